@@ -544,8 +544,8 @@ int populateReadIPDRCommonParam(
 	pIPDRCommonParameters->DocState_ = NONREADABLE;
 	pIPDRCommonParameters->DocType_ = 0;
 	pIPDRCommonParameters->descriptorCount_ = 1;
-	pIPDRCommonParameters->pDescriptorLookupHashTable_ = 
-		                      HashTableCreate(numOfBuckets);
+	pIPDRCommonParameters->pDescriptorLookupMap_ = 
+		                      newIPDRIntMap(numOfBuckets, free);
 	pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_ = 1;
 	pIPDRCommonParameters->pDescriptorLookupList_ = NULL;
 	pIPDRCommonParameters->pListErrorStructure_ = NULL;                    
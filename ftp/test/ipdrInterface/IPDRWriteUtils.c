@@ -56,8 +56,8 @@ int populateWriteIPDRCommonParam(
 	pIPDRCommonParameters->DocState_ = NONWRITABLE;
 	pIPDRCommonParameters->DocType_ = 0;
 	pIPDRCommonParameters->descriptorCount_ = 1;
-	pIPDRCommonParameters->pDescriptorLookupHashTable_ = 
-		                      HashTableCreate(numOfBuckets);
+	pIPDRCommonParameters->pDescriptorLookupMap_ = 
+		                      newIPDRIntMap(numOfBuckets, free);
 	pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_ = 1;
 	pIPDRCommonParameters->pDescriptorLookupList_ = NULL;
 	pIPDRCommonParameters->pListErrorStructure_ = NULL;                    
@@ -0,0 +1,81 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/******************************************************
+ * File                 : IPDRBatchConverter.h        *
+ * Description          : Converts batches of         *
+ *                        documents on a thread pool  *
+ * Author               : Infosys Tech Ltd            *
+ * Modification History :                             *
+ *--------------------------------------------------- *
+ * Date       Name        Change/Description          *
+ *--------------------------------------------------- *
+ *                                                    *
+ ******************************************************/
+
+#ifndef _IPDRBATCHCONVERTER_H
+#define _IPDRBATCHCONVERTER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils/IPDRCommon.h"
+
+/*
+ * convertIPDRDocuments() re-encodes a list of documents on a pool of
+ * worker threads. Each worker reads and writes with its own
+ * IPDRCommonParameters; with schema validation on, all of them use the
+ * schema shared through acquireSchemaData().
+ *
+ * The jobs are dealt to the workers largest input first, and a worker
+ * that runs out takes jobs from the end of the busiest queue, so a few
+ * large documents do not leave the other workers idle.
+ *
+ * XDR and XML documents can be read for conversion. An XML document
+ * carries no attribute types, so it is read with the schema of its
+ * service definitions, which must be reachable.
+ */
+
+typedef struct IPDRConversionJob
+{
+	char* pInputFileName_;
+	DocType inputType_;
+	char* pOutputFileName_;
+	DocType outputType_;
+	int errorCode_;          /* 0 once converted, set by the converter */
+	int noOfRecords_;        /* Records converted, set by the converter */
+	long noOfBytes_;         /* Size of the input, set by the converter */
+} IPDRConversionJob;
+
+typedef struct IPDRConversionStatistics
+{
+	int noOfThreads_;
+	int noOfDocuments_;      /* Documents converted */
+	int noOfFailures_;       /* Documents not converted */
+	long noOfRecords_;
+	double noOfBytes_;       /* Input bytes converted */
+	double elapsedSeconds_;
+	double recordsPerSecond_;
+	double bytesPerSecond_;
+} IPDRConversionStatistics;
+
+int convertIPDRDocument(IPDRConversionJob* pJob,
+						char* schemaVersion,
+						int schemaValidation);
+
+int convertIPDRDocuments(IPDRConversionJob* pJobs,
+						 int noOfJobs,
+						 int noOfThreads,
+						 char* schemaVersion,
+						 int schemaValidation,
+						 IPDRConversionStatistics* pStatistics,
+						 int* pErrorCode);
+
+#endif
@@ -29,12 +29,17 @@
 #include "utils/IPDRMemory.h"
 #include "common/schema.h"
 #include "utils/schemaUtil.h"
+#include "utils/IPDRThread.h"
+#include "utils/IPDRFlatRecord.h"
 
 #include "xdr/IPDRXDRHeaderHelper.h"
 #include "xdr/IPDRStreamElementHelper.h"
 #include "xdr/IPDRXDRRecordHelper.h"
 #include "xdr/IPDRXDRDocEndHelper.h"
 #include "xdr/IPDRRecord.h"
+#include "xdr/XDRInputBuffer.h"
+#include "xdr/XDRCodecPlan.h"
+#include "xdr/XDRUnMarshaller.h"
 
 #include "xml/IPDRXMLHeaderHelper.h"
 #include "xml/IPDRXMLRecordHelper.h"
@@ -47,12 +52,44 @@ int readHeader(
 			   int* errorCode
 			  );
 
+int setIPDRProjection(
+			 IPDRCommonParameters *IPDRCommonParameters, 
+			 List* pListAttributeName, 
+			 int* errorCode
+			 );
+
 int readIPDR(
 			 IPDRCommonParameters *IPDRCommonParameters, 
 			 FNFData** FNFData, 
 			 int* errorCode
 			 );
 
+int readIPDRFlat(
+			 IPDRCommonParameters *IPDRCommonParameters, 
+			 IPDRFlatRecord* pRecord, 
+			 int* recordRead,
+			 int* errorCode
+			 );
+
+int readIPDRInto(
+			 IPDRCommonParameters *IPDRCommonParameters, 
+			 FNFData* pFNFData, 
+			 int* recordRead,
+			 int* errorCode
+			 );
+
+/* Records a batch read hands to each worker at the least */
+#define IPDR_BATCH_MIN_RECORDS		64
+
+int readIPDRBatch(
+			 IPDRCommonParameters *IPDRCommonParameters, 
+			 FNFData** FNFData, 
+			 int maxRecords,
+			 int noOfThreads,
+			 int* noOfRecords,
+			 int* errorCode
+			 );
+
 int readDocEnd(
 			   IPDRCommonParameters *IPDRCommonParameters, 
 			   DocEnd *DocEnd, 
@@ -39,6 +39,8 @@
 #include "utils/hashtable.h"
 #include "xdr/IPDRStreamElementHelper.h"
 #include "xdr/IPDRRecord.h"
+#include "xdr/XDROutputBuffer.h"
+#include "xdr/XDRCodecPlan.h"
 #include "xml/IPDRXMLHeaderHelper.h"
 #include "xml/IPDRXMLRecordHelper.h"
 #include "xml/IPDRXMLDocEndHelper.h"
@@ -63,12 +65,31 @@ int createFNFData(
 				  int* errorCode
 				 );
 
+int resolveDescriptor(
+			  IPDRCommonParameters* IPDRCommonParameters, 
+			  FNFType* pFNFType, 
+			  int* errorCode
+			  );
+
 int writeIPDR(
 			  IPDRCommonParameters* IPDRCommonParameters, 
 			  FNFData* FNFData, 
 			  int* errorCode
 			  );
 
+int writeIPDRFlat(
+			  IPDRCommonParameters* IPDRCommonParameters, 
+			  IPDRFlatRecord* pRecord, 
+			  int* errorCode
+			  );
+
+int writeIPDRBatch(
+			  IPDRCommonParameters* IPDRCommonParameters, 
+			  FNFData** ppFNFData, 
+			  int noOfRecords, 
+			  int* errorCode
+			  );
+
 int writeDocEnd(
 				IPDRCommonParameters* IPDRCommonParameters, 
 				int* errorCode
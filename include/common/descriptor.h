@@ -24,6 +24,7 @@
 #include "utils/IPDRCommon.h"
 #include "utils/utils.h"
 #include "utils/dynamicArray.h"
+#include "utils/IPDRThread.h"
 
 
 #define IPDR_SCHEMA                    "schema"
@@ -118,6 +119,8 @@ typedef struct DescriptorCommon {
    int complexTypeFlag_;
 	int serviceFlag_;
 	ListNameSpaceInfo* pListNameSpaceInfo_;
+	List* lstVersion_;       /* version attributes, in document order */
+	char version_[10];       /* the first of them, selects 3.1 or 3.5 descriptors */
 } DescriptorCommon;
 
 static void start(void *data, const char *el, const char **attr);
@@ -129,6 +132,9 @@ int generateDescriptor(char* SchemaFile,
 					   char** OptionalAttributes,
 					   int* pErrorCode);
 
+/* Held while a schema is parsed, see generateSchemaDescriptor() */
+extern IPDRMutex gSchemaParserMutex;
+
 int generateSchemaDescriptor(char* SchemaURI, 
         FNFType* pFNFType,
 		ListNameSpaceInfo** pListNameSpaceInfo,
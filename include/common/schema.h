@@ -124,6 +124,9 @@ typedef struct SchemaCommon{
 	List* lstSchemaElementReference_;
 	List* lstSchemaElementMinOccurs_;
 	List* lstSchemaElementMaxOccurs_;
+
+	List* lstVersion_;       /* version attributes, in document order */
+	char version_[10];       /* version the schema is read for */
 	
 } SchemaCommon;
 
@@ -165,6 +168,4 @@ int setSchemaData(
 
 int freeSchemaCommon(SchemaCommon* pSchemaCommon);
 
-int setSchemaVersion(float ver);
-
 #endif
@@ -0,0 +1,77 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/******************************************************
+ * File                 : schemaCache.h               *
+ * Description          : On-disk cache of parsed     *
+ *                        schema documents            *
+ * Author               : Infosys Tech Ltd            *
+ * Modification History :                             *
+ *--------------------------------------------------- *
+ * Date       Name        Change/Description          *
+ *--------------------------------------------------- *
+ *                                                    *
+ ******************************************************/
+
+#ifndef _SCHEMACACHE_H
+#define _SCHEMACACHE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils/IPDRCommon.h"
+#include "common/schema.h"
+#include "common/descriptor.h"
+
+/*
+ * parseSchema() and parseSchemaLookup() run Expat over every schema
+ * of a service definition chain at each startup. When a cache
+ * directory is set, what a parse leaves in DescriptorCommon or
+ * SchemaCommon is written to a compiled image in that directory,
+ * keyed by the schema URI and checked against the length and hash
+ * of the schema contents. The next parse of an unchanged schema maps
+ * the image and rebuilds the structures from it instead.
+ *
+ * Images are written to a temporary file and renamed into place, so
+ * concurrent writers never expose a partial image. Any image that
+ * does not match is ignored and the schema is parsed as before.
+ */
+
+#define SCHEMA_CACHE_MAGIC			0x49504443U	/* "IPDC" */
+#define SCHEMA_CACHE_FORMAT			1
+
+/* Image kinds, one per parser */
+#define SCHEMA_CACHE_DESCRIPTOR		1
+#define SCHEMA_CACHE_LOOKUP			2
+
+int setSchemaCacheDirectory(char* directory, int* pErrorCode);
+
+char* getSchemaCacheDirectory(void);
+
+int loadDescriptorCommonCache(char* SchemaURI,
+							  char* SchemaFile,
+							  DescriptorCommon* pDescriptorCommon,
+							  int* pFound);
+
+int storeDescriptorCommonCache(char* SchemaURI,
+							   char* SchemaFile,
+							   DescriptorCommon* pDescriptorCommon,
+							   int extensionBaseParsed);
+
+int loadSchemaCommonCache(char* SchemaURI,
+						  char* SchemaFile,
+						  SchemaCommon* pSchemaCommon,
+						  int* pFound);
+
+int storeSchemaCommonCache(char* SchemaURI,
+						   char* SchemaFile,
+						   SchemaCommon* pSchemaCommon);
+
+#endif
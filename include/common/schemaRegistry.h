@@ -0,0 +1,62 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/******************************************************
+ * File                 : schemaRegistry.h            *
+ * Description          : Process wide registry of    *
+ *                        shared, read only schemas   *
+ * Author               : Infosys Tech Ltd            *
+ * Modification History :                             *
+ *--------------------------------------------------- *
+ * Date       Name        Change/Description          *
+ *--------------------------------------------------- *
+ *                                                    *
+ ******************************************************/
+
+#ifndef _SCHEMAREGISTRY_H
+#define _SCHEMAREGISTRY_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils/IPDRCommon.h"
+
+/*
+ * setSchemaData() parses the service definitions into the Schema of
+ * one document. acquireSchemaData() takes the same arguments, but
+ * loads each distinct set of service definitions only once per
+ * process: the first caller parses them into a Schema that is then
+ * frozen, with its attribute index built, and every later caller with
+ * the same definitions gets a reference to it.
+ *
+ * A frozen Schema is never written to. Validators and validation
+ * outcomes are kept in the IPDRCommonParameters of each document, so
+ * any number of writers and readers can use the same Schema from any
+ * thread without locking. Only acquiring and releasing take the
+ * registry lock; the lock is held while a schema is parsed, so each
+ * set of definitions is loaded once.
+ *
+ * The number of documents referencing a shared Schema is kept in the
+ * Schema itself, see retainSchemaData() and releaseSchemaData() in
+ * IPDRMemory.h, so freeIPDRCommonParameters() can release it without
+ * the registry. freeIPDRCommonParameters() releases a shared Schema
+ * instead of freeing it. Unreferenced schemas stay in the registry until
+ * clearSchemaRegistry() is called.
+ */
+
+int acquireSchemaData(IPDRCommonParameters* pIPDRCommonParameters,
+					  ListNameSpaceInfo* pListNameSpaceInfo,
+					  ListServiceDefinitionURI* pListServiceDefinitionURI,
+					  char* defaultNameSpace,
+					  int* pErrorCode);
+
+int clearSchemaRegistry(void);
+
+#endif
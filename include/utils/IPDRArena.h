@@ -0,0 +1,71 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : IPDRArena                  *
+ * Description          : Region allocator for       *
+ *                        records                    *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#ifndef _IPDRARENA_H
+#define _IPDRARENA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * An arena hands out zeroed blocks carved from large chunks, and frees
+ * them all at once. Records built in an arena, see newFNFDataInArena(),
+ * need no free call per list node or value: the application resets
+ * the arena once the records are processed, and the chunks are reused
+ * for the next ones without going back to the C library.
+ *
+ * Resetting takes constant time; chunks are only released by
+ * freeIPDRArena(). An arena is not locked, each thread uses its own.
+ */
+
+/* Bytes of a chunk when no size is given */
+#define IPDR_ARENA_CHUNK_SIZE		16384
+
+/* Alignment of the blocks, enough for hyper and double values */
+#define IPDR_ARENA_ALIGNMENT		8
+
+typedef struct IPDRArenaChunk
+{
+	struct IPDRArenaChunk* pNext_;
+	size_t size_;            /* Usable bytes following the header */
+	size_t used_;
+} IPDRArenaChunk;
+
+typedef struct IPDRArena
+{
+	IPDRArenaChunk* pFirst_;
+	IPDRArenaChunk* pCurrent_;   /* Chunk allocated from, chunks after it are free */
+	size_t chunkSize_;
+} IPDRArena;
+
+IPDRArena* newIPDRArena(size_t chunkSize);
+
+void* allocIPDRArena(IPDRArena* pArena, size_t size);
+
+char* copyIPDRArenaString(IPDRArena* pArena, const char* pString);
+
+int resetIPDRArena(IPDRArena* pArena);
+
+int freeIPDRArena(IPDRArena* pArena);
+
+#endif
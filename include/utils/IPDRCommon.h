@@ -26,6 +26,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include "utils/hashtable.h"
+#include "utils/IPDRMap.h"
+#include "utils/IPDRArena.h"
 #include "utils/dynamicArray.h"
 /*! 
  * Defining Constants for Version major
@@ -70,6 +72,14 @@
 #define HASH_BUCKETS						10
 #define MAX_SCHEMA_VERSION				10
 
+/*!
+ * String, byte array and boolean values of fewer than 
+ * IPDR_INLINE_VALUE_SIZE bytes are held in the list node itself,
+ * longer ones in a buffer of their own length.
+ */
+
+#define IPDR_INLINE_VALUE_SIZE		16
+
 /*!
  * Defining Constants for 8 primitive data types
  */
@@ -463,6 +473,9 @@ typedef struct ListIPDRArrayData
 {
 	int IPDRDataType_;
 	IPDRDataUnion IPDRDataUnion_;
+	int length_;                     /* Length of a string or byte array value */
+	int capacity_;                   /* Bytes of a value malloc'ed for the node, 0 otherwise */
+	char inlineValue_[IPDR_INLINE_VALUE_SIZE]; /* Holds short values */
 
    struct ListIPDRArrayData *pNext_;
 } ListIPDRArrayData; 
@@ -506,6 +519,9 @@ typedef struct ListIPDRStructureData
 typedef struct ListIPDRData {
 	int IPDRDataType_;
 	IPDRDataUnion IPDRDataUnion_;
+	int length_;                     /* Length of a string or byte array value */
+	int capacity_;                   /* Bytes of a value malloc'ed for the node, 0 otherwise */
+	char inlineValue_[IPDR_INLINE_VALUE_SIZE]; /* Holds short values */
 
 	/*IPDR v3.5, structures and Arrays*/
    int noOfElements_;	
@@ -530,6 +546,15 @@ typedef struct FNFData
    /*IPDR v3.5*/
 	ListAttributeDescriptor* pListServiceAttributeDescriptor_;
 	ListIPDRData* pListIPDRData_;
+	/* Descriptor resolved by resolveDescriptor(), 0 if unresolved */
+	int descriptorID_;
+	/* Owns the record and its lists, NULL if they are on the heap */
+	IPDRArena* pArena_;
+	/* Document, descriptor and readGeneration_ of the record last read
+	   by readIPDRInto(), whose lists the next record of that shape reuses */
+	const void* pReadDocument_;
+	int readDescriptorID_;
+	int readGeneration_;
 } FNFData;
 
 /*!
@@ -648,6 +673,8 @@ typedef struct FNFType
     ListAttributeDescriptor* pListAttributeDescriptor_;
     /*IPDR v3.5*/
     ListAttributeDescriptor* pListServiceAttributeDescriptor_;
+    /* Descriptor resolved by resolveDescriptor(), 0 if unresolved */
+    int descriptorID_;
 } FNFType;
 
 /*!
@@ -744,8 +771,106 @@ typedef struct Schema
 	ListSchemaLookup* pListSchemaLookup_;
 	ListNameSpaceInfo* pListNameSpaceInfo_;
 	int SchemaValidationFlag_;
+	/* Schema elements by attribute name, built on first lookup */
+	IPDRStringMap* pElementIndex_;
+	SchemaElement** ppIndexedElements_;
+	int* pElementSequence_;
+	/* Owned by the schema registry and read only, see schemaRegistry.h */
+	int shared_;
+	int refCount_;           /* Documents referencing a shared schema */
 }Schema;
  
+/*!
+ *  Output buffer used by the XDR marshallers. The encoded bytes
+ *  are kept in fixed size chunks and drained to the stream at
+ *  record and document boundaries.
+ */
+typedef struct XDROutputBuffer
+{
+	void* pStreamHandle_;    /* Stream the buffer is drained to */
+	byte** ppChunks_;
+	int noOfChunks_;         /* Chunks allocated so far */
+	int chunkSize_;
+	int currentChunk_;
+	int chunkOffset_;        /* Bytes used in the current chunk */
+	int length_;             /* Bytes buffered */
+	int capacity_;           /* Drain threshold at record boundaries */
+	int flushMode_;
+} XDROutputBuffer;
+
+/*!
+ *  Input source used by the XDR unmarshallers. The document is either
+ *  read through the stdio stream or mapped in memory and decoded from
+ *  a bounds checked cursor.
+ */
+typedef struct XDRInputBuffer
+{
+	void* pStreamHandle_;    /* Stream the document is read from */
+	const byte* pMapping_;   /* Mapped document, NULL when reading through stdio */
+	size_t mappingLength_;
+	size_t offset_;          /* Cursor in the mapping */
+	byte* pScratch_;         /* Holds the views of the stdio reader */
+	int scratchSize_;
+	int inputMode_;
+	int status_;             /* IPDR_EOF_ENCOUNTERED once the document is overrun */
+	int borrowed_;           /* IPDR_TRUE if the mapping belongs to another buffer */
+} XDRInputBuffer;
+
+/*!
+ *  Codec plan of a record descriptor. Every attribute becomes one
+ *  typed operation, and consecutive fixed width scalars are grouped
+ *  in runs that are encoded or decoded through a single buffer access.
+ */
+typedef struct XDRCodecOp
+{
+	int typeCode_;           /* IPDRDATA_* of the attribute */
+	int noOfElements_;       /* As in the descriptor, 0 for scalars */
+	int width_;              /* XDR bytes of a fixed width scalar, 0 otherwise */
+	int runLength_;          /* Ops in the fixed width run starting here */
+	int runWidth_;           /* XDR bytes of that run */
+	int projected_;          /* IPDR_FALSE if the value is skipped when read */
+} XDRCodecOp;
+
+typedef struct XDRCodecPlan
+{
+	XDRCodecOp* pOps_;
+	int noOfOps_;
+	int hasStructures_;      /* IPDR_TRUE if the record holds structures */
+} XDRCodecPlan;
+
+/*!
+ *  Precompiled XML of one attribute: its open and close tags and how
+ *  its value is formatted.
+ */
+typedef struct XMLElementTemplate
+{
+	char* pOpenTag_;         /* "<name>" */
+	int openLength_;
+	char* pCloseTag_;        /* "</name>\n" */
+	int closeLength_;
+	int typeCode_;           /* IPDRDATA_* of the attribute */
+	int derivedCode_;        /* XML_DERIVED_* of the attribute */
+	char* attributeName_;    /* Descriptor fields the template was built from */
+	char* attributeType_;
+	char* derivedType_;
+	char* complexType_;
+} XMLElementTemplate;
+
+/*!
+ *  Precompiled XML of a record type. Records holding arrays or
+ *  structures are left to writeIPDRXMLRecordHelper(), such templates
+ *  only have isCompiled_ cleared.
+ */
+typedef struct XMLRecordTemplate
+{
+	char* typeName_;
+	char* pRecordOpen_;      /* " <IPDR xsi:type=...>" up to the creation time */
+	int recordOpenLength_;
+	XMLElementTemplate* pElements_;
+	int noOfElements_;
+	int isCompiled_;         /* IPDR_TRUE if the records are written from the template */
+} XMLRecordTemplate;
+
 /*!
  *  This structure contains the parameters used by most 
  *  of the functions & This function will be passed across 
@@ -758,7 +883,7 @@ typedef struct IPDRCommonParameters
    char* pStreamName_;
 	DocState DocState_;            
 	IPDRCount IPDRCount_; /* Union of ipdrRecordCount & offsetValue */
-	HashTable* pDescriptorLookupHashTable_;
+	IPDRIntMap* pDescriptorLookupMap_;    /* Serialized descriptors by ID */
 	ListAttributeDescriptor* pDescriptorLookupList_;
 	Schema* pSchema_;
 	int descriptorCount_;
@@ -768,6 +893,26 @@ typedef struct IPDRCommonParameters
 	DocEnd *pDocEnd_;
    /* New member to store schema version */
    char schemaVersion[MAX_SCHEMA_VERSION];
+	XDROutputBuffer* pOutputBuffer_;
+	XDRInputBuffer* pInputBuffer_;
+	/* Decoded descriptors of the document, indexed by ID */
+	RecordDescriptor** ppDescriptorCache_;
+	unsigned int* pDescriptorFingerprints_;
+	XDRCodecPlan** ppCodecPlans_;    /* Compiled on first use */
+	int useCodecPlans_;              /* IPDR_FALSE reads and writes records without plans */
+	int descriptorCacheSize_;
+	IPDRIntMap* pXMLTemplateMap_;    /* XML record templates by descriptor fingerprint */
+	IPDRIntMap* pXMLTemplateIDMap_;  /* The same templates by descriptor ID, not owned */
+	IPDRIntMap* pXMLTypeCache_;      /* Schema types of XML records by shape */
+	IPDRIntMap* pValidatorMap_;      /* Compiled schema validators by record type name */
+	IPDRIntMap* pValidationMemo_;    /* Schema validation outcomes by descriptor ID */
+	IPDRStringMap* pProjection_;     /* Attributes read into FNFData, NULL for all */
+	struct XMLStreamReader* pXMLStreamReader_;    /* Open XML parse, NULL otherwise */
+	ListAttributeDescriptor* pListServiceAttributeDescriptor_;    /* Service attributes of the descriptors read */
+	int compositeDescriptorFlag_;    /* Set while reading the members of a structure descriptor */
+	int xmlArrayFound_;              /* An array attribute was seen in an XML record */
+	int xmlComplexArrayFound_;       /* An array member was seen in an XML structure */
+	int readGeneration_;             /* Renewed when a descriptor or the projection is set */
 } IPDRCommonParameters;
 
 typedef struct ComplexElement {
@@ -0,0 +1,122 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : IPDRFlatRecord             *
+ * Description          : Record held in flat arrays *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#ifndef _IPDRFLATRECORD_H
+#define _IPDRFLATRECORD_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils/IPDRCommon.h"
+
+/*
+ * A flat record holds the values of a record in an array indexed like
+ * the attribute descriptors of its layout, and its strings, byte
+ * arrays and booleans back to back in one payload buffer. Setting a
+ * value takes constant time, and so does getting one by index; names
+ * are resolved to indexes through a map built with the layout, so a
+ * consumer looks each name up once and keeps the index.
+ *
+ * A record is meant to be reused: clearing it, or reading a record of
+ * the same descriptor into it, keeps the layout and the capacity of
+ * the arrays and of the payload. Only attributes without arrays or
+ * structures can be held; copyFNFDataToFlatRecord() and
+ * copyFlatRecordToFNFData() convert between flat records and FNFData.
+ */
+
+/* Bytes of the payload of a new record */
+#define IPDR_FLAT_PAYLOAD_SIZE		256
+
+typedef struct IPDRFlatValue
+{
+	int IPDRDataType_;       /* IPDRDATA_* of the value, 0 while unset */
+	int length_;             /* Bytes of a string, byte array or boolean */
+	int offset_;             /* Where such a value starts in the payload */
+	IPDRDataUnion IPDRDataUnion_;    /* Other values */
+} IPDRFlatValue;
+
+typedef struct IPDRFlatRecord
+{
+	char* typeName_;
+	ListAttributeDescriptor* pListAttributeDescriptor_;
+	ListAttributeDescriptor* pListServiceAttributeDescriptor_;
+	AttributeDescriptor** ppAttributeDescriptors_;  /* By attribute index */
+	IPDRStringMap* pAttributeIndex_;    /* Attribute index by name */
+	IPDRArena* pLayoutArena_;        /* Holds the type name and descriptors */
+	unsigned int fingerprint_;       /* fingerprintDescriptor() of the layout */
+	int noOfAttributes_;
+	int capacity_;                   /* Slots of the value and descriptor arrays */
+	IPDRFlatValue* pValues_;
+	char* pPayload_;
+	int payloadLength_;
+	int payloadCapacity_;
+	const IPDRCommonParameters* pReadDocument_;  /* Document readDescriptorID_ is from */
+	int readDescriptorID_;
+	const IPDRCommonParameters* pWriteDocument_; /* Document writeDescriptorID_ is from */
+	int writeDescriptorID_;
+} IPDRFlatRecord;
+
+IPDRFlatRecord* newIPDRFlatRecord(void);
+
+int freeIPDRFlatRecord(IPDRFlatRecord* pRecord);
+
+int setIPDRFlatRecordLayout(IPDRFlatRecord* pRecord,
+							const char* typeName,
+							const ListAttributeDescriptor* pListAttributeDescriptor,
+							const ListAttributeDescriptor* pListServiceAttributeDescriptor);
+
+int clearIPDRFlatRecord(IPDRFlatRecord* pRecord);
+
+int getIPDRFlatRecordIndex(const IPDRFlatRecord* pRecord,
+						   const char* attributeName);
+
+int setIPDRFlatValue(IPDRFlatRecord* pRecord,
+					 int index,
+					 const IPDRDataUnion* pDataValue,
+					 int dataType);
+
+int setIPDRFlatValueByName(IPDRFlatRecord* pRecord,
+						   const char* attributeName,
+						   const IPDRDataUnion* pDataValue,
+						   int dataType);
+
+int setIPDRFlatBytes(IPDRFlatRecord* pRecord,
+					 int index,
+					 const char* pValue,
+					 int length,
+					 int dataType);
+
+const IPDRFlatValue* getIPDRFlatValue(const IPDRFlatRecord* pRecord,
+									  int index);
+
+const IPDRFlatValue* getIPDRFlatValueByName(const IPDRFlatRecord* pRecord,
+											const char* attributeName);
+
+const char* getIPDRFlatBytes(const IPDRFlatRecord* pRecord,
+							 const IPDRFlatValue* pValue);
+
+int copyFNFDataToFlatRecord(IPDRFlatRecord* pRecord,
+							const FNFData* pFNFData);
+
+int copyFlatRecordToFNFData(FNFData* pFNFData,
+							const IPDRFlatRecord* pRecord);
+
+#endif
@@ -0,0 +1,107 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : IPDRMap                    *
+ * Description          : Typed open addressing maps *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#ifndef _IPDRMAP_H
+#define _IPDRMAP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Both maps keep their entries in one flat array probed linearly, so a
+ * lookup touches consecutive slots instead of following bucket chains.
+ * The capacity is a power of two and the load factor is kept at or
+ * below one half. Entries cannot be removed; a map is filled while a
+ * document or schema is set up and freed with it.
+ */
+
+/* Smallest number of slots of a map */
+#define IPDR_MAP_MIN_CAPACITY		16
+
+/* 32 bit FNV-1a parameters, also used for descriptor fingerprints */
+#define IPDR_FNV_OFFSET_BASIS 2166136261U
+#define IPDR_FNV_PRIME 16777619U
+
+/*!
+ *  String to int map. The hash of every key is stored with its entry,
+ *  so probing compares hashes first and rehashing never rereads keys.
+ *  A hash of 0 marks an empty slot.
+ */
+typedef struct IPDRStringMapEntry
+{
+	unsigned int hash_;
+	char* key_;              /* Owned copy of the key */
+	int value_;
+} IPDRStringMapEntry;
+
+typedef struct IPDRStringMap
+{
+	IPDRStringMapEntry* pEntries_;
+	int capacity_;
+	int noOfEntries_;
+} IPDRStringMap;
+
+/*!
+ *  Int to pointer map. Values are owned by the map when a value
+ *  deallocator is given.
+ */
+typedef struct IPDRIntMapEntry
+{
+	int key_;
+	int used_;
+	void* pValue_;
+} IPDRIntMapEntry;
+
+typedef struct IPDRIntMap
+{
+	IPDRIntMapEntry* pEntries_;
+	int capacity_;
+	int noOfEntries_;
+	void (*valueDeallocator_)(void* pValue);
+} IPDRIntMap;
+
+unsigned int hashIPDRMapString(const char* key);
+
+IPDRStringMap* newIPDRStringMap(int expectedEntries);
+void freeIPDRStringMap(IPDRStringMap* pStringMap);
+int putIPDRStringMap(IPDRStringMap* pStringMap,
+					 const char* key,
+					 int value,
+					 int* pErrorCode);
+int getIPDRStringMap(const IPDRStringMap* pStringMap,
+					 const char* key,
+					 int* pValue);
+int getIPDRStringMapHashed(const IPDRStringMap* pStringMap,
+						   const char* key,
+						   unsigned int hash,
+						   int* pValue);
+
+IPDRIntMap* newIPDRIntMap(int expectedEntries,
+						  void (*valueDeallocator)(void* pValue));
+void freeIPDRIntMap(IPDRIntMap* pIntMap);
+int putIPDRIntMap(IPDRIntMap* pIntMap,
+				  int key,
+				  void* pValue,
+				  int* pErrorCode);
+void* getIPDRIntMap(const IPDRIntMap* pIntMap, int key);
+
+#endif
@@ -82,6 +82,24 @@ int appendListIPDRData(
 	 		void* dataValue,
 			int dataType
 			); 
+int appendListIPDRDataInArena(
+			IPDRArena* pArena,
+			ListIPDRData** pHeadRef, 
+	 		void* dataValue,
+			int dataType
+			); 
+int copyListIPDRDataInArena(
+			IPDRArena* pArena,
+			ListIPDRData** pHeadRef, 
+			const ListIPDRData* pListIPDRData
+			); 
+
+int setListIPDRDataValue(
+			ListIPDRData* pListIPDRData, 
+	 		void* dataValue,
+			int length,
+			int dataType
+			); 
 
 int freeListIPDRData(ListIPDRData** pHeadRef);
 int freeListNodeIPDRData(ListIPDRData** pHeadRef, int node);
@@ -123,6 +141,16 @@ int appendListAttributeDescriptor(ListAttributeDescriptor** pHeadRef,
      List* attrMaxOccursList,
      int noOfElements
 	);
+int appendListAttributeDescriptorInArena(
+			IPDRArena* pArena,
+			ListAttributeDescriptor** pHeadRef, 
+			const AttributeDescriptor* pAttributeDescriptor
+			);
+int setAttributeDescriptorString(
+			IPDRArena* pArena,
+			char** ppString,
+			const char* pValue
+			);
 
 int checkAttribute(
 			char *attribute, 
@@ -143,6 +171,8 @@ int printIPDRRecord(IPDRRecord* pIPDRRecord);
 
 /* Function prototypes for FNFData */
 FNFData* newFNFData(void);
+FNFData* newFNFDataInArena(IPDRArena* pArena);
+int copyFNFDataInArena(FNFData* pFNFData, const FNFData* pSourceFNFData);
 int freeFNFData(FNFData* pFNFData);
 int printFNFData(FNFData* pFNFData);
 
@@ -270,6 +300,10 @@ int freeHeadListFNFData(ListFNFData **pHeadRef);
 int printListFNFData(ListFNFData* pListFNFData);
 
 int freeSchemaData(Schema* pSchema);
+int retainSchemaData(Schema* pSchema);
+int releaseSchemaData(Schema* pSchema);
+int freeUnreferencedSchemaData(Schema* pSchema);
+int nextIPDRReadGeneration(void);
 ListOfKeys* newListOfKeys();
 int freeListOfKeys(ListOfKeys** pHeadRef);
 
@@ -418,6 +452,12 @@ int appendListIPDRArrayData(struct ListIPDRArrayData** pHeadRef,
 				 int dataType
 );
  
+int setListIPDRArrayDataValue(struct ListIPDRArrayData* pListIPDRArrayData, 
+	 			 void* dataValue,
+				 int length,
+				 int dataType
+);
+ 
 int appendListArrayToIPDRData(struct ListIPDRData** pHeadRef, 
 				 struct ListIPDRArrayData *pListIPDRArrayData,
 				 int noOfElements,
@@ -0,0 +1,88 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : IPDRThread                 *
+ * Description          : Portable locking primitives*
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#ifndef _IPDRTHREAD_H
+#define _IPDRTHREAD_H
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+/*
+ * Mutexes can be initialized statically with IPDR_MUTEX_INITIALIZER,
+ * so process wide state needs no setup call. Slim reader/writer locks
+ * are used on Windows as they have a static initializer, unlike
+ * critical sections. Mutexes in allocated memory are set up with
+ * initIPDRMutex() and released with destroyIPDRMutex().
+ */
+
+#ifdef WIN32
+typedef SRWLOCK IPDRMutex;
+#define IPDR_MUTEX_INITIALIZER SRWLOCK_INIT
+#else
+typedef pthread_mutex_t IPDRMutex;
+#define IPDR_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
+#endif
+
+/*
+ * The codec paths use the re-entrant forms of the C library calls
+ * that keep hidden state, so documents can be processed on several
+ * threads at once.
+ */
+
+#ifdef WIN32
+#define strtok_r strtok_s
+#define gmtime_r(pTime, pResult) \
+	(gmtime_s((pResult), (pTime)) == 0 ? (pResult) : NULL)
+#endif
+
+/*
+ * Worker threads run an IPDRThreadFunction; its argument is passed
+ * through unchanged.
+ */
+
+#ifdef WIN32
+typedef HANDLE IPDRThread;
+#else
+typedef pthread_t IPDRThread;
+#endif
+
+typedef void (*IPDRThreadFunction)(void* pArgument);
+
+int initIPDRMutex(IPDRMutex* pMutex);
+
+int destroyIPDRMutex(IPDRMutex* pMutex);
+
+int lockIPDRMutex(IPDRMutex* pMutex);
+
+int unlockIPDRMutex(IPDRMutex* pMutex);
+
+int startIPDRThread(IPDRThread* pThread,
+					IPDRThreadFunction function,
+					void* pArgument);
+
+int joinIPDRThread(IPDRThread* pThread);
+
+int getIPDRProcessorCount(void);
+
+#endif
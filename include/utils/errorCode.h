@@ -160,6 +160,12 @@
 #define IPDR_LOOKUP_FILE_NOT_FOUND                                              134
 #define IPDR_LOOKUP_READ_ERROR                                                  135
 #define IPDR_LOOKUP_PARSER_READ_ERROR                                           136
+#define IPDR_SCHEMA_CACHE_DIRECTORY_INVALID                                     139
+#define IPDR_SCHEMA_READ_ONLY                                                   140
+#define IPDR_THREAD_CREATE_FAILED                                               141
+#define IPDR_CONVERSION_INPUT_UNSUPPORTED                                       142
+#define IPDR_ATTRIBUTE_NOT_IN_LAYOUT                                            143
+#define IPDR_ATTRIBUTE_VALUE_NOT_SET                                            144
 
 
 /* Newly Added expat parser related error codes Series 200 - 299 */
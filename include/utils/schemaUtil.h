@@ -34,6 +34,7 @@
 #include "utils/serialize.h"
 #include "utils/errorCode.h"
 #include "utils/dynamicArray.h"
+#include "utils/schemaValidator.h"
 
 
 
@@ -43,6 +44,18 @@ int validateAgainstSchema(
            int* pErrorCode
           );
 
+int validateRecordAgainstSchema(
+           IPDRCommonParameters *pIPDRCommonParameters,
+           FNFData* pFNFData,
+           int descriptorID,
+           int layoutOfDescriptor,
+           int* pErrorCode
+          );
+
+int freeSchemaIndex(Schema* pSchema);
+
+int buildSchemaIndex(Schema* pSchema, int* pErrorCode);
+
 int getSchemElementFromAttributeName(IPDRCommonParameters* pIPDRCommonParameters, 
 									 SchemaElement* pSchemaElement, 
 									 char* attributeName, 
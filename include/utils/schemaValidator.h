@@ -0,0 +1,117 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : schemaValidator            *
+ * Description          : Schema validation of a     *
+ *                        record type, compiled once *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#ifndef _SCHEMAVALIDATOR_H
+#define _SCHEMAVALIDATOR_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils/IPDRCommon.h"
+#include "utils/IPDRMap.h"
+
+/*
+ * validateAgainstSchema() checks a record against the schema lookup
+ * of its service type. The outcome depends on the schema and on the
+ * attribute names only, so it is compiled once per record type name:
+ * attribute names are interned to slots holding their sequence number
+ * and schema types, and the mandatory attributes form a bitset. A
+ * record is then validated in a single pass over its attributes.
+ * Outcomes are also kept per descriptor ID, so that the following
+ * records of a descriptor only have their shape confirmed.
+ */
+
+/* Mandatory attributes a compiled validator can track */
+#define SCHEMA_VALIDATOR_SET_WORDS		16
+#define SCHEMA_VALIDATOR_MAX_MANDATORY	(SCHEMA_VALIDATOR_SET_WORDS * 32)
+
+/* Attribute names a compiled validator interns, records with more
+ * names are validated by the list walk */
+#define SCHEMA_VALIDATOR_MAX_SLOTS		1024
+
+/* Resolution of a slot */
+#define SCHEMA_SLOT_UNRESOLVED			0
+#define SCHEMA_SLOT_RESOLVED			1
+#define SCHEMA_SLOT_NOT_IN_SCHEMA		2
+#define SCHEMA_SLOT_UNBOUND_NAMESPACE	3
+
+/* Descriptor ID of records validated without one */
+#define SCHEMA_NO_DESCRIPTOR_ID			-1
+
+typedef struct SchemaValidatorSlot
+{
+	int mandatoryBit_;       /* Bit in the mandatory set, or -1 */
+	int resolution_;
+	int sequence_;           /* Position within the schema lookup */
+	char* attributeType_;
+	char* derivedType_;
+} SchemaValidatorSlot;
+
+typedef struct SchemaValidator
+{
+	char* typeName_;         /* Record type name as given */
+	char* serviceType_;      /* Type name without namespace prefix */
+	int useLegacy_;          /* IPDR_TRUE if the schema needs the list walk */
+	int hasMandatoryList_;   /* IPDR_FALSE if no mandatory attribute is known */
+	IPDRStringMap* pSlotIndex_;
+	SchemaValidatorSlot* pSlots_;
+	int noOfSlots_;
+	int slotCapacity_;
+	unsigned int mandatorySet_[SCHEMA_VALIDATOR_SET_WORDS];
+	int noOfMandatory_;
+} SchemaValidator;
+
+typedef struct SchemaValidationOutcome
+{
+	int mandatoryMissing_;   /* IPDR_TRUE if a mandatory attribute is absent */
+	int errorSeverity_;      /* Of the first failing attribute, or IPDR_OK */
+	int errorCode_;
+	int noOfCopied_;         /* Leading attributes given the schema derived type */
+} SchemaValidationOutcome;
+
+/*!
+ *  Outcome of a descriptor, with the shape it was found for.
+ */
+typedef struct SchemaValidationMemo
+{
+	char* typeName_;
+	int noOfAttributes_;
+	char** ppAttributeNames_;
+	char** ppAttributeTypes_;
+	char** ppDerivedTypes_;  /* noOfCopied_ entries */
+	int layoutOfDescriptor_; /* IPDR_TRUE if the shape was that of the descriptor */
+	unsigned int fingerprint_;   /* Of the descriptor when the memo was made */
+	SchemaValidationOutcome outcome_;
+} SchemaValidationMemo;
+
+void freeSchemaValidator(void* pSchemaValidator);
+
+void freeSchemaValidationMemo(void* pSchemaValidationMemo);
+
+int validateWithSchemaValidator(IPDRCommonParameters* pIPDRCommonParameters,
+								FNFData* pFNFData,
+								int descriptorID,
+								int layoutOfDescriptor,
+								int* pHandled,
+								int* pErrorCode);
+
+#endif
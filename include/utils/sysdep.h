@@ -48,6 +48,7 @@
 
   #include "utils/global.h"
   #include "utils/md5.h"
+  #include "utils/IPDRThread.h"
 
   /* set the following to the number of 100ns ticks of the actual
   resolution of
@@ -56,8 +57,11 @@
 
   /* Set the following to a call to acquire a system wide global lock
   */
-  #define LOCK
-  #define UNLOCK
+  /* The generator state is kept process wide so that UUIDs stay unique
+     across documents, threads of one process take gUUIDMutex */
+  extern IPDRMutex gUUIDMutex;
+  #define LOCK lockIPDRMutex(&gUUIDMutex)
+  #define UNLOCK unlockIPDRMutex(&gUUIDMutex)
 
   typedef unsigned long   unsigned32;
   typedef unsigned short  unsigned16;
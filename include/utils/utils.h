@@ -71,6 +71,12 @@ int convLongToTime(
 				   int* pErrorCode
 				  );
 
+int convLongMicroToTime(
+				   hyper* pTimeMicroSec,
+				   char* timeStr,
+				   int* pErrorCode
+				  );
+
 
 int convLongToDateTime(
 					   long* pTimelong, 
@@ -35,6 +35,9 @@
 
 #define MAXSIZE 100
 
+/* Descriptor IDs at or above this bound are not cached */
+#define IPDR_DESCRIPTOR_CACHE_LIMIT 65536
+
 
 int createDescriptor(
 					 IPDRCommonParameters *IPDRCommonParameters, 
@@ -66,5 +69,26 @@ int getDescriptor(
 				  int* errorCode
 				  );
 
+const RecordDescriptor* lookupDescriptor(
+				  IPDRCommonParameters *IPDRCommonParameters, 
+				  int descriptorID
+				  );
+
+int findDescriptor(
+				  IPDRCommonParameters *IPDRCommonParameters, 
+				  const char* typeName, 
+				  const ListAttributeDescriptor* pListAttributeDescriptor
+				  );
+
+int dropDescriptors(
+				  IPDRCommonParameters *IPDRCommonParameters, 
+				  int descriptorCount
+				  );
+
+unsigned int fingerprintDescriptor(
+				  const char* typeName, 
+				  const ListAttributeDescriptor* pListAttributeDescriptor
+				  );
+
 #endif
 
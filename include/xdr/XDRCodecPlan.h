@@ -0,0 +1,67 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : XDRCodecPlan               *
+ * Description          : Compiled encode / decode   *
+ *                        plans of record descriptors*
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#ifndef _XDRCODECPLAN_H
+#define _XDRCODECPLAN_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils/IPDRCommon.h"
+#include "utils/IPDRFlatRecord.h"
+
+/*
+ * A record descriptor is compiled once into a flat array of typed
+ * operations, so that records are encoded and decoded without walking
+ * the attribute list or converting type names. Records holding
+ * structures are left to writeFNFDataHelper() / readFNFDataHelper().
+ */
+
+/* Bytes a fixed width run may span */
+#define XDR_CODEC_RUN_LIMIT			256
+
+XDRCodecPlan* newXDRCodecPlan(const RecordDescriptor* pRecordDescriptor);
+int freeXDRCodecPlan(XDRCodecPlan* pCodecPlan);
+
+const XDRCodecPlan* getXDRCodecPlan(IPDRCommonParameters* pIPDRCommonParameters,
+									int descriptorID);
+
+int writeXDRCodecPlan(IPDRCommonParameters* pIPDRCommonParameters,
+					  const XDRCodecPlan* pCodecPlan,
+					  FNFData* pFNFData, int* pErrorCode);
+int readXDRCodecPlan(IPDRCommonParameters* pIPDRCommonParameters,
+					 const XDRCodecPlan* pCodecPlan,
+					 FNFData* pFNFData, int* pErrorCode);
+int readXDRCodecPlanInto(IPDRCommonParameters* pIPDRCommonParameters,
+						 const XDRCodecPlan* pCodecPlan,
+						 FNFData* pFNFData, int* pErrorCode);
+int writeXDRCodecPlanFlat(IPDRCommonParameters* pIPDRCommonParameters,
+						  const XDRCodecPlan* pCodecPlan,
+						  const IPDRFlatRecord* pRecord, int* pErrorCode);
+int readXDRCodecPlanFlat(IPDRCommonParameters* pIPDRCommonParameters,
+						 const XDRCodecPlan* pCodecPlan,
+						 IPDRFlatRecord* pRecord, int* pErrorCode);
+int skipXDRCodecPlan(XDRInputBuffer* pInputBuffer,
+					 const XDRCodecPlan* pCodecPlan,
+					 char* schemaVersion, int* pErrorCode);
+
+#endif
@@ -0,0 +1,61 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : XDRInputBuffer             *
+ * Description          : Input source for the XDR   *
+ *                        unmarshallers              *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#ifndef _XDRINPUTBUFFER_H
+#define _XDRINPUTBUFFER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils/IPDRCommon.h"
+
+/*
+ * The XDR unmarshallers read from an XDRInputBuffer instead of the
+ * input stream. With XDR_INPUT_MMAP the whole document is mapped and
+ * strings and octet arrays can be taken as views into the mapping.
+ */
+
+/*
+ * A cursor shares the mapping of another buffer and is positioned with
+ * seekXDRInputBuffer(), so several threads can decode different parts
+ * of one mapped document. The mapping must outlive the cursor.
+ */
+
+/* Input modes */
+#define XDR_INPUT_STDIO				0	/* fread() on the stream */
+#define XDR_INPUT_MMAP				1	/* cursor over the mapped document */
+
+XDRInputBuffer* newXDRInputBuffer(int inputMode);
+XDRInputBuffer* newXDRInputBufferCursor(const XDRInputBuffer* pSource);
+int freeXDRInputBuffer(XDRInputBuffer* pInputBuffer);
+
+int seekXDRInputBuffer(XDRInputBuffer* pInputBuffer, size_t offset);
+
+int readXDRInputBuffer(XDRInputBuffer* pInputBuffer, byte* pBuffer, int length);
+const byte* viewXDRInputBuffer(XDRInputBuffer* pInputBuffer, int length);
+
+int setXDRInputBuffer(IPDRCommonParameters* pIPDRCommonParameters,
+					  int inputMode, int* pErrorCode);
+int attachXDRInputBuffer(IPDRCommonParameters* pIPDRCommonParameters,
+						 int* pErrorCode);
+
+#endif
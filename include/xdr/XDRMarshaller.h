@@ -68,7 +68,7 @@
 #define HYPER_BITS 			16
 
 /* This function prototype is for integer */
-int write_long(int RawValue,void *pStream);
+int write_long(int RawValue,XDROutputBuffer* pOutputBuffer);
 int convWriteIntHexToInt(char iHexa[3]);
 
 /* This function prototype is for double */
@@ -77,7 +77,7 @@ int getWriteDoubleBinaryAfterDecimal(double n, char *b);
 int getWriteDoubleBinaryBeforeDecimal(double n, char *b);
 char getWriteDoubleHexFromBinary(char binary[4]);
 int getWriteDoubleHexFromDouble(char hexa[DOUBLE_HEXA_BITS], double d);
-int write_double(double rawValue, void *streamPointer);
+int write_double(double rawValue, XDROutputBuffer* pOutputBuffer);
 
 /* This function prototype is for float */
 int getFloatWriteExponent(double d);
@@ -86,44 +86,44 @@ int getFloatWriteBinaryBeforeDecimal(double n, char *b);
 char getFloatWriteHexFromBinary(char binary[4]);
 int getFloatWriteHexFromDouble(char hexa[FLOAT_HEXA_BITS], double d);
 int hexToInt (char iHexa[3]);
-int write_float(float rawValue, void *streamPointer);
+int write_float(float rawValue, XDROutputBuffer* pOutputBuffer);
 
 /* This definition is for unsigned Integer */
 int convWriteUInthexToInt(char iHexa[3]);
-int write_u_long(unsigned int RawValue, void* pStream);
+int write_u_long(unsigned int RawValue, XDROutputBuffer* pOutputBuffer);
 
 /* This definition is for Hyper Write */
 int convWriteHyperHexToInt(char iHexa[3]);
 int convWriteHyperToHex(hyper a, unsigned char* b);
-int write_longlong(hyper RawValue,FILE *pStream);
+int write_longlong(hyper RawValue,XDROutputBuffer* pOutputBuffer);
 
 /* This definition is for String Write */
-int write_string(char* pRawValue, void* pStream); 
+int write_string(char* pRawValue, XDROutputBuffer* pOutputBuffer); 
 
 /* This definition is for UTF8String Write */
 /*int write_wstring(wchar* pRawValue, void *pStream);*/
 /* Signature changed in order to pass the schema version parameter now */
-int write_wstring(wchar* pRawValue, void *pStream, char* schemaVer);
+int write_wstring(wchar* pRawValue, XDROutputBuffer* pOutputBuffer, char* schemaVer);
 int getUTF8String(char* srcString, char* UTF8String);
 int checkBigEndian();
 
 
 /* This definition is for ByteArray Write */
-int write_octet_array(byte* pRawValue, void *pStream);
+int write_octet_array(byte* pRawValue, XDROutputBuffer* pOutputBuffer);
 /*int write_noctet_array(byte* pRawValue, void *pStream, int length);*/
 /* code change to pass the schema version param */
-int write_noctet_array(byte* pRawValue, void *pStream, int length, char* schemaVer);
+int write_noctet_array(byte* pRawValue, XDROutputBuffer* pOutputBuffer, int length, char* schemaVer);
 
 
 /* This definition is for Unsigned Hyper Write */
-int write_u_longlong(u_hyper RawValue,FILE *pStream);
+int write_u_longlong(u_hyper RawValue,XDROutputBuffer* pOutputBuffer);
 int convWriteUnHyperToHex(u_hyper a, unsigned char* b);
 
 
-int write_short(int RawValue,void *pStream);
-int write_u_short( unsigned int RawValue, void* pStream);
-int write_byte(int RawValue,void *pStream);
-int write_boolean(char* RawValue,void *pStream);
+int write_short(int RawValue,XDROutputBuffer* pOutputBuffer);
+int write_u_short( unsigned int RawValue, XDROutputBuffer* pOutputBuffer);
+int write_byte(int RawValue,XDROutputBuffer* pOutputBuffer);
+int write_boolean(char* RawValue,XDROutputBuffer* pOutputBuffer);
 
 #endif
 
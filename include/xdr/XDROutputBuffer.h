@@ -0,0 +1,72 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : XDROutputBuffer            *
+ * Description          : In-memory sink for the XDR *
+ *                        marshallers                *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#ifndef _XDROUTPUTBUFFER_H
+#define _XDROUTPUTBUFFER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils/IPDRCommon.h"
+
+/*
+ * The XDR marshallers append to an XDROutputBuffer instead of the
+ * output stream. The buffer is drained at record boundaries once it
+ * holds capacity bytes, and always at the end of the document.
+ */
+
+#define XDR_OUTPUT_BUFFER_CAPACITY	65536
+#define XDR_OUTPUT_CHUNK_SIZE		16384
+
+/* Flush modes */
+#define XDR_FLUSH_STDIO				0	/* fwrite() per chunk */
+#define XDR_FLUSH_WRITEV			1	/* single writev() over all chunks */
+
+/* Position in an XDROutputBuffer, to truncate the buffer back to */
+typedef struct XDROutputMark
+{
+	int currentChunk_;
+	int chunkOffset_;
+	int length_;
+} XDROutputMark;
+
+XDROutputBuffer* newXDROutputBuffer(int capacity, int flushMode);
+int freeXDROutputBuffer(XDROutputBuffer* pOutputBuffer);
+
+int appendXDROutputBuffer(XDROutputBuffer* pOutputBuffer,
+						  const byte* pData, int length);
+int padXDROutputBuffer(XDROutputBuffer* pOutputBuffer, int length);
+
+void markXDROutputBuffer(const XDROutputBuffer* pOutputBuffer,
+						 XDROutputMark* pMark);
+int truncateXDROutputBuffer(XDROutputBuffer* pOutputBuffer,
+							const XDROutputMark* pMark);
+
+int commitXDROutputBuffer(XDROutputBuffer* pOutputBuffer, int* pErrorCode);
+int flushXDROutputBuffer(XDROutputBuffer* pOutputBuffer, int* pErrorCode);
+
+int setXDROutputBuffer(IPDRCommonParameters* pIPDRCommonParameters,
+					   int capacity, int flushMode, int* pErrorCode);
+int attachXDROutputBuffer(IPDRCommonParameters* pIPDRCommonParameters,
+						  int* pErrorCode);
+
+#endif
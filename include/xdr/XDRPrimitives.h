@@ -0,0 +1,101 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : XDRPrimitives              *
+ * Description          : Byte order kernels for the *
+ *                        XDR primitive types        *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#ifndef _XDRPRIMITIVES_H
+#define _XDRPRIMITIVES_H
+
+#include <stdio.h>
+#include <string.h>
+#include "utils/IPDRCommon.h"
+
+/*
+ * XDR stores every primitive in network (big-endian) byte order.
+ * The kernels below convert between host values and their XDR
+ * byte images directly, without going through a hex string.
+ */
+
+/* Sizes of the XDR byte images */
+#define XDR_SHORT_BYTES			2
+#define XDR_INT_BYTES			4
+#define XDR_HYPER_BYTES			8
+#define XDR_FLOAT_BYTES			4
+#define XDR_DOUBLE_BYTES		8
+
+/*
+ * XDR_HOST_SWAP is 1 when the host byte order has to be swapped
+ * to get XDR byte order, 0 when the host is big-endian and -1 when
+ * the byte order is not known at compile time (shift fallback).
+ */
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && \
+	(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define XDR_HOST_SWAP			1
+#elif defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && \
+	(__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define XDR_HOST_SWAP			0
+#elif defined(_WIN32)
+#define XDR_HOST_SWAP			1
+#else
+#define XDR_HOST_SWAP			-1
+#endif
+
+#if defined(__GNUC__) && ((__GNUC__ > 4) || \
+	((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)))
+#define XDR_BSWAP16(x)			__builtin_bswap16(x)
+#define XDR_BSWAP32(x)			__builtin_bswap32(x)
+#define XDR_BSWAP64(x)			__builtin_bswap64(x)
+#elif defined(_MSC_VER)
+#include <stdlib.h>
+#define XDR_BSWAP16(x)			_byteswap_ushort(x)
+#define XDR_BSWAP32(x)			_byteswap_ulong(x)
+#define XDR_BSWAP64(x)			_byteswap_uint64(x)
+#else
+#define XDR_BSWAP16(x)			((unsigned short) \
+								((((x) >> 8) & 0xff) | (((x) & 0xff) << 8)))
+#define XDR_BSWAP32(x)			((((x) >> 24) & 0xff) | \
+								(((x) >> 8) & 0xff00) | \
+								(((x) & 0xff00) << 8) | \
+								(((x) & 0xff) << 24))
+#define XDR_BSWAP64(x)			((((u_hyper) XDR_BSWAP32((unsigned int) (x))) << 32) | \
+								(u_hyper) XDR_BSWAP32((unsigned int) ((x) >> 32)))
+#endif
+
+
+/* Load a host value from its XDR byte image */
+unsigned short xdrLoadUShort(const byte* pBuffer);
+unsigned int xdrLoadUInt(const byte* pBuffer);
+u_hyper xdrLoadUHyper(const byte* pBuffer);
+
+/* Store a host value as its XDR byte image */
+void xdrStoreUShort(byte* pBuffer, unsigned short value);
+void xdrStoreUInt(byte* pBuffer, unsigned int value);
+void xdrStoreUHyper(byte* pBuffer, u_hyper value);
+
+/* IEEE-754 single and double precision, bit-cast through the integers */
+float xdrLoadFloat(const byte* pBuffer);
+double xdrLoadDouble(const byte* pBuffer);
+void xdrStoreFloat(byte* pBuffer, float value);
+void xdrStoreDouble(byte* pBuffer, double value);
+
+/* Read a whole XDR byte image from a stream */
+int xdrReadBytes(byte* pBuffer, int length, void* pStream);
+
+#endif
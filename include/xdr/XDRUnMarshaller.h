@@ -64,51 +64,53 @@
 /* This definition is for integer */
 int convReadIntHexToInt(int count, char iHexa[3]);
 void convReadIntCharHexToInt(char *phex, int *pSB);
-int read_long(void* pStream);
+int read_long(XDRInputBuffer* pInputBuffer);
 
 /* This definition is for unsigned integer */
 unsigned int convReadUIntHexToInt(int count, char iHexa[3]);
 void convReadUIntCharHexToInt(char *hex, int *SB);
-unsigned int read_u_long(void* pStream);
+unsigned int read_u_long(XDRInputBuffer* pInputBuffer);
 
 /* This definition is for double */
 double getReadDoubleMantissa(char Mantissa[DOUBLE_MANTISSA_BITS]);
 int getReadDoubleExponent(char Exponent[DOUBLE_EXPONENT_BITS     ]);
 int convReadDoubleHexToBinary(char hexa, char binary[4]);
-double read_double(void *streamPtr);
+double read_double(XDRInputBuffer* pInputBuffer);
 
 /* This definition is for float */
 float getFloatReadMantissa(char Mantissa[FLOAT_MANTISSA_BITS]);
 int getFloatReadExponent(char Exponent[FLOAT_EXPONENT_BITS]);
 int convFloatReadHexToBinary(char hexa, char binary[4]);
-float read_float(void *streamPtr);
+float read_float(XDRInputBuffer* pInputBuffer);
 
 /* This definition is for String */
-char* read_string(int length, void* pStream);
+char* read_string(int length, XDRInputBuffer* pInputBuffer);
 
 /* This definition is for UTF8String */
 /* Signature change to pass the schemaVersion parameter */
-wchar* read_wstring(int length, void* pStream, char* schemaVer);
+wchar* read_wstring(int length, XDRInputBuffer* pInputBuffer, char* schemaVer);
+const char* read_wstring_view(int length, XDRInputBuffer* pInputBuffer, char* schemaVer);
 
 /* This definition is for Byte Array */
 /* Signature change to pass the schemaVersion parameter */
-byte* read_octet_array(int length, void* pStream, char* schemaVer);
+byte* read_octet_array(int length, XDRInputBuffer* pInputBuffer, char* schemaVer);
+const byte* read_octet_view(int length, XDRInputBuffer* pInputBuffer, char* schemaVer);
 
 /* This definition is for Hyper */
 hyper hyperReadHexToInt(int count, char iHexa[3]);
 void convReadHyperCharHexToInt(char *hex, hyper *SB);
-hyper* read_longlong(void* pStream);
+hyper read_longlong(XDRInputBuffer* pInputBuffer);
 
 /* This definition is for unsigned Hyper */
 u_hyper unhyperReadHexToInt(int count, char iHexa[3]);
 void convReadUnHyperCharHexToInt(char *hex, u_hyper *SB);
-u_hyper* read_u_longlong(void* pStream);
+u_hyper read_u_longlong(XDRInputBuffer* pInputBuffer);
 
-short int read_short(void* pStream);
-unsigned short int read_u_short(void* pStream);
+short int read_short(XDRInputBuffer* pInputBuffer);
+unsigned short int read_u_short(XDRInputBuffer* pInputBuffer);
 /*int read_byte(void* pStream);*/
-char read_byte(void* pStream);
-int read_boolean(void* pStream);
+char read_byte(XDRInputBuffer* pInputBuffer);
+int read_boolean(XDRInputBuffer* pInputBuffer);
 
 int convReadShortIntHexToShortInt(int count, char iHexa[3]);
 unsigned int convReadUShortIntHexToShortInt(int count, char iHexa[3]);
@@ -22,11 +22,35 @@
 #ifndef _XMLMARSHALLER_H
 #define _XMLMARSHALLER_H
 
+#include "utils/IPDRCommon.h"
+
 # define MAX_XML_STRING_LENGTH 300
 
+/* Characters written as entity references in XML text */
+#define IPDR_XML_SPECIAL_CHARACTERS		"&<>\"'"
+
+/* Longest entity reference written for one character, "&quot;" */
+#define IPDR_XML_MAX_ENTITY_LENGTH		6
+
 int write_xml(
 			  char *pXMLString, 
 			  void *pXMLStream
 			  );
 
+int escapeXMLString(
+			  const char *pInputString, 
+			  char *pOutputString
+			  );
+
+int appendXMLString(
+			  XDROutputBuffer *pOutputBuffer, 
+			  const char *pXMLString,
+			  int length
+			  );
+
+int appendEscapedXMLString(
+			  XDROutputBuffer *pOutputBuffer, 
+			  const char *pInputString
+			  );
+
 #endif
@@ -0,0 +1,63 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : XMLRecordTemplate          *
+ * Description          : Precompiled XML of record  *
+ *                        descriptors                *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#ifndef _XMLRECORDTEMPLATE_H
+#define _XMLRECORDTEMPLATE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils/IPDRCommon.h"
+
+/*
+ * The tags of a record type are built once, so that a record is
+ * written by copying tags and formatting values into the output
+ * buffer instead of one sprintf() and fprintf() per element. The
+ * output is the one of writeIPDRXMLRecordHelper().
+ */
+
+/* Derived types, as handled by writeIPDRXMLRecordHelper() */
+#define XML_DERIVED_NONE			0
+#define XML_DERIVED_IPV4ADDR		1
+#define XML_DERIVED_DATETIME		2
+#define XML_DERIVED_DATETIMEMSEC	3
+#define XML_DERIVED_DATETIMEUSEC	4
+#define XML_DERIVED_BYTEARRAY		5    /* IPV6ADDR, UUID, IPADDR */
+
+/* Room for any formatted scalar, DBL_MAX takes 316 characters with %f */
+#define XML_TEMPLATE_VALUE_LENGTH	400
+
+XMLRecordTemplate* newXMLRecordTemplate(const char* typeName,
+										const ListAttributeDescriptor* pListAttributeDescriptor);
+int freeXMLRecordTemplate(XMLRecordTemplate* pRecordTemplate);
+
+const XMLRecordTemplate* getXMLRecordTemplate(IPDRCommonParameters* pIPDRCommonParameters,
+											  FNFData* pFNFData,
+											  int* pErrorCode);
+
+int writeXMLRecordTemplate(IPDRCommonParameters* pIPDRCommonParameters,
+						   const XMLRecordTemplate* pRecordTemplate,
+						   FNFData* pFNFData,
+						   const char* creationTime,
+						   int* pErrorCode);
+
+#endif
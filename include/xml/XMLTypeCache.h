@@ -0,0 +1,70 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : XMLTypeCache               *
+ * Description          : Schema types of XML record *
+ *                        shapes, resolved once      *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#ifndef _XMLTYPECACHE_H
+#define _XMLTYPECACHE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils/IPDRCommon.h"
+
+/*
+ * The attribute and derived types a record read from XML gets from
+ * the schema depend only on its type name and element names. They
+ * are resolved by getAttributeTypeFromSchema() or
+ * getComplexAttributeTypeFromSchema() for the first record of a shape
+ * and copied from the cache for the following ones.
+ */
+
+/*!
+ *  Outcome of the schema lookup for one attribute. A NULL
+ *  resolvedName_ or attributeType_ means the lookup left the
+ *  descriptor unchanged.
+ */
+typedef struct XMLResolvedAttribute
+{
+	char* attributeName_;    /* Element name as read */
+	char* complexType_;      /* Complex type as read */
+	char* resolvedName_;
+	char* attributeType_;
+	char* derivedType_;
+} XMLResolvedAttribute;
+
+typedef struct XMLTypeResolution
+{
+	char* typeName_;
+	int isComplex_;          /* IPDR_TRUE if resolved for a v3.5 record */
+	XMLResolvedAttribute* pAttributes_;
+	int noOfAttributes_;
+	XMLResolvedAttribute* pServiceAttributes_;
+	int noOfServiceAttributes_;
+} XMLTypeResolution;
+
+int freeXMLTypeResolution(XMLTypeResolution* pTypeResolution);
+
+int resolveXMLAttributeTypes(IPDRCommonParameters* pIPDRCommonParameters,
+							 FNFData* pFNFData,
+							 int isComplex,
+							 int* pErrorCode);
+
+#endif
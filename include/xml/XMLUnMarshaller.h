@@ -22,6 +22,7 @@
 #ifndef _XMLUNMARSHALLER_H
 #define _XMLUNMARSHALLER_H
 
+#include "expat.h"
 #include "utils/IPDRCommon.h"
 #include "utils/errorCode.h"
 #include "utils/utils.h"
@@ -35,6 +36,9 @@
 
 #define IPDR_XML_MAX_SCHEMA_LOCATION	400
 
+/* Bytes handed to the parser per read */
+#define IPDR_XML_READ_CHUNK		65536
+
 
 #define IPDR_XML_SEQ_NUM                "seqNum"
 
@@ -48,6 +52,7 @@ typedef struct XMLUnMarshallerCommon {
 	char *token_;
 	char *attributeName_;
 	char *attributeValue_;
+	int attributeValueCapacity_;	/* Bytes allocated to attributeValue_ */
 	int Depth_;
 	int IPDRDocEnd_;
 	int flagValue_;
@@ -66,8 +71,26 @@ typedef struct XMLUnMarshallerCommon {
 	ListFNFData* pListFNFData_;
 	ListIPDRComplex* pListIPDRComplex_;
 	DocEnd* pGDocEnd_;
+	char version_[MAX_SCHEMA_VERSION];	/* Version the document must match */
 	} XMLUnMarshallerCommon;
 
+/*!
+ *  Pull parser over an XML document. The input is fed to expat in
+ *  chunks of IPDR_XML_READ_CHUNK bytes and the parse is suspended
+ *  after the IPDRDoc start tag and after every IPDR element, so only
+ *  the record being read is held in memory.
+ */
+typedef struct XMLStreamReader {
+	XML_Parser xmlParser_;
+	XMLUnMarshallerCommon* pXMLUnMarshallerCommon_;
+	char* pText_;            /* Character data since the last tag */
+	int textLength_;
+	int textCapacity_;
+	int suspended_;          /* Parse stopped inside the current chunk */
+	int lastChunk_;          /* End of the stream was fed to the parser */
+	int finished_;           /* Whole document parsed */
+	} XMLStreamReader;
+
 int readXMLStreamData(
 			   IPDRCommonParameters *pIPDRCommonParameters,
 			   IPDRHeader *pIPDRHeader,
@@ -75,6 +98,18 @@ int readXMLStreamData(
 			  );
 
 
+int readXMLStreamRecord(
+			   IPDRCommonParameters *pIPDRCommonParameters,
+			   int* pErrorCode
+			  );
+
+int closeXMLStreamData(
+			   IPDRCommonParameters *pIPDRCommonParameters,
+			   int* pErrorCode
+			  );
+
+int freeXMLStreamReader(XMLStreamReader* pXMLStreamReader);
+
 int isNameSpaceInfo(char *source);
 
 
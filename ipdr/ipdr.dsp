@@ -131,6 +131,22 @@ SOURCE=..\source\utils\hashtable.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\source\utils\IPDRArena.c
+# End Source File
+# Begin Source File
+
+SOURCE=..\source\utils\IPDRFlatRecord.c
+# End Source File
+# Begin Source File
+
+SOURCE=..\source\utils\IPDRMap.c
+# End Source File
+# Begin Source File
+
+SOURCE=..\source\common\IPDRBatchConverter.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\source\common\IPDRDocReader.c
 # End Source File
 # Begin Source File
@@ -155,6 +171,10 @@ SOURCE=..\source\xdr\IPDRStreamElementHelper.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\source\utils\IPDRThread.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\ipdrWin32.def
 # End Source File
 # Begin Source File
@@ -199,10 +219,22 @@ SOURCE=..\source\common\schema.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\source\common\schemaCache.c
+# End Source File
+# Begin Source File
+
+SOURCE=..\source\common\schemaRegistry.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\source\utils\schemaUtil.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\source\utils\schemaValidator.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\source\utils\serialize.c
 # End Source File
 # Begin Source File
@@ -227,6 +259,22 @@ SOURCE=..\source\xdr\XDRMarshaller.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\source\xdr\XDRPrimitives.c
+# End Source File
+# Begin Source File
+
+SOURCE=..\source\xdr\XDROutputBuffer.c
+# End Source File
+# Begin Source File
+
+SOURCE=..\source\xdr\XDRInputBuffer.c
+# End Source File
+# Begin Source File
+
+SOURCE=..\source\xdr\XDRCodecPlan.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\source\xdr\XDRUnMarshaller.c
 # End Source File
 # Begin Source File
@@ -235,6 +283,14 @@ SOURCE=..\source\xml\XMLMarshaller.c
 # End Source File
 # Begin Source File
 
+SOURCE=..\source\xml\XMLRecordTemplate.c
+# End Source File
+# Begin Source File
+
+SOURCE=..\source\xml\XMLTypeCache.c
+# End Source File
+# Begin Source File
+
 SOURCE=..\source\xml\XMLUnMarshaller.c
 # End Source File
 # End Group
@@ -299,10 +355,26 @@ SOURCE=..\include\utils\hashtable.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\include\utils\IPDRArena.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\include\utils\IPDRFlatRecord.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\include\utils\IPDRMap.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\include\utils\IPDRCommon.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\include\common\IPDRBatchConverter.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\include\common\IPDRDocReader.h
 # End Source File
 # Begin Source File
@@ -331,6 +403,10 @@ SOURCE=..\include\xdr\IPDRStreamElementHelper.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\include\utils\IPDRThread.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\include\test\IPDRWriteTool.h
 # End Source File
 # Begin Source File
@@ -375,10 +451,22 @@ SOURCE=..\include\common\schema.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\include\common\schemaCache.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\include\common\schemaRegistry.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\include\utils\schemaUtil.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\include\utils\schemaValidator.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\include\utils\serialize.h
 # End Source File
 # Begin Source File
@@ -407,6 +495,22 @@ SOURCE=..\include\xdr\XDRMarshaller.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\include\xdr\XDRPrimitives.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\include\xdr\XDROutputBuffer.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\include\xdr\XDRInputBuffer.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\include\xdr\XDRCodecPlan.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\include\xdr\XDRUnMarshaller.h
 # End Source File
 # Begin Source File
@@ -415,6 +519,14 @@ SOURCE=..\include\xml\XMLMarshaller.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\include\xml\XMLRecordTemplate.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\include\xml\XMLTypeCache.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\include\xml\XMLUnMarshaller.h
 # End Source File
 # End Group
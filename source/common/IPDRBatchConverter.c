@@ -0,0 +1,584 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/******************************************************
+ * File                 : IPDRBatchConverter.c        *
+ * Description          : Converts batches of         *
+ *                        documents on a thread pool  *
+ * Author               : Infosys Tech Ltd            *
+ * Modification History :                             *
+ *--------------------------------------------------- *
+ * Date       Name        Change/Description          *
+ *--------------------------------------------------- *
+ *                                                    *
+ ******************************************************/
+
+#include "common/IPDRBatchConverter.h"
+#include "common/IPDRDocReader.h"
+#include "common/IPDRDocWriter.h"
+#include "common/schemaRegistry.h"
+#include "utils/IPDRMap.h"
+#include "utils/IPDRMemory.h"
+#include "utils/IPDRThread.h"
+#include "utils/utils.h"
+#include "utils/errorCode.h"
+#include "xdr/XDRInputBuffer.h"
+
+/*!
+ *  Jobs dealt to one worker. The worker takes jobs from the head,
+ *  other workers steal them from the tail.
+ */
+typedef struct ConversionQueue
+{
+	IPDRMutex mutex_;
+	int* pJobIndexes_;
+	int head_;
+	int tail_;
+} ConversionQueue;
+
+/*!
+ *  State shared by the workers of one convertIPDRDocuments() call
+ */
+typedef struct ConversionPool
+{
+	IPDRConversionJob* pJobs_;
+	ConversionQueue* pQueues_;
+	int noOfQueues_;
+	char* schemaVersion_;
+	int schemaValidation_;
+} ConversionPool;
+
+/*!
+ *  Position of a job in the order the jobs are dealt in
+ */
+typedef struct ConversionOrder
+{
+	long size_;
+	int index_;
+} ConversionOrder;
+
+typedef struct ConversionWorker
+{
+	ConversionPool* pPool_;
+	int queue_;              /* Queue owned by the worker */
+} ConversionWorker;
+
+
+/*!
+ *  NAME:
+ *      newConversionParameters() - parameters of one side of a
+ *      conversion
+ *
+ *  ARGUMENTS:
+ *	    - docType {IN}
+ *	    - streamName {IN}
+ *	    - pStream {IN}, closed with the parameters
+ *	    - schemaVersion {IN}
+ *
+ *  RETURNS
+ *	     Returns the parameters, or NULL if memory allocation failed,
+ *	     in which case pStream is closed
+ */
+
+static IPDRCommonParameters* newConversionParameters(DocType docType,
+													 char* streamName,
+													 FILE* pStream,
+													 char* schemaVersion)
+{
+	IPDRCommonParameters* pIPDRCommonParameters = NULL;
+
+	pIPDRCommonParameters = newIPDRCommonParameters();
+	if (pIPDRCommonParameters == NULL) {
+		fclose(pStream);
+		return (NULL);
+	}
+
+	pIPDRCommonParameters->DocType_ = docType;
+	pIPDRCommonParameters->DocState_ = NONWRITABLE;
+	pIPDRCommonParameters->pStreamHandle_ = pStream;
+	pIPDRCommonParameters->descriptorCount_ = 1;
+	pIPDRCommonParameters->pDescriptorLookupMap_ = newIPDRIntMap(9, free);
+	pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_ = 1;
+	strcpy(pIPDRCommonParameters->schemaVersion, schemaVersion);
+	pIPDRCommonParameters->pStreamName_ = (char *) calloc(strlen(streamName) + 1, sizeof(char));
+	if (pIPDRCommonParameters->pDescriptorLookupMap_ == NULL ||
+		pIPDRCommonParameters->pStreamName_ == NULL) {
+		freeIPDRCommonParameters(pIPDRCommonParameters);
+		return (NULL);
+	}
+	strcpy(pIPDRCommonParameters->pStreamName_, streamName);
+
+	return (pIPDRCommonParameters);
+}
+
+
+/*!
+ *  NAME:
+ *      getIPDRFileSize() - size of a file
+ *
+ *  ARGUMENTS:
+ *	    - fileName {IN}
+ *
+ *  RETURNS
+ *	     Returns the size in bytes, or 0 if the file can not be read
+ */
+
+static long getIPDRFileSize(char* fileName)
+{
+	struct stat fileStat;
+
+	if (stat(fileName, &fileStat) != 0)
+		return (0);
+	return ((long) fileStat.st_size);
+}
+
+
+/*!
+ *  NAME:
+ *      completeXMLDescriptors() - gives the attributes of a record read
+ *      from XML the complex type the writers expect
+ *
+ *  DESCRIPTION:
+ *         Descriptors read from XML leave the complex type of primitive
+ *         attributes unset; it is set empty, as the XDR reader does.
+ *
+ *  ARGUMENTS:
+ *	    - pFNFData {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK, or IPDR_ERROR if memory allocation failed
+ */
+
+static int completeXMLDescriptors(FNFData* pFNFData)
+{
+	ListAttributeDescriptor* pCurrent = NULL;
+
+	for (pCurrent = pFNFData->pListAttributeDescriptor_; pCurrent != NULL;
+		 pCurrent = pCurrent->pNext_) {
+		if (pCurrent->pAttributeDescriptor_->complexType_ != NULL)
+			continue;
+		pCurrent->pAttributeDescriptor_->complexType_ =
+			(char *) calloc(MAX_ATTRIBUTE_TYPE, sizeof(char));
+		if (pCurrent->pAttributeDescriptor_->complexType_ == NULL)
+			return (IPDR_ERROR);
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      convertIPDRDocument() - converts one document
+ *
+ *  DESCRIPTION:
+ *         Reads the input document of the job and writes its header
+ *         and records to the output document, in the output type of
+ *         the job. With schemaValidation set, the reader and the writer
+ *         use the shared schema of the service definitions of the
+ *         document, and the writer validates every record against it.
+ *         An XML input is always read with the shared schema, which
+ *         gives the types of its attributes.
+ *
+ *  ARGUMENTS:
+ *	    - pJob {IN/OUT}, errorCode_, noOfRecords_ and noOfBytes_ are
+ *	      set
+ *	    - schemaVersion {IN}
+ *	    - schemaValidation {IN}
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK, or IPDR_ERROR with pJob->errorCode_ set
+ */
+
+int convertIPDRDocument(IPDRConversionJob* pJob,
+						char* schemaVersion,
+						int schemaValidation)
+{
+	int errorSeverity = IPDR_ERROR;
+	int errorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+	FILE* pStream = NULL;
+	IPDRCommonParameters* pReader = NULL;
+	IPDRCommonParameters* pWriter = NULL;
+	IPDRHeader* pIPDRHeader = NULL;
+	FNFData* pFNFData = NULL;
+	DocEnd* pDocEnd = NULL;
+	ListNameSpaceInfo* pNameSpaceInfo = NULL;
+	ListSchemaNameSpace* pListSchemaNameSpace = NULL;
+
+	if (pJob == NULL || schemaVersion == NULL)
+		return (IPDR_ERROR);
+
+	pJob->noOfRecords_ = 0;
+	pJob->noOfBytes_ = 0;
+	if (pJob->pInputFileName_ == NULL || pJob->pOutputFileName_ == NULL) {
+		pJob->errorCode_ = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+	if (pJob->inputType_ != XDR && pJob->inputType_ != XML) {
+		pJob->errorCode_ = IPDR_CONVERSION_INPUT_UNSUPPORTED;
+		return (IPDR_ERROR);
+	}
+	pJob->noOfBytes_ = getIPDRFileSize(pJob->pInputFileName_);
+
+	pIPDRHeader = newIPDRHeader();
+	pDocEnd = newDocEnd();
+	if (pIPDRHeader == NULL || pDocEnd == NULL)
+		goto cleanup;
+
+	pStream = fopen(pJob->pInputFileName_, "rb");
+	if (pStream == NULL) {
+		errorCode = IPDR_INVALID_FILE;
+		goto cleanup;
+	}
+	pReader = newConversionParameters(pJob->inputType_, pJob->pInputFileName_, pStream,
+									  schemaVersion);
+	if (pReader == NULL)
+		goto cleanup;
+
+	pStream = fopen(pJob->pOutputFileName_, "wb");
+	if (pStream == NULL) {
+		errorCode = IPDR_INVALID_FILE;
+		goto cleanup;
+	}
+	pWriter = newConversionParameters(pJob->outputType_, pJob->pOutputFileName_,
+									  pStream, schemaVersion);
+	if (pWriter == NULL)
+		goto cleanup;
+
+	if (pJob->inputType_ == XDR &&
+		setXDRInputBuffer(pReader, XDR_INPUT_MMAP, &errorCode) == IPDR_ERROR)
+		goto cleanup;
+	if (readHeader(pReader, pIPDRHeader, &errorCode) == IPDR_ERROR)
+		goto cleanup;
+
+	/* XML records are typed from the schema, so it is always read for them */
+	if ((schemaValidation || pJob->inputType_ == XML) &&
+		acquireSchemaData(pReader, pIPDRHeader->pOtherNameSpaceInfo_,
+						  pIPDRHeader->pListServiceDefinitionURI_,
+						  pIPDRHeader->defaultNameSpaceURI_, &errorCode) == IPDR_ERROR)
+		goto cleanup;
+	if (schemaValidation &&
+		acquireSchemaData(pWriter, pIPDRHeader->pOtherNameSpaceInfo_,
+						  pIPDRHeader->pListServiceDefinitionURI_,
+						  pIPDRHeader->defaultNameSpaceURI_, &errorCode) == IPDR_ERROR)
+		goto cleanup;
+
+	for (pNameSpaceInfo = pIPDRHeader->pOtherNameSpaceInfo_; pNameSpaceInfo != NULL;
+		 pNameSpaceInfo = pNameSpaceInfo->pNext_)
+		appendListSchemaNameSpace(&pListSchemaNameSpace,
+								  pNameSpaceInfo->NameSpaceInfo_.nameSpaceURI_);
+
+	if (writeHeader(pWriter, pIPDRHeader->startTime_, pIPDRHeader->ipdrRecorderInfo_,
+					pIPDRHeader->defaultNameSpaceURI_, pIPDRHeader->pOtherNameSpaceInfo_,
+					pIPDRHeader->pListServiceDefinitionURI_, pIPDRHeader->docID_,
+					pListSchemaNameSpace, &errorCode) == IPDR_ERROR)
+		goto cleanup;
+
+	while (1) {
+		pFNFData = newFNFData();
+		if (readIPDR(pReader, &pFNFData, &errorCode) == IPDR_ERROR)
+			goto cleanup;
+		if (pFNFData == NULL)
+			break;
+		if (pJob->inputType_ == XML && completeXMLDescriptors(pFNFData) != IPDR_OK) {
+			errorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			goto cleanup;
+		}
+		if (writeIPDR(pWriter, pFNFData, &errorCode) == IPDR_ERROR)
+			goto cleanup;
+		freeFNFData(pFNFData);
+		pFNFData = NULL;
+		pJob->noOfRecords_++;
+	}
+
+	if (readDocEnd(pReader, pDocEnd, &errorCode) == IPDR_ERROR ||
+		writeDocEnd(pWriter, &errorCode) == IPDR_ERROR)
+		goto cleanup;
+
+	errorCode = 0;
+	errorSeverity = IPDR_OK;
+
+cleanup:
+	freeFNFData(pFNFData);
+	freeListSchemaNameSpace(&pListSchemaNameSpace);
+	if (pIPDRHeader != NULL)
+		freeIPDRHeader(pIPDRHeader);
+	if (pDocEnd != NULL)
+		freeDocEnd(pDocEnd);
+	if (pReader != NULL)
+		freeIPDRCommonParameters(pReader);
+	if (pWriter != NULL)
+		freeIPDRCommonParameters(pWriter);
+
+	pJob->errorCode_ = errorCode;
+	return (errorSeverity);
+}
+
+
+/*!
+ *  NAME:
+ *      takeConversionJob() - next job of a worker
+ *
+ *  DESCRIPTION:
+ *         Takes the job at the head of the worker's own queue. Once
+ *         that is empty, steals the job at the tail of the queue with
+ *         the most jobs left.
+ *
+ *  ARGUMENTS:
+ *	    - pPool {IN/OUT}
+ *	    - queue {IN}, the worker's queue
+ *
+ *  RETURNS
+ *	     Returns the job index, or -1 when no jobs are left
+ */
+
+static int takeConversionJob(ConversionPool* pPool, int queue)
+{
+	int jobIndex = -1;
+	int count = 0;
+	int victim = -1;
+	int mostJobs = 0;
+	int noOfJobs = 0;
+	ConversionQueue* pQueue = &pPool->pQueues_[queue];
+
+	lockIPDRMutex(&pQueue->mutex_);
+	if (pQueue->head_ < pQueue->tail_)
+		jobIndex = pQueue->pJobIndexes_[pQueue->head_++];
+	unlockIPDRMutex(&pQueue->mutex_);
+
+	while (jobIndex < 0) {
+		victim = -1;
+		mostJobs = 0;
+		for (count = 0; count < pPool->noOfQueues_; count++) {
+			pQueue = &pPool->pQueues_[count];
+			lockIPDRMutex(&pQueue->mutex_);
+			noOfJobs = pQueue->tail_ - pQueue->head_;
+			unlockIPDRMutex(&pQueue->mutex_);
+			if (noOfJobs > mostJobs) {
+				mostJobs = noOfJobs;
+				victim = count;
+			}
+		}
+		if (victim < 0)
+			break;
+
+		/* The victim may have emptied its queue since it was counted */
+		pQueue = &pPool->pQueues_[victim];
+		lockIPDRMutex(&pQueue->mutex_);
+		if (pQueue->head_ < pQueue->tail_)
+			jobIndex = pQueue->pJobIndexes_[--pQueue->tail_];
+		unlockIPDRMutex(&pQueue->mutex_);
+	}
+
+	return (jobIndex);
+}
+
+
+/*!
+ *  NAME:
+ *      runConversionWorker() - converts jobs until none are left
+ *
+ *  ARGUMENTS:
+ *	    - pArgument {IN}, the ConversionWorker
+ *
+ *  RETURNS
+ *	     Nothing
+ */
+
+static void runConversionWorker(void* pArgument)
+{
+	int jobIndex = 0;
+	ConversionWorker* pWorker = (ConversionWorker *) pArgument;
+	ConversionPool* pPool = pWorker->pPool_;
+
+	while ((jobIndex = takeConversionJob(pPool, pWorker->queue_)) >= 0)
+		convertIPDRDocument(&pPool->pJobs_[jobIndex], pPool->schemaVersion_,
+							pPool->schemaValidation_);
+}
+
+
+/*!
+ *  NAME:
+ *      compareJobSizes() - orders jobs by input size, largest first
+ */
+
+static int compareJobSizes(const void* pFirst, const void* pSecond)
+{
+	const ConversionOrder* pFirstOrder = (const ConversionOrder *) pFirst;
+	const ConversionOrder* pSecondOrder = (const ConversionOrder *) pSecond;
+
+	if (pFirstOrder->size_ != pSecondOrder->size_)
+		return (pFirstOrder->size_ > pSecondOrder->size_ ? -1 : 1);
+	return (pFirstOrder->index_ - pSecondOrder->index_);
+}
+
+
+/*!
+ *  NAME:
+ *      convertIPDRDocuments() - converts documents on a pool of
+ *      worker threads
+ *
+ *  DESCRIPTION:
+ *         Runs convertIPDRDocument() for every job. The calling thread
+ *         is one of the workers. The outcome of each job is left in the
+ *         job, and the totals and throughput of the batch in
+ *         pStatistics.
+ *
+ *  ARGUMENTS:
+ *	    - pJobs {IN/OUT}
+ *	    - noOfJobs {IN}
+ *	    - noOfThreads {IN}, 0 for one per processor
+ *	    - schemaVersion {IN}
+ *	    - schemaValidation {IN}
+ *	    - pStatistics {OUT}
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK if all documents were converted, IPDR_WARNING
+ *	     if some were not or fewer threads could be started, with
+ *	     pErrorCode set to the first error, or IPDR_ERROR if the batch
+ *	     could not be run
+ */
+
+int convertIPDRDocuments(IPDRConversionJob* pJobs,
+						 int noOfJobs,
+						 int noOfThreads,
+						 char* schemaVersion,
+						 int schemaValidation,
+						 IPDRConversionStatistics* pStatistics,
+						 int* pErrorCode)
+{
+	int errorSeverity = IPDR_OK;
+	int count = 0;
+	int queue = 0;
+	int offset = 0;
+	int noOfStarted = 0;
+	int* pJobIndexes = NULL;
+	hyper startTime = 0;
+	hyper endTime = 0;
+	ConversionOrder* pOrder = NULL;
+	ConversionPool pool;
+	ConversionWorker* pWorkers = NULL;
+	IPDRThread* pThreads = NULL;
+
+	if (pJobs == NULL || schemaVersion == NULL || pStatistics == NULL || noOfJobs < 0) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	memset(pStatistics, 0, sizeof(IPDRConversionStatistics));
+	if (noOfJobs == 0)
+		return (IPDR_OK);
+
+	if (noOfThreads <= 0)
+		noOfThreads = getIPDRProcessorCount();
+	if (noOfThreads > noOfJobs)
+		noOfThreads = noOfJobs;
+
+	memset(&pool, 0, sizeof(ConversionPool));
+	pOrder = (ConversionOrder *) calloc(noOfJobs, sizeof(ConversionOrder));
+	pJobIndexes = (int *) calloc(noOfJobs, sizeof(int));
+	pWorkers = (ConversionWorker *) calloc(noOfThreads, sizeof(ConversionWorker));
+	pThreads = (IPDRThread *) calloc(noOfThreads, sizeof(IPDRThread));
+	pool.pQueues_ = (ConversionQueue *) calloc(noOfThreads, sizeof(ConversionQueue));
+	if (pOrder == NULL || pJobIndexes == NULL || pWorkers == NULL ||
+		pThreads == NULL || pool.pQueues_ == NULL) {
+		free(pOrder);
+		free(pJobIndexes);
+		free(pWorkers);
+		free(pThreads);
+		free(pool.pQueues_);
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return (IPDR_ERROR);
+	}
+
+	for (count = 0; count < noOfJobs; count++) {
+		pOrder[count].index_ = count;
+		if (pJobs[count].pInputFileName_ != NULL)
+			pOrder[count].size_ = getIPDRFileSize(pJobs[count].pInputFileName_);
+	}
+	qsort(pOrder, noOfJobs, sizeof(ConversionOrder), compareJobSizes);
+
+	pool.pJobs_ = pJobs;
+	pool.noOfQueues_ = noOfThreads;
+	pool.schemaVersion_ = schemaVersion;
+	pool.schemaValidation_ = schemaValidation;
+
+	/* Queue i holds jobs i, i + n, i + 2n ... of the sorted order */
+	for (queue = 0; queue < noOfThreads; queue++) {
+		if (initIPDRMutex(&pool.pQueues_[queue].mutex_) != IPDR_OK) {
+			while (--queue >= 0)
+				destroyIPDRMutex(&pool.pQueues_[queue].mutex_);
+			free(pOrder);
+			free(pJobIndexes);
+			free(pWorkers);
+			free(pThreads);
+			free(pool.pQueues_);
+			*pErrorCode = IPDR_THREAD_CREATE_FAILED;
+			return (IPDR_ERROR);
+		}
+		pool.pQueues_[queue].pJobIndexes_ = pJobIndexes;
+		pool.pQueues_[queue].head_ = offset;
+		for (count = queue; count < noOfJobs; count += noOfThreads)
+			pJobIndexes[offset++] = pOrder[count].index_;
+		pool.pQueues_[queue].tail_ = offset;
+		pWorkers[queue].pPool_ = &pool;
+		pWorkers[queue].queue_ = queue;
+	}
+	free(pOrder);
+
+	getTime(&startTime, pErrorCode);
+
+	/* Worker 0 runs on the calling thread */
+	for (count = 1; count < noOfThreads; count++) {
+		if (startIPDRThread(&pThreads[noOfStarted], runConversionWorker,
+							&pWorkers[count]) != IPDR_OK) {
+			*pErrorCode = IPDR_THREAD_CREATE_FAILED;
+			errorSeverity = IPDR_WARNING;
+			continue;
+		}
+		noOfStarted++;
+	}
+	runConversionWorker(&pWorkers[0]);
+	for (count = 0; count < noOfStarted; count++)
+		joinIPDRThread(&pThreads[count]);
+
+	getTime(&endTime, pErrorCode);
+
+	pStatistics->noOfThreads_ = noOfStarted + 1;
+	pStatistics->elapsedSeconds_ = (double) (endTime - startTime) / 1000.0;
+	for (count = 0; count < noOfJobs; count++) {
+		if (pJobs[count].errorCode_ != 0) {
+			if (pStatistics->noOfFailures_ == 0 && errorSeverity == IPDR_OK)
+				*pErrorCode = pJobs[count].errorCode_;
+			pStatistics->noOfFailures_++;
+			errorSeverity = IPDR_WARNING;
+			continue;
+		}
+		pStatistics->noOfDocuments_++;
+		pStatistics->noOfRecords_ += pJobs[count].noOfRecords_;
+		pStatistics->noOfBytes_ += (double) pJobs[count].noOfBytes_;
+	}
+	if (pStatistics->elapsedSeconds_ > 0) {
+		pStatistics->recordsPerSecond_ =
+			(double) pStatistics->noOfRecords_ / pStatistics->elapsedSeconds_;
+		pStatistics->bytesPerSecond_ =
+			pStatistics->noOfBytes_ / pStatistics->elapsedSeconds_;
+	}
+
+	for (queue = 0; queue < noOfThreads; queue++)
+		destroyIPDRMutex(&pool.pQueues_[queue].mutex_);
+	free(pJobIndexes);
+	free(pWorkers);
+	free(pThreads);
+	free(pool.pQueues_);
+
+	return (errorSeverity);
+}
@@ -53,6 +53,13 @@ int readHeader(
     
 	/* Populate IPDRDoc header structure with values in XDR document*/		
 	if(pIPDRCommonParameters->DocType_ == XDR) {
+		errorSeverity = attachXDRInputBuffer(pIPDRCommonParameters, pErrorCode);
+		if (errorSeverity == IPDR_ERROR) {
+			pIPDRCommonParameters->DocState_ = NONREADABLE; 
+			exceptionHandler(pIPDRCommonParameters, pErrorCode, "attachXDRInputBuffer");	
+			return (IPDR_ERROR);
+		}
+
 		errorSeverity = readIPDRXDRHeaderHelper(pIPDRCommonParameters, pIPDRHeader, pErrorCode);		
 		if (errorSeverity == IPDR_WARNING) {
 			errorHandler(pIPDRCommonParameters, pErrorCode, "readIPDRXDRHeaderHelper");	
@@ -87,365 +94,1543 @@ int readHeader(
 
 /*!
  *  NAME:
- *      readIPDR() - 	reads IPDR data and/or descriptor from the XDR file 
+ *      projectFNFData() - drops the attributes outside the projection
  *
  *  DESCRIPTION:
- *      This function
- *       - Calls readIPDRStreamElementHelper
- *		 - Depending on the value of descriminator, calls following functions
- *		   a. Calls "addDescriptor", if value of descriminator is 1
- *		   b. Increments the value of ipdrCount, if value of descriminator is 2
- *		   c. Returns null to Stream Pointer, if value of descriminator is 3	
- *		 - Calls validateAgainstSchema
+ *      Removes from a fully read record the attribute descriptors
+ *      outside the projection of the document, with their values.
+ *      Nodes of a record in an arena are only unlinked.
  *
  *  ARGUMENTS:
- *       -	IPDRCommonParameters (IN/OUT)	
+ *       -	IPDRCommonParameters (IN)
  * 		 -	FNFData (IN/OUT)
  *
- *  RETURNS 	
+ *  RETURNS
+ *	     Nothing
+*/
+
+static void projectFNFData(
+			 IPDRCommonParameters* pIPDRCommonParameters,
+			 FNFData* pFNFData
+			)
+{
+	int slot = 0;
+	ListAttributeDescriptor** ppAttribute = &pFNFData->pListAttributeDescriptor_;
+	ListAttributeDescriptor* pAttribute;
+	ListIPDRData** ppValue = &pFNFData->pListIPDRData_;
+	ListIPDRData* pValue;
+
+	while (*ppAttribute != NULL && *ppValue != NULL) {
+		if (getIPDRStringMap(pIPDRCommonParameters->pProjection_,
+							 (*ppAttribute)->pAttributeDescriptor_->attributeName_,
+							 &slot) == IPDR_TRUE) {
+			ppAttribute = &(*ppAttribute)->pNext_;
+			ppValue = &(*ppValue)->pNext_;
+			continue;
+		}
+
+		pAttribute = *ppAttribute;
+		*ppAttribute = pAttribute->pNext_;
+		pValue = *ppValue;
+		*ppValue = pValue->pNext_;
+
+		/* Nodes of a record in an arena are freed with the arena */
+		if (pFNFData->pArena_ != NULL)
+			continue;
+
+		pAttribute->pNext_ = NULL;
+		freeListAttributeDescriptor(&pAttribute);
+		pValue->pNext_ = NULL;
+		freeListIPDRData(&pValue);
+	}
+}
+
+
+/*!
+ *  NAME:
+ *      readXDRDescriptor() - reads a record descriptor from the XDR file
+ *
+ *  DESCRIPTION:
+ *      Adds the descriptor, its discriminator having been read, and
+ *      appends its service attributes to the document.
+ *
+ *  ARGUMENTS:
+ *       -	IPDRCommonParameters (IN/OUT)
+ *
+ *  RETURNS
  *	     Returns Zero or appropriate error code
 */
 
-int readIPDR(
-			 IPDRCommonParameters* pIPDRCommonParameters, 
-			 FNFData** pFNFData, 
+static int readXDRDescriptor(
+			 IPDRCommonParameters* pIPDRCommonParameters,
 			 int* pErrorCode
 			)
 {
-	int descriptorID = 0;
 	int errorSeverity = 0;
-	int descriminator = 0;
-	static lFound = 1;
-
 	IPDRStreamElement* pIPDRStreamElement;
-	RecordDescriptor* pRecordDescriptor;
 	ListAttributeDescriptor* pCurrent;
-	ListAttributeDescriptor* pListAttributeDescriptorTemp = NULL;
-	static ListAttributeDescriptor* pListServiceAttributeDescriptorTemp = NULL;
-	ListIPDRData* pFirst;
-	void* IPDRValue =  NULL;
-	
-	if(pFNFData == NULL || pIPDRCommonParameters == NULL) {
-	    *pErrorCode = IPDR_NULL_INPUT_PARAMETER;
-	    return (IPDR_ERROR);
+
+	pIPDRStreamElement = 
+			newIPDRStreamElement(STREAM_RECORD_DESCRIPTOR);
+
+	if(pIPDRStreamElement == NULL) {
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return(IPDR_ERROR);
 	}
 
-	if (pIPDRCommonParameters->DocState_ != READABLE) {
-		*pErrorCode = IPDR_INVALID_DOCSTATE_MAKE_READABLE;
+	pIPDRStreamElement->descriminator_ = STREAM_RECORD_DESCRIPTOR;
+
+	errorSeverity = readIPDRStreamElementHelper(pIPDRCommonParameters, pIPDRStreamElement,
+																pIPDRCommonParameters->pListServiceAttributeDescriptor_,
+																pErrorCode);	
+	if (errorSeverity == IPDR_WARNING) {
+		errorHandler(pIPDRCommonParameters, pErrorCode, "readIPDRStreamElementHelper");	
+	}
+	else if (errorSeverity == IPDR_ERROR) {
+		pIPDRCommonParameters->DocState_ = NONREADABLE; 
+		exceptionHandler(pIPDRCommonParameters, pErrorCode, "readIPDRStreamElementHelper");	
 		return (IPDR_ERROR);
 	}
 
-	if(pIPDRCommonParameters->DocType_ == XDR) {
-		descriminator = read_long(pIPDRCommonParameters->pStreamHandle_);  
-		
-		switch (descriminator)
-		{
-			case STREAM_RECORD_DESCRIPTOR:
-				
-				pIPDRStreamElement = 
-						newIPDRStreamElement(STREAM_RECORD_DESCRIPTOR);
-				
-				if(pIPDRStreamElement == NULL) {
-					*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
-					return(IPDR_ERROR);
-				}
-				
-				pIPDRStreamElement->descriminator_ = descriminator;
-				
-				errorSeverity = readIPDRStreamElementHelper(pIPDRCommonParameters, pIPDRStreamElement,
-																			 pListServiceAttributeDescriptorTemp,
-																			pErrorCode);	
-				if (errorSeverity == IPDR_WARNING) {
-					errorHandler(pIPDRCommonParameters, pErrorCode, "readIPDRStreamElementHelper");	
-				}
-				else if (errorSeverity == IPDR_ERROR) {
-					pIPDRCommonParameters->DocState_ = NONREADABLE; 
-					exceptionHandler(pIPDRCommonParameters, pErrorCode, "readIPDRStreamElementHelper");	
-					return (IPDR_ERROR);
-				}
+	errorSeverity = addDescriptor(pIPDRCommonParameters, pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_, pErrorCode);
+	if (errorSeverity == IPDR_WARNING) {
+		errorHandler(pIPDRCommonParameters, pErrorCode, "addDescriptor");	
+	}
+	else if (errorSeverity == IPDR_ERROR) {
+		pIPDRCommonParameters->DocState_ = NONREADABLE; 
+		exceptionHandler(pIPDRCommonParameters, pErrorCode, "addDescriptor");	
+		return (IPDR_ERROR);
+	}
 
-				errorSeverity = addDescriptor(pIPDRCommonParameters, pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_, pErrorCode);
-				if (errorSeverity == IPDR_WARNING) {
-					errorHandler(pIPDRCommonParameters, pErrorCode, "addDescriptor");	
-				}
-				else if (errorSeverity == IPDR_ERROR) {
-					pIPDRCommonParameters->DocState_ = NONREADABLE; 
-					exceptionHandler(pIPDRCommonParameters, pErrorCode, "addDescriptor");	
-					return (IPDR_ERROR);
-				}
+	/* Records read into a caller's FNFData take the new layout */
+	pIPDRCommonParameters->readGeneration_ = nextIPDRReadGeneration();
 
-				pCurrent = pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_;
-
-				while (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_ != NULL) {
-					appendListAttributeDescriptor(&(pListServiceAttributeDescriptorTemp),
-									pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->attributeName_,
-									pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->attributeType_,
-									pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->description_,
-									pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->derivedType_,
-								   pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->complexType_, 
-								   pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->pListAttrNameList_, 
-								   pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->pListAttrClassList_, 
-								   pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->pListAttrMaxOccursList_, 
-								   pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ );
-				
-					pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_ = pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pNext_; 
-				}
+	pCurrent = pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_;
 
-				pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_ = pCurrent;
+	while (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_ != NULL) {
+		appendListAttributeDescriptor(&(pIPDRCommonParameters->pListServiceAttributeDescriptor_),
+						pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->attributeName_,
+						pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->attributeType_,
+						pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->description_,
+						pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->derivedType_,
+					pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->complexType_, 
+					pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->pListAttrNameList_, 
+					pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->pListAttrClassList_, 
+					pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->pListAttrMaxOccursList_, 
+					pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ );
 
-				freeIPDRStreamElement (pIPDRStreamElement);
+		pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_ = pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_->pNext_; 
+	}
 
-			case STREAM_IPDR_RECORD:
+	pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->pListServiceAttributeDescriptor_ = pCurrent;
 
-				pRecordDescriptor = newRecordDescriptor();
-				pIPDRStreamElement = newIPDRStreamElement(STREAM_IPDR_RECORD);
-				
-				if(pIPDRStreamElement == NULL || pRecordDescriptor == NULL) {
-					*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
-					return(IPDR_ERROR);
-				}
-				
-				if(descriminator == 2)
-					pIPDRStreamElement->descriminator_ = descriminator;
-				/*errorSeverity = readIPDRStreamElementHelper(pIPDRCommonParameters, 
-																		  pIPDRStreamElement, 
-																		  pErrorCode);	*/
-				errorSeverity = readIPDRStreamElementHelper(pIPDRCommonParameters, 
-																		  pIPDRStreamElement, 
-																		  pListServiceAttributeDescriptorTemp,
-																		  pErrorCode);	
-				if (errorSeverity == IPDR_WARNING) {
-					errorHandler(pIPDRCommonParameters, pErrorCode, "readIPDRStreamElementHelper");	
-				}
-				else if (errorSeverity == IPDR_ERROR) {
-					pIPDRCommonParameters->DocState_ = NONREADABLE; 
-					exceptionHandler(pIPDRCommonParameters, pErrorCode, "readIPDRStreamElementHelper");	
-					return (IPDR_ERROR);
-				}
-				
-				descriptorID = pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->descriptorID_; 
+	freeIPDRStreamElement (pIPDRStreamElement);
 
-				errorSeverity = getDescriptor(pIPDRCommonParameters, descriptorID, pRecordDescriptor, pErrorCode);
-				if (errorSeverity == IPDR_WARNING) {
-					errorHandler(pIPDRCommonParameters, pErrorCode, "getDescriptor");	
-				}
-				else if (errorSeverity == IPDR_ERROR) {
-					pIPDRCommonParameters->DocState_ = NONREADABLE; 
-					exceptionHandler(pIPDRCommonParameters, pErrorCode, "getDescriptor");	
-					return (IPDR_ERROR);
-				}
+	return (IPDR_OK);
+}
 
-				/* Populating FNFData */
-				pCurrent = pRecordDescriptor->pListAttributeDescriptor_;
-
-				while (pRecordDescriptor->pListAttributeDescriptor_ != NULL) {
-					appendListAttributeDescriptor(&((*pFNFData)->pListAttributeDescriptor_),
-							pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->attributeName_,
-							pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->attributeType_,
-							pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->description_,
-							pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->derivedType_,
-							pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_, 
-							pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->pListAttrNameList_, 
-							pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->pListAttrClassList_, 
-							pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->pListAttrMaxOccursList_, 
-							pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ );
-				
-					pRecordDescriptor->pListAttributeDescriptor_ = pRecordDescriptor->pListAttributeDescriptor_->pNext_; 
-				}
-				
-				pRecordDescriptor->pListAttributeDescriptor_ = pCurrent;
-
-/*if(lFound == 1) {*/
-				pCurrent = pListServiceAttributeDescriptorTemp;
-
-				while (pListServiceAttributeDescriptorTemp != NULL) {
-					appendListAttributeDescriptor(&((*pFNFData)->pListServiceAttributeDescriptor_),
-							pListServiceAttributeDescriptorTemp->pAttributeDescriptor_->attributeName_,
-							pListServiceAttributeDescriptorTemp->pAttributeDescriptor_->attributeType_,
-							pListServiceAttributeDescriptorTemp->pAttributeDescriptor_->description_,
-							pListServiceAttributeDescriptorTemp->pAttributeDescriptor_->derivedType_,
-							pListServiceAttributeDescriptorTemp->pAttributeDescriptor_->complexType_, 
-							pListServiceAttributeDescriptorTemp->pAttributeDescriptor_->pListAttrNameList_, 
-							pListServiceAttributeDescriptorTemp->pAttributeDescriptor_->pListAttrClassList_, 
-							pListServiceAttributeDescriptorTemp->pAttributeDescriptor_->pListAttrMaxOccursList_, 
-							pListServiceAttributeDescriptorTemp->pAttributeDescriptor_->noOfElements_ );
-				
-					pListServiceAttributeDescriptorTemp = pListServiceAttributeDescriptorTemp->pNext_; 
-				}
-				pListServiceAttributeDescriptorTemp = pCurrent;
 
-				lFound = 0;
-/*}*/
+/*!
+ *  NAME:
+ *      copyXDRRecordLayout() - copies the layout of a record into FNFData
+ *
+ *  DESCRIPTION:
+ *      Appends the attribute descriptors of the record descriptor, only
+ *      the projected ones if planProjected is set, and the service
+ *      attributes of the document, and copies the type name.
+ *
+ *  ARGUMENTS:
+ *       -	IPDRCommonParameters (IN)
+ * 		 -	pRecordDescriptor (IN)
+ * 		 -	planProjected (IN)
+ * 		 -	FNFData (IN/OUT)
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+*/
 
-				strcpy((*pFNFData)->typeName_, pRecordDescriptor->typeName_); 
-				
-				
-				pFirst = pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_;
-
-				while (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_ != NULL) {
-					
-				    if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_HEXADECARRAY) {
-						  	
-						  appendListIPDRData(&((*pFNFData)->pListIPDRData_ ),
-										pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRByteArray_,
-										IPDRDATA_HEXADECARRAY);
-					}
-					else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_DOUBLE) {
-						IPDRValue = (double *) &pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRDouble_;
-						  appendListIPDRData(&((*pFNFData)->pListIPDRData_ ),
-										IPDRValue,
-										IPDRDATA_DOUBLE);
-					}
-					else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_FLOAT) {
-					IPDRValue = (float *) &pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRFloat_;
-					  appendListIPDRData(&((*pFNFData)->pListIPDRData_ ),
-										IPDRValue,
-										IPDRDATA_FLOAT);
-					}
-					else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_LONG) {
-						appendListIPDRData(&((*pFNFData)->pListIPDRData_ ),
-										(void *) pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRLong_,
-										IPDRDATA_LONG);
-					}
-					else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_LONGLONG) {
-						appendListIPDRData(&((*pFNFData)->pListIPDRData_ ),
-										(void *) &(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRLongLong_),
-										IPDRDATA_LONGLONG);
-					}
-					else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_ULONG) {
-						appendListIPDRData(&((*pFNFData)->pListIPDRData_ ),
-										(void *) pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRULong_,
-										IPDRDATA_ULONG);
-					}
-					else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_ULONGLONG) {
-						appendListIPDRData(&((*pFNFData)->pListIPDRData_ ),
-										(void *) &(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRULongLong_),
-										IPDRDATA_ULONGLONG);
-					}
-					else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_STRING) {
-						appendListIPDRData(&((*pFNFData)->pListIPDRData_ ),
-										pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRUTF8Array_,
-										IPDRDATA_STRING);
-					}
-					else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_BOOLEAN) {
-					/*IPDRValue = (bool *) &pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRBoolean_;
-					  appendListIPDRData(&((*pFNFData)->pListIPDRData_ ),
-										IPDRValue,
-										IPDRDATA_BOOLEAN);
-					*/
-					  appendListIPDRData(&((*pFNFData)->pListIPDRData_ ),
-										pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRBoolean_,
-										IPDRDATA_BOOLEAN);
-					}
-					else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_SHORT) {
-					  appendListIPDRData(&((*pFNFData)->pListIPDRData_ ),
-										(void *) pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRShort_,
-										IPDRDATA_SHORT);
-					}
-					else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_USHORT) {
-					  appendListIPDRData(&((*pFNFData)->pListIPDRData_ ),
-										(void *) (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRUShort_),
-										IPDRDATA_USHORT);
-					}
-   				else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_ARRAY) {
-    					appendListArrayToIPDRData(&((*pFNFData)->pListIPDRData_),
-        				pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->pListIPDRArrayData_,pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->noOfElements_, IPDRDATA_ARRAY);
-   			  }
-   			  else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_STRUCTURE) {
-        				appendListStructureToIPDRData(&((*pFNFData)->pListIPDRData_),
-						pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->pListIPDRStructureData_,
-        				IPDRDATA_STRUCTURE);
-   			  }
-					else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_BYTE) {
-						appendListIPDRData(&((*pFNFData)->pListIPDRData_ ),
-										(void *) pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRByte_,
-										IPDRDATA_BYTE);
-					}
-					else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_UBYTE) {
-						appendListIPDRData(&((*pFNFData)->pListIPDRData_ ),
-										(void *) pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRByte_,
-										IPDRDATA_UBYTE);
-					}
+static int copyXDRRecordLayout(
+			 IPDRCommonParameters* pIPDRCommonParameters,
+			 const RecordDescriptor* pRecordDescriptor,
+			 int planProjected,
+			 FNFData* pFNFData
+			)
+{
+	ListAttributeDescriptor* pCurrent;
+	int slot = 0;
+	int copyError = IPDR_OK;
 
-					pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_ = pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->pNext_; 
-				}
-				
-				pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_ = pFirst;
+	/* Populating FNFData */
+	pCurrent = pRecordDescriptor->pListAttributeDescriptor_;
 
-     
-		if ((pIPDRCommonParameters->pSchema_ != NULL) && (pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL)) {
-			
-            /* Code change to now use the IPDRCommonParameters structure member to check schema version */
-					errorSeverity = validateAgainstSchema(pIPDRCommonParameters, *pFNFData, pErrorCode);
-					if (errorSeverity == IPDR_WARNING) {
-						errorHandler(pIPDRCommonParameters, pErrorCode, "validateAgainstSchema");	
-					}
-					else if (errorSeverity == IPDR_ERROR) {
-						pIPDRCommonParameters->DocState_ = NONREADABLE; 
-						exceptionHandler(pIPDRCommonParameters, pErrorCode, "validateAgainstSchema");	
-						return (IPDR_ERROR);
-					}
-			}
+	while (pCurrent != NULL) {
+		if (planProjected == IPDR_TRUE &&
+			getIPDRStringMap(pIPDRCommonParameters->pProjection_,
+							 pCurrent->pAttributeDescriptor_->attributeName_, &slot) != IPDR_TRUE) {
+			pCurrent = pCurrent->pNext_;
+			continue;
+		}
+		if (copyError == IPDR_OK)
+			copyError = appendListAttributeDescriptorInArena(pFNFData->pArena_,
+					&(pFNFData->pListAttributeDescriptor_),
+					pCurrent->pAttributeDescriptor_);
 
-				freeIPDRStreamElement (pIPDRStreamElement);
-				freeRecordDescriptor (pRecordDescriptor);
-			
-				break;
+		pCurrent = pCurrent->pNext_; 
+	}
 
-			case STREAM_DOC_END:
-				/*
-				   On getting the descriminator as 3, does nothing & returns. 
-				   Calling application (In this case, main), will be calling readDocEnd explicitly
-				   to read the DocEnd structure.
-				*/
-				freeFNFData(*pFNFData);
-				*pFNFData = NULL;
-				break;
+	pCurrent = pIPDRCommonParameters->pListServiceAttributeDescriptor_;
 
-			default:
-				*pErrorCode = IPDR_INVALID_DESCRIMINATOR;
-				return (IPDR_ERROR);
-				break;
-		}
+	while (pCurrent != NULL) {
+		if (copyError == IPDR_OK)
+			copyError = appendListAttributeDescriptorInArena(pFNFData->pArena_,
+					&(pFNFData->pListServiceAttributeDescriptor_),
+					pCurrent->pAttributeDescriptor_);
+
+		pCurrent = pCurrent->pNext_; 
 	}
-	else if (pIPDRCommonParameters->DocType_ == XML) {
-		errorSeverity = readIPDRXMLRecordHelper(pIPDRCommonParameters, pFNFData, pErrorCode); 
+
+	strcpy(pFNFData->typeName_, pRecordDescriptor->typeName_); 
+
+	return (copyError);
+}
+
+
+/*!
+ *  NAME:
+ *      copyXDRRecord() - copies a record read from the XDR file into FNFData
+ *
+ *  DESCRIPTION:
+ *      Copies the layout and values of the record held by the stream
+ *      element into FNFData, projects it and validates it against the
+ *      schema, if any. The stream element is freed.
+ *
+ *  ARGUMENTS:
+ *       -	IPDRCommonParameters (IN/OUT)
+ * 		 -	pIPDRStreamElement (IN/OUT)
+ * 		 -	FNFData (IN/OUT)
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+*/
+
+static int copyXDRRecord(
+			 IPDRCommonParameters* pIPDRCommonParameters,
+			 IPDRStreamElement* pIPDRStreamElement,
+			 FNFData* pFNFData,
+			 int* pErrorCode
+			)
+{
+	int descriptorID = 0;
+	int errorSeverity = 0;
+
+	RecordDescriptor* pRecordDescriptor;
+	RecordDescriptor* pOwnDescriptor = NULL;
+	ListIPDRData* pFirst;
+	void* IPDRValue =  NULL;
+	const XDRCodecPlan* pCodecPlan = NULL;
+	int planProjected = IPDR_FALSE;
+	int copyError = IPDR_OK;
+
+	descriptorID = pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->descriptorID_; 
+
+	/* Decoded descriptors are shared, only uncached IDs are copied */
+	pRecordDescriptor = (RecordDescriptor *) lookupDescriptor(pIPDRCommonParameters, descriptorID);
+	pOwnDescriptor = NULL;
+	if (pRecordDescriptor == NULL) {
+		pOwnDescriptor = newRecordDescriptor();
+		if(pOwnDescriptor == NULL) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return(IPDR_ERROR);
+		}
+		errorSeverity = getDescriptor(pIPDRCommonParameters, descriptorID, pOwnDescriptor, pErrorCode);
 		if (errorSeverity == IPDR_WARNING) {
-			errorHandler(pIPDRCommonParameters, pErrorCode, "readIPDRXMLRecordHelper");	
+			errorHandler(pIPDRCommonParameters, pErrorCode, "getDescriptor");	
 		}
 		else if (errorSeverity == IPDR_ERROR) {
 			pIPDRCommonParameters->DocState_ = NONREADABLE; 
-			exceptionHandler(pIPDRCommonParameters, pErrorCode, "readIPDRXMLRecordHelper");	
+			exceptionHandler(pIPDRCommonParameters, pErrorCode, "getDescriptor");	
+			freeRecordDescriptor(pOwnDescriptor);
 			return (IPDR_ERROR);
 		}
-		if(*pFNFData != NULL) {
-			
-		if ((pIPDRCommonParameters->pSchema_ != NULL) && (pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL)) {
-			
-            /* Code change to now use the IPDRCommonParameters structure member to check schema version */
-					errorSeverity = validateAgainstSchema(pIPDRCommonParameters, *pFNFData, pErrorCode);
-					if (errorSeverity == IPDR_WARNING) {
-						errorHandler(pIPDRCommonParameters, pErrorCode, "validateAgainstSchema");	
-					}
-					else if (errorSeverity == IPDR_ERROR) {
-						pIPDRCommonParameters->DocState_ = NONREADABLE; 
-						exceptionHandler(pIPDRCommonParameters, pErrorCode, "validateAgainstSchema");	
-						return (IPDR_ERROR);
-					}
-			}
+		pRecordDescriptor = pOwnDescriptor;
+	}
+
+	/* Values read through a codec plan are projected already */
+	if (pIPDRCommonParameters->pProjection_ != NULL) {
+		pCodecPlan = getXDRCodecPlan(pIPDRCommonParameters, descriptorID);
+		planProjected = (pCodecPlan != NULL && pCodecPlan->hasStructures_ == IPDR_FALSE);
+	}
+
+	copyError = copyXDRRecordLayout(pIPDRCommonParameters, pRecordDescriptor,
+									planProjected, pFNFData);
+
+	pFirst = pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_;
+
+	/* Values of a record in an arena are copied at once */
+	if (pFNFData->pArena_ != NULL && copyError == IPDR_OK)
+		copyError = copyListIPDRDataInArena(pFNFData->pArena_, &(pFNFData->pListIPDRData_), pFirst);
+
+	while (pFNFData->pArena_ == NULL &&
+		   pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_ != NULL) {
+
+		if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_HEXADECARRAY) {
+
+			appendListIPDRData(&(pFNFData->pListIPDRData_ ),
+							pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRByteArray_,
+							IPDRDATA_HEXADECARRAY);
+		}
+		else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_DOUBLE) {
+			IPDRValue = (double *) &pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRDouble_;
+			appendListIPDRData(&(pFNFData->pListIPDRData_ ),
+							IPDRValue,
+							IPDRDATA_DOUBLE);
+		}
+		else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_FLOAT) {
+			IPDRValue = (float *) &pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRFloat_;
+			appendListIPDRData(&(pFNFData->pListIPDRData_ ),
+							IPDRValue,
+							IPDRDATA_FLOAT);
+		}
+		else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_LONG) {
+			appendListIPDRData(&(pFNFData->pListIPDRData_ ),
+							(void *) pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRLong_,
+							IPDRDATA_LONG);
+		}
+		else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_LONGLONG) {
+			appendListIPDRData(&(pFNFData->pListIPDRData_ ),
+							(void *) &(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRLongLong_),
+							IPDRDATA_LONGLONG);
+		}
+		else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_ULONG) {
+			appendListIPDRData(&(pFNFData->pListIPDRData_ ),
+							(void *) pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRULong_,
+							IPDRDATA_ULONG);
+		}
+		else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_ULONGLONG) {
+			appendListIPDRData(&(pFNFData->pListIPDRData_ ),
+							(void *) &(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRULongLong_),
+							IPDRDATA_ULONGLONG);
+		}
+		else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_STRING) {
+			appendListIPDRData(&(pFNFData->pListIPDRData_ ),
+							pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRUTF8Array_,
+							IPDRDATA_STRING);
+		}
+		else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_BOOLEAN) {
+			/*IPDRValue = (bool *) &pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRBoolean_;
+			appendListIPDRData(&(pFNFData->pListIPDRData_ ),
+							IPDRValue,
+							IPDRDATA_BOOLEAN);
+			*/
+			appendListIPDRData(&(pFNFData->pListIPDRData_ ),
+							pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRBoolean_,
+							IPDRDATA_BOOLEAN);
+		}
+		else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_SHORT) {
+			appendListIPDRData(&(pFNFData->pListIPDRData_ ),
+							(void *) pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRShort_,
+							IPDRDATA_SHORT);
+		}
+		else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_USHORT) {
+			appendListIPDRData(&(pFNFData->pListIPDRData_ ),
+							(void *) (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRUShort_),
+							IPDRDATA_USHORT);
+		}
+		else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_ARRAY) {
+			appendListArrayToIPDRData(&(pFNFData->pListIPDRData_),
+							pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->pListIPDRArrayData_,pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->noOfElements_, IPDRDATA_ARRAY);
+		}
+		else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_STRUCTURE) {
+			appendListStructureToIPDRData(&(pFNFData->pListIPDRData_),
+							pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->pListIPDRStructureData_,
+							IPDRDATA_STRUCTURE);
 		}
+		else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_BYTE) {
+			appendListIPDRData(&(pFNFData->pListIPDRData_ ),
+							(void *) pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRByte_,
+							IPDRDATA_BYTE);
+		}
+		else if (pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataType_ == IPDRDATA_UBYTE) {
+			appendListIPDRData(&(pFNFData->pListIPDRData_ ),
+							(void *) pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->IPDRDataUnion_.IPDRByte_,
+							IPDRDATA_UBYTE);
+		}
+
+		pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_ = pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_->pNext_; 
 	}
-	else {
-		*pErrorCode = IPDR_INVALID_DOCTYPE;
+
+	pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_ = pFirst;
+
+	if (copyError != IPDR_OK) {
+		freeIPDRStreamElement (pIPDRStreamElement);
+		if (pOwnDescriptor != NULL)
+			freeRecordDescriptor (pOwnDescriptor);
+		*pErrorCode = copyError;
 		return (IPDR_ERROR);
 	}
-	
-	pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_++;
 
+	if (pIPDRCommonParameters->pProjection_ != NULL && planProjected == IPDR_FALSE)
+		projectFNFData(pIPDRCommonParameters, pFNFData);
+
+	/* Projected records are partial, they are not validated */
+	if ((pIPDRCommonParameters->pSchema_ != NULL) && (pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL) &&
+		(pIPDRCommonParameters->pProjection_ == NULL)) {
+
+		/* Code change to now use the IPDRCommonParameters structure member to check schema version */
+		errorSeverity = validateRecordAgainstSchema(pIPDRCommonParameters, pFNFData, 
+													descriptorID, IPDR_TRUE, pErrorCode);
+		if (errorSeverity == IPDR_WARNING) {
+			errorHandler(pIPDRCommonParameters, pErrorCode, "validateAgainstSchema");	
+		}
+		else if (errorSeverity == IPDR_ERROR) {
+			pIPDRCommonParameters->DocState_ = NONREADABLE; 
+			exceptionHandler(pIPDRCommonParameters, pErrorCode, "validateAgainstSchema");	
+			return (IPDR_ERROR);
+		}
+	}
+
+	freeIPDRStreamElement (pIPDRStreamElement);
+	if (pOwnDescriptor != NULL)
+		freeRecordDescriptor (pOwnDescriptor);
 
 	return (IPDR_OK);
 }
 
+
+/*!
+ *  NAME:
+ *      readXDRRecord() - reads an IPDR record from the XDR file
+ *
+ *  DESCRIPTION:
+ *      Reads the record, its discriminator having been read, into
+ *      FNFData and validates it against the schema, if any.
+ *
+ *  ARGUMENTS:
+ *       -	IPDRCommonParameters (IN/OUT)
+ * 		 -	FNFData (IN/OUT)
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+*/
+
+static int readXDRRecord(
+			 IPDRCommonParameters* pIPDRCommonParameters,
+			 FNFData* pFNFData,
+			 int* pErrorCode
+			)
+{
+	int errorSeverity = 0;
+
+	IPDRStreamElement* pIPDRStreamElement;
+
+	pIPDRStreamElement = newIPDRStreamElement(STREAM_IPDR_RECORD);
+
+	if(pIPDRStreamElement == NULL) {
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return(IPDR_ERROR);
+	}
+
+	pIPDRStreamElement->descriminator_ = STREAM_IPDR_RECORD;
+	/*errorSeverity = readIPDRStreamElementHelper(pIPDRCommonParameters, 
+															pIPDRStreamElement, 
+															pErrorCode);	*/
+	errorSeverity = readIPDRStreamElementHelper(pIPDRCommonParameters, 
+															pIPDRStreamElement, 
+															pIPDRCommonParameters->pListServiceAttributeDescriptor_,
+															pErrorCode);	
+	if (errorSeverity == IPDR_WARNING) {
+		errorHandler(pIPDRCommonParameters, pErrorCode, "readIPDRStreamElementHelper");	
+	}
+	else if (errorSeverity == IPDR_ERROR) {
+		pIPDRCommonParameters->DocState_ = NONREADABLE; 
+		exceptionHandler(pIPDRCommonParameters, pErrorCode, "readIPDRStreamElementHelper");	
+		return (IPDR_ERROR);
+	}
+
+	return (copyXDRRecord(pIPDRCommonParameters, pIPDRStreamElement, pFNFData, pErrorCode));
+}
+
+
+/*!
+ *  NAME:
+ *      setIPDRProjection() - 	sets the attributes read into FNFData
+ *
+ *  DESCRIPTION:
+ *      Records read afterwards only hold the named attributes, in
+ *      descriptor order. The values of the other attributes of an XDR
+ *      document are stepped over without being decoded, except in
+ *      records holding structures, which are read fully and then
+ *      projected like XML records. Projected records are not
+ *      validated against the schema.
+ *
+ *  ARGUMENTS:
+ *       -	IPDRCommonParameters (IN/OUT)	
+ * 		 -	pListAttributeName (IN), NULL to read every attribute
+ *
+ *  RETURNS 	
+ *	     Returns Zero or appropriate error code
+*/
+
+int setIPDRProjection(
+			 IPDRCommonParameters* pIPDRCommonParameters, 
+			 List* pListAttributeName, 
+			 int* pErrorCode
+			)
+{
+	int count = 0;
+	IPDRStringMap* pProjection = NULL;
+	List* pCurrent;
+
+	if(pIPDRCommonParameters == NULL) {
+	    *pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+	    return (IPDR_ERROR);
+	}
+
+	if (pListAttributeName != NULL) {
+		pProjection = newIPDRStringMap(getLength(pListAttributeName));
+		if (pProjection == NULL) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return (IPDR_ERROR);
+		}
+		for (pCurrent = pListAttributeName; pCurrent != NULL; pCurrent = pCurrent->pNext) {
+			if (putIPDRStringMap(pProjection, pCurrent->node, count++, pErrorCode) == IPDR_ERROR) {
+				freeIPDRStringMap(pProjection);
+				return (IPDR_ERROR);
+			}
+		}
+	}
+
+	freeIPDRStringMap(pIPDRCommonParameters->pProjection_);
+	pIPDRCommonParameters->pProjection_ = pProjection;
+	pIPDRCommonParameters->readGeneration_ = nextIPDRReadGeneration();
+
+	/* Plans are compiled for the projection, drop the ones compiled */
+	for (count = 0; count < pIPDRCommonParameters->descriptorCacheSize_; count++) {
+		if (pIPDRCommonParameters->ppCodecPlans_[count] != NULL) {
+			freeXDRCodecPlan(pIPDRCommonParameters->ppCodecPlans_[count]);
+			pIPDRCommonParameters->ppCodecPlans_[count] = NULL;
+		}
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      readIPDR() - 	reads IPDR data and/or descriptor from the XDR file 
+ *
+ *  DESCRIPTION:
+ *      This function
+ *       - Calls readIPDRStreamElementHelper
+ *		 - Depending on the value of descriminator, calls following functions
+ *		   a. Calls "addDescriptor", if value of descriminator is 1
+ *		   b. Increments the value of ipdrCount, if value of descriminator is 2
+ *		   c. Returns null to Stream Pointer, if value of descriminator is 3	
+ *		 - Calls validateAgainstSchema
+ *      A record from newFNFDataInArena() is filled from its arena.
+ *
+ *  ARGUMENTS:
+ *       -	IPDRCommonParameters (IN/OUT)	
+ * 		 -	FNFData (IN/OUT)
+ *
+ *  RETURNS 	
+ *	     Returns Zero or appropriate error code
+*/
+
+int readIPDR(
+			 IPDRCommonParameters* pIPDRCommonParameters, 
+			 FNFData** pFNFData, 
+			 int* pErrorCode
+			)
+{
+	int errorSeverity = 0;
+	int errorCode = 0;
+	int descriminator = 0;
+	FNFData* pArenaFNFData = NULL;
+	
+	if(pFNFData == NULL || pIPDRCommonParameters == NULL) {
+	    *pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+	    return (IPDR_ERROR);
+	}
+
+	if (pIPDRCommonParameters->DocState_ != READABLE) {
+		*pErrorCode = IPDR_INVALID_DOCSTATE_MAKE_READABLE;
+		return (IPDR_ERROR);
+	}
+
+	if(pIPDRCommonParameters->DocType_ == XDR) {
+		descriminator = read_long(pIPDRCommonParameters->pInputBuffer_);  
+		
+		switch (descriminator)
+		{
+			case STREAM_RECORD_DESCRIPTOR:
+				
+				if (readXDRDescriptor(pIPDRCommonParameters, pErrorCode) == IPDR_ERROR)
+					return (IPDR_ERROR);
+
+				/* Descriptors need not be followed by a record, read the next element */
+				return (readIPDR(pIPDRCommonParameters, pFNFData, pErrorCode));
+
+			case STREAM_IPDR_RECORD:
+
+				if (readXDRRecord(pIPDRCommonParameters, *pFNFData, pErrorCode) == IPDR_ERROR)
+					return (IPDR_ERROR);
+
+				break;
+
+			case STREAM_DOC_END:
+				/*
+				   On getting the descriminator as 3, does nothing & returns. 
+				   Calling application (In this case, main), will be calling readDocEnd explicitly
+				   to read the DocEnd structure.
+				*/
+				freeFNFData(*pFNFData);
+				*pFNFData = NULL;
+				break;
+
+			default:
+				*pErrorCode = IPDR_INVALID_DESCRIMINATOR;
+				pIPDRCommonParameters->DocState_ = NONREADABLE; 
+				exceptionHandler(pIPDRCommonParameters, pErrorCode, "readIPDR");	
+				return (IPDR_ERROR);
+				break;
+		}
+	}
+	else if (pIPDRCommonParameters->DocType_ == XML) {
+		/* XML records are rewritten while read, they are read on the heap and copied into an arena */
+		if (*pFNFData != NULL && (*pFNFData)->pArena_ != NULL) {
+			pArenaFNFData = *pFNFData;
+			*pFNFData = newFNFData();
+			if (*pFNFData == NULL) {
+				*pFNFData = pArenaFNFData;
+				*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+				return (IPDR_ERROR);
+			}
+		}
+		errorSeverity = readIPDRXMLRecordHelper(pIPDRCommonParameters, pFNFData, pErrorCode); 
+		if (errorSeverity == IPDR_WARNING) {
+			errorHandler(pIPDRCommonParameters, pErrorCode, "readIPDRXMLRecordHelper");	
+		}
+		else if (errorSeverity == IPDR_ERROR) {
+			pIPDRCommonParameters->DocState_ = NONREADABLE; 
+			exceptionHandler(pIPDRCommonParameters, pErrorCode, "readIPDRXMLRecordHelper");	
+			if (pArenaFNFData != NULL) {
+				freeFNFData(*pFNFData);
+				*pFNFData = pArenaFNFData;
+			}
+			return (IPDR_ERROR);
+		}
+		if (pArenaFNFData != NULL && *pFNFData != NULL) {
+			errorCode = copyFNFDataInArena(pArenaFNFData, *pFNFData);
+			freeFNFData(*pFNFData);
+			*pFNFData = pArenaFNFData;
+			if (errorCode != IPDR_OK) {
+				*pErrorCode = errorCode;
+				return (IPDR_ERROR);
+			}
+		}
+		if(*pFNFData != NULL && pIPDRCommonParameters->pProjection_ != NULL)
+			projectFNFData(pIPDRCommonParameters, *pFNFData);
+		else if(*pFNFData != NULL) {
+			
+		if ((pIPDRCommonParameters->pSchema_ != NULL) && (pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL)) {
+			
+            /* Code change to now use the IPDRCommonParameters structure member to check schema version */
+					errorSeverity = validateAgainstSchema(pIPDRCommonParameters, *pFNFData, pErrorCode);
+					if (errorSeverity == IPDR_WARNING) {
+						errorHandler(pIPDRCommonParameters, pErrorCode, "validateAgainstSchema");	
+					}
+					else if (errorSeverity == IPDR_ERROR) {
+						pIPDRCommonParameters->DocState_ = NONREADABLE; 
+						exceptionHandler(pIPDRCommonParameters, pErrorCode, "validateAgainstSchema");	
+						return (IPDR_ERROR);
+					}
+			}
+		}
+	}
+	else {
+		*pErrorCode = IPDR_INVALID_DOCTYPE;
+		return (IPDR_ERROR);
+	}
+	
+	pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_++;
+
+
+	return (IPDR_OK);
+}
+
+/*!
+ *  NAME:
+ *      readIPDRFlat() - 	reads the next IPDR record into a flat record
+ *
+ *  DESCRIPTION:
+ *      Descriptors before the record are added to the document as by
+ *      readIPDR(). The values of the record are decoded through the
+ *      codec plan of its descriptor into the record, which keeps its
+ *      layout and capacity while records of the same descriptor are
+ *      read into it, so no memory is allocated for them once it has
+ *      grown to fit. XML documents, and records validated against a
+ *      schema, are read by readIPDR() and copied into the record.
+ *      *pRecordRead is set to IPDR_FALSE at the end of the document.
+ *
+ *  ARGUMENTS:
+ *       -	IPDRCommonParameters (IN/OUT)
+ * 		 -	pRecord (IN/OUT)
+ * 		 -	pRecordRead (OUT)
+ *
+ *  RETURNS 	
+ *	     Returns Zero or appropriate error code
+*/
+
+int readIPDRFlat(
+			 IPDRCommonParameters* pIPDRCommonParameters, 
+			 IPDRFlatRecord* pRecord, 
+			 int* pRecordRead,
+			 int* pErrorCode
+			)
+{
+	int errorSeverity = 0;
+	int errorCode = 0;
+	int descriminator = 0;
+	int descriptorID = 0;
+	FNFData* pFNFData = NULL;
+	const RecordDescriptor* pRecordDescriptor;
+	const XDRCodecPlan* pCodecPlan;
+
+	if(pRecord == NULL || pRecordRead == NULL || pIPDRCommonParameters == NULL) {
+	    *pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+	    return (IPDR_ERROR);
+	}
+
+	*pRecordRead = IPDR_FALSE;
+
+	if (pIPDRCommonParameters->DocState_ != READABLE) {
+		*pErrorCode = IPDR_INVALID_DOCSTATE_MAKE_READABLE;
+		return (IPDR_ERROR);
+	}
+
+	/* Records validated against a schema are read as FNFData */
+	if (pIPDRCommonParameters->DocType_ != XDR ||
+		((pIPDRCommonParameters->pSchema_ != NULL) &&
+		 (pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL) &&
+		 (pIPDRCommonParameters->pProjection_ == NULL))) {
+		pFNFData = newFNFData();
+		if (pFNFData == NULL) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return (IPDR_ERROR);
+		}
+		errorSeverity = readIPDR(pIPDRCommonParameters, &pFNFData, pErrorCode);
+		if (errorSeverity == IPDR_ERROR || pFNFData == NULL) {
+			freeFNFData(pFNFData);
+			return (errorSeverity);
+		}
+		errorCode = copyFNFDataToFlatRecord(pRecord, pFNFData);
+		freeFNFData(pFNFData);
+		if (errorCode != IPDR_OK) {
+			*pErrorCode = errorCode;
+			return (IPDR_ERROR);
+		}
+		*pRecordRead = IPDR_TRUE;
+		return (errorSeverity);
+	}
+
+	for (;;) {
+		descriminator = read_long(pIPDRCommonParameters->pInputBuffer_);
+		if (descriminator != STREAM_RECORD_DESCRIPTOR)
+			break;
+		if (readXDRDescriptor(pIPDRCommonParameters, pErrorCode) == IPDR_ERROR)
+			return (IPDR_ERROR);
+	}
+
+	/* The end of the document is counted as readIPDR() counts it */
+	if (descriminator == STREAM_DOC_END) {
+		pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_++;
+		return (IPDR_OK);
+	}
+
+	if (descriminator != STREAM_IPDR_RECORD) {
+		*pErrorCode = IPDR_INVALID_DESCRIMINATOR;
+		pIPDRCommonParameters->DocState_ = NONREADABLE; 
+		exceptionHandler(pIPDRCommonParameters, pErrorCode, "readIPDRFlat");	
+		return (IPDR_ERROR);
+	}
+
+	descriptorID = read_long(pIPDRCommonParameters->pInputBuffer_);
+	if (read_long(pIPDRCommonParameters->pInputBuffer_) != IPDR_INDEFINITE_LENGTH_INDICATOR)
+		errorCode = IPDR_INVALID_COMPACT_FORMAT;
+
+	pRecordDescriptor = lookupDescriptor(pIPDRCommonParameters, descriptorID);
+	pCodecPlan = getXDRCodecPlan(pIPDRCommonParameters, descriptorID);
+	if (errorCode == IPDR_OK && (pRecordDescriptor == NULL || pCodecPlan == NULL))
+		errorCode = IPDR_NO_SUCH_DESCRIPTOR;
+	else if (errorCode == IPDR_OK && pCodecPlan->hasStructures_ == IPDR_TRUE)
+		errorCode = IPDR_NON_PRIMITIVE_DATA_TYPE;
+
+	/* The layout is kept while records of the same descriptor are read */
+	if (errorCode == IPDR_OK &&
+		(pRecord->pReadDocument_ != pIPDRCommonParameters ||
+		 pRecord->readDescriptorID_ != descriptorID ||
+		 pRecord->fingerprint_ != pIPDRCommonParameters->pDescriptorFingerprints_[descriptorID])) {
+		errorCode = setIPDRFlatRecordLayout(pRecord, pRecordDescriptor->typeName_,
+											pRecordDescriptor->pListAttributeDescriptor_,
+											pIPDRCommonParameters->pListServiceAttributeDescriptor_);
+		if (errorCode == IPDR_OK) {
+			pRecord->pReadDocument_ = pIPDRCommonParameters;
+			pRecord->readDescriptorID_ = descriptorID;
+		}
+	}
+
+	if (errorCode == IPDR_OK)
+		errorCode = clearIPDRFlatRecord(pRecord);
+
+	if (errorCode != IPDR_OK) {
+		*pErrorCode = errorCode;
+		pIPDRCommonParameters->DocState_ = NONREADABLE; 
+		exceptionHandler(pIPDRCommonParameters, pErrorCode, "readIPDRFlat");	
+		return (IPDR_ERROR);
+	}
+
+	if (readXDRCodecPlanFlat(pIPDRCommonParameters, pCodecPlan, pRecord, pErrorCode) == IPDR_ERROR) {
+		pIPDRCommonParameters->DocState_ = NONREADABLE; 
+		exceptionHandler(pIPDRCommonParameters, pErrorCode, "readXDRCodecPlanFlat");	
+		return (IPDR_ERROR);
+	}
+
+	pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_++;
+	*pRecordRead = IPDR_TRUE;
+
+	return (IPDR_OK);
+}
+
+/*!
+ *  NAME:
+ *      clearReadFNFData() - empties an FNFData records are read into
+ *
+ *  DESCRIPTION:
+ *      Frees the lists of a record on the heap, with the arrays read
+ *      through a codec plan, which belong to it; the lists of a record
+ *      in an arena are only dropped. The next record read into it
+ *      rebuilds its layout.
+ *
+ *  ARGUMENTS:
+ * 		 -	FNFData (IN/OUT)
+ *
+ *  RETURNS
+ *	     Nothing
+*/
+
+static void clearReadFNFData(
+			 FNFData* pFNFData
+			)
+{
+	ListIPDRData* pCurrent;
+
+	if (pFNFData->pArena_ == NULL) {
+		if (pFNFData->pReadDocument_ != NULL) {
+			for (pCurrent = pFNFData->pListIPDRData_; pCurrent != NULL; pCurrent = pCurrent->pNext_) {
+				if (pCurrent->IPDRDataType_ == IPDRDATA_ARRAY) {
+					freeListIPDRArrayData(&(pCurrent->pListIPDRArrayData_));
+					pCurrent->pListIPDRArrayData_ = NULL;
+				}
+			}
+		}
+		freeListAttributeDescriptor(&(pFNFData->pListAttributeDescriptor_));
+		freeListAttributeDescriptor(&(pFNFData->pListServiceAttributeDescriptor_));
+		freeListIPDRData(&(pFNFData->pListIPDRData_));
+	}
+
+	pFNFData->pListAttributeDescriptor_ = NULL;
+	pFNFData->pListServiceAttributeDescriptor_ = NULL;
+	pFNFData->pListIPDRData_ = NULL;
+	pFNFData->typeName_[0] = '\0';
+	pFNFData->pReadDocument_ = NULL;
+}
+
+
+/*!
+ *  NAME:
+ *      readIPDRInto() - 	reads the next IPDR record into a caller's FNFData
+ *
+ *  DESCRIPTION:
+ *      Descriptors before the record are added to the document as by
+ *      readIPDR(), and the record left in FNFData is the one readIPDR()
+ *      would return. FNFData is owned by the caller and reused: while
+ *      records of the same descriptor are read into it, the values of
+ *      an XDR record are decoded through the codec plan of its
+ *      descriptor into the nodes of the previous one, whose descriptor
+ *      lists are kept, so no memory is allocated once its values have
+ *      grown to fit. XML documents, records validated against a
+ *      schema, records holding structures and records in an arena are
+ *      read by readIPDR() and take the place of the former lists.
+ *      *pRecordRead is set to IPDR_FALSE at the end of the document.
+ *
+ *  ARGUMENTS:
+ *       -	IPDRCommonParameters (IN/OUT)
+ * 		 -	FNFData (IN/OUT), from newFNFData() or newFNFDataInArena()
+ * 		 -	pRecordRead (OUT)
+ *
+ *  RETURNS 	
+ *	     Returns Zero or appropriate error code
+*/
+
+int readIPDRInto(
+			 IPDRCommonParameters* pIPDRCommonParameters, 
+			 FNFData* pFNFData, 
+			 int* pRecordRead,
+			 int* pErrorCode
+			)
+{
+	int errorSeverity = 0;
+	int errorCode = IPDR_OK;
+	int descriminator = 0;
+	int descriptorID = 0;
+	FNFData* pReadFNFData = NULL;
+	IPDRStreamElement* pIPDRStreamElement;
+	const RecordDescriptor* pRecordDescriptor;
+	const XDRCodecPlan* pCodecPlan;
+
+	if(pFNFData == NULL || pRecordRead == NULL || pIPDRCommonParameters == NULL) {
+	    *pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+	    return (IPDR_ERROR);
+	}
+
+	*pRecordRead = IPDR_FALSE;
+
+	if (pIPDRCommonParameters->DocState_ != READABLE) {
+		*pErrorCode = IPDR_INVALID_DOCSTATE_MAKE_READABLE;
+		return (IPDR_ERROR);
+	}
+
+	if (pIPDRCommonParameters->DocType_ != XDR || pFNFData->pArena_ != NULL ||
+		((pIPDRCommonParameters->pSchema_ != NULL) &&
+		 (pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL) &&
+		 (pIPDRCommonParameters->pProjection_ == NULL))) {
+		pReadFNFData = newFNFDataInArena(pFNFData->pArena_);
+		if (pReadFNFData == NULL) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return (IPDR_ERROR);
+		}
+		errorSeverity = readIPDR(pIPDRCommonParameters, &pReadFNFData, pErrorCode);
+		if (errorSeverity == IPDR_ERROR || pReadFNFData == NULL) {
+			if (pReadFNFData != NULL)
+				freeFNFData(pReadFNFData);
+			return (errorSeverity);
+		}
+		clearReadFNFData(pFNFData);
+		pFNFData->pListAttributeDescriptor_ = pReadFNFData->pListAttributeDescriptor_;
+		pFNFData->pListServiceAttributeDescriptor_ = pReadFNFData->pListServiceAttributeDescriptor_;
+		pFNFData->pListIPDRData_ = pReadFNFData->pListIPDRData_;
+		strcpy(pFNFData->typeName_, pReadFNFData->typeName_);
+		pReadFNFData->pListAttributeDescriptor_ = NULL;
+		pReadFNFData->pListServiceAttributeDescriptor_ = NULL;
+		pReadFNFData->pListIPDRData_ = NULL;
+		freeFNFData(pReadFNFData);
+		*pRecordRead = IPDR_TRUE;
+		return (errorSeverity);
+	}
+
+	for (;;) {
+		descriminator = read_long(pIPDRCommonParameters->pInputBuffer_);
+		if (descriminator != STREAM_RECORD_DESCRIPTOR)
+			break;
+		if (readXDRDescriptor(pIPDRCommonParameters, pErrorCode) == IPDR_ERROR)
+			return (IPDR_ERROR);
+	}
+
+	/* The end of the document is counted as readIPDR() counts it */
+	if (descriminator == STREAM_DOC_END) {
+		pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_++;
+		return (IPDR_OK);
+	}
+
+	if (descriminator != STREAM_IPDR_RECORD) {
+		*pErrorCode = IPDR_INVALID_DESCRIMINATOR;
+		pIPDRCommonParameters->DocState_ = NONREADABLE; 
+		exceptionHandler(pIPDRCommonParameters, pErrorCode, "readIPDRInto");	
+		return (IPDR_ERROR);
+	}
+
+	descriptorID = read_long(pIPDRCommonParameters->pInputBuffer_);
+	pCodecPlan = getXDRCodecPlan(pIPDRCommonParameters, descriptorID);
+
+	/* Records holding structures are read as by readIPDR() */
+	if (pCodecPlan == NULL || pCodecPlan->hasStructures_ == IPDR_TRUE) {
+		clearReadFNFData(pFNFData);
+		pIPDRStreamElement = newIPDRStreamElement(STREAM_IPDR_RECORD);
+		if(pIPDRStreamElement == NULL) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return(IPDR_ERROR);
+		}
+		pIPDRStreamElement->descriminator_ = STREAM_IPDR_RECORD;
+		pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->descriptorID_ = descriptorID;
+		errorSeverity = readFNFDataHelper(pIPDRCommonParameters, 
+									pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_,
+									descriptorID, 
+									pIPDRCommonParameters->pListServiceAttributeDescriptor_,
+									pErrorCode);
+		if (errorSeverity == IPDR_WARNING) {
+			errorHandler(pIPDRCommonParameters, pErrorCode, "readFNFDataHelper");
+		}
+		else if (errorSeverity == IPDR_ERROR) {
+			freeIPDRStreamElement(pIPDRStreamElement);
+			pIPDRCommonParameters->DocState_ = NONREADABLE; 
+			exceptionHandler(pIPDRCommonParameters, pErrorCode, "readFNFDataHelper");
+			return (IPDR_ERROR);
+		}
+		if (copyXDRRecord(pIPDRCommonParameters, pIPDRStreamElement, pFNFData, pErrorCode) == IPDR_ERROR)
+			return (IPDR_ERROR);
+
+		pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_++;
+		*pRecordRead = IPDR_TRUE;
+		return (IPDR_OK);
+	}
+
+	if (read_long(pIPDRCommonParameters->pInputBuffer_) != IPDR_INDEFINITE_LENGTH_INDICATOR)
+		errorCode = IPDR_INVALID_COMPACT_FORMAT;
+
+	/* The layout is kept while records of the same descriptor are read */
+	if (errorCode == IPDR_OK &&
+		(pFNFData->pReadDocument_ != (const void *) pIPDRCommonParameters ||
+		 pFNFData->readDescriptorID_ != descriptorID ||
+		 pFNFData->readGeneration_ != pIPDRCommonParameters->readGeneration_)) {
+		clearReadFNFData(pFNFData);
+		pRecordDescriptor = lookupDescriptor(pIPDRCommonParameters, descriptorID);
+		if (pRecordDescriptor == NULL)
+			errorCode = IPDR_NO_SUCH_DESCRIPTOR;
+		else
+			errorCode = copyXDRRecordLayout(pIPDRCommonParameters, pRecordDescriptor,
+											pIPDRCommonParameters->pProjection_ != NULL,
+											pFNFData);
+		if (errorCode == IPDR_OK) {
+			pFNFData->pReadDocument_ = pIPDRCommonParameters;
+			pFNFData->readDescriptorID_ = descriptorID;
+			pFNFData->readGeneration_ = pIPDRCommonParameters->readGeneration_;
+		}
+	}
+
+	if (errorCode != IPDR_OK) {
+		*pErrorCode = errorCode;
+		pIPDRCommonParameters->DocState_ = NONREADABLE; 
+		exceptionHandler(pIPDRCommonParameters, pErrorCode, "readIPDRInto");	
+		return (IPDR_ERROR);
+	}
+
+	if (readXDRCodecPlanInto(pIPDRCommonParameters, pCodecPlan, pFNFData, pErrorCode) == IPDR_ERROR) {
+		pIPDRCommonParameters->DocState_ = NONREADABLE; 
+		exceptionHandler(pIPDRCommonParameters, pErrorCode, "readXDRCodecPlanInto");	
+		return (IPDR_ERROR);
+	}
+
+	pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_++;
+	*pRecordRead = IPDR_TRUE;
+
+	return (IPDR_OK);
+}
+
+/*
+ * A batch worker decodes a contiguous run of the records found by the
+ * scan. Its context is a copy of the document parameters taken before
+ * each run, with its own cursor over the mapping and its own error
+ * list, exception structure and validator caches; everything else it
+ * reaches is only read while the workers run.
+ */
+
+/* Offset of a slot the scan has decoded itself */
+#define BATCH_SLOT_DECODED		((size_t) -1)
+
+typedef struct BatchReadWorker
+{
+	IPDRCommonParameters context_;
+	XDRInputBuffer* pCursor_;
+	ErrorStructure* pExceptionStructure_;
+	ListErrorStructure* pListErrorStructure_;
+	IPDRIntMap* pValidatorMap_;
+	IPDRIntMap* pValidationMemo_;
+	FNFData** ppFNFData_;
+	const size_t* pOffsets_;
+	int first_;              /* First slot of the run */
+	int last_;               /* One past the last slot of the run */
+	int baseCount_;          /* Record count of slot 0 */
+	int failed_;             /* Slot that failed, -1 if none */
+	int errorCode_;
+	IPDRThread thread_;
+	int started_;            /* IPDR_TRUE if run on thread_ */
+} BatchReadWorker;
+
+
+/*!
+ *  NAME:
+ *      runBatchReadWorker() - decodes the run of records of a worker
+ *
+ *  DESCRIPTION:
+ *      Stops at the first record that cannot be read.
+ *
+ *  ARGUMENTS:
+ *       -	pArgument (IN/OUT), the BatchReadWorker
+ *
+ *  RETURNS
+ *	     Nothing
+*/
+
+static void runBatchReadWorker(void* pArgument)
+{
+	int slot = 0;
+	BatchReadWorker* pWorker = (BatchReadWorker *) pArgument;
+	IPDRCommonParameters* pContext = &pWorker->context_;
+
+	for (slot = pWorker->first_; slot < pWorker->last_; slot++) {
+		if (pWorker->pOffsets_[slot] == BATCH_SLOT_DECODED)
+			continue;
+		pContext->IPDRCount_.ipdrRecordCount_ = pWorker->baseCount_ + slot;
+		if (seekXDRInputBuffer(pContext->pInputBuffer_, pWorker->pOffsets_[slot]) != IPDR_OK) {
+			pWorker->errorCode_ = IPDR_EOF_ENCOUNTERED;
+			pWorker->failed_ = slot;
+			return;
+		}
+		if (readXDRRecord(pContext, pWorker->ppFNFData_[slot],
+						  &pWorker->errorCode_) == IPDR_ERROR) {
+			pWorker->failed_ = slot;
+			return;
+		}
+	}
+}
+
+
+/*!
+ *  NAME:
+ *      decodeBatchRecords() - decodes scanned records on the workers
+ *
+ *  DESCRIPTION:
+ *      Slots first to last - 1 are split into contiguous runs, one per
+ *      worker; the calling thread runs the first. Warnings of the
+ *      workers are appended to the document in record order. On an
+ *      error the exception of the earliest failing record is raised
+ *      on the document.
+ *
+ *  ARGUMENTS:
+ *       -	IPDRCommonParameters (IN/OUT)
+ *       -	pWorkers (IN/OUT)
+ *       -	noOfWorkers (IN)
+ *       -	first (IN)
+ *       -	last (IN)
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+*/
+
+static int decodeBatchRecords(
+			 IPDRCommonParameters* pIPDRCommonParameters,
+			 BatchReadWorker* pWorkers,
+			 int noOfWorkers,
+			 int first,
+			 int last,
+			 int* pErrorCode
+			)
+{
+	int count = 0;
+	int noOfRuns = 0;
+	int runLength = 0;
+	int failed = -1;
+	BatchReadWorker* pWorker;
+	ListErrorStructure** ppTail;
+
+	if (first >= last)
+		return (IPDR_OK);
+
+	noOfRuns = (last - first) / IPDR_BATCH_MIN_RECORDS;
+	if (noOfRuns > noOfWorkers)
+		noOfRuns = noOfWorkers;
+	if (noOfRuns < 1)
+		noOfRuns = 1;
+	runLength = (last - first + noOfRuns - 1) / noOfRuns;
+
+	for (count = 0; count < noOfRuns; count++) {
+		pWorker = &pWorkers[count];
+		pWorker->context_ = *pIPDRCommonParameters;
+		pWorker->context_.pInputBuffer_ = pWorker->pCursor_;
+		pWorker->context_.pExceptionStructure_ = pWorker->pExceptionStructure_;
+		pWorker->context_.pListErrorStructure_ = pWorker->pListErrorStructure_;
+		pWorker->context_.pValidatorMap_ = pWorker->pValidatorMap_;
+		pWorker->context_.pValidationMemo_ = pWorker->pValidationMemo_;
+		pWorker->first_ = first + count * runLength;
+		pWorker->last_ = pWorker->first_ + runLength;
+		if (pWorker->last_ > last)
+			pWorker->last_ = last;
+		pWorker->failed_ = -1;
+		pWorker->errorCode_ = 0;
+		pWorker->started_ = IPDR_FALSE;
+	}
+
+	for (count = 1; count < noOfRuns; count++) {
+		pWorker = &pWorkers[count];
+		if (startIPDRThread(&pWorker->thread_, runBatchReadWorker, pWorker) == IPDR_OK)
+			pWorker->started_ = IPDR_TRUE;
+	}
+
+	/* Runs whose thread could not be started are left to this thread */
+	for (count = 0; count < noOfRuns; count++) {
+		if (pWorkers[count].started_ == IPDR_FALSE)
+			runBatchReadWorker(&pWorkers[count]);
+	}
+
+	ppTail = &pIPDRCommonParameters->pListErrorStructure_;
+	for (count = 0; count < noOfRuns; count++) {
+		pWorker = &pWorkers[count];
+		if (pWorker->started_ == IPDR_TRUE)
+			joinIPDRThread(&pWorker->thread_);
+
+		/* Validator caches carry over to the next run */
+		pWorker->pValidatorMap_ = pWorker->context_.pValidatorMap_;
+		pWorker->pValidationMemo_ = pWorker->context_.pValidationMemo_;
+
+		while (*ppTail != NULL)
+			ppTail = &(*ppTail)->pNext_;
+		*ppTail = pWorker->context_.pListErrorStructure_;
+		pWorker->context_.pListErrorStructure_ = NULL;
+		pWorker->pListErrorStructure_ = NULL;
+
+		if (pWorker->failed_ >= 0 && failed < 0) {
+			failed = pWorker->failed_;
+			*pErrorCode = pWorker->errorCode_;
+			pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_ = pWorker->baseCount_ + failed;
+			pIPDRCommonParameters->DocState_ = NONREADABLE;
+			exceptionHandler(pIPDRCommonParameters, pErrorCode,
+							 pWorker->pExceptionStructure_->functionName_ != NULL ?
+							 pWorker->pExceptionStructure_->functionName_ : "readIPDRBatch");
+		}
+	}
+	return (failed < 0 ? IPDR_OK : IPDR_ERROR);
+}
+
+
+/*!
+ *  NAME:
+ *      freeBatchReadWorkers() - frees the workers of a batch read
+ *
+ *  ARGUMENTS:
+ *       -	pWorkers (IN/OUT)
+ *       -	noOfWorkers (IN)
+ *
+ *  RETURNS
+ *	     Nothing
+*/
+
+static void freeBatchReadWorkers(BatchReadWorker* pWorkers, int noOfWorkers)
+{
+	int count = 0;
+
+	if (pWorkers == NULL)
+		return;
+
+	for (count = 0; count < noOfWorkers; count++) {
+		if (pWorkers[count].pCursor_ != NULL)
+			freeXDRInputBuffer(pWorkers[count].pCursor_);
+		if (pWorkers[count].pExceptionStructure_ != NULL)
+			freeExceptionStructure(pWorkers[count].pExceptionStructure_);
+		freeListErrorStructure(&pWorkers[count].pListErrorStructure_);
+		freeIPDRIntMap(pWorkers[count].pValidatorMap_);
+		freeIPDRIntMap(pWorkers[count].pValidationMemo_);
+	}
+
+	free(pWorkers);
+}
+
+
+/*!
+ *  NAME:
+ *      newBatchReadWorkers() - allocates the workers of a batch read
+ *
+ *  ARGUMENTS:
+ *       -	IPDRCommonParameters (IN)
+ *       -	ppFNFData (IN), the slots of the batch
+ *       -	pOffsets (IN), the offsets of the slots
+ *       -	noOfWorkers (IN)
+ *
+ *  RETURNS
+ *	     Returns the workers, or NULL if memory allocation failed
+*/
+
+static BatchReadWorker* newBatchReadWorkers(
+			 IPDRCommonParameters* pIPDRCommonParameters,
+			 FNFData** ppFNFData,
+			 const size_t* pOffsets,
+			 int noOfWorkers
+			)
+{
+	int count = 0;
+	BatchReadWorker* pWorkers;
+
+	pWorkers = (BatchReadWorker *) calloc(noOfWorkers, sizeof(BatchReadWorker));
+	if (pWorkers == NULL)
+		return (NULL);
+
+	for (count = 0; count < noOfWorkers; count++) {
+		pWorkers[count].pCursor_ = newXDRInputBufferCursor(pIPDRCommonParameters->pInputBuffer_);
+		pWorkers[count].pExceptionStructure_ = newExceptionStructure();
+		pWorkers[count].ppFNFData_ = ppFNFData;
+		pWorkers[count].pOffsets_ = pOffsets;
+		pWorkers[count].baseCount_ = pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_;
+		if (pWorkers[count].pCursor_ == NULL || pWorkers[count].pExceptionStructure_ == NULL) {
+			freeBatchReadWorkers(pWorkers, count + 1);
+			return (NULL);
+		}
+	}
+
+	return (pWorkers);
+}
+
+
+/*!
+ *  NAME:
+ *      freeBatchRecords() - frees the records of a failed batch read
+ *
+ *  ARGUMENTS:
+ *       -	ppFNFData (IN/OUT)
+ *       -	noOfRecords (IN)
+ *
+ *  RETURNS
+ *	     Nothing
+*/
+
+static void freeBatchRecords(FNFData** ppFNFData, int noOfRecords)
+{
+	int count = 0;
+
+	for (count = 0; count < noOfRecords; count++) {
+		if (ppFNFData[count] != NULL)
+			freeFNFData(ppFNFData[count]);
+		ppFNFData[count] = NULL;
+	}
+}
+
+
+/*!
+ *  NAME:
+ *      readIPDRSequence() - reads a batch of records with readIPDR
+ *
+ *  DESCRIPTION:
+ *      Used for XML documents and documents that are not mapped.
+ *
+ *  ARGUMENTS:
+ *       -	IPDRCommonParameters (IN/OUT)
+ *       -	ppFNFData (OUT)
+ *       -	maxRecords (IN)
+ *       -	pNoOfRecords (OUT)
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+*/
+
+static int readIPDRSequence(
+			 IPDRCommonParameters* pIPDRCommonParameters,
+			 FNFData** ppFNFData,
+			 int maxRecords,
+			 int* pNoOfRecords,
+			 int* pErrorCode
+			)
+{
+	int count = 0;
+
+	for (count = 0; count < maxRecords; count++) {
+		ppFNFData[count] = newFNFData();
+		if (ppFNFData[count] == NULL) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			freeBatchRecords(ppFNFData, count);
+			return (IPDR_ERROR);
+		}
+		if (readIPDR(pIPDRCommonParameters, &ppFNFData[count], pErrorCode) == IPDR_ERROR) {
+			freeBatchRecords(ppFNFData, count + 1);
+			return (IPDR_ERROR);
+		}
+		if (ppFNFData[count] == NULL)
+			break;
+	}
+
+	*pNoOfRecords = count;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      readIPDRBatch() - 	reads up to maxRecords IPDR records at once
+ *
+ *  DESCRIPTION:
+ *      The records of a mapped XDR document are decoded on several
+ *      threads:
+ *		 - The calling thread scans the document, stepping over the
+ *		   values of each record with its compiled codec plan and
+ *		   noting where the record starts. Descriptors are read as
+ *		   readIPDR does; records holding structures, or that cannot
+ *		   be stepped over, are read by the scan itself.
+ *		 - The noted records are split into contiguous runs decoded
+ *		   by the workers, each with its own cursor over the mapping.
+ *		 - The records are returned in document order.
+ *      Other documents, or noOfThreads of 1, are read with readIPDR.
+ *
+ *      Fewer than maxRecords records are returned once the end of the
+ *      document has been read; readDocEnd is called next. The caller
+ *      frees each record with freeFNFData. On an error no records are
+ *      returned.
+ *
+ *  ARGUMENTS:
+ *       -	IPDRCommonParameters (IN/OUT)	
+ * 		 -	ppFNFData (OUT), array of at least maxRecords records
+ * 		 -	maxRecords (IN)
+ * 		 -	noOfThreads (IN), 0 for one per processor
+ * 		 -	pNoOfRecords (OUT)
+ *
+ *  RETURNS 	
+ *	     Returns Zero or appropriate error code
+*/
+
+int readIPDRBatch(
+			 IPDRCommonParameters* pIPDRCommonParameters, 
+			 FNFData** ppFNFData, 
+			 int maxRecords,
+			 int noOfThreads,
+			 int* pNoOfRecords,
+			 int* pErrorCode
+			)
+{
+	int slot = 0;
+	int first = 0;
+	int baseCount = 0;
+	int noOfRecords = 0;
+	int descriminator = 0;
+	int descriptorID = 0;
+	int skipErrorCode = 0;
+	int docEnd = IPDR_FALSE;
+	int errorSeverity = IPDR_OK;
+	size_t offset = 0;
+	size_t* pOffsets = NULL;
+	XDRInputBuffer* pInputBuffer;
+	const XDRCodecPlan* pCodecPlan;
+	BatchReadWorker* pWorkers = NULL;
+
+	if(ppFNFData == NULL || pIPDRCommonParameters == NULL || pNoOfRecords == NULL) {
+	    *pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+	    return (IPDR_ERROR);
+	}
+
+	*pNoOfRecords = 0;
+
+	if (pIPDRCommonParameters->DocState_ != READABLE) {
+		*pErrorCode = IPDR_INVALID_DOCSTATE_MAKE_READABLE;
+		return (IPDR_ERROR);
+	}
+
+	if (maxRecords <= 0)
+		return (IPDR_OK);
+
+	if (noOfThreads <= 0)
+		noOfThreads = getIPDRProcessorCount();
+
+	pInputBuffer = pIPDRCommonParameters->pInputBuffer_;
+	if (pIPDRCommonParameters->DocType_ != XDR || noOfThreads <= 1 ||
+		pInputBuffer == NULL || pInputBuffer->pMapping_ == NULL)
+		return (readIPDRSequence(pIPDRCommonParameters, ppFNFData, maxRecords,
+								 pNoOfRecords, pErrorCode));
+
+	/* The schema index is built lazily, so before the workers share it */
+	if (pIPDRCommonParameters->pSchema_ != NULL &&
+		pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL &&
+		pIPDRCommonParameters->pSchema_->pElementIndex_ == NULL &&
+		buildSchemaIndex(pIPDRCommonParameters->pSchema_, pErrorCode) != IPDR_OK) {
+		pIPDRCommonParameters->DocState_ = NONREADABLE; 
+		exceptionHandler(pIPDRCommonParameters, pErrorCode, "buildSchemaIndex");	
+		return (IPDR_ERROR);
+	}
+
+	pOffsets = (size_t *) calloc(maxRecords, sizeof(size_t));
+	if (pOffsets != NULL)
+		pWorkers = newBatchReadWorkers(pIPDRCommonParameters, ppFNFData, pOffsets, noOfThreads);
+	if (pWorkers == NULL) {
+		free(pOffsets);
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return (IPDR_ERROR);
+	}
+
+	baseCount = pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_;
+
+	while (noOfRecords < maxRecords && docEnd == IPDR_FALSE &&
+		   errorSeverity != IPDR_ERROR) {
+		descriminator = read_long(pInputBuffer);
+
+		switch (descriminator)
+		{
+			case STREAM_RECORD_DESCRIPTOR:
+				/* Records before a descriptor do not see its service attributes */
+				errorSeverity = decodeBatchRecords(pIPDRCommonParameters, pWorkers, noOfThreads,
+												   first, noOfRecords, pErrorCode);
+				first = noOfRecords;
+				if (errorSeverity != IPDR_ERROR)
+					errorSeverity = readXDRDescriptor(pIPDRCommonParameters, pErrorCode);
+				break;
+
+			case STREAM_IPDR_RECORD:
+				slot = noOfRecords++;
+				ppFNFData[slot] = newFNFData();
+				if (ppFNFData[slot] == NULL) {
+					*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+					errorSeverity = IPDR_ERROR;
+					break;
+				}
+
+				offset = pInputBuffer->offset_;
+				descriptorID = read_long(pInputBuffer);
+				pCodecPlan = getXDRCodecPlan(pIPDRCommonParameters, descriptorID);
+				if (pCodecPlan != NULL && pCodecPlan->hasStructures_ == IPDR_FALSE &&
+					read_long(pInputBuffer) == IPDR_INDEFINITE_LENGTH_INDICATOR &&
+					skipXDRCodecPlan(pInputBuffer, pCodecPlan,
+									 pIPDRCommonParameters->schemaVersion,
+									 &skipErrorCode) == IPDR_OK) {
+					pOffsets[slot] = offset;
+					break;
+				}
+
+				seekXDRInputBuffer(pInputBuffer, offset);
+				pOffsets[slot] = BATCH_SLOT_DECODED;
+				pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_ = baseCount + slot;
+				errorSeverity = readXDRRecord(pIPDRCommonParameters, ppFNFData[slot], pErrorCode);
+				break;
+
+			case STREAM_DOC_END:
+				docEnd = IPDR_TRUE;
+				break;
+
+			default:
+				*pErrorCode = IPDR_INVALID_DESCRIMINATOR;
+				pIPDRCommonParameters->DocState_ = NONREADABLE; 
+				exceptionHandler(pIPDRCommonParameters, pErrorCode, "readIPDRBatch");	
+				errorSeverity = IPDR_ERROR;
+				break;
+		}
+	}
+
+	if (errorSeverity != IPDR_ERROR)
+		errorSeverity = decodeBatchRecords(pIPDRCommonParameters, pWorkers, noOfThreads,
+										   first, noOfRecords, pErrorCode);
+
+	freeBatchReadWorkers(pWorkers, noOfThreads);
+	free(pOffsets);
+
+	if (errorSeverity == IPDR_ERROR) {
+		freeBatchRecords(ppFNFData, noOfRecords);
+		return (IPDR_ERROR);
+	}
+
+	/* As with readIPDR, the document end is counted */
+	pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_ = 
+		baseCount + noOfRecords + (docEnd == IPDR_TRUE ? 1 : 0);
+	*pNoOfRecords = noOfRecords;
+
+	return (IPDR_OK);
+}
+
+
 /*!
  *  NAME:
  *      readDocEnd() - 		This function reads the docEnd
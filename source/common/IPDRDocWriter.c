@@ -173,6 +173,13 @@ else
     
  /* Write the validated header structure in the output stream.*/
  if(pIPDRCommonParameters->DocType_ == XDR) {
+  errorSeverity = attachXDROutputBuffer(pIPDRCommonParameters, pErrorCode);
+  if (errorSeverity == IPDR_ERROR) {
+   pIPDRCommonParameters->DocState_ = NONWRITABLE; 
+   exceptionHandler(pIPDRCommonParameters, pErrorCode, "attachXDROutputBuffer"); 
+   return (IPDR_ERROR);
+  }
+
   errorSeverity = writeIPDRXDRHeaderHelper(pIPDRCommonParameters, pIPDRHeader, pErrorCode);
   if (errorSeverity == IPDR_WARNING) {
    errorHandler(pIPDRCommonParameters, pErrorCode, "writeIPDRXDRHeaderHelper"); 
@@ -182,6 +189,13 @@ else
    exceptionHandler(pIPDRCommonParameters, pErrorCode, "writeIPDRXDRHeaderHelper"); 
    return (IPDR_ERROR);
   }
+
+  errorSeverity = commitXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, pErrorCode);
+  if (errorSeverity == IPDR_ERROR) {
+   pIPDRCommonParameters->DocState_ = NONWRITABLE; 
+   exceptionHandler(pIPDRCommonParameters, pErrorCode, "commitXDROutputBuffer"); 
+   return (IPDR_ERROR);
+  }
  }
  else if (pIPDRCommonParameters->DocType_ == XML) {
   errorSeverity = writeIPDRXMLHeaderHelper(pIPDRCommonParameters, pIPDRHeader, pErrorCode);
@@ -303,6 +317,7 @@ int createFNFData(
  /* After these validations, this function populates FNFData and pass as out parameter */ 
  
  strcpy(pFNFData->typeName_, pFNFType->serviceType_);
+ pFNFData->descriptorID_ = pFNFType->descriptorID_;
  
  pFirstListAttributeDescriptor = pFNFType->pListAttributeDescriptor_;
  while(pFNFType->pListAttributeDescriptor_ != NULL) {
@@ -442,250 +457,384 @@ int createFNFData(
  
 /*!
  *  NAME:
- *      writeIPDR() - converts the Raw input into well-formed XDR document.
+ *      abandonRecords() - ends a document at the last complete record.
  *
  *  DESCRIPTION:
- *      - This function takes FNFData structure as input
- *      - Calls function validateAgainstSchema
- *  - Checks for input descriptor (AttributeDescriptorHashTable) in Lookup Hash                    
- *             table(DescriptorLookupHashTable). This function will return Descriptor ID. 
+ *      - Drops what was buffered after pRecordStart, along with the
+ *        descriptors created from descriptorCount on
+ *      - Writes the records buffered before it to the stream; a
+ *        NONWRITABLE document is not flushed when it is freed
+ *      - Makes the document NONWRITABLE
  *
  *  ARGUMENTS:
  *      - IPDRCommonParameters {IN/OUT}
- *     - FNFData {IN}
+ *      - pRecordStart {IN}
+ *      - descriptorCount {IN}
+ *
+ *  RETURNS  
+ *       Nothing
+*/
+ 
+static void abandonRecords(
+     IPDRCommonParameters* pIPDRCommonParameters, 
+     const XDROutputMark* pRecordStart, 
+     int descriptorCount
+    )
+{
+ int errorCode = 0;
+ 
+ if (pIPDRCommonParameters->pOutputBuffer_ != NULL &&
+  truncateXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, pRecordStart) == IPDR_OK)
+  flushXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, &errorCode);
+ 
+ if (pIPDRCommonParameters->DocType_ == XDR)
+  dropDescriptors(pIPDRCommonParameters, descriptorCount);
+ 
+ pIPDRCommonParameters->DocState_ = NONWRITABLE; 
+}
+ 
+/*!
+ *  NAME:
+ *      resolveDescriptor() - resolves the descriptor of an FNFType once.
+ *
+ *  DESCRIPTION:
+ *      - Finds the descriptor of the FNFType, creating and writing it
+ *        if the document does not have one yet
+ *      - Stores the descriptor ID in the FNFType; createFNFData passes 
+ *        it on to every FNFData so that writeIPDR skips the lookup
+ *      - The ID is only valid for this document and only as long as
+ *        the attribute list of the FNFType is not changed
+ *      - XML documents have no descriptors, the FNFType gets a new
+ *        document local ID under which its XML template is kept
+ *
+ *  ARGUMENTS:
+ *      - IPDRCommonParameters {IN/OUT}
+ *      - FNFType {IN/OUT}
  *      - pErrorCode {IN/OUT} 
  *
  *  RETURNS  
  *       Returns Zero or appropriate error code
 */
  
-int writeIPDR(
+int resolveDescriptor(
      IPDRCommonParameters* pIPDRCommonParameters, 
-     FNFData* pFNFData, 
+     FNFType* pFNFType, 
      int* pErrorCode
     )
 {
  int errorSeverity = 0;
  int descriptorID = 0;
+ int descriptorCount = 0;
+ FNFData* pFNFData = NULL;
+ XDROutputMark descriptorStart;
  
- char* tempString;
- char* resultGet;
- unsigned int length = 0;
- void* IPDRValue = NULL;
- 
- IPDRStreamElement* pIPDRStreamElement;
- ListAttributeDescriptor* pCurrentListAttributeDescriptor = NULL;
- ListIPDRData* pCurrentListIPDRData = NULL;
- 
- if(pFNFData == NULL || 
+ if(pFNFType == NULL || 
   pIPDRCommonParameters == NULL
      ) {
      *pErrorCode = IPDR_NULL_INPUT_PARAMETER;
      return (IPDR_ERROR);
  }
  
-
- pIPDRStreamElement = newIPDRStreamElement(STREAM_IPDR_RECORD);
- 
- length = getLengthSerializeFNFData(pFNFData);
-    tempString = (char *) calloc(sizeof(char), length);
- 
-  
- if(tempString == NULL || pIPDRStreamElement == NULL) {
-  *pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
-  return(IPDR_ERROR);
- }
- 
  if ((int)pIPDRCommonParameters->DocState_ != WRITABLE) {
   *pErrorCode = IPDR_INVALID_DOCSTATE_MAKE_WRITABLE;
   return(IPDR_ERROR);
  }
-    
  
+ if (pIPDRCommonParameters->DocType_ == XML) {
+  /* 0 is the unresolved ID */
+  if (pIPDRCommonParameters->descriptorCount_ <= 0)
+   pIPDRCommonParameters->descriptorCount_ = 1;
+  pFNFType->descriptorID_ = pIPDRCommonParameters->descriptorCount_++;
+  return (IPDR_OK);
+ }
  
- 		if ((pIPDRCommonParameters->pSchema_ != NULL) && (pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL)) {
-		errorSeverity = validateAgainstSchema(pIPDRCommonParameters, pFNFData, pErrorCode);
-		 if (errorSeverity == IPDR_WARNING) {
-		  errorHandler(pIPDRCommonParameters, pErrorCode, "validateAgainstSchema"); 
-		 }
-		 else if (errorSeverity == IPDR_ERROR) {
-		  pIPDRCommonParameters->DocState_ = NONWRITABLE; 
-		  exceptionHandler(pIPDRCommonParameters, pErrorCode, "validateAgainstSchema"); 
-		  return (IPDR_ERROR);
-		 }
-	 }
+ if (pIPDRCommonParameters->DocType_ != XDR)
+  return (IPDR_OK);
  
-    
- if(pIPDRCommonParameters->DocType_ == XDR) {
+ descriptorID = findDescriptor(pIPDRCommonParameters, pFNFType->serviceType_, 
+                               pFNFType->pListAttributeDescriptor_);
+ if (descriptorID == 0) {
+  markXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, &descriptorStart);
+  descriptorCount = pIPDRCommonParameters->descriptorCount_;
+ 
+  pFNFData = newFNFData();
+  if(pFNFData == NULL) {
+   *pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+   return(IPDR_ERROR);
+  }
+ 
+  /* The lists are only borrowed, createDescriptor copies them */
+  strcpy(pFNFData->typeName_, pFNFType->serviceType_);
+  pFNFData->pListAttributeDescriptor_ = pFNFType->pListAttributeDescriptor_;
+  pFNFData->pListServiceAttributeDescriptor_ = pFNFType->pListServiceAttributeDescriptor_;
+ 
+  errorSeverity = createDescriptor(pIPDRCommonParameters, pFNFData->pListAttributeDescriptor_, pFNFData, pErrorCode); 
+ 
+  pFNFData->pListAttributeDescriptor_ = NULL;
+  pFNFData->pListServiceAttributeDescriptor_ = NULL;
+  freeFNFData(pFNFData);
  
-  errorSeverity = serializeFNFDataStructure(pFNFData, tempString, pErrorCode);
   if (errorSeverity == IPDR_WARNING) {
-   errorHandler(pIPDRCommonParameters, pErrorCode, "serializeFNFDataStructure"); 
+   errorHandler(pIPDRCommonParameters, pErrorCode, "createDescriptor"); 
+  }
+  else if (errorSeverity == IPDR_ERROR) {
+   abandonRecords(pIPDRCommonParameters, &descriptorStart, descriptorCount);
+   exceptionHandler(pIPDRCommonParameters, pErrorCode, "createDescriptor"); 
+   return (IPDR_ERROR);
+  }
+ 
+  descriptorID = pIPDRCommonParameters->descriptorCount_ - 1;
+ }
+ 
+ pFNFType->descriptorID_ = descriptorID;
+ 
+ return (IPDR_OK);
+}
+ 
+/*!
+ *  NAME:
+ *      resolveRecordDescriptor() - finds the descriptor of a record.
+ *
+ *  DESCRIPTION:
+ *      - A descriptor ID already set in the FNFData is taken if the
+ *        document has that descriptor for the same type name
+ *      - Otherwise the descriptor is found by fingerprint, or created
+ *        and written if the document does not have one yet
+ *
+ *  ARGUMENTS:
+ *      - IPDRCommonParameters {IN/OUT}
+ *      - FNFData {IN}
+ *      - pDescriptorID {OUT}
+ *      - pErrorCode {IN/OUT} 
+ *
+ *  RETURNS  
+ *       Returns Zero or appropriate error code
+*/
+ 
+static int resolveRecordDescriptor(
+     IPDRCommonParameters* pIPDRCommonParameters, 
+     FNFData* pFNFData, 
+     int* pDescriptorID, 
+     int* pErrorCode
+    )
+{
+ int errorSeverity = 0;
+ int descriptorID = 0;
+ const RecordDescriptor* pRecordDescriptor = NULL;
+ 
+ /* A pre-resolved descriptor is taken as is, otherwise it is found by fingerprint */
+ descriptorID = pFNFData->descriptorID_;
+ if (descriptorID != 0) {
+  pRecordDescriptor = lookupDescriptor(pIPDRCommonParameters, descriptorID);
+  if (pRecordDescriptor == NULL || 
+	  strcmp(pRecordDescriptor->typeName_, pFNFData->typeName_) != 0)
+   descriptorID = 0;
+ }
+ if (descriptorID == 0)
+  descriptorID = findDescriptor(pIPDRCommonParameters, pFNFData->typeName_, 
+                                pFNFData->pListAttributeDescriptor_);
+ 
+ if (descriptorID == 0) {
+  errorSeverity = createDescriptor(pIPDRCommonParameters, pFNFData->pListAttributeDescriptor_, pFNFData, pErrorCode); 
+  if (errorSeverity == IPDR_WARNING) {
+   errorHandler(pIPDRCommonParameters, pErrorCode, "createDescriptor"); 
   }
   else if (errorSeverity == IPDR_ERROR) {
    pIPDRCommonParameters->DocState_ = NONWRITABLE; 
-   exceptionHandler(pIPDRCommonParameters, pErrorCode, "serializeFNFDataStructure"); 
+   exceptionHandler(pIPDRCommonParameters, pErrorCode, "createDescriptor"); 
    return (IPDR_ERROR);
   }
+ 
+  descriptorID = pIPDRCommonParameters->descriptorCount_ - 1;
+ }
+ 
+ *pDescriptorID = descriptorID;
+ 
+ return (IPDR_OK);
+}
+ 
+/*!
+ *  NAME:
+ *      writeXDRRecordCopy() - writes a record through a stream element.
+ *
+ *  DESCRIPTION:
+ *      - Copies the descriptors and values of the FNFData into a new
+ *        IPDRStreamElement and writes it with writeIPDRStreamElementHelper;
+ *        the helper changes the descriptors of records with structures,
+ *        so the FNFData of the caller is not handed to it
+ *      - The output buffer is not committed
+ *
+ *  ARGUMENTS:
+ *      - IPDRCommonParameters {IN/OUT}
+ *      - FNFData {IN}
+ *      - descriptorID {IN}
+ *      - pErrorCode {IN/OUT} 
+ *
+ *  RETURNS  
+ *       Returns Zero or appropriate error code
+*/
+ 
+static int writeXDRRecordCopy(
+     IPDRCommonParameters* pIPDRCommonParameters, 
+     FNFData* pFNFData, 
+     int descriptorID, 
+     int* pErrorCode
+    )
+{
+ int errorSeverity = 0;
+ 
+ void* IPDRValue = NULL;
+ 
+ IPDRStreamElement* pIPDRStreamElement;
+ ListAttributeDescriptor* pCurrentListAttributeDescriptor = NULL;
+ ListIPDRData* pCurrentListIPDRData = NULL;
+ 
+ pIPDRStreamElement = newIPDRStreamElement(STREAM_IPDR_RECORD);
+ 
+ if(pIPDRStreamElement == NULL) {
+  *pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+  return(IPDR_ERROR);
+ }
+ 
 
-  resultGet = (char *) HashTableGet(pIPDRCommonParameters->pDescriptorLookupHashTable_, tempString); 
-  if (resultGet !=NULL)
-   descriptorID = atoi(resultGet);
-  else 
-   descriptorID = 0;
+ pIPDRStreamElement->descriminator_ = STREAM_IPDR_RECORD;
  
-  if (descriptorID == 0) {
-   errorSeverity = createDescriptor(pIPDRCommonParameters, pFNFData->pListAttributeDescriptor_, pFNFData, pErrorCode); 
-   if (errorSeverity == IPDR_WARNING) {
-    errorHandler(pIPDRCommonParameters, pErrorCode, "createDescriptor"); 
-   }
-   else if (errorSeverity == IPDR_ERROR) {
-    pIPDRCommonParameters->DocState_ = NONWRITABLE; 
-    exceptionHandler(pIPDRCommonParameters, pErrorCode, "createDescriptor"); 
-    return (IPDR_ERROR);
-   }
+ pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->descriptorID_  = descriptorID;  
+ pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->descriptorID_ = descriptorID;
  
-   descriptorID = pIPDRCommonParameters->descriptorCount_ - 1;
-  }
  
-  
-  pIPDRStreamElement->descriminator_ = STREAM_IPDR_RECORD;
+ strcpy(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->typeName_, pFNFData->typeName_);
  
-  pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->descriptorID_  = descriptorID;  
-  
-  
-  strcpy(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->typeName_, pFNFData->typeName_);
-  
-  pCurrentListAttributeDescriptor = pFNFData->pListAttributeDescriptor_;
-  while (pFNFData->pListAttributeDescriptor_ != NULL) {
-   appendListAttributeDescriptor(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListAttributeDescriptor_),
-           pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeName_,
-           pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeType_,
-           pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->description_,
-           pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->derivedType_ ,
+ pCurrentListAttributeDescriptor = pFNFData->pListAttributeDescriptor_;
+ while (pFNFData->pListAttributeDescriptor_ != NULL) {
+  appendListAttributeDescriptor(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListAttributeDescriptor_),
+          pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeName_,
+          pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeType_,
+          pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->description_,
+          pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->derivedType_ ,
 								   pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_, 
 								   pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->pListAttrNameList_, 
 								   pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->pListAttrClassList_,
 								   pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->pListAttrMaxOccursList_, 
 								   pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ 
-           );
-   pFNFData->pListAttributeDescriptor_ = pFNFData->pListAttributeDescriptor_->pNext_; 
-  }
-  pFNFData->pListAttributeDescriptor_ = pCurrentListAttributeDescriptor;
- 
-  pCurrentListAttributeDescriptor = pFNFData->pListServiceAttributeDescriptor_;
-  while (pFNFData->pListServiceAttributeDescriptor_ != NULL) {
-   appendListAttributeDescriptor(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListServiceAttributeDescriptor_),
-           pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->attributeName_,
-           pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->attributeType_,
-           pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->description_,
-           pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->derivedType_ ,
+          );
+  pFNFData->pListAttributeDescriptor_ = pFNFData->pListAttributeDescriptor_->pNext_; 
+ }
+ pFNFData->pListAttributeDescriptor_ = pCurrentListAttributeDescriptor;
+ 
+ pCurrentListAttributeDescriptor = pFNFData->pListServiceAttributeDescriptor_;
+ while (pFNFData->pListServiceAttributeDescriptor_ != NULL) {
+  appendListAttributeDescriptor(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListServiceAttributeDescriptor_),
+          pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->attributeName_,
+          pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->attributeType_,
+          pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->description_,
+          pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->derivedType_ ,
 								   pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->complexType_, 
 								   pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->pListAttrNameList_, 
 								   pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->pListAttrClassList_,
 								   pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->pListAttrMaxOccursList_, 
 								   pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ 
-           );
-   pFNFData->pListServiceAttributeDescriptor_ = pFNFData->pListServiceAttributeDescriptor_->pNext_; 
-  }
-  pFNFData->pListServiceAttributeDescriptor_ = pCurrentListAttributeDescriptor;
+          );
+  pFNFData->pListServiceAttributeDescriptor_ = pFNFData->pListServiceAttributeDescriptor_->pNext_; 
+ }
+ pFNFData->pListServiceAttributeDescriptor_ = pCurrentListAttributeDescriptor;
 
-  pCurrentListIPDRData = pFNFData->pListIPDRData_;
+ pCurrentListIPDRData = pFNFData->pListIPDRData_;
  
-  while (pFNFData->pListIPDRData_ != NULL) {
+ while (pFNFData->pListIPDRData_ != NULL) {
 	switch (pFNFData->pListIPDRData_->IPDRDataType_)
 	{
 	case IPDRDATA_HEXADECARRAY:
 		appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
-        pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRByteArray_,
-        IPDRDATA_HEXADECARRAY);
+       pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRByteArray_,
+       IPDRDATA_HEXADECARRAY);
 		break;
 	case IPDRDATA_DOUBLE:
 		  IPDRValue = (double *) &pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRDouble_;
-      appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
-        IPDRValue,
-        IPDRDATA_DOUBLE);
+     appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
+       IPDRValue,
+       IPDRDATA_DOUBLE);
 		  break;
 
 	case IPDRDATA_FLOAT:
-   IPDRValue = (float *) &pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRFloat_;
-    appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
-        IPDRValue,
-        IPDRDATA_FLOAT);
+  IPDRValue = (float *) &pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRFloat_;
+   appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
+       IPDRValue,
+       IPDRDATA_FLOAT);
 		break;
 
 	case IPDRDATA_LONG:
 		   appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
-        (void *) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRLong_,
-        IPDRDATA_LONG);
+       (void *) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRLong_,
+       IPDRDATA_LONG);
 		break;
 
 	case IPDRDATA_LONGLONG:
 		appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
-        (void *) &(pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRLongLong_),
-        IPDRDATA_LONGLONG);
-   
+       (void *) &(pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRLongLong_),
+       IPDRDATA_LONGLONG);
+  
 		break;
 
 	case IPDRDATA_ULONG:
 		    appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
-        (void *) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRULong_,
-        IPDRDATA_ULONG);
+       (void *) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRULong_,
+       IPDRDATA_ULONG);
 		break;
 
 	case IPDRDATA_ULONGLONG:
 		appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
-        (void *) &(pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRULongLong_),
-        IPDRDATA_ULONGLONG);
+       (void *) &(pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRULongLong_),
+       IPDRDATA_ULONGLONG);
 		break;
 	case IPDRDATA_STRING:
 		    appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
-        pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUTF8Array_,
-        IPDRDATA_STRING);
+       pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUTF8Array_,
+       IPDRDATA_STRING);
 		  break;
-   case IPDRDATA_BOOLEAN:
-    	appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
-        pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRBoolean_,
-       IPDRDATA_BOOLEAN);
+  case IPDRDATA_BOOLEAN:
+   	appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
+       pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRBoolean_,
+      IPDRDATA_BOOLEAN);
 		break;
 	case IPDRDATA_SHORT:
-     	/*IPDRValue = (short int *) &pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRShort_;
-    	appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
-        IPDRValue,
-       IPDRDATA_SHORT);*/
-    	appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
-        (void *) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRShort_,
-       IPDRDATA_SHORT);
+    	/*IPDRValue = (short int *) &pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRShort_;
+   	appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
+       IPDRValue,
+      IPDRDATA_SHORT);*/
+   	appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
+       (void *) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRShort_,
+      IPDRDATA_SHORT);
 		break;
-   case IPDRDATA_USHORT:
-     	/*IPDRValue = (unsigned short int *) &pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUShort_;
-    	appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
-        IPDRValue,
-       IPDRDATA_USHORT);*/
-    	appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
-        (void *) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUShort_,
-       IPDRDATA_USHORT);
+  case IPDRDATA_USHORT:
+    	/*IPDRValue = (unsigned short int *) &pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUShort_;
+   	appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
+       IPDRValue,
+      IPDRDATA_USHORT);*/
+   	appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
+       (void *) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUShort_,
+      IPDRDATA_USHORT);
 		 break;
 	case IPDRDATA_ARRAY:
-    		appendListArrayToIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
-        		pFNFData->pListIPDRData_->pListIPDRArrayData_,
+   		appendListArrayToIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
+       		pFNFData->pListIPDRData_->pListIPDRArrayData_,
 				pFNFData->pListIPDRData_->noOfElements_,
 				IPDRDATA_ARRAY);
 		break;
 	case IPDRDATA_STRUCTURE:
-        appendListStructureToIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
+       appendListStructureToIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
 			pFNFData->pListIPDRData_->pListIPDRStructureData_,
-        	IPDRDATA_STRUCTURE);
+       	IPDRDATA_STRUCTURE);
 		break;
 	case IPDRDATA_BYTE:
 		   appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
-        (void *) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRByte_,
-        IPDRDATA_BYTE);
+       (void *) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRByte_,
+       IPDRDATA_BYTE);
 		break;
 	case IPDRDATA_UBYTE:
 		   appendListIPDRData(&(pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pIPDRRecord_->pFNFData_->pListIPDRData_),
-        (void *) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRByte_,
-        IPDRDATA_UBYTE);
+       (void *) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRByte_,
+       IPDRDATA_UBYTE);
 		break;
 
 	default:
@@ -693,20 +842,108 @@ int writeIPDR(
 
 
 	}
-   
-   pFNFData->pListIPDRData_ = pFNFData->pListIPDRData_->pNext_; 
-  }
   
-  pFNFData->pListIPDRData_ = pCurrentListIPDRData;
+  pFNFData->pListIPDRData_ = pFNFData->pListIPDRData_->pNext_; 
+ }
  
-
-  errorSeverity = writeIPDRStreamElementHelper(pIPDRCommonParameters, pIPDRStreamElement, pErrorCode);
-  if (errorSeverity == IPDR_WARNING) {
-   errorHandler(pIPDRCommonParameters, pErrorCode, "writeIPDRStreamElementHelper"); 
+ pFNFData->pListIPDRData_ = pCurrentListIPDRData;
+ 
+ errorSeverity = writeIPDRStreamElementHelper(pIPDRCommonParameters, pIPDRStreamElement, pErrorCode);
+ freeIPDRStreamElement (pIPDRStreamElement);
+ if (errorSeverity == IPDR_WARNING) {
+  errorHandler(pIPDRCommonParameters, pErrorCode, "writeIPDRStreamElementHelper"); 
+ }
+ else if (errorSeverity == IPDR_ERROR) {
+  pIPDRCommonParameters->DocState_ = NONWRITABLE; 
+  exceptionHandler(pIPDRCommonParameters, pErrorCode, "writeIPDRStreamElementHelper"); 
+  return (IPDR_ERROR);
+ }
+ 
+ return (IPDR_OK);
+}
+ 
+/*!
+ *  NAME:
+ *      writeIPDR() - converts the Raw input into well-formed XDR document.
+ *
+ *  DESCRIPTION:
+ *      - This function takes FNFData structure as input
+ *      - Calls function validateAgainstSchema
+ *  - Checks for input descriptor (AttributeDescriptorHashTable) in Lookup Hash                    
+ *             table(DescriptorLookupHashTable). This function will return Descriptor ID. 
+ *
+ *  ARGUMENTS:
+ *      - IPDRCommonParameters {IN/OUT}
+ *     - FNFData {IN}
+ *      - pErrorCode {IN/OUT} 
+ *
+ *  RETURNS  
+ *       Returns Zero or appropriate error code
+*/
+ 
+int writeIPDR(
+     IPDRCommonParameters* pIPDRCommonParameters, 
+     FNFData* pFNFData, 
+     int* pErrorCode
+    )
+{
+ int errorSeverity = 0;
+ int descriptorID = 0;
+ int descriptorCount = 0;
+ XDROutputMark recordStart;
+ 
+ if(pFNFData == NULL || 
+  pIPDRCommonParameters == NULL
+     ) {
+     *pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+     return (IPDR_ERROR);
+ }
+ 
+ if ((int)pIPDRCommonParameters->DocState_ != WRITABLE) {
+  *pErrorCode = IPDR_INVALID_DOCSTATE_MAKE_WRITABLE;
+  return(IPDR_ERROR);
+ }
+ 
+ /* A record that fails is dropped with the descriptor written for it */
+ markXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, &recordStart);
+ descriptorCount = pIPDRCommonParameters->descriptorCount_;
+    
+ 
+ 
+ 		if ((pIPDRCommonParameters->pSchema_ != NULL) && (pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL)) {
+		/* The descriptor ID of an FNFType is 0 until resolved; a pre-resolved
+		   record has the attributes of its descriptor */
+		errorSeverity = validateRecordAgainstSchema(pIPDRCommonParameters, pFNFData, 
+		                                            pFNFData->descriptorID_ != 0 ? 
+		                                            pFNFData->descriptorID_ : SCHEMA_NO_DESCRIPTOR_ID, 
+		                                            pFNFData->descriptorID_ != 0, 
+		                                            pErrorCode);
+		 if (errorSeverity == IPDR_WARNING) {
+		  errorHandler(pIPDRCommonParameters, pErrorCode, "validateAgainstSchema"); 
+		 }
+		 else if (errorSeverity == IPDR_ERROR) {
+		  abandonRecords(pIPDRCommonParameters, &recordStart, descriptorCount);
+		  exceptionHandler(pIPDRCommonParameters, pErrorCode, "validateAgainstSchema"); 
+		  return (IPDR_ERROR);
+		 }
+	 }
+ 
+    
+ if(pIPDRCommonParameters->DocType_ == XDR) {
+ 
+  errorSeverity = resolveRecordDescriptor(pIPDRCommonParameters, pFNFData, &descriptorID, pErrorCode);
+  if (errorSeverity != IPDR_ERROR)
+   errorSeverity = writeXDRRecordCopy(pIPDRCommonParameters, pFNFData, descriptorID, pErrorCode);
+  if (errorSeverity == IPDR_ERROR) {
+   abandonRecords(pIPDRCommonParameters, &recordStart, descriptorCount);
+   return (IPDR_ERROR);
   }
-  else if (errorSeverity == IPDR_ERROR) {
+
+  /* Record boundary, the output buffer is drained once it is full */
+  errorSeverity = commitXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, pErrorCode);
+  if (errorSeverity == IPDR_ERROR) {
    pIPDRCommonParameters->DocState_ = NONWRITABLE; 
-   exceptionHandler(pIPDRCommonParameters, pErrorCode, "writeIPDRStreamElementHelper"); 
+   exceptionHandler(pIPDRCommonParameters, pErrorCode, "commitXDROutputBuffer"); 
    return (IPDR_ERROR);
   }
  }
@@ -716,7 +953,7 @@ int writeIPDR(
    errorHandler(pIPDRCommonParameters, pErrorCode, "writeIPDRXMLRecordHelper"); 
   }
   else if (errorSeverity == IPDR_ERROR) {
-   pIPDRCommonParameters->DocState_ = NONWRITABLE; 
+   abandonRecords(pIPDRCommonParameters, &recordStart, descriptorCount);
    exceptionHandler(pIPDRCommonParameters, pErrorCode, "writeIPDRXMLRecordHelper"); 
    return (IPDR_ERROR);
   }
@@ -728,8 +965,317 @@ int writeIPDR(
  
  pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_++;
  
- free(tempString);
- freeIPDRStreamElement (pIPDRStreamElement);
+ return (IPDR_OK);
+}
+ 
+/*!
+ *  NAME:
+ *      writeIPDRFlat() - writes a flat record to the document.
+ *
+ *  DESCRIPTION:
+ *      - Writes the same bytes as writeIPDR() for an FNFData holding
+ *        the values of the record; every value has to be set
+ *      - The descriptor found or created for the record is kept in it,
+ *        so records of the same layout written to the same document
+ *        are not looked up again
+ *      - The values are encoded from the record through the codec
+ *        plan of the descriptor
+ *      - XML documents, and records validated against a schema, are
+ *        copied into an FNFData and written by writeIPDR()
+ *
+ *  ARGUMENTS:
+ *      - IPDRCommonParameters {IN/OUT}
+ *      - pRecord {IN/OUT}
+ *      - pErrorCode {IN/OUT} 
+ *
+ *  RETURNS  
+ *       Returns Zero or appropriate error code
+*/
+ 
+int writeIPDRFlat(
+     IPDRCommonParameters* pIPDRCommonParameters, 
+     IPDRFlatRecord* pRecord, 
+     int* pErrorCode
+    )
+{
+ int errorSeverity = 0;
+ int errorCode = 0;
+ int descriptorID = 0;
+ int descriptorCount = 0;
+ FNFData* pFNFData = NULL;
+ const XDRCodecPlan* pCodecPlan = NULL;
+ XDROutputMark recordStart;
+ 
+ if(pRecord == NULL || 
+  pIPDRCommonParameters == NULL
+     ) {
+     *pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+     return (IPDR_ERROR);
+ }
+ 
+ if ((int)pIPDRCommonParameters->DocState_ != WRITABLE) {
+  *pErrorCode = IPDR_INVALID_DOCSTATE_MAKE_WRITABLE;
+  return(IPDR_ERROR);
+ }
+
+ if (pRecord->typeName_ == NULL) {
+  *pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+  return (IPDR_ERROR);
+ }
+ 
+ /* Records validated against a schema are written as FNFData */
+ if (pIPDRCommonParameters->DocType_ != XDR ||
+  ((pIPDRCommonParameters->pSchema_ != NULL) && 
+   (pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL))) {
+  pFNFData = newFNFData();
+  if(pFNFData == NULL) {
+   *pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+   return(IPDR_ERROR);
+  }
+  errorCode = copyFlatRecordToFNFData(pFNFData, pRecord);
+  if (errorCode != IPDR_OK) {
+   freeFNFData(pFNFData);
+   *pErrorCode = errorCode;
+   return (IPDR_ERROR);
+  }
+  errorSeverity = writeIPDR(pIPDRCommonParameters, pFNFData, pErrorCode);
+  freeFNFData(pFNFData);
+  return (errorSeverity);
+ }
+ 
+ markXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, &recordStart);
+ descriptorCount = pIPDRCommonParameters->descriptorCount_;
+ 
+ /* The descriptor of the last write is taken if the layout is unchanged */
+ descriptorID = 0;
+ if (pRecord->pWriteDocument_ == pIPDRCommonParameters &&
+  lookupDescriptor(pIPDRCommonParameters, pRecord->writeDescriptorID_) != NULL &&
+  pIPDRCommonParameters->pDescriptorFingerprints_[pRecord->writeDescriptorID_] == pRecord->fingerprint_)
+  descriptorID = pRecord->writeDescriptorID_;
+ if (descriptorID == 0)
+  descriptorID = findDescriptor(pIPDRCommonParameters, pRecord->typeName_, 
+                                pRecord->pListAttributeDescriptor_);
+ if (descriptorID == 0) {
+  pFNFData = newFNFData();
+  if(pFNFData == NULL) {
+   *pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+   return(IPDR_ERROR);
+  }
+ 
+  /* The lists are only borrowed, createDescriptor copies them */
+  strcpy(pFNFData->typeName_, pRecord->typeName_);
+  pFNFData->pListAttributeDescriptor_ = pRecord->pListAttributeDescriptor_;
+  pFNFData->pListServiceAttributeDescriptor_ = pRecord->pListServiceAttributeDescriptor_;
+ 
+  errorSeverity = createDescriptor(pIPDRCommonParameters, pFNFData->pListAttributeDescriptor_, pFNFData, pErrorCode); 
+ 
+  pFNFData->pListAttributeDescriptor_ = NULL;
+  pFNFData->pListServiceAttributeDescriptor_ = NULL;
+  freeFNFData(pFNFData);
+ 
+  if (errorSeverity == IPDR_WARNING) {
+   errorHandler(pIPDRCommonParameters, pErrorCode, "createDescriptor"); 
+  }
+  else if (errorSeverity == IPDR_ERROR) {
+   abandonRecords(pIPDRCommonParameters, &recordStart, descriptorCount);
+   exceptionHandler(pIPDRCommonParameters, pErrorCode, "createDescriptor"); 
+   return (IPDR_ERROR);
+  }
+ 
+  descriptorID = pIPDRCommonParameters->descriptorCount_ - 1;
+ }
+
+ pRecord->pWriteDocument_ = pIPDRCommonParameters;
+ pRecord->writeDescriptorID_ = descriptorID;
+
+ pCodecPlan = getXDRCodecPlan(pIPDRCommonParameters, descriptorID);
+ if (pCodecPlan == NULL || pCodecPlan->hasStructures_ == IPDR_TRUE) {
+  *pErrorCode = (pCodecPlan == NULL) ? IPDR_NO_SUCH_DESCRIPTOR : IPDR_NON_PRIMITIVE_DATA_TYPE;
+  abandonRecords(pIPDRCommonParameters, &recordStart, descriptorCount);
+  exceptionHandler(pIPDRCommonParameters, pErrorCode, "getXDRCodecPlan"); 
+  return (IPDR_ERROR);
+ }
+
+ write_long(STREAM_IPDR_RECORD, pIPDRCommonParameters->pOutputBuffer_);
+ write_long(descriptorID, pIPDRCommonParameters->pOutputBuffer_);
+ write_long(IPDR_INDEFINITE_LENGTH_INDICATOR, pIPDRCommonParameters->pOutputBuffer_); 
+
+ errorSeverity = writeXDRCodecPlanFlat(pIPDRCommonParameters, pCodecPlan, pRecord, pErrorCode);
+ if (errorSeverity == IPDR_ERROR) {
+  abandonRecords(pIPDRCommonParameters, &recordStart, descriptorCount);
+  exceptionHandler(pIPDRCommonParameters, pErrorCode, "writeXDRCodecPlanFlat"); 
+  return (IPDR_ERROR);
+ }
+
+ /* Record boundary, the output buffer is drained once it is full */
+ errorSeverity = commitXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, pErrorCode);
+ if (errorSeverity == IPDR_ERROR) {
+  pIPDRCommonParameters->DocState_ = NONWRITABLE; 
+  exceptionHandler(pIPDRCommonParameters, pErrorCode, "commitXDROutputBuffer"); 
+  return (IPDR_ERROR);
+ }
+ 
+ pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_++;
+ 
+ return (IPDR_OK);
+}
+ 
+/*!
+ *  NAME:
+ *      writeIPDRBatch() - writes an array of records to the document.
+ *
+ *  DESCRIPTION:
+ *      - Writes the same bytes as calling writeIPDR() for every record
+ *        in turn; the records are written in the order given
+ *      - Consecutive records of the same descriptor form a group: the
+ *        descriptor and its codec plan are looked up once per group,
+ *        and the schema validation of the first record of the group
+ *        is replayed for the others
+ *      - Records without structures are encoded from the FNFData
+ *        through the codec plan, without the copy writeIPDR() makes
+ *      - The output buffer is committed once, after the last record,
+ *        so that a batch is written to the stream at most once
+ *      - XML documents are written record by record; a record that
+ *        fails stops the batch and the records before it stay written
+ *      - In an XDR document a record that fails drops the whole batch:
+ *        the bytes and descriptors buffered for it are discarded, the
+ *        records before the batch are written to the stream, the
+ *        record count is set back to the start of the batch and the
+ *        document is made NONWRITABLE
+ *
+ *  ARGUMENTS:
+ *      - IPDRCommonParameters {IN/OUT}
+ *      - ppFNFData {IN}
+ *      - noOfRecords {IN}
+ *      - pErrorCode {IN/OUT} 
+ *
+ *  RETURNS  
+ *       Returns Zero or appropriate error code
+*/
+ 
+int writeIPDRBatch(
+     IPDRCommonParameters* pIPDRCommonParameters, 
+     FNFData** ppFNFData, 
+     int noOfRecords, 
+     int* pErrorCode
+    )
+{
+ int errorSeverity = 0;
+ int count = 0;
+ int descriptorID = 0;
+ int groupDescriptorID = 0;
+ int validationID = 0;
+ int batchStartCount = 0;
+ int descriptorCount = 0;
+ FNFData* pFNFData = NULL;
+ const XDRCodecPlan* pCodecPlan = NULL;
+ XDROutputMark batchStart;
+ 
+ if(ppFNFData == NULL || 
+  pIPDRCommonParameters == NULL ||
+  noOfRecords < 0
+     ) {
+     *pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+     return (IPDR_ERROR);
+ }
+ 
+ for (count = 0; count < noOfRecords; count++) {
+  if (ppFNFData[count] == NULL) {
+   *pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+   return (IPDR_ERROR);
+  }
+ }
+ 
+ if ((int)pIPDRCommonParameters->DocState_ != WRITABLE) {
+  *pErrorCode = IPDR_INVALID_DOCSTATE_MAKE_WRITABLE;
+  return(IPDR_ERROR);
+ }
+ 
+ if (pIPDRCommonParameters->DocType_ != XDR) {
+  for (count = 0; count < noOfRecords; count++) {
+   errorSeverity = writeIPDR(pIPDRCommonParameters, ppFNFData[count], pErrorCode);
+   if (errorSeverity == IPDR_ERROR)
+    return (IPDR_ERROR);
+  }
+  return (IPDR_OK);
+ }
+ 
+ /* The records are counted as they are written, so that warnings name them */
+ batchStartCount = pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_;
+ descriptorCount = pIPDRCommonParameters->descriptorCount_;
+ markXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, &batchStart);
+ 
+ for (count = 0; count < noOfRecords; count++) {
+  pFNFData = ppFNFData[count];
+ 
+  /* 
+     The validation outcome is kept per descriptor ID; a record without
+     one is validated under the descriptor of the previous record, and
+     the outcome is replayed if it has the same attributes
+  */
+  if ((pIPDRCommonParameters->pSchema_ != NULL) && 
+   (pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL)) {
+   validationID = pFNFData->descriptorID_ != 0 ? pFNFData->descriptorID_ : groupDescriptorID;
+   errorSeverity = validateRecordAgainstSchema(pIPDRCommonParameters, pFNFData, 
+                                               validationID != 0 ? 
+                                               validationID : SCHEMA_NO_DESCRIPTOR_ID, 
+                                               pFNFData->descriptorID_ != 0, 
+                                               pErrorCode);
+   if (errorSeverity == IPDR_WARNING) {
+    errorHandler(pIPDRCommonParameters, pErrorCode, "validateAgainstSchema"); 
+   }
+   else if (errorSeverity == IPDR_ERROR) {
+    pIPDRCommonParameters->DocState_ = NONWRITABLE; 
+    exceptionHandler(pIPDRCommonParameters, pErrorCode, "validateAgainstSchema"); 
+    break;
+   }
+  }
+ 
+  errorSeverity = resolveRecordDescriptor(pIPDRCommonParameters, pFNFData, &descriptorID, pErrorCode);
+  if (errorSeverity == IPDR_ERROR)
+   break;
+ 
+  if (descriptorID != groupDescriptorID || pCodecPlan == NULL) {
+   groupDescriptorID = descriptorID;
+   pCodecPlan = getXDRCodecPlan(pIPDRCommonParameters, descriptorID);
+  }
+ 
+  if (pCodecPlan != NULL && pCodecPlan->hasStructures_ != IPDR_TRUE) {
+   write_long(STREAM_IPDR_RECORD, pIPDRCommonParameters->pOutputBuffer_);
+   write_long(descriptorID, pIPDRCommonParameters->pOutputBuffer_);
+   write_long(IPDR_INDEFINITE_LENGTH_INDICATOR, pIPDRCommonParameters->pOutputBuffer_); 
+ 
+   errorSeverity = writeXDRCodecPlan(pIPDRCommonParameters, pCodecPlan, pFNFData, pErrorCode);
+   if (errorSeverity == IPDR_ERROR) {
+    pIPDRCommonParameters->DocState_ = NONWRITABLE; 
+    exceptionHandler(pIPDRCommonParameters, pErrorCode, "writeXDRCodecPlan"); 
+    break;
+   }
+  }
+  else {
+   errorSeverity = writeXDRRecordCopy(pIPDRCommonParameters, pFNFData, descriptorID, pErrorCode);
+   if (errorSeverity == IPDR_ERROR)
+    break;
+  }
+ 
+  pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_++;
+ }
+ 
+ /* Nothing of a failed batch is written, so none of it is counted */
+ if (errorSeverity == IPDR_ERROR) {
+  abandonRecords(pIPDRCommonParameters, &batchStart, descriptorCount);
+  pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_ = batchStartCount;
+  return (IPDR_ERROR);
+ }
+ 
+ /* Batch boundary, the records are drained together */
+ errorSeverity = commitXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, pErrorCode);
+ if (errorSeverity == IPDR_ERROR) {
+  pIPDRCommonParameters->DocState_ = NONWRITABLE; 
+  pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_ = batchStartCount;
+  exceptionHandler(pIPDRCommonParameters, pErrorCode, "commitXDROutputBuffer"); 
+  return (IPDR_ERROR);
+ }
  
  return (IPDR_OK);
 }
@@ -819,8 +1365,29 @@ int writeDocEnd(
     return (IPDR_ERROR);
   }
  freeIPDRStreamElement(pIPDRStreamElement);
+
+  /* Document boundary, everything buffered goes to the stream */
+  errorSeverity = flushXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, pErrorCode);
+  if (errorSeverity == IPDR_ERROR) {
+   pIPDRCommonParameters->DocState_ = NONWRITABLE; 
+   exceptionHandler(pIPDRCommonParameters, pErrorCode, "flushXDROutputBuffer"); 
+   freeDocEnd(pDocEnd);
+   free (endTime);
+   return (IPDR_ERROR);
+  }
  }
  else if(pIPDRCommonParameters->DocType_ == XML) {
+  /* Records written from templates precede the document end */
+  if (pIPDRCommonParameters->pOutputBuffer_ != NULL) {
+   errorSeverity = flushXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, pErrorCode);
+   if (errorSeverity == IPDR_ERROR) {
+    pIPDRCommonParameters->DocState_ = NONWRITABLE; 
+    exceptionHandler(pIPDRCommonParameters, pErrorCode, "flushXDROutputBuffer"); 
+    freeDocEnd(pDocEnd);
+    free (endTime);
+    return (IPDR_ERROR);
+   }
+  }
   errorSeverity = writeIPDRXMLDocEndHelper(pIPDRCommonParameters, pDocEnd, pErrorCode); 
   if (errorSeverity == IPDR_WARNING) {
    errorHandler(pIPDRCommonParameters, pErrorCode, "writeIPDRXMLDocEndHelper"); 
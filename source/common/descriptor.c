@@ -32,8 +32,43 @@
 #include "common/getFile.h"
  
 #include "common/IPDRDocWriter.h"
+#include "common/schemaCache.h"
+#include "utils/IPDRThread.h"
 
-static char gVersion[10];
+IPDRMutex gSchemaParserMutex = IPDR_MUTEX_INITIALIZER;
+
+/*!
+ *  NAME:
+ *      readSchemaVersion() - Applies a version attribute of a schema
+ *
+ *  DESCRIPTION:
+ *      The first version attribute of the schemas parsed for a
+ *      descriptor selects the version the descriptor is generated
+ *      for. Attributes are applied as they are parsed, or replayed
+ *      from the schema cache.
+ *
+ *  ARGUMENTS:
+ *       - DescriptorCommon {IN/OUT}
+ *       - version {IN}
+ *
+ *  RETURNS
+ *      Returns void
+ */
+
+static void readSchemaVersion(DescriptorCommon* pDescriptorCommon, char* version)
+{
+	#ifdef DEBUG_IPDR	
+     printf("the version read from schema is: %s\n", version);
+	#endif
+     if (pDescriptorCommon->version_[0] == '\0') {
+        if(strstr(version,IPDR_VERSION_3_5) != NULL){
+           strcpy(pDescriptorCommon->version_, IPDR_VERSION_3_5);
+        }
+        else if((strstr(version,IPDR_VERSION_3_0) != NULL) || (strstr(version,IPDR_VERSION_3_1) != NULL)){
+           strcpy(pDescriptorCommon->version_, IPDR_VERSION_3_1);
+        }
+     }
+}
 
 /*!
  *  NAME:
@@ -65,7 +100,6 @@ static void start(void* data,
  int nextCount = 0;
  int nodeCount = 0;
  int tempLen = 0;
- static int cnt = 0;
  unsigned int lenExtensionBase = 0;
  unsigned int lenNameSpaceId = 0;
  char* attributeName = NULL;
@@ -158,18 +192,8 @@ static void start(void* data,
    /* Adding code to read the schema version */
    if ( strcmp(atts[count], "version") == 0) {
      count++;
-	#ifdef DEBUG_IPDR	
-     printf("the version read from schema is: %s\n", atts[count]);
-	#endif
-     cnt = cnt + 1;
-     if (cnt == 1) {
-        if(strstr(atts[count],IPDR_VERSION_3_5) != NULL){
-           strcpy(gVersion, IPDR_VERSION_3_5);
-        }
-        else if((strstr(atts[count],IPDR_VERSION_3_0) != NULL) || (strstr(atts[count],IPDR_VERSION_3_1) != NULL)){
-           strcpy(gVersion, IPDR_VERSION_3_1);
-        }
-     }
+     appendNode(&(pDescriptorCommon->lstVersion_), (char *) atts[count]);
+     readSchemaVersion(pDescriptorCommon, (char *) atts[count]);
    }
    count++;            
   }
@@ -294,7 +318,7 @@ static void start(void* data,
 		} 
     } 
 
-if((strcmp(gVersion,IPDR_VERSION_3_5)) == 0){
+if((strcmp(pDescriptorCommon->version_,IPDR_VERSION_3_5)) == 0){
 	if (strcmp(atts[count], IPDR_MAXOCCURS) == 0) {
         count++;
       if(pDescriptorCommon->complexTypeFlag_ == 1) {
@@ -342,7 +366,7 @@ if((strcmp(gVersion,IPDR_VERSION_3_5)) == 0){
 }
 
 /* IPDR v3.5,  Enum requirement. Check for version */
- if((strcmp(gVersion,IPDR_VERSION_3_5)) == 0)
+ if((strcmp(pDescriptorCommon->version_,IPDR_VERSION_3_5)) == 0)
  {
 	if (strcmp(name, IPDR_RESTRICTION) == 0) {
 		while (atts[count] != NULL) {
@@ -549,8 +573,10 @@ static void end(void *data, const char *name)
 		while(pDescriptorCommon->pFNFType_->pListAttributeDescriptor_ != NULL) {
 			getIPDRSubstring(pDescriptorCommon->pFNFType_->pListAttributeDescriptor_->pAttributeDescriptor_->attributeName_, tempNewAttrType, ':');
 			if(strcmp(pDescriptorCommon->pAttrClassNameList_->node, tempNewAttrType) == 0) {
-				strcpy(pDescriptorCommon->pFNFType_->pListAttributeDescriptor_->pAttributeDescriptor_->description_,
-				pDescriptorCommon->pAttrClassList_->node);
+				if (setAttributeDescriptorString(NULL,
+						&(pDescriptorCommon->pFNFType_->pListAttributeDescriptor_->pAttributeDescriptor_->description_),
+						pDescriptorCommon->pAttrClassList_->node) != IPDR_OK)
+					*(pDescriptorCommon->pErrorCode_) = IPDR_MEMORY_ALLOCATION_FAILED;
 				pDescriptorCommon->pFNFType_->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = atoi(pDescriptorCommon->pAttrMaxOccursList_->node);
 			}
 			pDescriptorCommon->pFNFType_->pListAttributeDescriptor_ = pDescriptorCommon->pFNFType_->pListAttributeDescriptor_->pNext_;
@@ -812,6 +838,7 @@ int freeDescriptorCommon(DescriptorCommon* pDescriptorCommon)
  freeList(&(pDescriptorCommon->pTempListAttrNameList_));
  freeList(&(pDescriptorCommon->pTempListAttrClassList_));
  freeList(&(pDescriptorCommon->pTempListAttrMaxOccursList_));
+ freeList(&(pDescriptorCommon->lstVersion_));
  
  free(pDescriptorCommon);
 
@@ -853,6 +880,8 @@ int initDescriptorCommon(DescriptorCommon* pDescriptorCommon,
  pDescriptorCommon->pTempListAttrClassList_ = NULL;
  pDescriptorCommon->pTempListAttrMaxOccursList_ = NULL;
  pDescriptorCommon->pListNameSpaceInfo_ = NULL;
+ freeList(&(pDescriptorCommon->lstVersion_));
+ pDescriptorCommon->lstVersion_ = NULL;
  pDescriptorCommon->nameTypeFlag_ = 0;
  pDescriptorCommon->nameSpaceId_ = NULL;
  pDescriptorCommon->recordFlag_ = 0;
@@ -940,6 +969,9 @@ int parseSchema(char* SchemaURI,
 	char *Buff = NULL;
 	char* configParams = NULL;
 	char* SchemaFile = NULL;
+	char* pExtensionBase = NULL;
+	int cacheFound = IPDR_FALSE;
+	List* pVersion = NULL;
 	XML_Parser xmlParser;
 
 
@@ -984,6 +1016,22 @@ int parseSchema(char* SchemaURI,
 		return (IPDR_WARNING);
 	}
 
+	initDescriptorCommon(pDescriptorCommon, pErrorCode);
+
+	/* An unchanged schema is read from its compiled image */
+	pExtensionBase = pDescriptorCommon->extensionBase_;
+	loadDescriptorCommonCache(SchemaURI, SchemaFile, pDescriptorCommon,
+							  &cacheFound);
+	if (cacheFound == IPDR_TRUE) {
+		for (pVersion = pDescriptorCommon->lstVersion_; pVersion != NULL;
+			 pVersion = pVersion->pNext)
+			readSchemaVersion(pDescriptorCommon, pVersion->node);
+
+		free(configParams);
+		free(SchemaFile);
+		return (IPDR_OK);
+	}
+
 	
 	lengthSchemaFile = getFileLength(SchemaFile) + 1;
 	Buff = (char *) calloc (lengthSchemaFile, sizeof(char));
@@ -1017,7 +1065,6 @@ int parseSchema(char* SchemaURI,
 		return (IPDR_ERROR);
 	} 
 
-	initDescriptorCommon(pDescriptorCommon, pErrorCode);
 	userData = (DescriptorCommon *) pDescriptorCommon;
 	XML_SetUserData(xmlParser, userData);
 
@@ -1053,6 +1100,10 @@ int parseSchema(char* SchemaURI,
 			break;
 	}
 
+	storeDescriptorCommonCache(SchemaURI, SchemaFile, pDescriptorCommon,
+							   pDescriptorCommon->extensionBase_ != pExtensionBase ?
+							   IPDR_TRUE : IPDR_FALSE);
+
 	/* Returning back the FNFType structure to calling function */
 	userData = (DescriptorCommon *) XML_GetUserData(xmlParser);
 	pDescriptorCommon = (DescriptorCommon *) userData;
@@ -1326,7 +1377,7 @@ int	appendListListAttributeDescriptor(
 	return (IPDR_OK);
 }
 
-int generateSchemaDescriptor(char* SchemaURI, 
+static int parseSchemaDescriptor(char* SchemaURI, 
 							 FNFType* pNewFNFType,
 							 ListNameSpaceInfo** pListNameSpaceInfo,
 							 int *pErrorCode)
@@ -1427,7 +1478,7 @@ int generateSchemaDescriptor(char* SchemaURI,
 			free(tempAttributeName);
 		}
 
-if(strcmp(gVersion, IPDR_VERSION_3_1) == 0) {
+if(strcmp(pDescriptorCommon->version_, IPDR_VERSION_3_1) == 0) {
 
 		if (pNewFNFType->pListAttributeDescriptor_== NULL) {
 			pNewFNFType->pListAttributeDescriptor_ = pListAttributeDescriptor;
@@ -1436,7 +1487,7 @@ if(strcmp(gVersion, IPDR_VERSION_3_1) == 0) {
 				&pNewFNFType->pListAttributeDescriptor_,
 				&pListAttributeDescriptor);
 		}
-} else if(strcmp(gVersion, IPDR_VERSION_3_5) == 0) {
+} else if(strcmp(pDescriptorCommon->version_, IPDR_VERSION_3_5) == 0) {
 
 		if (pTempFNFType->pListAttributeDescriptor_== NULL) {
 			pTempFNFType->pListAttributeDescriptor_ = pListAttributeDescriptor;
@@ -1460,7 +1511,7 @@ if(strcmp(gVersion, IPDR_VERSION_3_1) == 0) {
 
 	pDescriptorCommon->pFNFType_->pListAttributeDescriptor_ = 	pCurrentListAttributeDescriptor;
 
-if(strcmp(gVersion, IPDR_VERSION_3_5) == 0) {
+if(strcmp(pDescriptorCommon->version_, IPDR_VERSION_3_5) == 0) {
 	errorSeverity = getSchemaDescriptorForVersion(OptionalAttributes, pTempFNFType->pListAttributeDescriptor_, pNewFNFType);
 	if (errorSeverity == IPDR_ERROR) {
 		free(tempSchemaURI);
@@ -1477,6 +1528,41 @@ if(strcmp(gVersion, IPDR_VERSION_3_5) == 0) {
 	return (IPDR_OK);
  
 }
+
+
+/*!
+ *  NAME:
+ *      generateSchemaDescriptor() - descriptor of a service definition
+ *
+ *  DESCRIPTION:
+ *      Parses the schema with parseSchemaDescriptor(). The schema
+ *      parsers keep file level state, so one schema is parsed at a
+ *      time in the process.
+ *
+ *  ARGUMENTS:
+ *       - SchemaURI {IN}
+ *       - pNewFNFType {IN/OUT}
+ *       - pListNameSpaceInfo {IN/OUT}
+ *       - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *      Returns IPDR_OK or IPDR_ERROR
+ */
+
+int generateSchemaDescriptor(char* SchemaURI, 
+							 FNFType* pNewFNFType,
+							 ListNameSpaceInfo** pListNameSpaceInfo,
+							 int *pErrorCode)
+{
+	int errorSeverity = 0;
+
+	lockIPDRMutex(&gSchemaParserMutex);
+	errorSeverity = parseSchemaDescriptor(SchemaURI, pNewFNFType,
+										  pListNameSpaceInfo, pErrorCode);
+	unlockIPDRMutex(&gSchemaParserMutex);
+
+	return (errorSeverity);
+}
  
 
 int getFileName(char* URI, char* name)
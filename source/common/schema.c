@@ -23,14 +23,11 @@
 
 #include "common/schema.h"
 #include "common/IPDRDocWriter.h"
-
-char gSchemaVersion[10];
-
-static char serviceType[50];
+#include "common/schemaCache.h"
 
 /*
 *NAME:
-*     setSchemaData() 
+*     loadSchemaData() 
 *
 *DESCRIPTION:
 *   This method will help in populating SchemaLookupHashTable in the Schema 
@@ -54,7 +51,7 @@ static char serviceType[50];
 *     Returns Zero or appropriate error code
 */
 
-int setSchemaData( 
+static int loadSchemaData( 
 				   IPDRCommonParameters *pIPDRCommonParameters,
 				   ListNameSpaceInfo* pListNameSpaceInfo,
 				   ListServiceDefinitionURI* pListServiceDefinitionURI,
@@ -81,6 +78,12 @@ int setSchemaData(
 		return(IPDR_ERROR);
 	}
 
+	/* Schemas taken from the schema registry are read only */
+	if (pIPDRCommonParameters->pSchema_->shared_ == IPDR_TRUE) {
+		*pErrorCode = IPDR_SCHEMA_READ_ONLY;
+		return(IPDR_ERROR);
+	}
+
 	/* Setting Schema flag to TRUE */
 	pIPDRCommonParameters->pSchema_->SchemaValidationFlag_= IPDR_FALSE;
 
@@ -190,6 +193,11 @@ int setSchemaData(
 		
 		appendListSchemaLookup(&pIPDRCommonParameters->pSchema_->pListSchemaLookup_,
 								pSchemaLookup);
+		freeSchemaIndex(pIPDRCommonParameters->pSchema_);
+		freeIPDRIntMap(pIPDRCommonParameters->pValidatorMap_);
+		pIPDRCommonParameters->pValidatorMap_ = NULL;
+		freeIPDRIntMap(pIPDRCommonParameters->pValidationMemo_);
+		pIPDRCommonParameters->pValidationMemo_ = NULL;
 
 		freeSchemaLookup(pSchemaLookup);
 		
@@ -208,6 +216,46 @@ int setSchemaData(
 }
 
 
+/*!
+ *  NAME:
+ *      setSchemaData() - parses the service definitions into the
+ *      schema of a document
+ *
+ *  DESCRIPTION:
+ *      Calls loadSchemaData() holding gSchemaParserMutex, as the schema
+ *      parsers keep file level state.
+ *
+ *  ARGUMENTS:
+ *       - pIPDRCommonParameters {IN/OUT}
+ *       - pListNameSpaceInfo {IN}
+ *       - pListServiceDefinitionURI {IN}
+ *       - defaultNameSpace {IN}
+ *       - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *      Returns IPDR_OK, IPDR_WARNING or IPDR_ERROR
+ */
+
+int setSchemaData( 
+				   IPDRCommonParameters *pIPDRCommonParameters,
+				   ListNameSpaceInfo* pListNameSpaceInfo,
+				   ListServiceDefinitionURI* pListServiceDefinitionURI,
+				   char* defaultNameSpace,
+				   int* pErrorCode
+				  )
+{
+	int errorSeverity = 0;
+
+	lockIPDRMutex(&gSchemaParserMutex);
+	errorSeverity = loadSchemaData(pIPDRCommonParameters, pListNameSpaceInfo,
+								   pListServiceDefinitionURI, defaultNameSpace,
+								   pErrorCode);
+	unlockIPDRMutex(&gSchemaParserMutex);
+
+	return (errorSeverity);
+}
+
+
 SchemaCommon* newSchemaCommon(void)
 {
 	SchemaCommon* pSchemaCommon = NULL;
@@ -254,6 +302,7 @@ int freeSchemaCommon(SchemaCommon* pSchemaCommon)
 	freeList(&(pSchemaCommon->lstSchemaElementMinOccurs_));
 	freeList(&(pSchemaCommon->lstSchemaElementMaxOccurs_));
 	freeList(&(pSchemaCommon->lstSchemaElementReference_));
+	freeList(&(pSchemaCommon->lstVersion_));
 	free(pSchemaCommon);
 	return (IPDR_OK);
 
@@ -275,6 +324,38 @@ int getStringNoTabs(char* dest, char* src)
 
 
 
+/*!
+ *  NAME:
+ *      readSchemaVersionSL() - Applies a version attribute of a schema
+ *
+ *  DESCRIPTION:
+ *      The first version attribute of a schema and of the schemas it
+ *      extends sets the version the schemas are read for. Attributes
+ *      are applied as they are parsed, or replayed from the schema
+ *      cache.
+ *
+ *  ARGUMENTS:
+ *       - SchemaCommon {IN/OUT}
+ *       - version {IN}
+ *
+ *  RETURNS
+ *	     Nothing
+ */
+
+static void readSchemaVersionSL(SchemaCommon* pSchemaCommon, char* version)
+{
+	printf("the version read from schema is: %s\n", version);
+	if (pSchemaCommon->version_[0] == '\0') {
+		if(strstr(version,IPDR_VERSION_3_5) != NULL){
+			strcpy(pSchemaCommon->version_, IPDR_VERSION_3_5);
+		}
+		else if((strstr(version,IPDR_VERSION_3_0) != NULL) || (strstr(version,IPDR_VERSION_3_1) != NULL)){
+			strcpy(pSchemaCommon->version_, IPDR_VERSION_3_1);
+		}
+	}
+}
+
+
 static void start(
 		void *data, 
 		const char *el, 
@@ -283,7 +364,6 @@ static void start(
 	int i = 0;
 	int tmpLen = 0;
 	char* tmp = NULL;
-   static int cnt = 0; 
 
 	SchemaCommon *pSchemaCommon = NULL;
 	pSchemaCommon = (SchemaCommon *) data;
@@ -312,16 +392,8 @@ static void start(
 			}
                         if ( strcmp(attr[i], "version") == 0) {
                              i++;
-                             printf("the version read from schema is: %s\n", attr[i]);
-                             cnt = cnt + 1;
-                             if (cnt == 1) {
-                                if(strstr(attr[i],IPDR_VERSION_3_5) != NULL){
-				    							setSchemaVersion(3.5);
-                                }
-                                else if((strstr(attr[i],IPDR_VERSION_3_0) != NULL) || (strstr(attr[i],IPDR_VERSION_3_1) != NULL)){
-				    							setSchemaVersion(3.1);
-                                }
-                             }
+                             appendNode(&(pSchemaCommon->lstVersion_), (char *) attr[i]);
+                             readSchemaVersionSL(pSchemaCommon, (char *) attr[i]);
 			}
 			i++;            
 		}
@@ -486,7 +558,7 @@ static void start(
 			}
 
 			/*IPDR v3.5, Arrays*/
-			if((strcmp(gSchemaVersion,IPDR_VERSION_3_5)) == 0) {
+			if((strcmp(pSchemaCommon->version_,IPDR_VERSION_3_5)) == 0) {
 			if (strcmp(attr[i], "maxOccurs") == 0) {
             if(pSchemaCommon->complexTypeFlag_ == 0) {
 				i++;
@@ -533,7 +605,7 @@ static void start(
 
 
 /* IPDR v3.5,  Enum requirement. Check for version */
- if((strcmp(gSchemaVersion,IPDR_VERSION_3_5)) == 0)
+ if((strcmp(pSchemaCommon->version_,IPDR_VERSION_3_5)) == 0)
  {
 	if (strcmp(el, "restriction") == 0) {
 		while (attr[i] != NULL) {
@@ -935,6 +1007,37 @@ attributeValueHandler(
 	}
 
 
+/*!
+ *  NAME:
+ *      setCommonSchemaVersionSL() - Sets the schema version of the
+ *                                   common parameters
+ *
+ *  DESCRIPTION:
+ *      The version a lookup schema was read for becomes the version
+ *      of the common parameters, unless they already have one.
+ *
+ *  ARGUMENTS:
+ *       - pIPDRCommonParameters {IN/OUT}
+ *       - SchemaCommon {IN}
+ *
+ *  RETURNS
+ *	     Nothing
+ */
+
+static void setCommonSchemaVersionSL(IPDRCommonParameters *pIPDRCommonParameters,
+									 SchemaCommon* pSchemaCommon)
+{
+	if (pIPDRCommonParameters->schemaVersion[0] != '\0')
+		return;
+
+	/*IPDR v3.5, version changes*/
+	if (strcmp(pSchemaCommon->version_, IPDR_VERSION_3_5) == 0)
+		strcpy(pIPDRCommonParameters->schemaVersion, IPDR_VERSION_3_5);
+	else if (strcmp(pSchemaCommon->version_, IPDR_VERSION_3_1) == 0)
+		strcpy(pIPDRCommonParameters->schemaVersion, IPDR_VERSION_3_1);
+}
+
+
 int parseSchemaLookup(char* SchemaURI, 
 				SchemaCommon* pSchemaCommon,
 				   IPDRCommonParameters *pIPDRCommonParameters,
@@ -950,7 +1053,8 @@ int parseSchemaLookup(char* SchemaURI,
 	char* configParams = NULL;
 	char* SchemaFile = NULL;
 	unsigned int lengthSchemaFile = 0;
-   static int cnt = 0;
+	int cacheFound = IPDR_FALSE;
+	List* pVersion = NULL;
 
 
 	configParams = (char *) calloc (MAX_IPDR_STRING, sizeof(char));
@@ -996,6 +1100,20 @@ int parseSchemaLookup(char* SchemaURI,
 		return (IPDR_WARNING);
 	}
 
+	/* An unchanged schema is read from its compiled image */
+	loadSchemaCommonCache(SchemaURI, SchemaFile, pSchemaCommon,
+						  &cacheFound);
+	if (cacheFound == IPDR_TRUE) {
+		for (pVersion = pSchemaCommon->lstVersion_; pVersion != NULL;
+			 pVersion = pVersion->pNext)
+			readSchemaVersionSL(pSchemaCommon, pVersion->node);
+
+		setCommonSchemaVersionSL(pIPDRCommonParameters, pSchemaCommon);
+
+		free(configParams);
+		free(SchemaFile);
+		return (IPDR_OK);
+	}
 	
 	lengthSchemaFile = getFileLength(SchemaFile) + 1;
 	Buff = (char *) calloc (lengthSchemaFile, sizeof(char));
@@ -1063,21 +1181,10 @@ int parseSchemaLookup(char* SchemaURI,
 		if (done)
 			break;
 	}
-		/*IPDR v3.5, version changes*/
-        if(cnt == 0) {
-            if(strcmp(gSchemaVersion,IPDR_VERSION_3_5) == 0){
-               if (pIPDRCommonParameters->schemaVersion[0] == '\0') {
-                  /* Set the structure member */
-                  strcpy(pIPDRCommonParameters->schemaVersion, IPDR_VERSION_3_5);
-               }
-            }
-            else if(strcmp(gSchemaVersion,IPDR_VERSION_3_1) == 0){
-               if (pIPDRCommonParameters->schemaVersion[0] == '\0') {
-                  strcpy(pIPDRCommonParameters->schemaVersion, IPDR_VERSION_3_1);
-               }
-            }
-            cnt = cnt + 1;
-        }
+
+	storeSchemaCommonCache(SchemaURI, SchemaFile, pSchemaCommon);
+
+	setCommonSchemaVersionSL(pIPDRCommonParameters, pSchemaCommon);
 
 
 	/* Returning back the FNFType structure to calling function */
@@ -1139,14 +1246,16 @@ int generateSchemaLookup(
 	char* tempAttribName = NULL;
 	char* tempSchemaURI = NULL;
 	char* tempFileName = NULL;
-   static int lFound = 0;
-   static int lFnd = 0;
+	char schemaVersion[10];
 	
 	tempSchemaURI = (char *) calloc (MAX_NAMESPACE_URI, sizeof(char));
 	strcpy(tempSchemaURI, SchemaURI);
+	schemaVersion[0] = '\0';
 
 	do {
+		/* An extended schema is read for the version of the schema extending it */
 		pSchemaCommon = newSchemaCommon();
+		strcpy(pSchemaCommon->version_, schemaVersion);
 
 		tempFileName = (char *) calloc (MAX_IPDR_STRING, sizeof(char));
 		getFileNameSL(tempSchemaURI, tempFileName);
@@ -1166,6 +1275,7 @@ int generateSchemaLookup(
 			free(tempSchemaURI);
 			return (IPDR_ERROR);
 		}
+		strcpy(schemaVersion, pSchemaCommon->version_);
 
 		appendListNameSpaceInfo(
 								pListNameSpaceInfo,
@@ -1286,7 +1396,6 @@ int generateSchemaLookup(
          	if((strcmp(pSchemaElement->attributeName_, tempAttribName) == 0)) {
            		appendListSchemaElement( &pListServiceElement, pSchemaElement);
 				}
-            lFound = 1;
 				pCurrRef = pCurrRef->pNext;
 				free(tempAttribName);
             tempAttribName = NULL;
@@ -1543,16 +1652,3 @@ int getXMLCharSL(char* tmpXMLChar)
 		return (0);	/* ASCII value of ' ' */
 	
 }
-
-/* IPDR v3.5, change for version */
-int setSchemaVersion(float ver)
-{
-
-   printf("The ver in setSchemaVersion ChangeVersion is:%f\n", ver);
-
-   sprintf(gSchemaVersion,"%1.1f",ver);
-
-   printf("The setSchemaVersion global version is:%s\n", gSchemaVersion);
-
-   return (IPDR_OK);
-}
@@ -0,0 +1,981 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/******************************************************
+ * File                 : schemaCache.c               *
+ * Description          : On-disk cache of parsed     *
+ *                        schema documents            *
+ * Author               : Infosys Tech Ltd            *
+ * Modification History :                             *
+ *--------------------------------------------------- *
+ * Date       Name        Change/Description          *
+ *--------------------------------------------------- *
+ *                                                    *
+ ******************************************************/
+
+#include "common/schemaCache.h"
+#include "utils/IPDRMap.h"
+#include "utils/IPDRMemory.h"
+#include "utils/errorCode.h"
+
+#ifndef WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <process.h>
+#endif
+
+/* Length stored for a NULL string */
+#define SCHEMA_CACHE_NULL_STRING	0xFFFFFFFFU
+
+/*
+ * The image is a sequence of 32 bit words in host byte order and of
+ * strings stored as their length followed by the characters and a
+ * terminating NUL. The magic word doubles as the byte order check.
+ */
+typedef struct SchemaCacheImage
+{
+	char* pData_;
+	unsigned int length_;
+	unsigned int offset_;
+	unsigned int capacity_;
+	int failed_;
+	int mapped_;
+} SchemaCacheImage;
+
+static char gSchemaCacheDirectory[MAX_IPDR_STRING];
+
+
+/*!
+ *  NAME:
+ *      setSchemaCacheDirectory() - Sets the schema cache directory
+ *
+ *  DESCRIPTION:
+ *      Compiled schema images are read from and written to the
+ *      directory. NULL or an empty name turns the cache off. This
+ *      is meant to be called once, before any schema is parsed.
+ *
+ *  ARGUMENTS:
+ *       - directory {IN}
+ *       - pErrorCode {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int setSchemaCacheDirectory(char* directory, int* pErrorCode)
+{
+	if (directory == NULL) {
+		gSchemaCacheDirectory[0] = '\0';
+		return (IPDR_OK);
+	}
+
+	if (strlen(directory) + 32 >= MAX_IPDR_STRING) {
+		*pErrorCode = IPDR_SCHEMA_CACHE_DIRECTORY_INVALID;
+		return (IPDR_ERROR);
+	}
+
+	strcpy(gSchemaCacheDirectory, directory);
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      getSchemaCacheDirectory() - Returns the schema cache directory
+ *
+ *  RETURNS
+ *	     The directory, or NULL if the cache is off.
+ */
+
+char* getSchemaCacheDirectory(void)
+{
+	if (gSchemaCacheDirectory[0] == '\0')
+		return (NULL);
+	return (gSchemaCacheDirectory);
+}
+
+
+/*!
+ *  NAME:
+ *      hashSchemaFile() - Length and hash of a schema file
+ *
+ *  DESCRIPTION:
+ *      32 bit FNV-1a hash of the file contents.
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK, or IPDR_WARNING if the file can not be read.
+ */
+
+static int hashSchemaFile(char* SchemaFile,
+						  unsigned int* pLength,
+						  unsigned int* pHash)
+{
+	FILE* fp = NULL;
+	unsigned char buffer[4096];
+	unsigned int hash = IPDR_FNV_OFFSET_BASIS;
+	unsigned int length = 0;
+	size_t count = 0;
+	size_t index = 0;
+
+	if ((fp = fopen(SchemaFile, "rb")) == NULL)
+		return (IPDR_WARNING);
+
+	while ((count = fread(buffer, 1, sizeof(buffer), fp)) > 0) {
+		for (index = 0; index < count; index++) {
+			hash ^= buffer[index];
+			hash *= IPDR_FNV_PRIME;
+		}
+		length += (unsigned int) count;
+	}
+
+	if (ferror(fp)) {
+		fclose(fp);
+		return (IPDR_WARNING);
+	}
+
+	fclose(fp);
+	*pLength = length;
+	*pHash = hash;
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      getSchemaCachePath() - File name of the image of a schema
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK, or IPDR_WARNING if the name does not fit in
+ *	     size characters.
+ */
+
+static int getSchemaCachePath(char* SchemaURI, int kind, char* path, size_t size)
+{
+	int length = 0;
+
+	length = snprintf(path, size, "%s/%08x.%s", gSchemaCacheDirectory,
+					  hashIPDRMapString(SchemaURI),
+					  kind == SCHEMA_CACHE_DESCRIPTOR ? "ipdrsd" : "ipdrsl");
+	if (length < 0 || (size_t) length >= size)
+		return (IPDR_WARNING);
+
+	return (IPDR_OK);
+}
+
+
+/*
+ * Image writer
+ */
+
+static void putSchemaCacheBytes(SchemaCacheImage* pImage,
+								const void* pBytes,
+								unsigned int length)
+{
+	char* pData = NULL;
+	unsigned int capacity = 0;
+
+	if (pImage->failed_ == IPDR_TRUE)
+		return;
+
+	if (pImage->length_ + length > pImage->capacity_) {
+		capacity = pImage->capacity_ == 0 ? 4096 : pImage->capacity_;
+		while (capacity < pImage->length_ + length)
+			capacity *= 2;
+		pData = (char *) realloc(pImage->pData_, capacity);
+		if (pData == NULL) {
+			pImage->failed_ = IPDR_TRUE;
+			return;
+		}
+		pImage->pData_ = pData;
+		pImage->capacity_ = capacity;
+	}
+
+	memcpy(pImage->pData_ + pImage->length_, pBytes, length);
+	pImage->length_ += length;
+}
+
+
+static void putSchemaCacheInt(SchemaCacheImage* pImage, unsigned int value)
+{
+	putSchemaCacheBytes(pImage, &value, sizeof(value));
+}
+
+
+static void putSchemaCacheString(SchemaCacheImage* pImage, const char* value)
+{
+	unsigned int length = 0;
+
+	if (value == NULL) {
+		putSchemaCacheInt(pImage, SCHEMA_CACHE_NULL_STRING);
+		return;
+	}
+
+	length = (unsigned int) strlen(value);
+	putSchemaCacheInt(pImage, length);
+	putSchemaCacheBytes(pImage, value, length + 1);
+}
+
+
+static void putSchemaCacheList(SchemaCacheImage* pImage, List* pList)
+{
+	List* pCurrent = NULL;
+	unsigned int count = 0;
+
+	for (pCurrent = pList; pCurrent != NULL; pCurrent = pCurrent->pNext)
+		count++;
+
+	putSchemaCacheInt(pImage, count);
+	for (pCurrent = pList; pCurrent != NULL; pCurrent = pCurrent->pNext)
+		putSchemaCacheString(pImage, pCurrent->node);
+}
+
+
+static void putSchemaCacheHeader(SchemaCacheImage* pImage,
+								 char* SchemaURI,
+								 int kind,
+								 unsigned int contentLength,
+								 unsigned int contentHash)
+{
+	putSchemaCacheInt(pImage, SCHEMA_CACHE_MAGIC);
+	putSchemaCacheInt(pImage, SCHEMA_CACHE_FORMAT);
+	putSchemaCacheInt(pImage, (unsigned int) kind);
+	putSchemaCacheInt(pImage, contentLength);
+	putSchemaCacheInt(pImage, contentHash);
+	putSchemaCacheString(pImage, SchemaURI);
+}
+
+
+/*!
+ *  NAME:
+ *      writeSchemaCacheImage() - Writes an image into the cache
+ *
+ *  DESCRIPTION:
+ *      The image is written to a temporary file unique to the
+ *      writer and renamed over the cached one.
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK, or IPDR_WARNING if the image was not written.
+ */
+
+static int writeSchemaCacheImage(char* path, SchemaCacheImage* pImage)
+{
+	FILE* fp = NULL;
+	char* tempPath = NULL;
+	unsigned long processID = 0;
+	int written = 0;
+
+	if (pImage->failed_ == IPDR_TRUE)
+		return (IPDR_WARNING);
+
+#ifndef WIN32
+	processID = (unsigned long) getpid();
+#else
+	processID = (unsigned long) _getpid();
+#endif
+
+	tempPath = (char *) calloc(strlen(path) + 48, sizeof(char));
+	if (tempPath == NULL)
+		return (IPDR_WARNING);
+	sprintf(tempPath, "%s.%lu.%lx.tmp", path, processID,
+			(unsigned long) pImage->pData_);
+
+	if ((fp = fopen(tempPath, "wb")) == NULL) {
+		free(tempPath);
+		return (IPDR_WARNING);
+	}
+
+	written = fwrite(pImage->pData_, 1, pImage->length_, fp) == pImage->length_;
+	if (fclose(fp) != 0)
+		written = 0;
+
+	if (!written || rename(tempPath, path) != 0) {
+		remove(tempPath);
+		free(tempPath);
+		return (IPDR_WARNING);
+	}
+
+	free(tempPath);
+	return (IPDR_OK);
+}
+
+
+/*
+ * Image reader
+ */
+
+static unsigned int getSchemaCacheInt(SchemaCacheImage* pImage)
+{
+	unsigned int value = 0;
+
+	if (pImage->failed_ == IPDR_TRUE ||
+		pImage->length_ - pImage->offset_ < sizeof(value)) {
+		pImage->failed_ = IPDR_TRUE;
+		return (0);
+	}
+
+	memcpy(&value, pImage->pData_ + pImage->offset_, sizeof(value));
+	pImage->offset_ += sizeof(value);
+	return (value);
+}
+
+
+/*!
+ *  NAME:
+ *      getSchemaCacheString() - Reads a string of the image
+ *
+ *  RETURNS
+ *	     The string within the image, valid while it is mapped, or
+ *	     NULL for a NULL string and on failure.
+ */
+
+static char* getSchemaCacheString(SchemaCacheImage* pImage)
+{
+	unsigned int length = 0;
+	char* value = NULL;
+
+	length = getSchemaCacheInt(pImage);
+	if (pImage->failed_ == IPDR_TRUE || length == SCHEMA_CACHE_NULL_STRING)
+		return (NULL);
+
+	if (pImage->length_ - pImage->offset_ <= length ||
+		pImage->pData_[pImage->offset_ + length] != '\0') {
+		pImage->failed_ = IPDR_TRUE;
+		return (NULL);
+	}
+
+	value = pImage->pData_ + pImage->offset_;
+	pImage->offset_ += length + 1;
+	return (value);
+}
+
+
+static List* getSchemaCacheList(SchemaCacheImage* pImage)
+{
+	List* pList = NULL;
+	char* value = NULL;
+	unsigned int count = 0;
+	unsigned int index = 0;
+
+	count = getSchemaCacheInt(pImage);
+	for (index = 0; index < count && pImage->failed_ == IPDR_FALSE; index++) {
+		value = getSchemaCacheString(pImage);
+		if (value == NULL) {
+			pImage->failed_ = IPDR_TRUE;
+			break;
+		}
+		appendNode(&pList, value);
+	}
+
+	if (pImage->failed_ == IPDR_TRUE) {
+		freeList(&pList);
+		pList = NULL;
+	}
+	return (pList);
+}
+
+
+/*!
+ *  NAME:
+ *      getSchemaCacheBounded() - Reads a string for a fixed buffer
+ *
+ *  DESCRIPTION:
+ *      Fails the image if the string is NULL or does not fit the
+ *      size of the buffer it is going to.
+ *
+ *  RETURNS
+ *	     Returns the string within the image.
+ */
+
+static char* getSchemaCacheBounded(SchemaCacheImage* pImage, unsigned int size)
+{
+	char* value = getSchemaCacheString(pImage);
+
+	if (value == NULL || strlen(value) >= size) {
+		pImage->failed_ = IPDR_TRUE;
+		return (NULL);
+	}
+	return (value);
+}
+
+
+static char* copySchemaCacheString(char* value)
+{
+	char* copy = NULL;
+
+	if (value == NULL)
+		return (NULL);
+
+	copy = (char *) calloc(strlen(value) + 1, sizeof(char));
+	if (copy != NULL)
+		strcpy(copy, value);
+	return (copy);
+}
+
+
+static void unmapSchemaCacheImage(SchemaCacheImage* pImage)
+{
+#ifndef WIN32
+	if (pImage->mapped_ == IPDR_TRUE) {
+		munmap((void *) pImage->pData_, pImage->length_);
+		pImage->pData_ = NULL;
+	}
+#endif
+	free(pImage->pData_);
+	pImage->pData_ = NULL;
+	pImage->length_ = 0;
+	pImage->mapped_ = IPDR_FALSE;
+}
+
+
+/*!
+ *  NAME:
+ *      mapSchemaCacheImage() - Maps a cached image
+ *
+ *  DESCRIPTION:
+ *      Maps the image read only. Where mapping is not available the
+ *      image is read into memory instead.
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK, or IPDR_WARNING if there is no image.
+ */
+
+static int mapSchemaCacheImage(char* path, SchemaCacheImage* pImage)
+{
+#ifndef WIN32
+	struct stat fileStatus;
+	void* pMapping = NULL;
+	int fd = -1;
+
+	if ((fd = open(path, O_RDONLY)) < 0)
+		return (IPDR_WARNING);
+
+	if (fstat(fd, &fileStatus) != 0 || !S_ISREG(fileStatus.st_mode) ||
+		fileStatus.st_size <= 0) {
+		close(fd);
+		return (IPDR_WARNING);
+	}
+
+	pMapping = mmap(NULL, (size_t) fileStatus.st_size, PROT_READ,
+					MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (pMapping == MAP_FAILED)
+		return (IPDR_WARNING);
+
+	pImage->pData_ = (char *) pMapping;
+	pImage->length_ = (unsigned int) fileStatus.st_size;
+	pImage->mapped_ = IPDR_TRUE;
+#else
+	FILE* fp = NULL;
+	long length = 0;
+
+	if ((fp = fopen(path, "rb")) == NULL)
+		return (IPDR_WARNING);
+
+	if (fseek(fp, 0, SEEK_END) != 0 || (length = ftell(fp)) <= 0 ||
+		fseek(fp, 0, SEEK_SET) != 0) {
+		fclose(fp);
+		return (IPDR_WARNING);
+	}
+
+	pImage->pData_ = (char *) malloc((size_t) length);
+	if (pImage->pData_ == NULL ||
+		fread(pImage->pData_, 1, (size_t) length, fp) != (size_t) length) {
+		fclose(fp);
+		free(pImage->pData_);
+		pImage->pData_ = NULL;
+		return (IPDR_WARNING);
+	}
+	fclose(fp);
+
+	pImage->length_ = (unsigned int) length;
+	pImage->mapped_ = IPDR_FALSE;
+#endif
+
+	pImage->offset_ = 0;
+	pImage->failed_ = IPDR_FALSE;
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      openSchemaCacheImage() - Opens the image of a schema
+ *
+ *  DESCRIPTION:
+ *      Maps the cached image of the schema and checks that it was
+ *      compiled by this format, for this parser and from the current
+ *      contents of the schema file. The image is left positioned at
+ *      its payload.
+ *
+ *  ARGUMENTS:
+ *       - SchemaURI {IN}
+ *       - SchemaFile {IN}, local copy of the schema
+ *       - kind {IN}
+ *       - pImage {OUT}
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK, or IPDR_WARNING if there is no usable image.
+ */
+
+static int openSchemaCacheImage(char* SchemaURI,
+								char* SchemaFile,
+								int kind,
+								SchemaCacheImage* pImage)
+{
+	char path[MAX_IPDR_STRING];
+	char* imageURI = NULL;
+	unsigned int contentLength = 0;
+	unsigned int contentHash = 0;
+
+	memset(pImage, 0, sizeof(SchemaCacheImage));
+
+	if (getSchemaCacheDirectory() == NULL)
+		return (IPDR_WARNING);
+
+	if (hashSchemaFile(SchemaFile, &contentLength, &contentHash) != IPDR_OK)
+		return (IPDR_WARNING);
+
+	if (getSchemaCachePath(SchemaURI, kind, path, sizeof(path)) != IPDR_OK ||
+		mapSchemaCacheImage(path, pImage) != IPDR_OK)
+		return (IPDR_WARNING);
+
+	if (getSchemaCacheInt(pImage) != SCHEMA_CACHE_MAGIC ||
+		getSchemaCacheInt(pImage) != SCHEMA_CACHE_FORMAT ||
+		getSchemaCacheInt(pImage) != (unsigned int) kind ||
+		getSchemaCacheInt(pImage) != contentLength ||
+		getSchemaCacheInt(pImage) != contentHash ||
+		(imageURI = getSchemaCacheString(pImage)) == NULL ||
+		strcmp(imageURI, SchemaURI) != 0) {
+		unmapSchemaCacheImage(pImage);
+		return (IPDR_WARNING);
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      createSchemaCacheImage() - Starts the image of a schema
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK, or IPDR_WARNING if the cache is off or the
+ *	     schema file can not be read.
+ */
+
+static int createSchemaCacheImage(char* SchemaURI,
+								  char* SchemaFile,
+								  int kind,
+								  SchemaCacheImage* pImage)
+{
+	unsigned int contentLength = 0;
+	unsigned int contentHash = 0;
+
+	memset(pImage, 0, sizeof(SchemaCacheImage));
+
+	if (getSchemaCacheDirectory() == NULL)
+		return (IPDR_WARNING);
+
+	if (hashSchemaFile(SchemaFile, &contentLength, &contentHash) != IPDR_OK)
+		return (IPDR_WARNING);
+
+	putSchemaCacheHeader(pImage, SchemaURI, kind, contentLength, contentHash);
+	return (IPDR_OK);
+}
+
+
+static int finishSchemaCacheImage(char* SchemaURI,
+								  int kind,
+								  SchemaCacheImage* pImage)
+{
+	char path[MAX_IPDR_STRING];
+	int errorSeverity = 0;
+
+	errorSeverity = getSchemaCachePath(SchemaURI, kind, path, sizeof(path));
+	if (errorSeverity == IPDR_OK)
+		errorSeverity = writeSchemaCacheImage(path, pImage);
+	free(pImage->pData_);
+	pImage->pData_ = NULL;
+	return (errorSeverity);
+}
+
+
+/*!
+ *  NAME:
+ *      storeDescriptorCommonCache() - Caches what parseSchema() read
+ *
+ *  DESCRIPTION:
+ *      Writes the members of DescriptorCommon used by the descriptor
+ *      generators once the schema is parsed. Failures only leave the
+ *      cache without the image.
+ *
+ *  ARGUMENTS:
+ *       - SchemaURI {IN}
+ *       - SchemaFile {IN}, local copy of the schema
+ *       - pDescriptorCommon {IN}
+ *       - extensionBaseParsed {IN}, IPDR_TRUE if the parse set the
+ *         extension base. It is kept from the previous schema otherwise.
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK, or IPDR_WARNING if nothing was cached.
+ */
+
+int storeDescriptorCommonCache(char* SchemaURI,
+							   char* SchemaFile,
+							   DescriptorCommon* pDescriptorCommon,
+							   int extensionBaseParsed)
+{
+	SchemaCacheImage image;
+	ListAttributeDescriptor* pCurrent = NULL;
+	AttributeDescriptor* pAttributeDescriptor = NULL;
+	unsigned int count = 0;
+
+	if (createSchemaCacheImage(SchemaURI, SchemaFile,
+							   SCHEMA_CACHE_DESCRIPTOR, &image) != IPDR_OK)
+		return (IPDR_WARNING);
+
+	putSchemaCacheString(&image, pDescriptorCommon->targetNameSpace_);
+	putSchemaCacheString(&image, pDescriptorCommon->nameSpaceId_);
+	putSchemaCacheString(&image, pDescriptorCommon->schemaLocation_);
+	putSchemaCacheString(&image, extensionBaseParsed == IPDR_TRUE ?
+						 pDescriptorCommon->extensionBase_ : NULL);
+	putSchemaCacheString(&image, pDescriptorCommon->pFNFType_->serviceType_);
+	putSchemaCacheList(&image, pDescriptorCommon->lstVersion_);
+
+	for (pCurrent = pDescriptorCommon->pFNFType_->pListAttributeDescriptor_;
+		 pCurrent != NULL; pCurrent = pCurrent->pNext_)
+		count++;
+
+	putSchemaCacheInt(&image, count);
+	for (pCurrent = pDescriptorCommon->pFNFType_->pListAttributeDescriptor_;
+		 pCurrent != NULL; pCurrent = pCurrent->pNext_) {
+		pAttributeDescriptor = pCurrent->pAttributeDescriptor_;
+		putSchemaCacheString(&image, pAttributeDescriptor->attributeName_);
+		putSchemaCacheString(&image, pAttributeDescriptor->attributeType_);
+		putSchemaCacheString(&image, pAttributeDescriptor->description_);
+		putSchemaCacheString(&image, pAttributeDescriptor->derivedType_);
+		putSchemaCacheString(&image, pAttributeDescriptor->complexType_);
+		putSchemaCacheInt(&image, (unsigned int) pAttributeDescriptor->noOfElements_);
+		putSchemaCacheList(&image, pAttributeDescriptor->pListAttrNameList_);
+		putSchemaCacheList(&image, pAttributeDescriptor->pListAttrClassList_);
+		putSchemaCacheList(&image, pAttributeDescriptor->pListAttrMaxOccursList_);
+	}
+
+	return (finishSchemaCacheImage(SchemaURI, SCHEMA_CACHE_DESCRIPTOR, &image));
+}
+
+
+/*!
+ *  NAME:
+ *      loadDescriptorCommonCache() - Reads parseSchema() results
+ *                                    from the cache
+ *
+ *  DESCRIPTION:
+ *      Fills an initialised DescriptorCommon as parseSchema() would
+ *      from the image of the schema, if there is a current one. The
+ *      version attributes are left in lstVersion_ for the caller to
+ *      apply. DescriptorCommon is only changed once the whole image
+ *      was read.
+ *
+ *  ARGUMENTS:
+ *       - SchemaURI {IN}
+ *       - SchemaFile {IN}, local copy of the schema
+ *       - pDescriptorCommon {IN/OUT}
+ *       - pFound {OUT}, IPDR_TRUE if the image was used
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int loadDescriptorCommonCache(char* SchemaURI,
+							  char* SchemaFile,
+							  DescriptorCommon* pDescriptorCommon,
+							  int* pFound)
+{
+	SchemaCacheImage image;
+	ListAttributeDescriptor* pListAttributeDescriptor = NULL;
+	ListAttributeDescriptor** ppTail = &pListAttributeDescriptor;
+	List* pListVersion = NULL;
+	List* pListAttrName = NULL;
+	List* pListAttrClass = NULL;
+	List* pListAttrMaxOccurs = NULL;
+	char* targetNameSpace = NULL;
+	char* nameSpaceId = NULL;
+	char* schemaLocation = NULL;
+	char* extensionBase = NULL;
+	char* serviceType = NULL;
+	char* attributeName = NULL;
+	char* attributeType = NULL;
+	char* description = NULL;
+	char* derivedType = NULL;
+	char* complexType = NULL;
+	int noOfElements = 0;
+	unsigned int count = 0;
+	unsigned int index = 0;
+
+	*pFound = IPDR_FALSE;
+
+	if (openSchemaCacheImage(SchemaURI, SchemaFile,
+							 SCHEMA_CACHE_DESCRIPTOR, &image) != IPDR_OK)
+		return (IPDR_OK);
+
+	targetNameSpace = getSchemaCacheBounded(&image, MAX_NAMESPACE_URI);
+	nameSpaceId = getSchemaCacheString(&image);
+	schemaLocation = getSchemaCacheBounded(&image, MAX_NAMESPACE_URI);
+	extensionBase = getSchemaCacheString(&image);
+	serviceType = getSchemaCacheBounded(&image, MAX_IPDR_STRING);
+	pListVersion = getSchemaCacheList(&image);
+
+	count = getSchemaCacheInt(&image);
+	for (index = 0; index < count && image.failed_ == IPDR_FALSE; index++) {
+		attributeName = getSchemaCacheString(&image);
+		attributeType = getSchemaCacheBounded(&image, MAX_ATTRIBUTE_TYPE);
+		description = getSchemaCacheBounded(&image, MAX_ATTRIBUTE_CLASS);
+		derivedType = getSchemaCacheBounded(&image, MAX_ATTRIBUTE_TYPE);
+		complexType = getSchemaCacheString(&image);
+		noOfElements = (int) getSchemaCacheInt(&image);
+		pListAttrName = getSchemaCacheList(&image);
+		pListAttrClass = getSchemaCacheList(&image);
+		pListAttrMaxOccurs = getSchemaCacheList(&image);
+
+		if (attributeName == NULL ||
+			(complexType != NULL && strlen(complexType) >= MAX_ATTRIBUTE_TYPE))
+			image.failed_ = IPDR_TRUE;
+
+		if (image.failed_ == IPDR_FALSE) {
+			appendListAttributeDescriptor(ppTail, attributeName, attributeType,
+										  description, derivedType, complexType,
+										  pListAttrName, pListAttrClass,
+										  pListAttrMaxOccurs, noOfElements);
+			if (*ppTail == NULL)
+				image.failed_ = IPDR_TRUE;
+			else
+				ppTail = &(*ppTail)->pNext_;
+		}
+
+		freeList(&pListAttrName);
+		freeList(&pListAttrClass);
+		freeList(&pListAttrMaxOccurs);
+	}
+
+	if (image.failed_ == IPDR_TRUE) {
+		freeListAttributeDescriptor(&pListAttributeDescriptor);
+		freeList(&pListVersion);
+		unmapSchemaCacheImage(&image);
+		return (IPDR_OK);
+	}
+
+	strcpy(pDescriptorCommon->targetNameSpace_, targetNameSpace);
+	free(pDescriptorCommon->nameSpaceId_);
+	pDescriptorCommon->nameSpaceId_ = copySchemaCacheString(nameSpaceId);
+	strcpy(pDescriptorCommon->schemaLocation_, schemaLocation);
+	if (extensionBase != NULL) {
+		free(pDescriptorCommon->extensionBase_);
+		pDescriptorCommon->extensionBase_ = copySchemaCacheString(extensionBase);
+	}
+	strcpy(pDescriptorCommon->pFNFType_->serviceType_, serviceType);
+	freeListAttributeDescriptor(&(pDescriptorCommon->pFNFType_->pListAttributeDescriptor_));
+	pDescriptorCommon->pFNFType_->pListAttributeDescriptor_ = pListAttributeDescriptor;
+	freeList(&(pDescriptorCommon->lstVersion_));
+	pDescriptorCommon->lstVersion_ = pListVersion;
+
+	unmapSchemaCacheImage(&image);
+	*pFound = IPDR_TRUE;
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      storeSchemaCommonCache() - Caches what parseSchemaLookup() read
+ *
+ *  DESCRIPTION:
+ *      Writes the members of SchemaCommon used by
+ *      generateSchemaLookup() once the schema is parsed. Failures
+ *      only leave the cache without the image.
+ *
+ *  ARGUMENTS:
+ *       - SchemaURI {IN}
+ *       - SchemaFile {IN}, local copy of the schema
+ *       - pSchemaCommon {IN}
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK, or IPDR_WARNING if nothing was cached.
+ */
+
+int storeSchemaCommonCache(char* SchemaURI,
+						   char* SchemaFile,
+						   SchemaCommon* pSchemaCommon)
+{
+	SchemaCacheImage image;
+	ListSchemaElement* pCurrent = NULL;
+	SchemaElement* pSchemaElement = NULL;
+	unsigned int count = 0;
+
+	if (createSchemaCacheImage(SchemaURI, SchemaFile,
+							   SCHEMA_CACHE_LOOKUP, &image) != IPDR_OK)
+		return (IPDR_WARNING);
+
+	putSchemaCacheString(&image, pSchemaCommon->targetNameSpace_);
+	putSchemaCacheString(&image, pSchemaCommon->nameSpaceId_);
+	putSchemaCacheString(&image, pSchemaCommon->schemaLocation_);
+	putSchemaCacheString(&image, pSchemaCommon->extensionBase_);
+	putSchemaCacheString(&image, pSchemaCommon->pSchemaLookup_->serviceType_);
+	putSchemaCacheList(&image, pSchemaCommon->lstReference_);
+	putSchemaCacheList(&image, pSchemaCommon->lstVersion_);
+
+	for (pCurrent = pSchemaCommon->pSchemaLookup_->pListSchemaElement_;
+		 pCurrent != NULL; pCurrent = pCurrent->pNext_)
+		count++;
+
+	putSchemaCacheInt(&image, count);
+	for (pCurrent = pSchemaCommon->pSchemaLookup_->pListSchemaElement_;
+		 pCurrent != NULL; pCurrent = pCurrent->pNext_) {
+		pSchemaElement = pCurrent->pSchemaElement_;
+		putSchemaCacheString(&image, pSchemaElement->attributeName_);
+		putSchemaCacheString(&image, pSchemaElement->attributeType_);
+		putSchemaCacheString(&image, pSchemaElement->complexAttributeType_);
+		putSchemaCacheString(&image, pSchemaElement->documentation_);
+		putSchemaCacheString(&image, pSchemaElement->derivedType_);
+		putSchemaCacheString(&image, pSchemaElement->unit_);
+		putSchemaCacheString(&image, pSchemaElement->reference_);
+		putSchemaCacheString(&image, pSchemaElement->status_);
+		putSchemaCacheList(&image, pSchemaElement->pListAttributeEnum_);
+		putSchemaCacheList(&image, pSchemaElement->pListReference_);
+		putSchemaCacheList(&image, pSchemaElement->pListMinOccurs_);
+		putSchemaCacheList(&image, pSchemaElement->pListMaxOccurs_);
+		putSchemaCacheInt(&image, (unsigned int) pSchemaElement->pAttributeOptional_);
+		putSchemaCacheInt(&image, (unsigned int) pSchemaElement->noOfElements_);
+	}
+
+	return (finishSchemaCacheImage(SchemaURI, SCHEMA_CACHE_LOOKUP, &image));
+}
+
+
+/*!
+ *  NAME:
+ *      loadSchemaCommonCache() - Reads parseSchemaLookup() results
+ *                                from the cache
+ *
+ *  DESCRIPTION:
+ *      Fills a new SchemaCommon as parseSchemaLookup() would from the
+ *      image of the schema, if there is a current one. The version
+ *      attributes are left in lstVersion_ for the caller to apply.
+ *      SchemaCommon is only changed once the whole image was read.
+ *
+ *  ARGUMENTS:
+ *       - SchemaURI {IN}
+ *       - SchemaFile {IN}, local copy of the schema
+ *       - pSchemaCommon {IN/OUT}
+ *       - pFound {OUT}, IPDR_TRUE if the image was used
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int loadSchemaCommonCache(char* SchemaURI,
+						  char* SchemaFile,
+						  SchemaCommon* pSchemaCommon,
+						  int* pFound)
+{
+	SchemaCacheImage image;
+	SchemaElement schemaElement;
+	ListSchemaElement* pListSchemaElement = NULL;
+	ListSchemaElement** ppTail = &pListSchemaElement;
+	List* pListReference = NULL;
+	List* pListVersion = NULL;
+	char* targetNameSpace = NULL;
+	char* nameSpaceId = NULL;
+	char* schemaLocation = NULL;
+	char* extensionBase = NULL;
+	char* serviceType = NULL;
+	unsigned int count = 0;
+	unsigned int index = 0;
+
+	*pFound = IPDR_FALSE;
+
+	if (openSchemaCacheImage(SchemaURI, SchemaFile,
+							 SCHEMA_CACHE_LOOKUP, &image) != IPDR_OK)
+		return (IPDR_OK);
+
+	targetNameSpace = getSchemaCacheBounded(&image, MAX_NAMESPACE_URI);
+	nameSpaceId = getSchemaCacheString(&image);
+	schemaLocation = getSchemaCacheBounded(&image, MAX_NAMESPACE_URI);
+	extensionBase = getSchemaCacheString(&image);
+	serviceType = getSchemaCacheString(&image);
+	pListReference = getSchemaCacheList(&image);
+	pListVersion = getSchemaCacheList(&image);
+
+	count = getSchemaCacheInt(&image);
+	for (index = 0; index < count && image.failed_ == IPDR_FALSE; index++) {
+		memset(&schemaElement, 0, sizeof(schemaElement));
+		schemaElement.attributeName_ = getSchemaCacheString(&image);
+		schemaElement.attributeType_ = getSchemaCacheString(&image);
+		schemaElement.complexAttributeType_ = getSchemaCacheString(&image);
+		schemaElement.documentation_ = getSchemaCacheString(&image);
+		schemaElement.derivedType_ = getSchemaCacheString(&image);
+		schemaElement.unit_ = getSchemaCacheString(&image);
+		schemaElement.reference_ = getSchemaCacheString(&image);
+		schemaElement.status_ = getSchemaCacheString(&image);
+		schemaElement.pListAttributeEnum_ = getSchemaCacheList(&image);
+		schemaElement.pListReference_ = getSchemaCacheList(&image);
+		schemaElement.pListMinOccurs_ = getSchemaCacheList(&image);
+		schemaElement.pListMaxOccurs_ = getSchemaCacheList(&image);
+		schemaElement.pAttributeOptional_ =
+			(AttributeOptional) getSchemaCacheInt(&image);
+		schemaElement.noOfElements_ = (int) getSchemaCacheInt(&image);
+
+		if (image.failed_ == IPDR_FALSE) {
+			if (addListSchemaElement(ppTail, &schemaElement) != IPDR_OK)
+				image.failed_ = IPDR_TRUE;
+			else
+				ppTail = &(*ppTail)->pNext_;
+		}
+
+		freeList(&schemaElement.pListAttributeEnum_);
+		freeList(&schemaElement.pListReference_);
+		freeList(&schemaElement.pListMinOccurs_);
+		freeList(&schemaElement.pListMaxOccurs_);
+	}
+
+	if (image.failed_ == IPDR_TRUE) {
+		freeListSchemaElement(&pListSchemaElement);
+		freeList(&pListReference);
+		freeList(&pListVersion);
+		unmapSchemaCacheImage(&image);
+		return (IPDR_OK);
+	}
+
+	strcpy(pSchemaCommon->targetNameSpace_, targetNameSpace);
+	free(pSchemaCommon->nameSpaceId_);
+	pSchemaCommon->nameSpaceId_ = copySchemaCacheString(nameSpaceId);
+	strcpy(pSchemaCommon->schemaLocation_, schemaLocation);
+	free(pSchemaCommon->extensionBase_);
+	pSchemaCommon->extensionBase_ = copySchemaCacheString(extensionBase);
+	free(pSchemaCommon->pSchemaLookup_->serviceType_);
+	pSchemaCommon->pSchemaLookup_->serviceType_ = copySchemaCacheString(serviceType);
+	freeListSchemaElement(&(pSchemaCommon->pSchemaLookup_->pListSchemaElement_));
+	pSchemaCommon->pSchemaLookup_->pListSchemaElement_ = pListSchemaElement;
+	freeList(&(pSchemaCommon->lstReference_));
+	pSchemaCommon->lstReference_ = pListReference;
+	freeList(&(pSchemaCommon->lstVersion_));
+	pSchemaCommon->lstVersion_ = pListVersion;
+
+	unmapSchemaCacheImage(&image);
+	*pFound = IPDR_TRUE;
+	return (IPDR_OK);
+}
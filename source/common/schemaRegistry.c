@@ -0,0 +1,259 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/******************************************************
+ * File                 : schemaRegistry.c            *
+ * Description          : Process wide registry of    *
+ *                        shared, read only schemas   *
+ * Author               : Infosys Tech Ltd            *
+ * Modification History :                             *
+ *--------------------------------------------------- *
+ * Date       Name        Change/Description          *
+ *--------------------------------------------------- *
+ *                                                    *
+ ******************************************************/
+
+#include "common/schemaRegistry.h"
+#include "common/schema.h"
+#include "utils/IPDRMap.h"
+#include "utils/IPDRMemory.h"
+#include "utils/IPDRThread.h"
+#include "utils/schemaUtil.h"
+#include "utils/errorCode.h"
+
+/*!
+ *  One loaded set of service definitions
+ */
+typedef struct SchemaRegistryEntry
+{
+	char* key_;              /* Default namespace, namespaces and URIs */
+	Schema* pSchema_;
+	struct SchemaRegistryEntry* pNext_;
+} SchemaRegistryEntry;
+
+static SchemaRegistryEntry* gpSchemaRegistry = NULL;
+static IPDRMutex gSchemaRegistryMutex = IPDR_MUTEX_INITIALIZER;
+
+
+/*!
+ *  NAME:
+ *      newSchemaRegistryKey() - key of a set of service definitions
+ *
+ *  DESCRIPTION:
+ *         Joins the default namespace, the namespace declarations and
+ *         the service definition URIs, in their order, into one
+ *         string.
+ *
+ *  ARGUMENTS:
+ *	    - pListNameSpaceInfo {IN}
+ *	    - pListServiceDefinitionURI {IN}
+ *	    - defaultNameSpace {IN}
+ *
+ *  RETURNS
+ *	     Returns the allocated key, or NULL if memory allocation
+ *	     failed
+ */
+
+static char* newSchemaRegistryKey(ListNameSpaceInfo* pListNameSpaceInfo,
+								  ListServiceDefinitionURI* pListServiceDefinitionURI,
+								  char* defaultNameSpace)
+{
+	size_t length = 0;
+	char* key = NULL;
+	ListNameSpaceInfo* pNameSpace = NULL;
+	ListServiceDefinitionURI* pURI = NULL;
+
+	length = strlen(defaultNameSpace) + 4;
+	for (pNameSpace = pListNameSpaceInfo; pNameSpace != NULL; pNameSpace = pNameSpace->pNext_)
+		length += strlen(pNameSpace->NameSpaceInfo_.nameSpaceID_) +
+				  strlen(pNameSpace->NameSpaceInfo_.nameSpaceURI_) + 4;
+	for (pURI = pListServiceDefinitionURI; pURI != NULL; pURI = pURI->pNext_)
+		length += strlen(pURI->pServiceDefintionURI_) + 3;
+
+	key = (char *) calloc(length + 1, sizeof(char));
+	if (key == NULL)
+		return (NULL);
+
+	strcat(key, "D:");
+	strcat(key, defaultNameSpace);
+	strcat(key, "\n");
+	for (pNameSpace = pListNameSpaceInfo; pNameSpace != NULL; pNameSpace = pNameSpace->pNext_) {
+		strcat(key, "N:");
+		strcat(key, pNameSpace->NameSpaceInfo_.nameSpaceID_);
+		strcat(key, "=");
+		strcat(key, pNameSpace->NameSpaceInfo_.nameSpaceURI_);
+		strcat(key, "\n");
+	}
+	for (pURI = pListServiceDefinitionURI; pURI != NULL; pURI = pURI->pNext_) {
+		strcat(key, "U:");
+		strcat(key, pURI->pServiceDefintionURI_);
+		strcat(key, "\n");
+	}
+
+	return (key);
+}
+
+
+/*!
+ *  NAME:
+ *      acquireSchemaData() - shared schema of a set of service
+ *      definitions
+ *
+ *  DESCRIPTION:
+ *         Points the document at the registry schema of the service
+ *         definitions, loading it with setSchemaData() if this is the
+ *         first request for them. The schema the document held before
+ *         is released or freed, along with the validators and
+ *         validation outcomes compiled against it.
+ *
+ *         Warnings of the load are reported to the document that
+ *         loaded the schema only.
+ *
+ *  ARGUMENTS:
+ *	    - pIPDRCommonParameters {IN/OUT}
+ *	    - pListNameSpaceInfo {IN}
+ *	    - pListServiceDefinitionURI {IN}
+ *	    - defaultNameSpace {IN}
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK, IPDR_WARNING or IPDR_ERROR as setSchemaData().
+ *	     On IPDR_ERROR the document keeps its schema.
+ */
+
+int acquireSchemaData(IPDRCommonParameters* pIPDRCommonParameters,
+					  ListNameSpaceInfo* pListNameSpaceInfo,
+					  ListServiceDefinitionURI* pListServiceDefinitionURI,
+					  char* defaultNameSpace,
+					  int* pErrorCode)
+{
+	int errorSeverity = IPDR_OK;
+	char* key = NULL;
+	Schema* pPreviousSchema = NULL;
+	SchemaRegistryEntry* pEntry = NULL;
+
+	if (pIPDRCommonParameters == NULL || pListServiceDefinitionURI == NULL ||
+		defaultNameSpace == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	key = newSchemaRegistryKey(pListNameSpaceInfo, pListServiceDefinitionURI,
+							   defaultNameSpace);
+	if (key == NULL) {
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return (IPDR_ERROR);
+	}
+
+	lockIPDRMutex(&gSchemaRegistryMutex);
+
+	for (pEntry = gpSchemaRegistry; pEntry != NULL; pEntry = pEntry->pNext_)
+		if (strcmp(pEntry->key_, key) == 0)
+			break;
+
+	pPreviousSchema = pIPDRCommonParameters->pSchema_;
+	if (pEntry == NULL) {
+		pIPDRCommonParameters->pSchema_ = newSchema();
+		if (pIPDRCommonParameters->pSchema_ == NULL) {
+			unlockIPDRMutex(&gSchemaRegistryMutex);
+			pIPDRCommonParameters->pSchema_ = pPreviousSchema;
+			free(key);
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return (IPDR_ERROR);
+		}
+		errorSeverity = setSchemaData(pIPDRCommonParameters, pListNameSpaceInfo,
+									  pListServiceDefinitionURI, defaultNameSpace,
+									  pErrorCode);
+		if (errorSeverity != IPDR_ERROR &&
+			buildSchemaIndex(pIPDRCommonParameters->pSchema_, pErrorCode) != IPDR_OK)
+			errorSeverity = IPDR_ERROR;
+		if (errorSeverity != IPDR_ERROR) {
+			pEntry = (SchemaRegistryEntry *) calloc(1, sizeof(SchemaRegistryEntry));
+			if (pEntry == NULL) {
+				*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+				errorSeverity = IPDR_ERROR;
+			}
+		}
+		if (errorSeverity == IPDR_ERROR) {
+			unlockIPDRMutex(&gSchemaRegistryMutex);
+			freeSchemaData(pIPDRCommonParameters->pSchema_);
+			pIPDRCommonParameters->pSchema_ = pPreviousSchema;
+			free(key);
+			return (IPDR_ERROR);
+		}
+
+		pIPDRCommonParameters->pSchema_->shared_ = IPDR_TRUE;
+		pEntry->key_ = key;
+		pEntry->pSchema_ = pIPDRCommonParameters->pSchema_;
+		pEntry->pNext_ = gpSchemaRegistry;
+		gpSchemaRegistry = pEntry;
+		key = NULL;
+	}
+	else {
+		pIPDRCommonParameters->pSchema_ = pEntry->pSchema_;
+	}
+	retainSchemaData(pEntry->pSchema_);
+
+	unlockIPDRMutex(&gSchemaRegistryMutex);
+	free(key);
+
+	freeIPDRIntMap(pIPDRCommonParameters->pValidatorMap_);
+	pIPDRCommonParameters->pValidatorMap_ = NULL;
+	freeIPDRIntMap(pIPDRCommonParameters->pValidationMemo_);
+	pIPDRCommonParameters->pValidationMemo_ = NULL;
+
+	if (pPreviousSchema->shared_ == IPDR_TRUE)
+		releaseSchemaData(pPreviousSchema);
+	else
+		freeSchemaData(pPreviousSchema);
+
+	return (errorSeverity);
+}
+
+
+/*!
+ *  NAME:
+ *      clearSchemaRegistry() - frees the unreferenced schemas
+ *
+ *  DESCRIPTION:
+ *         Schemas still referenced by a document are kept.
+ *
+ *  ARGUMENTS:
+ *	    NONE
+ *
+ *  RETURNS
+ *	     Returns the number of schemas left in the registry
+ */
+
+int clearSchemaRegistry(void)
+{
+	int noOfSchemas = 0;
+	SchemaRegistryEntry* pEntry = NULL;
+	SchemaRegistryEntry** ppLink = NULL;
+
+	lockIPDRMutex(&gSchemaRegistryMutex);
+
+	ppLink = &gpSchemaRegistry;
+	while (*ppLink != NULL) {
+		pEntry = *ppLink;
+		if (freeUnreferencedSchemaData(pEntry->pSchema_) != IPDR_OK) {
+			noOfSchemas++;
+			ppLink = &pEntry->pNext_;
+			continue;
+		}
+		*ppLink = pEntry->pNext_;
+		free(pEntry->key_);
+		free(pEntry);
+	}
+
+	unlockIPDRMutex(&gSchemaRegistryMutex);
+
+	return (noOfSchemas);
+}
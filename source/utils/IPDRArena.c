@@ -0,0 +1,233 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : IPDRArena                  *
+ * Description          : Region allocator for       *
+ *                        records                    *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils/IPDRArena.h"
+#include "utils/IPDRCommon.h"
+#include "utils/errorCode.h"
+
+/* Size of a chunk header, rounded up to keep the blocks aligned */
+#define IPDR_ARENA_HEADER_SIZE \
+	((sizeof(IPDRArenaChunk) + IPDR_ARENA_ALIGNMENT - 1) & ~(size_t) (IPDR_ARENA_ALIGNMENT - 1))
+
+
+/*!
+ *  NAME:
+ *      newIPDRArenaChunk() - allocates a chunk of an arena
+ *
+ *  ARGUMENTS:
+ *       - size {IN}, usable bytes
+ *
+ *  RETURNS
+ *       Returns the chunk or NULL if memory allocation failed
+ */
+
+static IPDRArenaChunk* newIPDRArenaChunk(size_t size)
+{
+	IPDRArenaChunk* pChunk;
+
+	pChunk = (IPDRArenaChunk *) malloc(IPDR_ARENA_HEADER_SIZE + size);
+	if (pChunk == NULL)
+		return (NULL);
+
+	pChunk->pNext_ = NULL;
+	pChunk->size_ = size;
+	pChunk->used_ = 0;
+
+	return (pChunk);
+}
+
+
+/*!
+ *  NAME:
+ *      newIPDRArena() - creates an arena
+ *
+ *  DESCRIPTION:
+ *      The first chunk is allocated at once. Blocks larger than a
+ *      chunk get a chunk of their own.
+ *
+ *  ARGUMENTS:
+ *       - chunkSize {IN}, 0 for IPDR_ARENA_CHUNK_SIZE
+ *
+ *  RETURNS
+ *       Returns the arena or NULL if memory allocation failed
+ */
+
+IPDRArena* newIPDRArena(size_t chunkSize)
+{
+	IPDRArena* pArena;
+
+	if (chunkSize == 0)
+		chunkSize = IPDR_ARENA_CHUNK_SIZE;
+
+	pArena = (IPDRArena *) calloc(1, sizeof(IPDRArena));
+	if (pArena == NULL)
+		return (NULL);
+
+	pArena->chunkSize_ = chunkSize;
+	pArena->pFirst_ = newIPDRArenaChunk(chunkSize);
+	if (pArena->pFirst_ == NULL) {
+		free(pArena);
+		return (NULL);
+	}
+	pArena->pCurrent_ = pArena->pFirst_;
+
+	return (pArena);
+}
+
+
+/*!
+ *  NAME:
+ *      allocIPDRArena() - allocates a zeroed block from an arena
+ *
+ *  DESCRIPTION:
+ *      The block is taken from the current chunk. When it does not
+ *      fit, the next chunk kept by a reset is used, or a new chunk is
+ *      linked after the current one.
+ *
+ *  ARGUMENTS:
+ *       - pArena {IN/OUT}
+ *       - size {IN}
+ *
+ *  RETURNS
+ *       Returns the block or NULL if memory allocation failed
+ */
+
+void* allocIPDRArena(IPDRArena* pArena, size_t size)
+{
+	IPDRArenaChunk* pChunk;
+	void* pBlock;
+
+	if (pArena == NULL)
+		return (NULL);
+
+	size = (size + IPDR_ARENA_ALIGNMENT - 1) & ~(size_t) (IPDR_ARENA_ALIGNMENT - 1);
+
+	pChunk = pArena->pCurrent_;
+	while (pChunk->size_ - pChunk->used_ < size) {
+		if (pChunk->pNext_ == NULL || pChunk->pNext_->size_ < size) {
+			pChunk = newIPDRArenaChunk(size > pArena->chunkSize_ ? size : pArena->chunkSize_);
+			if (pChunk == NULL)
+				return (NULL);
+			pChunk->pNext_ = pArena->pCurrent_->pNext_;
+			pArena->pCurrent_->pNext_ = pChunk;
+		}
+		else {
+			pChunk = pChunk->pNext_;
+			pChunk->used_ = 0;
+		}
+		pArena->pCurrent_ = pChunk;
+	}
+
+	pBlock = (char *) pChunk + IPDR_ARENA_HEADER_SIZE + pChunk->used_;
+	pChunk->used_ += size;
+	memset(pBlock, 0, size);
+
+	return (pBlock);
+}
+
+
+/*!
+ *  NAME:
+ *      copyIPDRArenaString() - copies a string into an arena
+ *
+ *  ARGUMENTS:
+ *       - pArena {IN/OUT}
+ *       - pString {IN}
+ *
+ *  RETURNS
+ *       Returns the copy or NULL if memory allocation failed
+ */
+
+char* copyIPDRArenaString(IPDRArena* pArena, const char* pString)
+{
+	size_t length;
+	char* pCopy;
+
+	if (pString == NULL)
+		return (NULL);
+
+	length = strlen(pString) + 1;
+	pCopy = (char *) allocIPDRArena(pArena, length);
+	if (pCopy != NULL)
+		memcpy(pCopy, pString, length);
+
+	return (pCopy);
+}
+
+
+/*!
+ *  NAME:
+ *      resetIPDRArena() - frees every block of an arena
+ *
+ *  DESCRIPTION:
+ *      Allocation restarts at the first chunk; the other chunks are
+ *      kept and reused as the arena fills up again.
+ *
+ *  ARGUMENTS:
+ *       - pArena {IN/OUT}
+ *
+ *  RETURNS
+ *       Returns Zero or appropriate error code
+ */
+
+int resetIPDRArena(IPDRArena* pArena)
+{
+	if (pArena == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	pArena->pCurrent_ = pArena->pFirst_;
+	pArena->pFirst_->used_ = 0;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      freeIPDRArena() - releases an arena and its chunks
+ *
+ *  ARGUMENTS:
+ *       - pArena {IN}
+ *
+ *  RETURNS
+ *       Returns Zero or appropriate error code
+ */
+
+int freeIPDRArena(IPDRArena* pArena)
+{
+	IPDRArenaChunk* pChunk;
+	IPDRArenaChunk* pNext;
+
+	if (pArena == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	for (pChunk = pArena->pFirst_; pChunk != NULL; pChunk = pNext) {
+		pNext = pChunk->pNext_;
+		free(pChunk);
+	}
+	free(pArena);
+
+	return (IPDR_OK);
+}
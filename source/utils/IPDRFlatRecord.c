@@ -0,0 +1,767 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : IPDRFlatRecord             *
+ * Description          : Record held in flat arrays *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils/IPDRFlatRecord.h"
+#include "utils/IPDRMemory.h"
+#include "utils/errorCode.h"
+#include "xdr/IPDRRecord.h"
+
+
+/*!
+ *  NAME:
+ *      isFlatValueType() - tells whether a value type can be held in a
+ *                          flat record
+ *
+ *  ARGUMENTS:
+ *       - dataType {IN}
+ *
+ *  RETURNS
+ *       Returns IPDR_TRUE for the primitive types, IPDR_FALSE otherwise
+ */
+
+static int isFlatValueType(int dataType)
+{
+	return (dataType >= IPDRDATA_LONG && dataType <= IPDRDATA_USHORT);
+}
+
+
+/*!
+ *  NAME:
+ *      isFlatBytesType() - tells whether values of a type are kept in
+ *                          the payload
+ *
+ *  ARGUMENTS:
+ *       - dataType {IN}
+ *
+ *  RETURNS
+ *       Returns IPDR_TRUE for byte arrays, strings and booleans
+ */
+
+static int isFlatBytesType(int dataType)
+{
+	return (dataType == IPDRDATA_HEXADECARRAY || dataType == IPDRDATA_STRING ||
+			dataType == IPDRDATA_BOOLEAN);
+}
+
+
+/*!
+ *  NAME:
+ *      reserveIPDRFlatRecord() - makes room for the attributes of a
+ *                                layout
+ *
+ *  DESCRIPTION:
+ *      The value and descriptor arrays only grow, so a record reused
+ *      for layouts of similar size is not reallocated.
+ *
+ *  ARGUMENTS:
+ *       - pRecord {IN/OUT}
+ *       - noOfAttributes {IN}
+ *
+ *  RETURNS
+ *       Returns Zero or appropriate error code
+ */
+
+static int reserveIPDRFlatRecord(IPDRFlatRecord* pRecord, int noOfAttributes)
+{
+	int capacity = 0;
+	IPDRFlatValue* pValues;
+	AttributeDescriptor** ppAttributeDescriptors;
+
+	if (noOfAttributes <= pRecord->capacity_)
+		return (IPDR_OK);
+
+	capacity = pRecord->capacity_ * 2;
+	if (capacity < noOfAttributes)
+		capacity = noOfAttributes;
+
+	pValues = (IPDRFlatValue *) realloc(pRecord->pValues_,
+										capacity * sizeof(IPDRFlatValue));
+	if (pValues == NULL)
+		return (IPDR_MEMORY_ALLOCATION_FAILED);
+	pRecord->pValues_ = pValues;
+
+	ppAttributeDescriptors = (AttributeDescriptor **) realloc(
+								pRecord->ppAttributeDescriptors_,
+								capacity * sizeof(AttributeDescriptor *));
+	if (ppAttributeDescriptors == NULL)
+		return (IPDR_MEMORY_ALLOCATION_FAILED);
+	pRecord->ppAttributeDescriptors_ = ppAttributeDescriptors;
+
+	pRecord->capacity_ = capacity;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      reserveIPDRFlatPayload() - makes room for a value in the payload
+ *
+ *  DESCRIPTION:
+ *      Values are referred to by offset, so the payload can move when
+ *      it grows.
+ *
+ *  ARGUMENTS:
+ *       - pRecord {IN/OUT}
+ *       - length {IN}, bytes of the value, not counting its terminator
+ *
+ *  RETURNS
+ *       Returns Zero or appropriate error code
+ */
+
+static int reserveIPDRFlatPayload(IPDRFlatRecord* pRecord, int length)
+{
+	int capacity = 0;
+	char* pPayload;
+
+	if (pRecord->payloadLength_ + length + 1 <= pRecord->payloadCapacity_)
+		return (IPDR_OK);
+
+	capacity = pRecord->payloadCapacity_ * 2;
+	if (capacity < pRecord->payloadLength_ + length + 1)
+		capacity = pRecord->payloadLength_ + length + 1;
+
+	pPayload = (char *) realloc(pRecord->pPayload_, capacity);
+	if (pPayload == NULL)
+		return (IPDR_MEMORY_ALLOCATION_FAILED);
+	pRecord->pPayload_ = pPayload;
+	pRecord->payloadCapacity_ = capacity;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      newIPDRFlatRecord() - Memory allocation of IPDRFlatRecord
+ *
+ *  DESCRIPTION:
+ *      The record has no layout until setIPDRFlatRecordLayout() or
+ *      copyFNFDataToFlatRecord() is called, or a record is read into
+ *      it.
+ *
+ *  ARGUMENTS:
+ *       - void
+ *
+ *  RETURNS
+ *       Returns Pointer to IPDRFlatRecord or NULL if memory allocation
+ *       failed
+ */
+
+IPDRFlatRecord* newIPDRFlatRecord(void)
+{
+	IPDRFlatRecord* pRecord;
+
+	pRecord = (IPDRFlatRecord *) calloc(1, sizeof(IPDRFlatRecord));
+	if (pRecord == NULL)
+		return (NULL);
+
+	pRecord->pLayoutArena_ = newIPDRArena(0);
+	pRecord->pPayload_ = (char *) malloc(IPDR_FLAT_PAYLOAD_SIZE);
+	if (pRecord->pLayoutArena_ == NULL || pRecord->pPayload_ == NULL) {
+		freeIPDRFlatRecord(pRecord);
+		return (NULL);
+	}
+	pRecord->payloadCapacity_ = IPDR_FLAT_PAYLOAD_SIZE;
+
+	return (pRecord);
+}
+
+
+/*!
+ *  NAME:
+ *      freeIPDRFlatRecord() - Memory deallocation of IPDRFlatRecord
+ *
+ *  ARGUMENTS:
+ *       - pRecord {IN/OUT}
+ *
+ *  RETURNS
+ *       Returns Zero or appropriate error code
+ */
+
+int freeIPDRFlatRecord(IPDRFlatRecord* pRecord)
+{
+	if (pRecord == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	if (pRecord->pLayoutArena_ != NULL)
+		freeIPDRArena(pRecord->pLayoutArena_);
+	freeIPDRStringMap(pRecord->pAttributeIndex_);
+	free(pRecord->ppAttributeDescriptors_);
+	free(pRecord->pValues_);
+	free(pRecord->pPayload_);
+	free(pRecord);
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      setIPDRFlatRecordLayout() - sets the type and attributes of a
+ *                                  flat record
+ *
+ *  DESCRIPTION:
+ *      The descriptors are copied, and the attribute indexes follow
+ *      their order. All values are unset. Arrays cannot be held in a
+ *      flat record.
+ *
+ *  ARGUMENTS:
+ *       - pRecord {IN/OUT}
+ *       - typeName {IN}
+ *       - pListAttributeDescriptor {IN}
+ *       - pListServiceAttributeDescriptor {IN}, may be NULL
+ *
+ *  RETURNS
+ *       Returns Zero or appropriate error code
+ */
+
+int setIPDRFlatRecordLayout(IPDRFlatRecord* pRecord,
+							const char* typeName,
+							const ListAttributeDescriptor* pListAttributeDescriptor,
+							const ListAttributeDescriptor* pListServiceAttributeDescriptor)
+{
+	int count = 0;
+	int errorCode = IPDR_OK;
+	int noOfAttributes = 0;
+	const ListAttributeDescriptor* pCurrent;
+	ListAttributeDescriptor** ppTail;
+
+	if (pRecord == NULL || typeName == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	for (pCurrent = pListAttributeDescriptor; pCurrent != NULL; pCurrent = pCurrent->pNext_) {
+		if (pCurrent->pAttributeDescriptor_->noOfElements_ != 0)
+			return (IPDR_NON_PRIMITIVE_DATA_TYPE);
+		noOfAttributes++;
+	}
+
+	if (reserveIPDRFlatRecord(pRecord, noOfAttributes) != IPDR_OK)
+		return (IPDR_MEMORY_ALLOCATION_FAILED);
+
+	resetIPDRArena(pRecord->pLayoutArena_);
+	freeIPDRStringMap(pRecord->pAttributeIndex_);
+	pRecord->pAttributeIndex_ = NULL;
+	pRecord->pListAttributeDescriptor_ = NULL;
+	pRecord->pListServiceAttributeDescriptor_ = NULL;
+	pRecord->noOfAttributes_ = 0;
+	pRecord->pReadDocument_ = NULL;
+	pRecord->readDescriptorID_ = 0;
+	pRecord->pWriteDocument_ = NULL;
+	pRecord->writeDescriptorID_ = 0;
+
+	pRecord->typeName_ = copyIPDRArenaString(pRecord->pLayoutArena_, typeName);
+	pRecord->pAttributeIndex_ = newIPDRStringMap(noOfAttributes);
+	if (pRecord->typeName_ == NULL || pRecord->pAttributeIndex_ == NULL)
+		return (IPDR_MEMORY_ALLOCATION_FAILED);
+
+	/* The tail is kept, so the copies are appended without a search */
+	ppTail = &(pRecord->pListAttributeDescriptor_);
+	for (pCurrent = pListAttributeDescriptor; pCurrent != NULL; pCurrent = pCurrent->pNext_) {
+		if (appendListAttributeDescriptorInArena(pRecord->pLayoutArena_, ppTail,
+				pCurrent->pAttributeDescriptor_) != IPDR_OK)
+			return (IPDR_MEMORY_ALLOCATION_FAILED);
+		/* Descriptors read from XML have no complex type */
+		if ((*ppTail)->pAttributeDescriptor_->complexType_ == NULL)
+			(*ppTail)->pAttributeDescriptor_->complexType_ =
+				copyIPDRArenaString(pRecord->pLayoutArena_, "");
+		pRecord->ppAttributeDescriptors_[count] = (*ppTail)->pAttributeDescriptor_;
+		if (putIPDRStringMap(pRecord->pAttributeIndex_,
+							 (*ppTail)->pAttributeDescriptor_->attributeName_,
+							 count, &errorCode) != IPDR_OK)
+			return (errorCode);
+		ppTail = &((*ppTail)->pNext_);
+		count++;
+	}
+
+	ppTail = &(pRecord->pListServiceAttributeDescriptor_);
+	for (pCurrent = pListServiceAttributeDescriptor; pCurrent != NULL; pCurrent = pCurrent->pNext_) {
+		if (appendListAttributeDescriptorInArena(pRecord->pLayoutArena_, ppTail,
+				pCurrent->pAttributeDescriptor_) != IPDR_OK)
+			return (IPDR_MEMORY_ALLOCATION_FAILED);
+		ppTail = &((*ppTail)->pNext_);
+	}
+
+	pRecord->noOfAttributes_ = noOfAttributes;
+	pRecord->fingerprint_ = fingerprintDescriptor(pRecord->typeName_,
+												  pRecord->pListAttributeDescriptor_);
+
+	return (clearIPDRFlatRecord(pRecord));
+}
+
+
+/*!
+ *  NAME:
+ *      clearIPDRFlatRecord() - unsets all values of a flat record
+ *
+ *  DESCRIPTION:
+ *      The layout and the capacity of the record are kept.
+ *
+ *  ARGUMENTS:
+ *       - pRecord {IN/OUT}
+ *
+ *  RETURNS
+ *       Returns Zero or appropriate error code
+ */
+
+int clearIPDRFlatRecord(IPDRFlatRecord* pRecord)
+{
+	if (pRecord == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	if (pRecord->noOfAttributes_ > 0)
+		memset(pRecord->pValues_, 0, pRecord->noOfAttributes_ * sizeof(IPDRFlatValue));
+	pRecord->payloadLength_ = 0;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      getIPDRFlatRecordIndex() - returns the index of an attribute
+ *
+ *  ARGUMENTS:
+ *       - pRecord {IN}
+ *       - attributeName {IN}
+ *
+ *  RETURNS
+ *       Returns the index or -1 if the layout has no such attribute
+ */
+
+int getIPDRFlatRecordIndex(const IPDRFlatRecord* pRecord,
+						   const char* attributeName)
+{
+	int index = 0;
+
+	if (pRecord == NULL ||
+		getIPDRStringMap(pRecord->pAttributeIndex_, attributeName, &index) != IPDR_TRUE)
+		return (-1);
+
+	return (index);
+}
+
+
+/*!
+ *  NAME:
+ *      setIPDRFlatValue() - sets the value of an attribute
+ *
+ *  DESCRIPTION:
+ *      pDataValue holds the value in the member of its type, as the
+ *      values of ListIPDRData. Byte arrays, strings and booleans are
+ *      terminated strings there, which are copied into the payload.
+ *
+ *  ARGUMENTS:
+ *       - pRecord {IN/OUT}
+ *       - index {IN}
+ *       - pDataValue {IN}
+ *       - dataType {IN}
+ *
+ *  RETURNS
+ *       Returns Zero or appropriate error code
+ */
+
+int setIPDRFlatValue(IPDRFlatRecord* pRecord,
+					 int index,
+					 const IPDRDataUnion* pDataValue,
+					 int dataType)
+{
+	IPDRFlatValue* pValue;
+	const char* pBytes;
+
+	if (pRecord == NULL || pDataValue == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	if (index < 0 || index >= pRecord->noOfAttributes_)
+		return (IPDR_ATTRIBUTE_NOT_IN_LAYOUT);
+
+	if (isFlatValueType(dataType) == IPDR_FALSE)
+		return (IPDR_NON_PRIMITIVE_DATA_TYPE);
+
+	if (isFlatBytesType(dataType) == IPDR_TRUE) {
+		if (dataType == IPDRDATA_STRING)
+			pBytes = (const char *) pDataValue->IPDRUTF8Array_;
+		else if (dataType == IPDRDATA_HEXADECARRAY)
+			pBytes = (const char *) pDataValue->IPDRByteArray_;
+		else
+			pBytes = (const char *) pDataValue->IPDRBoolean_;
+		if (pBytes == NULL)
+			return (IPDR_NULL_INPUT_PARAMETER);
+		return (setIPDRFlatBytes(pRecord, index, pBytes, strlen(pBytes), dataType));
+	}
+
+	pValue = &pRecord->pValues_[index];
+	pValue->IPDRDataUnion_ = *pDataValue;
+	pValue->IPDRDataType_ = dataType;
+	pValue->length_ = 0;
+	pValue->offset_ = 0;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      setIPDRFlatValueByName() - sets the value of a named attribute
+ *
+ *  DESCRIPTION:
+ *      Same as setIPDRFlatValue(), with the index looked up first.
+ *
+ *  ARGUMENTS:
+ *       - pRecord {IN/OUT}
+ *       - attributeName {IN}
+ *       - pDataValue {IN}
+ *       - dataType {IN}
+ *
+ *  RETURNS
+ *       Returns Zero or appropriate error code
+ */
+
+int setIPDRFlatValueByName(IPDRFlatRecord* pRecord,
+						   const char* attributeName,
+						   const IPDRDataUnion* pDataValue,
+						   int dataType)
+{
+	return (setIPDRFlatValue(pRecord, getIPDRFlatRecordIndex(pRecord, attributeName),
+							 pDataValue, dataType));
+}
+
+
+/*!
+ *  NAME:
+ *      setIPDRFlatBytes() - sets a byte array, string or boolean value
+ *
+ *  DESCRIPTION:
+ *      length bytes are copied into the payload and terminated, so
+ *      the value need not be terminated itself. A value set again
+ *      leaves its former bytes in the payload until the record is
+ *      cleared.
+ *
+ *  ARGUMENTS:
+ *       - pRecord {IN/OUT}
+ *       - index {IN}
+ *       - pValue {IN}
+ *       - length {IN}
+ *       - dataType {IN}
+ *
+ *  RETURNS
+ *       Returns Zero or appropriate error code
+ */
+
+int setIPDRFlatBytes(IPDRFlatRecord* pRecord,
+					 int index,
+					 const char* pValue,
+					 int length,
+					 int dataType)
+{
+	IPDRFlatValue* pFlatValue;
+
+	if (pRecord == NULL || (pValue == NULL && length > 0) || length < 0)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	if (index < 0 || index >= pRecord->noOfAttributes_)
+		return (IPDR_ATTRIBUTE_NOT_IN_LAYOUT);
+
+	if (isFlatBytesType(dataType) == IPDR_FALSE)
+		return (IPDR_NON_PRIMITIVE_DATA_TYPE);
+
+	if (reserveIPDRFlatPayload(pRecord, length) != IPDR_OK)
+		return (IPDR_MEMORY_ALLOCATION_FAILED);
+
+	pFlatValue = &pRecord->pValues_[index];
+	pFlatValue->IPDRDataType_ = dataType;
+	pFlatValue->length_ = length;
+	pFlatValue->offset_ = pRecord->payloadLength_;
+
+	if (length > 0)
+		memcpy(pRecord->pPayload_ + pRecord->payloadLength_, pValue, length);
+	pRecord->pPayload_[pRecord->payloadLength_ + length] = '\0';
+	pRecord->payloadLength_ += length + 1;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      getIPDRFlatValue() - returns the value of an attribute
+ *
+ *  DESCRIPTION:
+ *      The bytes of byte arrays, strings and booleans are returned by
+ *      getIPDRFlatBytes().
+ *
+ *  ARGUMENTS:
+ *       - pRecord {IN}
+ *       - index {IN}
+ *
+ *  RETURNS
+ *       Returns the value, or NULL if the index is out of range or the
+ *       value is unset
+ */
+
+const IPDRFlatValue* getIPDRFlatValue(const IPDRFlatRecord* pRecord,
+									  int index)
+{
+	if (pRecord == NULL || index < 0 || index >= pRecord->noOfAttributes_ ||
+		pRecord->pValues_[index].IPDRDataType_ == 0)
+		return (NULL);
+
+	return (&pRecord->pValues_[index]);
+}
+
+
+/*!
+ *  NAME:
+ *      getIPDRFlatValueByName() - returns the value of a named attribute
+ *
+ *  ARGUMENTS:
+ *       - pRecord {IN}
+ *       - attributeName {IN}
+ *
+ *  RETURNS
+ *       Returns the value, or NULL if there is no such attribute or
+ *       the value is unset
+ */
+
+const IPDRFlatValue* getIPDRFlatValueByName(const IPDRFlatRecord* pRecord,
+											const char* attributeName)
+{
+	return (getIPDRFlatValue(pRecord, getIPDRFlatRecordIndex(pRecord, attributeName)));
+}
+
+
+/*!
+ *  NAME:
+ *      getIPDRFlatBytes() - returns the bytes of a payload value
+ *
+ *  DESCRIPTION:
+ *      The bytes are terminated, and valid until the record is
+ *      cleared or a value is set.
+ *
+ *  ARGUMENTS:
+ *       - pRecord {IN}
+ *       - pValue {IN}
+ *
+ *  RETURNS
+ *       Returns the bytes, or NULL if the value is not a byte array,
+ *       string or boolean
+ */
+
+const char* getIPDRFlatBytes(const IPDRFlatRecord* pRecord,
+							 const IPDRFlatValue* pValue)
+{
+	if (pRecord == NULL || pValue == NULL ||
+		isFlatBytesType(pValue->IPDRDataType_) == IPDR_FALSE)
+		return (NULL);
+
+	return (pRecord->pPayload_ + pValue->offset_);
+}
+
+
+/*!
+ *  NAME:
+ *      sameIPDRFlatRecordLayout() - tells whether a record has the
+ *                                   layout of an FNFData
+ *
+ *  DESCRIPTION:
+ *      Compares the type name and the names and types of the
+ *      attributes.
+ *
+ *  ARGUMENTS:
+ *       - pRecord {IN}
+ *       - pFNFData {IN}
+ *
+ *  RETURNS
+ *       Returns IPDR_TRUE if the layouts match, IPDR_FALSE otherwise
+ */
+
+static int sameIPDRFlatRecordLayout(const IPDRFlatRecord* pRecord,
+									const FNFData* pFNFData)
+{
+	int count = 0;
+	const ListAttributeDescriptor* pCurrent;
+
+	if (pRecord->typeName_ == NULL || strcmp(pRecord->typeName_, pFNFData->typeName_) != 0)
+		return (IPDR_FALSE);
+
+	for (pCurrent = pFNFData->pListAttributeDescriptor_; pCurrent != NULL;
+		 pCurrent = pCurrent->pNext_, count++) {
+		if (count >= pRecord->noOfAttributes_ ||
+			strcmp(pRecord->ppAttributeDescriptors_[count]->attributeName_,
+				   pCurrent->pAttributeDescriptor_->attributeName_) != 0 ||
+			strcmp(pRecord->ppAttributeDescriptors_[count]->attributeType_,
+				   pCurrent->pAttributeDescriptor_->attributeType_) != 0)
+			return (IPDR_FALSE);
+	}
+
+	return (count == pRecord->noOfAttributes_);
+}
+
+
+/*!
+ *  NAME:
+ *      copyFNFDataToFlatRecord() - copies an FNFData into a flat record
+ *
+ *  DESCRIPTION:
+ *      The record takes the layout of the FNFData, which is kept if
+ *      the record has it already, and its values. FNFData holding
+ *      arrays or structures cannot be copied.
+ *
+ *  ARGUMENTS:
+ *       - pRecord {IN/OUT}
+ *       - pFNFData {IN}
+ *
+ *  RETURNS
+ *       Returns Zero or appropriate error code
+ */
+
+int copyFNFDataToFlatRecord(IPDRFlatRecord* pRecord,
+							const FNFData* pFNFData)
+{
+	int count = 0;
+	int errorCode = IPDR_OK;
+	const ListIPDRData* pCurrent;
+
+	if (pRecord == NULL || pFNFData == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	if (sameIPDRFlatRecordLayout(pRecord, pFNFData) == IPDR_TRUE)
+		errorCode = clearIPDRFlatRecord(pRecord);
+	else
+		errorCode = setIPDRFlatRecordLayout(pRecord, pFNFData->typeName_,
+											pFNFData->pListAttributeDescriptor_,
+											pFNFData->pListServiceAttributeDescriptor_);
+	if (errorCode != IPDR_OK)
+		return (errorCode);
+
+	for (pCurrent = pFNFData->pListIPDRData_; pCurrent != NULL && errorCode == IPDR_OK;
+		 pCurrent = pCurrent->pNext_, count++)
+		errorCode = setIPDRFlatValue(pRecord, count, &pCurrent->IPDRDataUnion_,
+									 pCurrent->IPDRDataType_);
+
+	return (errorCode);
+}
+
+
+/*!
+ *  NAME:
+ *      copyFlatRecordToFNFData() - appends a flat record to an FNFData
+ *
+ *  DESCRIPTION:
+ *      The FNFData is expected to be empty, as from newFNFData() or
+ *      newFNFDataInArena(). It takes the type name, the descriptors
+ *      of the set values and the values, in index order, so unset
+ *      attributes are left out as from a projected read.
+ *
+ *  ARGUMENTS:
+ *       - pFNFData {IN/OUT}
+ *       - pRecord {IN}
+ *
+ *  RETURNS
+ *       Returns Zero or appropriate error code
+ */
+
+int copyFlatRecordToFNFData(FNFData* pFNFData,
+							const IPDRFlatRecord* pRecord)
+{
+	int count = 0;
+	int errorCode = IPDR_OK;
+	void* dataValue = NULL;
+	const IPDRFlatValue* pValue;
+	ListAttributeDescriptor** ppDescriptorTail;
+	ListIPDRData** ppDataTail;
+	const ListAttributeDescriptor* pCurrent;
+
+	if (pFNFData == NULL || pRecord == NULL || pRecord->typeName_ == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	strcpy(pFNFData->typeName_, pRecord->typeName_);
+
+	ppDescriptorTail = &(pFNFData->pListAttributeDescriptor_);
+	while (*ppDescriptorTail != NULL)
+		ppDescriptorTail = &((*ppDescriptorTail)->pNext_);
+	ppDataTail = &(pFNFData->pListIPDRData_);
+	while (*ppDataTail != NULL)
+		ppDataTail = &((*ppDataTail)->pNext_);
+
+	for (count = 0; count < pRecord->noOfAttributes_ && errorCode == IPDR_OK; count++) {
+		pValue = &pRecord->pValues_[count];
+		switch (pValue->IPDRDataType_)
+		{
+		case 0:
+			continue;
+		case IPDRDATA_LONGLONG:
+		case IPDRDATA_ULONGLONG:
+		case IPDRDATA_FLOAT:
+		case IPDRDATA_DOUBLE:
+			dataValue = (void *) &pValue->IPDRDataUnion_;
+			break;
+		case IPDRDATA_HEXADECARRAY:
+		case IPDRDATA_STRING:
+		case IPDRDATA_BOOLEAN:
+			dataValue = (void *) (pRecord->pPayload_ + pValue->offset_);
+			break;
+		case IPDRDATA_ULONG:
+			dataValue = (void *) (unsigned long) pValue->IPDRDataUnion_.IPDRULong_;
+			break;
+		case IPDRDATA_USHORT:
+			dataValue = (void *) (unsigned long) pValue->IPDRDataUnion_.IPDRUShort_;
+			break;
+		case IPDRDATA_SHORT:
+			dataValue = (void *) (long) pValue->IPDRDataUnion_.IPDRShort_;
+			break;
+		case IPDRDATA_BYTE:
+		case IPDRDATA_UBYTE:
+			dataValue = (void *) (long) pValue->IPDRDataUnion_.IPDRByte_;
+			break;
+		default:
+			dataValue = (void *) (long) pValue->IPDRDataUnion_.IPDRLong_;
+			break;
+		}
+
+		/* Both lists are appended to at their tail */
+		errorCode = appendListAttributeDescriptorInArena(pFNFData->pArena_, ppDescriptorTail,
+														 pRecord->ppAttributeDescriptors_[count]);
+		if (errorCode == IPDR_OK)
+			errorCode = appendListIPDRDataInArena(pFNFData->pArena_, ppDataTail,
+												  dataValue, pValue->IPDRDataType_);
+		if (*ppDescriptorTail != NULL)
+			ppDescriptorTail = &((*ppDescriptorTail)->pNext_);
+		if (*ppDataTail != NULL)
+			ppDataTail = &((*ppDataTail)->pNext_);
+	}
+
+	ppDescriptorTail = &(pFNFData->pListServiceAttributeDescriptor_);
+	while (*ppDescriptorTail != NULL)
+		ppDescriptorTail = &((*ppDescriptorTail)->pNext_);
+	for (pCurrent = pRecord->pListServiceAttributeDescriptor_;
+		 pCurrent != NULL && errorCode == IPDR_OK; pCurrent = pCurrent->pNext_) {
+		errorCode = appendListAttributeDescriptorInArena(pFNFData->pArena_, ppDescriptorTail,
+														 pCurrent->pAttributeDescriptor_);
+		if (*ppDescriptorTail != NULL)
+			ppDescriptorTail = &((*ppDescriptorTail)->pNext_);
+	}
+
+	return (errorCode);
+}
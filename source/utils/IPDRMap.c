@@ -0,0 +1,546 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : IPDRMap                    *
+ * Description          : Typed open addressing maps *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "utils/IPDRMap.h"
+#include "utils/IPDRCommon.h"
+#include "utils/errorCode.h"
+
+
+/*!
+ *  NAME:
+ *      getIPDRMapCapacity() - number of slots for a number of entries
+ *
+ *  DESCRIPTION:
+ *      Smallest power of two that keeps the load factor of
+ *      expectedEntries at or below one half.
+ *
+ *  ARGUMENTS:
+ *       - expectedEntries {IN}
+ *
+ *  RETURNS
+ *       Returns the capacity
+ */
+
+static int getIPDRMapCapacity(int expectedEntries)
+{
+	int capacity = IPDR_MAP_MIN_CAPACITY;
+
+	while (capacity < expectedEntries * 2)
+		capacity = capacity * 2;
+
+	return (capacity);
+}
+
+/*!
+ *  NAME:
+ *      hashIPDRMapInt() - hash of an int key
+ *
+ *  DESCRIPTION:
+ *      Multiplicative hash; the high bits are folded down so that the
+ *      masked slot depends on every bit of the key.
+ */
+
+static unsigned int hashIPDRMapInt(int key)
+{
+	unsigned int hash = (unsigned int) key * 2654435769U;
+
+	return (hash ^ (hash >> 16));
+}
+
+
+/*!
+ *  NAME:
+ *      hashIPDRMapString() - hash of a string key
+ *
+ *  DESCRIPTION:
+ *      32 bit FNV-1a hash of the key. The result is never 0, since
+ *      0 marks an empty slot of an IPDRStringMap. Callers looking up
+ *      the same key repeatedly may keep the hash and use
+ *      getIPDRStringMapHashed().
+ *
+ *  ARGUMENTS:
+ *       - key {IN}
+ *
+ *  RETURNS
+ *       Returns the hash
+ */
+
+unsigned int hashIPDRMapString(const char* key)
+{
+	unsigned int hash = IPDR_FNV_OFFSET_BASIS;
+
+	for (; *key != '\0'; key++) {
+		hash ^= (unsigned char) *key;
+		hash *= IPDR_FNV_PRIME;
+	}
+
+	return (hash == 0 ? 1 : hash);
+}
+
+
+/*!
+ *  NAME:
+ *      newIPDRStringMap() - creates a string to int map
+ *
+ *  DESCRIPTION:
+ *      Allocates a map sized for expectedEntries. The map grows
+ *      as entries are added.
+ *
+ *  ARGUMENTS:
+ *       - expectedEntries {IN}
+ *
+ *  RETURNS
+ *       Returns the map or NULL if memory allocation failed
+ */
+
+IPDRStringMap* newIPDRStringMap(int expectedEntries)
+{
+	IPDRStringMap* pStringMap;
+
+	pStringMap = (IPDRStringMap *) calloc(1, sizeof(IPDRStringMap));
+	if (pStringMap == NULL)
+		return (NULL);
+
+	pStringMap->capacity_ = getIPDRMapCapacity(expectedEntries);
+	pStringMap->pEntries_ = (IPDRStringMapEntry *) calloc(
+								pStringMap->capacity_,
+								sizeof(IPDRStringMapEntry));
+	if (pStringMap->pEntries_ == NULL) {
+		free(pStringMap);
+		return (NULL);
+	}
+
+	return (pStringMap);
+}
+
+
+/*!
+ *  NAME:
+ *      freeIPDRStringMap() - frees a string to int map
+ *
+ *  DESCRIPTION:
+ *      Frees the map and its copies of the keys.
+ *
+ *  ARGUMENTS:
+ *       - pStringMap {IN}
+ *
+ *  RETURNS
+ *       <nothing>
+ */
+
+void freeIPDRStringMap(IPDRStringMap* pStringMap)
+{
+	int count;
+
+	if (pStringMap == NULL)
+		return;
+
+	for (count = 0; count < pStringMap->capacity_; count++)
+		free(pStringMap->pEntries_[count].key_);
+	free(pStringMap->pEntries_);
+	free(pStringMap);
+}
+
+
+/*!
+ *  NAME:
+ *      findIPDRStringMapSlot() - probes for a string key
+ *
+ *  DESCRIPTION:
+ *      Returns the slot holding key, or the empty slot where it
+ *      would be inserted.
+ */
+
+static IPDRStringMapEntry* findIPDRStringMapSlot(
+								IPDRStringMapEntry* pEntries,
+								int capacity,
+								const char* key,
+								unsigned int hash)
+{
+	unsigned int mask = (unsigned int) capacity - 1;
+	unsigned int slot = hash & mask;
+
+	while (pEntries[slot].hash_ != 0) {
+		if (pEntries[slot].hash_ == hash &&
+			strcmp(pEntries[slot].key_, key) == 0)
+			break;
+		slot = (slot + 1) & mask;
+	}
+
+	return (&pEntries[slot]);
+}
+
+
+/*!
+ *  NAME:
+ *      growIPDRStringMap() - doubles the capacity of a string map
+ *
+ *  DESCRIPTION:
+ *      Reinserts the entries by their stored hashes; keys are
+ *      moved, not copied.
+ *
+ *  RETURNS
+ *       Returns IPDR_OK or IPDR_ERROR if memory allocation failed
+ */
+
+static int growIPDRStringMap(IPDRStringMap* pStringMap)
+{
+	IPDRStringMapEntry* pEntries;
+	unsigned int mask;
+	unsigned int slot;
+	int capacity = pStringMap->capacity_ * 2;
+	int count;
+
+	pEntries = (IPDRStringMapEntry *) calloc(capacity, sizeof(IPDRStringMapEntry));
+	if (pEntries == NULL)
+		return (IPDR_ERROR);
+
+	mask = (unsigned int) capacity - 1;
+	for (count = 0; count < pStringMap->capacity_; count++) {
+		if (pStringMap->pEntries_[count].hash_ == 0)
+			continue;
+		slot = pStringMap->pEntries_[count].hash_ & mask;
+		while (pEntries[slot].hash_ != 0)
+			slot = (slot + 1) & mask;
+		pEntries[slot] = pStringMap->pEntries_[count];
+	}
+
+	free(pStringMap->pEntries_);
+	pStringMap->pEntries_ = pEntries;
+	pStringMap->capacity_ = capacity;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      putIPDRStringMap() - adds a key / value pair to a string map
+ *
+ *  DESCRIPTION:
+ *      The key is copied. If the key is already present its value
+ *      is replaced.
+ *
+ *  ARGUMENTS:
+ *       - pStringMap {IN/OUT}
+ *       - key {IN}
+ *       - value {IN}
+ *       - pErrorCode {IN/OUT}
+ *
+ *  RETURNS
+ *       Returns Zero or appropriate error code
+ */
+
+int putIPDRStringMap(IPDRStringMap* pStringMap,
+					 const char* key,
+					 int value,
+					 int* pErrorCode)
+{
+	IPDRStringMapEntry* pSlot;
+	unsigned int hash;
+
+	if (pStringMap == NULL || key == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	hash = hashIPDRMapString(key);
+	pSlot = findIPDRStringMapSlot(pStringMap->pEntries_, pStringMap->capacity_,
+								  key, hash);
+	if (pSlot->hash_ != 0) {
+		pSlot->value_ = value;
+		return (IPDR_OK);
+	}
+
+	if ((pStringMap->noOfEntries_ + 1) * 2 > pStringMap->capacity_) {
+		if (growIPDRStringMap(pStringMap) != IPDR_OK) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return (IPDR_ERROR);
+		}
+		pSlot = findIPDRStringMapSlot(pStringMap->pEntries_,
+									  pStringMap->capacity_, key, hash);
+	}
+
+	pSlot->key_ = (char *) malloc(strlen(key) + 1);
+	if (pSlot->key_ == NULL) {
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return (IPDR_ERROR);
+	}
+	strcpy(pSlot->key_, key);
+	pSlot->hash_ = hash;
+	pSlot->value_ = value;
+	pStringMap->noOfEntries_++;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      getIPDRStringMapHashed() - looks up a string key by its hash
+ *
+ *  DESCRIPTION:
+ *      Same as getIPDRStringMap(), with hash computed beforehand by
+ *      hashIPDRMapString().
+ *
+ *  ARGUMENTS:
+ *       - pStringMap {IN}
+ *       - key {IN}
+ *       - hash {IN}
+ *       - pValue {OUT}
+ *
+ *  RETURNS
+ *       Returns IPDR_TRUE if the key is present, IPDR_FALSE otherwise
+ */
+
+int getIPDRStringMapHashed(const IPDRStringMap* pStringMap,
+						   const char* key,
+						   unsigned int hash,
+						   int* pValue)
+{
+	IPDRStringMapEntry* pSlot;
+
+	if (pStringMap == NULL || key == NULL)
+		return (IPDR_FALSE);
+
+	pSlot = findIPDRStringMapSlot(pStringMap->pEntries_, pStringMap->capacity_,
+								  key, hash);
+	if (pSlot->hash_ == 0)
+		return (IPDR_FALSE);
+
+	if (pValue != NULL)
+		*pValue = pSlot->value_;
+
+	return (IPDR_TRUE);
+}
+
+
+/*!
+ *  NAME:
+ *      getIPDRStringMap() - looks up a string key
+ *
+ *  ARGUMENTS:
+ *       - pStringMap {IN}
+ *       - key {IN}
+ *       - pValue {OUT}, may be NULL
+ *
+ *  RETURNS
+ *       Returns IPDR_TRUE if the key is present, IPDR_FALSE otherwise
+ */
+
+int getIPDRStringMap(const IPDRStringMap* pStringMap,
+					 const char* key,
+					 int* pValue)
+{
+	if (key == NULL)
+		return (IPDR_FALSE);
+
+	return (getIPDRStringMapHashed(pStringMap, key, hashIPDRMapString(key), pValue));
+}
+
+
+/*!
+ *  NAME:
+ *      newIPDRIntMap() - creates an int to pointer map
+ *
+ *  DESCRIPTION:
+ *      Allocates a map sized for expectedEntries. The map grows
+ *      as entries are added. If valueDeallocator is not NULL it is
+ *      called on replaced values and on all values when the map is
+ *      freed.
+ *
+ *  ARGUMENTS:
+ *       - expectedEntries {IN}
+ *       - valueDeallocator {IN}
+ *
+ *  RETURNS
+ *       Returns the map or NULL if memory allocation failed
+ */
+
+IPDRIntMap* newIPDRIntMap(int expectedEntries,
+						  void (*valueDeallocator)(void* pValue))
+{
+	IPDRIntMap* pIntMap;
+
+	pIntMap = (IPDRIntMap *) calloc(1, sizeof(IPDRIntMap));
+	if (pIntMap == NULL)
+		return (NULL);
+
+	pIntMap->capacity_ = getIPDRMapCapacity(expectedEntries);
+	pIntMap->pEntries_ = (IPDRIntMapEntry *) calloc(pIntMap->capacity_,
+													sizeof(IPDRIntMapEntry));
+	if (pIntMap->pEntries_ == NULL) {
+		free(pIntMap);
+		return (NULL);
+	}
+	pIntMap->valueDeallocator_ = valueDeallocator;
+
+	return (pIntMap);
+}
+
+
+/*!
+ *  NAME:
+ *      freeIPDRIntMap() - frees an int to pointer map
+ *
+ *  ARGUMENTS:
+ *       - pIntMap {IN}
+ *
+ *  RETURNS
+ *       <nothing>
+ */
+
+void freeIPDRIntMap(IPDRIntMap* pIntMap)
+{
+	int count;
+
+	if (pIntMap == NULL)
+		return;
+
+	if (pIntMap->valueDeallocator_ != NULL) {
+		for (count = 0; count < pIntMap->capacity_; count++) {
+			if (pIntMap->pEntries_[count].used_)
+				pIntMap->valueDeallocator_(pIntMap->pEntries_[count].pValue_);
+		}
+	}
+	free(pIntMap->pEntries_);
+	free(pIntMap);
+}
+
+
+/*!
+ *  NAME:
+ *      findIPDRIntMapSlot() - probes for an int key
+ *
+ *  DESCRIPTION:
+ *      Returns the slot holding key, or the empty slot where it
+ *      would be inserted.
+ */
+
+static IPDRIntMapEntry* findIPDRIntMapSlot(IPDRIntMapEntry* pEntries,
+										   int capacity,
+										   int key)
+{
+	unsigned int mask = (unsigned int) capacity - 1;
+	unsigned int slot = hashIPDRMapInt(key) & mask;
+
+	while (pEntries[slot].used_ && pEntries[slot].key_ != key)
+		slot = (slot + 1) & mask;
+
+	return (&pEntries[slot]);
+}
+
+
+/*!
+ *  NAME:
+ *      putIPDRIntMap() - adds a key / value pair to an int map
+ *
+ *  DESCRIPTION:
+ *      If the key is already present its value is replaced, and the
+ *      old value handed to the value deallocator.
+ *
+ *  ARGUMENTS:
+ *       - pIntMap {IN/OUT}
+ *       - key {IN}
+ *       - pValue {IN}
+ *       - pErrorCode {IN/OUT}
+ *
+ *  RETURNS
+ *       Returns Zero or appropriate error code
+ */
+
+int putIPDRIntMap(IPDRIntMap* pIntMap,
+				  int key,
+				  void* pValue,
+				  int* pErrorCode)
+{
+	IPDRIntMapEntry* pSlot;
+	IPDRIntMapEntry* pEntries;
+	int capacity;
+	int count;
+
+	if (pIntMap == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	pSlot = findIPDRIntMapSlot(pIntMap->pEntries_, pIntMap->capacity_, key);
+	if (pSlot->used_) {
+		if (pSlot->pValue_ != pValue && pIntMap->valueDeallocator_ != NULL)
+			pIntMap->valueDeallocator_(pSlot->pValue_);
+		pSlot->pValue_ = pValue;
+		return (IPDR_OK);
+	}
+
+	if ((pIntMap->noOfEntries_ + 1) * 2 > pIntMap->capacity_) {
+		capacity = pIntMap->capacity_ * 2;
+		pEntries = (IPDRIntMapEntry *) calloc(capacity, sizeof(IPDRIntMapEntry));
+		if (pEntries == NULL) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return (IPDR_ERROR);
+		}
+		for (count = 0; count < pIntMap->capacity_; count++) {
+			if (pIntMap->pEntries_[count].used_)
+				*findIPDRIntMapSlot(pEntries, capacity,
+									pIntMap->pEntries_[count].key_) =
+					pIntMap->pEntries_[count];
+		}
+		free(pIntMap->pEntries_);
+		pIntMap->pEntries_ = pEntries;
+		pIntMap->capacity_ = capacity;
+		pSlot = findIPDRIntMapSlot(pEntries, capacity, key);
+	}
+
+	pSlot->key_ = key;
+	pSlot->used_ = IPDR_TRUE;
+	pSlot->pValue_ = pValue;
+	pIntMap->noOfEntries_++;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      getIPDRIntMap() - looks up an int key
+ *
+ *  ARGUMENTS:
+ *       - pIntMap {IN}
+ *       - key {IN}
+ *
+ *  RETURNS
+ *       Returns the value of key or NULL if the key is not present
+ */
+
+void* getIPDRIntMap(const IPDRIntMap* pIntMap, int key)
+{
+	IPDRIntMapEntry* pSlot;
+
+	if (pIntMap == NULL)
+		return (NULL);
+
+	pSlot = findIPDRIntMapSlot(pIntMap->pEntries_, pIntMap->capacity_, key);
+
+	return (pSlot->used_ ? pSlot->pValue_ : NULL);
+}
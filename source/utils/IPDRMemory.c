@@ -26,6 +26,12 @@
 #include "utils/IPDRMemory.h"
 #include "utils/errorHandler.h"
 #include "common/schema.h"
+#include "utils/schemaUtil.h"
+#include "utils/IPDRThread.h"
+#include "xdr/XDROutputBuffer.h"
+#include "xdr/XDRInputBuffer.h"
+#include "xdr/XDRCodecPlan.h"
+#include "xml/XMLUnMarshaller.h"
 
 
 /*!
@@ -649,6 +655,95 @@ FNFData* newFNFData(void)
 	return (pFNFData);
 }
 
+
+/*!
+ *  NAME:
+ *      newFNFDataInArena() - Memory allocation of 
+ *      FNFData structure in an arena
+ *
+ *  DESCRIPTION:
+ *      1. The record is allocated from the arena, and so are the
+ *         lists readIPDR() or the InArena functions append to it.
+ *      2. freeFNFData() leaves such a record alone; its memory is
+ *         given back when the arena is reset or freed.
+ *	
+ *  ARGUMENTS:
+ *       -	pArena {IN/OUT}, NULL to allocate from the heap
+ *
+ *  RETURNS 	
+ *	     Returns Pointer to FNFData structure or NULL if memory
+ *	     allocation failed
+ */
+
+FNFData* newFNFDataInArena(IPDRArena* pArena)
+{
+	FNFData* pFNFData;
+
+	if (pArena == NULL)
+		return (newFNFData());
+
+	pFNFData = (FNFData *) allocIPDRArena(pArena, sizeof(FNFData));
+	if (pFNFData == NULL)
+		return (NULL);
+
+	pFNFData->typeName_ = (char *) allocIPDRArena(pArena, MAX_ATTRIBUTE_TYPE);
+	if (pFNFData->typeName_ == NULL)
+		return (NULL);
+	pFNFData->pArena_ = pArena;
+
+	return (pFNFData);
+}
+
+
+/*!
+ *  NAME:
+ *      copyFNFDataInArena() - copies a record into an arena record
+ *
+ *  DESCRIPTION:
+ *      1. Appends copies of the attribute descriptors and values of
+ *         pSourceFNFData to pFNFData, a record from 
+ *         newFNFDataInArena(), and copies its type name.
+ *	
+ *  ARGUMENTS:
+ *       -	pFNFData {IN/OUT} 
+ *       -	pSourceFNFData {IN} 
+ *
+ *  RETURNS 	
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int copyFNFDataInArena(FNFData* pFNFData, const FNFData* pSourceFNFData)
+{
+	int errorCode = IPDR_OK;
+	const ListAttributeDescriptor* pCurrent;
+
+	if (pFNFData == NULL || pSourceFNFData == NULL || pFNFData->pArena_ == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	strcpy(pFNFData->typeName_, pSourceFNFData->typeName_);
+	pFNFData->descriptorID_ = pSourceFNFData->descriptorID_;
+
+	for (pCurrent = pSourceFNFData->pListAttributeDescriptor_; 
+		 pCurrent != NULL && errorCode == IPDR_OK; pCurrent = pCurrent->pNext_)
+		errorCode = appendListAttributeDescriptorInArena(pFNFData->pArena_,
+						&(pFNFData->pListAttributeDescriptor_), 
+						pCurrent->pAttributeDescriptor_);
+
+	for (pCurrent = pSourceFNFData->pListServiceAttributeDescriptor_; 
+		 pCurrent != NULL && errorCode == IPDR_OK; pCurrent = pCurrent->pNext_)
+		errorCode = appendListAttributeDescriptorInArena(pFNFData->pArena_,
+						&(pFNFData->pListServiceAttributeDescriptor_), 
+						pCurrent->pAttributeDescriptor_);
+
+	if (errorCode == IPDR_OK)
+		errorCode = copyListIPDRDataInArena(pFNFData->pArena_,
+						&(pFNFData->pListIPDRData_), 
+						pSourceFNFData->pListIPDRData_);
+
+	return (errorCode);
+}
+
 /*!
  *  NAME:
  *      freeFNFData() - Memory deallocation of 
@@ -672,10 +767,16 @@ int freeFNFData(FNFData* pFNFData)
 		return (IPDR_NULL_INPUT_PARAMETER);
 	}
 
+	/* Records in an arena are freed with it */
+	if (pFNFData->pArena_ != NULL)
+		return (IPDR_OK);
+
 	free(pFNFData->typeName_);
 	pFNFData->typeName_ = NULL;
 	freeListAttributeDescriptor(&(pFNFData->pListAttributeDescriptor_));
 	pFNFData->pListAttributeDescriptor_ = NULL;
+	freeListAttributeDescriptor(&(pFNFData->pListServiceAttributeDescriptor_));
+	pFNFData->pListServiceAttributeDescriptor_ = NULL;
 	freeListIPDRData(&(pFNFData->pListIPDRData_));
 	pFNFData->pListIPDRData_ = NULL;
 	free (pFNFData);
@@ -857,6 +958,307 @@ int printRecordDescriptor(RecordDescriptor* pRecordDescriptor)
 
 
 
+/*!
+ *  NAME:
+ *      storeIPDRValue() - stores a string, byte array or boolean value
+ *           of a list node
+ *
+ *  DESCRIPTION:
+ *      Values shorter than IPDR_INLINE_VALUE_SIZE are copied into 
+ *      inlineValue, longer ones into a buffer of their own length, 
+ *      taken from the arena if one is given.
+ *	
+ *  ARGUMENTS:
+ *       - pArena {IN/OUT}, NULL to allocate from the heap
+ *       - inlineValue {OUT}
+ *       - pLength {OUT}
+ *       - pCapacity {OUT}, bytes malloc'ed for the value, 0 if none
+ *       - dataValue {IN}
+ *
+ *  RETURNS 	
+ *	     Returns the stored value, NULL if it could not be allocated
+ */
+static void* storeIPDRValue(IPDRArena* pArena, 
+				 char* inlineValue, 
+				 int* pLength, 
+				 int* pCapacity, 
+				 const void* dataValue)
+{
+	size_t length = strlen((const char *) dataValue);
+	char* pValue = inlineValue;
+
+	*pCapacity = 0;
+	if (length >= IPDR_INLINE_VALUE_SIZE) {
+		if (pArena != NULL)
+			pValue = (char *) allocIPDRArena(pArena, length + 1);
+		else
+			pValue = (char *) malloc(length + 1);
+		if (pValue == NULL)
+			return (NULL);
+		if (pArena == NULL)
+			*pCapacity = (int) length + 1;
+	}
+
+	memcpy(pValue, dataValue, length + 1);
+	*pLength = (int) length;
+	return (pValue);
+}
+
+
+/*!
+ *  NAME:
+ *      releaseIPDRValue() - frees a value stored by storeIPDRValue()
+ *
+ *  DESCRIPTION:
+ *      Values held inline in their node are left alone.
+ *	
+ *  ARGUMENTS:
+ *       - pValue {IN/OUT}
+ *       - inlineValue {IN}
+ *
+ *  RETURNS 	
+ *	     Nothing
+ */
+static void releaseIPDRValue(void* pValue, const char* inlineValue)
+{
+	if (pValue != (const void *) inlineValue)
+		free(pValue);
+}
+
+
+/*!
+ *  NAME:
+ *      replaceIPDRValue() - replaces a value stored by storeIPDRValue()
+ *
+ *  DESCRIPTION:
+ *      The bytes are copied into the buffer malloc'ed for the node if
+ *      they fit, into inlineValue if they are short, or else into a
+ *      new buffer of their own length, which replaces the former one.
+ *	
+ *  ARGUMENTS:
+ *       - pValue {IN/OUT}, the value held by the node, NULL if none
+ *       - inlineValue {OUT}
+ *       - pLength {OUT}
+ *       - pCapacity {IN/OUT}
+ *       - dataValue {IN}
+ *       - length {IN}, bytes of dataValue
+ *
+ *  RETURNS 	
+ *	     Returns the stored value, NULL if it could not be allocated,
+ *	     in which case the node keeps its value
+ */
+static void* replaceIPDRValue(void* pValue, 
+				 char* inlineValue, 
+				 int* pLength, 
+				 int* pCapacity, 
+				 const void* dataValue, 
+				 int length)
+{
+	char* pStore = inlineValue;
+
+	if (*pCapacity > length) {
+		pStore = (char *) pValue;
+	} else if (length >= IPDR_INLINE_VALUE_SIZE) {
+		pStore = (char *) malloc(length + 1);
+		if (pStore == NULL)
+			return (NULL);
+		if (*pCapacity > 0)
+			free(pValue);
+		*pCapacity = length + 1;
+	}
+
+	memcpy(pStore, dataValue, length);
+	pStore[length] = '\0';
+	*pLength = length;
+	return (pStore);
+}
+
+
+/*!
+ *  NAME:
+ *      setIPDRNodeValue() - sets the value of a list node in place
+ *
+ *  DESCRIPTION:
+ *      Shared by setListIPDRDataValue() and setListIPDRArrayDataValue(),
+ *      which pass the fields of their node.
+ *	
+ *  ARGUMENTS:
+ *       - pDataType {IN/OUT}
+ *       - pDataUnion {IN/OUT}
+ *       - inlineValue {OUT}
+ *       - pLength {OUT}
+ *       - pCapacity {IN/OUT}
+ *       - dataValue {IN}
+ *       - length {IN}
+ *       - dataType {IN}
+ *
+ *  RETURNS 	
+ *	     Returns Zero or appropriate error code
+ */
+static int setIPDRNodeValue(int* pDataType, 
+				 IPDRDataUnion* pDataUnion, 
+				 char* inlineValue, 
+				 int* pLength, 
+				 int* pCapacity, 
+				 void* dataValue, 
+				 int length, 
+				 int dataType)
+{
+	void* pValue = NULL;
+	IPDRDataUnion dataUnion;
+
+	if (*pDataType == IPDRDATA_HEXADECARRAY || *pDataType == IPDRDATA_STRING ||
+		*pDataType == IPDRDATA_BOOLEAN)
+		pValue = (void *) pDataUnion->IPDRByteArray_;
+
+	switch (dataType)
+	{
+	case IPDRDATA_HEXADECARRAY:
+	case IPDRDATA_STRING:
+	case IPDRDATA_BOOLEAN:
+		if (dataValue == NULL)
+			return (IPDR_NULL_INPUT_PARAMETER);
+		if (length < 0)
+			length = strlen((const char *) dataValue);
+		pValue = replaceIPDRValue(pValue, inlineValue, pLength, pCapacity, 
+				dataValue, length);
+		if (pValue == NULL)
+			return (IPDR_MEMORY_ALLOCATION_FAILED);
+		if (dataType == IPDRDATA_HEXADECARRAY)
+			pDataUnion->IPDRByteArray_ = (byte *) pValue;
+		else if (dataType == IPDRDATA_STRING)
+			pDataUnion->IPDRUTF8Array_ = (wchar *) pValue;
+		else
+			pDataUnion->IPDRBoolean_ = (bool *) pValue;
+		break;
+
+	default:
+		switch (dataType)
+		{
+		case IPDRDATA_LONG:
+			dataUnion.IPDRLong_ = (int) dataValue;
+			break;
+		case IPDRDATA_ULONG:
+			dataUnion.IPDRULong_ = (unsigned int) dataValue;
+			break;
+		case IPDRDATA_LONGLONG:
+			dataUnion.IPDRLongLong_ = *((hyper *) dataValue);
+			break;
+		case IPDRDATA_ULONGLONG:
+			dataUnion.IPDRULongLong_ = *((unsigned hyper *) dataValue);
+			break;
+		case IPDRDATA_FLOAT:
+			dataUnion.IPDRFloat_ = *((float *) dataValue);
+			break;
+		case IPDRDATA_DOUBLE:
+			dataUnion.IPDRDouble_ = *((double *) dataValue);
+			break;
+		case IPDRDATA_SHORT:
+			dataUnion.IPDRShort_ = (int) dataValue;
+			break;
+		case IPDRDATA_USHORT:
+			dataUnion.IPDRUShort_ = (unsigned int) dataValue;
+			break;
+		case IPDRDATA_BYTE:
+		case IPDRDATA_UBYTE:
+			dataUnion.IPDRByte_ = (int) dataValue;
+			break;
+		default:
+			return (IPDR_NON_PRIMITIVE_DATA_TYPE);
+		}
+		if (*pCapacity > 0) {
+			free(pValue);
+			*pCapacity = 0;
+		}
+		*pDataUnion = dataUnion;
+		break;
+	}
+
+	*pDataType = dataType;
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      setListIPDRDataValue() - sets the value of an IPDRData list node
+ *
+ *  DESCRIPTION:
+ *      1. dataValue is passed as to appendListIPDRData(). 
+ *      2. A string, byte array or boolean value reuses the buffer
+ *         of the value it replaces if it fits, so a node set again
+ *         with values no longer than before allocates nothing.
+ *      3. The node must be on the heap and hold a primitive value
+ *         or none; an array held by it is freed.
+ *	
+ *  ARGUMENTS:
+ *       - pListIPDRData {IN/OUT}
+ *       - dataValue {IN}
+ *       - length {IN}, bytes of a string, byte array or boolean
+ *         value, -1 if it is terminated
+ *       - dataType {IN}
+ *
+ *  RETURNS 	
+ *	     Returns Zero or appropriate error code
+ */
+int setListIPDRDataValue(ListIPDRData* pListIPDRData, 
+				 void* dataValue, 
+				 int length, 
+				 int dataType)
+{
+	if (pListIPDRData == NULL) {
+		return (IPDR_NULL_INPUT_PARAMETER);
+	}
+
+	if (pListIPDRData->IPDRDataType_ == IPDRDATA_ARRAY) {
+		freeListIPDRArrayData(&(pListIPDRData->pListIPDRArrayData_));
+		pListIPDRData->pListIPDRArrayData_ = NULL;
+		pListIPDRData->noOfElements_ = 0;
+		pListIPDRData->IPDRDataType_ = IPDRDATA_LONG;
+		pListIPDRData->IPDRDataUnion_.IPDRLong_ = 0;
+	}
+
+	return (setIPDRNodeValue(&pListIPDRData->IPDRDataType_, 
+				&pListIPDRData->IPDRDataUnion_, pListIPDRData->inlineValue_, 
+				&pListIPDRData->length_, &pListIPDRData->capacity_, 
+				dataValue, length, dataType));
+}
+
+
+/*!
+ *  NAME:
+ *      setListIPDRArrayDataValue() - sets the value of an array 
+ *           element node
+ *
+ *  DESCRIPTION:
+ *      As setListIPDRDataValue(), for the elements of an array.
+ *	
+ *  ARGUMENTS:
+ *       - pListIPDRArrayData {IN/OUT}
+ *       - dataValue {IN}
+ *       - length {IN}
+ *       - dataType {IN}
+ *
+ *  RETURNS 	
+ *	     Returns Zero or appropriate error code
+ */
+int setListIPDRArrayDataValue(ListIPDRArrayData* pListIPDRArrayData, 
+				 void* dataValue, 
+				 int length, 
+				 int dataType)
+{
+	if (pListIPDRArrayData == NULL) {
+		return (IPDR_NULL_INPUT_PARAMETER);
+	}
+
+	return (setIPDRNodeValue(&pListIPDRArrayData->IPDRDataType_, 
+				&pListIPDRArrayData->IPDRDataUnion_, pListIPDRArrayData->inlineValue_, 
+				&pListIPDRArrayData->length_, &pListIPDRArrayData->capacity_, 
+				dataValue, length, dataType));
+}
+
+
+
 /*!
  *  NAME:
  *      addListIPDRData() - adds node to the 
@@ -931,27 +1333,21 @@ int addListIPDRData(ListIPDRData** pHeadRef,
 		break;
 
 	case IPDRDATA_HEXADECARRAY:
-		pListIPDRData->IPDRDataUnion_.IPDRByteArray_ = 
-			(byte *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *)pListIPDRData->IPDRDataUnion_.IPDRByteArray_, 
-			dataValue);
+		pListIPDRData->IPDRDataUnion_.IPDRByteArray_ = (byte *) 
+			storeIPDRValue(NULL, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue);
 		pListIPDRData->IPDRDataType_ = dataType;
 		break;
 
 
 	case IPDRDATA_STRING:
-		pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_ = 
-		(wchar *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *) pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_, 
-		dataValue);
+		pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_ = (wchar *) 
+			storeIPDRValue(NULL, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue);
 		pListIPDRData->IPDRDataType_ = dataType;
 		break;
 
 	case IPDRDATA_BOOLEAN:
-		pListIPDRData->IPDRDataUnion_.IPDRBoolean_ = 
-		(char *)calloc(1, sizeof(char));
-		strcpy((char *) pListIPDRData->IPDRDataUnion_.IPDRBoolean_, 
-		dataValue);
+		pListIPDRData->IPDRDataUnion_.IPDRBoolean_ = (bool *) 
+			storeIPDRValue(NULL, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue);
 		pListIPDRData->IPDRDataType_ = dataType;
 		break;
 
@@ -1061,27 +1457,21 @@ int appendListIPDRData(struct ListIPDRData** pHeadRef,
 		break;
 
 	case IPDRDATA_HEXADECARRAY:
-		pListIPDRData->IPDRDataUnion_.IPDRByteArray_ = 
-			(byte *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *)pListIPDRData->IPDRDataUnion_.IPDRByteArray_, 
-			dataValue);
+		pListIPDRData->IPDRDataUnion_.IPDRByteArray_ = (byte *) 
+			storeIPDRValue(NULL, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue);
 		pListIPDRData->IPDRDataType_ = dataType;
 		break;
 
 
 	case IPDRDATA_STRING:
-		pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_ = 
-		(wchar *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *) pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_, 
-		dataValue);
+		pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_ = (wchar *) 
+			storeIPDRValue(NULL, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue);
 		pListIPDRData->IPDRDataType_ = dataType;
 		break;
 
 	case IPDRDATA_BOOLEAN:
-		pListIPDRData->IPDRDataUnion_.IPDRBoolean_ = 
-		(char *)calloc(3, sizeof(char));
-		strcpy((char *) pListIPDRData->IPDRDataUnion_.IPDRBoolean_, 
-		dataValue);
+		pListIPDRData->IPDRDataUnion_.IPDRBoolean_ = (bool *) 
+			storeIPDRValue(NULL, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue);
 		pListIPDRData->IPDRDataType_ = dataType;
 		break;
 
@@ -1163,27 +1553,21 @@ int appendListIPDRData(struct ListIPDRData** pHeadRef,
 		break;
 
 	case IPDRDATA_HEXADECARRAY:
-		pListIPDRData->IPDRDataUnion_.IPDRByteArray_ = 
-			(byte *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *) pListIPDRData->IPDRDataUnion_.IPDRByteArray_, 
-			dataValue);
+		pListIPDRData->IPDRDataUnion_.IPDRByteArray_ = (byte *) 
+			storeIPDRValue(NULL, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue);
 		pListIPDRData->IPDRDataType_ = dataType;
 		break;
 
 
 	case IPDRDATA_STRING:
-		pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_ = 
-		(wchar *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *) pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_, 
-		dataValue);
+		pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_ = (wchar *) 
+			storeIPDRValue(NULL, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue);
 		pListIPDRData->IPDRDataType_ = dataType;
 		break;
 
 	case IPDRDATA_BOOLEAN:
-		pListIPDRData->IPDRDataUnion_.IPDRBoolean_ = 
-		(char *)calloc(3, sizeof(char));
-		strcpy((char *) pListIPDRData->IPDRDataUnion_.IPDRBoolean_, 
-		dataValue);
+		pListIPDRData->IPDRDataUnion_.IPDRBoolean_ = (bool *) 
+			storeIPDRValue(NULL, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue);
 		pListIPDRData->IPDRDataType_ = dataType;
 		break;
 
@@ -1217,6 +1601,204 @@ int appendListIPDRData(struct ListIPDRData** pHeadRef,
 	return (IPDR_OK);
 }
 
+/*!
+ *  NAME:
+ *      appendListIPDRDataInArena() - appends node to the 
+ *           ListIPDRData list from an arena
+ *
+ *  DESCRIPTION:
+ *      1. Same as appendListIPDRData(), with the node and the string,
+ *         byte array and boolean values too long to be held in the
+ *         node allocated from the arena.
+ *	
+ *  ARGUMENTS:
+ *       - pArena {IN/OUT}, NULL to allocate from the heap
+ *       - pHeadRef, pointer to ListIPDRData {IN/OUT}
+ *       - dataValue {IN}
+ *       - dataType {IN}
+ *
+ *  RETURNS 	
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+int appendListIPDRDataInArena(IPDRArena* pArena,
+				 ListIPDRData** pHeadRef, 
+	 			 void* dataValue,
+				 int dataType
+) 
+{
+	ListIPDRData* pListIPDRData = NULL;
+	ListIPDRData* pCurrent = NULL;
+
+	if (pArena == NULL)
+		return (appendListIPDRData(pHeadRef, dataValue, dataType));
+
+	if (pHeadRef == NULL) {
+		return (IPDR_NULL_INPUT_PARAMETER);
+	}
+
+	if (dataValue == NULL && (dataType == IPDRDATA_HEXADECARRAY ||
+		dataType == IPDRDATA_STRING || dataType == IPDRDATA_BOOLEAN)) {
+		return (IPDR_NULL_INPUT_PARAMETER);
+	}
+
+	pListIPDRData = (ListIPDRData *) allocIPDRArena(pArena, sizeof(ListIPDRData));
+	if (pListIPDRData == NULL) {
+		return (IPDR_MEMORY_ALLOCATION_FAILED);
+	}
+
+	switch (dataType)
+	{
+	case IPDRDATA_LONG:
+		pListIPDRData->IPDRDataUnion_.IPDRLong_ = (int)dataValue;
+		break;
+
+	case IPDRDATA_ULONG:
+		pListIPDRData->IPDRDataUnion_.IPDRULong_ = (unsigned int)dataValue;
+		break;
+
+	case IPDRDATA_LONGLONG:
+		pListIPDRData->IPDRDataUnion_.IPDRLongLong_ = *((hyper *)dataValue);
+		break;
+
+	case IPDRDATA_ULONGLONG:
+		pListIPDRData->IPDRDataUnion_.IPDRULongLong_ = *((unsigned hyper *)dataValue);
+		break;
+
+	case IPDRDATA_FLOAT:
+		pListIPDRData->IPDRDataUnion_.IPDRFloat_ = *((float *) dataValue);
+		break;
+
+	case IPDRDATA_DOUBLE:
+		pListIPDRData->IPDRDataUnion_.IPDRDouble_ = *((double *) dataValue);
+		break;
+
+	case IPDRDATA_HEXADECARRAY:
+		pListIPDRData->IPDRDataUnion_.IPDRByteArray_ = (byte *) storeIPDRValue(
+			pArena, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue);
+		if (pListIPDRData->IPDRDataUnion_.IPDRByteArray_ == NULL)
+			return (IPDR_MEMORY_ALLOCATION_FAILED);
+		break;
+
+	case IPDRDATA_STRING:
+		pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_ = (wchar *) storeIPDRValue(
+			pArena, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue);
+		if (pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_ == NULL)
+			return (IPDR_MEMORY_ALLOCATION_FAILED);
+		break;
+
+	case IPDRDATA_BOOLEAN:
+		pListIPDRData->IPDRDataUnion_.IPDRBoolean_ = (bool *) storeIPDRValue(
+			pArena, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue);
+		if (pListIPDRData->IPDRDataUnion_.IPDRBoolean_ == NULL)
+			return (IPDR_MEMORY_ALLOCATION_FAILED);
+		break;
+
+	case IPDRDATA_SHORT:
+		pListIPDRData->IPDRDataUnion_.IPDRShort_ = (int) dataValue;
+		break;
+
+	case IPDRDATA_USHORT:
+		pListIPDRData->IPDRDataUnion_.IPDRUShort_ = (unsigned int) dataValue;
+		break;
+
+	case IPDRDATA_BYTE:
+	case IPDRDATA_UBYTE:
+		pListIPDRData->IPDRDataUnion_.IPDRByte_ = (int)dataValue;
+		break;
+
+	default:
+		dataType = 0;
+		break;
+	}
+	pListIPDRData->IPDRDataType_ = dataType;
+
+	if (*pHeadRef == NULL) {
+		*pHeadRef = pListIPDRData;
+	} else {
+		for (pCurrent = *pHeadRef; pCurrent->pNext_ != NULL; pCurrent = pCurrent->pNext_)
+			;
+		pCurrent->pNext_ = pListIPDRData;
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      copyListIPDRDataInArena() - appends copies of the nodes of a 
+ *           ListIPDRData list from an arena
+ *
+ *  DESCRIPTION:
+ *      1. The nodes and their string, byte array and boolean values
+ *         are copied into the arena. The elements of arrays and 
+ *         structures are shared with the source list, as 
+ *         appendListArrayToIPDRData() shares them.
+ *	
+ *  ARGUMENTS:
+ *       - pArena {IN/OUT}
+ *       - pHeadRef, pointer to ListIPDRData {IN/OUT}
+ *       - pListIPDRData {IN}
+ *
+ *  RETURNS 	
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+int copyListIPDRDataInArena(IPDRArena* pArena,
+				 ListIPDRData** pHeadRef, 
+				 const ListIPDRData* pListIPDRData
+) 
+{
+	ListIPDRData* pCopy = NULL;
+	ListIPDRData** ppTail = pHeadRef;
+	char* pValue = NULL;
+
+	if (pArena == NULL || pHeadRef == NULL) {
+		return (IPDR_NULL_INPUT_PARAMETER);
+	}
+
+	while (*ppTail != NULL)
+		ppTail = &((*ppTail)->pNext_);
+
+	for (; pListIPDRData != NULL; pListIPDRData = pListIPDRData->pNext_) {
+		pCopy = (ListIPDRData *) allocIPDRArena(pArena, sizeof(ListIPDRData));
+		if (pCopy == NULL) {
+			return (IPDR_MEMORY_ALLOCATION_FAILED);
+		}
+		*pCopy = *pListIPDRData;
+		pCopy->pNext_ = NULL;
+
+		pValue = NULL;
+		if (pListIPDRData->IPDRDataType_ == IPDRDATA_HEXADECARRAY)
+			pValue = (char *) pListIPDRData->IPDRDataUnion_.IPDRByteArray_;
+		else if (pListIPDRData->IPDRDataType_ == IPDRDATA_STRING)
+			pValue = (char *) pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_;
+		else if (pListIPDRData->IPDRDataType_ == IPDRDATA_BOOLEAN)
+			pValue = (char *) pListIPDRData->IPDRDataUnion_.IPDRBoolean_;
+
+		if (pValue != NULL) {
+			pValue = (char *) storeIPDRValue(pArena, pCopy->inlineValue_, 
+				&pCopy->length_, &pCopy->capacity_, pValue);
+			if (pValue == NULL) {
+				return (IPDR_MEMORY_ALLOCATION_FAILED);
+			}
+			if (pListIPDRData->IPDRDataType_ == IPDRDATA_HEXADECARRAY)
+				pCopy->IPDRDataUnion_.IPDRByteArray_ = (byte *) pValue;
+			else if (pListIPDRData->IPDRDataType_ == IPDRDATA_STRING)
+				pCopy->IPDRDataUnion_.IPDRUTF8Array_ = (wchar *) pValue;
+			else
+				pCopy->IPDRDataUnion_.IPDRBoolean_ = (bool *) pValue;
+		}
+
+		*ppTail = pCopy;
+		ppTail = &(pCopy->pNext_);
+	}
+
+	return (IPDR_OK);
+}
+
+
 int appendListArrayToIPDRData(struct ListIPDRData** pHeadRef, 
 				 struct ListIPDRArrayData *pListIPDRArrayData,
 				 int noOfElements,
@@ -1418,19 +2000,15 @@ int appendListIPDRDataComplex(struct ListIPDRData** pHeadRef,
 		break;
 
 	case IPDRDATA_HEXADECARRAY:
-		pListIPDRData->IPDRDataUnion_.IPDRByteArray_ = 
-			(byte *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *)pListIPDRData->IPDRDataUnion_.IPDRByteArray_, 
-			dataValue[0]);
+		pListIPDRData->IPDRDataUnion_.IPDRByteArray_ = (byte *) 
+			storeIPDRValue(NULL, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue[0]);
 		pListIPDRData->IPDRDataType_ = dataType[0];
 		break;
 
 
 	case IPDRDATA_STRING:
-		pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_ = 
-		(wchar *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *) pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_, 
-		dataValue[0]);
+		pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_ = (wchar *) 
+			storeIPDRValue(NULL, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue[0]);
 		pListIPDRData->IPDRDataType_ = dataType[0];
 		break;
 
@@ -1453,10 +2031,8 @@ int appendListIPDRDataComplex(struct ListIPDRData** pHeadRef,
 		break;
 
 	case IPDRDATA_BOOLEAN:
-		pListIPDRData->IPDRDataUnion_.IPDRBoolean_ = 
-		(char *)calloc(1, sizeof(char));
-		strcpy((char *) pListIPDRData->IPDRDataUnion_.IPDRBoolean_, 
-		dataValue[0]);
+		pListIPDRData->IPDRDataUnion_.IPDRBoolean_ = (bool *) 
+			storeIPDRValue(NULL, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue[0]);
 		pListIPDRData->IPDRDataType_ = dataType[0];
 		break;
 
@@ -1542,27 +2118,21 @@ int appendListIPDRDataComplex(struct ListIPDRData** pHeadRef,
 		break;
 
 	case IPDRDATA_HEXADECARRAY:
-		pListIPDRData->IPDRDataUnion_.IPDRByteArray_ = 
-			(byte *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *) pListIPDRData->IPDRDataUnion_.IPDRByteArray_, 
-			dataValue[0]);
+		pListIPDRData->IPDRDataUnion_.IPDRByteArray_ = (byte *) 
+			storeIPDRValue(NULL, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue[0]);
 		pListIPDRData->IPDRDataType_ = dataType[0];
 		break;
 
 
 	case IPDRDATA_STRING:
-		pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_ = 
-		(wchar *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *) pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_, 
-		dataValue[0]);
+		pListIPDRData->IPDRDataUnion_.IPDRUTF8Array_ = (wchar *) 
+			storeIPDRValue(NULL, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue[0]);
 		pListIPDRData->IPDRDataType_ = dataType[0];
 		break;
 
 	case IPDRDATA_BOOLEAN:
-		pListIPDRData->IPDRDataUnion_.IPDRBoolean_ = 
-		(char *)calloc(1, sizeof(char));
-		strcpy((char *) pListIPDRData->IPDRDataUnion_.IPDRBoolean_, 
-		dataValue[0]);
+		pListIPDRData->IPDRDataUnion_.IPDRBoolean_ = (bool *) 
+			storeIPDRValue(NULL, pListIPDRData->inlineValue_, &pListIPDRData->length_, &pListIPDRData->capacity_, dataValue[0]);
 		pListIPDRData->IPDRDataType_ = dataType[0];
 		break;
 
@@ -1952,27 +2522,21 @@ int appendListIPDRArrayData(struct ListIPDRArrayData** pHeadRef,
 		break;
 
 	case IPDRDATA_HEXADECARRAY:
-		pListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_ = 
-			(byte *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *)pListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_, 
-			dataValue);
+		pListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_ = (byte *) 
+			storeIPDRValue(NULL, pListIPDRArrayData->inlineValue_, &pListIPDRArrayData->length_, &pListIPDRArrayData->capacity_, dataValue);
 		pListIPDRArrayData->IPDRDataType_ = dataType;
 		break;
 
 
 	case IPDRDATA_STRING:
-		pListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_ = 
-		(wchar *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *) pListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_, 
-		dataValue);
+		pListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_ = (wchar *) 
+			storeIPDRValue(NULL, pListIPDRArrayData->inlineValue_, &pListIPDRArrayData->length_, &pListIPDRArrayData->capacity_, dataValue);
 		pListIPDRArrayData->IPDRDataType_ = dataType;
 		break;
 
 	case IPDRDATA_BOOLEAN:
-		pListIPDRArrayData->IPDRDataUnion_.IPDRBoolean_ = 
-			(bool *)calloc(1, sizeof(char));
-		strcpy((char *)pListIPDRArrayData->IPDRDataUnion_.IPDRBoolean_, 
-			dataValue);
+		pListIPDRArrayData->IPDRDataUnion_.IPDRBoolean_ = (bool *) 
+			storeIPDRValue(NULL, pListIPDRArrayData->inlineValue_, &pListIPDRArrayData->length_, &pListIPDRArrayData->capacity_, dataValue);
 		pListIPDRArrayData->IPDRDataType_ = dataType;
 		break;
 
@@ -2046,27 +2610,21 @@ int appendListIPDRArrayData(struct ListIPDRArrayData** pHeadRef,
 		break;
 
 	case IPDRDATA_HEXADECARRAY:
-		pListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_ = 
-			(byte *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *) pListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_, 
-			dataValue);
+		pListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_ = (byte *) 
+			storeIPDRValue(NULL, pListIPDRArrayData->inlineValue_, &pListIPDRArrayData->length_, &pListIPDRArrayData->capacity_, dataValue);
 		pListIPDRArrayData->IPDRDataType_ = dataType;
 		break;
 
 
 	case IPDRDATA_STRING:
-		pListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_ = 
-		(wchar *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *) pListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_, 
-		dataValue);
+		pListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_ = (wchar *) 
+			storeIPDRValue(NULL, pListIPDRArrayData->inlineValue_, &pListIPDRArrayData->length_, &pListIPDRArrayData->capacity_, dataValue);
 		pListIPDRArrayData->IPDRDataType_ = dataType;
 		break;
 
 	case IPDRDATA_BOOLEAN:
-		pListIPDRArrayData->IPDRDataUnion_.IPDRBoolean_ = 
-			(bool *)calloc(1, sizeof(char));
-		strcpy((char *)pListIPDRArrayData->IPDRDataUnion_.IPDRBoolean_, 
-			dataValue);
+		pListIPDRArrayData->IPDRDataUnion_.IPDRBoolean_ = (bool *) 
+			storeIPDRValue(NULL, pListIPDRArrayData->inlineValue_, &pListIPDRArrayData->length_, &pListIPDRArrayData->capacity_, dataValue);
 		pListIPDRArrayData->IPDRDataType_ = dataType;
 		break;
 
@@ -2387,27 +2945,21 @@ int appendListIPDRArrayDataToComplexData(struct ListIPDRArrayData** pHeadRef,
 		break;
 
 	case IPDRDATA_HEXADECARRAY:
-		pListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_ = 
-			(byte *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *)pListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_, 
-			ipdrDataUnion.IPDRByteArray_);
+		pListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_ = (byte *) 
+			storeIPDRValue(NULL, pListIPDRArrayData->inlineValue_, &pListIPDRArrayData->length_, &pListIPDRArrayData->capacity_, ipdrDataUnion.IPDRByteArray_);
 		pListIPDRArrayData->IPDRDataType_ = dataType;
 		break;
 
 
 	case IPDRDATA_STRING:
-		pListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_ = 
-		(wchar *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *) pListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_, 
-		(char *)ipdrDataUnion.IPDRUTF8Array_);
+		pListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_ = (wchar *) 
+			storeIPDRValue(NULL, pListIPDRArrayData->inlineValue_, &pListIPDRArrayData->length_, &pListIPDRArrayData->capacity_, (char *)ipdrDataUnion.IPDRUTF8Array_);
 		pListIPDRArrayData->IPDRDataType_ = dataType;
 		break;
 
 	case IPDRDATA_BOOLEAN:
-		pListIPDRArrayData->IPDRDataUnion_.IPDRBoolean_ = 
-			(bool *)calloc(1, sizeof(char));
-		strcpy((char *)pListIPDRArrayData->IPDRDataUnion_.IPDRBoolean_, 
-			ipdrDataUnion.IPDRBoolean_);
+		pListIPDRArrayData->IPDRDataUnion_.IPDRBoolean_ = (bool *) 
+			storeIPDRValue(NULL, pListIPDRArrayData->inlineValue_, &pListIPDRArrayData->length_, &pListIPDRArrayData->capacity_, ipdrDataUnion.IPDRBoolean_);
 		pListIPDRArrayData->IPDRDataType_ = dataType;
 		break;
 
@@ -2472,27 +3024,21 @@ int appendListIPDRArrayDataToComplexData(struct ListIPDRArrayData** pHeadRef,
 		break;
 
 	case IPDRDATA_HEXADECARRAY:
-		pListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_ = 
-			(byte *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *)pListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_, 
-			ipdrDataUnion.IPDRByteArray_);
+		pListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_ = (byte *) 
+			storeIPDRValue(NULL, pListIPDRArrayData->inlineValue_, &pListIPDRArrayData->length_, &pListIPDRArrayData->capacity_, ipdrDataUnion.IPDRByteArray_);
 		pListIPDRArrayData->IPDRDataType_ = dataType;
 		break;
 
 
 	case IPDRDATA_STRING:
-		pListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_ = 
-		(wchar *)calloc(MAX_IPDR_STRING, sizeof(char));
-		strcpy((char *) pListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_, 
-		(char *)ipdrDataUnion.IPDRUTF8Array_);
+		pListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_ = (wchar *) 
+			storeIPDRValue(NULL, pListIPDRArrayData->inlineValue_, &pListIPDRArrayData->length_, &pListIPDRArrayData->capacity_, (char *)ipdrDataUnion.IPDRUTF8Array_);
 		pListIPDRArrayData->IPDRDataType_ = dataType;
 		break;
 
 	case IPDRDATA_BOOLEAN:
-		pListIPDRArrayData->IPDRDataUnion_.IPDRBoolean_ = 
-			(bool *)calloc(1, sizeof(char));
-		strcpy((char *)pListIPDRArrayData->IPDRDataUnion_.IPDRBoolean_, 
-			ipdrDataUnion.IPDRBoolean_);
+		pListIPDRArrayData->IPDRDataUnion_.IPDRBoolean_ = (bool *) 
+			storeIPDRValue(NULL, pListIPDRArrayData->inlineValue_, &pListIPDRArrayData->length_, &pListIPDRArrayData->capacity_, ipdrDataUnion.IPDRBoolean_);
 		pListIPDRArrayData->IPDRDataType_ = dataType;
 		break;
 
@@ -2548,10 +3094,12 @@ int freeListIPDRData(ListIPDRData** pHeadRef)
         pNext = pCurrent->pNext_;
 		
 		if (pCurrent->IPDRDataType_ == IPDRDATA_HEXADECARRAY)
-			free(pCurrent->IPDRDataUnion_.IPDRByteArray_);  
+			releaseIPDRValue(pCurrent->IPDRDataUnion_.IPDRByteArray_, 
+				pCurrent->inlineValue_);  
 
 		if ((pCurrent->IPDRDataType_ == IPDRDATA_STRING) || (pCurrent->IPDRDataType_ == 0)) {
-			free(pCurrent->IPDRDataUnion_.IPDRUTF8Array_);  
+			releaseIPDRValue(pCurrent->IPDRDataUnion_.IPDRUTF8Array_, 
+				pCurrent->inlineValue_);  
 		}
   
 		if(pCurrent->IPDRDataType_ != 0) 
@@ -2604,9 +3152,11 @@ int freeListNodeIPDRData(ListIPDRData** pHeadRef, int node)
     }
 
 	if (pCurrent->IPDRDataType_ == IPDRDATA_HEXADECARRAY)
-		free(pCurrent->IPDRDataUnion_.IPDRByteArray_);  
+		releaseIPDRValue(pCurrent->IPDRDataUnion_.IPDRByteArray_, 
+			pCurrent->inlineValue_);  
 	if (pCurrent->IPDRDataType_ == IPDRDATA_STRING) 
-		free(pCurrent->IPDRDataUnion_.IPDRUTF8Array_);  
+		releaseIPDRValue(pCurrent->IPDRDataUnion_.IPDRUTF8Array_, 
+			pCurrent->inlineValue_);  
 			
 	free(pCurrent);
 
@@ -2916,13 +3466,32 @@ IPDRCommonParameters* newIPDRCommonParameters(void)
 	IPDRCommonParameters* pIPDRCommonParameters;
 	pIPDRCommonParameters = (IPDRCommonParameters *) 
 		calloc(1, sizeof(IPDRCommonParameters));
-	pIPDRCommonParameters->pDescriptorLookupHashTable_ = NULL;
+	pIPDRCommonParameters->pDescriptorLookupMap_ = NULL;
 	pIPDRCommonParameters->pDescriptorLookupList_ = NULL;
 	pIPDRCommonParameters->pListErrorStructure_ = NULL;
 	pIPDRCommonParameters->pSchema_ = newSchema();
 	pIPDRCommonParameters->pExceptionStructure_ = newExceptionStructure();
 	pIPDRCommonParameters->pListFNFData_ = NULL;
 	pIPDRCommonParameters->pDocEnd_ = newDocEnd();
+	pIPDRCommonParameters->pOutputBuffer_ = NULL;
+	pIPDRCommonParameters->pInputBuffer_ = NULL;
+	pIPDRCommonParameters->ppDescriptorCache_ = NULL;
+	pIPDRCommonParameters->pDescriptorFingerprints_ = NULL;
+	pIPDRCommonParameters->ppCodecPlans_ = NULL;
+	pIPDRCommonParameters->useCodecPlans_ = IPDR_TRUE;
+	pIPDRCommonParameters->descriptorCacheSize_ = 0;
+	pIPDRCommonParameters->pXMLTemplateMap_ = NULL;
+	pIPDRCommonParameters->pXMLTemplateIDMap_ = NULL;
+	pIPDRCommonParameters->pXMLTypeCache_ = NULL;
+	pIPDRCommonParameters->pValidatorMap_ = NULL;
+	pIPDRCommonParameters->pValidationMemo_ = NULL;
+	pIPDRCommonParameters->pProjection_ = NULL;
+	pIPDRCommonParameters->pXMLStreamReader_ = NULL;
+	pIPDRCommonParameters->pListServiceAttributeDescriptor_ = NULL;
+	pIPDRCommonParameters->compositeDescriptorFlag_ = 0;
+	pIPDRCommonParameters->xmlArrayFound_ = 0;
+	pIPDRCommonParameters->xmlComplexArrayFound_ = 0;
+	pIPDRCommonParameters->readGeneration_ = nextIPDRReadGeneration();
 	return (pIPDRCommonParameters);
 }
 
@@ -2991,8 +3560,8 @@ int initIPDRCommonParameters(
 	pIPDRCommonParameters->DocState_ = docState;
 	pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_ = 
 		(long) ipdrCount;
-	pIPDRCommonParameters->pDescriptorLookupHashTable_ = 
-		HashTableCreate(noOfBuckets);
+	pIPDRCommonParameters->pDescriptorLookupMap_ = 
+		newIPDRIntMap(noOfBuckets, free);
 	pIPDRCommonParameters->pDescriptorLookupList_ = 
 		ListAttributeDescriptor;
 	pIPDRCommonParameters->descriptorCount_ = descriptorCount;
@@ -3021,10 +3590,62 @@ int initIPDRCommonParameters(
 int freeIPDRCommonParameters(
 			IPDRCommonParameters* pIPDRCommonParameters)
 {
+	int errorCode = 0;
+	int count = 0;
+
 	if (pIPDRCommonParameters == NULL) {
 		return (IPDR_NULL_INPUT_PARAMETER);
 	}
 	
+	/* What a NONWRITABLE document still buffers is part of a failed record */
+	if (pIPDRCommonParameters->pOutputBuffer_ != NULL) {
+		if (pIPDRCommonParameters->pStreamHandle_ != NULL &&
+			pIPDRCommonParameters->DocState_ != NONWRITABLE)
+			flushXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_,
+								 &errorCode);
+		freeXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_);
+		pIPDRCommonParameters->pOutputBuffer_ = NULL;
+	}
+
+	if (pIPDRCommonParameters->pInputBuffer_ != NULL) {
+		freeXDRInputBuffer(pIPDRCommonParameters->pInputBuffer_);
+		pIPDRCommonParameters->pInputBuffer_ = NULL;
+	}
+
+	for (count = 0; count < pIPDRCommonParameters->descriptorCacheSize_; count++) {
+		if (pIPDRCommonParameters->ppDescriptorCache_[count] != NULL)
+			freeRecordDescriptor(pIPDRCommonParameters->ppDescriptorCache_[count]);
+		if (pIPDRCommonParameters->ppCodecPlans_[count] != NULL)
+			freeXDRCodecPlan(pIPDRCommonParameters->ppCodecPlans_[count]);
+	}
+	free(pIPDRCommonParameters->ppDescriptorCache_);
+	pIPDRCommonParameters->ppDescriptorCache_ = NULL;
+	free(pIPDRCommonParameters->pDescriptorFingerprints_);
+	pIPDRCommonParameters->pDescriptorFingerprints_ = NULL;
+	free(pIPDRCommonParameters->ppCodecPlans_);
+	pIPDRCommonParameters->ppCodecPlans_ = NULL;
+	pIPDRCommonParameters->descriptorCacheSize_ = 0;
+
+	freeIPDRIntMap(pIPDRCommonParameters->pXMLTemplateIDMap_);
+	pIPDRCommonParameters->pXMLTemplateIDMap_ = NULL;
+	freeIPDRIntMap(pIPDRCommonParameters->pXMLTemplateMap_);
+	pIPDRCommonParameters->pXMLTemplateMap_ = NULL;
+	freeIPDRIntMap(pIPDRCommonParameters->pXMLTypeCache_);
+	pIPDRCommonParameters->pXMLTypeCache_ = NULL;
+	freeIPDRIntMap(pIPDRCommonParameters->pValidatorMap_);
+	pIPDRCommonParameters->pValidatorMap_ = NULL;
+	freeIPDRIntMap(pIPDRCommonParameters->pValidationMemo_);
+	pIPDRCommonParameters->pValidationMemo_ = NULL;
+	freeIPDRStringMap(pIPDRCommonParameters->pProjection_);
+	pIPDRCommonParameters->pProjection_ = NULL;
+
+	freeXMLStreamReader(pIPDRCommonParameters->pXMLStreamReader_);
+	pIPDRCommonParameters->pXMLStreamReader_ = NULL;
+
+	freeListAttributeDescriptor(
+		&pIPDRCommonParameters->pListServiceAttributeDescriptor_);
+	pIPDRCommonParameters->pListServiceAttributeDescriptor_ = NULL;
+
 	if (pIPDRCommonParameters->pStreamHandle_ != NULL)
 	fclose(pIPDRCommonParameters->pStreamHandle_);
 	
@@ -3034,12 +3655,15 @@ int freeIPDRCommonParameters(
 	
 	freeListAttributeDescriptor(
 		&pIPDRCommonParameters->pDescriptorLookupList_);
-	freeSchemaData(pIPDRCommonParameters->pSchema_);
+	if (pIPDRCommonParameters->pSchema_->shared_ == IPDR_TRUE)
+		releaseSchemaData(pIPDRCommonParameters->pSchema_);
+	else
+		freeSchemaData(pIPDRCommonParameters->pSchema_);
 	
 	free(pIPDRCommonParameters->pExceptionStructure_->errorMessage_);
 	free(pIPDRCommonParameters->pExceptionStructure_);
 	
-	HashTableDestroy(pIPDRCommonParameters->pDescriptorLookupHashTable_);  
+	freeIPDRIntMap(pIPDRCommonParameters->pDescriptorLookupMap_);  
 
 	freeDocEnd(pIPDRCommonParameters->pDocEnd_);
 	
@@ -3803,6 +4427,8 @@ int freeAttributeDescriptor(AttributeDescriptor* pAttributeDescriptor)
  *  DESCRIPTION:
  *      1. This function appends the node to the AttributeDescriptor
  *         list with the values passed in the input parameters
+ *      2. Each string takes the length of its value, so a longer value
+ *         has to be set with setAttributeDescriptorString().
  *	
  *  ARGUMENTS:
  *       - pHeadRef, pointer to ListAttributeDescriptor {IN/OUT}
@@ -3878,7 +4504,7 @@ int appendListAttributeDescriptor(ListAttributeDescriptor** pHeadRef,
 	/* Allocating memory to AttributeDescriptor->attributeType */
 	lenAttributeType = strlen(attributeType) + 1;
 	pListAttributeDescriptor->pAttributeDescriptor_->attributeType_ = 
-          (char *) calloc (MAX_ATTRIBUTE_TYPE, sizeof(char));
+          (char *) calloc (lenAttributeType, sizeof(char));
   
 	if (pListAttributeDescriptor->pAttributeDescriptor_->attributeType_== 
 		NULL) {
@@ -3887,9 +4513,10 @@ int appendListAttributeDescriptor(ListAttributeDescriptor** pHeadRef,
  	strcpy(pListAttributeDescriptor->pAttributeDescriptor_->attributeType_,
                attributeType);
 	
-	/* Allocating memory to AttributeDescriptor->description MAX*/
+	/* Allocating memory to AttributeDescriptor->description */
+	lenDescription = strlen(description) + 1;
 	pListAttributeDescriptor->pAttributeDescriptor_->description_ = 
-		(char *) calloc (MAX_ATTRIBUTE_CLASS, sizeof(char));
+		(char *) calloc (lenDescription, sizeof(char));
 	
 	if (pListAttributeDescriptor->pAttributeDescriptor_->description_== 
 		NULL) {
@@ -3899,9 +4526,10 @@ int appendListAttributeDescriptor(ListAttributeDescriptor** pHeadRef,
 	strcpy(pListAttributeDescriptor->pAttributeDescriptor_->description_,
                description);
 	
-	/* Allocating memory to AttributeDescriptor->derivedType MAX*/
+	/* Allocating memory to AttributeDescriptor->derivedType */
+	lenDerivedType = strlen(derivedType) + 1;
 	pListAttributeDescriptor->pAttributeDescriptor_->derivedType_ = 
-		(char *) calloc (MAX_ATTRIBUTE_TYPE, sizeof(char));
+		(char *) calloc (lenDerivedType, sizeof(char));
 	
 	if (pListAttributeDescriptor->pAttributeDescriptor_->derivedType_== 
 		NULL) {
@@ -3914,7 +4542,7 @@ int appendListAttributeDescriptor(ListAttributeDescriptor** pHeadRef,
 
    if(complexType != NULL) {
 		pListAttributeDescriptor->pAttributeDescriptor_->complexType_ = 
-			(char *) calloc (MAX_ATTRIBUTE_TYPE, sizeof(char));
+			(char *) calloc (strlen(complexType) + 1, sizeof(char));
 	
 		if (pListAttributeDescriptor->pAttributeDescriptor_->complexType_== 
 			NULL) {
@@ -3988,7 +4616,7 @@ int appendListAttributeDescriptor(ListAttributeDescriptor** pHeadRef,
 	/* Allocating memory to AttributeDescriptor->attributeType */
 	lenAttributeType = strlen(attributeType) + 1;
 	pListAttributeDescriptor->pAttributeDescriptor_->attributeType_ = 
-          (char *) calloc (MAX_ATTRIBUTE_TYPE, sizeof(char));
+          (char *) calloc (lenAttributeType, sizeof(char));
   
 	if (pListAttributeDescriptor->pAttributeDescriptor_->attributeType_== 
 		NULL) {
@@ -3997,9 +4625,10 @@ int appendListAttributeDescriptor(ListAttributeDescriptor** pHeadRef,
  	strcpy(pListAttributeDescriptor->pAttributeDescriptor_->attributeType_,
                attributeType);
 
-	/* Allocating memory to AttributeDescriptor->description MAX */
+	/* Allocating memory to AttributeDescriptor->description */
+	lenDescription = strlen(description) + 1;
 	pListAttributeDescriptor->pAttributeDescriptor_->description_ = 
-		(char *) calloc (MAX_ATTRIBUTE_CLASS, sizeof(char));
+		(char *) calloc (lenDescription, sizeof(char));
 
 	if (pListAttributeDescriptor->pAttributeDescriptor_->description_== 
 		NULL) {
@@ -4010,8 +4639,9 @@ int appendListAttributeDescriptor(ListAttributeDescriptor** pHeadRef,
                description);
 	
 	/* Allocating memory to AttributeDescriptor->derivedType */
+	lenDerivedType = strlen(derivedType) + 1;
 	pListAttributeDescriptor->pAttributeDescriptor_->derivedType_ = 
-		(char *) calloc (MAX_ATTRIBUTE_TYPE, sizeof(char));
+		(char *) calloc (lenDerivedType, sizeof(char));
 
 	if (pListAttributeDescriptor->pAttributeDescriptor_->derivedType_== 
 		NULL) {
@@ -4022,7 +4652,8 @@ int appendListAttributeDescriptor(ListAttributeDescriptor** pHeadRef,
 
  
 	pListAttributeDescriptor->pAttributeDescriptor_->complexType_ = 
-			(char *) calloc (MAX_ATTRIBUTE_TYPE, sizeof(char));
+			(char *) calloc (complexType != NULL ? strlen(complexType) + 1 : 1,
+							 sizeof(char));
 	
 	if (pListAttributeDescriptor->pAttributeDescriptor_->complexType_== 
 			NULL) {
@@ -4071,6 +4702,193 @@ int appendListAttributeDescriptor(ListAttributeDescriptor** pHeadRef,
 }
 
 
+/*!
+ *  NAME:
+ *      setAttributeDescriptorString() - sets a string of an attribute
+ *           descriptor
+ *
+ *  DESCRIPTION:
+ *      The strings of a descriptor appended to a list have the length
+ *      of their value. A value no longer than the current one is copied
+ *      in place, a longer one gets a new string, from the arena if the
+ *      descriptor is held in one or else by realloc(). A NULL string is
+ *      allocated.
+ *	
+ *  ARGUMENTS:
+ *       - pArena {IN/OUT}, arena of the descriptor, NULL if on the heap
+ *       - ppString {IN/OUT}, field of the descriptor
+ *       - pValue {IN}
+ *
+ *  RETURNS 	
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+int setAttributeDescriptorString(IPDRArena* pArena,
+      char** ppString,
+      const char* pValue
+	)
+{
+	size_t length = 0;
+	char* pString = NULL;
+
+	if (ppString == NULL || pValue == NULL) {
+		return (IPDR_NULL_INPUT_PARAMETER);
+	}
+
+	length = strlen(pValue);
+	if (*ppString != NULL && length <= strlen(*ppString)) {
+		memmove(*ppString, pValue, length + 1);
+		return (IPDR_OK);
+	}
+
+	if (pArena != NULL) {
+		pString = copyIPDRArenaString(pArena, pValue);
+	}
+	else {
+		pString = (char *) realloc(*ppString, length + 1);
+		if (pString != NULL)
+			memcpy(pString, pValue, length + 1);
+	}
+	if (pString == NULL) {
+		return (IPDR_MEMORY_ALLOCATION_FAILED);
+	}
+
+	*ppString = pString;
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      copyListInArena() - copies a List into an arena
+ *
+ *  DESCRIPTION:
+ *      The nodes are copied, their strings are shared with the 
+ *      source list as appendNode() shares them.
+ *	
+ *  ARGUMENTS:
+ *       - pArena {IN/OUT}
+ *       - pList {IN}
+ *       - ppCopy {OUT}
+ *
+ *  RETURNS 	
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+static int copyListInArena(IPDRArena* pArena, const List* pList, List** ppCopy)
+{
+	List* pNode = NULL;
+
+	*ppCopy = NULL;
+	for (; pList != NULL; pList = pList->pNext) {
+		pNode = (List *) allocIPDRArena(pArena, sizeof(List));
+		if (pNode == NULL) {
+			return (IPDR_MEMORY_ALLOCATION_FAILED);
+		}
+		pNode->node = pList->node;
+		*ppCopy = pNode;
+		ppCopy = &(pNode->pNext);
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      appendListAttributeDescriptorInArena() - appends a copy of an
+ *           attribute descriptor to the list from an arena
+ *
+ *  DESCRIPTION:
+ *      1. Same as appendListAttributeDescriptor() with the fields of
+ *         pAttributeDescriptor, the node and its strings being
+ *         allocated from the arena. The strings take the length of 
+ *         their content as on the heap.
+ *	
+ *  ARGUMENTS:
+ *       - pArena {IN/OUT}, NULL to allocate from the heap
+ *       - pHeadRef, pointer to ListAttributeDescriptor {IN/OUT}
+ *       - pAttributeDescriptor {IN}
+ *
+ *  RETURNS 	
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+int appendListAttributeDescriptorInArena(IPDRArena* pArena,
+      ListAttributeDescriptor** pHeadRef, 
+      const AttributeDescriptor* pAttributeDescriptor
+	)
+{
+	ListAttributeDescriptor* pListAttributeDescriptor = NULL;
+	ListAttributeDescriptor* pCurrent = NULL;
+	AttributeDescriptor* pCopy = NULL;
+
+	if (pHeadRef == NULL || pAttributeDescriptor == NULL) {
+		return (IPDR_NULL_INPUT_PARAMETER);
+	}
+
+	if (pArena == NULL) {
+		return (appendListAttributeDescriptor(pHeadRef,
+				pAttributeDescriptor->attributeName_,
+				pAttributeDescriptor->attributeType_,
+				pAttributeDescriptor->description_,
+				pAttributeDescriptor->derivedType_,
+				pAttributeDescriptor->complexType_, 
+				pAttributeDescriptor->pListAttrNameList_, 
+				pAttributeDescriptor->pListAttrClassList_, 
+				pAttributeDescriptor->pListAttrMaxOccursList_, 
+				pAttributeDescriptor->noOfElements_));
+	}
+
+	if ((pAttributeDescriptor->attributeName_ == NULL) || 
+		(pAttributeDescriptor->attributeType_ == NULL) || 
+		(pAttributeDescriptor->derivedType_ == NULL)) {
+		return (IPDR_NULL_INPUT_PARAMETER);
+	}
+
+	pListAttributeDescriptor = (ListAttributeDescriptor *) 
+		allocIPDRArena(pArena, sizeof(ListAttributeDescriptor));
+	pCopy = (AttributeDescriptor *) allocIPDRArena(pArena, sizeof(AttributeDescriptor));
+	if (pListAttributeDescriptor == NULL || pCopy == NULL) {
+		return (IPDR_MEMORY_ALLOCATION_FAILED);
+	}
+	pListAttributeDescriptor->pAttributeDescriptor_ = pCopy;
+
+	pCopy->attributeName_ = copyIPDRArenaString(pArena, pAttributeDescriptor->attributeName_);
+	pCopy->attributeType_ = copyIPDRArenaString(pArena, pAttributeDescriptor->attributeType_);
+	pCopy->derivedType_ = copyIPDRArenaString(pArena, pAttributeDescriptor->derivedType_);
+	pCopy->description_ = copyIPDRArenaString(pArena, 
+		pAttributeDescriptor->description_ != NULL ? pAttributeDescriptor->description_ : "");
+	if (pAttributeDescriptor->complexType_ != NULL)
+		pCopy->complexType_ = copyIPDRArenaString(pArena, pAttributeDescriptor->complexType_);
+	if (pCopy->attributeName_ == NULL || pCopy->attributeType_ == NULL ||
+		pCopy->derivedType_ == NULL || pCopy->description_ == NULL ||
+		(pAttributeDescriptor->complexType_ != NULL && pCopy->complexType_ == NULL)) {
+		return (IPDR_MEMORY_ALLOCATION_FAILED);
+	}
+
+	if (copyListInArena(pArena, pAttributeDescriptor->pListAttrNameList_, 
+						&(pCopy->pListAttrNameList_)) != IPDR_OK ||
+		copyListInArena(pArena, pAttributeDescriptor->pListAttrClassList_, 
+						&(pCopy->pListAttrClassList_)) != IPDR_OK ||
+		copyListInArena(pArena, pAttributeDescriptor->pListAttrMaxOccursList_, 
+						&(pCopy->pListAttrMaxOccursList_)) != IPDR_OK) {
+		return (IPDR_MEMORY_ALLOCATION_FAILED);
+	}
+	pCopy->noOfElements_ = pAttributeDescriptor->noOfElements_;
+
+	if (*pHeadRef == NULL) {
+		*pHeadRef = pListAttributeDescriptor;
+	} else {
+		for (pCurrent = *pHeadRef; pCurrent->pNext_ != NULL; pCurrent = pCurrent->pNext_)
+			;
+		pCurrent->pNext_ = pListAttributeDescriptor;
+	}
+
+	return (IPDR_OK);
+}
+
+
 /*!
  *  NAME:
  *      checkAttribute() - function checks whether Attribute is optional 
@@ -4457,9 +5275,16 @@ int printFNFType(FNFType* pFNFType)
 Schema* newSchema()
 {
 	Schema* pSchema = (Schema *) calloc (1, sizeof(Schema));
+	if (pSchema == NULL)
+		return (NULL);
 	pSchema->pListSchemaLookup_ = NULL;
 	pSchema->pListNameSpaceInfo_ = NULL;
 	pSchema->SchemaValidationFlag_ = IPDR_FALSE;
+	pSchema->pElementIndex_ = NULL;
+	pSchema->ppIndexedElements_ = NULL;
+	pSchema->pElementSequence_ = NULL;
+	pSchema->shared_ = IPDR_FALSE;
+	pSchema->refCount_ = 0;
 	return pSchema;
 }
 
@@ -4885,6 +5710,7 @@ int freeSchemaData(Schema* pSchema)
 {
 	freeListNameSpaceInfo(&(pSchema->pListNameSpaceInfo_));
 	pSchema->SchemaValidationFlag_ = IPDR_FALSE;
+	freeSchemaIndex(pSchema);
 	freeListSchemaLookup(&pSchema->pListSchemaLookup_); 
 
 	free(pSchema);
@@ -4892,6 +5718,137 @@ int freeSchemaData(Schema* pSchema)
 	return (IPDR_OK);
 }
 
+/* Guards refCount_ of the shared schemas */
+static IPDRMutex gSchemaReferenceMutex = IPDR_MUTEX_INITIALIZER;
+
+/* Last readGeneration_ handed out, to any document */
+static IPDRMutex gReadGenerationMutex = IPDR_MUTEX_INITIALIZER;
+static unsigned int gReadGeneration = 0;
+
+
+/*!
+ *  NAME:
+ *      nextIPDRReadGeneration() - returns a new read generation
+ *
+ *  DESCRIPTION:
+ *         Documents take a new generation when they are created and
+ *         whenever a descriptor or the projection is set. The value
+ *         is unique in the process, so a record keyed on it is not
+ *         taken for one of a later document at the same address.
+ *
+ *  RETURNS
+ *	     Returns the generation, never 0
+ */
+
+int nextIPDRReadGeneration(void)
+{
+	unsigned int generation;
+
+	lockIPDRMutex(&gReadGenerationMutex);
+	if (++gReadGeneration == 0 || gReadGeneration > (unsigned int) 0x7fffffff)
+		gReadGeneration = 1;
+	generation = gReadGeneration;
+	unlockIPDRMutex(&gReadGenerationMutex);
+
+	return ((int) generation);
+}
+
+
+/*!
+ *  NAME:
+ *      retainSchemaData() - adds a reference to a shared schema
+ *
+ *  DESCRIPTION:
+ *         Called by the schema registry for every document the
+ *         schema is handed to.
+ *
+ *  ARGUMENTS:
+ *	    - pSchema {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK, or IPDR_ERROR if the schema is not shared
+ */
+
+int retainSchemaData(Schema* pSchema)
+{
+	if (pSchema == NULL || pSchema->shared_ != IPDR_TRUE)
+		return (IPDR_ERROR);
+
+	lockIPDRMutex(&gSchemaReferenceMutex);
+	pSchema->refCount_++;
+	unlockIPDRMutex(&gSchemaReferenceMutex);
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      releaseSchemaData() - drops a reference to a shared schema
+ *
+ *  DESCRIPTION:
+ *         The schema stays in the schema registry for later documents
+ *         until clearSchemaRegistry() frees it.
+ *
+ *  ARGUMENTS:
+ *	    - pSchema {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK, or IPDR_ERROR if the schema is not shared
+ *	     or not referenced
+ */
+
+int releaseSchemaData(Schema* pSchema)
+{
+	int errorSeverity = IPDR_ERROR;
+
+	if (pSchema == NULL || pSchema->shared_ != IPDR_TRUE)
+		return (IPDR_ERROR);
+
+	lockIPDRMutex(&gSchemaReferenceMutex);
+	if (pSchema->refCount_ > 0) {
+		pSchema->refCount_--;
+		errorSeverity = IPDR_OK;
+	}
+	unlockIPDRMutex(&gSchemaReferenceMutex);
+
+	return (errorSeverity);
+}
+
+
+/*!
+ *  NAME:
+ *      freeUnreferencedSchemaData() - frees a shared schema no
+ *      document references
+ *
+ *  DESCRIPTION:
+ *         The caller must make sure no reference is added while this
+ *         runs; the schema registry holds its lock.
+ *
+ *  ARGUMENTS:
+ *	    - pSchema {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK if the schema was freed, or IPDR_WARNING if
+ *	     it is still referenced
+ */
+
+int freeUnreferencedSchemaData(Schema* pSchema)
+{
+	int refCount = 0;
+
+	lockIPDRMutex(&gSchemaReferenceMutex);
+	refCount = pSchema->refCount_;
+	unlockIPDRMutex(&gSchemaReferenceMutex);
+
+	if (refCount > 0)
+		return (IPDR_WARNING);
+
+	freeSchemaData(pSchema);
+
+	return (IPDR_OK);
+}
+
 /*!
 *NAME:
 *     newListOfKeys() 
@@ -6619,10 +7576,12 @@ int freeListIPDRArrayData(ListIPDRArrayData** pHeadRef)
         pNext = pCurrent->pNext_;
 		
 		if (pCurrent->IPDRDataType_ == IPDRDATA_HEXADECARRAY)
-			free(pCurrent->IPDRDataUnion_.IPDRByteArray_);  
+			releaseIPDRValue(pCurrent->IPDRDataUnion_.IPDRByteArray_, 
+				pCurrent->inlineValue_);  
 
 		if (pCurrent->IPDRDataType_ == IPDRDATA_STRING) {
-			free(pCurrent->IPDRDataUnion_.IPDRUTF8Array_);  
+			releaseIPDRValue(pCurrent->IPDRDataUnion_.IPDRUTF8Array_, 
+				pCurrent->inlineValue_);  
 		}
 
 	    free(pCurrent);
@@ -0,0 +1,245 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : IPDRThread                 *
+ * Description          : Portable locking primitives*
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include <stdlib.h>
+#ifndef WIN32
+#include <unistd.h>
+#endif
+#include "utils/IPDRThread.h"
+#include "utils/errorCode.h"
+
+/*!
+ *  Function and argument handed to a new thread
+ */
+typedef struct IPDRThreadStart
+{
+	IPDRThreadFunction function_;
+	void* pArgument_;
+} IPDRThreadStart;
+
+
+/*!
+ *  NAME:
+ *      initIPDRMutex() - sets up a mutex that was not initialized
+ *      statically
+ *
+ *  ARGUMENTS:
+ *       - pMutex {OUT}
+ *
+ *  RETURNS
+ *       Returns IPDR_OK, or IPDR_ERROR if the mutex could not be set up
+ */
+
+int initIPDRMutex(IPDRMutex* pMutex)
+{
+#ifdef WIN32
+	InitializeSRWLock(pMutex);
+	return (IPDR_OK);
+#else
+	return (pthread_mutex_init(pMutex, NULL) == 0 ? IPDR_OK : IPDR_ERROR);
+#endif
+}
+
+
+/*!
+ *  NAME:
+ *      destroyIPDRMutex() - releases a mutex set up by initIPDRMutex()
+ *
+ *  ARGUMENTS:
+ *       - pMutex {IN/OUT}, must not be held
+ *
+ *  RETURNS
+ *       Returns IPDR_OK, or IPDR_ERROR if the mutex is still held
+ */
+
+int destroyIPDRMutex(IPDRMutex* pMutex)
+{
+#ifdef WIN32
+	/* Slim reader/writer locks hold no resources */
+	return (IPDR_OK);
+#else
+	return (pthread_mutex_destroy(pMutex) == 0 ? IPDR_OK : IPDR_ERROR);
+#endif
+}
+
+
+/*!
+ *  NAME:
+ *      lockIPDRMutex() - acquires a mutex
+ *
+ *  ARGUMENTS:
+ *       - pMutex {IN/OUT}
+ *
+ *  RETURNS
+ *       Returns IPDR_OK, or IPDR_ERROR if the mutex could not be
+ *       acquired
+ */
+
+int lockIPDRMutex(IPDRMutex* pMutex)
+{
+#ifdef WIN32
+	AcquireSRWLockExclusive(pMutex);
+	return (IPDR_OK);
+#else
+	return (pthread_mutex_lock(pMutex) == 0 ? IPDR_OK : IPDR_ERROR);
+#endif
+}
+
+
+/*!
+ *  NAME:
+ *      unlockIPDRMutex() - releases a mutex
+ *
+ *  ARGUMENTS:
+ *       - pMutex {IN/OUT}
+ *
+ *  RETURNS
+ *       Returns IPDR_OK, or IPDR_ERROR if the mutex was not held
+ */
+
+int unlockIPDRMutex(IPDRMutex* pMutex)
+{
+#ifdef WIN32
+	ReleaseSRWLockExclusive(pMutex);
+	return (IPDR_OK);
+#else
+	return (pthread_mutex_unlock(pMutex) == 0 ? IPDR_OK : IPDR_ERROR);
+#endif
+}
+
+
+/*!
+ *  NAME:
+ *      runIPDRThread() - entry point of the threads started by
+ *      startIPDRThread()
+ *
+ *  ARGUMENTS:
+ *       - pArgument {IN}, the IPDRThreadStart, which is freed
+ *
+ *  RETURNS
+ *       Returns 0
+ */
+
+#ifdef WIN32
+static DWORD WINAPI runIPDRThread(LPVOID pArgument)
+#else
+static void* runIPDRThread(void* pArgument)
+#endif
+{
+	IPDRThreadStart start = *((IPDRThreadStart *) pArgument);
+
+	free(pArgument);
+	start.function_(start.pArgument_);
+
+	return (0);
+}
+
+
+/*!
+ *  NAME:
+ *      startIPDRThread() - runs a function on a new thread
+ *
+ *  ARGUMENTS:
+ *       - pThread {OUT}
+ *       - function {IN}
+ *       - pArgument {IN}
+ *
+ *  RETURNS
+ *       Returns IPDR_OK, or IPDR_ERROR if the thread could not be
+ *       started
+ */
+
+int startIPDRThread(IPDRThread* pThread,
+					IPDRThreadFunction function,
+					void* pArgument)
+{
+	IPDRThreadStart* pStart = NULL;
+
+	pStart = (IPDRThreadStart *) calloc(1, sizeof(IPDRThreadStart));
+	if (pStart == NULL)
+		return (IPDR_ERROR);
+	pStart->function_ = function;
+	pStart->pArgument_ = pArgument;
+
+#ifdef WIN32
+	*pThread = CreateThread(NULL, 0, runIPDRThread, pStart, 0, NULL);
+	if (*pThread == NULL) {
+#else
+	if (pthread_create(pThread, NULL, runIPDRThread, pStart) != 0) {
+#endif
+		free(pStart);
+		return (IPDR_ERROR);
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      joinIPDRThread() - waits for a thread to finish
+ *
+ *  ARGUMENTS:
+ *       - pThread {IN}
+ *
+ *  RETURNS
+ *       Returns IPDR_OK, or IPDR_ERROR if the thread could not be
+ *       waited for
+ */
+
+int joinIPDRThread(IPDRThread* pThread)
+{
+#ifdef WIN32
+	if (WaitForSingleObject(*pThread, INFINITE) != WAIT_OBJECT_0)
+		return (IPDR_ERROR);
+	CloseHandle(*pThread);
+	return (IPDR_OK);
+#else
+	return (pthread_join(*pThread, NULL) == 0 ? IPDR_OK : IPDR_ERROR);
+#endif
+}
+
+
+/*!
+ *  NAME:
+ *      getIPDRProcessorCount() - number of online processors
+ *
+ *  ARGUMENTS:
+ *       NONE
+ *
+ *  RETURNS
+ *       Returns the number of processors, at least 1
+ */
+
+int getIPDRProcessorCount(void)
+{
+	long count = 1;
+#ifdef WIN32
+	SYSTEM_INFO systemInfo;
+
+	GetSystemInfo(&systemInfo);
+	count = (long) systemInfo.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+	count = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+	return (count < 1 ? 1 : (int) count);
+}
@@ -724,6 +724,24 @@ int getErrorMessage (char* errorMessage, int* errorCode)
     case IPDR_NO_DATA_IN_FILE:
     	strcpy(errorMessage, "Input File contains no Data");
 	    break;
+    case IPDR_SCHEMA_CACHE_DIRECTORY_INVALID:
+    	strcpy(errorMessage, "Schema cache directory is invalid");
+	    break;
+    case IPDR_SCHEMA_READ_ONLY:
+    	strcpy(errorMessage, "Shared schema can not be modified");
+	    break;
+    case IPDR_THREAD_CREATE_FAILED:
+    	strcpy(errorMessage, "Worker thread could not be started");
+	    break;
+    case IPDR_CONVERSION_INPUT_UNSUPPORTED:
+    	strcpy(errorMessage, "Input document type can not be converted");
+	    break;
+    case IPDR_ATTRIBUTE_NOT_IN_LAYOUT:
+    	strcpy(errorMessage, "Attribute is not in the layout of the record");
+	    break;
+    case IPDR_ATTRIBUTE_VALUE_NOT_SET:
+    	strcpy(errorMessage, "Attribute of the record has no value");
+	    break;
 	default:
 		if (*errorCode > EXPAT_ERROR_CODE) {
 			strcpy(errorMessage, "XML parser error: ");
@@ -21,8 +21,17 @@
 **********************************************************************/
 
 #include "utils/schemaUtil.h"
+#include "utils/schemaValidator.h"
 #include "utils/dynamicArray.h"
 #include "common/schema.h"
+#include "utils/IPDRThread.h"
+
+static int validateAgainstSchemaLookup(
+	   IPDRCommonParameters *pIPDRCommonParameters,
+	   FNFData* pFNFData,
+	   int* pErrorCode
+	  );
+static void freeElementIndex(Schema* pSchema);
 
 
 /*!
@@ -31,7 +40,9 @@
 *
 *DESCRIPTION:
 *     This method is used to validate a given FNFData object against a 
-*      schema object.
+*      schema object. Records are checked by the compiled validator of
+*      their type name; types it cannot compile fall back to the walk
+*      of the schema lookup lists.
 * 
 *ARGUMENTS:
 * - Poiter to IPDRCommomnParameters{IN}
@@ -49,10 +60,97 @@ int validateAgainstSchema(
 	   FNFData* pFNFData,
 	   int* pErrorCode
 	  )
+{
+	return (validateRecordAgainstSchema(pIPDRCommonParameters, 
+										pFNFData, 
+										SCHEMA_NO_DESCRIPTOR_ID, 
+										IPDR_FALSE, 
+										pErrorCode));
+}
+
+
+/*!
+*NAME:
+*     validateRecordAgainstSchema() 
+*
+*DESCRIPTION:
+*     Same as validateAgainstSchema() for a record of a known 
+*      descriptor. The outcome is kept per descriptor ID, so that the 
+*      following records of that descriptor are not validated again.
+* 
+*ARGUMENTS:
+* - Poiter to IPDRCommomnParameters{IN}
+* - Pointer to FNFData {IN}
+* - Descriptor ID of the record, SCHEMA_NO_DESCRIPTOR_ID if unknown {IN}
+* - IPDR_TRUE if the attributes of the record are those of the 
+*        descriptor {IN}
+*      - Integer variable to store the error code if it originates
+*        in the function {OUT}
+*
+* RETURNS 
+* Returns Zero or appropriate error code
+*/
+
+int validateRecordAgainstSchema(
+	   IPDRCommonParameters *pIPDRCommonParameters,
+	   FNFData* pFNFData,
+	   int descriptorID,
+	   int layoutOfDescriptor,
+	   int* pErrorCode
+	  )
+{
+	int handled = IPDR_FALSE;
+	int errorSeverity = 0;
+
+	if(pIPDRCommonParameters == NULL || pFNFData == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return(IPDR_ERROR);
+	}
+	if(pIPDRCommonParameters->pSchema_->pListSchemaLookup_ == NULL) {
+		*pErrorCode = IPDR_NULL_SCHEMA_LOOKUP;
+		return(IPDR_WARNING);
+	}
+
+	errorSeverity = validateWithSchemaValidator(pIPDRCommonParameters, 
+												pFNFData, 
+												descriptorID, 
+												layoutOfDescriptor, 
+												&handled, 
+												pErrorCode);
+	if (handled == IPDR_TRUE)
+		return (errorSeverity);
+
+	return (validateAgainstSchemaLookup(pIPDRCommonParameters, pFNFData, pErrorCode));
+}
+
+
+/*!
+*NAME:
+*     validateAgainstSchemaLookup() 
+*
+*DESCRIPTION:
+*     Validates a FNFData object by walking the schema lookup lists.
+* 
+*ARGUMENTS:
+* - Poiter to IPDRCommomnParameters{IN}
+* - Pointer to FNFData {IN}
+*      - Integer variable to store the error code if it originates
+*        in the function {OUT}
+*
+* RETURNS 
+* Returns Zero or appropriate error code
+*/
+
+static int validateAgainstSchemaLookup(
+	   IPDRCommonParameters *pIPDRCommonParameters,
+	   FNFData* pFNFData,
+	   int* pErrorCode
+	  )
 {
 	char* pFNFtypeName = NULL;
 	char* tempString = NULL;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
 	char* nameSpaceFnfID = NULL;
 	char* nameSpaceFnfURI = NULL;
 	char* FNFAttributeName = NULL;
@@ -88,7 +186,7 @@ int validateAgainstSchema(
 	}
 	
 	strcpy(tempString, pFNFData->typeName_);
-	serviceTypeToken = strtok(tempString, ":");
+	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 	
 	if(!strcmp(pFNFData->typeName_,serviceTypeToken)) 
 		strcpy(pFNFtypeName, pFNFData->typeName_);
@@ -132,11 +230,11 @@ int validateAgainstSchema(
 
    /*check For structures ... getMandatoryAttr and CheckForMandorteyAttrrinFNFData*/
 	pCurrentListSchemaElement = pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_;
-	while(pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_ != NULL) {
-		if(pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->attributeType_ == SCHEMA_LOOKUP_WRITE_STRUCTURE) {
+	while(pCurrentListSchemaElement != NULL) {
+		if(pCurrentListSchemaElement->pSchemaElement_->attributeType_ == SCHEMA_LOOKUP_WRITE_STRUCTURE) {
 			errorSeverity = getMandatoryAttributesFromSchemaForStructures(
 									pIPDRCommonParameters,
-									pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_, 
+									pCurrentListSchemaElement, 
 									&pListAttrName, 
 									pFNFtypeName, 
 									pErrorCode);
@@ -169,7 +267,7 @@ int validateAgainstSchema(
 			/*check for Array size ... if noOfelements is != 0, then array*/
 			errorSeverity = validateArraySizeForAttributesFromSchemaForStructures(
 									pIPDRCommonParameters,
-									pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_, 
+									pCurrentListSchemaElement, 
 								   pFNFData->pListServiceAttributeDescriptor_,
 									pFNFtypeName, 
 									pErrorCode);
@@ -185,10 +283,8 @@ int validateAgainstSchema(
 			}			
 		}
 		
-		pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_ = 
-					pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pNext_; 
+		pCurrentListSchemaElement = pCurrentListSchemaElement->pNext_; 
 	}
-	pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_ = pCurrentListSchemaElement;
 /*End of Structures*/
 
 	pCurrentListAttributeDescriptor = pFNFData->pListAttributeDescriptor_;
@@ -225,7 +321,7 @@ int validateAgainstSchema(
 		pFNFAttributeName = (char *) calloc (strlen(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeName_) + 1, sizeof(char));
 
 		strcpy(tempAttributeString, pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeName_);
-		serviceTypeToken = strtok(tempAttributeString, ":");
+		serviceTypeToken = strtok_r(tempAttributeString, ":", &pTokenContext);
 		
 		if(!strcmp(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeName_,serviceTypeToken)) 
 			strcpy(pFNFAttributeName, pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeName_);
@@ -306,7 +402,19 @@ int validateAgainstSchema(
 			free(nameSpaceFnfURI);				
 			return(IPDR_WARNING);
 		}
-		strcpy(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->derivedType_, pSchemaElement->derivedType_);    
+		if (setAttributeDescriptorString(pFNFData->pArena_,
+				&(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->derivedType_),
+				pSchemaElement->derivedType_) != IPDR_OK) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			pFNFData->pListAttributeDescriptor_ = pCurrentListAttributeDescriptor;
+			free(pFNFtypeName);
+			free(nameSpaceFnfID);
+			free(nameSpaceFnfURI);
+			freeSchemaElement(pSchemaElement);
+			if (pListAttrName != NULL)
+				freeList(&pListAttrName);
+			return (IPDR_ERROR);
+		}
 		freeSchemaElement(pSchemaElement); 
 
 			
@@ -387,84 +495,228 @@ int	getMandatoryAttributesFromSchema(
 		return(IPDR_ERROR);
 	}
 
+	/* Walks with local cursors, the schema may be shared */
 	pCurrentListSchemaLookup = pIPDRCommonParameters->pSchema_->pListSchemaLookup_;
-	while(pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL ) {
-		if(strcmp(serviceType, pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->serviceType_) != 0) {
-			pIPDRCommonParameters->pSchema_->pListSchemaLookup_ = pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pNext_; 			
+	while(pCurrentListSchemaLookup != NULL ) {
+		if(strcmp(serviceType, pCurrentListSchemaLookup->pSchemaLookup_->serviceType_) != 0) {
+			pCurrentListSchemaLookup = pCurrentListSchemaLookup->pNext_; 			
 		} else {
-			pCurrentListSchemaElement = pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_;
-			while(pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_ != NULL) {
-				if(pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->pAttributeOptional_ == 0) {
-					appendNode(pListAttrName, pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->attributeName_); 
+			pCurrentListSchemaElement = pCurrentListSchemaLookup->pSchemaLookup_->pListSchemaElement_;
+			while(pCurrentListSchemaElement != NULL) {
+				if(pCurrentListSchemaElement->pSchemaElement_->pAttributeOptional_ == 0) {
+					appendNode(pListAttrName, pCurrentListSchemaElement->pSchemaElement_->attributeName_); 
 				}
-				pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_ = 
-					pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pNext_; 
+				pCurrentListSchemaElement = pCurrentListSchemaElement->pNext_; 
 			}
-			pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_ = pCurrentListSchemaElement;
 			break;
 		}
 	}
 
-	pIPDRCommonParameters->pSchema_->pListSchemaLookup_ = pCurrentListSchemaLookup;
-
 	return(IPDR_OK);
 }
 
 
+/*!
+*NAME:
+*     freeSchemaIndex() 
+*
+*DESCRIPTION:
+*     Drops the attribute name index of a schema. It is rebuilt on
+*     the next lookup, so this is also called whenever a schema lookup
+*     is added.
+* 
+*ARGUMENTS:
+* - Pointer to Schema {IN/OUT}
+*
+* RETURNS 
+* Returns Zero or appropriate error code
+*/
+
+int freeSchemaIndex(Schema* pSchema)
+{
+	if (pSchema == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	freeElementIndex(pSchema);
+
+	return (IPDR_OK);
+}
+
+
+/*!
+*NAME:
+*     freeElementIndex() 
+*
+*DESCRIPTION:
+*     Drops the attribute name index only.
+* 
+*ARGUMENTS:
+* - Pointer to Schema {IN/OUT}
+*/
+
+static void freeElementIndex(Schema* pSchema)
+{
+	freeIPDRStringMap(pSchema->pElementIndex_);
+	free(pSchema->ppIndexedElements_);
+	free(pSchema->pElementSequence_);
+	pSchema->pElementIndex_ = NULL;
+	pSchema->ppIndexedElements_ = NULL;
+	pSchema->pElementSequence_ = NULL;
+}
+
+
+/*!
+*NAME:
+*     buildSchemaIndex() 
+*
+*DESCRIPTION:
+*     Maps every attribute name of the schema to its SchemaElement and
+*     its position within the schema lookup. As with the list walk it
+*     replaces, only the first lookup of a service type is searched,
+*     and only for names of that service type; the first of equal
+*     names wins.
+* 
+*ARGUMENTS:
+* - Pointer to Schema {IN/OUT}
+* - Integer variable to store the error code {OUT}
+*
+* RETURNS 
+* Returns Zero or appropriate error code
+*/
+
+int buildSchemaIndex(Schema* pSchema, int* pErrorCode)
+{
+	int noOfElements = 0;
+	int sequenceNo = 0;
+	int slot = 0;
+	char* serviceType = NULL;
+	IPDRStringMap* pServiceTypes = NULL;
+	ListSchemaLookup* pListSchemaLookup = NULL;
+	ListSchemaElement* pListSchemaElement = NULL;
+	SchemaElement* pSchemaElement = NULL;
+
+	for (pListSchemaLookup = pSchema->pListSchemaLookup_; pListSchemaLookup != NULL;
+		 pListSchemaLookup = pListSchemaLookup->pNext_)
+		noOfElements += getLengthListSchemaElement(
+							pListSchemaLookup->pSchemaLookup_->pListSchemaElement_);
+
+	pSchema->pElementIndex_ = newIPDRStringMap(noOfElements);
+	pSchema->ppIndexedElements_ = (SchemaElement **) calloc(noOfElements + 1, 
+															sizeof(SchemaElement *));
+	pSchema->pElementSequence_ = (int *) calloc(noOfElements + 1, sizeof(int));
+	pServiceTypes = newIPDRStringMap(HASH_BUCKETS);
+	serviceType = (char *) calloc(MAX_IPDR_STRING, sizeof(char));
+	if (pSchema->pElementIndex_ == NULL || pSchema->ppIndexedElements_ == NULL ||
+		pSchema->pElementSequence_ == NULL || pServiceTypes == NULL ||
+		serviceType == NULL) {
+		freeElementIndex(pSchema);
+		freeIPDRStringMap(pServiceTypes);
+		free(serviceType);
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return (IPDR_ERROR);
+	}
+
+	for (pListSchemaLookup = pSchema->pListSchemaLookup_; pListSchemaLookup != NULL;
+		 pListSchemaLookup = pListSchemaLookup->pNext_) {
+		if (getIPDRStringMap(pServiceTypes, 
+							 pListSchemaLookup->pSchemaLookup_->serviceType_, 
+							 NULL) == IPDR_TRUE)
+			continue;
+		putIPDRStringMap(pServiceTypes, pListSchemaLookup->pSchemaLookup_->serviceType_, 
+						 0, pErrorCode);
+
+		sequenceNo = 0;
+		for (pListSchemaElement = pListSchemaLookup->pSchemaLookup_->pListSchemaElement_;
+			 pListSchemaElement != NULL; 
+			 pListSchemaElement = pListSchemaElement->pNext_) {
+			pSchemaElement = pListSchemaElement->pSchemaElement_;
+			sequenceNo++;
+
+			if (strlen(pSchemaElement->attributeName_) >= MAX_IPDR_STRING)
+				continue;
+			strcpy(serviceType, "");
+			getServiceType(serviceType, pSchemaElement->attributeName_, pErrorCode);
+			if (strcmp(serviceType, pListSchemaLookup->pSchemaLookup_->serviceType_) != 0 ||
+				getIPDRStringMap(pSchema->pElementIndex_, 
+								 pSchemaElement->attributeName_, NULL) == IPDR_TRUE)
+				continue;
+
+			if (putIPDRStringMap(pSchema->pElementIndex_, pSchemaElement->attributeName_,
+								 slot, pErrorCode) != IPDR_OK) {
+				freeElementIndex(pSchema);
+				freeIPDRStringMap(pServiceTypes);
+				free(serviceType);
+				return (IPDR_ERROR);
+			}
+			pSchema->ppIndexedElements_[slot] = pSchemaElement;
+			pSchema->pElementSequence_[slot] = sequenceNo;
+			slot++;
+		}
+	}
+
+	freeIPDRStringMap(pServiceTypes);
+	free(serviceType);
+
+	return (IPDR_OK);
+}
+
+
+/*!
+*NAME:
+*     lookupSchemaElement() 
+*
+*DESCRIPTION:
+*     Finds the schema element of an attribute name of the form
+*     serviceType$nameSpaceURI$attributeName.
+* 
+*ARGUMENTS:
+* - Poiter to IPDRCommomnParameters{IN}
+* - attributeName {IN}
+* - Integer variable to store the position of the element {OUT}
+* - Integer variable to store the error code {OUT}
+*
+* RETURNS 
+* Returns the element or NULL if the schema holds no such attribute
+*/
+
+static SchemaElement* lookupSchemaElement(
+			IPDRCommonParameters* pIPDRCommonParameters,
+			const char* attributeName,
+			int* pSequence,
+			int* pErrorCode)
+{
+	int slot = 0;
+	Schema* pSchema = pIPDRCommonParameters->pSchema_;
+
+	if (pSchema->pElementIndex_ == NULL && 
+		buildSchemaIndex(pSchema, pErrorCode) != IPDR_OK)
+		return (NULL);
+
+	if (getIPDRStringMap(pSchema->pElementIndex_, attributeName, &slot) != IPDR_TRUE)
+		return (NULL);
+
+	if (pSequence != NULL)
+		*pSequence = pSchema->pElementSequence_[slot];
+
+	return (pSchema->ppIndexedElements_[slot]);
+}
+
+
 int getAttributeNameSeq(
 			IPDRCommonParameters* pIPDRCommonParameters,
 			char* attributeName,
 			int* attSequence,
 			int* pErrorCode)
 {
-	int flag = 0;
-	int sequenceNo = 0;
-	char* serviceType;
-	ListSchemaLookup* pCurrentListSchemaLookup = NULL; 
-	ListSchemaElement*  pCurrentListSchemaElement = NULL;
-	
 	if(pIPDRCommonParameters == NULL || attributeName == NULL) {
 		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
 		return(IPDR_ERROR);
 	}
 
-	/* Getting service Type */
-	serviceType = (char *) calloc(strlen(attributeName), sizeof(char));
-	getServiceType(serviceType, attributeName, pErrorCode);
-
-	pCurrentListSchemaLookup = pIPDRCommonParameters->pSchema_->pListSchemaLookup_;
+	if (lookupSchemaElement(pIPDRCommonParameters, attributeName, 
+							attSequence, pErrorCode) == NULL)
+		*attSequence = 0;
 
-	while(pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL && flag == 0) {
-		if(strcmp(serviceType, pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->serviceType_) != 0) {
-			pIPDRCommonParameters->pSchema_->pListSchemaLookup_ = pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pNext_; 			
-		} else {
-			
-			pCurrentListSchemaElement = pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_;
-			while(pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_ != NULL && flag == 0) {
-				/*
-				printf("\nAttribute in Schema = %s", pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->attributeName_);
-				*/
-				if(strcmp(attributeName, pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->attributeName_) != 0) {
-					pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_ = 
-						pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pNext_; 
-					sequenceNo++;
-				} else {
-					*attSequence = sequenceNo + 1;
-					flag = 1;
-					break;
-				}				
-			}
-			pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_ = pCurrentListSchemaElement;
-	
-			if (flag == 0) {
-			*attSequence = 0;
-			break;
-			}
-		}
-	}
-	pIPDRCommonParameters->pSchema_->pListSchemaLookup_ = pCurrentListSchemaLookup;
-	
-	free(serviceType); 
 	return(IPDR_OK);
 }
 
@@ -474,10 +726,7 @@ int getSchemElementFromAttributeName(IPDRCommonParameters* pIPDRCommonParameters
 									 char* attributeName, 
 									 int* pErrorCode)
 {
-	int flag = 0;
-	char* serviceType;
-	ListSchemaLookup* pCurrentListSchemaLookup = NULL; 
-	ListSchemaElement*  pCurrentListSchemaElement = NULL;
+	SchemaElement* pIndexedElement = NULL;
 	
 	if(pIPDRCommonParameters == NULL || pSchemaElement == NULL ||
 		attributeName == NULL) {
@@ -485,59 +734,28 @@ int getSchemElementFromAttributeName(IPDRCommonParameters* pIPDRCommonParameters
 		return(IPDR_ERROR);
 	}
 
-	/* Getting service Type */
-	serviceType = (char *) calloc(strlen(attributeName), sizeof(char));
-	getServiceType(serviceType, attributeName, pErrorCode);
-
-	pCurrentListSchemaLookup = pIPDRCommonParameters->pSchema_->pListSchemaLookup_;
-
-	while(pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL && flag == 0) {
-		if(strcmp(serviceType, pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->serviceType_) != 0) {
-			pIPDRCommonParameters->pSchema_->pListSchemaLookup_ = pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pNext_; 			
-		} else {
-			
-			pCurrentListSchemaElement = pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_;
-			while(pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_ != NULL && flag == 0) {
-				
-				if(strcmp(attributeName, pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->attributeName_) != 0) {
-					pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_ = 
-						pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pNext_; 
-				} else {
-					initSchemaElement(
-						  pSchemaElement,
-						  pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->attributeName_,
-						  pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->attributeType_,
-						  pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->complexAttributeType_,
-						  pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->documentation_,
-						  pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->derivedType_,
-						  pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->unit_,
-						  pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->reference_,
-						  pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->status_,
-						  pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->pListAttributeEnum_,
-						  
-						  pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->pListReference_,
-						  
-						  pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->pListMinOccurs_,
-						  pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->pListMaxOccurs_,
-						  pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->noOfElements_,
-
-						  pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_->pSchemaElement_->pAttributeOptional_
-						);
-					flag = 1;
-					break;
-				}				
-			}
-			pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_ = pCurrentListSchemaElement;
-			if (flag == 0) {
-			break;
-			}
-	
-		}
+	pIndexedElement = lookupSchemaElement(pIPDRCommonParameters, attributeName, 
+										  NULL, pErrorCode);
+	if (pIndexedElement != NULL) {
+		initSchemaElement(
+			  pSchemaElement,
+			  pIndexedElement->attributeName_,
+			  pIndexedElement->attributeType_,
+			  pIndexedElement->complexAttributeType_,
+			  pIndexedElement->documentation_,
+			  pIndexedElement->derivedType_,
+			  pIndexedElement->unit_,
+			  pIndexedElement->reference_,
+			  pIndexedElement->status_,
+			  pIndexedElement->pListAttributeEnum_,
+			  pIndexedElement->pListReference_,
+			  pIndexedElement->pListMinOccurs_,
+			  pIndexedElement->pListMaxOccurs_,
+			  pIndexedElement->noOfElements_,
+			  pIndexedElement->pAttributeOptional_
+			);
 	}
-	pIPDRCommonParameters->pSchema_->pListSchemaLookup_ = pCurrentListSchemaLookup;
-	
 
-	free(serviceType); 
 	return(IPDR_OK);
 }
 
@@ -547,6 +765,7 @@ int getServiceType(char* serviceType, char* attributeName, int* pErrorCode)
 {
 	char seps[] = "$";
 	char* token;
+	char* pTokenContext = NULL;
 	char* tmpString;
 	int tokenCount = 0;
 	unsigned int strLength = 0;
@@ -560,12 +779,12 @@ int getServiceType(char* serviceType, char* attributeName, int* pErrorCode)
 	tmpString = (char *) calloc (strLength, sizeof(char));
 	strcpy(tmpString, attributeName);
 
-	token = strtok( tmpString, seps );
+	token = strtok_r( tmpString, seps, &pTokenContext );
 
 	while( token != NULL )
 	{
 	  if (tokenCount == 0) strcpy(serviceType, token);
-	  token = strtok( NULL, seps );
+	  token = strtok_r( NULL, seps, &pTokenContext );
 	  tokenCount++;
 	}
 
@@ -579,6 +798,7 @@ int getSchemaAttributeName(char* attributeName, char* key, int* pErrorCode)
 {
 	char seps[] = "$";
 	char* token;
+	char* pTokenContext = NULL;
 	char* tmpString;
 	int tokenCount = 0;
 	unsigned int strLength = 0;
@@ -592,12 +812,12 @@ int getSchemaAttributeName(char* attributeName, char* key, int* pErrorCode)
 	tmpString = (char *) calloc (strLength, sizeof(char));
 	strcpy(tmpString, key);
 
-	token = strtok( tmpString, seps );
+	token = strtok_r( tmpString, seps, &pTokenContext );
 
 	while( token != NULL )
 	{
 	  if (tokenCount == 2) strcpy(attributeName, token);
-	  token = strtok( NULL, seps );
+	  token = strtok_r( NULL, seps, &pTokenContext );
 	  tokenCount++;
 	}
 
@@ -704,7 +924,6 @@ int	getMandatoryAttributesFromSchemaForStructures(
 									int* pErrorCode)
 {
 	ListSchemaLookup* pCurrentListSchemaLookup = NULL; 
-	ListSchemaElement*  pCurrentListSchemaElement = NULL;
 	List* pCurrentListReference;
 	List* pCurrentListMinOcurs;
 	
@@ -715,29 +934,23 @@ int	getMandatoryAttributesFromSchemaForStructures(
 	}
 
 	pCurrentListSchemaLookup = pIPDRCommonParameters->pSchema_->pListSchemaLookup_;
-	while(pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL ) {
-		if(strcmp(serviceType, pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->serviceType_) != 0) {
-			pIPDRCommonParameters->pSchema_->pListSchemaLookup_ = pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pNext_; 			
+	while(pCurrentListSchemaLookup != NULL ) {
+		if(strcmp(serviceType, pCurrentListSchemaLookup->pSchemaLookup_->serviceType_) != 0) {
+			pCurrentListSchemaLookup = pCurrentListSchemaLookup->pNext_; 			
 		} else {
 					pCurrentListReference = pListSchemaElement->pSchemaElement_->pListReference_;
 					pCurrentListMinOcurs = pListSchemaElement->pSchemaElement_->pListMinOccurs_;
-					while(pListSchemaElement->pSchemaElement_->pListReference_ != NULL) {
-						if(strcmp(pListSchemaElement->pSchemaElement_->pListMinOccurs_->node, "0") == 0) {
-							appendNode(pListAttrName, pListSchemaElement->pSchemaElement_->pListReference_->node); 
+					while(pCurrentListReference != NULL) {
+						if(strcmp(pCurrentListMinOcurs->node, "0") == 0) {
+							appendNode(pListAttrName, pCurrentListReference->node); 
 						}
-						pListSchemaElement->pSchemaElement_->pListReference_ = pListSchemaElement->pSchemaElement_->pListReference_->pNext;
-						pListSchemaElement->pSchemaElement_->pListMinOccurs_ = pListSchemaElement->pSchemaElement_->pListMinOccurs_->pNext;
+						pCurrentListReference = pCurrentListReference->pNext;
+						pCurrentListMinOcurs = pCurrentListMinOcurs->pNext;
 					}
-					pListSchemaElement->pSchemaElement_->pListReference_ = pCurrentListReference;
-					pListSchemaElement->pSchemaElement_->pListMinOccurs_ = pCurrentListMinOcurs;
-
-					pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->pListSchemaElement_ = pCurrentListSchemaElement;
 					break;
 		}
 	}
 
-	pIPDRCommonParameters->pSchema_->pListSchemaLookup_ = pCurrentListSchemaLookup;
-
 	return(IPDR_OK);
 }
 
@@ -797,7 +1010,6 @@ int	validateArraySizeForAttributesFromSchemaForStructures(
 	int flag = 0;
 	char* attributeName = NULL;
 	ListSchemaLookup* pCurrentListSchemaLookup = NULL; 
-	ListSchemaElement*  pCurrentListSchemaElement = NULL;
 	ListAttributeDescriptor* pCurrentListServiceAttributeDescriptor = NULL;
 	List* pCurrentListReference;
 	List* pCurrentListMaxOcurs;
@@ -811,30 +1023,30 @@ int	validateArraySizeForAttributesFromSchemaForStructures(
 	attributeName = (char *) calloc(MAX_IPDR_STRING, sizeof(char));
 
 	pCurrentListSchemaLookup = pIPDRCommonParameters->pSchema_->pListSchemaLookup_;
-	while(pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL ) {
-		if(strcmp(serviceType, pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pSchemaLookup_->serviceType_) != 0) {
-			pIPDRCommonParameters->pSchema_->pListSchemaLookup_ = pIPDRCommonParameters->pSchema_->pListSchemaLookup_->pNext_; 			
+	while(pCurrentListSchemaLookup != NULL ) {
+		if(strcmp(serviceType, pCurrentListSchemaLookup->pSchemaLookup_->serviceType_) != 0) {
+			pCurrentListSchemaLookup = pCurrentListSchemaLookup->pNext_; 			
 		} else {
 					pCurrentListReference = pListSchemaElement->pSchemaElement_->pListReference_;
 					pCurrentListMaxOcurs = pListSchemaElement->pSchemaElement_->pListMaxOccurs_;
 
-					while(pListSchemaElement->pSchemaElement_->pListReference_ != NULL) {
+					while(pCurrentListReference != NULL) {
 						flag = 0;
 		
 						pCurrentListServiceAttributeDescriptor = pListServiceAttributeDescriptor;
-						while ((pListServiceAttributeDescriptor != NULL) && (flag == 0)) {
+						while ((pCurrentListServiceAttributeDescriptor != NULL) && (flag == 0)) {
 			
 							getSchemaAttributeName(attributeName, 
-															pListSchemaElement->pSchemaElement_->pListReference_->node,
+															pCurrentListReference->node,
 															pErrorCode);
 
-							if(strcmp(pListServiceAttributeDescriptor->pAttributeDescriptor_->attributeName_, 
+							if(strcmp(pCurrentListServiceAttributeDescriptor->pAttributeDescriptor_->attributeName_, 
 										 attributeName) == 0) 
 							{
 								flag =1;
-								if(atoi(pListSchemaElement->pSchemaElement_->pListMaxOccurs_->node) != 0) {
-									if(pListServiceAttributeDescriptor->pAttributeDescriptor_->noOfElements_ <=
-										atoi(pListSchemaElement->pSchemaElement_->pListMaxOccurs_->node)) {
+								if(atoi(pCurrentListMaxOcurs->node) != 0) {
+									if(pCurrentListServiceAttributeDescriptor->pAttributeDescriptor_->noOfElements_ <=
+										atoi(pCurrentListMaxOcurs->node)) {
 									#ifdef DEBUG_IPDR
 										printf("Valid noOfElements\n");
 									#endif
@@ -843,31 +1055,27 @@ int	validateArraySizeForAttributesFromSchemaForStructures(
 									#ifdef DEBUG_IPDR
 										printf("InValid noOfElements\n");
 									#endif
+										free(attributeName);
 										return(IPDR_ERROR);
 									}
 								}
 							} else {
-								pListServiceAttributeDescriptor = pListServiceAttributeDescriptor->pNext_; 	
+								pCurrentListServiceAttributeDescriptor = pCurrentListServiceAttributeDescriptor->pNext_; 	
 							}
 						}
 
-						pListServiceAttributeDescriptor = pCurrentListServiceAttributeDescriptor;
 						if(flag != 1) {
 							*pErrorCode = IPDR_MANDATORY_ATTR_NOT_FOUND;
+							free(attributeName);
 							return(IPDR_WARNING);
 						}
 		
-						pListSchemaElement->pSchemaElement_->pListReference_ = 
-							pListSchemaElement->pSchemaElement_->pListReference_->pNext; 
-						pListSchemaElement->pSchemaElement_->pListMaxOccurs_ = 
-							pListSchemaElement->pSchemaElement_->pListMaxOccurs_->pNext; 
+						pCurrentListReference = pCurrentListReference->pNext; 
+						pCurrentListMaxOcurs = pCurrentListMaxOcurs->pNext; 
 					}
-					pListSchemaElement->pSchemaElement_->pListReference_ = pCurrentListReference;
-					pListSchemaElement->pSchemaElement_->pListMaxOccurs_ = pCurrentListMaxOcurs;
 					break;
 			}
 		}
-		pIPDRCommonParameters->pSchema_->pListSchemaLookup_ = pCurrentListSchemaLookup;
 	
 		free(attributeName);
 		return(IPDR_OK);
@@ -0,0 +1,794 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : schemaValidator            *
+ * Description          : Schema validation of a     *
+ *                        record type, compiled once *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include "utils/schemaValidator.h"
+#include "utils/schemaUtil.h"
+#include "utils/errorHandler.h"
+#include "utils/errorCode.h"
+#include "common/schema.h"
+
+
+/*!
+ *  NAME:
+ *      freeSchemaValidator() - frees a compiled validator
+ *
+ *  DESCRIPTION:
+ *         Used as the value deallocator of pValidatorMap_.
+ *
+ *  ARGUMENTS:
+ *	    - pSchemaValidator {IN}, may be NULL
+ *
+ *  RETURNS
+ *	     Nothing
+ */
+
+void freeSchemaValidator(void* pSchemaValidator)
+{
+	int count = 0;
+	SchemaValidator* pValidator = (SchemaValidator *) pSchemaValidator;
+
+	if (pValidator == NULL)
+		return;
+
+	for (count = 0; count < pValidator->noOfSlots_; count++) {
+		free(pValidator->pSlots_[count].attributeType_);
+		free(pValidator->pSlots_[count].derivedType_);
+	}
+	free(pValidator->pSlots_);
+	freeIPDRStringMap(pValidator->pSlotIndex_);
+	free(pValidator->typeName_);
+	free(pValidator->serviceType_);
+	free(pValidator);
+}
+
+
+/*!
+ *  NAME:
+ *      copySchemaString() - heap copy of a string
+ *
+ *  ARGUMENTS:
+ *	    - pString {IN}, may be NULL
+ *
+ *  RETURNS
+ *	     Returns the copy, or NULL
+ */
+
+static char* copySchemaString(const char* pString)
+{
+	char* pCopy = NULL;
+
+	if (pString == NULL)
+		return (NULL);
+	pCopy = (char *) malloc(strlen(pString) + 1);
+	if (pCopy != NULL)
+		strcpy(pCopy, pString);
+
+	return (pCopy);
+}
+
+
+/*!
+ *  NAME:
+ *      internSchemaSlot() - slot of an attribute name
+ *
+ *  DESCRIPTION:
+ *         Returns the slot of the name, adding an unresolved one
+ *         if the name was not seen before.
+ *
+ *  ARGUMENTS:
+ *	    - pValidator {IN/OUT}
+ *	    - attributeName {IN}
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns the slot, or -1 on allocation failure
+ */
+
+static int internSchemaSlot(SchemaValidator* pValidator,
+							const char* attributeName,
+							int* pErrorCode)
+{
+	int slot = 0;
+	int capacity = 0;
+	SchemaValidatorSlot* pSlots = NULL;
+
+	if (getIPDRStringMap(pValidator->pSlotIndex_, attributeName, &slot) == IPDR_TRUE)
+		return (slot);
+
+	if (pValidator->noOfSlots_ == pValidator->slotCapacity_) {
+		capacity = pValidator->slotCapacity_ * 2;
+		if (capacity < IPDR_MAP_MIN_CAPACITY)
+			capacity = IPDR_MAP_MIN_CAPACITY;
+		pSlots = (SchemaValidatorSlot *) realloc(pValidator->pSlots_,
+												  capacity * sizeof(SchemaValidatorSlot));
+		if (pSlots == NULL) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return (-1);
+		}
+		pValidator->pSlots_ = pSlots;
+		pValidator->slotCapacity_ = capacity;
+	}
+
+	slot = pValidator->noOfSlots_;
+	if (putIPDRStringMap(pValidator->pSlotIndex_, attributeName, slot,
+						 pErrorCode) != IPDR_OK)
+		return (-1);
+
+	memset(&pValidator->pSlots_[slot], 0, sizeof(SchemaValidatorSlot));
+	pValidator->pSlots_[slot].mandatoryBit_ = -1;
+	pValidator->pSlots_[slot].resolution_ = SCHEMA_SLOT_UNRESOLVED;
+	pValidator->noOfSlots_++;
+
+	return (slot);
+}
+
+
+/*!
+ *  NAME:
+ *      resolveSchemaSlot() - looks up an attribute in the schema
+ *
+ *  DESCRIPTION:
+ *         Builds the serviceType$nameSpaceURI$attributeName key as
+ *         validateAgainstSchema() does and keeps the sequence number
+ *         and types of the schema element. A name whose namespace
+ *         prefix is not declared by the schema is marked unbound:
+ *         the list walk reuses the URI of the attribute before it
+ *         for such names, so those records keep using it.
+ *
+ *  ARGUMENTS:
+ *	    - pIPDRCommonParameters {IN}
+ *	    - pValidator {IN/OUT}
+ *	    - slot {IN}
+ *	    - attributeName {IN}
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK or IPDR_ERROR
+ */
+
+static int resolveSchemaSlot(IPDRCommonParameters* pIPDRCommonParameters,
+							 SchemaValidator* pValidator,
+							 int slot,
+							 char* attributeName,
+							 int* pErrorCode)
+{
+	int sequence = 0;
+	char* key = NULL;
+	char nameSpaceID[MAX_ATTRIBUTE_LENGTH];
+	const char* nameSpaceURI = NULL;
+	ListNameSpaceInfo* pListNameSpaceInfo = NULL;
+	SchemaElement* pSchemaElement = NULL;
+	SchemaValidatorSlot* pSlot = &pValidator->pSlots_[slot];
+
+	if (strlen(attributeName) >= MAX_ATTRIBUTE_LENGTH) {
+		pSlot->resolution_ = SCHEMA_SLOT_UNBOUND_NAMESPACE;
+		return (IPDR_OK);
+	}
+	getNameSpaceID(nameSpaceID, attributeName);
+
+	for (pListNameSpaceInfo = pIPDRCommonParameters->pSchema_->pListNameSpaceInfo_;
+		 pListNameSpaceInfo != NULL; pListNameSpaceInfo = pListNameSpaceInfo->pNext_) {
+		if (strcmp(pListNameSpaceInfo->NameSpaceInfo_.nameSpaceID_, nameSpaceID) == 0) {
+			nameSpaceURI = pListNameSpaceInfo->NameSpaceInfo_.nameSpaceURI_;
+			break;
+		}
+	}
+	if (nameSpaceURI == NULL) {
+		pSlot->resolution_ = SCHEMA_SLOT_UNBOUND_NAMESPACE;
+		return (IPDR_OK);
+	}
+
+	key = (char *) calloc(strlen(pValidator->serviceType_) + strlen(nameSpaceURI) +
+						  strlen(attributeName) + 3, sizeof(char));
+	if (key == NULL) {
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return (IPDR_ERROR);
+	}
+	sprintf(key, "%s$%s$%s", pValidator->serviceType_, nameSpaceURI, attributeName);
+
+	getAttributeNameSeq(pIPDRCommonParameters, key, &sequence, pErrorCode);
+	if (sequence == 0) {
+		free(key);
+		pSlot->resolution_ = SCHEMA_SLOT_NOT_IN_SCHEMA;
+		return (IPDR_OK);
+	}
+
+	pSchemaElement = newSchemaElement();
+	if (pSchemaElement == NULL) {
+		free(key);
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return (IPDR_ERROR);
+	}
+	getSchemElementFromAttributeName(pIPDRCommonParameters, pSchemaElement,
+									 key, pErrorCode);
+	free(key);
+
+	pSlot->attributeType_ = copySchemaString(pSchemaElement->attributeType_);
+	pSlot->derivedType_ = copySchemaString(pSchemaElement->derivedType_);
+	freeSchemaElement(pSchemaElement);
+	if (pSlot->attributeType_ == NULL || pSlot->derivedType_ == NULL) {
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return (IPDR_ERROR);
+	}
+
+	pSlot->sequence_ = sequence;
+	pSlot->resolution_ = SCHEMA_SLOT_RESOLVED;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      compileSchemaValidator() - compiles the validator of a type
+ *
+ *  DESCRIPTION:
+ *         Strips the namespace prefix from the type name and interns
+ *         the names of the mandatory attributes of its schema lookup.
+ *         The names are taken from the schema keys as
+ *         checkForMandatoryAttrInFNFData() does. Schemas with more
+ *         mandatory attributes than the bitset holds are marked to
+ *         use the list walk.
+ *
+ *  ARGUMENTS:
+ *	    - pIPDRCommonParameters {IN}
+ *	    - typeName {IN}
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns the validator, or NULL on allocation failure
+ */
+
+static SchemaValidator* compileSchemaValidator(
+							IPDRCommonParameters* pIPDRCommonParameters,
+							char* typeName,
+							int* pErrorCode)
+{
+	int slot = 0;
+	char* attributeName = NULL;
+	SchemaValidator* pValidator = NULL;
+	ListSchemaLookup* pListSchemaLookup = NULL;
+	ListSchemaElement* pListSchemaElement = NULL;
+	SchemaElement* pSchemaElement = NULL;
+
+	pValidator = (SchemaValidator *) calloc(1, sizeof(SchemaValidator));
+	attributeName = (char *) calloc(MAX_IPDR_STRING, sizeof(char));
+	if (pValidator == NULL || attributeName == NULL) {
+		free(pValidator);
+		free(attributeName);
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return (NULL);
+	}
+	pValidator->typeName_ = copySchemaString(typeName);
+	pValidator->serviceType_ = (char *) calloc(strlen(typeName) + 1, sizeof(char));
+	pValidator->pSlotIndex_ = newIPDRStringMap(0);
+	if (pValidator->typeName_ == NULL || pValidator->serviceType_ == NULL ||
+		pValidator->pSlotIndex_ == NULL) {
+		freeSchemaValidator(pValidator);
+		free(attributeName);
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return (NULL);
+	}
+
+	if (strchr(typeName, ':') == NULL)
+		strcpy(pValidator->serviceType_, typeName);
+	else
+		getIPDRSubstring(typeName, pValidator->serviceType_, ':');
+
+	for (pListSchemaLookup = pIPDRCommonParameters->pSchema_->pListSchemaLookup_;
+		 pListSchemaLookup != NULL; pListSchemaLookup = pListSchemaLookup->pNext_) {
+		if (strcmp(pValidator->serviceType_,
+				   pListSchemaLookup->pSchemaLookup_->serviceType_) == 0)
+			break;
+	}
+
+	if (pListSchemaLookup != NULL) {
+		for (pListSchemaElement = pListSchemaLookup->pSchemaLookup_->pListSchemaElement_;
+			 pListSchemaElement != NULL; pListSchemaElement = pListSchemaElement->pNext_) {
+			pSchemaElement = pListSchemaElement->pSchemaElement_;
+			if (pSchemaElement->pAttributeOptional_ != 0)
+				continue;
+
+			/* Keeps the previous name for keys without one, as the list walk does */
+			getSchemaAttributeName(attributeName, pSchemaElement->attributeName_,
+								   pErrorCode);
+			pValidator->hasMandatoryList_ = IPDR_TRUE;
+
+			slot = internSchemaSlot(pValidator, attributeName, pErrorCode);
+			if (slot < 0) {
+				freeSchemaValidator(pValidator);
+				free(attributeName);
+				return (NULL);
+			}
+			if (pValidator->pSlots_[slot].mandatoryBit_ >= 0)
+				continue;
+			if (pValidator->noOfMandatory_ == SCHEMA_VALIDATOR_MAX_MANDATORY) {
+				pValidator->useLegacy_ = IPDR_TRUE;
+				break;
+			}
+			pValidator->pSlots_[slot].mandatoryBit_ = pValidator->noOfMandatory_;
+			pValidator->mandatorySet_[pValidator->noOfMandatory_ / 32] |=
+				1U << (pValidator->noOfMandatory_ % 32);
+			pValidator->noOfMandatory_++;
+		}
+	}
+
+	free(attributeName);
+
+	return (pValidator);
+}
+
+
+/*!
+ *  NAME:
+ *      getSchemaValidator() - validator of a record type name
+ *
+ *  DESCRIPTION:
+ *         Validators are kept in pValidatorMap_ of the document,
+ *         keyed by the hash of the type name, so a shared schema is
+ *         never written to. They are dropped whenever a schema lookup
+ *         is added.
+ *
+ *  ARGUMENTS:
+ *	    - pIPDRCommonParameters {IN/OUT}
+ *	    - typeName {IN}
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns the validator, or NULL if the type has to be
+ *	     validated by the list walk
+ */
+
+static SchemaValidator* getSchemaValidator(
+							IPDRCommonParameters* pIPDRCommonParameters,
+							char* typeName,
+							int* pErrorCode)
+{
+	int key = 0;
+	SchemaValidator* pValidator = NULL;
+
+	key = (int) hashIPDRMapString(typeName);
+	if (pIPDRCommonParameters->pValidatorMap_ != NULL) {
+		pValidator = (SchemaValidator *) getIPDRIntMap(
+						pIPDRCommonParameters->pValidatorMap_, key);
+		if (pValidator != NULL)
+			return (strcmp(pValidator->typeName_, typeName) == 0 ? pValidator : NULL);
+	}
+	else {
+		pIPDRCommonParameters->pValidatorMap_ = newIPDRIntMap(0, freeSchemaValidator);
+		if (pIPDRCommonParameters->pValidatorMap_ == NULL) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return (NULL);
+		}
+	}
+
+	pValidator = compileSchemaValidator(pIPDRCommonParameters, typeName, pErrorCode);
+	if (pValidator == NULL)
+		return (NULL);
+	if (putIPDRIntMap(pIPDRCommonParameters->pValidatorMap_, key, pValidator,
+					  pErrorCode) != IPDR_OK) {
+		freeSchemaValidator(pValidator);
+		return (NULL);
+	}
+
+	return (pValidator);
+}
+
+
+/*!
+ *  NAME:
+ *      runSchemaValidator() - checks a record against a compiled
+ *      validator
+ *
+ *  DESCRIPTION:
+ *         One pass over the attributes marks the mandatory ones
+ *         present and checks order and types up to the first failure,
+ *         copying the derived types of the schema into the attribute
+ *         descriptors before it. Nothing is reported here. Once all
+ *         names of the record were seen, nothing is allocated but
+ *         derived types longer than the ones they replace.
+ *
+ *  ARGUMENTS:
+ *	    - pIPDRCommonParameters {IN}
+ *	    - pValidator {IN/OUT}
+ *	    - pFNFData {IN/OUT}
+ *	    - pOutcome {OUT}
+ *
+ *  RETURNS
+ *	     Returns IPDR_TRUE, or IPDR_FALSE if the record has to be
+ *	     validated by the list walk instead
+ */
+
+static int runSchemaValidator(IPDRCommonParameters* pIPDRCommonParameters,
+							  SchemaValidator* pValidator,
+							  FNFData* pFNFData,
+							  SchemaValidationOutcome* pOutcome)
+{
+	int slot = 0;
+	int word = 0;
+	int sequence = 0;
+	int localErrorCode = 0;
+	unsigned int presentSet[SCHEMA_VALIDATOR_SET_WORDS];
+	SchemaValidatorSlot* pSlot = NULL;
+	AttributeDescriptor* pAttributeDescriptor = NULL;
+	ListAttributeDescriptor* pListAttributeDescriptor = NULL;
+
+	memset(pOutcome, 0, sizeof(SchemaValidationOutcome));
+	pOutcome->errorSeverity_ = IPDR_OK;
+	memset(presentSet, 0, sizeof(presentSet));
+
+	for (pListAttributeDescriptor = pFNFData->pListAttributeDescriptor_;
+		 pListAttributeDescriptor != NULL;
+		 pListAttributeDescriptor = pListAttributeDescriptor->pNext_) {
+		pAttributeDescriptor = pListAttributeDescriptor->pAttributeDescriptor_;
+
+		if (getIPDRStringMap(pValidator->pSlotIndex_,
+							 pAttributeDescriptor->attributeName_, &slot) != IPDR_TRUE) {
+			/* Not mandatory; past a failure only presence matters */
+			if (pOutcome->errorSeverity_ != IPDR_OK)
+				continue;
+			/* Names outside the schema are not interned without bound */
+			if (pValidator->noOfSlots_ >= SCHEMA_VALIDATOR_MAX_SLOTS)
+				return (IPDR_FALSE);
+			slot = internSchemaSlot(pValidator, pAttributeDescriptor->attributeName_,
+									&localErrorCode);
+			if (slot < 0)
+				return (IPDR_FALSE);
+		}
+
+		pSlot = &pValidator->pSlots_[slot];
+		if (pSlot->mandatoryBit_ >= 0)
+			presentSet[pSlot->mandatoryBit_ / 32] |= 1U << (pSlot->mandatoryBit_ % 32);
+		if (pOutcome->errorSeverity_ != IPDR_OK)
+			continue;
+
+		if (pSlot->resolution_ == SCHEMA_SLOT_UNRESOLVED) {
+			if (resolveSchemaSlot(pIPDRCommonParameters, pValidator, slot,
+								  pAttributeDescriptor->attributeName_,
+								  &localErrorCode) != IPDR_OK)
+				return (IPDR_FALSE);
+			pSlot = &pValidator->pSlots_[slot];
+		}
+
+		switch (pSlot->resolution_) {
+		case SCHEMA_SLOT_NOT_IN_SCHEMA:
+			pOutcome->errorCode_ = IPDR_NO_SUCH_ATTRIBUTE_IN_SCHEMA;
+			pOutcome->errorSeverity_ = IPDR_WARNING;
+			break;
+		case SCHEMA_SLOT_RESOLVED:
+			if (pSlot->sequence_ <= sequence) {
+				pOutcome->errorCode_ = IPDR_INVALID_ORDER;
+				pOutcome->errorSeverity_ = IPDR_ERROR;
+			}
+			else if (strcmp(pSlot->attributeType_,
+							pAttributeDescriptor->attributeType_) != 0) {
+				pOutcome->errorCode_ = IPDR_DATATYPE_MISMATCH_IN_SCHEMA_AND_FNFDATA;
+				pOutcome->errorSeverity_ = IPDR_WARNING;
+			}
+			else {
+				if (setAttributeDescriptorString(pFNFData->pArena_,
+						&(pAttributeDescriptor->derivedType_), pSlot->derivedType_) != IPDR_OK)
+					return (IPDR_FALSE);
+				pOutcome->noOfCopied_++;
+			}
+			sequence = pSlot->sequence_;
+			break;
+		default:
+			/* The URI of an unbound prefix depends on the attributes before it */
+			return (IPDR_FALSE);
+		}
+	}
+
+	for (word = 0; word < SCHEMA_VALIDATOR_SET_WORDS; word++) {
+		if ((presentSet[word] & pValidator->mandatorySet_[word]) !=
+			pValidator->mandatorySet_[word]) {
+			pOutcome->mandatoryMissing_ = IPDR_TRUE;
+			break;
+		}
+	}
+
+	return (IPDR_TRUE);
+}
+
+
+/*!
+ *  NAME:
+ *      freeSchemaValidationMemo() - frees a validation memo
+ *
+ *  DESCRIPTION:
+ *         Used as the value deallocator of pValidationMemo_.
+ *
+ *  ARGUMENTS:
+ *	    - pSchemaValidationMemo {IN}, may be NULL
+ *
+ *  RETURNS
+ *	     Nothing
+ */
+
+void freeSchemaValidationMemo(void* pSchemaValidationMemo)
+{
+	int count = 0;
+	SchemaValidationMemo* pMemo = (SchemaValidationMemo *) pSchemaValidationMemo;
+
+	if (pMemo == NULL)
+		return;
+
+	for (count = 0; count < pMemo->noOfAttributes_; count++) {
+		free(pMemo->ppAttributeNames_[count]);
+		free(pMemo->ppAttributeTypes_[count]);
+		free(pMemo->ppDerivedTypes_[count]);
+	}
+	free(pMemo->ppAttributeNames_);
+	free(pMemo->ppAttributeTypes_);
+	free(pMemo->ppDerivedTypes_);
+	free(pMemo->typeName_);
+	free(pMemo);
+}
+
+
+/*!
+ *  NAME:
+ *      newSchemaValidationMemo() - records the outcome of a record
+ *
+ *  ARGUMENTS:
+ *	    - pFNFData {IN}, as validated
+ *	    - pOutcome {IN}
+ *	    - layoutOfDescriptor {IN}
+ *	    - fingerprint {IN}, of the descriptor
+ *
+ *  RETURNS
+ *	     Returns the memo, or NULL on allocation failure
+ */
+
+static SchemaValidationMemo* newSchemaValidationMemo(
+									const FNFData* pFNFData,
+									const SchemaValidationOutcome* pOutcome,
+									int layoutOfDescriptor,
+									unsigned int fingerprint)
+{
+	int count = 0;
+	int failed = IPDR_FALSE;
+	SchemaValidationMemo* pMemo = NULL;
+	const ListAttributeDescriptor* pListAttributeDescriptor = NULL;
+	const AttributeDescriptor* pAttributeDescriptor = NULL;
+
+	pMemo = (SchemaValidationMemo *) calloc(1, sizeof(SchemaValidationMemo));
+	if (pMemo == NULL)
+		return (NULL);
+
+	for (pListAttributeDescriptor = pFNFData->pListAttributeDescriptor_;
+		 pListAttributeDescriptor != NULL;
+		 pListAttributeDescriptor = pListAttributeDescriptor->pNext_)
+		count++;
+
+	pMemo->typeName_ = copySchemaString(pFNFData->typeName_);
+	pMemo->ppAttributeNames_ = (char **) calloc(count + 1, sizeof(char *));
+	pMemo->ppAttributeTypes_ = (char **) calloc(count + 1, sizeof(char *));
+	pMemo->ppDerivedTypes_ = (char **) calloc(count + 1, sizeof(char *));
+	pMemo->outcome_ = *pOutcome;
+	pMemo->layoutOfDescriptor_ = layoutOfDescriptor;
+	pMemo->fingerprint_ = fingerprint;
+	if (pMemo->typeName_ == NULL || pMemo->ppAttributeNames_ == NULL ||
+		pMemo->ppAttributeTypes_ == NULL || pMemo->ppDerivedTypes_ == NULL) {
+		freeSchemaValidationMemo(pMemo);
+		return (NULL);
+	}
+
+	for (count = 0, pListAttributeDescriptor = pFNFData->pListAttributeDescriptor_;
+		 pListAttributeDescriptor != NULL;
+		 pListAttributeDescriptor = pListAttributeDescriptor->pNext_, count++) {
+		pAttributeDescriptor = pListAttributeDescriptor->pAttributeDescriptor_;
+		pMemo->ppAttributeNames_[count] = copySchemaString(pAttributeDescriptor->attributeName_);
+		pMemo->ppAttributeTypes_[count] = copySchemaString(pAttributeDescriptor->attributeType_);
+		if (pMemo->ppAttributeNames_[count] == NULL || pMemo->ppAttributeTypes_[count] == NULL)
+			failed = IPDR_TRUE;
+		if (count < pOutcome->noOfCopied_) {
+			pMemo->ppDerivedTypes_[count] = copySchemaString(pAttributeDescriptor->derivedType_);
+			if (pMemo->ppDerivedTypes_[count] == NULL)
+				failed = IPDR_TRUE;
+		}
+		pMemo->noOfAttributes_++;
+	}
+
+	if (failed == IPDR_TRUE) {
+		freeSchemaValidationMemo(pMemo);
+		return (NULL);
+	}
+
+	return (pMemo);
+}
+
+
+/*!
+ *  NAME:
+ *      replaySchemaValidationMemo() - applies a memo to a record
+ *
+ *  DESCRIPTION:
+ *         Confirms that the record has the type name, attribute names
+ *         and attribute types the memo was recorded for, copying in
+ *         the derived types on the way. A record that differs is left
+ *         to the validator; the derived types copied by then are the
+ *         ones it would copy as well.
+ *
+ *         A record laid out as its descriptor, recorded from such a
+ *         record of the same descriptor fingerprint, has the shape
+ *         already; only the derived types are copied.
+ *
+ *  ARGUMENTS:
+ *	    - pMemo {IN}
+ *	    - pFNFData {IN/OUT}
+ *	    - layoutOfDescriptor {IN}
+ *	    - fingerprint {IN}, of the descriptor
+ *
+ *  RETURNS
+ *	     Returns IPDR_TRUE if the memo applies, IPDR_FALSE otherwise
+ */
+
+static int replaySchemaValidationMemo(const SchemaValidationMemo* pMemo,
+									  FNFData* pFNFData,
+									  int layoutOfDescriptor,
+									  unsigned int fingerprint)
+{
+	int count = 0;
+	AttributeDescriptor* pAttributeDescriptor = NULL;
+	ListAttributeDescriptor* pListAttributeDescriptor = NULL;
+
+	if (strcmp(pMemo->typeName_, pFNFData->typeName_) != 0)
+		return (IPDR_FALSE);
+
+	if (layoutOfDescriptor == IPDR_TRUE && pMemo->layoutOfDescriptor_ == IPDR_TRUE &&
+		pMemo->fingerprint_ == fingerprint) {
+		for (pListAttributeDescriptor = pFNFData->pListAttributeDescriptor_;
+			 pListAttributeDescriptor != NULL && count < pMemo->outcome_.noOfCopied_;
+			 pListAttributeDescriptor = pListAttributeDescriptor->pNext_, count++)
+			if (setAttributeDescriptorString(pFNFData->pArena_,
+					&(pListAttributeDescriptor->pAttributeDescriptor_->derivedType_),
+					pMemo->ppDerivedTypes_[count]) != IPDR_OK)
+				return (IPDR_FALSE);
+		return (IPDR_TRUE);
+	}
+
+	for (pListAttributeDescriptor = pFNFData->pListAttributeDescriptor_;
+		 pListAttributeDescriptor != NULL;
+		 pListAttributeDescriptor = pListAttributeDescriptor->pNext_, count++) {
+		pAttributeDescriptor = pListAttributeDescriptor->pAttributeDescriptor_;
+		if (count == pMemo->noOfAttributes_ ||
+			strcmp(pMemo->ppAttributeNames_[count], pAttributeDescriptor->attributeName_) != 0 ||
+			strcmp(pMemo->ppAttributeTypes_[count], pAttributeDescriptor->attributeType_) != 0)
+			return (IPDR_FALSE);
+		if (count < pMemo->outcome_.noOfCopied_ &&
+			setAttributeDescriptorString(pFNFData->pArena_, &(pAttributeDescriptor->derivedType_),
+										 pMemo->ppDerivedTypes_[count]) != IPDR_OK)
+			return (IPDR_FALSE);
+	}
+
+	return (count == pMemo->noOfAttributes_ ? IPDR_TRUE : IPDR_FALSE);
+}
+
+
+/*!
+ *  NAME:
+ *      validateWithSchemaValidator() - validates a record against
+ *      the compiled validator of its type
+ *
+ *  DESCRIPTION:
+ *         Reports the same errors, with the same severity and in the
+ *         same order, as the list walk of validateAgainstSchema(), and
+ *         copies the derived types of the schema into the attribute
+ *         descriptors; the missing mandatory attribute warning comes
+ *         before any other failure.
+ *
+ *         Given a descriptor ID, the outcome is kept in
+ *         pValidationMemo_ and replayed for the following records of
+ *         that descriptor, as long as their type name, attribute names
+ *         and attribute types match. Outcomes that end the document
+ *         are not kept. With layoutOfDescriptor set the record is
+ *         taken to have the attributes of the descriptor, so the match
+ *         is that of the descriptor fingerprint.
+ *
+ *  ARGUMENTS:
+ *	    - pIPDRCommonParameters {IN/OUT}
+ *	    - pFNFData {IN/OUT}
+ *	    - descriptorID {IN}, SCHEMA_NO_DESCRIPTOR_ID if unknown
+ *	    - layoutOfDescriptor {IN}, IPDR_TRUE if the attributes of the
+ *	      record are those of the descriptor
+ *	    - pHandled {OUT}, IPDR_FALSE if the record has to be
+ *	      validated by the list walk instead
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK, IPDR_WARNING or IPDR_ERROR
+ */
+
+int validateWithSchemaValidator(IPDRCommonParameters* pIPDRCommonParameters,
+								FNFData* pFNFData,
+								int descriptorID,
+								int layoutOfDescriptor,
+								int* pHandled,
+								int* pErrorCode)
+{
+	int localErrorCode = 0;
+	unsigned int fingerprint = 0;
+	SchemaValidator* pValidator = NULL;
+	SchemaValidationMemo* pMemo = NULL;
+	SchemaValidationOutcome outcome;
+
+	*pHandled = IPDR_FALSE;
+
+	if (descriptorID >= 0 && descriptorID < pIPDRCommonParameters->descriptorCacheSize_ &&
+		pIPDRCommonParameters->ppDescriptorCache_[descriptorID] != NULL)
+		fingerprint = pIPDRCommonParameters->pDescriptorFingerprints_[descriptorID];
+	else
+		layoutOfDescriptor = IPDR_FALSE;
+
+	if (descriptorID != SCHEMA_NO_DESCRIPTOR_ID &&
+		pIPDRCommonParameters->pValidationMemo_ != NULL)
+		pMemo = (SchemaValidationMemo *) getIPDRIntMap(
+						pIPDRCommonParameters->pValidationMemo_, descriptorID);
+
+	if (pMemo != NULL && replaySchemaValidationMemo(pMemo, pFNFData, layoutOfDescriptor,
+													fingerprint) == IPDR_TRUE) {
+		outcome = pMemo->outcome_;
+	}
+	else {
+		pValidator = getSchemaValidator(pIPDRCommonParameters, pFNFData->typeName_,
+										&localErrorCode);
+		if (pValidator == NULL || pValidator->useLegacy_ == IPDR_TRUE)
+			return (IPDR_OK);
+
+		if (pValidator->hasMandatoryList_ != IPDR_TRUE ||
+			pFNFData->pListAttributeDescriptor_ == NULL) {
+			*pHandled = IPDR_TRUE;
+			*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+			exceptionHandler(pIPDRCommonParameters, pErrorCode, "checkForMandatoryAttrInFNFData");
+			return (IPDR_ERROR);
+		}
+
+		if (runSchemaValidator(pIPDRCommonParameters, pValidator, pFNFData,
+							   &outcome) != IPDR_TRUE)
+			return (IPDR_OK);
+
+		if (descriptorID != SCHEMA_NO_DESCRIPTOR_ID && outcome.errorSeverity_ != IPDR_ERROR) {
+			if (pIPDRCommonParameters->pValidationMemo_ == NULL)
+				pIPDRCommonParameters->pValidationMemo_ =
+					newIPDRIntMap(0, freeSchemaValidationMemo);
+			pMemo = newSchemaValidationMemo(pFNFData, &outcome, layoutOfDescriptor,
+											fingerprint);
+			if (pIPDRCommonParameters->pValidationMemo_ == NULL || pMemo == NULL ||
+				putIPDRIntMap(pIPDRCommonParameters->pValidationMemo_, descriptorID,
+							  pMemo, &localErrorCode) != IPDR_OK)
+				freeSchemaValidationMemo(pMemo);
+		}
+	}
+
+	*pHandled = IPDR_TRUE;
+
+	if (outcome.mandatoryMissing_ == IPDR_TRUE) {
+		*pErrorCode = IPDR_MANDATORY_ATTR_NOT_FOUND;
+		errorHandler(pIPDRCommonParameters, pErrorCode, "checkForMandatoryAttrInFNFData");
+	}
+
+	if (outcome.errorSeverity_ != IPDR_OK)
+		*pErrorCode = outcome.errorCode_;
+
+	return (outcome.errorSeverity_);
+}
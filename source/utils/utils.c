@@ -22,6 +22,7 @@
 
 #include "utils/utils.h"
 #include "utils/errorCode.h"
+#include "utils/IPDRThread.h"
 
 
  /*!
@@ -252,13 +253,14 @@ int convLongToTime(
 {
 		
 		struct tm* newTime = NULL;
+		struct tm timeBuffer;
 		char *tempStr;
 		char mnth[3];
 		char day[3];
 		char hour[3];
 		char min[3];
 		char sec[3];
-		char temp[3];
+		char temp[4];
 		char milliSec[4];
 		
 		int milliSeconds=0;
@@ -295,7 +297,7 @@ int convLongToTime(
 
 		TimeSec1 = ((double)(*pTimeMilliSec) - milliSeconds)/1000;
 		TimeSec = (long)TimeSec1;
-		newTime = gmtime( &TimeSec );
+		newTime = gmtime_r(&TimeSec, &timeBuffer);
 
 		/*
 		newTime = localtime( &TimeSec );
@@ -371,13 +373,14 @@ int convLongMicroToTime(
 {
 		
 		struct tm* newTime = NULL;
+		struct tm timeBuffer;
 		char *tempStr;
 		char mnth[3];
 		char day[3];
 		char hour[3];
 		char min[3];
 		char sec[3];
-		char temp[3];
+		char temp[7];
 		char microSec[7];
 		
 		int microSeconds=0;
@@ -416,7 +419,7 @@ int convLongMicroToTime(
 
 		TimeSec1 = ((double)(*pTimeMicroSec) - microSeconds)/1000000;
 		TimeSec = (long)TimeSec1;
-		newTime = gmtime( &TimeSec );
+		newTime = gmtime_r(&TimeSec, &timeBuffer);
 
 		/*
 		newTime = localtime( &TimeSec );
@@ -525,6 +528,7 @@ int convLongToDateTime(
 {
 		
 		struct tm* newTime = NULL;
+		struct tm timeBuffer;
 		char mnth[3];
 		char day[3];
 		char hour[3];
@@ -545,7 +549,7 @@ int convLongToDateTime(
 		TimeSec = (int)((*pTimelong)-(*pTimelong) % 1000) / 1000;
 	
 		/*gmtime( &TimeSec );*/
-		newTime = gmtime( &TimeSec );
+		newTime = gmtime_r(&TimeSec, &timeBuffer);
 			
 		/*newTime = localtime( &TimeSec );*/
 		
@@ -627,6 +631,7 @@ int convIntToDateTime(
 {
 		
 		struct tm* newTime = NULL;
+		struct tm timeBuffer;
 		char mnth[3];
 		char day[3];
 		char hour[3];
@@ -642,7 +647,7 @@ int convIntToDateTime(
 		}
 				
 		TimeSec =  (long) *pTimelnt;
-		newTime = gmtime(&TimeSec);
+		newTime = gmtime_r(&TimeSec, &timeBuffer);
 
 		sprintf(timeStr, "%d%s", newTime->tm_year + 1900, DASH);
 
@@ -1782,7 +1787,8 @@ int convIntToIPv4Addr(int IPV4, char* strIPV4, int* pErrorCode)
  *  DESCRIPTION:
  *      This method takes as input the IPV4Addr address string and 
  *      converts it into an integer. That integer is then returned as 
- *      output.
+ *      output. A value without dots is taken as the decimal value of 
+ *      the address.
  *  
  *  ARGUMENTS:
  *       -  strIPV4 (IN)
@@ -1801,7 +1807,7 @@ int convIPv4AddrToInt(char* strIPV4, int* addr, int* pErrorCode)
 	int count1 = 0;
 	int count2 = 0;
 
-	int IPV4[4];
+	int IPV4[4] = {0, 0, 0, 0};
 
 
 	if ((strIPV4 == NULL) || (addr == NULL)) {
@@ -1813,10 +1819,24 @@ int convIPv4AddrToInt(char* strIPV4, int* addr, int* pErrorCode)
 	printf("\n IPV4 Len (%d) strIPV4(%s)", (int)strlen(strIPV4), strIPV4);
 	#endif
 
+	/* Without a schema the address is written as its decimal value */
+	if (strchr(strIPV4, '.') == NULL) {
+		*addr = atoi(strIPV4);
+		return (IPDR_OK);
+	}
+
 	for(count = 0; count < (int)strlen(strIPV4); count++) {
 		if (strIPV4[count] != '.') {
+			if (count1 == 3) {
+				*pErrorCode = IPDR_INVALID_IPV4ADDR;
+				return (IPDR_INVALID_IPV4ADDR);
+			}
 			tempStr[count1++] = strIPV4[count];
 		} else {
+			if (count2 == 3) {
+				*pErrorCode = IPDR_INVALID_IPV4ADDR;
+				return (IPDR_INVALID_IPV4ADDR);
+			}
 			tempStr[count1] = '\0';
 			IPV4[count2++] = atoi(tempStr);
 			count1 = 0;
@@ -2399,13 +2419,14 @@ int convLongToTimeHeader(
 {
 		
 		struct tm* newTime = NULL;
+		struct tm timeBuffer;
 		char *tempStr;
 		char mnth[3];
 		char day[3];
 		char hour[3];
 		char min[3];
 		char sec[3];
-		char temp[3];
+		char temp[4];
 		char milliSec[4];
 		
 		int milliSeconds=0;
@@ -2447,7 +2468,7 @@ int convLongToTimeHeader(
 
 		time( &TimeSec );
 
-		newTime = gmtime( &TimeSec );
+		newTime = gmtime_r(&TimeSec, &timeBuffer);
 			
 		
 		sprintf(timeStr, "%d%s", newTime->tm_year+1900, DASH);
@@ -2699,9 +2720,10 @@ int getNameSpaceID(
 {
  char* temp;
  char* token;
+ char* pTokenContext = NULL;
  temp = (char *) calloc(strlen(key) + 1, sizeof(char));
  strcpy(temp, key);
- token = strtok(temp, ":");
+ token = strtok_r(temp, ":", &pTokenContext);
  if(!strcmp(key,token)) strcpy(service,"ipdr");
  else 
   strcpy(service, token);
@@ -2864,6 +2886,7 @@ int tokenizeKey(
 				)
 {
    char* token;
+   char* pTokenContext = NULL;
    char seps[] = "$";
    int tokenCount = 0;
 
@@ -2874,14 +2897,14 @@ int tokenizeKey(
    tmpString = (char *) calloc (strLength, sizeof(char));
    strcpy(tmpString, key);
 
-   token = strtok( tmpString, seps );
+   token = strtok_r( tmpString, seps, &pTokenContext );
 
    while( token != NULL )
    {
       if (tokenCount == 0) strcpy(serviceType, token);
       if (tokenCount == 1) strcpy(nameSpaceURI, token);
       if (tokenCount == 2) strcpy(attributeName, token);
-      token = strtok( NULL, seps );
+      token = strtok_r( NULL, seps, &pTokenContext );
       tokenCount++;
  }
 
@@ -2960,18 +2983,17 @@ int validateDocID(char* docID, int* pErrorCode)
 /*!
  *  NAME:
  *      validateAttributeName() - This function put Input Descriptor 
- *                                        in a Name-Type Code structure (Hash Table).   
+ *                                        in a name map for duplicate checks.   
  *                     
  *  DESCRIPTION:
  *     	- This function retrieve the Name-Type pair set from the addresses given in 
  *        Input as array of pointers
- *      - Call hashTableCreation & hashTablePut function for creating 
- *        AttributeDescriptor Hash Table (as a set of Name-Type pair) 
- *		  for validating for dublicate attibute names
+ *      - Adds every attribute name to a string map and reports an 
+ *		  attribute name that is already present as a duplicate
  *
  *	ARGUMENTS:
  *      - ListAttributeDescriptor {IN/ OUT}
- *      - AttributeDescriptorHashTable {local variable}
+ *      - AttributeNameMap {local variable}
  *		- pErrorCode { IN / OUT }
  *
  *  RETURNS 	
@@ -2984,14 +3006,10 @@ int validateAttributeName(
 						 int* pErrorCode
 						)	
 {	
-
-	char* resultGet = NULL;
-	
 	int count = 0;
-	int numOfBuckets = 0;
 	int listAttributeDescriptorLength = 0;
 	
-	HashTable* AttributeDescriptorHashTable;
+	IPDRStringMap* pAttributeNameMap;
 
 	if(pListAttributeDescriptor == NULL || 
 		pIPDRCommonParameters == NULL) {
@@ -2999,38 +3017,35 @@ int validateAttributeName(
 	    return (IPDR_ERROR);
 	}
 	
-	/* Number of Hash Table elements (Buckets) = RECORDS */
-	numOfBuckets = HASH_BUCKETS;
-	AttributeDescriptorHashTable = HashTableCreate(numOfBuckets); 
 	listAttributeDescriptorLength = getLengthListAttributeDescriptor(pListAttributeDescriptor);
+	pAttributeNameMap = newIPDRStringMap(listAttributeDescriptorLength); 
+	if (pAttributeNameMap == NULL) {
+	    *pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+	    return (IPDR_ERROR);
+	}
     
-	/*
-	This function will insert a Attribute Descriptor in the hash table and perform the 
-        validation for dublicate Attribute Name Check using hash table properties. It will take Attribute 
-	Name as Key for hash table and hash table has a property that Key cannot be dublicated.	
-    */	
+	/* The position of each name is kept as its value */
 	for(count = 0; count < listAttributeDescriptorLength; count++) {
 
-		resultGet = (char *) HashTableGet(
-			        AttributeDescriptorHashTable, 
-				    pListAttributeDescriptor->pAttributeDescriptor_->attributeName_
-					);
-
-		if (resultGet == NULL) {
+		if (getIPDRStringMap(pAttributeNameMap, 
+				    pListAttributeDescriptor->pAttributeDescriptor_->attributeName_,
+					NULL) == IPDR_TRUE) {
+			freeIPDRStringMap(pAttributeNameMap);
+			*pErrorCode = IPDR_DUPLICATE_ATTRIBUTE_NAME;
+			return(IPDR_ERROR);
+		}
 		
-			HashTablePutstr(AttributeDescriptorHashTable, 
+		if (putIPDRStringMap(pAttributeNameMap, 
                             pListAttributeDescriptor->pAttributeDescriptor_->attributeName_, 
-                            pListAttributeDescriptor->pAttributeDescriptor_->attributeType_);	
-		
-			pListAttributeDescriptor = pListAttributeDescriptor->pNext_; 
-		}
-		else {
-			*pErrorCode = IPDR_DUPLICATE_ATTRIBUTE_NAME;
+                            count, pErrorCode) != IPDR_OK) {
+			freeIPDRStringMap(pAttributeNameMap);
 			return(IPDR_ERROR);
 		}
+		
+		pListAttributeDescriptor = pListAttributeDescriptor->pNext_; 
 	}
 	
-	HashTableDestroy (AttributeDescriptorHashTable);
+	freeIPDRStringMap(pAttributeNameMap);
 	
 	return (IPDR_OK);
 }
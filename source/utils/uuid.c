@@ -41,6 +41,8 @@
   static void get_current_time(uuid_time_t * timestamp);
   static unsigned16 true_random(void);
 
+  IPDRMutex gUUIDMutex = IPDR_MUTEX_INITIALIZER;
+
  /*!
  *  NAME:
  *      uuid_create() - function to create UUID.
@@ -231,6 +233,7 @@
   static void get_current_time(uuid_time_t * timestamp) {
       uuid_time_t                time_now;
       static uuid_time_t  time_last;
+      static uuid_time_t  timestamp_last;
       static unsigned16   uuids_this_tick;
     static int                   inited = 0;
 
@@ -255,8 +258,16 @@
         };
         /*! going too fast for our clock; spin */
       };
+      time_last = time_now;
+
     /*! add the count of uuids to low order bits of the clock reading */
     *timestamp = time_now + uuids_this_tick;
+
+    /*! the clock resolution is coarser than UUIDS_PER_TICK ticks on
+       some systems, never hand out a timestamp twice */
+    if (*timestamp <= timestamp_last)
+        *timestamp = timestamp_last + 1;
+    timestamp_last = *timestamp;
   }
 
   /*! true_random -- generate a crypto-quality random number.
@@ -20,6 +20,7 @@
  *****************************************************/
 
 #include "xdr/AttributeDescriptorHelper.h"
+#include "utils/IPDRThread.h"
 
 /*!
  *  NAME:
@@ -54,6 +55,7 @@ int writeAttributeDescriptorHelper(
    char* tempComplexType = NULL; 
    char * tempString = NULL;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
 	
 	if(pAttributeDescriptor == NULL ||
 		pIPDRCommonParameters == NULL
@@ -67,7 +69,7 @@ if(pAttributeDescriptor->complexType_[0] != '\0') {
 	tempString = (char *) calloc(strlen(pAttributeDescriptor->complexType_) + 1, sizeof(char));
 	tempComplexType = (char *) calloc(strlen(pAttributeDescriptor->complexType_) + 1, sizeof(char));
 	strcpy(tempString, pAttributeDescriptor->complexType_);
-	serviceTypeToken = strtok(tempString, ":");
+	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 	
 	if(strcmp(pAttributeDescriptor->complexType_,serviceTypeToken)) {
 		getIPDRSubstring(pAttributeDescriptor->complexType_, tempComplexType, ':');
@@ -85,16 +87,16 @@ if(pAttributeDescriptor->complexType_[0] != '\0') {
 	} else {
 		attributeNameLength = strlen(pAttributeDescriptor->attributeName_);
 		write_long(attributeNameLength, 
-			pIPDRCommonParameters->pStreamHandle_);
+			pIPDRCommonParameters->pOutputBuffer_);
 		write_wstring((wchar *) pAttributeDescriptor->attributeName_, 
-			pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+			pIPDRCommonParameters->pOutputBuffer_, pIPDRCommonParameters->schemaVersion);
 
 		if(pAttributeDescriptor->noOfElements_ !=0) {
 			ltypeCode = convAttributeTypeToTypeCode(pAttributeDescriptor->attributeType_);
 			typeCode = IPDRDATA_ARRAY | ltypeCode;
-			write_long(typeCode, pIPDRCommonParameters->pStreamHandle_);
+			write_long(typeCode, pIPDRCommonParameters->pOutputBuffer_);
 
-			write_long(pAttributeDescriptor->noOfElements_, pIPDRCommonParameters->pStreamHandle_);
+			write_long(pAttributeDescriptor->noOfElements_, pIPDRCommonParameters->pOutputBuffer_);
 		} else {
 			typeCode = convAttributeTypeToTypeCode(pAttributeDescriptor->attributeType_);
 
@@ -102,7 +104,7 @@ if(pAttributeDescriptor->complexType_[0] != '\0') {
          if((strcmp(pIPDRCommonParameters->schemaVersion, IPDR_VERSION_3_5)) != 0) {
              typeCode = typeCode & 0x0000000F;
          }
-			write_long(typeCode, pIPDRCommonParameters->pStreamHandle_);
+			write_long(typeCode, pIPDRCommonParameters->pOutputBuffer_);
 		}
 	}
 	
@@ -146,6 +148,7 @@ int writeComplexAttributeDescriptorHelper(
 	char* tempComplexType;
    char * tempString;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
 
 	List* pcurrentMaxOccrsList = NULL;
 	List* pcurrent = NULL;
@@ -167,14 +170,14 @@ int writeComplexAttributeDescriptorHelper(
 
 	attributeNameLength = strlen(pAttributeDescriptor->attributeName_);
 	write_long(attributeNameLength, 
-			pIPDRCommonParameters->pStreamHandle_);
+			pIPDRCommonParameters->pOutputBuffer_);
 	write_wstring((wchar *) pAttributeDescriptor->attributeName_, 
-			pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+			pIPDRCommonParameters->pOutputBuffer_, pIPDRCommonParameters->schemaVersion);
 
 	if(pAttributeDescriptor->noOfElements_ !=0) {
 		ltypeCode = IPDRDATA_STRUCTURE;
 		typeCode = IPDRDATA_ARRAY | ltypeCode;
-		write_long(typeCode, pIPDRCommonParameters->pStreamHandle_);
+		write_long(typeCode, pIPDRCommonParameters->pOutputBuffer_);
 
 		pCurrent = pListServiceAttributeDescriptor;
 		attributeDescriptorLength = getLengthListAttributeDescriptor(pCurrent);
@@ -185,12 +188,12 @@ int writeComplexAttributeDescriptorHelper(
 			}
 			pCurrent = pCurrent->pNext_;
 		}
-		write_long(getLength(pCurrent->pAttributeDescriptor_->pListAttrNameList_), pIPDRCommonParameters->pStreamHandle_);
+		write_long(getLength(pCurrent->pAttributeDescriptor_->pListAttrNameList_), pIPDRCommonParameters->pOutputBuffer_);
 
-		write_long(pAttributeDescriptor->noOfElements_, pIPDRCommonParameters->pStreamHandle_);
+		write_long(pAttributeDescriptor->noOfElements_, pIPDRCommonParameters->pOutputBuffer_);
 	} else {
 		typeCode = IPDRDATA_STRUCTURE;
-		write_long(typeCode, pIPDRCommonParameters->pStreamHandle_);
+		write_long(typeCode, pIPDRCommonParameters->pOutputBuffer_);
 		pCurrent = pListServiceAttributeDescriptor;
 		attributeDescriptorLength = getLengthListAttributeDescriptor(pCurrent);
 		for (count = 0; count < attributeDescriptorLength; count++) {
@@ -200,7 +203,7 @@ int writeComplexAttributeDescriptorHelper(
 			}
 			pCurrent = pCurrent->pNext_;
 		}
-		write_long(getLength(pCurrent->pAttributeDescriptor_->pListAttrNameList_), pIPDRCommonParameters->pStreamHandle_);
+		write_long(getLength(pCurrent->pAttributeDescriptor_->pListAttrNameList_), pIPDRCommonParameters->pOutputBuffer_);
 	}
 
 	attributeDescriptorLength = getLengthListAttributeDescriptor(pListServiceAttributeDescriptor);
@@ -220,7 +223,7 @@ int writeComplexAttributeDescriptorHelper(
 							tempString = (char *) calloc(strlen(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_) + 1, sizeof(char));
 							tempComplexType = (char *) calloc(strlen(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_) + 1, sizeof(char));
 							strcpy(tempString, pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_);
-							serviceTypeToken = strtok(tempString, ":");
+							serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 	
 							if(strcmp(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_,serviceTypeToken)) {
 							getIPDRSubstring(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_, 
@@ -237,21 +240,21 @@ int writeComplexAttributeDescriptorHelper(
 				} else {
 						attributeNameLength = strlen(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->attributeName_);
 						write_long(attributeNameLength, 
-										pIPDRCommonParameters->pStreamHandle_);
+										pIPDRCommonParameters->pOutputBuffer_);
 						write_wstring((wchar *) pOldListServiceAttributeDescriptor->pAttributeDescriptor_->attributeName_, 
-											pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+											pIPDRCommonParameters->pOutputBuffer_, pIPDRCommonParameters->schemaVersion);
 
 
               		if((pcurrentMaxOccrsList != NULL)) {
 							if((strcmp(pcurrentMaxOccrsList->node, "0") != 0)) {
 								ltypeCode = convAttributeTypeToTypeCode(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->attributeType_);  
 								typeCode = IPDRDATA_ARRAY | ltypeCode;
-								write_long(typeCode, pIPDRCommonParameters->pStreamHandle_);
+								write_long(typeCode, pIPDRCommonParameters->pOutputBuffer_);
 
-								write_long(atoi(pcurrentMaxOccrsList->node), pIPDRCommonParameters->pStreamHandle_);
+								write_long(atoi(pcurrentMaxOccrsList->node), pIPDRCommonParameters->pOutputBuffer_);
 							} else {
 								typeCode = convAttributeTypeToTypeCode(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->attributeType_);
-								write_long(typeCode, pIPDRCommonParameters->pStreamHandle_);
+								write_long(typeCode, pIPDRCommonParameters->pOutputBuffer_);
 							}
               		}
 					}
@@ -317,15 +320,15 @@ int readAttributeDescriptorHelper( 	IPDRCommonParameters *pIPDRCommonParameters,
 		return(IPDR_ERROR);
 	}
 
-	attributeNameLength = read_long(pIPDRCommonParameters->pStreamHandle_);
+	attributeNameLength = read_long(pIPDRCommonParameters->pInputBuffer_);
 
 	tmpString = read_wstring(attributeNameLength, 
-		pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+		pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 
 	strcpy(pAttributeDescriptor->attributeName_, (char *) tmpString);
 	free(tmpString);
 
-	attributeTypeCode = read_long(pIPDRCommonParameters->pStreamHandle_);
+	attributeTypeCode = read_long(pIPDRCommonParameters->pInputBuffer_);
 
 	sprintf(typeCode, "%0x", attributeTypeCode);
 	if((strlen(typeCode) > 4) && (typeCode[0] == '4') || (typeCode[0] == 'c')) {
@@ -350,7 +353,7 @@ int readAttributeDescriptorHelper( 	IPDRCommonParameters *pIPDRCommonParameters,
 		return(IPDR_OK);
 	} else {
 		if(arrayFlag == 1) {
-			maxLen = read_long(pIPDRCommonParameters->pStreamHandle_);
+			maxLen = read_long(pIPDRCommonParameters->pInputBuffer_);
 			pAttributeDescriptor->noOfElements_ = maxLen;
 		}
 	}
@@ -410,7 +413,6 @@ int readCompositeDescriptor(char* attrName,
 	int attributeNameLength = 0;
 	int attributeTypeCode = 0;
 	int errorSeverity = 0;
-	static int AttributeFlag = 0;
 	char complexType[MAX_LEN];
 	char typeCode[MAX_LEN];
 	char maxLenTemp[MAX_LEN];
@@ -419,15 +421,15 @@ int readCompositeDescriptor(char* attrName,
 
 	pAttributeDescriptor = newAttributeDescriptor();
 
-	compLength = read_long(pIPDRCommonParameters->pStreamHandle_);
+	compLength = read_long(pIPDRCommonParameters->pInputBuffer_);
 
    if(arrayflag == 1) 
-		maxLen = read_long(pIPDRCommonParameters->pStreamHandle_);
+		maxLen = read_long(pIPDRCommonParameters->pInputBuffer_);
 
 	strcpy(complexType, attrName);
 	strcat(complexType,"Type");
 
-if(AttributeFlag == 0) {
+if(pIPDRCommonParameters->compositeDescriptorFlag_ == 0) {
 	appendListAttributeDescriptor(&(*pListAttributeDescriptor),
 		attrName,
    	"UTF8_ARRAY",
@@ -439,7 +441,7 @@ if(AttributeFlag == 0) {
 		NULL,
       maxLen	
    );
-	AttributeFlag = 1;
+	pIPDRCommonParameters->compositeDescriptorFlag_ = 1;
 } else {
 	appendListAttributeDescriptor(&(*pListServiceAttributeDescriptor),
 		attrName,
@@ -452,21 +454,21 @@ if(AttributeFlag == 0) {
 		NULL,
       maxLen	
    );
-	AttributeFlag = 0;
+	pIPDRCommonParameters->compositeDescriptorFlag_ = 0;
 }
 
 	for(i = 0; i < compLength; i++) {
 		childMaxLen = 0;
 		childArrayFlag = 0;
-   	attributeNameLength = read_long(pIPDRCommonParameters->pStreamHandle_);
+   	attributeNameLength = read_long(pIPDRCommonParameters->pInputBuffer_);
    
    	tmpString = read_wstring(attributeNameLength, 
-   		pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+   		pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
    
    	strcpy(pAttributeDescriptor->attributeName_, (char *) tmpString);
    	free(tmpString);
    
-   	attributeTypeCode = read_long(pIPDRCommonParameters->pStreamHandle_);
+   	attributeTypeCode = read_long(pIPDRCommonParameters->pInputBuffer_);
    
    	sprintf(typeCode, "%0x", attributeTypeCode);
    	if((strlen(typeCode) > 4) && (typeCode[0] == '4') || (typeCode[0] == 'c')) {
@@ -475,7 +477,7 @@ if(AttributeFlag == 0) {
    	}
    	
    	if(attributeTypeCode == IPDRDATA_STRUCTURE) {
-			AttributeFlag = 1;
+			pIPDRCommonParameters->compositeDescriptorFlag_ = 1;
    		readCompositeDescriptor(pAttributeDescriptor->attributeName_,
 											childArrayFlag, 
    										&(*pListAttributeDescriptor), 
@@ -485,7 +487,7 @@ if(AttributeFlag == 0) {
    									  );
    	} else {
    		if(childArrayFlag == 1) {
-   			childMaxLen = read_long(pIPDRCommonParameters->pStreamHandle_);
+   			childMaxLen = read_long(pIPDRCommonParameters->pInputBuffer_);
    			pAttributeDescriptor->noOfElements_ = childMaxLen;
    		}
 			errorSeverity = convTypeCodeToAttributeType(attributeTypeCode, pAttributeDescriptor->attributeType_);
@@ -508,7 +510,7 @@ if(AttributeFlag == 0) {
 													NULL,
       											0	
    											  );
-			AttributeFlag = 0;
+			pIPDRCommonParameters->compositeDescriptorFlag_ = 0;
    	}
 		appendNode (&(pAttributeDescriptor->pListAttrNameList_),
 							 pAttributeDescriptor->attributeName_);
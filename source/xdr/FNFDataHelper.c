@@ -22,6 +22,8 @@
 
 
 #include "xdr/FNFDataHelper.h"
+#include "xdr/XDRCodecPlan.h"
+#include "utils/IPDRThread.h"
 
 
 /*!
@@ -54,11 +56,13 @@ int writeFNFDataHelper(IPDRCommonParameters* pIPDRCommonParameters,
    char* tempComplexType = NULL; 
    char * tempString = NULL;
 	char* serviceTypeToken=NULL;
+	char* pTokenContext = NULL;
 		
 	ListIPDRData* pCurrentListIPDRData = NULL;
 	ListAttributeDescriptor* pCurrentListAttributeDescriptor = NULL; 
  	ListIPDRArrayData* pCurrentListIPDRArrayData = NULL;
  	ListIPDRStructureData* pCurrentListIPDRStructureData = NULL;
+	const XDRCodecPlan* pCodecPlan = NULL;
 
 	if(pFNFData == NULL || pIPDRCommonParameters == NULL) {
 		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
@@ -68,8 +72,14 @@ int writeFNFDataHelper(IPDRCommonParameters* pIPDRCommonParameters,
 	pCurrentListIPDRData = pFNFData->pListIPDRData_; 
 	pCurrentListAttributeDescriptor = pFNFData->pListAttributeDescriptor_; 
 	
+	write_long(IPDR_INDEFINITE_LENGTH_INDICATOR, pIPDRCommonParameters->pOutputBuffer_); 
+
+	/* Records without structures are written through the compiled plan */
+	pCodecPlan = getXDRCodecPlan(pIPDRCommonParameters, pFNFData->descriptorID_);
+	if (pCodecPlan != NULL && pCodecPlan->hasStructures_ == IPDR_FALSE)
+		return (writeXDRCodecPlan(pIPDRCommonParameters, pCodecPlan, pFNFData, pErrorCode));
+
 	listIPDRDataLength = getLengthListIPDRData(pFNFData->pListIPDRData_);
-	write_long(IPDR_INDEFINITE_LENGTH_INDICATOR, pIPDRCommonParameters->pStreamHandle_); 
 	
 	for (count = 0; count < listIPDRDataLength; count++)
 	{
@@ -78,7 +88,7 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
    	tempString = (char *) calloc(strlen(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_) + 1, sizeof(char));
    	tempComplexType = (char *) calloc(strlen(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_) + 1, sizeof(char));
    	strcpy(tempString, pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_);
-   	serviceTypeToken = strtok(tempString, ":");
+   	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
    	
    	if(strcmp(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_,serviceTypeToken)) {
    		getIPDRSubstring(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_, tempComplexType, ':');
@@ -98,7 +108,7 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
    
    		if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
    				pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = pFNFData->pListIPDRData_->pListIPDRStructureData_->noOfElements_;
-				write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pStreamHandle_);
+				write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pOutputBuffer_);
    			pCurrentListIPDRStructureData = pFNFData->pListIPDRData_->pListIPDRStructureData_;
    			for(cnt = 0;cnt < (pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_);
                    cnt++) { 
@@ -135,20 +145,20 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 			  		if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 			  			pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = pFNFData->pListIPDRData_->noOfElements_; 
 						/*writing number of Elements*/
-						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pStreamHandle_);
+						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pOutputBuffer_);
 						pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRArrayData_;
 						for(cnt = 0;cnt < (pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_);
                 	cnt++) { 
 							/*write_long((int) pFNFData->pListIPDRData_->pListIPDRArrayData_->IPDRDataUnion_.IPDRLong_, 
-											pIPDRCommonParameters->pStreamHandle_);*/
+											pIPDRCommonParameters->pOutputBuffer_);*/
 							write_long((int) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRLong_, 
-											pIPDRCommonParameters->pStreamHandle_);
+											pIPDRCommonParameters->pOutputBuffer_);
 
 							pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;
 						}
 					} else {
 						write_long((int) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRLong_, 
-										pIPDRCommonParameters->pStreamHandle_);
+										pIPDRCommonParameters->pOutputBuffer_);
 					}
                break;
 
@@ -160,18 +170,18 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 			  		if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 			  			pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = pFNFData->pListIPDRData_->noOfElements_; 
 						/*writing number of Elements*/
-						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pStreamHandle_);
+						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pOutputBuffer_);
 						pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRArrayData_;
 						for(cnt = 0;cnt < (pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_);
                 	cnt++) { 
 							write_u_long((unsigned int) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRULong_, 
-												pIPDRCommonParameters->pStreamHandle_);
+												pIPDRCommonParameters->pOutputBuffer_);
 
 							pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;
 						}
 					} else {
 						write_u_long((unsigned int) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRULong_, 
-						pIPDRCommonParameters->pStreamHandle_);
+						pIPDRCommonParameters->pOutputBuffer_);
 					}
                break;
 
@@ -183,18 +193,18 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 			  		if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 			  			pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = pFNFData->pListIPDRData_->noOfElements_; 
 						/*writing number of Elements*/
-						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pStreamHandle_);
+						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pOutputBuffer_);
 						pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRArrayData_;
 						for(cnt = 0;cnt < (pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_);
                 	cnt++) { 
 							write_longlong((hyper) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRLongLong_, 
-												pIPDRCommonParameters->pStreamHandle_);
+												pIPDRCommonParameters->pOutputBuffer_);
 
 							pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;
 						}
 					} else {
 						write_longlong((hyper) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRLongLong_, 
-											pIPDRCommonParameters->pStreamHandle_);
+											pIPDRCommonParameters->pOutputBuffer_);
 					}
                break;
 
@@ -206,18 +216,18 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 			  		if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 			  			pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = pFNFData->pListIPDRData_->noOfElements_; 
 						/*writing number of Elements*/
-						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pStreamHandle_);
+						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pOutputBuffer_);
 						pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRArrayData_;
 						for(cnt = 0;cnt < (pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_);
                 	cnt++) { 
 							write_u_longlong((u_hyper) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRULongLong_, 
-													pIPDRCommonParameters->pStreamHandle_);
+													pIPDRCommonParameters->pOutputBuffer_);
 
 							pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;
 						}
 					} else {
 							write_u_longlong((u_hyper) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRULongLong_, 
-													pIPDRCommonParameters->pStreamHandle_);
+													pIPDRCommonParameters->pOutputBuffer_);
 					}
                break;
 
@@ -229,18 +239,18 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 			  		if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 			  			pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = pFNFData->pListIPDRData_->noOfElements_; 
 						/*writing number of Elements*/
-						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pStreamHandle_);
+						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pOutputBuffer_);
 						pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRArrayData_;
 						for(cnt = 0;cnt < (pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_);
                 	cnt++) { 
 							write_float((float) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRFloat_, 
-											pIPDRCommonParameters->pStreamHandle_);
+											pIPDRCommonParameters->pOutputBuffer_);
 
 							pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;
 						}
 					} else {
 						write_float((float) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRFloat_, 
-										pIPDRCommonParameters->pStreamHandle_);
+										pIPDRCommonParameters->pOutputBuffer_);
 					}
                break;
 
@@ -252,18 +262,18 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 			  		if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 			  			pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = pFNFData->pListIPDRData_->noOfElements_; 
 						/*writing number of Elements*/
-						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pStreamHandle_);
+						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pOutputBuffer_);
 						pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRArrayData_;
 						for(cnt = 0;cnt < (pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_);
                 	cnt++) { 
 							write_double((double) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRDouble_, 
-											 pIPDRCommonParameters->pStreamHandle_);
+											 pIPDRCommonParameters->pOutputBuffer_);
 
 							pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;
 						}
 					} else {
 						write_double((double) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRDouble_, 
-										 pIPDRCommonParameters->pStreamHandle_);
+										 pIPDRCommonParameters->pOutputBuffer_);
 					}
                break;
 
@@ -275,20 +285,20 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 			  		if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 			  			pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = pFNFData->pListIPDRData_->noOfElements_; 
 						/*writing number of Elements*/
-						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pStreamHandle_);
+						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pOutputBuffer_);
 						pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRArrayData_;
 						for(cnt = 0;cnt < (pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_);
                 	cnt++) { 
 							byteArrayLength = getByteArrayLength(pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_);
-							write_long(byteArrayLength, pIPDRCommonParameters->pStreamHandle_);
-							write_noctet_array(pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_, pIPDRCommonParameters->pStreamHandle_, byteArrayLength, pIPDRCommonParameters->schemaVersion);     
+							write_long(byteArrayLength, pIPDRCommonParameters->pOutputBuffer_);
+							write_noctet_array(pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_, pIPDRCommonParameters->pOutputBuffer_, byteArrayLength, pIPDRCommonParameters->schemaVersion);     
 
 							pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;
 						}
 					} else {
 						byteArrayLength = getByteArrayLength(pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRByteArray_);
-						write_long(byteArrayLength, pIPDRCommonParameters->pStreamHandle_);
-						write_noctet_array(pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRByteArray_, pIPDRCommonParameters->pStreamHandle_, byteArrayLength, pIPDRCommonParameters->schemaVersion);     
+						write_long(byteArrayLength, pIPDRCommonParameters->pOutputBuffer_);
+						write_noctet_array(pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRByteArray_, pIPDRCommonParameters->pOutputBuffer_, byteArrayLength, pIPDRCommonParameters->schemaVersion);     
 					}
 					break;
 
@@ -300,18 +310,18 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 			  		if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 			  			pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = pFNFData->pListIPDRData_->noOfElements_; 
 						/*writing number of Elements*/
-						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pStreamHandle_);
+						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pOutputBuffer_);
 						pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRArrayData_;
 						for(cnt = 0;cnt < (pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_);
                 	cnt++) { 
-							write_long(strlen((char *) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_), pIPDRCommonParameters->pStreamHandle_);
-				   		write_wstring((wchar *)pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+							write_long(strlen((char *) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_), pIPDRCommonParameters->pOutputBuffer_);
+				   		write_wstring((wchar *)pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_, pIPDRCommonParameters->pOutputBuffer_, pIPDRCommonParameters->schemaVersion);
 
 							pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;
 						}
 					} else {
-						write_long(strlen((char *) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUTF8Array_), pIPDRCommonParameters->pStreamHandle_);
-				   	write_wstring((wchar *)pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUTF8Array_, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+						write_long(strlen((char *) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUTF8Array_), pIPDRCommonParameters->pOutputBuffer_);
+				   	write_wstring((wchar *)pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUTF8Array_, pIPDRCommonParameters->pOutputBuffer_, pIPDRCommonParameters->schemaVersion);
 					}
 					break;
 			
@@ -323,27 +333,27 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 			  		if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 			  			pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = pFNFData->pListIPDRData_->noOfElements_; 
 						/*writing number of Elements*/
-						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pStreamHandle_);
+						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pOutputBuffer_);
 						pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRArrayData_;
 						for(cnt = 0;cnt < (pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_);
                 	cnt++) {
 							if(strcmp(pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRBoolean_, "0") == 0) { 
-								/*write_long((int) 0, pIPDRCommonParameters->pStreamHandle_);*/
-								write_boolean("false", pIPDRCommonParameters->pStreamHandle_);
+								/*write_long((int) 0, pIPDRCommonParameters->pOutputBuffer_);*/
+								write_boolean("false", pIPDRCommonParameters->pOutputBuffer_);
 							} else if(strcmp(pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRBoolean_, "1") == 0) {
-								/*write_long((int) 1, pIPDRCommonParameters->pStreamHandle_);*/
-								write_boolean("true", pIPDRCommonParameters->pStreamHandle_);
+								/*write_long((int) 1, pIPDRCommonParameters->pOutputBuffer_);*/
+								write_boolean("true", pIPDRCommonParameters->pOutputBuffer_);
 							}
 
 							pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;
 						}
 					} else {
 							if(strcmp(pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRBoolean_, "0") == 0) { 
-								/*write_long((int) 0, pIPDRCommonParameters->pStreamHandle_);*/
-								write_boolean("false", pIPDRCommonParameters->pStreamHandle_);
+								/*write_long((int) 0, pIPDRCommonParameters->pOutputBuffer_);*/
+								write_boolean("false", pIPDRCommonParameters->pOutputBuffer_);
 							} else if(strcmp(pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRBoolean_, "1") == 0) {
-								/*write_long((int) 1, pIPDRCommonParameters->pStreamHandle_);*/
-								write_boolean("true", pIPDRCommonParameters->pStreamHandle_);
+								/*write_long((int) 1, pIPDRCommonParameters->pOutputBuffer_);*/
+								write_boolean("true", pIPDRCommonParameters->pOutputBuffer_);
 							}
 					}
                break;
@@ -355,22 +365,22 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 
 			  		if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 			  			pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = pFNFData->pListIPDRData_->noOfElements_; 
-						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pStreamHandle_);
+						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pOutputBuffer_);
 						pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRArrayData_;
 						for(cnt = 0;cnt < (pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_);
                 	cnt++) { 
 							/*write_long((int) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRShort_, 
-											pIPDRCommonParameters->pStreamHandle_);*/
+											pIPDRCommonParameters->pOutputBuffer_);*/
 							write_short((short int) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRShort_, 
-											pIPDRCommonParameters->pStreamHandle_);
+											pIPDRCommonParameters->pOutputBuffer_);
 
 							pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;
 						}
 					} else {
 						write_short((short int) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRShort_, 
-										pIPDRCommonParameters->pStreamHandle_);
+										pIPDRCommonParameters->pOutputBuffer_);
 						/*write_long((int) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRShort_, 
-										pIPDRCommonParameters->pStreamHandle_);*/
+										pIPDRCommonParameters->pOutputBuffer_);*/
 					}
                break;
 
@@ -381,18 +391,18 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 
 			  		if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 			  			pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = pFNFData->pListIPDRData_->noOfElements_; 
-						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pStreamHandle_);
+						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pOutputBuffer_);
 						pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRArrayData_;
 						for(cnt = 0;cnt < (pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_);
                 	cnt++) { 
-							write_u_long((unsigned int) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUShort_, pIPDRCommonParameters->pStreamHandle_);
-							/*write_u_short((unsigned int) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUShort_, pIPDRCommonParameters->pStreamHandle_);*/
+							write_u_long((unsigned int) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUShort_, pIPDRCommonParameters->pOutputBuffer_);
+							/*write_u_short((unsigned int) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUShort_, pIPDRCommonParameters->pOutputBuffer_);*/
 
 							pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;
 						}
 					} else {
-						write_u_long((unsigned int) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUShort_, pIPDRCommonParameters->pStreamHandle_);
-						/*write_u_short((unsigned int) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUShort_, pIPDRCommonParameters->pStreamHandle_);*/
+						write_u_long((unsigned int) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUShort_, pIPDRCommonParameters->pOutputBuffer_);
+						/*write_u_short((unsigned int) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUShort_, pIPDRCommonParameters->pOutputBuffer_);*/
 					}
                break;
 
@@ -404,22 +414,22 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 			  		if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 			  			pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = pFNFData->pListIPDRData_->noOfElements_; 
 						/*writing number of Elements*/
-						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pStreamHandle_);
+						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pOutputBuffer_);
 						pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRArrayData_;
 						for(cnt = 0;cnt < (pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_);
                 	cnt++) { 
-							write_long((int) pFNFData->pListIPDRData_->pListIPDRArrayData_->IPDRDataUnion_.IPDRByte_, 
-											pIPDRCommonParameters->pStreamHandle_);
+							write_long((int) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRByte_, 
+											pIPDRCommonParameters->pOutputBuffer_);
 							/*write_byte((int) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRByte_, 
-											pIPDRCommonParameters->pStreamHandle_);*/
+											pIPDRCommonParameters->pOutputBuffer_);*/
 
 							pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;
 						}
 					} else {
 						/*write_byte((int) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRByte_, 
-										pIPDRCommonParameters->pStreamHandle_);*/
+										pIPDRCommonParameters->pOutputBuffer_);*/
 						write_long((int) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRByte_, 
-										pIPDRCommonParameters->pStreamHandle_);
+										pIPDRCommonParameters->pOutputBuffer_);
 					}
                break;
 
@@ -431,20 +441,20 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 			  		if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 			  			pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = pFNFData->pListIPDRData_->noOfElements_; 
 						/*writing number of Elements*/
-						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pStreamHandle_);
+						write_long(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_, pIPDRCommonParameters->pOutputBuffer_);
 						pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRArrayData_;
 						for(cnt = 0;cnt < (pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_);
                 	cnt++) { 
 							/*write_long((int) pFNFData->pListIPDRData_->pListIPDRArrayData_->IPDRDataUnion_.IPDRLong_, 
-											pIPDRCommonParameters->pStreamHandle_);*/
+											pIPDRCommonParameters->pOutputBuffer_);*/
 							write_byte((int) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRByte_, 
-											pIPDRCommonParameters->pStreamHandle_);
+											pIPDRCommonParameters->pOutputBuffer_);
 
 							pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;
 						}
 					} else {
 						write_byte((int) pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRByte_, 
-										pIPDRCommonParameters->pStreamHandle_);
+										pIPDRCommonParameters->pOutputBuffer_);
 					}
                break;
 
@@ -501,8 +511,6 @@ int readFNFDataHelper(
    char* tempComplexType; 
    char * tempString;
 
-	hyper* tempHyper;
-	u_hyper* tempUHyper;
 	wchar* tempUTFArray;
 
 	RecordDescriptor* pRecordDescriptor = NULL;
@@ -511,10 +519,14 @@ int readFNFDataHelper(
 	ListAttributeDescriptor* pCurrent = NULL;
 	ListIPDRComplexData* pListIPDRComplexData[MAX_IPDR_STRING];
 	void* IPDRValue =  NULL;
+	const XDRCodecPlan* pCodecPlan = NULL;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
 	
 	void* dataValue[MAX_IPDR_STRING];
 	int dataType[MAX_IPDR_STRING];
+	hyper hyperValues[MAX_IPDR_STRING];
+	u_hyper uHyperValues[MAX_IPDR_STRING];
 	char boolValue[3];
 
 	memset(dataValue, 0, sizeof(dataValue));
@@ -527,10 +539,15 @@ int readFNFDataHelper(
 	}
 
 	inDefiniteLengthIndicator = read_long(
-		                        pIPDRCommonParameters->pStreamHandle_);
+		                        pIPDRCommonParameters->pInputBuffer_);
 	if (inDefiniteLengthIndicator != IPDR_INDEFINITE_LENGTH_INDICATOR) 
 		return (IPDR_INVALID_COMPACT_FORMAT);
 
+	/* Records without structures are read through the compiled plan */
+	pCodecPlan = getXDRCodecPlan(pIPDRCommonParameters, descriptorID);
+	if (pCodecPlan != NULL && pCodecPlan->hasStructures_ == IPDR_FALSE)
+		return (readXDRCodecPlan(pIPDRCommonParameters, pCodecPlan, pFNFData, pErrorCode));
+
 	pRecordDescriptor = newRecordDescriptor();
 
 	errorSeverity = getDescriptor(pIPDRCommonParameters, descriptorID, 
@@ -574,7 +591,7 @@ int readFNFDataHelper(
    		tempString = (char *) calloc(strlen(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_) + 1, sizeof(char));
    		tempComplexType = (char *) calloc(strlen(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_) + 1, sizeof(char));
    		strcpy(tempString, pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_);
-   		serviceTypeToken = strtok(tempString, ":");
+   		serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
    	
    		if(strcmp(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_,serviceTypeToken)) {
    			getIPDRSubstring(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_, tempComplexType, ':');
@@ -591,7 +608,7 @@ int readFNFDataHelper(
 			/*check for noOfElements*/
    		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ == -1) {
    			pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = 
-										read_long(pIPDRCommonParameters->pStreamHandle_);
+										read_long(pIPDRCommonParameters->pInputBuffer_);
    		}
 
    		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
@@ -637,19 +654,19 @@ int readFNFDataHelper(
 			case IPDRDATA_LONG: 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ != 0) {
 			  			pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = 
-														read_long(pIPDRCommonParameters->pStreamHandle_); 
+														read_long(pIPDRCommonParameters->pInputBuffer_); 
 			  		}
 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 						for (countVal = 0; countVal < pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_; countVal++) {
-      					dataValue[countVal] = (void *)read_long(pIPDRCommonParameters->pStreamHandle_);
+      					dataValue[countVal] = (void *)read_long(pIPDRCommonParameters->pInputBuffer_);
 						}
 						dataType[0] = IPDRDATA_ARRAY;
 						dataType[1] = IPDRDATA_LONG;
       	 			appendListIPDRDataComplex(&((pFNFData)->pListIPDRData_), dataValue, dataType);
 					} else {
 						appendListIPDRData(&pFNFData->pListIPDRData_, 
-						(void *) read_long(pIPDRCommonParameters->pStreamHandle_), 
+						(void *) read_long(pIPDRCommonParameters->pInputBuffer_), 
 						IPDRDATA_LONG);  
 					}
 					break;
@@ -657,19 +674,19 @@ int readFNFDataHelper(
 			case IPDRDATA_ULONG: 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ != 0) {
 			  			pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = 
-														read_long(pIPDRCommonParameters->pStreamHandle_); 
+														read_long(pIPDRCommonParameters->pInputBuffer_); 
 			  		}
 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 						for (countVal = 0; countVal < pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_; countVal++) {
-      					dataValue[countVal] = (void *)read_u_long(pIPDRCommonParameters->pStreamHandle_);
+      					dataValue[countVal] = (void *)read_u_long(pIPDRCommonParameters->pInputBuffer_);
 						}
 						dataType[0] = IPDRDATA_ARRAY;
 						dataType[1] = IPDRDATA_ULONG;
       	 			appendListIPDRDataComplex(&((pFNFData)->pListIPDRData_), dataValue, dataType);
 					} else {
 						appendListIPDRData(&pFNFData->pListIPDRData_, 
-						(void *) read_u_long(pIPDRCommonParameters->pStreamHandle_), 
+						(void *) read_u_long(pIPDRCommonParameters->pInputBuffer_), 
 						IPDRDATA_ULONG);  
 					}
 					break;
@@ -677,71 +694,59 @@ int readFNFDataHelper(
 			case IPDRDATA_LONGLONG: 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ != 0) {
 			  			pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = 
-														read_long(pIPDRCommonParameters->pStreamHandle_); 
+														read_long(pIPDRCommonParameters->pInputBuffer_); 
 			  		}
 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
-						pIPDRData = newIPDRData(IPDRDATA_LONGLONG); 
 						for (countVal = 0; countVal < pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_; countVal++) {
-							tempHyper = read_longlong(pIPDRCommonParameters->pStreamHandle_);
-				   		pIPDRData->IPDRDataUnion_.IPDRLongLong_ = (hyper) *tempHyper;
-      					dataValue[countVal] = (void *)&(pIPDRData->IPDRDataUnion_.IPDRLongLong_);
+							hyperValues[countVal] = read_longlong(pIPDRCommonParameters->pInputBuffer_);
+      					dataValue[countVal] = (void *)&hyperValues[countVal];
 						}
 						dataType[0] = IPDRDATA_ARRAY;
 						dataType[1] = IPDRDATA_LONGLONG;
       	 			appendListIPDRDataComplex(&((pFNFData)->pListIPDRData_), dataValue, dataType);
 					} else {
-						pIPDRData = newIPDRData(IPDRDATA_LONGLONG); 
-						tempHyper = read_longlong(pIPDRCommonParameters->pStreamHandle_);
-				   	pIPDRData->IPDRDataUnion_.IPDRLongLong_ = (hyper) *tempHyper;
+						hyperValues[0] = read_longlong(pIPDRCommonParameters->pInputBuffer_);
 
 				   	appendListIPDRData(&pFNFData->pListIPDRData_, 
-						(void *) &(pIPDRData->IPDRDataUnion_.IPDRLongLong_),
+						(void *) &hyperValues[0],
 						IPDRDATA_LONGLONG);
 					}
-					free (tempHyper);
-					freeIPDRData (pIPDRData);
 					break;
 
 			case IPDRDATA_ULONGLONG: 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ != 0) {
 			  			pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = 
-														read_long(pIPDRCommonParameters->pStreamHandle_); 
+														read_long(pIPDRCommonParameters->pInputBuffer_); 
 			  		}
 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
-						pIPDRData = newIPDRData(IPDRDATA_ULONGLONG); 
 						for (countVal = 0; countVal < pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_; countVal++) {
-							tempUHyper = read_u_longlong(pIPDRCommonParameters->pStreamHandle_);
-				   		pIPDRData->IPDRDataUnion_.IPDRULongLong_ = (u_hyper) *tempUHyper;
-      					dataValue[countVal] = (void *)&(pIPDRData->IPDRDataUnion_.IPDRULongLong_);
+							uHyperValues[countVal] = read_u_longlong(pIPDRCommonParameters->pInputBuffer_);
+      					dataValue[countVal] = (void *)&uHyperValues[countVal];
 						}
 						dataType[0] = IPDRDATA_ARRAY;
 						dataType[1] = IPDRDATA_ULONGLONG;
       	 			appendListIPDRDataComplex(&((pFNFData)->pListIPDRData_), dataValue, dataType);
 					} else {
-						pIPDRData = newIPDRData(IPDRDATA_ULONGLONG); 
-						tempUHyper = read_u_longlong(pIPDRCommonParameters->pStreamHandle_);
-						pIPDRData->IPDRDataUnion_.IPDRULongLong_  = (u_hyper) *tempUHyper;
+						uHyperValues[0] = read_u_longlong(pIPDRCommonParameters->pInputBuffer_);
 					
 						appendListIPDRData(&pFNFData->pListIPDRData_, 
-										(void *) &(pIPDRData->IPDRDataUnion_.IPDRULongLong_),
+										(void *) &uHyperValues[0],
 										IPDRDATA_ULONGLONG);
 					}
-					free (tempUHyper);
-					freeIPDRData (pIPDRData);
 					break;
 					
             case IPDRDATA_FLOAT: 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ != 0) {
 			  			pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = 
-														read_long(pIPDRCommonParameters->pStreamHandle_); 
+														read_long(pIPDRCommonParameters->pInputBuffer_); 
 			  		}
 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 						pIPDRData = newIPDRData(IPDRDATA_FLOAT); 
 						for (countVal = 0; countVal < pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_; countVal++) {
-				   		pIPDRData->IPDRDataUnion_.IPDRFloat_ = read_float(pIPDRCommonParameters->pStreamHandle_);
+				   		pIPDRData->IPDRDataUnion_.IPDRFloat_ = read_float(pIPDRCommonParameters->pInputBuffer_);
       					dataValue[countVal] = (float *) &(pIPDRData->IPDRDataUnion_.IPDRFloat_);
 						}
 						dataType[0] = IPDRDATA_ARRAY;
@@ -750,7 +755,7 @@ int readFNFDataHelper(
 					} else {
 						pIPDRData = newIPDRData(IPDRDATA_FLOAT); 
 						pIPDRData->IPDRDataUnion_.IPDRFloat_ = 
-							read_float(pIPDRCommonParameters->pStreamHandle_);
+							read_float(pIPDRCommonParameters->pInputBuffer_);
 						IPDRValue = (float *) &pIPDRData->IPDRDataUnion_.IPDRFloat_;
 					
 						appendListIPDRData(&pFNFData->pListIPDRData_, 
@@ -764,13 +769,13 @@ int readFNFDataHelper(
 			case IPDRDATA_DOUBLE: 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ != 0) {
 			  			pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = 
-														read_long(pIPDRCommonParameters->pStreamHandle_); 
+														read_long(pIPDRCommonParameters->pInputBuffer_); 
 			  		}
 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 						pIPDRData = newIPDRData(IPDRDATA_DOUBLE); 
 						for (countVal = 0; countVal < pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_; countVal++) {
-				   		pIPDRData->IPDRDataUnion_.IPDRDouble_ = read_double(pIPDRCommonParameters->pStreamHandle_);
+				   		pIPDRData->IPDRDataUnion_.IPDRDouble_ = read_double(pIPDRCommonParameters->pInputBuffer_);
       					dataValue[countVal] = (double *) &(pIPDRData->IPDRDataUnion_.IPDRDouble_);
 						}
 						dataType[0] = IPDRDATA_ARRAY;
@@ -779,7 +784,7 @@ int readFNFDataHelper(
 					} else {
 						pIPDRData = newIPDRData(IPDRDATA_DOUBLE); 
 						pIPDRData->IPDRDataUnion_.IPDRDouble_ = 
-							read_double(pIPDRCommonParameters->pStreamHandle_);
+							read_double(pIPDRCommonParameters->pInputBuffer_);
 						IPDRValue = (double *) &pIPDRData->IPDRDataUnion_.IPDRDouble_;
 					
 						appendListIPDRData(&pFNFData->pListIPDRData_, 
@@ -793,7 +798,7 @@ int readFNFDataHelper(
 			case IPDRDATA_HEXADECARRAY: 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ != 0) {
 			  			pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = 
-														read_long(pIPDRCommonParameters->pStreamHandle_); 
+														read_long(pIPDRCommonParameters->pInputBuffer_); 
 			  		}
 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
@@ -801,10 +806,10 @@ int readFNFDataHelper(
 						for (countVal = 0; countVal < pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_; countVal++) {
 							pIPDRData->IPDRDataFlag_ = IPDRDATA_HEXADECARRAY;
 							byteArraylength = 
-								read_long(pIPDRCommonParameters->pStreamHandle_);
+								read_long(pIPDRCommonParameters->pInputBuffer_);
 							pIPDRData->IPDRDataUnion_.IPDRByteArray_ = 
 								read_octet_array(byteArraylength, 										 
-													pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+													pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 							dataValue[countVal] = (void *) calloc (1, (byteArraylength+1));
       					strcpy((char *)dataValue[countVal], (char *)pIPDRData->IPDRDataUnion_.IPDRByteArray_);
 						}
@@ -815,10 +820,10 @@ int readFNFDataHelper(
 						pIPDRData = (IPDRData *) malloc(sizeof(IPDRData));
 						pIPDRData->IPDRDataFlag_ = IPDRDATA_HEXADECARRAY;
 						byteArraylength = 
-							read_long(pIPDRCommonParameters->pStreamHandle_);
+							read_long(pIPDRCommonParameters->pInputBuffer_);
 						pIPDRData->IPDRDataUnion_.IPDRByteArray_ = 
 							read_octet_array(byteArraylength, 										 
-												pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+												pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 					
 						appendListIPDRData(&pFNFData->pListIPDRData_, 
 											pIPDRData->IPDRDataUnion_.IPDRByteArray_, 
@@ -831,14 +836,14 @@ int readFNFDataHelper(
 			case IPDRDATA_STRING: 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ != 0) {
 			  			pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = 
-														read_long(pIPDRCommonParameters->pStreamHandle_); 
+														read_long(pIPDRCommonParameters->pInputBuffer_); 
 			  		}
 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 						for (countVal = 0; countVal < pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_; countVal++) {
 							utfArrayLength = 
-								read_long(pIPDRCommonParameters->pStreamHandle_);
-				   		tempUTFArray = (wchar *) read_wstring(utfArrayLength, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+								read_long(pIPDRCommonParameters->pInputBuffer_);
+				   		tempUTFArray = (wchar *) read_wstring(utfArrayLength, pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 							dataValue[countVal] = (void *) calloc (1,  (utfArrayLength+1));
       					strcpy((char *)dataValue[countVal], (char *)tempUTFArray);
 						}
@@ -847,8 +852,8 @@ int readFNFDataHelper(
       	 			appendListIPDRDataComplex(&((pFNFData)->pListIPDRData_), dataValue, dataType);
 					} else {
 						utfArrayLength = 
-							read_long(pIPDRCommonParameters->pStreamHandle_);
-				   	tempUTFArray = (wchar *) read_wstring(utfArrayLength, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+							read_long(pIPDRCommonParameters->pInputBuffer_);
+				   	tempUTFArray = (wchar *) read_wstring(utfArrayLength, pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 					
 						appendListIPDRData(&pFNFData->pListIPDRData_, 
 											tempUTFArray, 
@@ -861,21 +866,21 @@ int readFNFDataHelper(
 			case IPDRDATA_BOOLEAN: 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ != 0) {
 			  			pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = 
-														read_long(pIPDRCommonParameters->pStreamHandle_); 
+														read_long(pIPDRCommonParameters->pInputBuffer_); 
 			  		}
 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 						for (countVal = 0; countVal < pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_; countVal++) {
-      					/*dataValue[countVal] = (void *)read_long(pIPDRCommonParameters->pStreamHandle_);*/
-      					dataValue[countVal] = (void *)read_boolean(pIPDRCommonParameters->pStreamHandle_);
+      					/*dataValue[countVal] = (void *)read_long(pIPDRCommonParameters->pInputBuffer_);*/
+      					dataValue[countVal] = (void *)read_boolean(pIPDRCommonParameters->pInputBuffer_);
 						}
 						dataType[0] = IPDRDATA_ARRAY;
 						dataType[1] = IPDRDATA_BOOLEAN;
       	 			appendListIPDRDataComplex(&((pFNFData)->pListIPDRData_), dataValue, dataType);
 					} else {
 						boolValue[0] = '\0';
-						/*int* value = (void *) read_long(pIPDRCommonParameters->pStreamHandle_);*/
-						value = (void *) read_boolean(pIPDRCommonParameters->pStreamHandle_);
+						/*int* value = (void *) read_long(pIPDRCommonParameters->pInputBuffer_);*/
+						value = (void *) read_boolean(pIPDRCommonParameters->pInputBuffer_);
 						sprintf(boolValue, "%d", value);
 						appendListIPDRData(&pFNFData->pListIPDRData_, 
 						boolValue,
@@ -886,23 +891,23 @@ int readFNFDataHelper(
 			case IPDRDATA_SHORT: 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ != 0) {
 			  			pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = 
-														read_long(pIPDRCommonParameters->pStreamHandle_); 
+														read_long(pIPDRCommonParameters->pInputBuffer_); 
 			  		}
 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 						for (countVal = 0; countVal < pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_; countVal++) {
-      					/*dataValue[countVal] = (void *)read_long(pIPDRCommonParameters->pStreamHandle_);*/
-      					dataValue[countVal] = (void *)read_short(pIPDRCommonParameters->pStreamHandle_);
+      					/*dataValue[countVal] = (void *)read_long(pIPDRCommonParameters->pInputBuffer_);*/
+      					dataValue[countVal] = (void *)read_short(pIPDRCommonParameters->pInputBuffer_);
 						}
 						dataType[0] = IPDRDATA_ARRAY;
 						dataType[1] = IPDRDATA_SHORT;
       	 			appendListIPDRDataComplex(&((pFNFData)->pListIPDRData_), dataValue, dataType);
 					} else {
 						/*appendListIPDRData(&pFNFData->pListIPDRData_, 
-						(void *) read_long(pIPDRCommonParameters->pStreamHandle_), 
+						(void *) read_long(pIPDRCommonParameters->pInputBuffer_), 
 						IPDRDATA_SHORT);*/
 						appendListIPDRData(&pFNFData->pListIPDRData_, 
-						(void *) read_short(pIPDRCommonParameters->pStreamHandle_), 
+						(void *) read_short(pIPDRCommonParameters->pInputBuffer_), 
 						IPDRDATA_SHORT);
 					}
 					break;
@@ -910,65 +915,65 @@ int readFNFDataHelper(
 			case IPDRDATA_USHORT: 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ != 0) {
 			  			pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = 
-														read_long(pIPDRCommonParameters->pStreamHandle_); 
+														read_long(pIPDRCommonParameters->pInputBuffer_); 
 			  		}
 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 						for (countVal = 0; countVal < pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_; countVal++) {
-      					dataValue[countVal] = (void *)read_u_long(pIPDRCommonParameters->pStreamHandle_);
-      					/*dataValue[countVal] = (void *)read_u_short(pIPDRCommonParameters->pStreamHandle_);*/
+      					dataValue[countVal] = (void *)read_u_long(pIPDRCommonParameters->pInputBuffer_);
+      					/*dataValue[countVal] = (void *)read_u_short(pIPDRCommonParameters->pInputBuffer_);*/
 						}
 						dataType[0] = IPDRDATA_ARRAY;
 						dataType[1] = IPDRDATA_USHORT;
       	 			appendListIPDRDataComplex(&((pFNFData)->pListIPDRData_), dataValue, dataType);
 					} else {
 						appendListIPDRData(&pFNFData->pListIPDRData_, 
-						(void *) read_u_long(pIPDRCommonParameters->pStreamHandle_), 
+						(void *) read_u_long(pIPDRCommonParameters->pInputBuffer_), 
 						IPDRDATA_USHORT);  
 						/*appendListIPDRData(&pFNFData->pListIPDRData_, 
-						(void *) read_u_short(pIPDRCommonParameters->pStreamHandle_), 
+						(void *) read_u_short(pIPDRCommonParameters->pInputBuffer_), 
 						IPDRDATA_USHORT);*/
 					}
 					break;
 			case IPDRDATA_BYTE: 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ != 0) {
 			  			pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = 
-														read_long(pIPDRCommonParameters->pStreamHandle_); 
+														read_long(pIPDRCommonParameters->pInputBuffer_); 
 			  		}
 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 						for (countVal = 0; countVal < pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_; countVal++) {
-      					dataValue[countVal] = (void *)read_byte(pIPDRCommonParameters->pStreamHandle_);
+      					dataValue[countVal] = (void *)read_byte(pIPDRCommonParameters->pInputBuffer_);
 						}
 						dataType[0] = IPDRDATA_ARRAY;
 						dataType[1] = IPDRDATA_BYTE;
       	 			appendListIPDRDataComplex(&((pFNFData)->pListIPDRData_), dataValue, dataType);
 					} else {
 						appendListIPDRData(&pFNFData->pListIPDRData_, 
-						(void *) read_byte(pIPDRCommonParameters->pStreamHandle_), 
+						(void *) read_byte(pIPDRCommonParameters->pInputBuffer_), 
 						IPDRDATA_BYTE);  
 					}
 					break;
 			case IPDRDATA_UBYTE: 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ != 0) {
 			  			pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ = 
-														read_long(pIPDRCommonParameters->pStreamHandle_); 
+														read_long(pIPDRCommonParameters->pInputBuffer_); 
 			  		}
 
 			  		if(pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_ > 0) {
 						for (countVal = 0; countVal < pRecordDescriptor->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_; countVal++) {
-      					/*dataValue[countVal] = (void *)read_byte(pIPDRCommonParameters->pStreamHandle_);*/
-      					dataValue[countVal] = (void *)read_long(pIPDRCommonParameters->pStreamHandle_);
+      					/*dataValue[countVal] = (void *)read_byte(pIPDRCommonParameters->pInputBuffer_);*/
+      					dataValue[countVal] = (void *)read_long(pIPDRCommonParameters->pInputBuffer_);
 						}
 						dataType[0] = IPDRDATA_ARRAY;
 						dataType[1] = IPDRDATA_LONG;
       	 			appendListIPDRDataComplex(&((pFNFData)->pListIPDRData_), dataValue, dataType);
 					} else {
 						/*appendListIPDRData(&pFNFData->pListIPDRData_, 
-						(void *) read_byte(pIPDRCommonParameters->pStreamHandle_), 
+						(void *) read_byte(pIPDRCommonParameters->pInputBuffer_), 
 						IPDRDATA_BYTE);*/
 						appendListIPDRData(&pFNFData->pListIPDRData_, 
-						(void *) read_long(pIPDRCommonParameters->pStreamHandle_), 
+						(void *) read_long(pIPDRCommonParameters->pInputBuffer_), 
 						IPDRDATA_LONG);
 					}
 					break;
@@ -1028,7 +1033,10 @@ int readComplexFNFDataHelper(char* pComplexType,
    char * tempString;
 	char* resultString;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
 	void* dataValue[MAX_IPDR_STRING];
+	hyper hyperValues[MAX_IPDR_STRING];
+	u_hyper uHyperValues[MAX_IPDR_STRING];
  	ListAttributeDescriptor* pCurrentListServiceAttributeDescriptor = NULL;
  	ListAttributeDescriptor* pOldListServiceAttributeDescriptor = NULL;
  	ListAttributeDescriptor* pTempOldListServiceAttributeDescriptor = NULL;
@@ -1036,8 +1044,6 @@ int readComplexFNFDataHelper(char* pComplexType,
 	List* pcurrentMaxOccrsList = NULL;
 	List* pcurrent = NULL;
 	IPDRData* pIPDRData; 
-	hyper* tempHyper;
-	u_hyper* tempUHyper;
 	wchar* tempUTFArray;
 
 	memset(dataValue, 0, sizeof(dataValue));
@@ -1052,7 +1058,7 @@ int readComplexFNFDataHelper(char* pComplexType,
 	tempString = (char *) calloc(strlen(pComplexType) + 1, sizeof(char));
 	tempComplexType = (char *) calloc(strlen(pComplexType) + 1, sizeof(char));
 	strcpy(tempString, pComplexType);
-	serviceTypeToken = strtok(tempString, ":");
+	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 	
 	if(strcmp(pComplexType,serviceTypeToken)) {
 		getIPDRSubstring(pComplexType, tempComplexType, ':');
@@ -1083,7 +1089,7 @@ int readComplexFNFDataHelper(char* pComplexType,
 						tempString = (char *) calloc(strlen(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_) + 1, sizeof(char));
 						tempComplexType = (char *) calloc(strlen(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_) + 1, sizeof(char));
 						strcpy(tempString, pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_);
-						serviceTypeToken = strtok(tempString, ":");
+						serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 	
 					if(strcmp(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_,serviceTypeToken)) {
 						getIPDRSubstring(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_, 
@@ -1104,7 +1110,7 @@ int readComplexFNFDataHelper(char* pComplexType,
 
               				if((pcurrentMaxOccrsList != NULL)) {
 									if(strcmp(pcurrentMaxOccrsList->node, "0") != 0) {
-              						noOfElements = read_long(pIPDRCommonParameters->pStreamHandle_); 
+              						noOfElements = read_long(pIPDRCommonParameters->pInputBuffer_); 
 									}
 									else {
               						noOfElements = atoi(pcurrentMaxOccrsList->node);
@@ -1113,12 +1119,12 @@ int readComplexFNFDataHelper(char* pComplexType,
               
               				if (noOfElements > 0) {
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
-      								dataValue[cnt] = (void *)read_long(pIPDRCommonParameters->pStreamHandle_);
+      								dataValue[cnt] = (void *)read_long(pIPDRCommonParameters->pInputBuffer_);
               					}
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_LONG);
               				}
               				else {
-									dataValue[0] = (void *) read_long(pIPDRCommonParameters->pStreamHandle_);
+									dataValue[0] = (void *) read_long(pIPDRCommonParameters->pInputBuffer_);
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_LONG);
               				}
                         break;
@@ -1126,7 +1132,7 @@ int readComplexFNFDataHelper(char* pComplexType,
               			case IPDRDATA_ULONG: 
               				if((pcurrentMaxOccrsList != NULL)) {
 									if(strcmp(pcurrentMaxOccrsList->node, "0") != 0) {
-              						noOfElements = read_long(pIPDRCommonParameters->pStreamHandle_);
+              						noOfElements = read_long(pIPDRCommonParameters->pInputBuffer_);
 									}
 									else {
               						noOfElements = atoi(pcurrentMaxOccrsList->node);
@@ -1135,12 +1141,12 @@ int readComplexFNFDataHelper(char* pComplexType,
               
               				if (noOfElements > 0) {
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
-      								dataValue[cnt] = (void *)read_u_long(pIPDRCommonParameters->pStreamHandle_);
+      								dataValue[cnt] = (void *)read_u_long(pIPDRCommonParameters->pInputBuffer_);
               					}
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_ULONG);
               				}
               				else {
-									dataValue[0] = (void *) read_u_long(pIPDRCommonParameters->pStreamHandle_);
+									dataValue[0] = (void *) read_u_long(pIPDRCommonParameters->pInputBuffer_);
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_ULONG);
               				}
                         break;
@@ -1148,7 +1154,7 @@ int readComplexFNFDataHelper(char* pComplexType,
                        case IPDRDATA_LONGLONG: 
               				if((pcurrentMaxOccrsList != NULL)) {
 									if(strcmp(pcurrentMaxOccrsList->node, "0") != 0) {
-              						noOfElements = read_long(pIPDRCommonParameters->pStreamHandle_);
+              						noOfElements = read_long(pIPDRCommonParameters->pInputBuffer_);
 									}
 									else {
               						noOfElements = atoi(pcurrentMaxOccrsList->node);
@@ -1156,29 +1162,23 @@ int readComplexFNFDataHelper(char* pComplexType,
               				}
               
               				if (noOfElements > 0) {
-									pIPDRData = newIPDRData(IPDRDATA_LONGLONG); 
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
-										tempHyper = read_longlong(pIPDRCommonParameters->pStreamHandle_);
-				   					pIPDRData->IPDRDataUnion_.IPDRLongLong_ = (hyper) *tempHyper;
-      								dataValue[cnt] = (void *)&(pIPDRData->IPDRDataUnion_.IPDRLongLong_);
+										hyperValues[cnt] = read_longlong(pIPDRCommonParameters->pInputBuffer_);
+      								dataValue[cnt] = (void *)&hyperValues[cnt];
               					}
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_LONGLONG);
               				}
               				else {
-									pIPDRData = newIPDRData(IPDRDATA_LONGLONG); 
-									tempHyper = read_longlong(pIPDRCommonParameters->pStreamHandle_);
-				   				pIPDRData->IPDRDataUnion_.IPDRLongLong_ = (hyper) *tempHyper;
-      							dataValue[0] = (void *)&(pIPDRData->IPDRDataUnion_.IPDRLongLong_);
+									hyperValues[0] = read_longlong(pIPDRCommonParameters->pInputBuffer_);
+      							dataValue[0] = (void *)&hyperValues[0];
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_LONGLONG);
               				}
-								free(tempHyper);
-								freeIPDRData (pIPDRData);
                          break;
               
                        case IPDRDATA_ULONGLONG: 
               				if((pcurrentMaxOccrsList != NULL)) {
 									if(strcmp(pcurrentMaxOccrsList->node, "0") != 0) {
-              						noOfElements = read_long(pIPDRCommonParameters->pStreamHandle_);
+              						noOfElements = read_long(pIPDRCommonParameters->pInputBuffer_);
 									}
 									else {
               						noOfElements = atoi(pcurrentMaxOccrsList->node);
@@ -1186,29 +1186,23 @@ int readComplexFNFDataHelper(char* pComplexType,
               				}
               
               				if (noOfElements > 0) {
-									pIPDRData = newIPDRData(IPDRDATA_ULONGLONG); 
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
-										tempUHyper = read_u_longlong(pIPDRCommonParameters->pStreamHandle_);
-				   					pIPDRData->IPDRDataUnion_.IPDRULongLong_ = (hyper) *tempUHyper;
-      								dataValue[cnt] = (void *)&(pIPDRData->IPDRDataUnion_.IPDRULongLong_);
+										uHyperValues[cnt] = read_u_longlong(pIPDRCommonParameters->pInputBuffer_);
+      								dataValue[cnt] = (void *)&uHyperValues[cnt];
               					}
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_ULONGLONG);
               				}
               				else {
-									pIPDRData = newIPDRData(IPDRDATA_ULONGLONG); 
-									tempUHyper = read_u_longlong(pIPDRCommonParameters->pStreamHandle_);
-				   				pIPDRData->IPDRDataUnion_.IPDRULongLong_ = (hyper) *tempUHyper;
-      							dataValue[0] = (void *)&(pIPDRData->IPDRDataUnion_.IPDRULongLong_);
+									uHyperValues[0] = read_u_longlong(pIPDRCommonParameters->pInputBuffer_);
+      							dataValue[0] = (void *)&uHyperValues[0];
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_ULONGLONG);
               				}
-								free(tempUHyper);
-								freeIPDRData (pIPDRData);
                         break;
               
                        case IPDRDATA_FLOAT: 
               				if((pcurrentMaxOccrsList != NULL)) {
 									if(strcmp(pcurrentMaxOccrsList->node, "0") != 0) {
-              						noOfElements = read_long(pIPDRCommonParameters->pStreamHandle_);
+              						noOfElements = read_long(pIPDRCommonParameters->pInputBuffer_);
 									}
 									else {
               						noOfElements = atoi(pcurrentMaxOccrsList->node);
@@ -1219,7 +1213,7 @@ int readComplexFNFDataHelper(char* pComplexType,
 									pIPDRData = newIPDRData(IPDRDATA_FLOAT); 
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
 				   					pIPDRData->IPDRDataUnion_.IPDRFloat_ = 
-															read_float(pIPDRCommonParameters->pStreamHandle_);
+															read_float(pIPDRCommonParameters->pInputBuffer_);
       								dataValue[cnt] = (float *) &(pIPDRData->IPDRDataUnion_.IPDRFloat_);
               					}
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_FLOAT);
@@ -1227,7 +1221,7 @@ int readComplexFNFDataHelper(char* pComplexType,
               				else {
 									pIPDRData = newIPDRData(IPDRDATA_FLOAT); 
 				   				pIPDRData->IPDRDataUnion_.IPDRFloat_ = 
-															read_float(pIPDRCommonParameters->pStreamHandle_);
+															read_float(pIPDRCommonParameters->pInputBuffer_);
       							dataValue[0] = (void *)&(pIPDRData->IPDRDataUnion_.IPDRFloat_);
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_FLOAT);
               				}
@@ -1237,7 +1231,7 @@ int readComplexFNFDataHelper(char* pComplexType,
                        case IPDRDATA_DOUBLE: 
               				if((pcurrentMaxOccrsList != NULL)) {
 									if(strcmp(pcurrentMaxOccrsList->node, "0") != 0) {
-              						noOfElements = read_long(pIPDRCommonParameters->pStreamHandle_);
+              						noOfElements = read_long(pIPDRCommonParameters->pInputBuffer_);
 									}
 									else {
               						noOfElements = atoi(pcurrentMaxOccrsList->node);
@@ -1248,7 +1242,7 @@ int readComplexFNFDataHelper(char* pComplexType,
 									pIPDRData = newIPDRData(IPDRDATA_DOUBLE); 
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
 				   					pIPDRData->IPDRDataUnion_.IPDRDouble_ = 
-															read_float(pIPDRCommonParameters->pStreamHandle_);
+															read_float(pIPDRCommonParameters->pInputBuffer_);
       								dataValue[cnt] = (void *)&(pIPDRData->IPDRDataUnion_.IPDRDouble_);
               					}
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_DOUBLE);
@@ -1256,7 +1250,7 @@ int readComplexFNFDataHelper(char* pComplexType,
               				else {
 									pIPDRData = newIPDRData(IPDRDATA_DOUBLE); 
 				   				pIPDRData->IPDRDataUnion_.IPDRDouble_ = 
-															read_float(pIPDRCommonParameters->pStreamHandle_);
+															read_float(pIPDRCommonParameters->pInputBuffer_);
       							dataValue[0] = (void *)&(pIPDRData->IPDRDataUnion_.IPDRDouble_);
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_DOUBLE);
               				}
@@ -1266,7 +1260,7 @@ int readComplexFNFDataHelper(char* pComplexType,
                        case IPDRDATA_HEXADECARRAY: 
               				if((pcurrentMaxOccrsList != NULL)) {
 									if(strcmp(pcurrentMaxOccrsList->node, "0") != 0) {
-              						noOfElements = read_long(pIPDRCommonParameters->pStreamHandle_);
+              						noOfElements = read_long(pIPDRCommonParameters->pInputBuffer_);
 									}
 									else {
               						noOfElements = atoi(pcurrentMaxOccrsList->node);
@@ -1278,10 +1272,10 @@ int readComplexFNFDataHelper(char* pComplexType,
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
 										pIPDRData->IPDRDataFlag_ = IPDRDATA_HEXADECARRAY;
 										byteArraylength = 
-												read_long(pIPDRCommonParameters->pStreamHandle_);
+												read_long(pIPDRCommonParameters->pInputBuffer_);
 										pIPDRData->IPDRDataUnion_.IPDRByteArray_ = 
 												read_octet_array(byteArraylength, 										 
-														pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+														pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 										dataValue[cnt] = (void *) calloc (1, (byteArraylength+1));
       								strcpy((char *)dataValue[cnt], (char *)pIPDRData->IPDRDataUnion_.IPDRByteArray_);
               					}
@@ -1291,10 +1285,10 @@ int readComplexFNFDataHelper(char* pComplexType,
 									pIPDRData = (IPDRData *) malloc(sizeof(IPDRData));
 									pIPDRData->IPDRDataFlag_ = IPDRDATA_HEXADECARRAY;
 									byteArraylength = 
-											read_long(pIPDRCommonParameters->pStreamHandle_);
+											read_long(pIPDRCommonParameters->pInputBuffer_);
 									pIPDRData->IPDRDataUnion_.IPDRByteArray_ = 
 											read_octet_array(byteArraylength, 										 
-														pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+														pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 									dataValue[0] = (void *) calloc (1, (byteArraylength+1));
       							strcpy((char *)dataValue[0], (char *)pIPDRData->IPDRDataUnion_.IPDRByteArray_);
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_HEXADECARRAY);
@@ -1305,7 +1299,7 @@ int readComplexFNFDataHelper(char* pComplexType,
                        case IPDRDATA_STRING: 
               				if((pcurrentMaxOccrsList != NULL)) {
 									if(strcmp(pcurrentMaxOccrsList->node, "0") != 0) {
-              						noOfElements = read_long(pIPDRCommonParameters->pStreamHandle_);
+              						noOfElements = read_long(pIPDRCommonParameters->pInputBuffer_);
 									}
 									else {
               						noOfElements = atoi(pcurrentMaxOccrsList->node);
@@ -1315,9 +1309,9 @@ int readComplexFNFDataHelper(char* pComplexType,
               				if (noOfElements > 0) {
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
 										utfArrayLength = 
-											read_long(pIPDRCommonParameters->pStreamHandle_);
+											read_long(pIPDRCommonParameters->pInputBuffer_);
 				   					tempUTFArray = 
-											(wchar *) read_wstring(utfArrayLength, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+											(wchar *) read_wstring(utfArrayLength, pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 										dataValue[cnt] = (void *) calloc (1,  (utfArrayLength+1));
       								strcpy((char *)dataValue[cnt], (char *)tempUTFArray);
               					}
@@ -1325,9 +1319,9 @@ int readComplexFNFDataHelper(char* pComplexType,
               				}
               				else {
 									utfArrayLength = 
-											read_long(pIPDRCommonParameters->pStreamHandle_);
+											read_long(pIPDRCommonParameters->pInputBuffer_);
 				   				tempUTFArray = 
-										(wchar *) read_wstring(utfArrayLength, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+										(wchar *) read_wstring(utfArrayLength, pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 									dataValue[0] = (void *) calloc (1,  (utfArrayLength+1));
       							strcpy((char *)dataValue[0], (char *)tempUTFArray);
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_STRING);
@@ -1338,7 +1332,7 @@ int readComplexFNFDataHelper(char* pComplexType,
                        case IPDRDATA_BOOLEAN: 
               				if((pcurrentMaxOccrsList != NULL)) {
 									if(strcmp(pcurrentMaxOccrsList->node, "0") != 0) {
-              						noOfElements = read_long(pIPDRCommonParameters->pStreamHandle_);
+              						noOfElements = read_long(pIPDRCommonParameters->pInputBuffer_);
 									}
 									else {
               						noOfElements = atoi(pcurrentMaxOccrsList->node);
@@ -1347,12 +1341,12 @@ int readComplexFNFDataHelper(char* pComplexType,
               
               				if (noOfElements > 0) {
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
-      								dataValue[cnt] = (void *)read_long(pIPDRCommonParameters->pStreamHandle_);
+      								dataValue[cnt] = (void *)read_long(pIPDRCommonParameters->pInputBuffer_);
               					}
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_BOOLEAN);
               				}
               				else {
-      								dataValue[0] = (void *)read_long(pIPDRCommonParameters->pStreamHandle_);
+      								dataValue[0] = (void *)read_long(pIPDRCommonParameters->pInputBuffer_);
 										appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_BOOLEAN);
               				}
               				break;
@@ -1360,7 +1354,7 @@ int readComplexFNFDataHelper(char* pComplexType,
               			case IPDRDATA_SHORT: 
               				if((pcurrentMaxOccrsList != NULL)) {
 									if(strcmp(pcurrentMaxOccrsList->node, "0") != 0) {
-              						noOfElements = read_long(pIPDRCommonParameters->pStreamHandle_);
+              						noOfElements = read_long(pIPDRCommonParameters->pInputBuffer_);
 									}
 									else {
               						noOfElements = atoi(pcurrentMaxOccrsList->node);
@@ -1369,14 +1363,14 @@ int readComplexFNFDataHelper(char* pComplexType,
               
               				if (noOfElements > 0) {
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
-      								/*dataValue[cnt] = (void *)read_long(pIPDRCommonParameters->pStreamHandle_);*/
-      								dataValue[cnt] = (void *)read_short(pIPDRCommonParameters->pStreamHandle_);
+      								/*dataValue[cnt] = (void *)read_long(pIPDRCommonParameters->pInputBuffer_);*/
+      								dataValue[cnt] = (void *)read_short(pIPDRCommonParameters->pInputBuffer_);
 										appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_SHORT);
               					}
               				}
               				else {
-      								/*dataValue[0] = (void *)read_long(pIPDRCommonParameters->pStreamHandle_);*/
-      								dataValue[0] = (void *)read_short(pIPDRCommonParameters->pStreamHandle_);
+      								/*dataValue[0] = (void *)read_long(pIPDRCommonParameters->pInputBuffer_);*/
+      								dataValue[0] = (void *)read_short(pIPDRCommonParameters->pInputBuffer_);
 										appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_SHORT);
               				}
                         break;
@@ -1384,7 +1378,7 @@ int readComplexFNFDataHelper(char* pComplexType,
               			case IPDRDATA_USHORT: 
               				if((pcurrentMaxOccrsList != NULL)) {
 									if(strcmp(pcurrentMaxOccrsList->node, "0") != 0) {
-              						noOfElements = read_long(pIPDRCommonParameters->pStreamHandle_);
+              						noOfElements = read_long(pIPDRCommonParameters->pInputBuffer_);
 									}
 									else {
               						noOfElements = atoi(pcurrentMaxOccrsList->node);
@@ -1393,12 +1387,12 @@ int readComplexFNFDataHelper(char* pComplexType,
               
               				if (noOfElements > 0) {
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
-      								dataValue[cnt] = (void *)read_u_long(pIPDRCommonParameters->pStreamHandle_);
+      								dataValue[cnt] = (void *)read_u_long(pIPDRCommonParameters->pInputBuffer_);
 										appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_USHORT);
               					}
               				}
               				else {
-      								dataValue[0] = (void *)read_u_long(pIPDRCommonParameters->pStreamHandle_);
+      								dataValue[0] = (void *)read_u_long(pIPDRCommonParameters->pInputBuffer_);
 										appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_USHORT);
               				}
                         break;
@@ -1407,7 +1401,7 @@ int readComplexFNFDataHelper(char* pComplexType,
 
               				if((pcurrentMaxOccrsList != NULL)) {
 									if(strcmp(pcurrentMaxOccrsList->node, "0") != 0) {
-              						noOfElements = read_long(pIPDRCommonParameters->pStreamHandle_); 
+              						noOfElements = read_long(pIPDRCommonParameters->pInputBuffer_); 
 									}
 									else {
               						noOfElements = atoi(pcurrentMaxOccrsList->node);
@@ -1416,12 +1410,12 @@ int readComplexFNFDataHelper(char* pComplexType,
               
               				if (noOfElements > 0) {
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
-      								dataValue[cnt] = (void *)read_byte(pIPDRCommonParameters->pStreamHandle_);
+      								dataValue[cnt] = (void *)read_byte(pIPDRCommonParameters->pInputBuffer_);
               					}
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_LONG);
               				}
               				else {
-									dataValue[0] = (void *) read_byte(pIPDRCommonParameters->pStreamHandle_);
+									dataValue[0] = (void *) read_byte(pIPDRCommonParameters->pInputBuffer_);
 									appendListIPDRComplex(&(*pListIPDRComplex), dataValue, IPDRDATA_LONG);
               				}
                         break;
@@ -1518,6 +1512,7 @@ writeIPDRXDRComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
    char * tempString;
 	char* resultString;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
  	ListIPDRData* pCurrentListIPDRData = NULL;
  	ListAttributeDescriptor* pCurrentListServiceAttributeDescriptor = NULL;
  	ListAttributeDescriptor* pOldListServiceAttributeDescriptor = NULL;
@@ -1539,7 +1534,7 @@ writeIPDRXDRComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
 	tempString = (char *) calloc(strlen(pComplexType) + 1, sizeof(char));
 	tempComplexType = (char *) calloc(strlen(pComplexType) + 1, sizeof(char));
 	strcpy(tempString, pComplexType);
-	serviceTypeToken = strtok(tempString, ":");
+	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 	
 	if(strcmp(pComplexType,serviceTypeToken)) {
 		getIPDRSubstring(pComplexType, tempComplexType, ':');
@@ -1569,7 +1564,7 @@ writeIPDRXDRComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
 						tempString = (char *) calloc(strlen(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_) + 1, sizeof(char));
 						tempComplexType = (char *) calloc(strlen(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_) + 1, sizeof(char));
 						strcpy(tempString, pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_);
-						serviceTypeToken = strtok(tempString, ":");
+						serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 	
 				if(strcmp(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_,serviceTypeToken)) {
 					getIPDRSubstring(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_, 
@@ -1600,17 +1595,17 @@ writeIPDRXDRComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
               				if (noOfElements > 0) {
               						noOfElements = 
 									pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->noOfElements_;
-									write_long(noOfElements, pIPDRCommonParameters->pStreamHandle_);
+									write_long(noOfElements, pIPDRCommonParameters->pOutputBuffer_);
               					pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_;
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
 										write_long((int) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRLong_, 
-													  pIPDRCommonParameters->pStreamHandle_);
+													  pIPDRCommonParameters->pOutputBuffer_);
               					   pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;	
               					}
               				}
               				else {
 										write_long((int) pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRLong_, 
-													  pIPDRCommonParameters->pStreamHandle_);
+													  pIPDRCommonParameters->pOutputBuffer_);
               				}
                         break;
               
@@ -1628,20 +1623,20 @@ writeIPDRXDRComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
               				if (noOfElements > 0) {
               						noOfElements = 
 									pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->noOfElements_;
-									write_long(noOfElements, pIPDRCommonParameters->pStreamHandle_);
+									write_long(noOfElements, pIPDRCommonParameters->pOutputBuffer_);
               					pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_;
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
               						noOfElements = 
 									pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->noOfElements_;
 										write_u_long((unsigned int) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRULong_, 
-														 pIPDRCommonParameters->pStreamHandle_);
+														 pIPDRCommonParameters->pOutputBuffer_);
 
               					   pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;	
               					}
               				}
               				else {
 									write_u_long((unsigned int) pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRULong_, 
-														 pIPDRCommonParameters->pStreamHandle_);
+														 pIPDRCommonParameters->pOutputBuffer_);
               				}
                         break;
               
@@ -1659,17 +1654,17 @@ writeIPDRXDRComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
               				if (noOfElements > 0) {
               						noOfElements = 
 									pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->noOfElements_;
-									write_long(noOfElements, pIPDRCommonParameters->pStreamHandle_);
+									write_long(noOfElements, pIPDRCommonParameters->pOutputBuffer_);
               					pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_;
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
 										write_longlong((hyper) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRLongLong_, 
-															pIPDRCommonParameters->pStreamHandle_);
+															pIPDRCommonParameters->pOutputBuffer_);
               					   pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;	
               					}
               				}
               				else {
 										write_longlong((hyper) pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRLongLong_, 
-															pIPDRCommonParameters->pStreamHandle_);
+															pIPDRCommonParameters->pOutputBuffer_);
               				}
                          break;
               
@@ -1687,18 +1682,18 @@ writeIPDRXDRComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
               				if (noOfElements > 0) {
               						noOfElements = 
 									pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->noOfElements_;
-									write_long(noOfElements, pIPDRCommonParameters->pStreamHandle_);
+									write_long(noOfElements, pIPDRCommonParameters->pOutputBuffer_);
               					pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_;
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
 										write_u_longlong((u_hyper) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRULongLong_, 
-													pIPDRCommonParameters->pStreamHandle_);
+													pIPDRCommonParameters->pOutputBuffer_);
 
               					   pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;	
               					}
               				}
               				else {
 										write_u_longlong((u_hyper) pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRULongLong_, 
-													pIPDRCommonParameters->pStreamHandle_);
+													pIPDRCommonParameters->pOutputBuffer_);
               				}
                         break;
               
@@ -1716,18 +1711,18 @@ writeIPDRXDRComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
               				if (noOfElements > 0) {
               						noOfElements = 
 									pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->noOfElements_;
-									write_long(noOfElements, pIPDRCommonParameters->pStreamHandle_);
+									write_long(noOfElements, pIPDRCommonParameters->pOutputBuffer_);
               					pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_;
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
 										write_float((float) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRFloat_, 
-											pIPDRCommonParameters->pStreamHandle_);
+											pIPDRCommonParameters->pOutputBuffer_);
 
               					   pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;	
               					}
               				}
               				else {
 										write_float((float) pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRFloat_, 
-											pIPDRCommonParameters->pStreamHandle_);
+											pIPDRCommonParameters->pOutputBuffer_);
               				}
               				break;
               
@@ -1745,18 +1740,18 @@ writeIPDRXDRComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
               				if (noOfElements > 0) {
               						noOfElements = 
 									pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->noOfElements_;
-									write_long(noOfElements, pIPDRCommonParameters->pStreamHandle_);
+									write_long(noOfElements, pIPDRCommonParameters->pOutputBuffer_);
               					pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_;
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
 											write_double((double) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRDouble_, 
-											 pIPDRCommonParameters->pStreamHandle_);
+											 pIPDRCommonParameters->pOutputBuffer_);
 
               					   pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;	
               					}
               				}
               				else {
 									write_double((double) pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRDouble_, 
-											 pIPDRCommonParameters->pStreamHandle_);
+											 pIPDRCommonParameters->pOutputBuffer_);
               				}
               				break;
               
@@ -1774,20 +1769,20 @@ writeIPDRXDRComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
               				if (noOfElements > 0) {
               						noOfElements = 
 									pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->noOfElements_;
-									write_long(noOfElements, pIPDRCommonParameters->pStreamHandle_);
+									write_long(noOfElements, pIPDRCommonParameters->pOutputBuffer_);
               					pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_;
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
 										byteArrayLength = getByteArrayLength(pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_);
-										write_long(byteArrayLength, pIPDRCommonParameters->pStreamHandle_);
-										write_noctet_array(pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_, pIPDRCommonParameters->pStreamHandle_, byteArrayLength, pIPDRCommonParameters->schemaVersion);     
+										write_long(byteArrayLength, pIPDRCommonParameters->pOutputBuffer_);
+										write_noctet_array(pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_, pIPDRCommonParameters->pOutputBuffer_, byteArrayLength, pIPDRCommonParameters->schemaVersion);     
 
               					   pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;	
               					}
               				}
               				else {
 										byteArrayLength = getByteArrayLength(pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRByteArray_);
-										write_long(byteArrayLength, pIPDRCommonParameters->pStreamHandle_);
-										write_noctet_array(pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRByteArray_, pIPDRCommonParameters->pStreamHandle_, byteArrayLength, pIPDRCommonParameters->schemaVersion);     
+										write_long(byteArrayLength, pIPDRCommonParameters->pOutputBuffer_);
+										write_noctet_array(pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRByteArray_, pIPDRCommonParameters->pOutputBuffer_, byteArrayLength, pIPDRCommonParameters->schemaVersion);     
               				}
               				break;
               
@@ -1805,17 +1800,17 @@ writeIPDRXDRComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
               				if (noOfElements > 0) {
               						noOfElements = 
 									pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->noOfElements_;
-									write_long(noOfElements, pIPDRCommonParameters->pStreamHandle_);
+									write_long(noOfElements, pIPDRCommonParameters->pOutputBuffer_);
               					pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_;
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
-										write_long(strlen((char *) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_), pIPDRCommonParameters->pStreamHandle_);
-				   					write_wstring((wchar *)pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+										write_long(strlen((char *) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_), pIPDRCommonParameters->pOutputBuffer_);
+				   					write_wstring((wchar *)pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_, pIPDRCommonParameters->pOutputBuffer_, pIPDRCommonParameters->schemaVersion);
               					   pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;	
               					}
               				}
               				else {
-										write_long(strlen((char *) pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRUTF8Array_), pIPDRCommonParameters->pStreamHandle_);
-				   					write_wstring((wchar *)pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRUTF8Array_, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+										write_long(strlen((char *) pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRUTF8Array_), pIPDRCommonParameters->pOutputBuffer_);
+				   					write_wstring((wchar *)pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRUTF8Array_, pIPDRCommonParameters->pOutputBuffer_, pIPDRCommonParameters->schemaVersion);
               				}
               				break;
               			
@@ -1833,26 +1828,26 @@ writeIPDRXDRComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
               				if (noOfElements > 0) {
               						noOfElements = 
 									pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->noOfElements_;
-									write_long(noOfElements, pIPDRCommonParameters->pStreamHandle_);
+									write_long(noOfElements, pIPDRCommonParameters->pOutputBuffer_);
               					pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_;
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
 										if(strcmp(pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRBoolean_, "0") == 0) { 
-											write_boolean("false", pIPDRCommonParameters->pStreamHandle_);
-											/*write_long((int) 0, pIPDRCommonParameters->pStreamHandle_);*/
+											write_boolean("false", pIPDRCommonParameters->pOutputBuffer_);
+											/*write_long((int) 0, pIPDRCommonParameters->pOutputBuffer_);*/
 										} else if(strcmp(pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRBoolean_, "1 ") == 0) {
-											write_boolean("true", pIPDRCommonParameters->pStreamHandle_);
-											/*write_long((int) 1, pIPDRCommonParameters->pStreamHandle_);*/
+											write_boolean("true", pIPDRCommonParameters->pOutputBuffer_);
+											/*write_long((int) 1, pIPDRCommonParameters->pOutputBuffer_);*/
 										}
               					   pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;	
               					}
               				}
               				else {
 										if(strcmp(pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRBoolean_, "0")) { 
-											write_boolean("false", pIPDRCommonParameters->pStreamHandle_);
-											/*write_long((int) 0, pIPDRCommonParameters->pStreamHandle_);*/
+											write_boolean("false", pIPDRCommonParameters->pOutputBuffer_);
+											/*write_long((int) 0, pIPDRCommonParameters->pOutputBuffer_);*/
 										} else if(strcmp(pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRBoolean_, "1")) {
-											write_boolean("true", pIPDRCommonParameters->pStreamHandle_);
-											/*write_long((int) 1, pIPDRCommonParameters->pStreamHandle_);*/
+											write_boolean("true", pIPDRCommonParameters->pOutputBuffer_);
+											/*write_long((int) 1, pIPDRCommonParameters->pOutputBuffer_);*/
 										}
               				}
               				break;
@@ -1871,22 +1866,22 @@ writeIPDRXDRComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
               				if (noOfElements > 0) {
               						noOfElements = 
 									pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->noOfElements_;
-									write_long(noOfElements, pIPDRCommonParameters->pStreamHandle_);
+									write_long(noOfElements, pIPDRCommonParameters->pOutputBuffer_);
               					pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_;
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
 										/*write_long((int)pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRShort_, 
-											pIPDRCommonParameters->pStreamHandle_);*/
+											pIPDRCommonParameters->pOutputBuffer_);*/
 										write_short((short int)pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRShort_, 
-											pIPDRCommonParameters->pStreamHandle_);
+											pIPDRCommonParameters->pOutputBuffer_);
 
               					   pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;	
               					}
               				}
               				else {
 										/*write_long((int)pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRShort_, 
-											pIPDRCommonParameters->pStreamHandle_);*/
+											pIPDRCommonParameters->pOutputBuffer_);*/
 										write_short((short int)pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRShort_, 
-											pIPDRCommonParameters->pStreamHandle_);
+											pIPDRCommonParameters->pOutputBuffer_);
               				}
                         break;
               
@@ -1904,22 +1899,22 @@ writeIPDRXDRComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
               				if (noOfElements > 0) {
               						noOfElements = 
 									pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->noOfElements_;
-									write_long(noOfElements, pIPDRCommonParameters->pStreamHandle_);
+									write_long(noOfElements, pIPDRCommonParameters->pOutputBuffer_);
               					pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_;
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
 										/*write_u_long((unsigned int)pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUShort_, 
-											pIPDRCommonParameters->pStreamHandle_);*/
+											pIPDRCommonParameters->pOutputBuffer_);*/
 										write_u_short((unsigned int)pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUShort_, 
-											pIPDRCommonParameters->pStreamHandle_);
+											pIPDRCommonParameters->pOutputBuffer_);
 
               					   pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;	
               					}
               				}
               				else {
 										/*write_u_long((unsigned int)pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRUShort_, 
-											pIPDRCommonParameters->pStreamHandle_);*/
+											pIPDRCommonParameters->pOutputBuffer_);*/
 										write_u_short((unsigned int)pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRUShort_, 
-											pIPDRCommonParameters->pStreamHandle_);
+											pIPDRCommonParameters->pOutputBuffer_);
               				}
                         break;
 
@@ -1938,17 +1933,17 @@ writeIPDRXDRComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
               				if (noOfElements > 0) {
               						noOfElements = 
 									pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->noOfElements_;
-									write_long(noOfElements, pIPDRCommonParameters->pStreamHandle_);
+									write_long(noOfElements, pIPDRCommonParameters->pOutputBuffer_);
               					pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_;
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
 										write_byte((int) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRByte_, 
-													  pIPDRCommonParameters->pStreamHandle_);
+													  pIPDRCommonParameters->pOutputBuffer_);
               					   pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;	
               					}
               				}
               				else {
 										write_byte((int) pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRByte_, 
-													  pIPDRCommonParameters->pStreamHandle_);
+													  pIPDRCommonParameters->pOutputBuffer_);
               				}
                         break;
 
@@ -1967,17 +1962,17 @@ writeIPDRXDRComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
               				if (noOfElements > 0) {
               						noOfElements = 
 									pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->noOfElements_;
-									write_long(noOfElements, pIPDRCommonParameters->pStreamHandle_);
+									write_long(noOfElements, pIPDRCommonParameters->pOutputBuffer_);
               					pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_;
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
 										write_long((int) pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRByte_, 
-													  pIPDRCommonParameters->pStreamHandle_);
+													  pIPDRCommonParameters->pOutputBuffer_);
               					   pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;	
               					}
               				}
               				else {
 										write_long((int) pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRByte_, 
-													  pIPDRCommonParameters->pStreamHandle_);
+													  pIPDRCommonParameters->pOutputBuffer_);
               				}
                         break;
               
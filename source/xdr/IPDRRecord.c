@@ -21,16 +21,347 @@
  *****************************************************/
 
 #include "xdr/IPDRRecord.h"
+#include "xdr/XDRCodecPlan.h"
+
+/*!
+ *  NAME:
+ *      copyListAttributeDescriptor() - copies a list of attribute
+ *                                      descriptors
+ *
+ *  DESCRIPTION:
+ *     	Appends a copy of every element of pSource to *pHeadRef.
+ *
+ *	ARGUMENTS:
+ *        -	pHeadRef {IN/OUT}
+ *        -	pSource (IN)
+ *	      
+ *  RETURNS 	
+ *	      Returns Zero or appropriate error code
+*/
+
+static int copyListAttributeDescriptor(
+				  ListAttributeDescriptor** pHeadRef, 
+				  const ListAttributeDescriptor* pSource
+				 )
+{
+	AttributeDescriptor* pAttributeDescriptor;
+
+	for (; pSource != NULL; pSource = pSource->pNext_) {
+		pAttributeDescriptor = pSource->pAttributeDescriptor_;
+		if (appendListAttributeDescriptor(pHeadRef,
+						pAttributeDescriptor->attributeName_,
+						pAttributeDescriptor->attributeType_,
+						pAttributeDescriptor->description_,
+						pAttributeDescriptor->derivedType_,
+						pAttributeDescriptor->complexType_, 
+						pAttributeDescriptor->pListAttrNameList_, 
+						pAttributeDescriptor->pListAttrClassList_, 
+						pAttributeDescriptor->pListAttrMaxOccursList_, 
+						pAttributeDescriptor->noOfElements_) != IPDR_OK)
+			return (IPDR_MEMORY_ALLOCATION_FAILED);
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      fingerprintDescriptor() - computes the structural fingerprint 
+ *                                of a descriptor
+ *
+ *  DESCRIPTION:
+ *     	FNV-1a hash over the type name and the name, type, description,
+ *      derived type, complex type and number of elements of every
+ *      attribute, i.e. the fields that identify a descriptor.
+ *
+ *	ARGUMENTS:
+ *        -	typeName (IN)
+ *        -	pListAttributeDescriptor (IN)
+ *	      
+ *  RETURNS 	
+ *	      Returns the fingerprint
+*/
+
+static unsigned int fingerprintString(unsigned int hash, const char* string)
+{
+	for (; *string != '\0'; string++) {
+		hash ^= (unsigned char) *string;
+		hash *= IPDR_FNV_PRIME;
+	}
+	/* Terminator, so that "ab","c" and "a","bc" differ */
+	hash *= IPDR_FNV_PRIME;
+	return (hash);
+}
+
+unsigned int fingerprintDescriptor(
+				  const char* typeName, 
+				  const ListAttributeDescriptor* pListAttributeDescriptor
+				 )
+{
+	unsigned int hash = IPDR_FNV_OFFSET_BASIS;
+	const AttributeDescriptor* pAttributeDescriptor;
+
+	hash = fingerprintString(hash, typeName);
+	for (; pListAttributeDescriptor != NULL; 
+		 pListAttributeDescriptor = pListAttributeDescriptor->pNext_) {
+		pAttributeDescriptor = pListAttributeDescriptor->pAttributeDescriptor_;
+		hash = fingerprintString(hash, pAttributeDescriptor->attributeName_);
+		hash = fingerprintString(hash, pAttributeDescriptor->attributeType_);
+		hash = fingerprintString(hash, pAttributeDescriptor->description_);
+		hash = fingerprintString(hash, pAttributeDescriptor->derivedType_);
+		hash = fingerprintString(hash, pAttributeDescriptor->complexType_);
+		hash ^= (unsigned int) pAttributeDescriptor->noOfElements_;
+		hash *= IPDR_FNV_PRIME;
+	}
+
+	return (hash);
+}
+
+
+/*!
+ *  NAME:
+ *      matchDescriptor() - compares a descriptor with a type name and
+ *                          attribute list
+ *
+ *  DESCRIPTION:
+ *     	Confirms a fingerprint hit field by field.
+ *
+ *	ARGUMENTS:
+ *        -	pRecordDescriptor (IN)
+ *        -	typeName (IN)
+ *        -	pListAttributeDescriptor (IN)
+ *	      
+ *  RETURNS 	
+ *	      Returns IPDR_TRUE if they describe the same record, IPDR_FALSE otherwise
+*/
+
+static int matchDescriptor(
+				  const RecordDescriptor* pRecordDescriptor, 
+				  const char* typeName, 
+				  const ListAttributeDescriptor* pListAttributeDescriptor
+				 )
+{
+	const ListAttributeDescriptor* pCurrent;
+	const AttributeDescriptor* pLeft;
+	const AttributeDescriptor* pRight;
+
+	if (strcmp(pRecordDescriptor->typeName_, typeName) != 0)
+		return (IPDR_FALSE);
+
+	pCurrent = pRecordDescriptor->pListAttributeDescriptor_;
+	for (; pCurrent != NULL && pListAttributeDescriptor != NULL;
+		 pCurrent = pCurrent->pNext_,
+		 pListAttributeDescriptor = pListAttributeDescriptor->pNext_) {
+		pLeft = pCurrent->pAttributeDescriptor_;
+		pRight = pListAttributeDescriptor->pAttributeDescriptor_;
+		if (pLeft->noOfElements_ != pRight->noOfElements_ ||
+			strcmp(pLeft->attributeName_, pRight->attributeName_) != 0 ||
+			strcmp(pLeft->attributeType_, pRight->attributeType_) != 0 ||
+			strcmp(pLeft->description_, pRight->description_) != 0 ||
+			strcmp(pLeft->derivedType_, pRight->derivedType_) != 0 ||
+			strcmp(pLeft->complexType_, pRight->complexType_) != 0)
+			return (IPDR_FALSE);
+	}
+
+	if (pCurrent != NULL || pListAttributeDescriptor != NULL)
+		return (IPDR_FALSE);
+
+	return (IPDR_TRUE);
+}
+
+
+/*!
+ *  NAME:
+ *      storeDescriptor() - puts a decoded descriptor in the descriptor
+ *                          cache
+ *
+ *  DESCRIPTION:
+ *     	The cache is an array of descriptors indexed by descriptor ID,
+ *      with the fingerprint of each descriptor alongside. It grows 
+ *      by doubling. A descriptor redefining an ID replaces the cached
+ *      one. On success the cache owns pRecordDescriptor; IDs outside
+ *      [0, IPDR_DESCRIPTOR_CACHE_LIMIT) are not cached and the 
+ *      descriptor is freed.
+ *
+ *	ARGUMENTS:
+ *        -	IPDRCommonParameters {IN/OUT}
+ *        -	pRecordDescriptor (IN)
+ *		  - pErrorCode { IN / OUT }
+ *	      
+ *  RETURNS 	
+ *	      Returns Zero or appropriate error code
+*/
+
+static int storeDescriptor(
+				  IPDRCommonParameters* pIPDRCommonParameters, 
+				  RecordDescriptor* pRecordDescriptor, 
+				  int* pErrorCode
+				 )
+{
+	int size = 0;
+	int count = 0;
+	int descriptorID = pRecordDescriptor->descriptorID_;
+	RecordDescriptor** ppDescriptorCache;
+	unsigned int* pDescriptorFingerprints;
+	XDRCodecPlan** ppCodecPlans;
+
+	if (descriptorID < 0 || descriptorID >= IPDR_DESCRIPTOR_CACHE_LIMIT) {
+		freeRecordDescriptor(pRecordDescriptor);
+		return (IPDR_OK);
+	}
+
+	if (descriptorID >= pIPDRCommonParameters->descriptorCacheSize_) {
+		size = pIPDRCommonParameters->descriptorCacheSize_ * 2;
+		if (size <= descriptorID)
+			size = descriptorID + 1;
+		ppDescriptorCache = (RecordDescriptor **) realloc(
+								pIPDRCommonParameters->ppDescriptorCache_,
+								size * sizeof(RecordDescriptor *));
+		if (ppDescriptorCache != NULL)
+			pIPDRCommonParameters->ppDescriptorCache_ = ppDescriptorCache;
+		pDescriptorFingerprints = (unsigned int *) realloc(
+								pIPDRCommonParameters->pDescriptorFingerprints_,
+								size * sizeof(unsigned int));
+		if (pDescriptorFingerprints != NULL)
+			pIPDRCommonParameters->pDescriptorFingerprints_ = pDescriptorFingerprints;
+		ppCodecPlans = (XDRCodecPlan **) realloc(
+								pIPDRCommonParameters->ppCodecPlans_,
+								size * sizeof(XDRCodecPlan *));
+		if (ppCodecPlans != NULL)
+			pIPDRCommonParameters->ppCodecPlans_ = ppCodecPlans;
+		if (ppDescriptorCache == NULL || pDescriptorFingerprints == NULL ||
+			ppCodecPlans == NULL) {
+			freeRecordDescriptor(pRecordDescriptor);
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return (IPDR_ERROR);
+		}
+		for (count = pIPDRCommonParameters->descriptorCacheSize_; count < size; count++) {
+			ppDescriptorCache[count] = NULL;
+			pDescriptorFingerprints[count] = 0;
+			ppCodecPlans[count] = NULL;
+		}
+		pIPDRCommonParameters->descriptorCacheSize_ = size;
+	}
+
+	if (pIPDRCommonParameters->ppDescriptorCache_[descriptorID] != NULL)
+		freeRecordDescriptor(pIPDRCommonParameters->ppDescriptorCache_[descriptorID]);
+	if (pIPDRCommonParameters->ppCodecPlans_[descriptorID] != NULL) {
+		freeXDRCodecPlan(pIPDRCommonParameters->ppCodecPlans_[descriptorID]);
+		pIPDRCommonParameters->ppCodecPlans_[descriptorID] = NULL;
+	}
+	pIPDRCommonParameters->ppDescriptorCache_[descriptorID] = pRecordDescriptor;
+	pIPDRCommonParameters->pDescriptorFingerprints_[descriptorID] = 
+		fingerprintDescriptor(pRecordDescriptor->typeName_, 
+							  pRecordDescriptor->pListAttributeDescriptor_);
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      findDescriptor() -  finds the descriptor of a record type
+ *                     
+ *  DESCRIPTION:
+ *     	Looks the descriptor up in the descriptor cache by its 
+ *      structural fingerprint, so that no key string is built per
+ *      record. Fingerprint hits are confirmed field by field.
+ *
+ *	ARGUMENTS:
+ *        -	IPDRCommonParameters {IN}
+ *        -	typeName (IN)
+ *        -	pListAttributeDescriptor (IN)
+ *	      
+ *  RETURNS 	
+ *	      Returns the descriptor ID or 0 if there is no such descriptor
+*/
+
+int findDescriptor(
+				  IPDRCommonParameters* pIPDRCommonParameters, 
+				  const char* typeName, 
+				  const ListAttributeDescriptor* pListAttributeDescriptor
+				 )
+{
+	int descriptorID = 0;
+	unsigned int fingerprint = 0;
+
+	if (pIPDRCommonParameters == NULL || typeName == NULL)
+		return (0);
+
+	fingerprint = fingerprintDescriptor(typeName, pListAttributeDescriptor);
+	for (descriptorID = 0; descriptorID < pIPDRCommonParameters->descriptorCacheSize_; descriptorID++) {
+		if (pIPDRCommonParameters->ppDescriptorCache_[descriptorID] != NULL &&
+			pIPDRCommonParameters->pDescriptorFingerprints_[descriptorID] == fingerprint &&
+			matchDescriptor(pIPDRCommonParameters->ppDescriptorCache_[descriptorID],
+							typeName, pListAttributeDescriptor) == IPDR_TRUE)
+			return (descriptorID);
+	}
+
+	return (0);
+}
+
+
+/*!
+ *  NAME:
+ *      dropDescriptors() -  drops the descriptors created from an ID on
+ *                     
+ *  DESCRIPTION:
+ *     	Frees the cached descriptors and codec plans of the IDs from
+ *      descriptorCount up to the descriptor count of the document and
+ *      sets the count back, as if those descriptors had never been
+ *      created. Used when the records that created them are not
+ *      written after all.
+ *
+ *	ARGUMENTS:
+ *        -	IPDRCommonParameters {IN/OUT}
+ *        -	descriptorCount (IN)
+ *	      
+ *  RETURNS 	
+ *	      Returns Zero or appropriate error code
+*/
+
+int dropDescriptors(
+				  IPDRCommonParameters* pIPDRCommonParameters, 
+				  int descriptorCount
+				 )
+{
+	int descriptorID = 0;
+
+	if (pIPDRCommonParameters == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	if (descriptorCount < 0 || descriptorCount > pIPDRCommonParameters->descriptorCount_)
+		return (IPDR_INVALID_INPUT_PARAM_VALUE);
+
+	for (descriptorID = descriptorCount; 
+		 descriptorID < pIPDRCommonParameters->descriptorCount_ &&
+		 descriptorID < pIPDRCommonParameters->descriptorCacheSize_; descriptorID++) {
+		if (pIPDRCommonParameters->ppDescriptorCache_[descriptorID] != NULL) {
+			freeRecordDescriptor(pIPDRCommonParameters->ppDescriptorCache_[descriptorID]);
+			pIPDRCommonParameters->ppDescriptorCache_[descriptorID] = NULL;
+		}
+		if (pIPDRCommonParameters->ppCodecPlans_[descriptorID] != NULL) {
+			freeXDRCodecPlan(pIPDRCommonParameters->ppCodecPlans_[descriptorID]);
+			pIPDRCommonParameters->ppCodecPlans_[descriptorID] = NULL;
+		}
+		pIPDRCommonParameters->pDescriptorFingerprints_[descriptorID] = 0;
+	}
+	pIPDRCommonParameters->descriptorCount_ = descriptorCount;
+
+	return (IPDR_OK);
+}
+
 
 /*!
  *  NAME:
  *  createDescriptor() - This function creates descriptor according to NDM-U 3.0 
- *                       specification and adds the same in Descriptor Lookup Table. 
+ *                       specification and adds the same in the descriptor cache. 
  *                     
  *  DESCRIPTION:
  *     	  - This function takes the set of AttributeDescriptor from 
- *          AttributeDescriptor HashTable and adds the same in Descriptor Lookup 
- *			table with new Descriptor ID (generated sequentially)
+ *          AttributeDescriptor HashTable and adds the same in the descriptor 
+ *			cache with new Descriptor ID (generated sequentially)
  *        - It creates Descriptor structure according to NDM-U 3.0 specifications
  *		  - This function updates the global parameter DescriptorCount
  *		  - Associate the new descriptor with the stream element
@@ -53,10 +384,7 @@ int createDescriptor(
 					)	
 {	
 	int errorSeverity;
-	int result = 0;
-   unsigned int length = 0;
-	char* tempString;
-	FNFType* pFNFType; 
+	RecordDescriptor* pCachedDescriptor;
 	ListAttributeDescriptor* pCurrent = NULL;
 	IPDRStreamElement* pIPDRStreamElement = NULL;
 
@@ -77,34 +405,30 @@ int createDescriptor(
 
 	/*
     1. This function takes the set of AttributeDescriptor from 
- 	   AttributeDescriptorHashTable and adds the same in Descriptor 
-       Lookup table with new Descriptor ID (generated sequentially).
+ 	   AttributeDescriptorHashTable and adds the same in the descriptor
+       cache with new Descriptor ID (generated sequentially).
     */
 	
-
-	pFNFType = newFNFType(); 
-	strcpy(pFNFType->serviceType_, pFNFData->typeName_);
-	pFNFType->pListAttributeDescriptor_ = pListAttributeDescriptor; 
-
-    length = getLengthSerializeFNFType(pFNFType);
-    tempString = (char *) calloc(sizeof(char), length);
-	
-	if(tempString == NULL ) {
+	pCachedDescriptor = newRecordDescriptor();
+	if(pCachedDescriptor == NULL) {
 		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
 		return(IPDR_ERROR);
 	}
-
-	errorSeverity = serializeFNFTypeStructure(pFNFType, tempString, pErrorCode);
-	if (errorSeverity == IPDR_WARNING) {
-		errorHandler(pIPDRCommonParameters, pErrorCode, "serializeFNFTypeStructure");
+	pCachedDescriptor->descriptorID_ = pIPDRCommonParameters->descriptorCount_;
+	strcpy(pCachedDescriptor->typeName_, pFNFData->typeName_);
+	if (copyListAttributeDescriptor(&pCachedDescriptor->pListAttributeDescriptor_,
+									pListAttributeDescriptor) != IPDR_OK) {
+		freeRecordDescriptor(pCachedDescriptor);
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return(IPDR_ERROR);
 	}
-	else if (errorSeverity == IPDR_ERROR) {
+
+	errorSeverity = storeDescriptor(pIPDRCommonParameters, pCachedDescriptor, pErrorCode);
+	if (errorSeverity == IPDR_ERROR) {
 		pIPDRCommonParameters->DocState_ = NONWRITABLE; 
-		exceptionHandler(pIPDRCommonParameters, pErrorCode, "serializeFNFTypeStructure");
+		exceptionHandler(pIPDRCommonParameters, pErrorCode, "storeDescriptor");
 		return (IPDR_ERROR);
 	}	
-
-	HashTablePut(pIPDRCommonParameters->pDescriptorLookupHashTable_, tempString, (void *) pIPDRCommonParameters->descriptorCount_);
 	
 	/*  2. It creates Descriptor structure according to NDM-U 3.0 specifications.*/
 	pIPDRStreamElement->pStreamElement_->StreamElementUnion_.pRecordDescriptor_->descriptorID_ = pIPDRCommonParameters->descriptorCount_;
@@ -164,8 +488,6 @@ int createDescriptor(
 		return (IPDR_ERROR);
 	}	
 
-	free (tempString);
-	freeFNFType (pFNFType); 
 	freeIPDRStreamElement(pIPDRStreamElement);
 	return (IPDR_OK);	
 }
@@ -218,7 +540,7 @@ int createIPDRRecordStructure(IPDRCommonParameters* pIPDRCommonParameters,
 /*!
  *  NAME:
  *      addDescriptor() -  This function adds a new descriptor to the 
- *                         DescriptorLookUpHashTable (part of IPDRCommonParameter).
+ *                         descriptor lookup map (part of IPDRCommonParameter).
  *                     
  *  DESCRIPTION:
  *     	This function generates the descriptor for this type & registers it.
@@ -238,13 +560,13 @@ int addDescriptor(IPDRCommonParameters *pIPDRCommonParameters,
                   int* pErrorCode)
 {
 	char* tempString;
-	char* descriptorID;
 
 	int errorSeverity = 0;
 	int tempDescriptorID = 0;
 	unsigned int length = 0;
 	
 	FNFType* pFNFType;
+	RecordDescriptor* pCachedDescriptor;
 	
 	if(pRecordDescriptor == NULL ||
 	   pIPDRCommonParameters == NULL 
@@ -254,9 +576,8 @@ int addDescriptor(IPDRCommonParameters *pIPDRCommonParameters,
 	}
 
 	pFNFType = newFNFType(); 
-	descriptorID = (char *) calloc(sizeof(char), MAX_IPDR_STRING);
 	
-	if(descriptorID == NULL || pFNFType == NULL) {
+	if(pFNFType == NULL) {
 		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
 		return(IPDR_ERROR);
 	}
@@ -283,26 +604,82 @@ int addDescriptor(IPDRCommonParameters *pIPDRCommonParameters,
 	}	
 
 	tempDescriptorID = pRecordDescriptor->descriptorID_;
-	sprintf(descriptorID, "%d", tempDescriptorID);
 
-	HashTablePutstr(pIPDRCommonParameters->pDescriptorLookupHashTable_, descriptorID, tempString);
+	if (pIPDRCommonParameters->pDescriptorLookupMap_ == NULL)
+		pIPDRCommonParameters->pDescriptorLookupMap_ = newIPDRIntMap(HASH_BUCKETS, free);
+
+	/* The map owns the serialized descriptor from here on */
+	if (putIPDRIntMap(pIPDRCommonParameters->pDescriptorLookupMap_, 
+					  tempDescriptorID, tempString, pErrorCode) != IPDR_OK) {
+		free(tempString);
+		freeFNFType(pFNFType);
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return(IPDR_ERROR);
+	}
+
+	/* Decode once; records index the decoded descriptor by ID */
+	errorSeverity = IPDR_OK;
+	pCachedDescriptor = newRecordDescriptor();
+	if (pCachedDescriptor == NULL) {
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return(IPDR_ERROR);
+	}
+	if (deserializeFNFTypeStructure(tempString, pCachedDescriptor) == IPDR_OK) {
+		pCachedDescriptor->descriptorID_ = tempDescriptorID;
+		errorSeverity = storeDescriptor(pIPDRCommonParameters, pCachedDescriptor, pErrorCode);
+	}
+	else
+		freeRecordDescriptor(pCachedDescriptor);
 
 	pIPDRCommonParameters->descriptorCount_ ++;
 	
-	free(tempString);
-	free(descriptorID);
 	freeFNFType(pFNFType); 
 
-	return (IPDR_OK);
+	return (errorSeverity);
+}
+
+/*!
+ *  NAME:
+ *      lookupDescriptor() -  This function returns the decoded descriptor 
+ *                            for an ID
+ *                     
+ *  DESCRIPTION:
+ *     	Indexes the descriptor cache filled by addDescriptor and
+ *      createDescriptor. The returned descriptor is owned by 
+ *      IPDRCommonParameters and must not be modified or freed by 
+ *      the caller.
+ *
+ *	ARGUMENTS:
+ *        -	IPDRCommonParameters {IN}
+ *		  - descriptorID { IN } 
+ *	      
+ *  RETURNS 	
+ *	      Returns the cached descriptor or NULL if the ID is not cached
+*/
+
+const RecordDescriptor* lookupDescriptor(
+				  IPDRCommonParameters* pIPDRCommonParameters, 
+				  int descriptorID
+				 )
+{
+	if (pIPDRCommonParameters == NULL ||
+		descriptorID < 0 ||
+		descriptorID >= pIPDRCommonParameters->descriptorCacheSize_)
+		return (NULL);
+
+	return (pIPDRCommonParameters->ppDescriptorCache_[descriptorID]);
 }
 
+
 /*!
  *  NAME:
  *      getDescriptor() -  This function gets descriptor 
  *                         
  *                     
  *  DESCRIPTION:
- *     	This function gets descriptor.
+ *     	This function copies the descriptor into pRecordDescriptor. 
+ *      Cached descriptors are copied as is; others are deserialized
+ *      from the descriptor lookup map.
  *
  *	ARGUMENTS:
  *        -	IPDRCommonParameters {IN/OUT}
@@ -323,10 +700,8 @@ int getDescriptor(
 				 )
 {
 	char* tempString = NULL;
-	char* key;
-	int result = 0;
-	int check = 0;
 	int errorSeverity = 0;
+	const RecordDescriptor* pCachedDescriptor;
 	
 	if(pRecordDescriptor == NULL ||
 	   pIPDRCommonParameters == NULL 
@@ -335,21 +710,24 @@ int getDescriptor(
 		return (IPDR_ERROR);
 	}
 
-	key = (char *) calloc(sizeof(char), MAX_ATTRIBUTE_LENGTH);
-	if(key == NULL) {
-		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
-		return(IPDR_ERROR);
+	pCachedDescriptor = lookupDescriptor(pIPDRCommonParameters, descriptorID);
+	if (pCachedDescriptor != NULL) {
+		strcpy(pRecordDescriptor->typeName_, pCachedDescriptor->typeName_);
+		if (copyListAttributeDescriptor(&(pRecordDescriptor->pListAttributeDescriptor_),
+						pCachedDescriptor->pListAttributeDescriptor_) != IPDR_OK) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return (IPDR_ERROR);
+		}
+		pRecordDescriptor->descriptorID_ = descriptorID; 
+		return (IPDR_OK);
 	}
 
-	sprintf(key, "%d", descriptorID);
-	
-	check = HashTableContainsKey(pIPDRCommonParameters->pDescriptorLookupHashTable_, key);
-	if(check = 0) {
+	tempString = (char *) getIPDRIntMap(pIPDRCommonParameters->pDescriptorLookupMap_, 
+										descriptorID);
+	if(tempString == NULL) {
 		*pErrorCode = IPDR_NO_SUCH_DESCRIPTOR;
 		return (IPDR_ERROR);
 	}
-
-	tempString = (char *) HashTableGet(pIPDRCommonParameters->pDescriptorLookupHashTable_, key);
 	
 	errorSeverity = deserializeFNFTypeStructure(tempString, pRecordDescriptor);
 	if (errorSeverity == IPDR_WARNING) {
@@ -361,12 +739,7 @@ int getDescriptor(
 		return (IPDR_ERROR);
 	}	
 
-	if (pRecordDescriptor == NULL)
-		return (IPDR_ERROR);
-
 	pRecordDescriptor->descriptorID_ = descriptorID; 
-	
-	free(key);
 
 	return (IPDR_OK);
 }
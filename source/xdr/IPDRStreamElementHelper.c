@@ -68,7 +68,7 @@ int writeIPDRStreamElementHelper(
 
 	descriminator = pIPDRStreamElement->descriminator_;
 
-	write_long(pIPDRStreamElement->descriminator_, pIPDRCommonParameters->pStreamHandle_);
+	write_long(pIPDRStreamElement->descriminator_, pIPDRCommonParameters->pOutputBuffer_);
 	
 	switch (descriminator)
 	{
@@ -165,7 +165,7 @@ int readIPDRStreamElementHelper(
 	}
 	
 	if(pIPDRStreamElement->descriminator_ != 1 && pIPDRStreamElement->descriminator_ != 2) {
-			descriminator = read_long(pIPDRCommonParameters->pStreamHandle_); 
+			descriminator = read_long(pIPDRCommonParameters->pInputBuffer_); 
 		}
 		else{
 			descriminator = pIPDRStreamElement->descriminator_;
@@ -48,19 +48,15 @@ int readIPDRXDRDocEndHelper(
 						 int* pErrorCode
 						)	
 {	
-	hyper* pTmpHyper = NULL;
-	
 	if(pDocEnd == NULL) {
 		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
 		return(IPDR_ERROR);
 	}
 
 
-	pDocEnd->count_ = read_long(pIPDRCommonParameters->pStreamHandle_); 	
-	pTmpHyper = read_longlong(pIPDRCommonParameters->pStreamHandle_);	
-    pDocEnd->endTime_ = (hyper) *pTmpHyper;
+	pDocEnd->count_ = read_long(pIPDRCommonParameters->pInputBuffer_); 	
+	pDocEnd->endTime_ = read_longlong(pIPDRCommonParameters->pInputBuffer_);
 	
-	free (pTmpHyper);
 	return (IPDR_OK);	
 }
 
@@ -98,8 +94,8 @@ int writeIPDRXDRDocEndHelper(
 		return(IPDR_ERROR);
 	}
 	
-	write_long(pDocEnd->count_, pIPDRCommonParameters->pStreamHandle_);	
-	write_longlong(pDocEnd->endTime_, pIPDRCommonParameters->pStreamHandle_);	
+	write_long(pDocEnd->count_, pIPDRCommonParameters->pOutputBuffer_);	
+	write_longlong(pDocEnd->endTime_, pIPDRCommonParameters->pOutputBuffer_);	
 	
 	return (IPDR_OK);	
 }
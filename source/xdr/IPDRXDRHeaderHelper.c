@@ -66,26 +66,26 @@ int writeIPDRXDRHeaderHelper(
         
         /* Code Change to read the pIPDRCommonParameters structure member to check the schema version */
         if((strcmp(pIPDRCommonParameters->schemaVersion, IPDR_VERSION_3_1)) == 0)
-	   		write_long(COMPACT_IPDR_VERSION, pIPDRCommonParameters->pStreamHandle_);	
+	   		write_long(COMPACT_IPDR_VERSION, pIPDRCommonParameters->pOutputBuffer_);	
         else if((strcmp(pIPDRCommonParameters->schemaVersion, IPDR_VERSION_3_5)) == 0)
-	   		write_long(4, pIPDRCommonParameters->pStreamHandle_);
+	   		write_long(4, pIPDRCommonParameters->pOutputBuffer_);
         else
            return (IPDR_ERROR);	
 
 	
-	write_long(strlen(pIPDRHeader->ipdrRecorderInfo_), pIPDRCommonParameters->pStreamHandle_);
-	write_wstring((wchar *) pIPDRHeader->ipdrRecorderInfo_, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+	write_long(strlen(pIPDRHeader->ipdrRecorderInfo_), pIPDRCommonParameters->pOutputBuffer_);
+	write_wstring((wchar *) pIPDRHeader->ipdrRecorderInfo_, pIPDRCommonParameters->pOutputBuffer_, pIPDRCommonParameters->schemaVersion);
 	
-	write_longlong(pIPDRHeader->startTime_, pIPDRCommonParameters->pStreamHandle_);	
+	write_longlong(pIPDRHeader->startTime_, pIPDRCommonParameters->pOutputBuffer_);	
 	
-	write_long(strlen(pIPDRHeader->defaultNameSpaceURI_), pIPDRCommonParameters->pStreamHandle_);
-	write_wstring((wchar *) pIPDRHeader->defaultNameSpaceURI_, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+	write_long(strlen(pIPDRHeader->defaultNameSpaceURI_), pIPDRCommonParameters->pOutputBuffer_);
+	write_wstring((wchar *) pIPDRHeader->defaultNameSpaceURI_, pIPDRCommonParameters->pOutputBuffer_, pIPDRCommonParameters->schemaVersion);
 
 	otherNameSpaceInfoLength = getLengthListNameSpaceInfo(pIPDRHeader->pOtherNameSpaceInfo_);
 	if(otherNameSpaceInfoLength == IPDR_NULL_INPUT_PARAMETER)
-		write_long(0, pIPDRCommonParameters->pStreamHandle_);
+		write_long(0, pIPDRCommonParameters->pOutputBuffer_);
 	else
-		write_long(otherNameSpaceInfoLength, pIPDRCommonParameters->pStreamHandle_);
+		write_long(otherNameSpaceInfoLength, pIPDRCommonParameters->pOutputBuffer_);
 
 if(pIPDRHeader->pOtherNameSpaceInfo_ != NULL) {	
 	
@@ -105,18 +105,18 @@ if(pIPDRHeader->pOtherNameSpaceInfo_ != NULL) {
 	}
 }
 
-	write_long(getLengthListServiceDefinitionURI(pIPDRHeader->pListServiceDefinitionURI_), pIPDRCommonParameters->pStreamHandle_);
+	write_long(getLengthListServiceDefinitionURI(pIPDRHeader->pListServiceDefinitionURI_), pIPDRCommonParameters->pOutputBuffer_);
 	
 	while (pIPDRHeader->pListServiceDefinitionURI_ != NULL) {
 		
-		write_long(strlen(pIPDRHeader->pListServiceDefinitionURI_->pServiceDefintionURI_), pIPDRCommonParameters->pStreamHandle_);    
-		write_wstring((wchar *) pIPDRHeader->pListServiceDefinitionURI_->pServiceDefintionURI_, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);    
+		write_long(strlen(pIPDRHeader->pListServiceDefinitionURI_->pServiceDefintionURI_), pIPDRCommonParameters->pOutputBuffer_);    
+		write_wstring((wchar *) pIPDRHeader->pListServiceDefinitionURI_->pServiceDefintionURI_, pIPDRCommonParameters->pOutputBuffer_, pIPDRCommonParameters->schemaVersion);    
 				
 		pIPDRHeader->pListServiceDefinitionURI_ = pIPDRHeader->pListServiceDefinitionURI_->pNext_;  
 	}
 	
 	lengthDocID = strlen(pIPDRHeader->docID_) - 4;
-	write_long(lengthDocID/2 , pIPDRCommonParameters->pStreamHandle_);  	
+	write_long(lengthDocID/2 , pIPDRCommonParameters->pOutputBuffer_);  	
 	byteUUID = (byte* ) calloc (1, lengthDocID + 1);
 	
 	errorSeverity = convUUIDToByteArray(pIPDRHeader->docID_, byteUUID, pErrorCode); 
@@ -128,10 +128,10 @@ if(pIPDRHeader->pOtherNameSpaceInfo_ != NULL) {
 		return (IPDR_ERROR);
 	}	
 
-	write_noctet_array(byteUUID, pIPDRCommonParameters->pStreamHandle_, lengthDocID/2, pIPDRCommonParameters->schemaVersion);	
+	write_noctet_array(byteUUID, pIPDRCommonParameters->pOutputBuffer_, lengthDocID/2, pIPDRCommonParameters->schemaVersion);	
 	
 	/* Indefinite length indicator */	
-	write_long(IPDR_INDEFINITE_LENGTH_INDICATOR, pIPDRCommonParameters->pStreamHandle_); 
+	write_long(IPDR_INDEFINITE_LENGTH_INDICATOR, pIPDRCommonParameters->pOutputBuffer_); 
 	
 	free(byteUUID);
 	return(IPDR_OK);	
@@ -187,7 +187,6 @@ int readIPDRXDRHeaderHelper(
 	char* nameSpaceID;
 	char* nameSpaceURI;
 	char* serviceDefinitionURI;
-	hyper* pTmpHyper = NULL;
 	byte* byteUUID;
 
 	wchar* tmpString = NULL;
@@ -209,7 +208,7 @@ int readIPDRXDRHeaderHelper(
 		return(IPDR_ERROR);
 	}	
 
-	pIPDRHeader->majorVersion_ = read_long(pIPDRCommonParameters->pStreamHandle_);
+	pIPDRHeader->majorVersion_ = read_long(pIPDRCommonParameters->pInputBuffer_);
 
 	/* IPDR v3.5 ,change for version*/
         /* Code Change to read the pIPDRCommonParameters structure member to check the schema version */ 
@@ -244,51 +243,50 @@ int readIPDRXDRHeaderHelper(
 	
 	pIPDRCommonParameters->DocState_ = READABLE;
 
-	recorderInfoLength = read_long(pIPDRCommonParameters->pStreamHandle_);
+	recorderInfoLength = read_long(pIPDRCommonParameters->pInputBuffer_);
 
-	pIPDRHeader->ipdrRecorderInfo_ = (char *) read_wstring(recorderInfoLength, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);		
+	pIPDRHeader->ipdrRecorderInfo_ = (char *) read_wstring(recorderInfoLength, pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);		
 	
-	pTmpHyper = read_longlong(pIPDRCommonParameters->pStreamHandle_);		
-	pIPDRHeader->startTime_ = (hyper) *pTmpHyper;
+	pIPDRHeader->startTime_ = read_longlong(pIPDRCommonParameters->pInputBuffer_);
 
-	defaultNameSpaceLength = read_long(pIPDRCommonParameters->pStreamHandle_);
+	defaultNameSpaceLength = read_long(pIPDRCommonParameters->pInputBuffer_);
 	free(pIPDRHeader->defaultNameSpaceURI_);
 	pIPDRHeader->defaultNameSpaceURI_ = NULL;
-	pIPDRHeader->defaultNameSpaceURI_ = (char *) read_wstring(defaultNameSpaceLength, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+	pIPDRHeader->defaultNameSpaceURI_ = (char *) read_wstring(defaultNameSpaceLength, pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 	
-	otherNameSpaceInfolength = read_long(pIPDRCommonParameters->pStreamHandle_);
+	otherNameSpaceInfolength = read_long(pIPDRCommonParameters->pInputBuffer_);
 
 if(otherNameSpaceInfolength != 0) {
     for (count = 0; count < otherNameSpaceInfolength; count++){			
 
-		nameSpaceIdLength =  read_long(pIPDRCommonParameters->pStreamHandle_);
-		tmpNameSpaceURI = read_wstring(nameSpaceIdLength, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
-		nameSpaceIdLength = read_long(pIPDRCommonParameters->pStreamHandle_);
-		tmpNameSpaceID = read_wstring(nameSpaceIdLength, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+		nameSpaceIdLength =  read_long(pIPDRCommonParameters->pInputBuffer_);
+		tmpNameSpaceURI = read_wstring(nameSpaceIdLength, pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
+		nameSpaceIdLength = read_long(pIPDRCommonParameters->pInputBuffer_);
+		tmpNameSpaceID = read_wstring(nameSpaceIdLength, pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 /*
-		tmpNameSpaceID = read_wstring(nameSpaceIdLength, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
-		nameSpaceIdLength = read_long(pIPDRCommonParameters->pStreamHandle_);
-		tmpNameSpaceURI = read_wstring(nameSpaceIdLength, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+		tmpNameSpaceID = read_wstring(nameSpaceIdLength, pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
+		nameSpaceIdLength = read_long(pIPDRCommonParameters->pInputBuffer_);
+		tmpNameSpaceURI = read_wstring(nameSpaceIdLength, pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 */
 		appendListNameSpaceInfo(&pIPDRHeader->pOtherNameSpaceInfo_, (char *) tmpNameSpaceID, (char *) tmpNameSpaceURI);
 		free(tmpNameSpaceID);
 		free(tmpNameSpaceURI);
 	}
 }
-	serviceDefURILength = read_long(pIPDRCommonParameters->pStreamHandle_);
+	serviceDefURILength = read_long(pIPDRCommonParameters->pInputBuffer_);
 
     for (count = 0; count < serviceDefURILength; count++){			
 		
-		uriLength = read_long(pIPDRCommonParameters->pStreamHandle_);
-		tmpString = read_wstring(uriLength, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+		uriLength = read_long(pIPDRCommonParameters->pInputBuffer_);
+		tmpString = read_wstring(uriLength, pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 		appendListServiceDefinitionURI(&pIPDRHeader->pListServiceDefinitionURI_,(char *) tmpString);
 		free(tmpString);
 		tmpString = NULL;
 	}
 	
-	docIDLength = read_long(pIPDRCommonParameters->pStreamHandle_);
+	docIDLength = read_long(pIPDRCommonParameters->pInputBuffer_);
 	pIPDRHeader->docID_ = (char *) calloc (1, (2 * docIDLength) + 5);
-	byteUUID = read_octet_array(docIDLength,pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+	byteUUID = read_octet_array(docIDLength,pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 	
 	errorSeverity = convByteArrayToUUID(byteUUID, pIPDRHeader->docID_, pErrorCode); 
 	if (errorSeverity == IPDR_WARNING) {
@@ -309,13 +307,12 @@ if(otherNameSpaceInfolength != 0) {
 	}	
 
 	/*Indefinite Length Indicator*/
-	ipdrCompactFormat = read_long(pIPDRCommonParameters->pStreamHandle_);
+	ipdrCompactFormat = read_long(pIPDRCommonParameters->pInputBuffer_);
 	
 	free(byteUUID);
 	free(nameSpaceID);
 	free(nameSpaceURI);
 	free(serviceDefinitionURI);
-	free(pTmpHyper);
 
 	return (IPDR_OK);	
 
@@ -56,7 +56,7 @@ int writeIPDRXDRRecordHelper(
 	    return (IPDR_ERROR);
 	}
 
-	write_long(pIPDRRecord->descriptorID_, pIPDRCommonParameters->pStreamHandle_);
+	write_long(pIPDRRecord->descriptorID_, pIPDRCommonParameters->pOutputBuffer_);
 
 	errorSeverity = writeFNFDataHelper(pIPDRCommonParameters, pIPDRRecord->pFNFData_, pErrorCode);
 	if (errorSeverity == IPDR_WARNING) {
@@ -115,7 +115,7 @@ int readIPDRXDRRecordHelper(
 	}
 
 
-	descriptorID = read_long(pIPDRCommonParameters->pStreamHandle_);
+	descriptorID = read_long(pIPDRCommonParameters->pInputBuffer_);
 	pIPDRRecord->descriptorID_ = descriptorID;
 
 	errorSeverity = readFNFDataHelper(
@@ -56,12 +56,12 @@ int writeNameSpaceInfoHelper(
 	}
 	
 	nameSpaceURILength = strlen(pNameSpaceInfo->nameSpaceURI_);
-	write_long(nameSpaceURILength, pIPDRCommonParameters->pStreamHandle_);
-	write_wstring((wchar *) pNameSpaceInfo->nameSpaceURI_, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+	write_long(nameSpaceURILength, pIPDRCommonParameters->pOutputBuffer_);
+	write_wstring((wchar *) pNameSpaceInfo->nameSpaceURI_, pIPDRCommonParameters->pOutputBuffer_, pIPDRCommonParameters->schemaVersion);
 		
 	nameSpaceIDLength = strlen(pNameSpaceInfo->nameSpaceID_);
-	write_long(nameSpaceIDLength, pIPDRCommonParameters->pStreamHandle_);
-	write_wstring((wchar *) pNameSpaceInfo->nameSpaceID_, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+	write_long(nameSpaceIDLength, pIPDRCommonParameters->pOutputBuffer_);
+	write_wstring((wchar *) pNameSpaceInfo->nameSpaceID_, pIPDRCommonParameters->pOutputBuffer_, pIPDRCommonParameters->schemaVersion);
 	
 	return (IPDR_OK);
 }
@@ -99,11 +99,11 @@ int readNameSpaceInfoHelper(
 	    return (IPDR_ERROR);
 	}
 	
-	nameSpaceURILength = read_long(pIPDRCommonParameters->pStreamHandle_);
-	pNameSpaceInfo->nameSpaceURI_ = (char *) read_wstring(nameSpaceURILength, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+	nameSpaceURILength = read_long(pIPDRCommonParameters->pInputBuffer_);
+	pNameSpaceInfo->nameSpaceURI_ = (char *) read_wstring(nameSpaceURILength, pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 		
-	nameSpaceIDLength = read_long(pIPDRCommonParameters->pStreamHandle_);
-	pNameSpaceInfo->nameSpaceID_ = (char *) read_wstring(nameSpaceIDLength, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+	nameSpaceIDLength = read_long(pIPDRCommonParameters->pInputBuffer_);
+	pNameSpaceInfo->nameSpaceID_ = (char *) read_wstring(nameSpaceIDLength, pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 
 	return (IPDR_OK);
 }
@@ -60,13 +60,13 @@ int writeRecordDescriptorHelper(
 	    return (IPDR_ERROR);
 	}
 
-	write_long(pRecordDescriptor->descriptorID_, pIPDRCommonParameters->pStreamHandle_);
+	write_long(pRecordDescriptor->descriptorID_, pIPDRCommonParameters->pOutputBuffer_);
 	
-	write_long(strlen(pRecordDescriptor->typeName_), pIPDRCommonParameters->pStreamHandle_);
-	write_wstring((wchar *) pRecordDescriptor->typeName_, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+	write_long(strlen(pRecordDescriptor->typeName_), pIPDRCommonParameters->pOutputBuffer_);
+	write_wstring((wchar *) pRecordDescriptor->typeName_, pIPDRCommonParameters->pOutputBuffer_, pIPDRCommonParameters->schemaVersion);
 	
 	attributeDescriptorLength = getLengthListAttributeDescriptor(pRecordDescriptor->pListAttributeDescriptor_);
-	write_long(attributeDescriptorLength, pIPDRCommonParameters->pStreamHandle_);
+	write_long(attributeDescriptorLength, pIPDRCommonParameters->pOutputBuffer_);
 	
 	pCurrentListAttributeDescriptor = pRecordDescriptor->pListAttributeDescriptor_;
 	for(count = 0; count < attributeDescriptorLength; count++) {
@@ -139,15 +139,15 @@ int readRecordDescriptorHelper(
 	    return (IPDR_ERROR);
 	}
 	
-	pRecordDescriptor->descriptorID_ = read_long(pIPDRCommonParameters->pStreamHandle_);
+	pRecordDescriptor->descriptorID_ = read_long(pIPDRCommonParameters->pInputBuffer_);
 
-	serviceTypeLength = read_long(pIPDRCommonParameters->pStreamHandle_);
-	tmpString = read_wstring(serviceTypeLength, pIPDRCommonParameters->pStreamHandle_, pIPDRCommonParameters->schemaVersion);
+	serviceTypeLength = read_long(pIPDRCommonParameters->pInputBuffer_);
+	tmpString = read_wstring(serviceTypeLength, pIPDRCommonParameters->pInputBuffer_, pIPDRCommonParameters->schemaVersion);
 	strcpy(pRecordDescriptor->typeName_, (char *) tmpString);
 	free(tmpString);
 	tmpString = NULL;
 	
-	listAttributeDescriptorLength = read_long(pIPDRCommonParameters->pStreamHandle_);  
+	listAttributeDescriptorLength = read_long(pIPDRCommonParameters->pInputBuffer_);  
 	for (count = 0; count < listAttributeDescriptorLength; count++ ) {
 		
 	   pAttributeDescriptor = newAttributeDescriptor();
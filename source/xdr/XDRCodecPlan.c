@@ -0,0 +1,1494 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : XDRCodecPlan               *
+ * Description          : Compiled encode / decode   *
+ *                        plans of record descriptors*
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include "xdr/XDRCodecPlan.h"
+#include "xdr/XDRPrimitives.h"
+#include "xdr/XDRInputBuffer.h"
+#include "xdr/XDROutputBuffer.h"
+#include "xdr/XDRMarshaller.h"
+#include "xdr/XDRUnMarshaller.h"
+#include "xdr/FNFDataHelper.h"
+#include "xml/IPDRXMLRecordHelper.h"
+#include "utils/IPDRMemory.h"
+#include "utils/IPDRThread.h"
+#include "utils/errorCode.h"
+#include "utils/utils.h"
+
+
+/*!
+ *  NAME:
+ *      getCodecWidth() - XDR bytes of a fixed width type
+ *
+ *  DESCRIPTION:
+ *         USHORT and UBYTE are marshalled as 4 byte integers, see
+ *         writeFNFDataHelper().
+ *
+ *  ARGUMENTS:
+ *	    - typeCode {IN}
+ *
+ *  RETURNS
+ *	     Returns the width or 0 for variable width and unknown types
+ */
+
+static int getCodecWidth(int typeCode)
+{
+	switch (typeCode)
+	{
+	case IPDRDATA_LONG:
+	case IPDRDATA_ULONG:
+	case IPDRDATA_USHORT:
+	case IPDRDATA_UBYTE:
+		return (XDR_INT_BYTES);
+	case IPDRDATA_LONGLONG:
+	case IPDRDATA_ULONGLONG:
+		return (XDR_HYPER_BYTES);
+	case IPDRDATA_FLOAT:
+		return (XDR_FLOAT_BYTES);
+	case IPDRDATA_DOUBLE:
+		return (XDR_DOUBLE_BYTES);
+	case IPDRDATA_SHORT:
+		return (XDR_SHORT_BYTES);
+	case IPDRDATA_BOOLEAN:
+	case IPDRDATA_BYTE:
+		return (BYTE_BYTES);
+	default:
+		return (0);
+	}
+}
+
+
+/*!
+ *  NAME:
+ *      isStructureAttribute() - tells whether an attribute is a structure
+ *
+ *  DESCRIPTION:
+ *         Strips the namespace prefix of the complex type the way
+ *         writeFNFDataHelper() does and looks the type up with
+ *         isPrimitiveComplexType(). The descriptor is not modified.
+ *
+ *  ARGUMENTS:
+ *	    - pAttributeDescriptor {IN}
+ *
+ *  RETURNS
+ *	     Returns IPDR_TRUE for structures, IPDR_FALSE otherwise
+ */
+
+static int isStructureAttribute(const AttributeDescriptor* pAttributeDescriptor)
+{
+	int isStructure = IPDR_FALSE;
+	char* complexType = NULL;
+	char* tempString = NULL;
+	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
+
+	if (pAttributeDescriptor->complexType_[0] == '\0')
+		return (IPDR_FALSE);
+
+	complexType = (char *) calloc(strlen(pAttributeDescriptor->complexType_) + 1, sizeof(char));
+	tempString = (char *) calloc(strlen(pAttributeDescriptor->complexType_) + 1, sizeof(char));
+	if (complexType == NULL || tempString == NULL) {
+		free(complexType);
+		free(tempString);
+		return (IPDR_TRUE);
+	}
+
+	strcpy(tempString, pAttributeDescriptor->complexType_);
+	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
+	if (serviceTypeToken != NULL &&
+		strcmp(pAttributeDescriptor->complexType_, serviceTypeToken) != 0)
+		getIPDRSubstring((char *) pAttributeDescriptor->complexType_, complexType, ':');
+	else
+		strcpy(complexType, pAttributeDescriptor->complexType_);
+
+	if (isPrimitiveComplexType(complexType) == IPDR_FALSE)
+		isStructure = IPDR_TRUE;
+
+	free(tempString);
+	free(complexType);
+
+	return (isStructure);
+}
+
+
+/*!
+ *  NAME:
+ *      newXDRCodecPlan() - compiles the codec plan of a descriptor
+ *
+ *  DESCRIPTION:
+ *         Resolves the type code and XDR width of every attribute and
+ *         groups consecutive fixed width scalars in runs of at most
+ *         XDR_CODEC_RUN_LIMIT bytes. Compilation stops at the first
+ *         structure, such plans only have hasStructures_ set.
+ *
+ *  ARGUMENTS:
+ *	    - pRecordDescriptor {IN}
+ *
+ *  RETURNS
+ *	     Returns Pointer to XDRCodecPlan structure or NULL
+ */
+
+XDRCodecPlan* newXDRCodecPlan(const RecordDescriptor* pRecordDescriptor)
+{
+	int count = 0;
+	int end = 0;
+	int runWidth = 0;
+	int noOfOps = 0;
+	XDRCodecPlan* pCodecPlan;
+	XDRCodecOp* pCodecOp;
+	const ListAttributeDescriptor* pCurrent;
+
+	if (pRecordDescriptor == NULL)
+		return (NULL);
+
+	noOfOps = getLengthListAttributeDescriptor(
+					pRecordDescriptor->pListAttributeDescriptor_);
+
+	pCodecPlan = (XDRCodecPlan *) calloc(1, sizeof(XDRCodecPlan));
+	if (pCodecPlan == NULL)
+		return (NULL);
+	pCodecPlan->pOps_ = (XDRCodecOp *) calloc(noOfOps > 0 ? noOfOps : 1,
+											  sizeof(XDRCodecOp));
+	if (pCodecPlan->pOps_ == NULL) {
+		free(pCodecPlan);
+		return (NULL);
+	}
+	pCodecPlan->hasStructures_ = IPDR_FALSE;
+
+	pCurrent = pRecordDescriptor->pListAttributeDescriptor_;
+	for (count = 0; count < noOfOps; count++, pCurrent = pCurrent->pNext_) {
+		if (isStructureAttribute(pCurrent->pAttributeDescriptor_) == IPDR_TRUE) {
+			pCodecPlan->hasStructures_ = IPDR_TRUE;
+			break;
+		}
+		pCodecOp = &pCodecPlan->pOps_[count];
+		pCodecOp->typeCode_ = convAttributeTypeToTypeCode(
+								pCurrent->pAttributeDescriptor_->attributeType_);
+		pCodecOp->noOfElements_ = pCurrent->pAttributeDescriptor_->noOfElements_;
+		pCodecOp->width_ = getCodecWidth(pCodecOp->typeCode_);
+		pCodecOp->projected_ = IPDR_TRUE;
+	}
+	pCodecPlan->noOfOps_ = count;
+
+	for (count = 0; count < pCodecPlan->noOfOps_; ) {
+		pCodecOp = &pCodecPlan->pOps_[count];
+		runWidth = 0;
+		for (end = count; end < pCodecPlan->noOfOps_; end++) {
+			if (pCodecPlan->pOps_[end].noOfElements_ != 0 ||
+				pCodecPlan->pOps_[end].width_ == 0 ||
+				runWidth + pCodecPlan->pOps_[end].width_ > XDR_CODEC_RUN_LIMIT)
+				break;
+			runWidth += pCodecPlan->pOps_[end].width_;
+		}
+		if (end == count) {
+			count++;
+			continue;
+		}
+		pCodecOp->runLength_ = end - count;
+		pCodecOp->runWidth_ = runWidth;
+		count = end;
+	}
+
+	return (pCodecPlan);
+}
+
+
+/*!
+ *  NAME:
+ *      freeXDRCodecPlan() - Memory deallocation of XDRCodecPlan
+ *
+ *  DESCRIPTION:
+ *         Frees the operations and the plan.
+ *
+ *  ARGUMENTS:
+ *	    - pCodecPlan {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+ */
+
+int freeXDRCodecPlan(XDRCodecPlan* pCodecPlan)
+{
+	if (pCodecPlan == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	free(pCodecPlan->pOps_);
+	free(pCodecPlan);
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      projectXDRCodecPlan() - marks the operations read into FNFData
+ *
+ *  DESCRIPTION:
+ *         Operations of attributes outside the projection of the
+ *         document are skipped by readXDRCodecPlan().
+ *
+ *  ARGUMENTS:
+ *	    - IPDRCommonParameters {IN}
+ *	    - pRecordDescriptor {IN}
+ *	    - pCodecPlan {IN/OUT}
+ *
+ *  RETURNS
+ *	     Nothing
+ */
+
+static void projectXDRCodecPlan(const IPDRCommonParameters* pIPDRCommonParameters,
+								const RecordDescriptor* pRecordDescriptor,
+								XDRCodecPlan* pCodecPlan)
+{
+	int count = 0;
+	int slot = 0;
+	const ListAttributeDescriptor* pCurrent;
+
+	pCurrent = pRecordDescriptor->pListAttributeDescriptor_;
+	for (count = 0; count < pCodecPlan->noOfOps_ && pCurrent != NULL;
+		 count++, pCurrent = pCurrent->pNext_)
+		pCodecPlan->pOps_[count].projected_ = getIPDRStringMap(
+				pIPDRCommonParameters->pProjection_,
+				pCurrent->pAttributeDescriptor_->attributeName_, &slot);
+}
+
+
+/*!
+ *  NAME:
+ *      getXDRCodecPlan() - returns the codec plan of a descriptor ID
+ *
+ *  DESCRIPTION:
+ *         Plans are kept alongside the descriptor cache and compiled
+ *         the first time a record of the descriptor is encoded or
+ *         decoded. storeDescriptor() drops the plan of a redefined ID.
+ *         With useCodecPlans_ cleared no plan is returned, records
+ *         are then read and written attribute by attribute; the flat
+ *         record functions need a plan and fail.
+ *
+ *  ARGUMENTS:
+ *	    - IPDRCommonParameters {IN/OUT}
+ *	    - descriptorID {IN}
+ *
+ *  RETURNS
+ *	     Returns the plan or NULL if the descriptor is not cached
+ *	     or plans are not used
+ */
+
+const XDRCodecPlan* getXDRCodecPlan(IPDRCommonParameters* pIPDRCommonParameters,
+									int descriptorID)
+{
+	if (pIPDRCommonParameters == NULL ||
+		pIPDRCommonParameters->useCodecPlans_ == IPDR_FALSE ||
+		descriptorID < 0 ||
+		descriptorID >= pIPDRCommonParameters->descriptorCacheSize_ ||
+		pIPDRCommonParameters->ppDescriptorCache_[descriptorID] == NULL)
+		return (NULL);
+
+	if (pIPDRCommonParameters->ppCodecPlans_[descriptorID] == NULL) {
+		pIPDRCommonParameters->ppCodecPlans_[descriptorID] = newXDRCodecPlan(
+				pIPDRCommonParameters->ppDescriptorCache_[descriptorID]);
+		if (pIPDRCommonParameters->ppCodecPlans_[descriptorID] != NULL &&
+			pIPDRCommonParameters->pProjection_ != NULL)
+			projectXDRCodecPlan(pIPDRCommonParameters,
+								pIPDRCommonParameters->ppDescriptorCache_[descriptorID],
+								pIPDRCommonParameters->ppCodecPlans_[descriptorID]);
+	}
+
+	return (pIPDRCommonParameters->ppCodecPlans_[descriptorID]);
+}
+
+
+/*!
+ *  NAME:
+ *      encodeCodecScalar() - stores the XDR image of a fixed width value
+ *
+ *  DESCRIPTION:
+ *         Produces the same bytes as the write_* marshaller used by
+ *         writeFNFDataHelper() for the type. Booleans other than "0"
+ *         and "1" are not written.
+ *
+ *  ARGUMENTS:
+ *	    - pBuffer {OUT}
+ *	    - typeCode {IN}
+ *	    - pDataUnion {IN}
+ *
+ *  RETURNS
+ *	     Returns the number of bytes stored or -1 for other types
+ */
+
+static int encodeCodecScalar(byte* pBuffer, int typeCode,
+							 const IPDRDataUnion* pDataUnion)
+{
+	switch (typeCode)
+	{
+	case IPDRDATA_LONG:
+		xdrStoreUInt(pBuffer, (unsigned int) pDataUnion->IPDRLong_);
+		return (XDR_INT_BYTES);
+	case IPDRDATA_ULONG:
+		xdrStoreUInt(pBuffer, pDataUnion->IPDRULong_);
+		return (XDR_INT_BYTES);
+	case IPDRDATA_LONGLONG:
+		xdrStoreUHyper(pBuffer, (u_hyper) pDataUnion->IPDRLongLong_);
+		return (XDR_HYPER_BYTES);
+	case IPDRDATA_ULONGLONG:
+		xdrStoreUHyper(pBuffer, pDataUnion->IPDRULongLong_);
+		return (XDR_HYPER_BYTES);
+	case IPDRDATA_FLOAT:
+		xdrStoreFloat(pBuffer, pDataUnion->IPDRFloat_);
+		return (XDR_FLOAT_BYTES);
+	case IPDRDATA_DOUBLE:
+		xdrStoreDouble(pBuffer, pDataUnion->IPDRDouble_);
+		return (XDR_DOUBLE_BYTES);
+	case IPDRDATA_BOOLEAN:
+		if (strcmp((char *) pDataUnion->IPDRBoolean_, "0") == 0) {
+			pBuffer[0] = 0;
+			return (BYTE_BYTES);
+		} else if (strcmp((char *) pDataUnion->IPDRBoolean_, "1") == 0) {
+			pBuffer[0] = 1;
+			return (BYTE_BYTES);
+		}
+		return (0);
+	case IPDRDATA_SHORT:
+		xdrStoreUShort(pBuffer, (unsigned short) pDataUnion->IPDRShort_);
+		return (XDR_SHORT_BYTES);
+	case IPDRDATA_USHORT:
+		xdrStoreUInt(pBuffer, pDataUnion->IPDRUShort_);
+		return (XDR_INT_BYTES);
+	case IPDRDATA_UBYTE:
+		xdrStoreUInt(pBuffer, (unsigned int) pDataUnion->IPDRByte_);
+		return (XDR_INT_BYTES);
+	case IPDRDATA_BYTE:
+		pBuffer[0] = (byte) pDataUnion->IPDRByte_;
+		return (BYTE_BYTES);
+	default:
+		return (-1);
+	}
+}
+
+
+/*!
+ *  NAME:
+ *      writeCodecValue() - marshalls one value of an attribute
+ *
+ *  DESCRIPTION:
+ *         Octet arrays and strings are written with their length,
+ *         other types through encodeCodecScalar().
+ *
+ *  ARGUMENTS:
+ *	    - IPDRCommonParameters {IN/OUT}
+ *	    - typeCode {IN}
+ *	    - pDataUnion {IN}
+ *	    - pErrorCode {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+ */
+
+static int writeCodecValue(IPDRCommonParameters* pIPDRCommonParameters,
+						   int typeCode, const IPDRDataUnion* pDataUnion,
+						   int* pErrorCode)
+{
+	int length = 0;
+	byte bytes[XDR_HYPER_BYTES];
+
+	switch (typeCode)
+	{
+	case IPDRDATA_HEXADECARRAY:
+		length = getByteArrayLength(pDataUnion->IPDRByteArray_);
+		write_long(length, pIPDRCommonParameters->pOutputBuffer_);
+		write_noctet_array(pDataUnion->IPDRByteArray_,
+						   pIPDRCommonParameters->pOutputBuffer_, length,
+						   pIPDRCommonParameters->schemaVersion);
+		return (IPDR_OK);
+
+	case IPDRDATA_STRING:
+		write_long(strlen((char *) pDataUnion->IPDRUTF8Array_),
+				   pIPDRCommonParameters->pOutputBuffer_);
+		write_wstring(pDataUnion->IPDRUTF8Array_,
+					  pIPDRCommonParameters->pOutputBuffer_,
+					  pIPDRCommonParameters->schemaVersion);
+		return (IPDR_OK);
+
+	default:
+		length = encodeCodecScalar(bytes, typeCode, pDataUnion);
+		if (length < 0) {
+			*pErrorCode = IPDR_NON_PRIMITIVE_DATA_TYPE;
+			return (IPDR_ERROR);
+		}
+		appendXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, bytes, length);
+		return (IPDR_OK);
+	}
+}
+
+
+/*!
+ *  NAME:
+ *      writeXDRCodecPlan() - writes the values of a record through its plan
+ *
+ *  DESCRIPTION:
+ *         Writes the same bytes as writeFNFDataHelper() after the
+ *         indefinite length indicator. A fixed width run is encoded
+ *         in a local buffer and appended to the output buffer at once.
+ *         Arrays bounded by -1 in the descriptor take their number of
+ *         elements from the data.
+ *
+ *  ARGUMENTS:
+ *	    - IPDRCommonParameters {IN/OUT}
+ *	    - pCodecPlan {IN}
+ *	    - FNFData {IN}
+ *	    - pErrorCode {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+ */
+
+int writeXDRCodecPlan(IPDRCommonParameters* pIPDRCommonParameters,
+					  const XDRCodecPlan* pCodecPlan,
+					  FNFData* pFNFData, int* pErrorCode)
+{
+	int count = 0;
+	int cnt = 0;
+	int end = 0;
+	int length = 0;
+	int noOfElements = 0;
+	int errorSeverity = IPDR_OK;
+	byte run[XDR_CODEC_RUN_LIMIT];
+	const XDRCodecOp* pCodecOp;
+	ListIPDRData* pCurrentListIPDRData;
+	ListIPDRArrayData* pCurrentListIPDRArrayData;
+
+	if (pIPDRCommonParameters == NULL || pCodecPlan == NULL || pFNFData == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	pCurrentListIPDRData = pFNFData->pListIPDRData_;
+	count = 0;
+	while (count < pCodecPlan->noOfOps_ && pCurrentListIPDRData != NULL) {
+		pCodecOp = &pCodecPlan->pOps_[count];
+
+		if (pCodecOp->runLength_ > 0) {
+			length = 0;
+			end = count + pCodecOp->runLength_;
+			for (; count < end && pCurrentListIPDRData != NULL; count++) {
+				length += encodeCodecScalar(run + length,
+											pCodecPlan->pOps_[count].typeCode_,
+											&pCurrentListIPDRData->IPDRDataUnion_);
+				pCurrentListIPDRData = pCurrentListIPDRData->pNext_;
+			}
+			appendXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, run, length);
+			continue;
+		}
+
+		noOfElements = pCodecOp->noOfElements_;
+		if (noOfElements == -1)
+			noOfElements = pCurrentListIPDRData->noOfElements_;
+
+		if (noOfElements > 0) {
+			noOfElements = pCurrentListIPDRData->noOfElements_;
+			write_long(noOfElements, pIPDRCommonParameters->pOutputBuffer_);
+			pCurrentListIPDRArrayData = pCurrentListIPDRData->pListIPDRArrayData_;
+			for (cnt = 0; cnt < noOfElements && pCurrentListIPDRArrayData != NULL; cnt++) {
+				errorSeverity = writeCodecValue(pIPDRCommonParameters, pCodecOp->typeCode_,
+												&pCurrentListIPDRArrayData->IPDRDataUnion_,
+												pErrorCode);
+				if (errorSeverity == IPDR_ERROR)
+					return (IPDR_ERROR);
+				pCurrentListIPDRArrayData = pCurrentListIPDRArrayData->pNext_;
+			}
+		} else {
+			errorSeverity = writeCodecValue(pIPDRCommonParameters, pCodecOp->typeCode_,
+											&pCurrentListIPDRData->IPDRDataUnion_,
+											pErrorCode);
+			if (errorSeverity == IPDR_ERROR)
+				return (IPDR_ERROR);
+		}
+
+		pCurrentListIPDRData = pCurrentListIPDRData->pNext_;
+		count++;
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      decodeCodecScalar() - loads a fixed width value from its XDR image
+ *
+ *  DESCRIPTION:
+ *         Returns the value in the form appendListIPDRData() takes it:
+ *         integers in the pointer itself, hypers and floating point
+ *         values through pDataUnion and booleans as "0" / "1" in
+ *         boolValue.
+ *
+ *  ARGUMENTS:
+ *	    - typeCode {IN}
+ *	    - pBuffer {IN}
+ *	    - pDataUnion {OUT}
+ *	    - boolValue {OUT}
+ *
+ *  RETURNS
+ *	     Returns the value to append
+ */
+
+static void* decodeCodecScalar(int typeCode, const byte* pBuffer,
+							   IPDRDataUnion* pDataUnion, char* boolValue)
+{
+	switch (typeCode)
+	{
+	case IPDRDATA_LONG:
+	case IPDRDATA_UBYTE:
+		return ((void *) (long) (int) xdrLoadUInt(pBuffer));
+	case IPDRDATA_ULONG:
+	case IPDRDATA_USHORT:
+		return ((void *) (unsigned long) xdrLoadUInt(pBuffer));
+	case IPDRDATA_LONGLONG:
+		pDataUnion->IPDRLongLong_ = (hyper) xdrLoadUHyper(pBuffer);
+		return ((void *) &pDataUnion->IPDRLongLong_);
+	case IPDRDATA_ULONGLONG:
+		pDataUnion->IPDRULongLong_ = xdrLoadUHyper(pBuffer);
+		return ((void *) &pDataUnion->IPDRULongLong_);
+	case IPDRDATA_FLOAT:
+		pDataUnion->IPDRFloat_ = xdrLoadFloat(pBuffer);
+		return ((void *) &pDataUnion->IPDRFloat_);
+	case IPDRDATA_DOUBLE:
+		pDataUnion->IPDRDouble_ = xdrLoadDouble(pBuffer);
+		return ((void *) &pDataUnion->IPDRDouble_);
+	case IPDRDATA_BOOLEAN:
+		sprintf(boolValue, "%d", (int) pBuffer[0]);
+		return ((void *) boolValue);
+	case IPDRDATA_SHORT:
+		return ((void *) (long) (short int) xdrLoadUShort(pBuffer));
+	case IPDRDATA_BYTE:
+		return ((void *) (long) (char) pBuffer[0]);
+	default:
+		return (NULL);
+	}
+}
+
+
+/*!
+ *  NAME:
+ *      decodeCodecUnion() - loads a fixed width value into a union
+ *
+ *  DESCRIPTION:
+ *         Same as decodeCodecScalar() with the value left in the
+ *         member of its type, as setIPDRFlatValue() takes it. UBYTE
+ *         values are loaded as LONG, the type they are read back as,
+ *         and booleans point to "0" / "1" in boolValue.
+ *
+ *  ARGUMENTS:
+ *	    - typeCode {IN}
+ *	    - pBuffer {IN}
+ *	    - pDataUnion {OUT}
+ *	    - boolValue {OUT}
+ *
+ *  RETURNS
+ *	     Nothing
+ */
+
+static void decodeCodecUnion(int typeCode, const byte* pBuffer,
+							 IPDRDataUnion* pDataUnion, char* boolValue)
+{
+	switch (typeCode)
+	{
+	case IPDRDATA_LONG:
+	case IPDRDATA_UBYTE:
+		pDataUnion->IPDRLong_ = (int) xdrLoadUInt(pBuffer);
+		break;
+	case IPDRDATA_ULONG:
+		pDataUnion->IPDRULong_ = xdrLoadUInt(pBuffer);
+		break;
+	case IPDRDATA_USHORT:
+		pDataUnion->IPDRUShort_ = xdrLoadUInt(pBuffer);
+		break;
+	case IPDRDATA_LONGLONG:
+		pDataUnion->IPDRLongLong_ = (hyper) xdrLoadUHyper(pBuffer);
+		break;
+	case IPDRDATA_ULONGLONG:
+		pDataUnion->IPDRULongLong_ = xdrLoadUHyper(pBuffer);
+		break;
+	case IPDRDATA_FLOAT:
+		pDataUnion->IPDRFloat_ = xdrLoadFloat(pBuffer);
+		break;
+	case IPDRDATA_DOUBLE:
+		pDataUnion->IPDRDouble_ = xdrLoadDouble(pBuffer);
+		break;
+	case IPDRDATA_BOOLEAN:
+		sprintf(boolValue, "%d", (int) pBuffer[0]);
+		pDataUnion->IPDRBoolean_ = (bool *) boolValue;
+		break;
+	case IPDRDATA_SHORT:
+		pDataUnion->IPDRShort_ = (short int) xdrLoadUShort(pBuffer);
+		break;
+	case IPDRDATA_BYTE:
+		pDataUnion->IPDRByte_ = (char) pBuffer[0];
+		break;
+	default:
+		break;
+	}
+}
+
+
+/*!
+ *  NAME:
+ *      readCodecValue() - unmarshalls one value of an attribute
+ *
+ *  DESCRIPTION:
+ *         Octet arrays and strings are read with their length into
+ *         *ppOwned, which the caller frees once the value is appended.
+ *         A value cut short by the end of the document fails.
+ *
+ *  ARGUMENTS:
+ *	    - IPDRCommonParameters {IN/OUT}
+ *	    - pCodecOp {IN}
+ *	    - pDataUnion {OUT}
+ *	    - boolValue {OUT}
+ *	    - pDataValue {OUT}, the value to append
+ *	    - ppOwned {OUT}
+ *	    - pErrorCode {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+ */
+
+static int readCodecValue(IPDRCommonParameters* pIPDRCommonParameters,
+						  const XDRCodecOp* pCodecOp, IPDRDataUnion* pDataUnion,
+						  char* boolValue, void** pDataValue, void** ppOwned,
+						  int* pErrorCode)
+{
+	int length = 0;
+	const byte* pBuffer;
+	XDRInputBuffer* pInputBuffer = pIPDRCommonParameters->pInputBuffer_;
+
+	*ppOwned = NULL;
+	*pDataValue = NULL;
+
+	switch (pCodecOp->typeCode_)
+	{
+	case IPDRDATA_HEXADECARRAY:
+	case IPDRDATA_STRING:
+		length = read_long(pInputBuffer);
+		if (length < 0) {
+			*pErrorCode = IPDR_INVALID_COMPACT_FORMAT;
+			return (IPDR_ERROR);
+		}
+		if (pCodecOp->typeCode_ == IPDRDATA_HEXADECARRAY)
+			*ppOwned = read_octet_array(length, pInputBuffer,
+										pIPDRCommonParameters->schemaVersion);
+		else
+			*ppOwned = read_wstring(length, pInputBuffer,
+									pIPDRCommonParameters->schemaVersion);
+		if (*ppOwned == NULL) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return (IPDR_ERROR);
+		}
+		*pDataValue = *ppOwned;
+		break;
+
+	default:
+		pBuffer = viewXDRInputBuffer(pInputBuffer, pCodecOp->width_);
+		if (pBuffer == NULL) {
+			*pErrorCode = IPDR_EOF_ENCOUNTERED;
+			return (IPDR_ERROR);
+		}
+		*pDataValue = decodeCodecScalar(pCodecOp->typeCode_, pBuffer,
+										pDataUnion, boolValue);
+		break;
+	}
+
+	if (pInputBuffer->status_ == IPDR_EOF_ENCOUNTERED) {
+		free(*ppOwned);
+		*ppOwned = NULL;
+		*pErrorCode = IPDR_EOF_ENCOUNTERED;
+		return (IPDR_ERROR);
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      skipCodecOp() - steps over the value of one operation
+ *
+ *  DESCRIPTION:
+ *         Consumes the bytes readCodecValue() would for the value, or
+ *         for every element of an array, without decoding them.
+ *
+ *  ARGUMENTS:
+ *	    - pInputBuffer {IN/OUT}
+ *	    - pCodecOp {IN}
+ *	    - schemaVersion {IN}
+ *	    - pErrorCode {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+ */
+
+static int skipCodecOp(XDRInputBuffer* pInputBuffer, const XDRCodecOp* pCodecOp,
+					   char* schemaVersion, int* pErrorCode)
+{
+	int cnt = 0;
+	int length = 0;
+	int noOfElements = 0;
+
+	if (pCodecOp->width_ == 0 &&
+		pCodecOp->typeCode_ != IPDRDATA_HEXADECARRAY &&
+		pCodecOp->typeCode_ != IPDRDATA_STRING) {
+		*pErrorCode = IPDR_NON_PRIMITIVE_DATA_TYPE;
+		return (IPDR_ERROR);
+	}
+
+	noOfElements = 0;
+	if (pCodecOp->noOfElements_ != 0)
+		noOfElements = read_long(pInputBuffer);
+	if (noOfElements <= 0)
+		noOfElements = 1;
+
+	for (cnt = 0; cnt < noOfElements; cnt++) {
+		if (pCodecOp->width_ != 0) {
+			viewXDRInputBuffer(pInputBuffer, pCodecOp->width_);
+		} else {
+			length = read_long(pInputBuffer);
+			if (length < 0) {
+				*pErrorCode = IPDR_INVALID_COMPACT_FORMAT;
+				return (IPDR_ERROR);
+			}
+			read_octet_view(length, pInputBuffer, schemaVersion);
+		}
+		if (pInputBuffer->status_ == IPDR_EOF_ENCOUNTERED) {
+			*pErrorCode = IPDR_EOF_ENCOUNTERED;
+			return (IPDR_ERROR);
+		}
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      readXDRCodecPlan() - reads the values of a record through its plan
+ *
+ *  DESCRIPTION:
+ *         Appends to the FNFData the same values readFNFDataHelper()
+ *         does, the indefinite length indicator having been read.
+ *         A fixed width run is taken from the input buffer at once;
+ *         values are appended at the tail of the list, which is only
+ *         searched once per record. Values outside the projection of
+ *         the document are stepped over without being decoded.
+ *
+ *  ARGUMENTS:
+ *	    - IPDRCommonParameters {IN/OUT}
+ *	    - pCodecPlan {IN}
+ *	    - FNFData {IN/OUT}
+ *	    - pErrorCode {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+ */
+
+int readXDRCodecPlan(IPDRCommonParameters* pIPDRCommonParameters,
+					 const XDRCodecPlan* pCodecPlan,
+					 FNFData* pFNFData, int* pErrorCode)
+{
+	int count = 0;
+	int cnt = 0;
+	int end = 0;
+	int dataType = 0;
+	int noOfElements = 0;
+	char boolValue[4];
+	void* dataValue = NULL;
+	void* pOwned = NULL;
+	const byte* pBuffer;
+	const XDRCodecOp* pCodecOp;
+	IPDRDataUnion dataUnion;
+	ListIPDRData* pListIPDRData;
+	ListIPDRData** ppTail;
+	ListIPDRArrayData** ppArrayTail;
+
+	if (pIPDRCommonParameters == NULL || pCodecPlan == NULL || pFNFData == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	ppTail = &pFNFData->pListIPDRData_;
+	while (*ppTail != NULL)
+		ppTail = &(*ppTail)->pNext_;
+
+	count = 0;
+	while (count < pCodecPlan->noOfOps_) {
+		pCodecOp = &pCodecPlan->pOps_[count];
+		/* UBYTE values are read back as LONG */
+		dataType = (pCodecOp->typeCode_ == IPDRDATA_UBYTE) ?
+							IPDRDATA_LONG : pCodecOp->typeCode_;
+
+		if (pCodecOp->runLength_ > 0) {
+			pBuffer = viewXDRInputBuffer(pIPDRCommonParameters->pInputBuffer_,
+										 pCodecOp->runWidth_);
+			if (pBuffer == NULL ||
+				pIPDRCommonParameters->pInputBuffer_->status_ == IPDR_EOF_ENCOUNTERED) {
+				*pErrorCode = IPDR_EOF_ENCOUNTERED;
+				return (IPDR_ERROR);
+			}
+			end = count + pCodecOp->runLength_;
+			for (; count < end; count++) {
+				pCodecOp = &pCodecPlan->pOps_[count];
+				if (pCodecOp->projected_ == IPDR_FALSE) {
+					pBuffer += pCodecOp->width_;
+					continue;
+				}
+				dataType = (pCodecOp->typeCode_ == IPDRDATA_UBYTE) ?
+									IPDRDATA_LONG : pCodecOp->typeCode_;
+				dataValue = decodeCodecScalar(pCodecOp->typeCode_, pBuffer,
+											  &dataUnion, boolValue);
+				appendListIPDRData(ppTail, dataValue, dataType);
+				if (*ppTail != NULL)
+					ppTail = &(*ppTail)->pNext_;
+				pBuffer += pCodecOp->width_;
+			}
+			continue;
+		}
+
+		if (pCodecOp->projected_ == IPDR_FALSE) {
+			if (skipCodecOp(pIPDRCommonParameters->pInputBuffer_, pCodecOp,
+							pIPDRCommonParameters->schemaVersion, pErrorCode) == IPDR_ERROR)
+				return (IPDR_ERROR);
+			count++;
+			continue;
+		}
+
+		if (pCodecOp->width_ == 0 &&
+			pCodecOp->typeCode_ != IPDRDATA_HEXADECARRAY &&
+			pCodecOp->typeCode_ != IPDRDATA_STRING) {
+			*pErrorCode = IPDR_NON_PRIMITIVE_DATA_TYPE;
+			return (IPDR_ERROR);
+		}
+
+		noOfElements = 0;
+		if (pCodecOp->noOfElements_ != 0)
+			noOfElements = read_long(pIPDRCommonParameters->pInputBuffer_);
+
+		if (noOfElements > 0) {
+			pListIPDRData = (ListIPDRData *) calloc(1, sizeof(ListIPDRData));
+			if (pListIPDRData == NULL) {
+				*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+				return (IPDR_ERROR);
+			}
+			pListIPDRData->IPDRDataType_ = IPDRDATA_ARRAY;
+			ppArrayTail = &pListIPDRData->pListIPDRArrayData_;
+			/* Linked first, the elements read go with the FNFData on a failure */
+			*ppTail = pListIPDRData;
+			for (cnt = 0; cnt < noOfElements; cnt++) {
+				if (readCodecValue(pIPDRCommonParameters, pCodecOp, &dataUnion,
+								   boolValue, &dataValue, &pOwned,
+								   pErrorCode) == IPDR_ERROR)
+					return (IPDR_ERROR);
+				appendListIPDRArrayData(ppArrayTail, dataValue, dataType);
+				if (*ppArrayTail != NULL)
+					ppArrayTail = &(*ppArrayTail)->pNext_;
+				free(pOwned);
+				pListIPDRData->noOfElements_ = cnt + 1;
+			}
+		} else {
+			if (readCodecValue(pIPDRCommonParameters, pCodecOp, &dataUnion,
+							   boolValue, &dataValue, &pOwned,
+							   pErrorCode) == IPDR_ERROR)
+				return (IPDR_ERROR);
+			appendListIPDRData(ppTail, dataValue, dataType);
+			free(pOwned);
+		}
+
+		if (*ppTail != NULL)
+			ppTail = &(*ppTail)->pNext_;
+		count++;
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      viewCodecValue() - unmarshalls one value of an attribute
+ *           without a copy
+ *
+ *  DESCRIPTION:
+ *         As readCodecValue(), but an octet array or a string is
+ *         returned as a view into the input buffer, cut at its first
+ *         NUL, with its length in *pLength; *pLength is -1 for other
+ *         values.
+ *
+ *  ARGUMENTS:
+ *	    - IPDRCommonParameters {IN/OUT}
+ *	    - pCodecOp {IN}
+ *	    - pDataUnion {OUT}
+ *	    - boolValue {OUT}
+ *	    - pDataValue {OUT}, the value to set
+ *	    - pLength {OUT}
+ *	    - pErrorCode {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+ */
+
+static int viewCodecValue(IPDRCommonParameters* pIPDRCommonParameters,
+						  const XDRCodecOp* pCodecOp, IPDRDataUnion* pDataUnion,
+						  char* boolValue, void** pDataValue, int* pLength,
+						  int* pErrorCode)
+{
+	int length = 0;
+	const char* pView;
+	const char* pEnd;
+	const byte* pBuffer;
+
+	if (pCodecOp->width_ != 0) {
+		pBuffer = viewXDRInputBuffer(pIPDRCommonParameters->pInputBuffer_,
+									 pCodecOp->width_);
+		if (pBuffer == NULL) {
+			*pErrorCode = IPDR_EOF_ENCOUNTERED;
+			return (IPDR_ERROR);
+		}
+		*pDataValue = decodeCodecScalar(pCodecOp->typeCode_, pBuffer,
+										pDataUnion, boolValue);
+		*pLength = -1;
+		return (IPDR_OK);
+	}
+
+	length = read_long(pIPDRCommonParameters->pInputBuffer_);
+	if (length < 0) {
+		*pErrorCode = IPDR_INVALID_COMPACT_FORMAT;
+		return (IPDR_ERROR);
+	}
+	pView = read_wstring_view(length, pIPDRCommonParameters->pInputBuffer_,
+							  pIPDRCommonParameters->schemaVersion);
+	if (pView == NULL && length > 0) {
+		*pErrorCode = IPDR_EOF_ENCOUNTERED;
+		return (IPDR_ERROR);
+	}
+	if (length > 0) {
+		pEnd = (const char *) memchr(pView, '\0', length);
+		if (pEnd != NULL)
+			length = pEnd - pView;
+	} else {
+		pView = "";
+	}
+
+	*pDataValue = (void *) pView;
+	*pLength = length;
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      nextCodecNode() - returns the node a value is read into
+ *
+ *  DESCRIPTION:
+ *         The node at *ppNode, or a new one holding a LONG zero
+ *         linked there if the list ends.
+ *
+ *  ARGUMENTS:
+ *	    - ppNode {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns the node, NULL if it could not be allocated
+ */
+
+static ListIPDRData* nextCodecNode(ListIPDRData** ppNode)
+{
+	if (*ppNode == NULL) {
+		*ppNode = (ListIPDRData *) calloc(1, sizeof(ListIPDRData));
+		if (*ppNode != NULL)
+			(*ppNode)->IPDRDataType_ = IPDRDATA_LONG;
+	}
+	return (*ppNode);
+}
+
+
+/*!
+ *  NAME:
+ *      readXDRCodecPlanInto() - reads the values of a record through
+ *           its plan into the nodes of the FNFData
+ *
+ *  DESCRIPTION:
+ *         Leaves in the FNFData the same values readXDRCodecPlan()
+ *         appends to an empty one, the indefinite length indicator
+ *         having been read. The nodes and array elements already in
+ *         the list are set in place, reusing the buffers of their
+ *         values, and only missing ones are allocated; nodes beyond
+ *         the values of the record are freed. Strings and byte arrays
+ *         are copied once, from the input buffer into their node.
+ *
+ *  ARGUMENTS:
+ *	    - IPDRCommonParameters {IN/OUT}
+ *	    - pCodecPlan {IN}
+ *	    - FNFData {IN/OUT}, whose values are on the heap
+ *	    - pErrorCode {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+ */
+
+int readXDRCodecPlanInto(IPDRCommonParameters* pIPDRCommonParameters,
+						 const XDRCodecPlan* pCodecPlan,
+						 FNFData* pFNFData, int* pErrorCode)
+{
+	int count = 0;
+	int cnt = 0;
+	int end = 0;
+	int length = 0;
+	int dataType = 0;
+	int noOfElements = 0;
+	int errorCode = IPDR_OK;
+	char boolValue[4];
+	void* dataValue = NULL;
+	const byte* pBuffer;
+	const XDRCodecOp* pCodecOp;
+	IPDRDataUnion dataUnion;
+	ListIPDRData* pListIPDRData;
+	ListIPDRData** ppNode;
+	ListIPDRArrayData** ppElement;
+
+	if (pIPDRCommonParameters == NULL || pCodecPlan == NULL || pFNFData == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	ppNode = &pFNFData->pListIPDRData_;
+
+	count = 0;
+	while (count < pCodecPlan->noOfOps_) {
+		pCodecOp = &pCodecPlan->pOps_[count];
+		/* UBYTE values are read back as LONG */
+		dataType = (pCodecOp->typeCode_ == IPDRDATA_UBYTE) ?
+							IPDRDATA_LONG : pCodecOp->typeCode_;
+
+		if (pCodecOp->runLength_ > 0) {
+			pBuffer = viewXDRInputBuffer(pIPDRCommonParameters->pInputBuffer_,
+										 pCodecOp->runWidth_);
+			if (pBuffer == NULL) {
+				*pErrorCode = IPDR_EOF_ENCOUNTERED;
+				return (IPDR_ERROR);
+			}
+			end = count + pCodecOp->runLength_;
+			for (; count < end; count++) {
+				pCodecOp = &pCodecPlan->pOps_[count];
+				if (pCodecOp->projected_ == IPDR_FALSE) {
+					pBuffer += pCodecOp->width_;
+					continue;
+				}
+				dataType = (pCodecOp->typeCode_ == IPDRDATA_UBYTE) ?
+									IPDRDATA_LONG : pCodecOp->typeCode_;
+				dataValue = decodeCodecScalar(pCodecOp->typeCode_, pBuffer,
+											  &dataUnion, boolValue);
+				if (nextCodecNode(ppNode) == NULL) {
+					*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+					return (IPDR_ERROR);
+				}
+				errorCode = setListIPDRDataValue(*ppNode, dataValue, -1, dataType);
+				if (errorCode != IPDR_OK) {
+					*pErrorCode = errorCode;
+					return (IPDR_ERROR);
+				}
+				ppNode = &(*ppNode)->pNext_;
+				pBuffer += pCodecOp->width_;
+			}
+			continue;
+		}
+
+		if (pCodecOp->projected_ == IPDR_FALSE) {
+			if (skipCodecOp(pIPDRCommonParameters->pInputBuffer_, pCodecOp,
+							pIPDRCommonParameters->schemaVersion, pErrorCode) == IPDR_ERROR)
+				return (IPDR_ERROR);
+			count++;
+			continue;
+		}
+
+		if (pCodecOp->width_ == 0 &&
+			pCodecOp->typeCode_ != IPDRDATA_HEXADECARRAY &&
+			pCodecOp->typeCode_ != IPDRDATA_STRING) {
+			*pErrorCode = IPDR_NON_PRIMITIVE_DATA_TYPE;
+			return (IPDR_ERROR);
+		}
+
+		pListIPDRData = nextCodecNode(ppNode);
+		if (pListIPDRData == NULL) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return (IPDR_ERROR);
+		}
+
+		noOfElements = 0;
+		if (pCodecOp->noOfElements_ != 0)
+			noOfElements = read_long(pIPDRCommonParameters->pInputBuffer_);
+
+		if (noOfElements > 0) {
+			if (pListIPDRData->IPDRDataType_ != IPDRDATA_ARRAY) {
+				/* The node held a scalar, whose value goes */
+				setListIPDRDataValue(pListIPDRData, NULL, 0, IPDRDATA_LONG);
+				memset(&pListIPDRData->IPDRDataUnion_, 0, sizeof(IPDRDataUnion));
+				pListIPDRData->IPDRDataType_ = IPDRDATA_ARRAY;
+			}
+			ppElement = &pListIPDRData->pListIPDRArrayData_;
+			for (cnt = 0; cnt < noOfElements; cnt++) {
+				if (viewCodecValue(pIPDRCommonParameters, pCodecOp, &dataUnion,
+								   boolValue, &dataValue, &length, pErrorCode) == IPDR_ERROR)
+					return (IPDR_ERROR);
+				if (*ppElement == NULL) {
+					*ppElement = (ListIPDRArrayData *) calloc(1, sizeof(ListIPDRArrayData));
+					if (*ppElement == NULL) {
+						*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+						return (IPDR_ERROR);
+					}
+					(*ppElement)->IPDRDataType_ = IPDRDATA_LONG;
+				}
+				errorCode = setListIPDRArrayDataValue(*ppElement, dataValue,
+													  length, dataType);
+				if (errorCode != IPDR_OK) {
+					*pErrorCode = errorCode;
+					return (IPDR_ERROR);
+				}
+				ppElement = &(*ppElement)->pNext_;
+			}
+			freeListIPDRArrayData(ppElement);
+			*ppElement = NULL;
+			pListIPDRData->noOfElements_ = noOfElements;
+		} else {
+			if (viewCodecValue(pIPDRCommonParameters, pCodecOp, &dataUnion,
+							   boolValue, &dataValue, &length, pErrorCode) == IPDR_ERROR)
+				return (IPDR_ERROR);
+			errorCode = setListIPDRDataValue(pListIPDRData, dataValue, length, dataType);
+			if (errorCode != IPDR_OK) {
+				*pErrorCode = errorCode;
+				return (IPDR_ERROR);
+			}
+		}
+
+		ppNode = &pListIPDRData->pNext_;
+		count++;
+	}
+
+	/* Nodes left from a longer record */
+	while (*ppNode != NULL) {
+		pListIPDRData = *ppNode;
+		*ppNode = pListIPDRData->pNext_;
+		pListIPDRData->pNext_ = NULL;
+		if (pListIPDRData->IPDRDataType_ == IPDRDATA_ARRAY)
+			freeListIPDRArrayData(&pListIPDRData->pListIPDRArrayData_);
+		freeListIPDRData(&pListIPDRData);
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      skipXDRCodecPlan() - steps over the values of a record
+ *
+ *  DESCRIPTION:
+ *         Consumes exactly the bytes readXDRCodecPlan() would, without
+ *         decoding them, the indefinite length indicator having been
+ *         read. Used to find record boundaries in a mapped document.
+ *
+ *  ARGUMENTS:
+ *	    - pInputBuffer {IN/OUT}
+ *	    - pCodecPlan {IN}
+ *	    - schemaVersion {IN}
+ *	    - pErrorCode {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+ */
+
+int skipXDRCodecPlan(XDRInputBuffer* pInputBuffer,
+					 const XDRCodecPlan* pCodecPlan,
+					 char* schemaVersion, int* pErrorCode)
+{
+	int count = 0;
+	const XDRCodecOp* pCodecOp;
+
+	if (pInputBuffer == NULL || pCodecPlan == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	count = 0;
+	while (count < pCodecPlan->noOfOps_) {
+		pCodecOp = &pCodecPlan->pOps_[count];
+
+		if (pCodecOp->runLength_ > 0) {
+			viewXDRInputBuffer(pInputBuffer, pCodecOp->runWidth_);
+			count += pCodecOp->runLength_;
+			continue;
+		}
+
+		if (skipCodecOp(pInputBuffer, pCodecOp, schemaVersion, pErrorCode) == IPDR_ERROR)
+			return (IPDR_ERROR);
+		count++;
+	}
+
+	if (pInputBuffer->status_ == IPDR_EOF_ENCOUNTERED) {
+		*pErrorCode = IPDR_EOF_ENCOUNTERED;
+		return (IPDR_ERROR);
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      writeXDRCodecPlanFlat() - writes the values of a flat record
+ *                                through its plan
+ *
+ *  DESCRIPTION:
+ *         Writes the same bytes as writeXDRCodecPlan() for an FNFData
+ *         holding the values of the record. The attribute indexes of
+ *         the record are the operation indexes of the plan, and every
+ *         value has to be set.
+ *
+ *  ARGUMENTS:
+ *	    - IPDRCommonParameters {IN/OUT}
+ *	    - pCodecPlan {IN}
+ *	    - pRecord {IN}
+ *	    - pErrorCode {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+ */
+
+int writeXDRCodecPlanFlat(IPDRCommonParameters* pIPDRCommonParameters,
+						  const XDRCodecPlan* pCodecPlan,
+						  const IPDRFlatRecord* pRecord, int* pErrorCode)
+{
+	int count = 0;
+	int end = 0;
+	int length = 0;
+	byte run[XDR_CODEC_RUN_LIMIT];
+	const XDRCodecOp* pCodecOp;
+	const IPDRFlatValue* pValue;
+	IPDRDataUnion dataUnion;
+
+	if (pIPDRCommonParameters == NULL || pCodecPlan == NULL || pRecord == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	if (pCodecPlan->noOfOps_ != pRecord->noOfAttributes_) {
+		*pErrorCode = IPDR_ATTRIBUTE_NOT_IN_LAYOUT;
+		return (IPDR_ERROR);
+	}
+
+	for (count = 0; count < pRecord->noOfAttributes_; count++) {
+		if (pRecord->pValues_[count].IPDRDataType_ == 0) {
+			*pErrorCode = IPDR_ATTRIBUTE_VALUE_NOT_SET;
+			return (IPDR_ERROR);
+		}
+	}
+
+	count = 0;
+	while (count < pCodecPlan->noOfOps_) {
+		pCodecOp = &pCodecPlan->pOps_[count];
+
+		if (pCodecOp->runLength_ > 0) {
+			length = 0;
+			end = count + pCodecOp->runLength_;
+			for (; count < end; count++) {
+				pValue = &pRecord->pValues_[count];
+				dataUnion = pValue->IPDRDataUnion_;
+				if (pValue->IPDRDataType_ == IPDRDATA_BOOLEAN)
+					dataUnion.IPDRBoolean_ = (bool *) (pRecord->pPayload_ + pValue->offset_);
+				length += encodeCodecScalar(run + length,
+											pCodecPlan->pOps_[count].typeCode_,
+											&dataUnion);
+			}
+			appendXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, run, length);
+			continue;
+		}
+
+		if (pCodecOp->noOfElements_ != 0) {
+			*pErrorCode = IPDR_NON_PRIMITIVE_DATA_TYPE;
+			return (IPDR_ERROR);
+		}
+
+		pValue = &pRecord->pValues_[count];
+		if (pCodecOp->typeCode_ == IPDRDATA_HEXADECARRAY ||
+			pCodecOp->typeCode_ == IPDRDATA_STRING) {
+			/* The length is known, the value is not searched for its end */
+			write_long(pValue->length_, pIPDRCommonParameters->pOutputBuffer_);
+			write_noctet_array((byte *) (pRecord->pPayload_ + pValue->offset_),
+							   pIPDRCommonParameters->pOutputBuffer_, pValue->length_,
+							   pIPDRCommonParameters->schemaVersion);
+		} else {
+			dataUnion = pValue->IPDRDataUnion_;
+			if (pValue->IPDRDataType_ == IPDRDATA_BOOLEAN)
+				dataUnion.IPDRBoolean_ = (bool *) (pRecord->pPayload_ + pValue->offset_);
+			if (writeCodecValue(pIPDRCommonParameters, pCodecOp->typeCode_,
+								&dataUnion, pErrorCode) == IPDR_ERROR)
+				return (IPDR_ERROR);
+		}
+		count++;
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      readXDRCodecPlanFlat() - reads the values of a record into a
+ *                               flat record through its plan
+ *
+ *  DESCRIPTION:
+ *         Sets the values readXDRCodecPlan() would append, the record
+ *         having the layout of the descriptor and the indefinite
+ *         length indicator having been read. Strings and byte arrays
+ *         are copied from the input buffer into the payload once, and
+ *         end at their first NUL as they do in an FNFData. Values
+ *         outside the projection of the document are left unset.
+ *
+ *  ARGUMENTS:
+ *	    - IPDRCommonParameters {IN/OUT}
+ *	    - pCodecPlan {IN}
+ *	    - pRecord {IN/OUT}
+ *	    - pErrorCode {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+ */
+
+int readXDRCodecPlanFlat(IPDRCommonParameters* pIPDRCommonParameters,
+						 const XDRCodecPlan* pCodecPlan,
+						 IPDRFlatRecord* pRecord, int* pErrorCode)
+{
+	int count = 0;
+	int end = 0;
+	int length = 0;
+	int dataType = 0;
+	int errorCode = IPDR_OK;
+	char boolValue[4];
+	const char* pView;
+	const char* pEnd;
+	const byte* pBuffer;
+	const XDRCodecOp* pCodecOp;
+	IPDRDataUnion dataUnion;
+
+	if (pIPDRCommonParameters == NULL || pCodecPlan == NULL || pRecord == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	if (pCodecPlan->noOfOps_ != pRecord->noOfAttributes_) {
+		*pErrorCode = IPDR_ATTRIBUTE_NOT_IN_LAYOUT;
+		return (IPDR_ERROR);
+	}
+
+	count = 0;
+	while (count < pCodecPlan->noOfOps_) {
+		pCodecOp = &pCodecPlan->pOps_[count];
+
+		if (pCodecOp->runLength_ > 0) {
+			pBuffer = viewXDRInputBuffer(pIPDRCommonParameters->pInputBuffer_,
+										 pCodecOp->runWidth_);
+			if (pBuffer == NULL) {
+				*pErrorCode = IPDR_EOF_ENCOUNTERED;
+				return (IPDR_ERROR);
+			}
+			end = count + pCodecOp->runLength_;
+			for (; count < end; count++) {
+				pCodecOp = &pCodecPlan->pOps_[count];
+				if (pCodecOp->projected_ == IPDR_FALSE) {
+					pBuffer += pCodecOp->width_;
+					continue;
+				}
+				/* UBYTE values are read back as LONG */
+				dataType = (pCodecOp->typeCode_ == IPDRDATA_UBYTE) ?
+									IPDRDATA_LONG : pCodecOp->typeCode_;
+				decodeCodecUnion(pCodecOp->typeCode_, pBuffer, &dataUnion, boolValue);
+				errorCode = setIPDRFlatValue(pRecord, count, &dataUnion, dataType);
+				if (errorCode != IPDR_OK) {
+					*pErrorCode = errorCode;
+					return (IPDR_ERROR);
+				}
+				pBuffer += pCodecOp->width_;
+			}
+			continue;
+		}
+
+		if (pCodecOp->projected_ == IPDR_FALSE) {
+			if (skipCodecOp(pIPDRCommonParameters->pInputBuffer_, pCodecOp,
+							pIPDRCommonParameters->schemaVersion, pErrorCode) == IPDR_ERROR)
+				return (IPDR_ERROR);
+			count++;
+			continue;
+		}
+
+		if (pCodecOp->noOfElements_ != 0 ||
+			(pCodecOp->width_ == 0 &&
+			 pCodecOp->typeCode_ != IPDRDATA_HEXADECARRAY &&
+			 pCodecOp->typeCode_ != IPDRDATA_STRING)) {
+			*pErrorCode = IPDR_NON_PRIMITIVE_DATA_TYPE;
+			return (IPDR_ERROR);
+		}
+
+		if (pCodecOp->width_ == 0) {
+			length = read_long(pIPDRCommonParameters->pInputBuffer_);
+			if (length < 0) {
+				*pErrorCode = IPDR_INVALID_COMPACT_FORMAT;
+				return (IPDR_ERROR);
+			}
+			pView = read_wstring_view(length, pIPDRCommonParameters->pInputBuffer_,
+									  pIPDRCommonParameters->schemaVersion);
+			if (pView == NULL && length > 0) {
+				*pErrorCode = IPDR_EOF_ENCOUNTERED;
+				return (IPDR_ERROR);
+			}
+			if (length > 0) {
+				pEnd = (const char *) memchr(pView, '\0', length);
+				if (pEnd != NULL)
+					length = pEnd - pView;
+			}
+			errorCode = setIPDRFlatBytes(pRecord, count, pView, length,
+										 pCodecOp->typeCode_);
+		} else {
+			pBuffer = viewXDRInputBuffer(pIPDRCommonParameters->pInputBuffer_,
+										 pCodecOp->width_);
+			if (pBuffer == NULL) {
+				*pErrorCode = IPDR_EOF_ENCOUNTERED;
+				return (IPDR_ERROR);
+			}
+			dataType = (pCodecOp->typeCode_ == IPDRDATA_UBYTE) ?
+								IPDRDATA_LONG : pCodecOp->typeCode_;
+			decodeCodecUnion(pCodecOp->typeCode_, pBuffer, &dataUnion, boolValue);
+			errorCode = setIPDRFlatValue(pRecord, count, &dataUnion, dataType);
+		}
+		if (errorCode != IPDR_OK) {
+			*pErrorCode = errorCode;
+			return (IPDR_ERROR);
+		}
+		count++;
+	}
+
+	return (IPDR_OK);
+}
@@ -0,0 +1,472 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : XDRInputBuffer             *
+ * Description          : Input source for the XDR   *
+ *                        unmarshallers              *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include "xdr/XDRInputBuffer.h"
+#include "xdr/XDRPrimitives.h"
+#include "utils/errorCode.h"
+
+#ifndef WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+/*!
+ *  NAME:
+ *      newXDRInputBuffer() - Memory allocation of XDRInputBuffer
+ *
+ *  DESCRIPTION:
+ *         Allocates the input buffer. The stream is bound, and
+ *         mapped for XDR_INPUT_MMAP, by attachXDRInputBuffer().
+ *
+ *  ARGUMENTS:
+ *	    - inputMode {IN} XDR_INPUT_STDIO or XDR_INPUT_MMAP
+ *
+ *  RETURNS
+ *	     Returns Pointer to XDRInputBuffer structure or NULL
+ */
+
+XDRInputBuffer* newXDRInputBuffer(int inputMode)
+{
+	XDRInputBuffer* pInputBuffer;
+
+	pInputBuffer = (XDRInputBuffer *) calloc(1, sizeof(XDRInputBuffer));
+	if (pInputBuffer == NULL)
+		return (NULL);
+
+	pInputBuffer->pStreamHandle_ = NULL;
+	pInputBuffer->pMapping_ = NULL;
+	pInputBuffer->mappingLength_ = 0;
+	pInputBuffer->offset_ = 0;
+	pInputBuffer->pScratch_ = NULL;
+	pInputBuffer->scratchSize_ = 0;
+	pInputBuffer->inputMode_ = inputMode;
+	pInputBuffer->status_ = IPDR_OK;
+	pInputBuffer->borrowed_ = IPDR_FALSE;
+
+	return (pInputBuffer);
+}
+
+
+/*!
+ *  NAME:
+ *      newXDRInputBufferCursor() - Second cursor over a mapped document
+ *
+ *  DESCRIPTION:
+ *         The cursor reads the mapping of pSource without owning it;
+ *         freeing the cursor leaves the mapping in place.
+ *
+ *  ARGUMENTS:
+ *	    - pSource {IN}, a buffer with a mapped document
+ *
+ *  RETURNS
+ *	     Returns Pointer to XDRInputBuffer structure, or NULL if the
+ *	     source is not mapped or memory allocation failed
+ */
+
+XDRInputBuffer* newXDRInputBufferCursor(const XDRInputBuffer* pSource)
+{
+	XDRInputBuffer* pInputBuffer;
+
+	if (pSource == NULL || pSource->pMapping_ == NULL)
+		return (NULL);
+
+	pInputBuffer = newXDRInputBuffer(XDR_INPUT_MMAP);
+	if (pInputBuffer == NULL)
+		return (NULL);
+
+	pInputBuffer->pMapping_ = pSource->pMapping_;
+	pInputBuffer->mappingLength_ = pSource->mappingLength_;
+	pInputBuffer->offset_ = pSource->offset_;
+	pInputBuffer->borrowed_ = IPDR_TRUE;
+
+	return (pInputBuffer);
+}
+
+
+/*!
+ *  NAME:
+ *      unmapXDRInputBuffer() - Releases the mapped document
+ *
+ *  DESCRIPTION:
+ *         Views taken from the mapping are no longer valid afterwards.
+ *
+ *  ARGUMENTS:
+ *	    - pInputBuffer {IN/OUT}
+ *
+ *  RETURNS
+ *	     Nothing
+ */
+
+static void unmapXDRInputBuffer(XDRInputBuffer* pInputBuffer)
+{
+#ifndef WIN32
+	if (pInputBuffer->pMapping_ != NULL && pInputBuffer->borrowed_ == IPDR_FALSE)
+		munmap((void *) pInputBuffer->pMapping_, pInputBuffer->mappingLength_);
+#endif
+	pInputBuffer->pMapping_ = NULL;
+	pInputBuffer->mappingLength_ = 0;
+	pInputBuffer->offset_ = 0;
+	pInputBuffer->borrowed_ = IPDR_FALSE;
+}
+
+
+/*!
+ *  NAME:
+ *      freeXDRInputBuffer() - Memory deallocation of XDRInputBuffer
+ *
+ *  DESCRIPTION:
+ *         Unmaps the document and frees the buffer. The stream itself
+ *         is left open.
+ *
+ *  ARGUMENTS:
+ *	    - pInputBuffer {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int freeXDRInputBuffer(XDRInputBuffer* pInputBuffer)
+{
+	if (pInputBuffer == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	unmapXDRInputBuffer(pInputBuffer);
+	free(pInputBuffer->pScratch_);
+	free(pInputBuffer);
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      mapXDRInputBuffer() - Maps the document read by the buffer
+ *
+ *  DESCRIPTION:
+ *         Maps the whole file behind the stream read only and places
+ *         the cursor at the current stream position. Streams which
+ *         can not be mapped (pipes, empty files) are read through
+ *         stdio instead.
+ *
+ *  ARGUMENTS:
+ *	    - pInputBuffer {IN/OUT}
+ *
+ *  RETURNS
+ *	     Nothing
+ */
+
+static void mapXDRInputBuffer(XDRInputBuffer* pInputBuffer)
+{
+#ifndef WIN32
+	FILE* pStream = (FILE *) pInputBuffer->pStreamHandle_;
+	struct stat fileStatus;
+	void* pMapping = NULL;
+	long position = 0;
+
+	position = ftell(pStream);
+	if (position < 0 || fstat(fileno(pStream), &fileStatus) != 0 ||
+		!S_ISREG(fileStatus.st_mode) || fileStatus.st_size <= 0) {
+		pInputBuffer->inputMode_ = XDR_INPUT_STDIO;
+		return;
+	}
+
+	pMapping = mmap(NULL, (size_t) fileStatus.st_size, PROT_READ,
+					MAP_PRIVATE, fileno(pStream), 0);
+	if (pMapping == MAP_FAILED) {
+		pInputBuffer->inputMode_ = XDR_INPUT_STDIO;
+		return;
+	}
+#ifdef MADV_SEQUENTIAL
+	madvise(pMapping, (size_t) fileStatus.st_size, MADV_SEQUENTIAL);
+#endif
+
+	pInputBuffer->pMapping_ = (const byte *) pMapping;
+	pInputBuffer->mappingLength_ = (size_t) fileStatus.st_size;
+	pInputBuffer->offset_ = (size_t) position;
+	if (pInputBuffer->offset_ > pInputBuffer->mappingLength_)
+		pInputBuffer->offset_ = pInputBuffer->mappingLength_;
+#else
+	pInputBuffer->inputMode_ = XDR_INPUT_STDIO;
+#endif
+}
+
+
+/*!
+ *  NAME:
+ *      reserveXDRInputScratch() - Grows the scratch area
+ *
+ *  DESCRIPTION:
+ *         The scratch area backs the views of the stdio reader and
+ *         the tail of an overrun mapping.
+ *
+ *  ARGUMENTS:
+ *	    - pInputBuffer {IN/OUT}
+ *	    - length {IN}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+static int reserveXDRInputScratch(XDRInputBuffer* pInputBuffer, int length)
+{
+	byte* pScratch = NULL;
+
+	if (length <= pInputBuffer->scratchSize_)
+		return (IPDR_OK);
+
+	pScratch = (byte *) realloc(pInputBuffer->pScratch_, length);
+	if (pScratch == NULL)
+		return (IPDR_MEMORY_ALLOCATION_FAILED);
+
+	pInputBuffer->pScratch_ = pScratch;
+	pInputBuffer->scratchSize_ = length;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      readXDRInputBuffer() - Copies bytes from the document
+ *
+ *  DESCRIPTION:
+ *         Reads length bytes at the cursor. Bytes past the end of
+ *         the document are zero filled and the buffer status is set
+ *         to IPDR_EOF_ENCOUNTERED.
+ *
+ *  ARGUMENTS:
+ *	    - pInputBuffer {IN/OUT}
+ *	    - pBuffer {IN/OUT}
+ *	    - length {IN}
+ *
+ *  RETURNS
+ *	     Returns the number of bytes actually read
+ */
+
+int readXDRInputBuffer(XDRInputBuffer* pInputBuffer, byte* pBuffer, int length)
+{
+	size_t available = 0;
+	int bytesRead = 0;
+
+	if (length <= 0)
+		return (0);
+
+	if (pInputBuffer == NULL) {
+		memset(pBuffer, 0, length);
+		return (0);
+	}
+
+	if (pInputBuffer->pMapping_ == NULL) {
+		bytesRead = xdrReadBytes(pBuffer, length, pInputBuffer->pStreamHandle_);
+		if (bytesRead < length)
+			pInputBuffer->status_ = IPDR_EOF_ENCOUNTERED;
+		return (bytesRead);
+	}
+
+	available = pInputBuffer->mappingLength_ - pInputBuffer->offset_;
+	if ((size_t) length <= available) {
+		memcpy(pBuffer, pInputBuffer->pMapping_ + pInputBuffer->offset_, length);
+		pInputBuffer->offset_ += length;
+		return (length);
+	}
+
+	memcpy(pBuffer, pInputBuffer->pMapping_ + pInputBuffer->offset_, available);
+	memset(pBuffer + available, 0, length - available);
+	pInputBuffer->offset_ = pInputBuffer->mappingLength_;
+	pInputBuffer->status_ = IPDR_EOF_ENCOUNTERED;
+
+	return ((int) available);
+}
+
+
+/*!
+ *  NAME:
+ *      viewXDRInputBuffer() - Takes bytes from the document in place
+ *
+ *  DESCRIPTION:
+ *         Returns length bytes at the cursor without copying them out
+ *         of the mapping. The stdio reader, and an overrun of the
+ *         mapping, return the bytes in a scratch area instead, which
+ *         is reused by the next view.
+ *
+ *  ARGUMENTS:
+ *	    - pInputBuffer {IN/OUT}
+ *	    - length {IN}
+ *
+ *  RETURNS
+ *	     Returns a pointer to the bytes or NULL in case of failure
+ */
+
+const byte* viewXDRInputBuffer(XDRInputBuffer* pInputBuffer, int length)
+{
+	const byte* pView = NULL;
+
+	if (pInputBuffer == NULL || length < 0)
+		return (NULL);
+
+	if (pInputBuffer->pMapping_ != NULL &&
+		(size_t) length <= pInputBuffer->mappingLength_ - pInputBuffer->offset_) {
+		pView = pInputBuffer->pMapping_ + pInputBuffer->offset_;
+		pInputBuffer->offset_ += length;
+		return (pView);
+	}
+
+	if (reserveXDRInputScratch(pInputBuffer, (length > 0) ? length : 1) != IPDR_OK)
+		return (NULL);
+
+	readXDRInputBuffer(pInputBuffer, pInputBuffer->pScratch_, length);
+
+	return (pInputBuffer->pScratch_);
+}
+
+
+/*!
+ *  NAME:
+ *      seekXDRInputBuffer() - Moves the cursor of a mapped document
+ *
+ *  ARGUMENTS:
+ *	    - pInputBuffer {IN/OUT}
+ *	    - offset {IN}, from the start of the document
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK, or IPDR_ERROR if the document is not mapped
+ *	     or the offset is past its end
+ */
+
+int seekXDRInputBuffer(XDRInputBuffer* pInputBuffer, size_t offset)
+{
+	if (pInputBuffer == NULL || pInputBuffer->pMapping_ == NULL ||
+		offset > pInputBuffer->mappingLength_)
+		return (IPDR_ERROR);
+
+	pInputBuffer->offset_ = offset;
+	pInputBuffer->status_ = IPDR_OK;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      setXDRInputBuffer() - Configures the XDR input buffer
+ *
+ *  DESCRIPTION:
+ *         Replaces the input buffer of the document, to be called
+ *         before readHeader().
+ *
+ *  ARGUMENTS:
+ *	    - pIPDRCommonParameters {IN/OUT}
+ *	    - inputMode {IN}
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int setXDRInputBuffer(IPDRCommonParameters* pIPDRCommonParameters,
+					  int inputMode, int* pErrorCode)
+{
+	XDRInputBuffer* pInputBuffer = NULL;
+
+	if (pIPDRCommonParameters == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	if (inputMode != XDR_INPUT_STDIO && inputMode != XDR_INPUT_MMAP) {
+		*pErrorCode = IPDR_INVALID_INPUT_PARAM_VALUE;
+		return (IPDR_ERROR);
+	}
+
+	pInputBuffer = newXDRInputBuffer(inputMode);
+	if (pInputBuffer == NULL) {
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return (IPDR_ERROR);
+	}
+
+	if (pIPDRCommonParameters->pInputBuffer_ != NULL)
+		freeXDRInputBuffer(pIPDRCommonParameters->pInputBuffer_);
+	pIPDRCommonParameters->pInputBuffer_ = pInputBuffer;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      attachXDRInputBuffer() - Binds the input buffer to the stream
+ *
+ *  DESCRIPTION:
+ *         Creates a default input buffer if none was configured and
+ *         binds it to the input stream of the document, mapping the
+ *         document for XDR_INPUT_MMAP.
+ *
+ *  ARGUMENTS:
+ *	    - pIPDRCommonParameters {IN/OUT}
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int attachXDRInputBuffer(IPDRCommonParameters* pIPDRCommonParameters,
+						 int* pErrorCode)
+{
+	XDRInputBuffer* pInputBuffer = NULL;
+
+	if (pIPDRCommonParameters == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	if (pIPDRCommonParameters->pStreamHandle_ == NULL) {
+		*pErrorCode = IPDR_INVALID_STREAM_HANDLE;
+		return (IPDR_ERROR);
+	}
+
+	if (pIPDRCommonParameters->pInputBuffer_ == NULL) {
+		pIPDRCommonParameters->pInputBuffer_ = newXDRInputBuffer(XDR_INPUT_STDIO);
+		if (pIPDRCommonParameters->pInputBuffer_ == NULL) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return (IPDR_ERROR);
+		}
+	}
+
+	pInputBuffer = pIPDRCommonParameters->pInputBuffer_;
+	if (pInputBuffer->pStreamHandle_ == pIPDRCommonParameters->pStreamHandle_)
+		return (IPDR_OK);
+
+	unmapXDRInputBuffer(pInputBuffer);
+	pInputBuffer->pStreamHandle_ = pIPDRCommonParameters->pStreamHandle_;
+	pInputBuffer->status_ = IPDR_OK;
+	if (pInputBuffer->inputMode_ == XDR_INPUT_MMAP)
+		mapXDRInputBuffer(pInputBuffer);
+
+	return (IPDR_OK);
+}
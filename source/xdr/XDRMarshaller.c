@@ -21,6 +21,8 @@
  *****************************************************/
 
 #include "xdr/XDRMarshaller.h"
+#include "xdr/XDRPrimitives.h"
+#include "xdr/XDROutputBuffer.h"
 #include "utils/errorCode.h"
 #include "utils/IPDRCommon.h"
 
@@ -40,34 +42,22 @@ Header File. Name: "XDRMarshaller.h"
  *  
  *  ARGUMENTS:
  *      - RawValue (IN)
- *	    - pStream {IN/OUT}
+ *	    - pOutputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	     Returns Zero if the operation is successful or appropriate
  * 		 error code in case of failure.
  */
 
-int write_long(int RawValue,void *pStream)
+int write_long(int RawValue,XDROutputBuffer* pOutputBuffer)
 {
-        int byteCount = 0;
-        int count;
-        char tempByte[3] = "ff";
-        int byteToPrint;
-        unsigned char bytes[INT_BITS];
+        byte bytes[XDR_INT_BYTES];
 
-        if(pStream == NULL)
+        if(pOutputBuffer == NULL)
                 return(IPDR_NULL_INPUT_PARAMETER);
 
-        sprintf((char *)bytes, "%08x", RawValue);
-        for ( count = 0; count < INT_BITS; count = count + 2 )
-        {
-                tempByte[0] = bytes[count];
-                tempByte[1] = bytes[count+1];
-                byteToPrint = convWriteIntHexToInt(tempByte);
-                fprintf(pStream, "%c", byteToPrint);
-        }
-
-        return(IPDR_OK);
+        xdrStoreUInt(bytes, (unsigned int) RawValue);
+        return(appendXDROutputBuffer(pOutputBuffer, bytes, XDR_INT_BYTES));
 }
 
 /*!
@@ -124,37 +114,22 @@ int convWriteIntHexToInt(char iHexa[3])
  *      
  *	ARGUMENTS:
  *      - rawValue (IN)
- *	    - streamPointer {IN/OUT}
+ *	    - pOutputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	     Returns Zero if the operation is successful or appropriate
  * 		 error code in case of failure.
  */
 
-int write_double(double rawValue, void *streamPointer)
+int write_double(double rawValue, XDROutputBuffer* pOutputBuffer)
 {
-	char *cHex = NULL;
-	int count = 0;
-        char tempByte[3] = "ff";
-        int byteToPrint;
-
-	cHex = (char *)calloc(sizeof(char), DOUBLE_HEXA_BITS);
+	byte bytes[XDR_DOUBLE_BYTES];
 
-	if(streamPointer == NULL)
+	if(pOutputBuffer == NULL)
 		return(IPDR_NULL_INPUT_PARAMETER);
 
-	getWriteDoubleHexFromDouble(cHex, rawValue);
-    
-	/* Writing the values into file */
-       	for (count = 0 ; count < DOUBLE_HEXA_BITS ; count = count + 2)
-	{
-		tempByte[0] = cHex[count];
-		tempByte[1] = cHex[count + 1];
-		byteToPrint = convWriteIntHexToInt(tempByte);
-		fprintf(streamPointer, "%c", byteToPrint);
-	}
-	free(cHex);
-    return(IPDR_OK);
+	xdrStoreDouble(bytes, rawValue);
+	return(appendXDROutputBuffer(pOutputBuffer, bytes, XDR_DOUBLE_BYTES));
 }
 
 /*!
@@ -392,27 +367,15 @@ char getWriteDoubleHexFromBinary(char binary[4])
  * 		 error code in case of failure.
  */
 
-int write_float(float rawValue, void *streamPointer)
+int write_float(float rawValue, XDROutputBuffer* pOutputBuffer)
 {
-	char *cHex = NULL;
-	int count = 0;
-    char tempByte[2] = "ff";
-    int byteToPrint;
-    if(streamPointer == NULL)
-          return(IPDR_NULL_INPUT_PARAMETER);
-	cHex = (char *)calloc(sizeof(char), FLOAT_HEXA_BITS);
-	getFloatWriteHexFromDouble(cHex, rawValue);
-	
-    /* Writing the values into file */
-    for (count = 0 ; count < FLOAT_HEXA_BITS ; count = count + 2) {
-		tempByte[0] = cHex[count];
-		tempByte[1] = cHex[count + 1];
-		byteToPrint = hexToInt(tempByte);
-		fprintf(streamPointer, "%c", byteToPrint);
-	}
+	byte bytes[XDR_FLOAT_BYTES];
+
+	if(pOutputBuffer == NULL)
+		return(IPDR_NULL_INPUT_PARAMETER);
 
-	free(cHex);
-    return(IPDR_OK);
+	xdrStoreFloat(bytes, rawValue);
+	return(appendXDROutputBuffer(pOutputBuffer, bytes, XDR_FLOAT_BYTES));
 }
 
 /*!
@@ -773,7 +736,7 @@ char getFloatWriteHexFromBinary(char binary[4])
  *      
  *	ARGUMENTS:
  *      - pRawValue (IN/OUT)
- *	    - pStream {IN/OUT}
+ *	    - pOutputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	      Returns Zero if the operation is successful or appropriate error 
@@ -782,35 +745,17 @@ char getFloatWriteHexFromBinary(char binary[4])
 
 int write_u_long(
 				unsigned int RawValue, 
-			    void* pStream
+			    XDROutputBuffer* pOutputBuffer
 			  )
 
 {
-        
-        int byteCount = 0;
-        char tempByte[2] = "ff";
-        int byteToPrint=0;
-		unsigned char bytes[INT_BITS];
-        int count=0;
-        int counter=0;
-
-
-		if(pStream==NULL)
-			return(18);
-
-
-         sprintf((char *)bytes, "%08x", RawValue);
-         for(count=0;count<U_INT_MAXCOUNT_4; count++)
-         {
-             counter=2*count;
-             tempByte[0] = bytes[counter];
-             tempByte[1] = bytes[counter+1];
-             byteToPrint = convWriteUInthexToInt(tempByte);
-             fprintf(pStream, "%c", byteToPrint);
-            
-		 }
-
-    return(IPDR_OK);
+		byte bytes[XDR_INT_BYTES];
+
+		if(pOutputBuffer==NULL)
+			return(IPDR_NULL_INPUT_PARAMETER);
+
+		xdrStoreUInt(bytes, RawValue);
+		return(appendXDROutputBuffer(pOutputBuffer, bytes, XDR_INT_BYTES));
 }
 
 /*!
@@ -871,7 +816,7 @@ int convWriteUInthexToInt(char iHexa[3])
  *
  *	ARGUMENTS:
  *      - RawValue (IN)
- *      - pStream (IN/OUT)
+ *      - pOutputBuffer (IN/OUT)
  *
  *  RETURNS 	
  *  Returns Zero if the operation is successful or appropriate
@@ -879,29 +824,15 @@ int convWriteUInthexToInt(char iHexa[3])
 */
 
 
-int write_longlong(hyper RawValue,FILE *pStream)
+int write_longlong(hyper RawValue,XDROutputBuffer* pOutputBuffer)
 {
-        int byteCount = 0;
-        int count;
-        char tempByte[3] = "ff";
-        int byteToPrint;
-        int convHex;
-        unsigned char bytes[HYPER_BITS];
-        char tempBytes[HYPER_BITS];
-
-        if(pStream==NULL)
-                return(18);
-        convHex = convWriteHyperToHex(RawValue, bytes);
-        
-		sprintf(tempBytes, "%016s", bytes);
-		for(count = 0;count < HYPER_MAXCOUNT_16;count = count + 2)
-        {
-                tempByte[0] = (unsigned char)tempBytes[count];
-                tempByte[1] = (unsigned char)tempBytes[count + 1];
-                byteToPrint = convWriteHyperHexToInt(tempByte);
-                fprintf(pStream, "%c", byteToPrint);
-        }
-        return(IPDR_OK);
+        byte bytes[XDR_HYPER_BYTES];
+
+        if(pOutputBuffer==NULL)
+                return(IPDR_NULL_INPUT_PARAMETER);
+
+        xdrStoreUHyper(bytes, (u_hyper) RawValue);
+        return(appendXDROutputBuffer(pOutputBuffer, bytes, XDR_HYPER_BYTES));
 }
 
 /*!
@@ -1025,27 +956,24 @@ int convWriteHyperToHex(hyper a, unsigned char* b)
  *      
  *	ARGUMENTS:
  *      - pRawValue (IN)
- *	    - pStream {IN/OUT}
+ *	    - pOutputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	      Returns Zero or appropriate error code
  */
 
-int write_string(char* pRawValue, void* pStream) 
+int write_string(char* pRawValue, XDROutputBuffer* pOutputBuffer) 
 {
-    int count = 0;
-    for(count = 0; count < (int)strlen(pRawValue); count++){
-       fprintf(pStream, "%c",pRawValue[count]);
-     }
 /*
 	if((strcmp(gVersion,IPDR_VERSION_3_1)) == 0) {
     if((strlen(pRawValue)%4)!=0) {
        for(count=(strlen(pRawValue)%4);count<4;count++)
-         fprintf(pStream, "%c",0);
+         fprintf(pOutputBuffer, "%c",0);
      }
    } 
 */
-	 return (0);
+    return(appendXDROutputBuffer(pOutputBuffer, (byte *) pRawValue,
+                                 (int) strlen(pRawValue)));
 }
 
 /*!
@@ -1056,44 +984,31 @@ int write_string(char* pRawValue, void* pStream)
  *      
  *	ARGUMENTS:
  *      - pRawValue (IN)
- *	    - pStream {IN/OUT}
+ *	    - pOutputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	      Returns Zero or appropriate error code
 */
 
-int write_wstring(wchar* pRawValue, void *pStream, char* schemaVer)
+int write_wstring(wchar* pRawValue, XDROutputBuffer* pOutputBuffer, char* schemaVer)
 {
-    int count = 0;
  int length = 0;
- wchar* UTF8String;
- 
- UTF8String = (wchar *) calloc (sizeof(char), MAX_IPDR_STRING * 2);
- 
- getUTF8String((char *) pRawValue, (char *) UTF8String);
- 
- while(UTF8String[count] != '\0') {
-  if ((int)UTF8String[count] <= 255)
-   UTF8String[count] = 19456 + (int)UTF8String[count];
-  count++;
- }
- 
- length = count;
- for(count = 0; count < length; count++) {
-       fprintf(pStream, "%c", UTF8String[count]);
- }
-         
+ int errorCode = IPDR_OK;
+
+ /*
+  * Every character used to be widened with getUTF8String() and
+  * printed back with "%c", which kept only its low byte; the bytes
+  * of the string are appended as they are.
+  */
+ length = strlen((char *) pRawValue);
+ errorCode = appendXDROutputBuffer(pOutputBuffer, (byte *) pRawValue, length);
+ if (errorCode != IPDR_OK)
+  return (errorCode);
+
 /* Code change to check the strcuture member for schema version */
-if((strcmp(schemaVer, IPDR_VERSION_3_1)) == 0) {
-	length = strlen((char *) pRawValue);
+if((strcmp(schemaVer, IPDR_VERSION_3_1)) == 0)
+	return (padXDROutputBuffer(pOutputBuffer, length));
 
-	if ((length % 4) != 0) {
-    	for (count = (length % 4); count < 4; count++)
-    	fprintf(pStream, "%c",0);
-   }
-}
-	
-  free (UTF8String);
   return (0);
 }
 
@@ -1147,28 +1062,24 @@ int checkBigEndian()
  *      
  *	ARGUMENTS:
  *      - pRawValue (IN)
- *	    - pStream {IN/OUT}
+ *	    - pOutputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	      Returns Zero or appropriate error code
 */
 
-int write_octet_array(byte* pRawValue, void *pStream)
+int write_octet_array(byte* pRawValue, XDROutputBuffer* pOutputBuffer)
 {
-    int count = 0;
-
-    for(count = 0; count < (int) strlen((char *)pRawValue); count++){
-       fprintf(pStream, "%c", pRawValue[count] );
-    }
 /*
 	if((strcmp(gVersion,IPDR_VERSION_3_1)) == 0) {
     	if( (strlen((char *)pRawValue) % 4) != 0 ) {
        	for( count = (strlen((char *)pRawValue) % 4); count < 4 ; count++)
-         	fprintf(pStream, "%c", 0);
+         	fprintf(pOutputBuffer, "%c", 0);
     	}
 	}
 */
-	return (0);
+    return(appendXDROutputBuffer(pOutputBuffer, pRawValue,
+                                 (int) strlen((char *)pRawValue)));
 }
 
 
@@ -1181,27 +1092,24 @@ int write_octet_array(byte* pRawValue, void *pStream)
  *	ARGUMENTS:
  *      - pRawValue (IN)
  *      - length (IN)
- *	    - pStream {IN/OUT}
+ *	    - pOutputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	      Returns Zero or appropriate error code
 */
 
-int write_noctet_array(byte* pRawValue, void *pStream, int length, char* schemaVer)
+int write_noctet_array(byte* pRawValue, XDROutputBuffer* pOutputBuffer, int length, char* schemaVer)
 {
-    int count = 0;
+    int errorCode = IPDR_OK;
 
-    for(count = 0; count < length; count++){
-       fprintf(pStream, "%c", pRawValue[count] );
-    }
+    errorCode = appendXDROutputBuffer(pOutputBuffer, pRawValue, length);
+    if (errorCode != IPDR_OK)
+        return (errorCode);
 
 /* Code change to read the structure member for the schema version */
-if((strcmp(schemaVer, IPDR_VERSION_3_1)) == 0) {
-    if( (length % 4) != 0 ) {
-       for( count = (length % 4); count < 4 ; count++)
-         fprintf(pStream, "%c", 0);
-    }
-}
+if((strcmp(schemaVer, IPDR_VERSION_3_1)) == 0)
+    return (padXDROutputBuffer(pOutputBuffer, length));
+
 	return (0);
 }
 
@@ -1215,33 +1123,21 @@ if((strcmp(schemaVer, IPDR_VERSION_3_1)) == 0) {
  *      
  *	ARGUMENTS:
  *      - pRawValue (IN)
- *	    - pStream {IN/OUT}
+ *	    - pOutputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	      Returns Zero or appropriate error code
 */
 
-int write_u_longlong(u_hyper RawValue,FILE *pStream)
+int write_u_longlong(u_hyper RawValue,XDROutputBuffer* pOutputBuffer)
 {
-        int byteCount = 0;
-        int count;
-        char tempByte[3] = "ff";
-        int byteToPrint;
-        int convHex;
-        unsigned char bytes[HYPER_BITS];
-        char tempBytes[HYPER_BITS];
-
-        if(pStream==NULL)
-                return(18);
-        convHex = convWriteUnHyperToHex(RawValue, bytes);
-		sprintf(tempBytes, "%016s", bytes);
-		for(count = 0;count < HYPER_MAXCOUNT_16;count = count + 2) {
-                tempByte[0] = (unsigned char)tempBytes[count];
-                tempByte[1] = (unsigned char)tempBytes[count + 1];
-                byteToPrint = convWriteHyperHexToInt(tempByte);
-                fprintf(pStream, "%c", byteToPrint);
-        }
-        return(IPDR_OK);
+        byte bytes[XDR_HYPER_BYTES];
+
+        if(pOutputBuffer==NULL)
+                return(IPDR_NULL_INPUT_PARAMETER);
+
+        xdrStoreUHyper(bytes, RawValue);
+        return(appendXDROutputBuffer(pOutputBuffer, bytes, XDR_HYPER_BYTES));
 }
 
 
@@ -1316,32 +1212,20 @@ int convWriteUnHyperToHex(u_hyper a, unsigned char* b)
  *      
  *	ARGUMENTS:
  *      - pRawValue (IN)
- *	    - pStream {IN/OUT}
+ *	    - pOutputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	      Returns Zero or appropriate error code
 */
-int write_short(int RawValue,void *pStream)
+int write_short(int RawValue,XDROutputBuffer* pOutputBuffer)
 {
-        int byteCount = 0;
-        int count;
-        char tempByte[3] = "ff";
-        int byteToPrint;
-        unsigned char bytes[INT_BITS];
+        byte bytes[XDR_SHORT_BYTES];
 
-        if(pStream == NULL)
+        if(pOutputBuffer == NULL)
                 return(IPDR_NULL_INPUT_PARAMETER);
 
-        sprintf((char *)bytes, "%04x", RawValue);
-        for ( count = 0; count < SHORT_INT_BITS; count = count + 2 )
-        {
-                tempByte[0] = bytes[count];
-                tempByte[1] = bytes[count+1];
-                byteToPrint = convWriteIntHexToInt(tempByte);
-                fprintf(pStream, "%c", byteToPrint);
-        }
-
-        return(IPDR_OK);
+        xdrStoreUShort(bytes, (unsigned short) RawValue);
+        return(appendXDROutputBuffer(pOutputBuffer, bytes, XDR_SHORT_BYTES));
 }
 
 /*!
@@ -1352,41 +1236,24 @@ int write_short(int RawValue,void *pStream)
  *      
  *	ARGUMENTS:
  *      - pRawValue (IN)
- *	    - pStream {IN/OUT}
+ *	    - pOutputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	      Returns Zero or appropriate error code
 */
 int write_u_short(
 				unsigned int RawValue, 
-			    void* pStream
+			    XDROutputBuffer* pOutputBuffer
 			  )
 
 {
-        
-      int byteCount = 0;
-      char tempByte[2] = "ff";
-      int byteToPrint=0;
-		unsigned char bytes[INT_BITS];
-      int count=0;
-      int counter=0;
-
-
-		if(pStream==NULL)
-			return(18);
+		byte bytes[XDR_SHORT_BYTES];
 
+		if(pOutputBuffer==NULL)
+			return(IPDR_NULL_INPUT_PARAMETER);
 
-       sprintf((char *)bytes, "%04x", RawValue);
-       for(count=0;count<U_SHORT_INT_MAXCOUNT_2; count++)
-       {
-          counter=2*count;
-          tempByte[0] = bytes[counter];
-          tempByte[1] = bytes[counter+1];
-          byteToPrint = convWriteUInthexToInt(tempByte);
-          fprintf(pStream, "%c", byteToPrint);
-		 }
-
-    return(IPDR_OK);
+		xdrStoreUShort(bytes, (unsigned short) RawValue);
+		return(appendXDROutputBuffer(pOutputBuffer, bytes, XDR_SHORT_BYTES));
 }
 
 /*!
@@ -1397,35 +1264,19 @@ int write_u_short(
  *      
  *	ARGUMENTS:
  *      - pRawValue (IN)
- *	    - pStream {IN/OUT}
+ *	    - pOutputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	      Returns Zero or appropriate error code
 */
-int write_byte(int RawValue,void *pStream)
+int write_byte(int RawValue,XDROutputBuffer* pOutputBuffer)
 {
-/*
-        int byteCount = 0;
-        int count;
-        char tempByte[3] = "ff";
-        int byteToPrint;
-        unsigned char bytes[INT_BITS];
+        byte value = (byte) RawValue;
 
-        if(pStream == NULL)
+        if(pOutputBuffer == NULL)
                 return(IPDR_NULL_INPUT_PARAMETER);
 
-        sprintf((char *)bytes, "%02x", RawValue);
-        for ( count = 0; count < BYTE_BITS; count = count + 2 )
-        {
-                tempByte[0] = bytes[count];
-                tempByte[1] = bytes[count+1];
-                byteToPrint = convWriteIntHexToInt(tempByte);
-                fprintf(pStream, "%c", byteToPrint);
-        }
-*/
-       fprintf(pStream, "%c",RawValue);
-
-        return(IPDR_OK);
+        return(appendXDROutputBuffer(pOutputBuffer, &value, 1));
 }
 
 /*!
@@ -1436,35 +1287,20 @@ int write_byte(int RawValue,void *pStream)
  *      
  *	ARGUMENTS:
  *      - pRawValue (IN)
- *	    - pStream {IN/OUT}
+ *	    - pOutputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	      Returns Zero or appropriate error code
 */
-int write_boolean(char* RawValue,void *pStream)
+int write_boolean(char* RawValue,XDROutputBuffer* pOutputBuffer)
 {
-        int byteCount = 0;
-        int count;
-        char tempByte[3] = "ff";
-        int byteToPrint;
-        unsigned char bytes[INT_BITS];
+        byte value = 0;
 
-        if(pStream == NULL)
+        if(pOutputBuffer == NULL)
                 return(IPDR_NULL_INPUT_PARAMETER);
 
-		  if(strcmp(RawValue, "true") == 0) {
-        	sprintf((char *)bytes, "%02x", 1);
-		  } else if(strcmp(RawValue, "false") == 0) {
-        	sprintf((char *)bytes, "%02x", 0);
-		  }
-
-        for ( count = 0; count < BYTE_BITS; count = count + 2 )
-        {
-                tempByte[0] = bytes[count];
-                tempByte[1] = bytes[count+1];
-                byteToPrint = convWriteIntHexToInt(tempByte);
-                fprintf(pStream, "%c", byteToPrint);
-        }
+        if(strcmp(RawValue, "true") == 0)
+                value = 1;
 
-        return(IPDR_OK);
+        return(appendXDROutputBuffer(pOutputBuffer, &value, 1));
 }
@@ -0,0 +1,568 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : XDROutputBuffer            *
+ * Description          : In-memory sink for the XDR *
+ *                        marshallers                *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include "xdr/XDROutputBuffer.h"
+#include "utils/errorCode.h"
+
+#ifndef WIN32
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#if defined(IOV_MAX) && (IOV_MAX < 64)
+#define XDR_OUTPUT_IOV_MAX			IOV_MAX
+#else
+#define XDR_OUTPUT_IOV_MAX			64
+#endif
+#endif
+
+
+/*!
+ *  NAME:
+ *      newXDROutputBuffer() - Memory allocation of XDROutputBuffer
+ *
+ *  DESCRIPTION:
+ *         Allocates the buffer with its first chunk. The stream is
+ *         bound later by attachXDROutputBuffer().
+ *
+ *  ARGUMENTS:
+ *	    - capacity {IN} bytes buffered before a record boundary
+ *	      drains the buffer, default if not positive
+ *	    - flushMode {IN} XDR_FLUSH_STDIO or XDR_FLUSH_WRITEV
+ *
+ *  RETURNS
+ *	     Returns Pointer to XDROutputBuffer structure or NULL
+ */
+
+XDROutputBuffer* newXDROutputBuffer(int capacity, int flushMode)
+{
+	XDROutputBuffer* pOutputBuffer;
+
+	pOutputBuffer = (XDROutputBuffer *) calloc(1, sizeof(XDROutputBuffer));
+	if (pOutputBuffer == NULL)
+		return (NULL);
+
+	pOutputBuffer->ppChunks_ = (byte **) calloc(1, sizeof(byte *));
+	if (pOutputBuffer->ppChunks_ == NULL) {
+		free(pOutputBuffer);
+		return (NULL);
+	}
+
+	pOutputBuffer->chunkSize_ = XDR_OUTPUT_CHUNK_SIZE;
+	pOutputBuffer->ppChunks_[0] = (byte *) malloc(pOutputBuffer->chunkSize_);
+	if (pOutputBuffer->ppChunks_[0] == NULL) {
+		free(pOutputBuffer->ppChunks_);
+		free(pOutputBuffer);
+		return (NULL);
+	}
+
+	pOutputBuffer->pStreamHandle_ = NULL;
+	pOutputBuffer->noOfChunks_ = 1;
+	pOutputBuffer->currentChunk_ = 0;
+	pOutputBuffer->chunkOffset_ = 0;
+	pOutputBuffer->length_ = 0;
+	pOutputBuffer->capacity_ =
+		(capacity > 0) ? capacity : XDR_OUTPUT_BUFFER_CAPACITY;
+	pOutputBuffer->flushMode_ = flushMode;
+
+	return (pOutputBuffer);
+}
+
+
+/*!
+ *  NAME:
+ *      freeXDROutputBuffer() - Memory deallocation of XDROutputBuffer
+ *
+ *  DESCRIPTION:
+ *         Frees the chunks. Buffered data is discarded, call
+ *         flushXDROutputBuffer() first to keep it.
+ *
+ *  ARGUMENTS:
+ *	    - pOutputBuffer {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int freeXDROutputBuffer(XDROutputBuffer* pOutputBuffer)
+{
+	int count = 0;
+
+	if (pOutputBuffer == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	for (count = 0; count < pOutputBuffer->noOfChunks_; count++)
+		free(pOutputBuffer->ppChunks_[count]);
+	free(pOutputBuffer->ppChunks_);
+	free(pOutputBuffer);
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      nextXDROutputChunk() - Moves to the next chunk
+ *
+ *  DESCRIPTION:
+ *         Chunks are kept across drains, a new one is only allocated
+ *         when a record outgrows the chunks allocated so far.
+ *
+ *  ARGUMENTS:
+ *	    - pOutputBuffer {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+static int nextXDROutputChunk(XDROutputBuffer* pOutputBuffer)
+{
+	byte** ppChunks = NULL;
+
+	if (pOutputBuffer->currentChunk_ + 1 == pOutputBuffer->noOfChunks_) {
+		ppChunks = (byte **) realloc(pOutputBuffer->ppChunks_,
+			(pOutputBuffer->noOfChunks_ + 1) * sizeof(byte *));
+		if (ppChunks == NULL)
+			return (IPDR_MEMORY_ALLOCATION_FAILED);
+		pOutputBuffer->ppChunks_ = ppChunks;
+
+		ppChunks[pOutputBuffer->noOfChunks_] =
+			(byte *) malloc(pOutputBuffer->chunkSize_);
+		if (ppChunks[pOutputBuffer->noOfChunks_] == NULL)
+			return (IPDR_MEMORY_ALLOCATION_FAILED);
+		pOutputBuffer->noOfChunks_++;
+	}
+
+	pOutputBuffer->currentChunk_++;
+	pOutputBuffer->chunkOffset_ = 0;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      appendXDROutputBuffer() - Appends bytes to the buffer
+ *
+ *  DESCRIPTION:
+ *         Copies length bytes of an XDR image into the buffer. This is
+ *         the single sink of all the write_*() marshallers.
+ *
+ *  ARGUMENTS:
+ *	    - pOutputBuffer {IN/OUT}
+ *	    - pData {IN}
+ *	    - length {IN}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int appendXDROutputBuffer(XDROutputBuffer* pOutputBuffer,
+						  const byte* pData, int length)
+{
+	int space = 0;
+	int copy = 0;
+
+	if (pOutputBuffer == NULL || (pData == NULL && length > 0))
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	while (length > 0) {
+		space = pOutputBuffer->chunkSize_ - pOutputBuffer->chunkOffset_;
+		if (space == 0) {
+			if (nextXDROutputChunk(pOutputBuffer) != IPDR_OK)
+				return (IPDR_MEMORY_ALLOCATION_FAILED);
+			space = pOutputBuffer->chunkSize_;
+		}
+
+		copy = (length < space) ? length : space;
+		memcpy(pOutputBuffer->ppChunks_[pOutputBuffer->currentChunk_] +
+			   pOutputBuffer->chunkOffset_, pData, copy);
+		pOutputBuffer->chunkOffset_ += copy;
+		pOutputBuffer->length_ += copy;
+		pData += copy;
+		length -= copy;
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      padXDROutputBuffer() - Pads an opaque value to 4 bytes
+ *
+ *  DESCRIPTION:
+ *         Appends the zero bytes which align a value of length bytes
+ *         on the next XDR unit.
+ *
+ *  ARGUMENTS:
+ *	    - pOutputBuffer {IN/OUT}
+ *	    - length {IN}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int padXDROutputBuffer(XDROutputBuffer* pOutputBuffer, int length)
+{
+	static const byte zeros[4] = { 0, 0, 0, 0 };
+
+	if ((length % 4) == 0)
+		return (IPDR_OK);
+
+	return (appendXDROutputBuffer(pOutputBuffer, zeros, 4 - (length % 4)));
+}
+
+
+/*!
+ *  NAME:
+ *      markXDROutputBuffer() - Records the end of the buffered bytes
+ *
+ *  DESCRIPTION:
+ *         The mark is the position truncateXDROutputBuffer() goes back
+ *         to. It is only valid until the buffer is next drained.
+ *
+ *  ARGUMENTS:
+ *	    - pOutputBuffer {IN}
+ *	    - pMark {OUT}
+ *
+ *  RETURNS
+ *	     Nothing
+ */
+
+void markXDROutputBuffer(const XDROutputBuffer* pOutputBuffer,
+						 XDROutputMark* pMark)
+{
+	if (pOutputBuffer == NULL) {
+		pMark->currentChunk_ = 0;
+		pMark->chunkOffset_ = 0;
+		pMark->length_ = 0;
+		return;
+	}
+
+	pMark->currentChunk_ = pOutputBuffer->currentChunk_;
+	pMark->chunkOffset_ = pOutputBuffer->chunkOffset_;
+	pMark->length_ = pOutputBuffer->length_;
+}
+
+
+/*!
+ *  NAME:
+ *      truncateXDROutputBuffer() - Drops the bytes appended after a mark
+ *
+ *  DESCRIPTION:
+ *         Sets the buffer back to a position recorded by
+ *         markXDROutputBuffer(). The chunks are kept for reuse.
+ *
+ *  ARGUMENTS:
+ *	    - pOutputBuffer {IN/OUT}
+ *	    - pMark {IN}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure, such as a mark taken before
+ * 		 the last drain.
+ */
+
+int truncateXDROutputBuffer(XDROutputBuffer* pOutputBuffer,
+							const XDROutputMark* pMark)
+{
+	if (pOutputBuffer == NULL || pMark == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	if (pMark->length_ > pOutputBuffer->length_ ||
+		pMark->currentChunk_ > pOutputBuffer->currentChunk_)
+		return (IPDR_INVALID_INPUT_PARAM_VALUE);
+
+	pOutputBuffer->currentChunk_ = pMark->currentChunk_;
+	pOutputBuffer->chunkOffset_ = pMark->chunkOffset_;
+	pOutputBuffer->length_ = pMark->length_;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      drainXDROutputBuffer() - Writes the buffered bytes to the stream
+ *
+ *  DESCRIPTION:
+ *         XDR_FLUSH_STDIO writes each chunk with fwrite(). XDR_FLUSH_WRITEV
+ *         flushes the stdio buffer of the stream, then hands the chunks
+ *         to writev() on the underlying descriptor.
+ *
+ *  ARGUMENTS:
+ *	    - pOutputBuffer {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+static int drainXDROutputBuffer(XDROutputBuffer* pOutputBuffer)
+{
+	FILE* pStream = (FILE *) pOutputBuffer->pStreamHandle_;
+	int count = 0;
+	int length = 0;
+#ifndef WIN32
+	struct iovec iov[XDR_OUTPUT_IOV_MAX];
+	int noOfIov = 0;
+	int first = 0;
+	ssize_t written = 0;
+#endif
+
+	if (pStream == NULL)
+		return (IPDR_INVALID_STREAM_HANDLE);
+	if (pOutputBuffer->length_ == 0)
+		return (IPDR_OK);
+
+#ifndef WIN32
+	if (pOutputBuffer->flushMode_ == XDR_FLUSH_WRITEV) {
+		if (fflush(pStream) != 0)
+			return (IPDR_UNWRITABLE_OSTREAM);
+
+		count = 0;
+		while (count <= pOutputBuffer->currentChunk_) {
+			for (noOfIov = 0; noOfIov < XDR_OUTPUT_IOV_MAX &&
+				 count <= pOutputBuffer->currentChunk_; noOfIov++, count++) {
+				iov[noOfIov].iov_base = pOutputBuffer->ppChunks_[count];
+				iov[noOfIov].iov_len = (count < pOutputBuffer->currentChunk_) ?
+					pOutputBuffer->chunkSize_ : pOutputBuffer->chunkOffset_;
+			}
+
+			first = 0;
+			while (first < noOfIov) {
+				written = writev(fileno(pStream), iov + first, noOfIov - first);
+				if (written < 0) {
+					if (errno == EINTR)
+						continue;
+					return (IPDR_UNWRITABLE_OSTREAM);
+				}
+				/* Skip what was written, a short write resumes mid chunk */
+				while (first < noOfIov && written >= (ssize_t) iov[first].iov_len) {
+					written -= iov[first].iov_len;
+					first++;
+				}
+				if (first < noOfIov) {
+					iov[first].iov_base = (char *) iov[first].iov_base + written;
+					iov[first].iov_len -= written;
+				}
+			}
+		}
+	}
+	else
+#endif
+	{
+		for (count = 0; count <= pOutputBuffer->currentChunk_; count++) {
+			length = (count < pOutputBuffer->currentChunk_) ?
+				pOutputBuffer->chunkSize_ : pOutputBuffer->chunkOffset_;
+			if ((int) fwrite(pOutputBuffer->ppChunks_[count], 1,
+							 length, pStream) != length)
+				return (IPDR_UNWRITABLE_OSTREAM);
+		}
+	}
+
+	pOutputBuffer->currentChunk_ = 0;
+	pOutputBuffer->chunkOffset_ = 0;
+	pOutputBuffer->length_ = 0;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      commitXDROutputBuffer() - Marks a record boundary
+ *
+ *  DESCRIPTION:
+ *         Drains the buffer once it holds at least capacity bytes,
+ *         so records are never split across two drains.
+ *
+ *  ARGUMENTS:
+ *	    - pOutputBuffer {IN/OUT}
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int commitXDROutputBuffer(XDROutputBuffer* pOutputBuffer, int* pErrorCode)
+{
+	if (pOutputBuffer == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	if (pOutputBuffer->length_ < pOutputBuffer->capacity_)
+		return (IPDR_OK);
+
+	*pErrorCode = drainXDROutputBuffer(pOutputBuffer);
+	if (*pErrorCode != IPDR_OK)
+		return (IPDR_ERROR);
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      flushXDROutputBuffer() - Marks a document boundary
+ *
+ *  DESCRIPTION:
+ *         Drains the whole buffer and flushes the stream.
+ *
+ *  ARGUMENTS:
+ *	    - pOutputBuffer {IN/OUT}
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int flushXDROutputBuffer(XDROutputBuffer* pOutputBuffer, int* pErrorCode)
+{
+	if (pOutputBuffer == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	*pErrorCode = drainXDROutputBuffer(pOutputBuffer);
+	if (*pErrorCode != IPDR_OK)
+		return (IPDR_ERROR);
+
+	if (fflush((FILE *) pOutputBuffer->pStreamHandle_) != 0) {
+		*pErrorCode = IPDR_UNWRITABLE_OSTREAM;
+		return (IPDR_ERROR);
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      setXDROutputBuffer() - Configures the XDR output buffer
+ *
+ *  DESCRIPTION:
+ *         Replaces the output buffer of the document, to be called
+ *         before writeHeader(). Data still buffered is flushed first.
+ *
+ *  ARGUMENTS:
+ *	    - pIPDRCommonParameters {IN/OUT}
+ *	    - capacity {IN}
+ *	    - flushMode {IN}
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int setXDROutputBuffer(IPDRCommonParameters* pIPDRCommonParameters,
+					   int capacity, int flushMode, int* pErrorCode)
+{
+	XDROutputBuffer* pOutputBuffer = NULL;
+
+	if (pIPDRCommonParameters == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	if (flushMode != XDR_FLUSH_STDIO && flushMode != XDR_FLUSH_WRITEV) {
+		*pErrorCode = IPDR_INVALID_INPUT_PARAM_VALUE;
+		return (IPDR_ERROR);
+	}
+
+	pOutputBuffer = newXDROutputBuffer(capacity, flushMode);
+	if (pOutputBuffer == NULL) {
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return (IPDR_ERROR);
+	}
+
+	if (pIPDRCommonParameters->pOutputBuffer_ != NULL) {
+		if (flushXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_,
+								 pErrorCode) != IPDR_OK &&
+			*pErrorCode != IPDR_INVALID_STREAM_HANDLE) {
+			freeXDROutputBuffer(pOutputBuffer);
+			return (IPDR_ERROR);
+		}
+		freeXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_);
+	}
+
+	pOutputBuffer->pStreamHandle_ = pIPDRCommonParameters->pStreamHandle_;
+	pIPDRCommonParameters->pOutputBuffer_ = pOutputBuffer;
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      attachXDROutputBuffer() - Binds the output buffer to the stream
+ *
+ *  DESCRIPTION:
+ *         Creates a default output buffer if none was configured and
+ *         binds it to the output stream of the document.
+ *
+ *  ARGUMENTS:
+ *	    - pIPDRCommonParameters {IN/OUT}
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int attachXDROutputBuffer(IPDRCommonParameters* pIPDRCommonParameters,
+						  int* pErrorCode)
+{
+	if (pIPDRCommonParameters == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	if (pIPDRCommonParameters->pStreamHandle_ == NULL) {
+		*pErrorCode = IPDR_INVALID_STREAM_HANDLE;
+		return (IPDR_ERROR);
+	}
+
+	if (pIPDRCommonParameters->pOutputBuffer_ == NULL) {
+		pIPDRCommonParameters->pOutputBuffer_ =
+			newXDROutputBuffer(XDR_OUTPUT_BUFFER_CAPACITY, XDR_FLUSH_STDIO);
+		if (pIPDRCommonParameters->pOutputBuffer_ == NULL) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return (IPDR_ERROR);
+		}
+	}
+
+	pIPDRCommonParameters->pOutputBuffer_->pStreamHandle_ =
+		pIPDRCommonParameters->pStreamHandle_;
+
+	return (IPDR_OK);
+}
@@ -0,0 +1,340 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : XDRPrimitives              *
+ * Description          : Byte order kernels for the *
+ *                        XDR primitive types        *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include "xdr/XDRPrimitives.h"
+#include "utils/errorCode.h"
+
+
+/*!
+ *  NAME:
+ *      xdrLoadUShort() - Loads a 16 bit value from its XDR image
+ *
+ *  DESCRIPTION:
+ *         Converts 2 bytes in network byte order to a host value.
+ *
+ *  ARGUMENTS:
+ *	    - pBuffer {IN}
+ *
+ *  RETURNS
+ *	     Returns the host value
+ */
+
+unsigned short xdrLoadUShort(const byte* pBuffer)
+{
+#if XDR_HOST_SWAP >= 0
+	unsigned short value;
+
+	memcpy(&value, pBuffer, XDR_SHORT_BYTES);
+#if XDR_HOST_SWAP == 1
+	value = XDR_BSWAP16(value);
+#endif
+	return(value);
+#else
+	return((unsigned short) ((pBuffer[0] << 8) | pBuffer[1]));
+#endif
+}
+
+
+/*!
+ *  NAME:
+ *      xdrLoadUInt() - Loads a 32 bit value from its XDR image
+ *
+ *  DESCRIPTION:
+ *         Converts 4 bytes in network byte order to a host value.
+ *
+ *  ARGUMENTS:
+ *	    - pBuffer {IN}
+ *
+ *  RETURNS
+ *	     Returns the host value
+ */
+
+unsigned int xdrLoadUInt(const byte* pBuffer)
+{
+#if XDR_HOST_SWAP >= 0
+	unsigned int value;
+
+	memcpy(&value, pBuffer, XDR_INT_BYTES);
+#if XDR_HOST_SWAP == 1
+	value = XDR_BSWAP32(value);
+#endif
+	return(value);
+#else
+	return(((unsigned int) pBuffer[0] << 24) |
+		   ((unsigned int) pBuffer[1] << 16) |
+		   ((unsigned int) pBuffer[2] << 8)  |
+		    (unsigned int) pBuffer[3]);
+#endif
+}
+
+
+/*!
+ *  NAME:
+ *      xdrLoadUHyper() - Loads a 64 bit value from its XDR image
+ *
+ *  DESCRIPTION:
+ *         Converts 8 bytes in network byte order to a host value.
+ *
+ *  ARGUMENTS:
+ *	    - pBuffer {IN}
+ *
+ *  RETURNS
+ *	     Returns the host value
+ */
+
+u_hyper xdrLoadUHyper(const byte* pBuffer)
+{
+#if XDR_HOST_SWAP >= 0
+	u_hyper value;
+
+	memcpy(&value, pBuffer, XDR_HYPER_BYTES);
+#if XDR_HOST_SWAP == 1
+	value = XDR_BSWAP64(value);
+#endif
+	return(value);
+#else
+	return(((u_hyper) xdrLoadUInt(pBuffer) << 32) |
+		    (u_hyper) xdrLoadUInt(pBuffer + XDR_INT_BYTES));
+#endif
+}
+
+
+/*!
+ *  NAME:
+ *      xdrStoreUShort() - Stores a 16 bit value as its XDR image
+ *
+ *  DESCRIPTION:
+ *         Converts a host value to 2 bytes in network byte order.
+ *
+ *  ARGUMENTS:
+ *	    - pBuffer {IN/OUT}
+ *	    - value {IN}
+ *
+ *  RETURNS
+ *	     Nothing
+ */
+
+void xdrStoreUShort(byte* pBuffer, unsigned short value)
+{
+#if XDR_HOST_SWAP >= 0
+#if XDR_HOST_SWAP == 1
+	value = XDR_BSWAP16(value);
+#endif
+	memcpy(pBuffer, &value, XDR_SHORT_BYTES);
+#else
+	pBuffer[0] = (byte) (value >> 8);
+	pBuffer[1] = (byte) value;
+#endif
+}
+
+
+/*!
+ *  NAME:
+ *      xdrStoreUInt() - Stores a 32 bit value as its XDR image
+ *
+ *  DESCRIPTION:
+ *         Converts a host value to 4 bytes in network byte order.
+ *
+ *  ARGUMENTS:
+ *	    - pBuffer {IN/OUT}
+ *	    - value {IN}
+ *
+ *  RETURNS
+ *	     Nothing
+ */
+
+void xdrStoreUInt(byte* pBuffer, unsigned int value)
+{
+#if XDR_HOST_SWAP >= 0
+#if XDR_HOST_SWAP == 1
+	value = XDR_BSWAP32(value);
+#endif
+	memcpy(pBuffer, &value, XDR_INT_BYTES);
+#else
+	pBuffer[0] = (byte) (value >> 24);
+	pBuffer[1] = (byte) (value >> 16);
+	pBuffer[2] = (byte) (value >> 8);
+	pBuffer[3] = (byte) value;
+#endif
+}
+
+
+/*!
+ *  NAME:
+ *      xdrStoreUHyper() - Stores a 64 bit value as its XDR image
+ *
+ *  DESCRIPTION:
+ *         Converts a host value to 8 bytes in network byte order.
+ *
+ *  ARGUMENTS:
+ *	    - pBuffer {IN/OUT}
+ *	    - value {IN}
+ *
+ *  RETURNS
+ *	     Nothing
+ */
+
+void xdrStoreUHyper(byte* pBuffer, u_hyper value)
+{
+#if XDR_HOST_SWAP >= 0
+#if XDR_HOST_SWAP == 1
+	value = XDR_BSWAP64(value);
+#endif
+	memcpy(pBuffer, &value, XDR_HYPER_BYTES);
+#else
+	xdrStoreUInt(pBuffer, (unsigned int) (value >> 32));
+	xdrStoreUInt(pBuffer + XDR_INT_BYTES, (unsigned int) value);
+#endif
+}
+
+
+/*!
+ *  NAME:
+ *      xdrLoadFloat() - Loads a float from its XDR image
+ *
+ *  DESCRIPTION:
+ *         XDR floats are IEEE-754 single precision in network byte
+ *         order, so the bits are reinterpreted as is. Denormals,
+ *         signed zero, infinities and NaN payloads are preserved.
+ *
+ *  ARGUMENTS:
+ *	    - pBuffer {IN}
+ *
+ *  RETURNS
+ *	     Returns the float value
+ */
+
+float xdrLoadFloat(const byte* pBuffer)
+{
+	unsigned int bits;
+	float value;
+
+	bits = xdrLoadUInt(pBuffer);
+	memcpy(&value, &bits, XDR_FLOAT_BYTES);
+	return(value);
+}
+
+
+/*!
+ *  NAME:
+ *      xdrLoadDouble() - Loads a double from its XDR image
+ *
+ *  DESCRIPTION:
+ *         XDR doubles are IEEE-754 double precision in network byte
+ *         order, so the bits are reinterpreted as is.
+ *
+ *  ARGUMENTS:
+ *	    - pBuffer {IN}
+ *
+ *  RETURNS
+ *	     Returns the double value
+ */
+
+double xdrLoadDouble(const byte* pBuffer)
+{
+	u_hyper bits;
+	double value;
+
+	bits = xdrLoadUHyper(pBuffer);
+	memcpy(&value, &bits, XDR_DOUBLE_BYTES);
+	return(value);
+}
+
+
+/*!
+ *  NAME:
+ *      xdrStoreFloat() - Stores a float as its XDR image
+ *
+ *  DESCRIPTION:
+ *         Writes the IEEE-754 single precision bits in network
+ *         byte order.
+ *
+ *  ARGUMENTS:
+ *	    - pBuffer {IN/OUT}
+ *	    - value {IN}
+ *
+ *  RETURNS
+ *	     Nothing
+ */
+
+void xdrStoreFloat(byte* pBuffer, float value)
+{
+	unsigned int bits;
+
+	memcpy(&bits, &value, XDR_FLOAT_BYTES);
+	xdrStoreUInt(pBuffer, bits);
+}
+
+
+/*!
+ *  NAME:
+ *      xdrStoreDouble() - Stores a double as its XDR image
+ *
+ *  DESCRIPTION:
+ *         Writes the IEEE-754 double precision bits in network
+ *         byte order.
+ *
+ *  ARGUMENTS:
+ *	    - pBuffer {IN/OUT}
+ *	    - value {IN}
+ *
+ *  RETURNS
+ *	     Nothing
+ */
+
+void xdrStoreDouble(byte* pBuffer, double value)
+{
+	u_hyper bits;
+
+	memcpy(&bits, &value, XDR_DOUBLE_BYTES);
+	xdrStoreUHyper(pBuffer, bits);
+}
+
+
+/*!
+ *  NAME:
+ *      xdrReadBytes() - Reads an XDR byte image from the stream
+ *
+ *  DESCRIPTION:
+ *         Reads length bytes with a single call. Bytes which could
+ *         not be read (end of stream) are zero filled.
+ *
+ *  ARGUMENTS:
+ *	    - pBuffer {IN/OUT}
+ *	    - length {IN}
+ *	    - pStream {IN}
+ *
+ *  RETURNS
+ *	     Returns the number of bytes actually read
+ */
+
+int xdrReadBytes(byte* pBuffer, int length, void* pStream)
+{
+	int bytesRead = 0;
+
+	bytesRead = (int) fread(pBuffer, 1, length, (FILE *) pStream);
+	if (bytesRead < length)
+		memset(pBuffer + bytesRead, 0, length - bytesRead);
+
+	return(bytesRead);
+}
+
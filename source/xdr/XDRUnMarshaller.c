@@ -21,6 +21,8 @@
  *****************************************************/
 
 #include "xdr/XDRUnMarshaller.h"
+#include "xdr/XDRPrimitives.h"
+#include "xdr/XDRInputBuffer.h"
 #include "utils/IPDRCommon.h"
 
 
@@ -39,30 +41,19 @@
  *         Unmarshalling of long value
  *  
  *  ARGUMENTS:
- *	    - pStream {IN}
+ *	    - pInputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	     Returns the value which has been read from input stream
  */
 
 
-int read_long(void* pStream)
+int read_long(XDRInputBuffer* pInputBuffer)
 {
-        char tempByte[3] = "ff";
-        int byteToPrint;
-        int count = 0;
-        unsigned char ch[5] = "";
-        int RawValue = 0;
-
-        fread(ch, sizeof(char), INT_BYTES, pStream);
-        for ( count = 0; count < INT_BYTES; count++ )
-        {
-             sprintf(tempByte, "%02x", ch[count]);
-             byteToPrint = convReadIntHexToInt(count, tempByte);
-             RawValue = RawValue + byteToPrint;
-        }
-
-        return(RawValue);
+        byte bytes[XDR_INT_BYTES];
+
+        readXDRInputBuffer(pInputBuffer, bytes, XDR_INT_BYTES);
+        return((int) xdrLoadUInt(bytes));
 }
 
 
@@ -145,58 +136,18 @@ void convReadIntCharHexToInt(char *hex,int* SB)
  *        Unmarshalling of double
  *  
  *  ARGUMENTS:
- *	    - streamPtr {IN}
+ *	    - pInputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	     Returns the double value which has been read from input stream
  */
 
-double read_double(void *streamPtr)
+double read_double(XDRInputBuffer* pInputBuffer)
 {
-	int count = 0;
-	char signDouble;
-	int countNext = 0;
-	int dExponent;
-	double dMantissa;
-	double thisDouble = 0;
-	unsigned char HexaDouble[DOUBLE_HEXA_BYTES];
-	unsigned char HexaTemp[2];
-	unsigned char BinaryTemp[4];
-	unsigned char HexaComplete[DOUBLE_HEXA_BITS];
-	unsigned char Exponent[DOUBLE_EXPONENT_BITS     ];
-	unsigned char Mantissa[DOUBLE_MANTISSA_BITS];
-	unsigned char BinaryComplete[DOUBLE_HEXA_BITS * 4];
-
-	fread(HexaDouble, sizeof(char), DOUBLE_HEXA_BYTES, streamPtr);
-	
-	for (count = 0; count < DOUBLE_HEXA_BYTES; count++) {
-		sprintf((char *)HexaTemp, "%02x", HexaDouble[count]);
-		HexaComplete[2 * count] = HexaTemp[0];
-		HexaComplete[(2 * count) + 1] = HexaTemp[1];
-	}
-
-	for (count = 0; count < DOUBLE_HEXA_BITS; count++) {
-		convReadDoubleHexToBinary(HexaComplete[count], (char *)BinaryTemp);
-		for (countNext = 0; countNext < 4; countNext++) {
-			BinaryComplete[countNext + (4 * count)] = BinaryTemp[countNext];
-		}
-	}
-
-	for (count = 0; count < DOUBLE_EXPONENT_BITS     ; count++)
-		Exponent[count] = BinaryComplete[count];
-
-	for (count = 0; count < DOUBLE_MANTISSA_BITS; count++)
-		Mantissa[count] = BinaryComplete[count + DOUBLE_EXPONENT_BITS     ];
+	byte bytes[XDR_DOUBLE_BYTES];
 
-	signDouble = BinaryComplete[0];
-
-	dExponent = getReadDoubleExponent((char *)Exponent);
-	dMantissa = getReadDoubleMantissa((char *)Mantissa);
-	thisDouble = pow(2, dExponent) * dMantissa;
-	if (signDouble == '1') 
-		return -(thisDouble);
-	else
-		return thisDouble;
+	readXDRInputBuffer(pInputBuffer, bytes, XDR_DOUBLE_BYTES);
+	return(xdrLoadDouble(bytes));
 }
 
 
@@ -346,59 +297,18 @@ int convReadDoubleHexToBinary(char hexa, char binary[4])
  *         Unmarshalling of float value
  *  
  *  ARGUMENTS:
- *	    - streamPtr {IN}
+ *	    - pInputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	     Returns the float value which has been read from input stream
  */
 
-float read_float(void *streamPtr)
+float read_float(XDRInputBuffer* pInputBuffer)
 {
-	int count = 0;
-	char signDouble;
-	int countNext = 0;
-	int dExponent = 0;
-	float dMantissa = 0;
-	float thisDouble = 0;
-	unsigned char HexaDouble[FLOAT_HEXA_BYTES];
-	unsigned char HexaTemp[2];
-	unsigned char BinaryTemp[4];
-	unsigned char HexaComplete[FLOAT_HEXA_BITS];
-	unsigned char Exponent[FLOAT_EXPONENT_BITS];
-	unsigned char Mantissa[FLOAT_MANTISSA_BITS];
-	unsigned char BinaryComplete[FLOAT_HEXA_BITS * 4];
-
-	fread(HexaDouble, sizeof(char), FLOAT_HEXA_BYTES, streamPtr);
-	
-	for (count = 0; count < FLOAT_HEXA_BYTES; count++) {
-		sprintf((char *)HexaTemp, "%02x", HexaDouble[count]);
-		HexaComplete[2 * count] = HexaTemp[0];
-		HexaComplete[(2 * count) + 1] = HexaTemp[1];
-	}
+	byte bytes[XDR_FLOAT_BYTES];
 
-	for (count = 0; count < FLOAT_HEXA_BITS; count++) {
-		convFloatReadHexToBinary(HexaComplete[count], (char *)BinaryTemp);
-		for (countNext = 0; countNext < 4; countNext++) {
-			BinaryComplete[countNext + (4 * count)] = BinaryTemp[countNext];
-		}
-	}
-
-	for (count = 0; count < FLOAT_EXPONENT_BITS; count++)
-		Exponent[count] = BinaryComplete[count];
-
-	for (count = 0; count < FLOAT_MANTISSA_BITS; count++)
-		Mantissa[count] = BinaryComplete[count + FLOAT_EXPONENT_BITS];
-
-	signDouble = BinaryComplete[0];
-	
-	dExponent = getFloatReadExponent((char *)Exponent);
-	dMantissa = getFloatReadMantissa((char *)Mantissa);
-	thisDouble = (float) pow(2, dExponent) * dMantissa;
-	
-	if (signDouble == '1') 
-		return -(thisDouble);
-	else
-		return thisDouble;
+	readXDRInputBuffer(pInputBuffer, bytes, XDR_FLOAT_BYTES);
+	return(xdrLoadFloat(bytes));
 }
 
 
@@ -545,28 +455,19 @@ int convFloatReadHexToBinary(char hexa, char binary[4])
  *         Unmarshalling of unsigned long value
  *  
  *  ARGUMENTS:
- *	    - pStream {IN}
+ *	    - pInputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	     Returns the unsigned long value which has been read from input 
  *       stream
  */
 
-unsigned int read_u_long(void* pStream)
+unsigned int read_u_long(XDRInputBuffer* pInputBuffer)
 {
-        char tempByte[3] = "ff";
-        unsigned int byteToPrint;
-        int count = 0;
-        unsigned char ch[5];
-		unsigned int RawValue = 0;  
-        fread(ch, sizeof(char), 4, pStream);
-       for (count = 0; count < U_INT_MAXCOUNT_4; count++)
-       {
-            sprintf(tempByte, "%02x", ch[count]);
-            byteToPrint = convReadUIntHexToInt(count, tempByte);
-            RawValue = RawValue + byteToPrint;
-       }
-       return(RawValue);
+        byte bytes[XDR_INT_BYTES];
+
+        readXDRInputBuffer(pInputBuffer, bytes, XDR_INT_BYTES);
+        return(xdrLoadUInt(bytes));
 }
 
 /*!
@@ -649,17 +550,16 @@ void convReadUIntCharHexToInt(char* hex, int* SB)
  *         Unmarshalling of string value
  *  
  *  ARGUMENTS:
- *	    - pStream {IN}
+ *	    - pInputBuffer {IN/OUT}
  *      - length {IN}
  *
  *  RETURNS 	
  *	     Returns the value which has been read from input stream
  */
 
-char* read_string(int length, void* pStream)
+char* read_string(int length, XDRInputBuffer* pInputBuffer)
 {
     char* pRawValue;
-    int quadLength = 0;
 
 /*
 if((strcmp(gVersion,IPDR_VERSION_3_1)) == 0) {
@@ -673,7 +573,7 @@ else {
 }
 */
     pRawValue = (char *) calloc(sizeof(char), (length + 1));
-    fgets(pRawValue, quadLength + 1, pStream);
+    readXDRInputBuffer(pInputBuffer, (byte *) pRawValue, length);
     pRawValue[length] = '\0';
     return (pRawValue);
 }
@@ -687,13 +587,13 @@ else {
  *      
  *	ARGUMENTS:
  *      - length {IN} 
- *	    - pStream {IN}
+ *	    - pInputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	      Returns the value which has been read
 */
 
-wchar* read_wstring(int length, void* pStream, char* schemaVer)
+wchar* read_wstring(int length, XDRInputBuffer* pInputBuffer, char* schemaVer)
 { 
  wchar* pRawValue;
 
@@ -706,11 +606,35 @@ if((strcmp(schemaVer, IPDR_VERSION_3_1)) == 0) {
 	length = length + (4 - (length % 4));
 }
 
-    fread((wchar *)pRawValue, sizeof(char), length, pStream);
+    readXDRInputBuffer(pInputBuffer, (byte *) pRawValue, length);
 
  return (pRawValue);
 }
 
+
+/*
+ *  NAME:
+ *      read_wstring_view() - Unmarshalling of UTF8 without a copy
+ *                  
+ *  DESCRIPTION:      Unmarshalling of UTF8. The string is not copied
+ *                    nor terminated, the returned view points into the
+ *                    mapped document, or for the stdio reader into a
+ *                    scratch area which is reused by the next view.
+ *      
+ *	ARGUMENTS:
+ *      - length {IN} 
+ *	    - pInputBuffer {IN/OUT}
+ *	    - schemaVer {IN}
+ *
+ *  RETURNS 	
+ *	      Returns the view of length bytes or NULL
+*/
+
+const char* read_wstring_view(int length, XDRInputBuffer* pInputBuffer, char* schemaVer)
+{
+	return ((const char *) read_octet_view(length, pInputBuffer, schemaVer));
+}
+
 /*
  *  NAME:
  *      read_octet_array() - Unmarshalling of Byte Array
@@ -719,14 +643,14 @@ if((strcmp(schemaVer, IPDR_VERSION_3_1)) == 0) {
  *      
  *	ARGUMENTS:
  *      - length {IN} 
- *	    - pStream {IN}
+ *	    - pInputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	      Returns the Byte Array which has been read
 */
 
 
-byte* read_octet_array(int length, void* pStream, char* schemaVer)
+byte* read_octet_array(int length, XDRInputBuffer* pInputBuffer, char* schemaVer)
 {
     byte* pRawValue;
 
@@ -738,12 +662,44 @@ if((strcmp(schemaVer,IPDR_VERSION_3_1)) == 0) {
 
   	pRawValue = (byte *) calloc (sizeof(byte), (length+1));
 
-	fread(pRawValue, 1, length, pStream);
+	readXDRInputBuffer(pInputBuffer, pRawValue, length);
 
 	pRawValue[length] = '\0';
     return (pRawValue);
 }
 
+
+/*
+ *  NAME:
+ *      read_octet_view() - Unmarshalling of Byte Array without a copy
+ *                  
+ *  DESCRIPTION:      Unmarshalling of Byte Array. The returned view
+ *                    holds length bytes and is valid as long as the
+ *                    document stays mapped, or for the stdio reader
+ *                    until the next view is taken. The 3.1 padding is
+ *                    skipped.
+ *      
+ *	ARGUMENTS:
+ *      - length {IN} 
+ *	    - pInputBuffer {IN/OUT}
+ *	    - schemaVer {IN}
+ *
+ *  RETURNS 	
+ *	      Returns the view of length bytes or NULL
+*/
+
+const byte* read_octet_view(int length, XDRInputBuffer* pInputBuffer, char* schemaVer)
+{
+	int quadLength = length;
+
+	if((strcmp(schemaVer, IPDR_VERSION_3_1)) == 0) {
+		if ((length % 4) != 0)
+			quadLength = length + (4 - (length % 4));
+	}
+
+	return (viewXDRInputBuffer(pInputBuffer, quadLength));
+}
+
 /*
  *  NAME:
  *      read_longlong() - Unmarshalling of hyper
@@ -751,31 +707,19 @@ if((strcmp(schemaVer,IPDR_VERSION_3_1)) == 0) {
  *  DESCRIPTION:     Unmarshalling of hyper 
  *      
  *	ARGUMENTS:
- *	    - pStream {IN}
+ *	    - pInputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	      Returns the hyper value which has been read
 */
 
 
-hyper* read_longlong(void* pStream)
+hyper read_longlong(XDRInputBuffer* pInputBuffer)
 {
-    char tempByte[3] = "ff";
-    hyper byteToPrint;
-	hyper* pRawValue;
-	int count = 0;
-    unsigned char ch[5];
-	
-	pRawValue = (hyper *) calloc(sizeof(hyper), 100);
+	byte bytes[XDR_HYPER_BYTES];
 
-	fread(ch, sizeof(char), 8, pStream);
-
-    for(count = 0;count < HYPER_MAX_BYTES; count++) {
-         sprintf(tempByte, "%02x", ch[count]);
-         byteToPrint = hyperReadHexToInt(count, tempByte);
-         (*pRawValue) = (*pRawValue) + byteToPrint;
-	}
-    return(pRawValue);
+	readXDRInputBuffer(pInputBuffer, bytes, XDR_HYPER_BYTES);
+	return((hyper) xdrLoadUHyper(bytes));
 }
 
 /*!
@@ -876,31 +820,19 @@ void convReadHyperCharHexToInt(char *hex, hyper *SB)
  *  DESCRIPTION:     Unmarshalling of Unsigned Hyper 
  *      
  *	ARGUMENTS:
- *	    - pStream {IN}
+ *	    - pInputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	      Returns the value which has been read
 */
 
 
-u_hyper* read_u_longlong(void* pStream)
+u_hyper read_u_longlong(XDRInputBuffer* pInputBuffer)
 {
-    char tempByte[3] = "ff";
-    u_hyper byteToPrint;
-	u_hyper* pRawValue;
-	int count = 0;
-    unsigned char ch[5];
-	
-	pRawValue = (u_hyper *) calloc(sizeof(u_hyper), 100);
+	byte bytes[XDR_HYPER_BYTES];
 
-	fread(ch, sizeof(char), 8, pStream);
-
-    for(count = 0;count < HYPER_MAX_BYTES; count++) {
-         sprintf(tempByte, "%02x", ch[count]);
-         byteToPrint = unhyperReadHexToInt(count, tempByte);
-         (*pRawValue) = (*pRawValue) + byteToPrint;
-	}
-    return(pRawValue);
+	readXDRInputBuffer(pInputBuffer, bytes, XDR_HYPER_BYTES);
+	return(xdrLoadUHyper(bytes));
 }
 
 /*!
@@ -1004,28 +936,17 @@ void convReadUnHyperCharHexToInt(char *hex, u_hyper *SB)
  *         Unmarshalling of short value
  *  
  *  ARGUMENTS:
- *	    - pStream {IN}
+ *	    - pInputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	     Returns the value which has been read from input stream
  */
-short int read_short(void* pStream)
+short int read_short(XDRInputBuffer* pInputBuffer)
 {
-        char tempByte[3] = "ff";
-        int byteToPrint;
-        int count = 0;
-        unsigned char ch[5] = "";
-        short int RawValue = 0;
-
-        fread(ch, sizeof(char), SHORT_INT_BYTES, pStream);
-        for ( count = 0; count < SHORT_INT_BYTES; count++ )
-        {
-             sprintf(tempByte, "%02x", ch[count]);
-             byteToPrint = convReadShortIntHexToShortInt(count, tempByte);
-             RawValue = RawValue + byteToPrint;
-        }
-
-        return(RawValue);
+        byte bytes[XDR_SHORT_BYTES];
+
+        readXDRInputBuffer(pInputBuffer, bytes, XDR_SHORT_BYTES);
+        return((short int) xdrLoadUShort(bytes));
 }
 
 /*!
@@ -1036,27 +957,17 @@ short int read_short(void* pStream)
  *         Unmarshalling of unsigned short value
  *  
  *  ARGUMENTS:
- *	    - pStream {IN}
+ *	    - pInputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	     Returns the value which has been read from input stream
  */
-unsigned short int read_u_short(void* pStream)
+unsigned short int read_u_short(XDRInputBuffer* pInputBuffer)
 {
-        char tempByte[3] = "ff";
-        unsigned int byteToPrint;
-        int count = 0;
-        unsigned char ch[5];
-		unsigned short int RawValue = 0;  
-
-        fread(ch, sizeof(char), SHORT_INT_BYTES, pStream);
-       for (count = 0; count < U_INT_MAXCOUNT_2; count++)
-       {
-            sprintf(tempByte, "%02x", ch[count]);
-            byteToPrint = convReadUShortIntHexToShortInt(count, tempByte);
-            RawValue = RawValue + byteToPrint;
-       }
-       return(RawValue);
+        byte bytes[XDR_SHORT_BYTES];
+
+        readXDRInputBuffer(pInputBuffer, bytes, XDR_SHORT_BYTES);
+        return(xdrLoadUShort(bytes));
 }
 
 /*!
@@ -1067,27 +978,17 @@ unsigned short int read_u_short(void* pStream)
  *         Unmarshalling of byte value
  *  
  *  ARGUMENTS:
- *	    - pStream {IN}
+ *	    - pInputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	     Returns the value which has been read from input stream
  */
-char read_byte(void* pStream)
+char read_byte(XDRInputBuffer* pInputBuffer)
 {
-        char tempByte[3] = "ff";
-        char byteToPrint;
-        int count = 0;
-        unsigned char ch[5] = "";
-
-        fread(ch, sizeof(char), BYTE_BYTES, pStream);
-		  byteToPrint = ch;
-        for ( count = 0; count < BYTE_BYTES; count++ )
-        {
-             sprintf(tempByte, "%02x", ch[count]);
-             byteToPrint = convReadIntHexToByte(count, tempByte);
-        }
-
-        return(byteToPrint);
+        byte value;
+
+        readXDRInputBuffer(pInputBuffer, &value, BYTE_BYTES);
+        return((char) value);
 }
 
 /*!
@@ -1098,28 +999,17 @@ char read_byte(void* pStream)
  *         Unmarshalling of boolean value
  *  
  *  ARGUMENTS:
- *	    - pStream {IN}
+ *	    - pInputBuffer {IN/OUT}
  *
  *  RETURNS 	
  *	     Returns the value which has been read from input stream
  */
-int read_boolean(void* pStream)
+int read_boolean(XDRInputBuffer* pInputBuffer)
 {
-        char tempByte[3] = "ff";
-        int byteToPrint;
-        int count = 0;
-        unsigned char ch[5] = "";
-        int RawValue = 0;
-
-        fread(ch, sizeof(char), BYTE_BYTES, pStream);
-        for ( count = 0; count < BYTE_BYTES; count++ )
-        {
-             sprintf(tempByte, "%02x", ch[count]);
-             byteToPrint = convReadIntHexToByte(count, tempByte);
-             RawValue = RawValue + byteToPrint;
-        }
-
-        return(RawValue);
+        byte value;
+
+        readXDRInputBuffer(pInputBuffer, &value, BYTE_BYTES);
+        return((int) value);
 }
 
 /*!
@@ -28,6 +28,7 @@
  *
  *  DESCRIPTION:
  *      This function
+ *		 - Reads the rest of the document
  *		 - Reads count
  *		 - Reads endTime
  *		 - Populates the DocEnd structure with the above read values
@@ -53,7 +54,12 @@ int readIPDRXMLDocEndHelper(
 		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
 		return(IPDR_ERROR);
 	}
-	
+
+	errorSeverity = closeXMLStreamData(pIPDRCommonParameters, pErrorCode);
+	if (errorSeverity == IPDR_ERROR) {
+		return (IPDR_ERROR);
+	}
+
 	pDocEnd->count_ = pIPDRCommonParameters->pDocEnd_->count_;
 	pDocEnd->endTime_ = pIPDRCommonParameters->pDocEnd_->endTime_;
 
@@ -22,8 +22,12 @@
 
 #include "common/schema.h"
 #include "xml/IPDRXMLRecordHelper.h"
+#include "xml/XMLRecordTemplate.h"
+#include "xml/XMLTypeCache.h"
+#include "xdr/XDROutputBuffer.h"
 #include "utils/dynamicArray.h"
 #include "utils/schemaUtil.h"
+#include "utils/IPDRThread.h"
 
 /*!
  *  NAME:
@@ -60,6 +64,13 @@ int readIPDRXMLRecordHelper(
 	ListAttributeDescriptor* pListAttributeDescriptor = NULL;
 
 
+	if(pIPDRCommonParameters != NULL) {
+		errorSeverity = readXMLStreamRecord(pIPDRCommonParameters, pErrorCode);
+		if (errorSeverity == IPDR_ERROR) {
+			return (IPDR_ERROR);
+		}
+	}
+
 	if (pIPDRCommonParameters->pListFNFData_ == NULL) {
 		freeFNFData(*pFNFData);
 		*pFNFData = NULL;
@@ -136,7 +147,7 @@ if((strcmp(pIPDRCommonParameters->schemaVersion,IPDR_VERSION_3_5)) == 0) {
  	if ((pIPDRCommonParameters->pSchema_ != NULL) && (pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL)) {
 
 		/*Need to make use of the Schema attribute types*/
-		errorSeverity = getComplexAttributeTypeFromSchema(pIPDRCommonParameters,((*pFNFData)) , pErrorCode);
+		errorSeverity = resolveXMLAttributeTypes(pIPDRCommonParameters, *pFNFData, IPDR_TRUE, pErrorCode);
     	if (errorSeverity == IPDR_WARNING) {
 			errorHandler(pIPDRCommonParameters, pErrorCode, "readIPDRXMLRecordHelper");	
 		}
@@ -278,7 +289,7 @@ if((strcmp(pIPDRCommonParameters->schemaVersion,IPDR_VERSION_3_5)) == 0) {
 
  if ((pIPDRCommonParameters->pSchema_ != NULL) && (pIPDRCommonParameters->pSchema_->pListSchemaLookup_ != NULL)) {
 
-	errorSeverity = getAttributeTypeFromSchema(pIPDRCommonParameters, *pFNFData, pErrorCode);
+	errorSeverity = resolveXMLAttributeTypes(pIPDRCommonParameters, *pFNFData, IPDR_FALSE, pErrorCode);
     if (errorSeverity == IPDR_WARNING) {
 		errorHandler(pIPDRCommonParameters, pErrorCode, "readIPDRXMLRecordHelper");	
 	}
@@ -311,6 +322,7 @@ int populateListAttributeDescriptor(
 	char* pFNFtypeName = NULL;
 	char* tempString = NULL;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
 	char* nameSpaceFnfID = NULL;
 	char* nameSpaceFnfURI = NULL;
 	char* FNFAttributeName = NULL;
@@ -333,7 +345,7 @@ int populateListAttributeDescriptor(
 	}
 
 	strcpy(tempString, pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_);
-	serviceTypeToken = strtok(tempString, ":");
+	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 
 	if(!strcmp(pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_,serviceTypeToken)) 
 		strcpy(pFNFtypeName, pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_);
@@ -540,6 +552,7 @@ int populateAttributeDescriptor(
 	char* pFNFtypeName = NULL;
 	char* tempString = NULL;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
 	char* nameSpaceFnfID = NULL;
 	char* nameSpaceFnfURI = NULL;
 	char* FNFAttributeName = NULL;
@@ -549,7 +562,6 @@ int populateAttributeDescriptor(
    int cntVal = 1;
 	int noOfElements = 0;
 	int lCopyDataFlag = 1;
-	static int lArrFndFlag = 0;
 	SchemaElement* pSchemaElement = NULL;
 	ListAttributeDescriptor* pCurrentListAttributeDescriptor = NULL;
 	ListAttributeDescriptor* pTempListAttributeDescriptor = NULL;
@@ -566,7 +578,7 @@ int populateAttributeDescriptor(
 	}
 
 	strcpy(tempString, pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_);
-	serviceTypeToken = strtok(tempString, ":");
+	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 
 	if(!strcmp(pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_,serviceTypeToken)) 
 		strcpy(pFNFtypeName, pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_);
@@ -605,26 +617,28 @@ int populateAttributeDescriptor(
 			if(noOfElements != 0)
 				noOfElements = noOfElements - 1;
 		
-			if(lArrFndFlag == 1) {
+			if(pIPDRCommonParameters->xmlArrayFound_ == 1) {
 				noOfElements = -1;
 			}
 					
 			if(noOfElements > 0) {
 				noOfElements = -1;
-				lArrFndFlag = 1;
+				pIPDRCommonParameters->xmlArrayFound_ = 1;
 			}
 		}
 		
 		if(pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->pListAttributeDescriptor_->pAttributeDescriptor_->pListAttrNameList_ != NULL) {
-   if(pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_ == NULL) {
-		pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_ = (char *) calloc (MAX_ATTRIBUTE_TYPE, sizeof(char));
-	
-			strcpy(pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_, pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->pListAttributeDescriptor_->pAttributeDescriptor_->attributeName_);
-			strcat(pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_, "Element");
-			} else {
-				strcpy(pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_, pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->pListAttributeDescriptor_->pAttributeDescriptor_->attributeName_);
-				strcat(pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_, "Element");
-
+			strcat(tempFNFAttributeName, "Element");
+			if (setAttributeDescriptorString(NULL, &(pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_),
+											 tempFNFAttributeName) != IPDR_OK) {
+				*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+				pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->pListAttributeDescriptor_ = pCurrentListAttributeDescriptor;
+				pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->pListIPDRData_ = pCurrentListIPDRData;
+				free(tempFNFAttributeName);
+				free(pFNFtypeName);
+				free(nameSpaceFnfID);
+				free(nameSpaceFnfURI);
+				return (IPDR_ERROR);
 			}
 		}
 
@@ -693,6 +707,7 @@ int populateComplexDataType(
 	char* pFNFtypeName = NULL;
 	char* tempString = NULL;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
 	char* nameSpaceFnfID = NULL;
 	char* nameSpaceFnfURI = NULL;
 	char* FNFAttributeName = NULL;
@@ -711,7 +726,7 @@ int populateComplexDataType(
 	}
 	
 	strcpy(tempString, pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_);
-	serviceTypeToken = strtok(tempString, ":");
+	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 	
 	if(!strcmp(pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_,serviceTypeToken)) 
 		strcpy(pFNFtypeName, pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_);
@@ -874,11 +889,11 @@ int populateComplexType(
 	int errorSeverity = 0;
 	int noOfElements = 0;
 	int elementCount = 0;
-	static int lArrayFoundFlag = 0;
 
 	char* pFNFtypeName = NULL;
 	char* tempString = NULL;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
 	char* nameSpaceFnfID = NULL;
 	char* nameSpaceFnfURI = NULL;
 	char* FNFAttributeName = NULL;
@@ -905,7 +920,7 @@ int populateComplexType(
 	}
 	
 	strcpy(tempString, pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_);
-	serviceTypeToken = strtok(tempString, ":");
+	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 	
 	if(!strcmp(pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_,serviceTypeToken)) 
 		strcpy(pFNFtypeName, pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_);
@@ -923,13 +938,15 @@ int populateComplexType(
 		strcpy(tempFNFAttributeName, pListAttributeDescriptor->pAttributeDescriptor_->attributeName_);
 		strcat(tempFNFAttributeName, "Element");
 
-   if(pListAttributeDescriptor->pAttributeDescriptor_->complexType_ == NULL) {
-		pListAttributeDescriptor->pAttributeDescriptor_->complexType_ = (char *) calloc (MAX_ATTRIBUTE_TYPE, sizeof(char));
-	
-			strcpy(pListAttributeDescriptor->pAttributeDescriptor_->complexType_, tempFNFAttributeName);
-			} else {
-				strcpy(pListAttributeDescriptor->pAttributeDescriptor_->complexType_, tempFNFAttributeName);
-			}
+	if (setAttributeDescriptorString(NULL, &(pListAttributeDescriptor->pAttributeDescriptor_->complexType_),
+									 tempFNFAttributeName) != IPDR_OK) {
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		free(tempFNFAttributeName);
+		free(pFNFtypeName);
+		free(nameSpaceFnfID);
+		free(nameSpaceFnfURI);
+		return (IPDR_ERROR);
+	}
 		
 
 		pCurrentListAttrNameList = pListAttributeDescriptor->pAttributeDescriptor_->pListAttrNameList_;
@@ -956,13 +973,13 @@ int populateComplexType(
 		if(pTempCurrentListAttrNameList == NULL) {
 			elementCount = elementCount - 1;
 			
-			if(lArrayFoundFlag == 1) {
+			if(pIPDRCommonParameters->xmlComplexArrayFound_ == 1) {
 				elementCount =  -1;
 			}
 
 			if(elementCount > 0) {
 				elementCount =  -1;
-				lArrayFoundFlag = 1;
+				pIPDRCommonParameters->xmlComplexArrayFound_ = 1;
 			}
 				
 				appendNode (&(pattrNameList),
@@ -1069,6 +1086,7 @@ int populateListIPDRData( 	IPDRCommonParameters* pIPDRCommonParameters,
 	char* pFNFtypeName = NULL;
 	char* tempString = NULL;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
 	char* nameSpaceFnfID = NULL;
 	char* nameSpaceFnfURI = NULL;
 	char* FNFAttributeName = NULL;
@@ -1099,7 +1117,7 @@ int populateListIPDRData( 	IPDRCommonParameters* pIPDRCommonParameters,
 	}
 
 	strcpy(tempString, pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_);
-	serviceTypeToken = strtok(tempString, ":");
+	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 
 	if(!strcmp(pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_,serviceTypeToken)) 
 		strcpy(pFNFtypeName, pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_);
@@ -1265,6 +1283,7 @@ int populateIPDRData( 	IPDRCommonParameters* pIPDRCommonParameters,
 	char* pFNFtypeName = NULL;
 	char* tempString = NULL;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
 	char* nameSpaceFnfID = NULL;
 	char* nameSpaceFnfURI = NULL;
 	char* FNFAttributeName = NULL;
@@ -1296,7 +1315,7 @@ int populateIPDRData( 	IPDRCommonParameters* pIPDRCommonParameters,
 	}
 
 	strcpy(tempString, pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_);
-	serviceTypeToken = strtok(tempString, ":");
+	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 
 	if(!strcmp(pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_,serviceTypeToken)) 
 		strcpy(pFNFtypeName, pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->typeName_);
@@ -1444,6 +1463,8 @@ int writeIPDRXMLRecordHelper(
 	char *tempXMLString = NULL;
 	char *stringIPDRCreationTime = NULL;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
+	const XMLRecordTemplate* pRecordTemplate = NULL;
  	ListIPDRData* pCurrentListIPDRData = NULL;
  	ListIPDRArrayData* pCurrentListIPDRArrayData = NULL;
  	ListAttributeDescriptor* pCurrentListAttributeDescriptor = NULL;
@@ -1475,8 +1496,6 @@ int writeIPDRXMLRecordHelper(
 
    pCurrentListAttributeDescriptor = pFNFData->pListAttributeDescriptor_;
 
-	sprintf(tempXMLString, " <IPDR xsi:type=\"%s\">\n", pFNFData->typeName_);
-	write_xml(tempXMLString, pIPDRCommonParameters->pStreamHandle_);
 	errorSeverity = getTime(IPDRCreationTime, pErrorCode);
 	if (errorSeverity == IPDR_WARNING) {
 	errorHandler(pIPDRCommonParameters, pErrorCode, "getTime"); 
@@ -1505,6 +1524,44 @@ int writeIPDRXMLRecordHelper(
 		return (IPDR_ERROR);
 	}
 
+	pRecordTemplate = getXMLRecordTemplate(pIPDRCommonParameters, pFNFData, pErrorCode);
+	if (pRecordTemplate != NULL) {
+		errorSeverity = attachXDROutputBuffer(pIPDRCommonParameters, pErrorCode);
+		if (errorSeverity == IPDR_OK)
+			errorSeverity = writeXMLRecordTemplate(pIPDRCommonParameters, pRecordTemplate,
+												   pFNFData, stringIPDRCreationTime, pErrorCode);
+		if (errorSeverity == IPDR_OK)
+			errorSeverity = commitXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, pErrorCode);
+		free(resultGet);
+		free(tempXMLString);
+		free(IPDRCreationTime);
+		free(stringIPDRCreationTime);
+		if (errorSeverity == IPDR_ERROR) {
+			pIPDRCommonParameters->DocState_ = NONWRITABLE;
+			exceptionHandler(pIPDRCommonParameters, pErrorCode, "writeIPDRXMLRecordHelper"); 
+			return (IPDR_ERROR);
+		}
+		return (IPDR_OK);
+	}
+
+	/* Records written from templates go to the stream first */
+	if (pIPDRCommonParameters->pOutputBuffer_ != NULL &&
+		pIPDRCommonParameters->pOutputBuffer_->length_ > 0) {
+		errorSeverity = flushXDROutputBuffer(pIPDRCommonParameters->pOutputBuffer_, pErrorCode);
+		if (errorSeverity == IPDR_ERROR) {
+			pIPDRCommonParameters->DocState_ = NONWRITABLE;
+			exceptionHandler(pIPDRCommonParameters, pErrorCode, "writeIPDRXMLRecordHelper"); 
+			free(resultGet);
+			free(tempXMLString);
+			free(IPDRCreationTime);
+			free(stringIPDRCreationTime);
+			return (IPDR_ERROR);
+		}
+	}
+
+	sprintf(tempXMLString, " <IPDR xsi:type=\"%s\">\n", pFNFData->typeName_);
+	write_xml(tempXMLString, pIPDRCommonParameters->pStreamHandle_);
+
 	sprintf(tempXMLString, "<%s>%s</%s>\n", "IPDRCreationTime",
 					stringIPDRCreationTime,"IPDRCreationTime");
 
@@ -1524,7 +1581,7 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 	tempString = (char *) calloc(strlen(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_) + 1, sizeof(char));
 	tempComplexType = (char *) calloc(strlen(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_) + 1, sizeof(char));
 	strcpy(tempString, pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_);
-	serviceTypeToken = strtok(tempString, ":");
+	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 	
 	if(strcmp(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_,serviceTypeToken)) {
 		getIPDRSubstring(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_, tempComplexType, ':');
@@ -1803,13 +1860,14 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 				pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRArrayData_;
 				for(cnt = 0;cnt < (pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_);
                 cnt++) { 
-					resultString = (char *) calloc(strlen((char *)pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_) + 10, sizeof(char));
+					resultString = (char *) calloc(strlen((char *)pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_) * IPDR_XML_MAX_ENTITY_LENGTH + 1, sizeof(char));
 					convToEntityReference((char *)pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_, resultString);
 					
 					sprintf(tempXMLString, "<%s>%s</%s>\n", 
 						pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeName_,
 						resultString, 
 						pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeName_);
+					free(resultString);
 
 					write_xml(tempXMLString, pIPDRCommonParameters->pStreamHandle_);
 
@@ -1817,7 +1875,7 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 				}
 			  }
 			  else {	
-					resultString = (char *) calloc(strlen((char *)pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUTF8Array_) + 10, sizeof(char));
+					resultString = (char *) calloc(strlen((char *)pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUTF8Array_) * IPDR_XML_MAX_ENTITY_LENGTH + 1, sizeof(char));
 					convToEntityReference((char *)pFNFData->pListIPDRData_->IPDRDataUnion_.IPDRUTF8Array_, resultString);
 					
 					sprintf(tempXMLString, "<%s>%s</%s>\n", 
@@ -2335,7 +2393,7 @@ if(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->complexType_[0] !
 				pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRArrayData_;
 				for(cnt = 0;cnt < (pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->noOfElements_);
                 cnt++) { 
-					errorSeverity = convLongMicroToTime(pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRLongLong_, resultGet, pErrorCode);   
+					errorSeverity = convLongMicroToTime(&pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRLongLong_, resultGet, pErrorCode);   
 					if (errorSeverity == IPDR_WARNING) {
 						errorHandler(pIPDRCommonParameters, pErrorCode, "convLongMicroToTime"); 
 					}
@@ -3101,6 +3159,7 @@ int getAttributeTypeFromSchema(
 	char* pFNFtypeName = NULL;
 	char* tempString = NULL;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
 	char* nameSpaceFnfID = NULL;
 	char* nameSpaceFnfURI = NULL;
 	char* FNFAttributeName = NULL;
@@ -3128,7 +3187,7 @@ int getAttributeTypeFromSchema(
 	}
 	
 	strcpy(tempString, pFNFData->typeName_);
-	serviceTypeToken = strtok(tempString, ":");
+	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 	
 	if(!strcmp(pFNFData->typeName_,serviceTypeToken)) 
 		strcpy(pFNFtypeName, pFNFData->typeName_);
@@ -3211,10 +3270,18 @@ int getAttributeTypeFromSchema(
 			return (IPDR_WARNING);
 		}
 
-		strcpy(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeType_, pSchemaElement->attributeType_);   
-		/*int len = strlen(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeType_);
-		pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeType_[len+1] = '\0';*/
-		strcpy(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->derivedType_, pSchemaElement->derivedType_);    
+		if (setAttributeDescriptorString(pFNFData->pArena_, &(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeType_),
+										 pSchemaElement->attributeType_) != IPDR_OK ||
+			setAttributeDescriptorString(pFNFData->pArena_, &(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->derivedType_),
+										 pSchemaElement->derivedType_) != IPDR_OK) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			pFNFData->pListAttributeDescriptor_ = pCurrentListAttributeDescriptor;
+			free(pFNFtypeName);
+			free(nameSpaceFnfID);
+			free(nameSpaceFnfURI);
+			freeSchemaElement(pSchemaElement);
+			return (IPDR_ERROR);
+		}
 /*
 		printf("The pAttributeDescriptor_->attributeType_ : %s\n", pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeType_);
 		printf("The pSchemaElement->attributeType_ : %s\n", pSchemaElement->attributeType_);*/
@@ -3257,6 +3324,7 @@ int getComplexAttributeTypeFromSchema(
 	char* pFNFtypeName = NULL;
 	char* tempString = NULL;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
 	char* nameSpaceFnfID = NULL;
 	char* nameSpaceFnfURI = NULL;
 	char* FNFAttributeName = NULL;
@@ -3288,7 +3356,7 @@ int getComplexAttributeTypeFromSchema(
 	}
 	
 	strcpy(tempString, pFNFData->typeName_);
-	serviceTypeToken = strtok(tempString, ":");
+	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 	
 	if(!strcmp(pFNFData->typeName_,serviceTypeToken)) 
 		strcpy(pFNFtypeName, pFNFData->typeName_);
@@ -3371,10 +3439,18 @@ int getComplexAttributeTypeFromSchema(
 			return (IPDR_WARNING);
 		}
 
-		pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeType_[0] = '\0';
-		pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->derivedType_[0] = '\0';
-		strcpy(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeType_, pSchemaElement->attributeType_);   
-		strcpy(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->derivedType_, pSchemaElement->derivedType_);    
+		if (setAttributeDescriptorString(pFNFData->pArena_, &(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeType_),
+										 pSchemaElement->attributeType_) != IPDR_OK ||
+			setAttributeDescriptorString(pFNFData->pArena_, &(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->derivedType_),
+										 pSchemaElement->derivedType_) != IPDR_OK) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			pFNFData->pListAttributeDescriptor_ = pCurrentListAttributeDescriptor;
+			free(pFNFtypeName);
+			free(nameSpaceFnfID);
+			free(nameSpaceFnfURI);
+			freeSchemaElement(pSchemaElement);
+			return (IPDR_ERROR);
+		}
 		/*int len = strlen(pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeType_);
 		pFNFData->pListAttributeDescriptor_->pAttributeDescriptor_->attributeType_[len+1] = '\0';*/
 /*
@@ -3482,10 +3558,18 @@ int getComplexAttributeTypeFromSchema(
 				return (IPDR_WARNING);
 			}
 
-		pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->attributeType_[0] = '\0';
-		pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->derivedType_[0] = '\0';
-		strcpy(pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->attributeType_, pSchemaElement->attributeType_);   
-		strcpy(pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->derivedType_, pSchemaElement->derivedType_);    
+		if (setAttributeDescriptorString(pFNFData->pArena_, &(pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->attributeType_),
+										 pSchemaElement->attributeType_) != IPDR_OK ||
+			setAttributeDescriptorString(pFNFData->pArena_, &(pFNFData->pListServiceAttributeDescriptor_->pAttributeDescriptor_->derivedType_),
+										 pSchemaElement->derivedType_) != IPDR_OK) {
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			pFNFData->pListServiceAttributeDescriptor_ = pCurrentListServiceAttributeDescriptor;
+			free(pFNFtypeName);
+			free(nameSpaceFnfID);
+			free(nameSpaceFnfURI);
+			freeSchemaElement(pSchemaElement);
+			return (IPDR_ERROR);
+		}
 		}
 		}
 		freeSchemaElement(pSchemaElement); 
@@ -3500,40 +3584,31 @@ int getComplexAttributeTypeFromSchema(
 	return (IPDR_OK);
 }
 
+/*!
+ *  NAME:
+ *      convToEntityReference() - replaces the special characters of
+ *				a string value by entity references
+ *                     
+ *  DESCRIPTION:
+ *     	-All five predefined XML entities are written, see
+ *       escapeXMLString().
+ *  
+ *	ARGUMENTS:
+ *      - inputString {IN}
+ *      - outputString {IN / OUT}, holds strlen(inputString) * 
+ *        IPDR_XML_MAX_ENTITY_LENGTH + 1 characters
+ *
+ *  RETURNS 	
+ *	    Returns Zero or appropriate error code
+*/
+
 int convToEntityReference(char* inputString, char* outputString)
 {
-	char* tempString;
-	char* tempString1;
-	char* token;
-	
-	tempString = (char *) calloc(strlen(inputString) + 1, sizeof(char));
-	tempString1 = (char *) calloc(strlen(inputString) + 1, sizeof(char));
-	
-	strcpy(tempString, inputString);
-	token = strtok(tempString, "&");
-	if(!strcmp(inputString, token)) 
-		strcpy(outputString, inputString);
-	else {
-		getIPDRSubstring(inputString, tempString1, '&');
-		sprintf(outputString, "%s%s%s", tempString, "&amp;", tempString1);   
-	}
+	if (inputString == NULL || outputString == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
 
-	free(tempString);
-	free(tempString1); 
+	escapeXMLString(inputString, outputString);
 
-	tempString = (char *) calloc(strlen(inputString) + 1, sizeof(char));
-	tempString1 = (char *) calloc(strlen(inputString) + 1, sizeof(char));
-	
-	strcpy(tempString, inputString);
-	token = strtok(tempString, "<");
-	if(strcmp(inputString, token)) {
-		getIPDRSubstring(inputString, tempString1, '<');
-		sprintf(outputString, "%s%s%s", tempString, "&lt;", tempString1);   
-	}
-
-	free(tempString);
-	free(tempString1); 
-	
 	return (IPDR_OK);
 }
 
@@ -3619,6 +3694,7 @@ writeIPDRXMLComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
    char * tempString;
 	char* resultString;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
 	char *tempXMLString = NULL;
 	char *stringIPDRCreationTime = NULL;
  	ListIPDRData* pCurrentListIPDRData = NULL;
@@ -3658,7 +3734,7 @@ writeIPDRXMLComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
 	tempString = (char *) calloc(strlen(pComplexType) + 1, sizeof(char));
 	tempComplexType = (char *) calloc(strlen(pComplexType) + 1, sizeof(char));
 	strcpy(tempString, pComplexType);
-	serviceTypeToken = strtok(tempString, ":");
+	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 	
 	if(strcmp(pComplexType,serviceTypeToken)) {
 		getIPDRSubstring(pComplexType, tempComplexType, ':');
@@ -3688,7 +3764,7 @@ writeIPDRXMLComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
 						tempString = (char *) calloc(strlen(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_) + 1, sizeof(char));
 						tempComplexType = (char *) calloc(strlen(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_) + 1, sizeof(char));
 						strcpy(tempString, pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_);
-						serviceTypeToken = strtok(tempString, ":");
+						serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 	
 				if(strcmp(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_,serviceTypeToken)) {
 					getIPDRSubstring(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_, 
@@ -3944,7 +4020,7 @@ writeIPDRXMLComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
               				if (noOfElements > 0) {
               					pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_;
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
-              						resultString = (char *) calloc(strlen((char *)pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_) + 10, sizeof(char));
+              						resultString = (char *) calloc(strlen((char *)pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_) * IPDR_XML_MAX_ENTITY_LENGTH + 1, sizeof(char));
               						convToEntityReference((char *)pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRUTF8Array_, resultString);
               					
               						sprintf(tempXMLString, "<%s>%s</%s>\n", 
@@ -3958,7 +4034,7 @@ writeIPDRXMLComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
               					}
               				}
               				else {
-              					resultString = (char *) calloc(strlen((char *)pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRUTF8Array_) + 10, sizeof(char));
+              					resultString = (char *) calloc(strlen((char *)pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRUTF8Array_) * IPDR_XML_MAX_ENTITY_LENGTH + 1, sizeof(char));
               					convToEntityReference((char *)pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_->IPDRDataUnion_.IPDRUTF8Array_, resultString);
               					
               					sprintf(tempXMLString, "<%s>%s</%s>\n", 
@@ -4478,7 +4554,7 @@ writeIPDRXMLComplexRecordHelper(FNFData *pFNFData,char *pComplexType,IPDRCommonP
               				if (noOfElements > 0) {
               					pCurrentListIPDRArrayData = pFNFData->pListIPDRData_->pListIPDRStructureData_->pListIPDRComplexData_->pListIPDRComplex_->pListIPDRArrayData_;
               					for(cnt = 0;cnt < noOfElements; cnt++) { 
-              						errorSeverity = convLongMicroToTime(&pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRByteArray_, resultGet, pErrorCode);   
+              						errorSeverity = convLongMicroToTime(&pCurrentListIPDRArrayData->IPDRDataUnion_.IPDRLongLong_, resultGet, pErrorCode);   
               						if (errorSeverity == IPDR_WARNING) {
               							errorHandler(pIPDRCommonParameters, pErrorCode, "convLongMicroToTime"); 
               						}
@@ -4581,6 +4657,7 @@ int populateComplexDataTypeWithSchema(char* pComplexType,
    char * tempString;
 	char* resultString;
 	char* serviceTypeToken = NULL;
+	char* pTokenContext = NULL;
 	char* endPtr;
 	char *tempXMLString = NULL;
 	char *stringIPDRCreationTime = NULL;
@@ -4629,7 +4706,7 @@ int populateComplexDataTypeWithSchema(char* pComplexType,
 	tempString = (char *) calloc(strlen(pComplexType) + 1, sizeof(char));
 	tempComplexType = (char *) calloc(strlen(pComplexType) + 1, sizeof(char));
 	strcpy(tempString, pComplexType);
-	serviceTypeToken = strtok(tempString, ":");
+	serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 	
 	if(strcmp(pComplexType,serviceTypeToken)) {
 		getIPDRSubstring(pComplexType, tempComplexType, ':');
@@ -4659,7 +4736,7 @@ int populateComplexDataTypeWithSchema(char* pComplexType,
 						tempString = (char *) calloc(strlen(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_) + 1, sizeof(char));
 						tempComplexType = (char *) calloc(strlen(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_) + 1, sizeof(char));
 						strcpy(tempString, pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_);
-						serviceTypeToken = strtok(tempString, ":");
+						serviceTypeToken = strtok_r(tempString, ":", &pTokenContext);
 	
 				if(strcmp(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_,serviceTypeToken)) {
 					getIPDRSubstring(pOldListServiceAttributeDescriptor->pAttributeDescriptor_->complexType_, 
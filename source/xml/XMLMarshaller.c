@@ -23,6 +23,7 @@
 #include "xml/XMLMarshaller.h"
 #include "utils/errorCode.h"
 #include "utils/IPDRCommon.h"
+#include "xdr/XDROutputBuffer.h"
 
 
 /*
@@ -55,3 +56,161 @@ int write_xml(
     return(IPDR_OK);
 }
 
+
+/*
+ *  NAME:
+ *      getEntityReference() - Entity reference of a special character
+ *                  
+ *  DESCRIPTION:     Returns the entity reference written for one of
+ *                   IPDR_XML_SPECIAL_CHARACTERS.
+ *      
+ *	ARGUMENTS:
+ *      - character (IN)
+ *
+ *  RETURNS 	
+ *	     Returns the entity reference or NULL for any other character
+ */
+
+static const char* getEntityReference(char character)
+{
+	switch (character) {
+		case '&':
+			return ("&amp;");
+		case '<':
+			return ("&lt;");
+		case '>':
+			return ("&gt;");
+		case '"':
+			return ("&quot;");
+		case '\'':
+			return ("&apos;");
+		default:
+			return (NULL);
+	}
+}
+
+
+/*
+ *  NAME:
+ *      escapeXMLString() - Replaces the special characters of a
+ *                          string by entity references
+ *                  
+ *  DESCRIPTION:     The string is scanned once; runs without special
+ *                   characters are found with strcspn() and copied as
+ *                   a whole. pOutputString must hold
+ *                   strlen(pInputString) * IPDR_XML_MAX_ENTITY_LENGTH + 1
+ *                   characters.
+ *      
+ *	ARGUMENTS:
+ *      - pInputString (IN)
+ *	    - pOutputString {IN/OUT}
+ *
+ *  RETURNS 	
+ *	     Returns the length of the escaped string
+ */
+
+int escapeXMLString(
+			  const char *pInputString, 
+			  char *pOutputString
+			  )
+{
+	const char* pEntity = NULL;
+	int length = 0;
+	int run = 0;
+	int entityLength = 0;
+
+	for (;;) {
+		run = strcspn(pInputString, IPDR_XML_SPECIAL_CHARACTERS);
+		memcpy(pOutputString + length, pInputString, run);
+		length += run;
+		pInputString += run;
+		if (*pInputString == '\0')
+			break;
+
+		pEntity = getEntityReference(*pInputString);
+		entityLength = strlen(pEntity);
+		memcpy(pOutputString + length, pEntity, entityLength);
+		length += entityLength;
+		pInputString++;
+	}
+	pOutputString[length] = '\0';
+
+	return (length);
+}
+
+
+/*
+ *  NAME:
+ *      appendXMLString() - Appends XML to the output buffer
+ *                  
+ *  DESCRIPTION:     Buffered counterpart of write_xml()
+ *      
+ *	ARGUMENTS:
+ *      - pOutputBuffer {IN/OUT}
+ *	    - pXMLString (IN)
+ *	    - length (IN), -1 if pXMLString is NUL terminated
+ *
+ *  RETURNS 	
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int appendXMLString(
+			  XDROutputBuffer *pOutputBuffer, 
+			  const char *pXMLString,
+			  int length
+			  )
+{
+	if (pXMLString == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	if (length < 0)
+		length = strlen(pXMLString);
+
+	return (appendXDROutputBuffer(pOutputBuffer, (const byte *) pXMLString, length));
+}
+
+
+/*
+ *  NAME:
+ *      appendEscapedXMLString() - Appends XML text to the output buffer
+ *                  
+ *  DESCRIPTION:     Same scan as escapeXMLString(), writing straight
+ *                   into the output buffer.
+ *      
+ *	ARGUMENTS:
+ *      - pOutputBuffer {IN/OUT}
+ *	    - pInputString (IN)
+ *
+ *  RETURNS 	
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int appendEscapedXMLString(
+			  XDROutputBuffer *pOutputBuffer, 
+			  const char *pInputString
+			  )
+{
+	const char* pEntity = NULL;
+	int run = 0;
+	int result = IPDR_OK;
+
+	if (pInputString == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	for (;;) {
+		run = strcspn(pInputString, IPDR_XML_SPECIAL_CHARACTERS);
+		result = appendXDROutputBuffer(pOutputBuffer, (const byte *) pInputString, run);
+		if (result != IPDR_OK || pInputString[run] == '\0')
+			break;
+
+		pEntity = getEntityReference(pInputString[run]);
+		result = appendXDROutputBuffer(pOutputBuffer, (const byte *) pEntity, strlen(pEntity));
+		if (result != IPDR_OK)
+			break;
+		pInputString += run + 1;
+	}
+
+	return (result);
+}
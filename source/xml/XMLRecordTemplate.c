@@ -0,0 +1,690 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : XMLRecordTemplate          *
+ * Description          : Precompiled XML of record  *
+ *                        descriptors                *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include "xml/XMLRecordTemplate.h"
+#include "xml/XMLMarshaller.h"
+#include "xml/XMLUnMarshaller.h"
+#include "xml/IPDRXMLRecordHelper.h"
+#include "xdr/IPDRRecord.h"
+#include "utils/IPDRMap.h"
+#include "utils/errorCode.h"
+#include "utils/errorHandler.h"
+#include "utils/utils.h"
+
+#define XML_TEMPLATE_TIME_CLOSE		"</IPDRCreationTime>\n<" IPDR_XML_SEQ_NUM ">"
+#define XML_TEMPLATE_SEQ_CLOSE		"</" IPDR_XML_SEQ_NUM ">\n"
+#define XML_TEMPLATE_RECORD_CLOSE	"</IPDR>\n"
+
+
+/*!
+ *  NAME:
+ *      getDerivedCode() - maps a derived type name to XML_DERIVED_*
+ *
+ *  DESCRIPTION:
+ *         Names are compared in upper case, as done by
+ *         writeIPDRXMLRecordHelper().
+ *
+ *  ARGUMENTS:
+ *	    - derivedType {IN}
+ *
+ *  RETURNS
+ *	     Returns the XML_DERIVED_* code or -1 for unknown types
+ */
+
+static int getDerivedCode(const char* derivedType)
+{
+	char upperType[MAX_ATTRIBUTE_TYPE];
+
+	if (strlen(derivedType) >= MAX_ATTRIBUTE_TYPE)
+		return (-1);
+	convertToUpper((char *) derivedType, upperType);
+
+	if (strcmp(upperType, "IPV4ADDR") == 0)
+		return (XML_DERIVED_IPV4ADDR);
+	if (strcmp(upperType, "DATETIME") == 0)
+		return (XML_DERIVED_DATETIME);
+	if (strcmp(upperType, "DATETIMEMSEC") == 0)
+		return (XML_DERIVED_DATETIMEMSEC);
+	if (strcmp(upperType, "DATETIMEUSEC") == 0)
+		return (XML_DERIVED_DATETIMEUSEC);
+	if (strcmp(upperType, "IPV6ADDR") == 0 ||
+		strcmp(upperType, "UUID") == 0 ||
+		strcmp(upperType, "IPADDR") == 0)
+		return (XML_DERIVED_BYTEARRAY);
+
+	return (-1);
+}
+
+
+/*!
+ *  NAME:
+ *      isTemplateScalar() - tells whether an attribute can be templated
+ *
+ *  DESCRIPTION:
+ *         Arrays, structures and complex types carrying a namespace
+ *         prefix are written by writeIPDRXMLRecordHelper(), which also
+ *         strips the prefix of the descriptor.
+ *
+ *  ARGUMENTS:
+ *	    - pAttributeDescriptor {IN}
+ *
+ *  RETURNS
+ *	     Returns IPDR_TRUE or IPDR_FALSE
+ */
+
+static int isTemplateScalar(const AttributeDescriptor* pAttributeDescriptor)
+{
+	if (pAttributeDescriptor->noOfElements_ != 0)
+		return (IPDR_FALSE);
+
+	if (pAttributeDescriptor->complexType_[0] != '\0') {
+		if (strchr(pAttributeDescriptor->complexType_, ':') != NULL)
+			return (IPDR_FALSE);
+		if (isPrimitiveComplexType(pAttributeDescriptor->complexType_) == IPDR_FALSE)
+			return (IPDR_FALSE);
+	}
+
+	return (IPDR_TRUE);
+}
+
+
+/*!
+ *  NAME:
+ *      copyTemplateString() - allocates a copy of a string
+ *
+ *  ARGUMENTS:
+ *	    - pString {IN}
+ *
+ *  RETURNS
+ *	     Returns the copy or NULL
+ */
+
+static char* copyTemplateString(const char* pString)
+{
+	char* pCopy = (char *) malloc(strlen(pString) + 1);
+
+	if (pCopy != NULL)
+		strcpy(pCopy, pString);
+
+	return (pCopy);
+}
+
+
+/*!
+ *  NAME:
+ *      compileElementTemplate() - builds the template of one attribute
+ *
+ *  ARGUMENTS:
+ *	    - pElementTemplate {OUT}
+ *	    - pAttributeDescriptor {IN}
+ *
+ *  RETURNS
+ *	     Returns IPDR_TRUE if the attribute is templated, IPDR_FALSE
+ *	     if it is left to writeIPDRXMLRecordHelper() and IPDR_ERROR
+ *	     if memory allocation fails
+ */
+
+static int compileElementTemplate(XMLElementTemplate* pElementTemplate,
+								  const AttributeDescriptor* pAttributeDescriptor)
+{
+	int nameLength = 0;
+
+	if (isTemplateScalar(pAttributeDescriptor) == IPDR_FALSE)
+		return (IPDR_FALSE);
+
+	pElementTemplate->typeCode_ = convAttributeTypeToTypeCode(
+									pAttributeDescriptor->attributeType_);
+	if (pElementTemplate->typeCode_ < IPDRDATA_LONG ||
+		pElementTemplate->typeCode_ > IPDRDATA_USHORT)
+		return (IPDR_FALSE);
+
+	if (strcmp(pAttributeDescriptor->attributeType_,
+			   pAttributeDescriptor->derivedType_) == 0)
+		pElementTemplate->derivedCode_ = XML_DERIVED_NONE;
+	else
+		pElementTemplate->derivedCode_ = getDerivedCode(
+											pAttributeDescriptor->derivedType_);
+	if (pElementTemplate->derivedCode_ < 0)
+		return (IPDR_FALSE);
+
+	nameLength = strlen(pAttributeDescriptor->attributeName_);
+	pElementTemplate->pOpenTag_ = (char *) malloc(nameLength + 3);
+	pElementTemplate->pCloseTag_ = (char *) malloc(nameLength + 5);
+	pElementTemplate->attributeName_ = copyTemplateString(pAttributeDescriptor->attributeName_);
+	pElementTemplate->attributeType_ = copyTemplateString(pAttributeDescriptor->attributeType_);
+	pElementTemplate->derivedType_ = copyTemplateString(pAttributeDescriptor->derivedType_);
+	pElementTemplate->complexType_ = copyTemplateString(pAttributeDescriptor->complexType_);
+	if (pElementTemplate->pOpenTag_ == NULL || pElementTemplate->pCloseTag_ == NULL ||
+		pElementTemplate->attributeName_ == NULL || pElementTemplate->attributeType_ == NULL ||
+		pElementTemplate->derivedType_ == NULL || pElementTemplate->complexType_ == NULL)
+		return (IPDR_ERROR);
+
+	sprintf(pElementTemplate->pOpenTag_, "<%s>", pAttributeDescriptor->attributeName_);
+	sprintf(pElementTemplate->pCloseTag_, "</%s>\n", pAttributeDescriptor->attributeName_);
+	pElementTemplate->openLength_ = nameLength + 2;
+	pElementTemplate->closeLength_ = nameLength + 4;
+
+	return (IPDR_TRUE);
+}
+
+
+/*!
+ *  NAME:
+ *      newXMLRecordTemplate() - compiles the XML template of a descriptor
+ *
+ *  DESCRIPTION:
+ *         Builds the record open tag and the tags and value formats of
+ *         every attribute. Compilation stops at the first attribute
+ *         writeIPDRXMLRecordHelper() has to handle, such templates only
+ *         have isCompiled_ cleared.
+ *
+ *  ARGUMENTS:
+ *	    - typeName {IN}
+ *	    - pListAttributeDescriptor {IN}
+ *
+ *  RETURNS
+ *	     Returns Pointer to XMLRecordTemplate structure or NULL
+ */
+
+XMLRecordTemplate* newXMLRecordTemplate(const char* typeName,
+										const ListAttributeDescriptor* pListAttributeDescriptor)
+{
+	int count = 0;
+	int noOfElements = 0;
+	int compiled = IPDR_TRUE;
+	XMLRecordTemplate* pRecordTemplate;
+	const ListAttributeDescriptor* pCurrent;
+
+	if (typeName == NULL)
+		return (NULL);
+
+	noOfElements = getLengthListAttributeDescriptor(
+						(ListAttributeDescriptor *) pListAttributeDescriptor);
+
+	pRecordTemplate = (XMLRecordTemplate *) calloc(1, sizeof(XMLRecordTemplate));
+	if (pRecordTemplate == NULL)
+		return (NULL);
+	pRecordTemplate->pElements_ = (XMLElementTemplate *) calloc(
+									noOfElements > 0 ? noOfElements : 1,
+									sizeof(XMLElementTemplate));
+	pRecordTemplate->typeName_ = copyTemplateString(typeName);
+	pRecordTemplate->pRecordOpen_ = (char *) malloc(strlen(typeName) + 64);
+	if (pRecordTemplate->pElements_ == NULL || pRecordTemplate->typeName_ == NULL ||
+		pRecordTemplate->pRecordOpen_ == NULL) {
+		freeXMLRecordTemplate(pRecordTemplate);
+		return (NULL);
+	}
+
+	pRecordTemplate->recordOpenLength_ = sprintf(pRecordTemplate->pRecordOpen_,
+		" <IPDR xsi:type=\"%s\">\n<IPDRCreationTime>", typeName);
+
+	pCurrent = pListAttributeDescriptor;
+	for (count = 0; count < noOfElements; count++, pCurrent = pCurrent->pNext_) {
+		compiled = compileElementTemplate(&pRecordTemplate->pElements_[count],
+										  pCurrent->pAttributeDescriptor_);
+		if (compiled == IPDR_ERROR) {
+			pRecordTemplate->noOfElements_ = count + 1;
+			freeXMLRecordTemplate(pRecordTemplate);
+			return (NULL);
+		}
+		if (compiled == IPDR_FALSE)
+			break;
+	}
+	pRecordTemplate->noOfElements_ = count;
+	pRecordTemplate->isCompiled_ = compiled;
+
+	return (pRecordTemplate);
+}
+
+
+/*!
+ *  NAME:
+ *      freeXMLRecordTemplate() - Memory deallocation of XMLRecordTemplate
+ *
+ *  DESCRIPTION:
+ *         Frees the element templates and the record template.
+ *
+ *  ARGUMENTS:
+ *	    - pRecordTemplate {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+ */
+
+int freeXMLRecordTemplate(XMLRecordTemplate* pRecordTemplate)
+{
+	int count = 0;
+	XMLElementTemplate* pElementTemplate;
+
+	if (pRecordTemplate == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	for (count = 0; pRecordTemplate->pElements_ != NULL &&
+					count < pRecordTemplate->noOfElements_; count++) {
+		pElementTemplate = &pRecordTemplate->pElements_[count];
+		free(pElementTemplate->pOpenTag_);
+		free(pElementTemplate->pCloseTag_);
+		free(pElementTemplate->attributeName_);
+		free(pElementTemplate->attributeType_);
+		free(pElementTemplate->derivedType_);
+		free(pElementTemplate->complexType_);
+	}
+	free(pRecordTemplate->pElements_);
+	free(pRecordTemplate->typeName_);
+	free(pRecordTemplate->pRecordOpen_);
+	free(pRecordTemplate);
+
+	return (IPDR_OK);
+}
+
+
+static void freeXMLRecordTemplateValue(void* pValue)
+{
+	freeXMLRecordTemplate((XMLRecordTemplate *) pValue);
+}
+
+
+/*!
+ *  NAME:
+ *      matchXMLRecordTemplate() - checks a template against a record
+ *
+ *  DESCRIPTION:
+ *         Guards against fingerprint collisions by comparing the
+ *         descriptor fields the template was built from.
+ *
+ *  ARGUMENTS:
+ *	    - pRecordTemplate {IN}
+ *	    - pFNFData {IN}
+ *
+ *  RETURNS
+ *	     Returns IPDR_TRUE or IPDR_FALSE
+ */
+
+static int matchXMLRecordTemplate(const XMLRecordTemplate* pRecordTemplate,
+								  const FNFData* pFNFData)
+{
+	int count = 0;
+	const XMLElementTemplate* pElementTemplate;
+	const AttributeDescriptor* pAttributeDescriptor;
+	const ListAttributeDescriptor* pCurrent;
+
+	if (strcmp(pRecordTemplate->typeName_, pFNFData->typeName_) != 0)
+		return (IPDR_FALSE);
+
+	pCurrent = pFNFData->pListAttributeDescriptor_;
+	for (count = 0; count < pRecordTemplate->noOfElements_;
+		 count++, pCurrent = pCurrent->pNext_) {
+		if (pCurrent == NULL)
+			return (IPDR_FALSE);
+		pElementTemplate = &pRecordTemplate->pElements_[count];
+		pAttributeDescriptor = pCurrent->pAttributeDescriptor_;
+		if (pAttributeDescriptor->noOfElements_ != 0 ||
+			strcmp(pElementTemplate->attributeName_, pAttributeDescriptor->attributeName_) != 0 ||
+			strcmp(pElementTemplate->attributeType_, pAttributeDescriptor->attributeType_) != 0 ||
+			strcmp(pElementTemplate->derivedType_, pAttributeDescriptor->derivedType_) != 0 ||
+			strcmp(pElementTemplate->complexType_, pAttributeDescriptor->complexType_) != 0)
+			return (IPDR_FALSE);
+	}
+
+	return (pCurrent == NULL ? IPDR_TRUE : IPDR_FALSE);
+}
+
+
+/*!
+ *  NAME:
+ *      getXMLRecordTemplate() - returns the XML template of a record
+ *
+ *  DESCRIPTION:
+ *         Templates are kept by descriptor fingerprint and compiled
+ *         the first time a record of the descriptor is written.
+ *
+ *         A record carrying a descriptor ID takes the template last
+ *         matched for that ID if the type name is the same, as
+ *         writeIPDR() does with descriptors. The fingerprint is only
+ *         computed and the attributes compared when the ID is 0 or
+ *         not known yet.
+ *
+ *  ARGUMENTS:
+ *	    - IPDRCommonParameters {IN/OUT}
+ *	    - pFNFData {IN}
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns the template or NULL if the record has to be written
+ *	     by writeIPDRXMLRecordHelper()
+ */
+
+const XMLRecordTemplate* getXMLRecordTemplate(IPDRCommonParameters* pIPDRCommonParameters,
+											  FNFData* pFNFData,
+											  int* pErrorCode)
+{
+	unsigned int fingerprint = 0;
+	int errorCode = 0;
+	XMLRecordTemplate* pRecordTemplate;
+
+	if (pIPDRCommonParameters == NULL || pFNFData == NULL || pFNFData->typeName_ == NULL)
+		return (NULL);
+
+	if (pFNFData->descriptorID_ != 0 && pIPDRCommonParameters->pXMLTemplateIDMap_ != NULL) {
+		pRecordTemplate = (XMLRecordTemplate *) getIPDRIntMap(
+							pIPDRCommonParameters->pXMLTemplateIDMap_, pFNFData->descriptorID_);
+		if (pRecordTemplate != NULL &&
+			strcmp(pRecordTemplate->typeName_, pFNFData->typeName_) == 0)
+			return (pRecordTemplate->isCompiled_ == IPDR_TRUE ? pRecordTemplate : NULL);
+	}
+
+	if (pIPDRCommonParameters->pXMLTemplateMap_ == NULL) {
+		pIPDRCommonParameters->pXMLTemplateMap_ =
+			newIPDRIntMap(0, freeXMLRecordTemplateValue);
+		if (pIPDRCommonParameters->pXMLTemplateMap_ == NULL)
+			return (NULL);
+	}
+
+	fingerprint = fingerprintDescriptor(pFNFData->typeName_,
+										pFNFData->pListAttributeDescriptor_);
+	pRecordTemplate = (XMLRecordTemplate *) getIPDRIntMap(
+						pIPDRCommonParameters->pXMLTemplateMap_, (int) fingerprint);
+
+	if (pRecordTemplate == NULL) {
+		pRecordTemplate = newXMLRecordTemplate(pFNFData->typeName_,
+											   pFNFData->pListAttributeDescriptor_);
+		if (pRecordTemplate == NULL)
+			return (NULL);
+		if (putIPDRIntMap(pIPDRCommonParameters->pXMLTemplateMap_, (int) fingerprint,
+						  pRecordTemplate, pErrorCode) != IPDR_OK) {
+			freeXMLRecordTemplate(pRecordTemplate);
+			return (NULL);
+		}
+	}
+
+	if (matchXMLRecordTemplate(pRecordTemplate, pFNFData) != IPDR_TRUE)
+		return (NULL);
+
+	/* Later records of the descriptor skip the fingerprint */
+	if (pFNFData->descriptorID_ != 0) {
+		if (pIPDRCommonParameters->pXMLTemplateIDMap_ == NULL)
+			pIPDRCommonParameters->pXMLTemplateIDMap_ = newIPDRIntMap(0, NULL);
+		if (pIPDRCommonParameters->pXMLTemplateIDMap_ != NULL)
+			putIPDRIntMap(pIPDRCommonParameters->pXMLTemplateIDMap_, pFNFData->descriptorID_,
+						  pRecordTemplate, &errorCode);
+	}
+
+	if (pRecordTemplate->isCompiled_ != IPDR_TRUE)
+		return (NULL);
+
+	return (pRecordTemplate);
+}
+
+
+/*!
+ *  NAME:
+ *      formatXMLInteger() - decimal image of an integer
+ *
+ *  DESCRIPTION:
+ *         Same digits as the %d / %u / %lld / %llu conversions used by
+ *         writeIPDRXMLRecordHelper().
+ *
+ *  ARGUMENTS:
+ *	    - pBuffer {OUT}
+ *	    - magnitude {IN}
+ *	    - negative {IN}
+ *
+ *  RETURNS
+ *	     Returns the number of characters stored, not NUL terminated
+ */
+
+static int formatXMLInteger(char* pBuffer, u_hyper magnitude, int negative)
+{
+	char digits[24];
+	int noOfDigits = 0;
+	int length = 0;
+
+	do {
+		digits[noOfDigits++] = (char) ('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude != 0);
+
+	if (negative)
+		pBuffer[length++] = '-';
+	while (noOfDigits > 0)
+		pBuffer[length++] = digits[--noOfDigits];
+
+	return (length);
+}
+
+
+static int formatXMLSigned(char* pBuffer, hyper value)
+{
+	if (value < 0)
+		return (formatXMLInteger(pBuffer, (u_hyper) (-(value + 1)) + 1, IPDR_TRUE));
+
+	return (formatXMLInteger(pBuffer, (u_hyper) value, IPDR_FALSE));
+}
+
+
+/*!
+ *  NAME:
+ *      writeTemplateValue() - appends the value of one attribute
+ *
+ *  DESCRIPTION:
+ *         Formats the value the way writeIPDRXMLRecordHelper() does.
+ *         Warnings of the derived type conversions are reported with
+ *         errorHandler().
+ *
+ *  ARGUMENTS:
+ *	    - IPDRCommonParameters {IN/OUT}
+ *	    - pElementTemplate {IN}
+ *	    - pDataUnion {IN}
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+static int writeTemplateValue(IPDRCommonParameters* pIPDRCommonParameters,
+							  const XMLElementTemplate* pElementTemplate,
+							  IPDRDataUnion* pDataUnion,
+							  int* pErrorCode)
+{
+	char value[XML_TEMPLATE_VALUE_LENGTH];
+	const char* pValue = value;
+	const char* conversion = NULL;
+	int length = -1;
+	int errorSeverity = IPDR_OK;
+	XDROutputBuffer* pOutputBuffer = pIPDRCommonParameters->pOutputBuffer_;
+
+	/* The conversions append to the buffer */
+	value[0] = '\0';
+
+	switch (pElementTemplate->derivedCode_)
+	{
+	case XML_DERIVED_IPV4ADDR:
+		errorSeverity = convIntToIPv4Addr(pDataUnion->IPDRLong_, value, pErrorCode);
+		conversion = "convIntToIPv4Addr";
+		break;
+	case XML_DERIVED_DATETIME:
+		errorSeverity = convIntToDateTime(&pDataUnion->IPDRLong_, value, pErrorCode);
+		conversion = "convIntToDateTime";
+		break;
+	case XML_DERIVED_DATETIMEMSEC:
+		errorSeverity = convLongToTime(&pDataUnion->IPDRLongLong_, value, pErrorCode);
+		conversion = "convLongToTime";
+		break;
+	case XML_DERIVED_DATETIMEUSEC:
+		errorSeverity = convLongMicroToTime(&pDataUnion->IPDRLongLong_, value, pErrorCode);
+		conversion = "convLongMicroToTime";
+		break;
+	case XML_DERIVED_BYTEARRAY:
+		pValue = (const char *) pDataUnion->IPDRByteArray_;
+		break;
+	default:
+		switch (pElementTemplate->typeCode_)
+		{
+		case IPDRDATA_LONG:
+			length = formatXMLSigned(value, pDataUnion->IPDRLong_);
+			break;
+		case IPDRDATA_ULONG:
+			length = formatXMLInteger(value, pDataUnion->IPDRULong_, IPDR_FALSE);
+			break;
+		case IPDRDATA_LONGLONG:
+			length = formatXMLSigned(value, pDataUnion->IPDRLongLong_);
+			break;
+		case IPDRDATA_ULONGLONG:
+			length = formatXMLInteger(value, pDataUnion->IPDRULongLong_, IPDR_FALSE);
+			break;
+		case IPDRDATA_FLOAT:
+			length = snprintf(value, sizeof(value), "%f", pDataUnion->IPDRFloat_);
+			break;
+		case IPDRDATA_DOUBLE:
+			length = snprintf(value, sizeof(value), "%f", pDataUnion->IPDRDouble_);
+			break;
+		case IPDRDATA_HEXADECARRAY:
+			pValue = (const char *) pDataUnion->IPDRByteArray_;
+			break;
+		case IPDRDATA_STRING:
+			return (appendEscapedXMLString(pOutputBuffer,
+										   (const char *) pDataUnion->IPDRUTF8Array_));
+		case IPDRDATA_BOOLEAN:
+			pValue = (const char *) pDataUnion->IPDRBoolean_;
+			if (strcmp(pValue, "0") == 0)
+				pValue = "false";
+			else if (strcmp(pValue, "1") == 0)
+				pValue = "true";
+			break;
+		case IPDRDATA_SHORT:
+			length = formatXMLSigned(value, pDataUnion->IPDRShort_);
+			break;
+		case IPDRDATA_USHORT:
+			length = formatXMLInteger(value, pDataUnion->IPDRUShort_, IPDR_FALSE);
+			break;
+		case IPDRDATA_BYTE:
+		case IPDRDATA_UBYTE:
+			length = formatXMLSigned(value, pDataUnion->IPDRByte_);
+			break;
+		default:
+			return (IPDR_NON_PRIMITIVE_DATA_TYPE);
+		}
+		break;
+	}
+
+	if (errorSeverity == IPDR_WARNING) {
+		errorHandler(pIPDRCommonParameters, pErrorCode, (char *) conversion);
+	}
+	else if (errorSeverity == IPDR_ERROR) {
+		return (*pErrorCode);
+	}
+
+	if (length >= (int) sizeof(value))
+		length = sizeof(value) - 1;
+
+	return (appendXMLString(pOutputBuffer, pValue, length));
+}
+
+
+/*!
+ *  NAME:
+ *      writeXMLRecordTemplate() - writes a record from its template
+ *
+ *  DESCRIPTION:
+ *         Appends the XML of the record to the output buffer of the
+ *         document, see attachXDROutputBuffer(). The caller commits
+ *         the buffer at the record boundary.
+ *
+ *  ARGUMENTS:
+ *	    - IPDRCommonParameters {IN/OUT}
+ *	    - pRecordTemplate {IN}
+ *	    - pFNFData {IN}
+ *	    - creationTime {IN}
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int writeXMLRecordTemplate(IPDRCommonParameters* pIPDRCommonParameters,
+						   const XMLRecordTemplate* pRecordTemplate,
+						   FNFData* pFNFData,
+						   const char* creationTime,
+						   int* pErrorCode)
+{
+	int count = 0;
+	int length = 0;
+	int result = IPDR_OK;
+	char seqNum[24];
+	const XMLElementTemplate* pElementTemplate;
+	ListIPDRData* pCurrentListIPDRData;
+	XDROutputBuffer* pOutputBuffer;
+
+	if (pIPDRCommonParameters == NULL || pRecordTemplate == NULL ||
+		pFNFData == NULL || creationTime == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	pOutputBuffer = pIPDRCommonParameters->pOutputBuffer_;
+	length = formatXMLSigned(seqNum, pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_);
+
+	result = appendXMLString(pOutputBuffer, pRecordTemplate->pRecordOpen_,
+							 pRecordTemplate->recordOpenLength_);
+	if (result == IPDR_OK)
+		result = appendXMLString(pOutputBuffer, creationTime, -1);
+	if (result == IPDR_OK)
+		result = appendXMLString(pOutputBuffer, XML_TEMPLATE_TIME_CLOSE,
+								 sizeof(XML_TEMPLATE_TIME_CLOSE) - 1);
+	if (result == IPDR_OK)
+		result = appendXMLString(pOutputBuffer, seqNum, length);
+	if (result == IPDR_OK)
+		result = appendXMLString(pOutputBuffer, XML_TEMPLATE_SEQ_CLOSE,
+								 sizeof(XML_TEMPLATE_SEQ_CLOSE) - 1);
+
+	pCurrentListIPDRData = pFNFData->pListIPDRData_;
+	for (count = 0; result == IPDR_OK && count < pRecordTemplate->noOfElements_;
+		 count++, pCurrentListIPDRData = pCurrentListIPDRData->pNext_) {
+		if (pCurrentListIPDRData == NULL) {
+			result = IPDR_NULL_INPUT_PARAMETER;
+			break;
+		}
+		pElementTemplate = &pRecordTemplate->pElements_[count];
+		result = appendXMLString(pOutputBuffer, pElementTemplate->pOpenTag_,
+								 pElementTemplate->openLength_);
+		if (result == IPDR_OK)
+			result = writeTemplateValue(pIPDRCommonParameters, pElementTemplate,
+										&pCurrentListIPDRData->IPDRDataUnion_,
+										pErrorCode);
+		if (result == IPDR_OK)
+			result = appendXMLString(pOutputBuffer, pElementTemplate->pCloseTag_,
+									 pElementTemplate->closeLength_);
+	}
+
+	if (result == IPDR_OK)
+		result = appendXMLString(pOutputBuffer, XML_TEMPLATE_RECORD_CLOSE,
+								 sizeof(XML_TEMPLATE_RECORD_CLOSE) - 1);
+
+	if (result != IPDR_OK) {
+		*pErrorCode = result;
+		return (IPDR_ERROR);
+	}
+
+	return (IPDR_OK);
+}
@@ -0,0 +1,472 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : XMLTypeCache               *
+ * Description          : Schema types of XML record *
+ *                        shapes, resolved once      *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include "xml/XMLTypeCache.h"
+#include "xml/IPDRXMLRecordHelper.h"
+#include "utils/IPDRMap.h"
+#include "utils/errorCode.h"
+
+static void freeResolvedAttributes(XMLResolvedAttribute* pAttributes, int noOfAttributes);
+
+
+/*!
+ *  NAME:
+ *      fingerprintShapeString() - folds a string into a shape fingerprint
+ *
+ *  ARGUMENTS:
+ *	    - hash {IN}
+ *	    - pString {IN}, may be NULL
+ *
+ *  RETURNS
+ *	     Returns the updated fingerprint
+ */
+
+static unsigned int fingerprintShapeString(unsigned int hash, const char* pString)
+{
+	if (pString != NULL) {
+		for (; *pString != '\0'; pString++) {
+			hash ^= (unsigned char) *pString;
+			hash *= IPDR_FNV_PRIME;
+		}
+	}
+
+	/* Separator, so that "ab","c" and "a","bc" differ */
+	hash ^= 0xff;
+	hash *= IPDR_FNV_PRIME;
+
+	return (hash);
+}
+
+
+/*!
+ *  NAME:
+ *      fingerprintShape() - fingerprint of the shape of a record
+ *
+ *  DESCRIPTION:
+ *         Covers the type name and the element names, and the complex
+ *         types of the service attributes of v3.5 records.
+ *
+ *  ARGUMENTS:
+ *	    - pFNFData {IN}
+ *	    - isComplex {IN}
+ *
+ *  RETURNS
+ *	     Returns the fingerprint
+ */
+
+static unsigned int fingerprintShape(const FNFData* pFNFData, int isComplex)
+{
+	unsigned int hash = IPDR_FNV_OFFSET_BASIS;
+	const ListAttributeDescriptor* pCurrent;
+
+	hash = fingerprintShapeString(hash, pFNFData->typeName_);
+	hash ^= (unsigned int) isComplex;
+	hash *= IPDR_FNV_PRIME;
+
+	for (pCurrent = pFNFData->pListAttributeDescriptor_; pCurrent != NULL;
+		 pCurrent = pCurrent->pNext_)
+		hash = fingerprintShapeString(hash, pCurrent->pAttributeDescriptor_->attributeName_);
+
+	if (isComplex == IPDR_TRUE) {
+		for (pCurrent = pFNFData->pListServiceAttributeDescriptor_; pCurrent != NULL;
+			 pCurrent = pCurrent->pNext_) {
+			hash = fingerprintShapeString(hash, pCurrent->pAttributeDescriptor_->attributeName_);
+			hash = fingerprintShapeString(hash, pCurrent->pAttributeDescriptor_->complexType_);
+		}
+	}
+
+	return (hash);
+}
+
+
+static char* copyShapeString(const char* pString)
+{
+	char* pCopy;
+
+	if (pString == NULL)
+		return (NULL);
+
+	pCopy = (char *) malloc(strlen(pString) + 1);
+	if (pCopy != NULL)
+		strcpy(pCopy, pString);
+
+	return (pCopy);
+}
+
+
+static int isSameString(const char* pString1, const char* pString2)
+{
+	if (pString1 == NULL || pString2 == NULL)
+		return (pString1 == pString2);
+
+	return (strcmp(pString1, pString2) == 0);
+}
+
+
+/*!
+ *  NAME:
+ *      newResolvedAttributes() - records the element names of a list
+ *
+ *  ARGUMENTS:
+ *	    - pListAttributeDescriptor {IN}
+ *	    - pNoOfAttributes {OUT}
+ *
+ *  RETURNS
+ *	     Returns the array, NULL if memory allocation fails
+ */
+
+static XMLResolvedAttribute* newResolvedAttributes(
+								const ListAttributeDescriptor* pListAttributeDescriptor,
+								int* pNoOfAttributes)
+{
+	int count = 0;
+	int noOfAttributes = 0;
+	XMLResolvedAttribute* pAttributes;
+	const ListAttributeDescriptor* pCurrent;
+
+	for (pCurrent = pListAttributeDescriptor; pCurrent != NULL; pCurrent = pCurrent->pNext_)
+		noOfAttributes++;
+
+	pAttributes = (XMLResolvedAttribute *) calloc(noOfAttributes > 0 ? noOfAttributes : 1,
+												  sizeof(XMLResolvedAttribute));
+	if (pAttributes == NULL)
+		return (NULL);
+	*pNoOfAttributes = noOfAttributes;
+
+	for (pCurrent = pListAttributeDescriptor; pCurrent != NULL;
+		 pCurrent = pCurrent->pNext_, count++) {
+		pAttributes[count].attributeName_ =
+			copyShapeString(pCurrent->pAttributeDescriptor_->attributeName_);
+		pAttributes[count].complexType_ =
+			copyShapeString(pCurrent->pAttributeDescriptor_->complexType_);
+		if (pAttributes[count].attributeName_ == NULL) {
+			freeResolvedAttributes(pAttributes, noOfAttributes);
+			return (NULL);
+		}
+	}
+
+	return (pAttributes);
+}
+
+
+static void freeResolvedAttributes(XMLResolvedAttribute* pAttributes, int noOfAttributes)
+{
+	int count = 0;
+
+	if (pAttributes == NULL)
+		return;
+
+	for (count = 0; count < noOfAttributes; count++) {
+		free(pAttributes[count].attributeName_);
+		free(pAttributes[count].complexType_);
+		free(pAttributes[count].resolvedName_);
+		free(pAttributes[count].attributeType_);
+		free(pAttributes[count].derivedType_);
+	}
+	free(pAttributes);
+}
+
+
+/*!
+ *  NAME:
+ *      freeXMLTypeResolution() - Memory deallocation of XMLTypeResolution
+ *
+ *  ARGUMENTS:
+ *	    - pTypeResolution {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+ */
+
+int freeXMLTypeResolution(XMLTypeResolution* pTypeResolution)
+{
+	if (pTypeResolution == NULL)
+		return (IPDR_NULL_INPUT_PARAMETER);
+
+	freeResolvedAttributes(pTypeResolution->pAttributes_,
+						   pTypeResolution->noOfAttributes_);
+	freeResolvedAttributes(pTypeResolution->pServiceAttributes_,
+						   pTypeResolution->noOfServiceAttributes_);
+	free(pTypeResolution->typeName_);
+	free(pTypeResolution);
+
+	return (IPDR_OK);
+}
+
+
+static void freeXMLTypeResolutionValue(void* pValue)
+{
+	freeXMLTypeResolution((XMLTypeResolution *) pValue);
+}
+
+
+/*!
+ *  NAME:
+ *      newXMLTypeResolution() - records the shape of a record
+ *
+ *  DESCRIPTION:
+ *         Takes the names before the schema lookup, which may rewrite
+ *         the names of service attributes.
+ *
+ *  ARGUMENTS:
+ *	    - pFNFData {IN}
+ *	    - isComplex {IN}
+ *
+ *  RETURNS
+ *	     Returns Pointer to XMLTypeResolution structure or NULL
+ */
+
+static XMLTypeResolution* newXMLTypeResolution(const FNFData* pFNFData, int isComplex)
+{
+	XMLTypeResolution* pTypeResolution;
+
+	pTypeResolution = (XMLTypeResolution *) calloc(1, sizeof(XMLTypeResolution));
+	if (pTypeResolution == NULL)
+		return (NULL);
+
+	pTypeResolution->isComplex_ = isComplex;
+	pTypeResolution->typeName_ = copyShapeString(pFNFData->typeName_);
+	pTypeResolution->pAttributes_ = newResolvedAttributes(
+										pFNFData->pListAttributeDescriptor_,
+										&pTypeResolution->noOfAttributes_);
+	if (isComplex == IPDR_TRUE)
+		pTypeResolution->pServiceAttributes_ = newResolvedAttributes(
+										pFNFData->pListServiceAttributeDescriptor_,
+										&pTypeResolution->noOfServiceAttributes_);
+
+	if (pTypeResolution->typeName_ == NULL || pTypeResolution->pAttributes_ == NULL ||
+		(isComplex == IPDR_TRUE && pTypeResolution->pServiceAttributes_ == NULL)) {
+		freeXMLTypeResolution(pTypeResolution);
+		return (NULL);
+	}
+
+	return (pTypeResolution);
+}
+
+
+/*!
+ *  NAME:
+ *      captureResolvedAttributes() - records the outcome of the lookup
+ *
+ *  DESCRIPTION:
+ *         Types of service attributes are only set by
+ *         getComplexAttributeTypeFromSchema() if they have a complex
+ *         type other than "structure".
+ *
+ *  ARGUMENTS:
+ *	    - pAttributes {IN/OUT}
+ *	    - pListAttributeDescriptor {IN}
+ *	    - isService {IN}
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK or IPDR_ERROR if memory allocation fails
+ */
+
+static int captureResolvedAttributes(XMLResolvedAttribute* pAttributes,
+									 const ListAttributeDescriptor* pListAttributeDescriptor,
+									 int isService)
+{
+	int count = 0;
+	const AttributeDescriptor* pAttributeDescriptor;
+	const ListAttributeDescriptor* pCurrent;
+
+	for (pCurrent = pListAttributeDescriptor; pCurrent != NULL;
+		 pCurrent = pCurrent->pNext_, count++) {
+		pAttributeDescriptor = pCurrent->pAttributeDescriptor_;
+		if (isService == IPDR_TRUE &&
+			strcmp(pAttributes[count].attributeName_, pAttributeDescriptor->attributeName_) != 0) {
+			pAttributes[count].resolvedName_ = copyShapeString(pAttributeDescriptor->attributeName_);
+			if (pAttributes[count].resolvedName_ == NULL)
+				return (IPDR_ERROR);
+		}
+		if (isService == IPDR_TRUE && (pAttributeDescriptor->complexType_ == NULL ||
+			strcmp(pAttributeDescriptor->complexType_, "structure") == 0))
+			continue;
+		pAttributes[count].attributeType_ = copyShapeString(pAttributeDescriptor->attributeType_);
+		pAttributes[count].derivedType_ = copyShapeString(pAttributeDescriptor->derivedType_);
+		if (pAttributes[count].attributeType_ == NULL || pAttributes[count].derivedType_ == NULL)
+			return (IPDR_ERROR);
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      matchResolvedAttributes() - checks a cached list against a record
+ *
+ *  ARGUMENTS:
+ *	    - pAttributes {IN}
+ *	    - noOfAttributes {IN}
+ *	    - pListAttributeDescriptor {IN}
+ *	    - isService {IN}
+ *
+ *  RETURNS
+ *	     Returns IPDR_TRUE or IPDR_FALSE
+ */
+
+static int matchResolvedAttributes(const XMLResolvedAttribute* pAttributes,
+								   int noOfAttributes,
+								   const ListAttributeDescriptor* pListAttributeDescriptor,
+								   int isService)
+{
+	int count = 0;
+	const ListAttributeDescriptor* pCurrent = pListAttributeDescriptor;
+
+	for (count = 0; count < noOfAttributes; count++, pCurrent = pCurrent->pNext_) {
+		if (pCurrent == NULL ||
+			strcmp(pAttributes[count].attributeName_,
+				   pCurrent->pAttributeDescriptor_->attributeName_) != 0)
+			return (IPDR_FALSE);
+		if (isService == IPDR_TRUE &&
+			!isSameString(pAttributes[count].complexType_,
+						  pCurrent->pAttributeDescriptor_->complexType_))
+			return (IPDR_FALSE);
+	}
+
+	return (pCurrent == NULL ? IPDR_TRUE : IPDR_FALSE);
+}
+
+
+static int applyResolvedAttributes(const XMLResolvedAttribute* pAttributes,
+								   IPDRArena* pArena,
+								   ListAttributeDescriptor* pListAttributeDescriptor)
+{
+	int count = 0;
+	AttributeDescriptor* pAttributeDescriptor;
+	ListAttributeDescriptor* pCurrent;
+
+	for (pCurrent = pListAttributeDescriptor; pCurrent != NULL;
+		 pCurrent = pCurrent->pNext_, count++) {
+		pAttributeDescriptor = pCurrent->pAttributeDescriptor_;
+		if (pAttributes[count].resolvedName_ != NULL)
+			strcpy(pAttributeDescriptor->attributeName_, pAttributes[count].resolvedName_);
+		if (pAttributes[count].attributeType_ != NULL &&
+			(setAttributeDescriptorString(pArena, &(pAttributeDescriptor->attributeType_),
+										  pAttributes[count].attributeType_) != IPDR_OK ||
+			 setAttributeDescriptorString(pArena, &(pAttributeDescriptor->derivedType_),
+										  pAttributes[count].derivedType_) != IPDR_OK))
+			return (IPDR_ERROR);
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      resolveXMLAttributeTypes() - sets the schema types of a record
+ *                                   read from XML
+ *
+ *  DESCRIPTION:
+ *         Looks the shape of the record up in the type cache of the
+ *         document and copies the cached types on a hit. Otherwise
+ *         the schema is walked by getComplexAttributeTypeFromSchema()
+ *         for v3.5 records or getAttributeTypeFromSchema(), and a
+ *         successful resolution is cached. Failed lookups are never
+ *         cached, so that each record reports its own errors.
+ *
+ *  ARGUMENTS:
+ *	    - IPDRCommonParameters {IN/OUT}
+ *	    - pFNFData {IN/OUT}
+ *	    - isComplex {IN} IPDR_TRUE for v3.5 records
+ *	    - pErrorCode {OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+ */
+
+int resolveXMLAttributeTypes(IPDRCommonParameters* pIPDRCommonParameters,
+							 FNFData* pFNFData,
+							 int isComplex,
+							 int* pErrorCode)
+{
+	int errorSeverity = 0;
+	int errorCode = 0;
+	unsigned int fingerprint = 0;
+	XMLTypeResolution* pCached = NULL;
+	XMLTypeResolution* pTypeResolution = NULL;
+
+	if (pIPDRCommonParameters == NULL || pFNFData == NULL) {
+		*pErrorCode = IPDR_NULL_INPUT_PARAMETER;
+		return (IPDR_ERROR);
+	}
+
+	if (pIPDRCommonParameters->pXMLTypeCache_ == NULL)
+		pIPDRCommonParameters->pXMLTypeCache_ =
+			newIPDRIntMap(0, freeXMLTypeResolutionValue);
+
+	if (pIPDRCommonParameters->pXMLTypeCache_ != NULL && pFNFData->typeName_ != NULL) {
+		fingerprint = fingerprintShape(pFNFData, isComplex);
+		pCached = (XMLTypeResolution *) getIPDRIntMap(
+					pIPDRCommonParameters->pXMLTypeCache_, (int) fingerprint);
+	}
+
+	if (pCached != NULL) {
+		if (pCached->isComplex_ == isComplex &&
+			strcmp(pCached->typeName_, pFNFData->typeName_) == 0 &&
+			matchResolvedAttributes(pCached->pAttributes_, pCached->noOfAttributes_,
+									pFNFData->pListAttributeDescriptor_, IPDR_FALSE) == IPDR_TRUE &&
+			(isComplex != IPDR_TRUE ||
+			 matchResolvedAttributes(pCached->pServiceAttributes_,
+									 pCached->noOfServiceAttributes_,
+									 pFNFData->pListServiceAttributeDescriptor_,
+									 IPDR_TRUE) == IPDR_TRUE)) {
+			if (applyResolvedAttributes(pCached->pAttributes_, pFNFData->pArena_,
+										pFNFData->pListAttributeDescriptor_) != IPDR_OK ||
+				(isComplex == IPDR_TRUE &&
+				 applyResolvedAttributes(pCached->pServiceAttributes_, pFNFData->pArena_,
+										 pFNFData->pListServiceAttributeDescriptor_) != IPDR_OK)) {
+				*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+				return (IPDR_ERROR);
+			}
+			return (IPDR_OK);
+		}
+	}
+	else if (pIPDRCommonParameters->pXMLTypeCache_ != NULL && pFNFData->typeName_ != NULL) {
+		pTypeResolution = newXMLTypeResolution(pFNFData, isComplex);
+	}
+
+	if (isComplex == IPDR_TRUE)
+		errorSeverity = getComplexAttributeTypeFromSchema(pIPDRCommonParameters,
+														  pFNFData, pErrorCode);
+	else
+		errorSeverity = getAttributeTypeFromSchema(pIPDRCommonParameters,
+												   pFNFData, pErrorCode);
+
+	if (pTypeResolution == NULL)
+		return (errorSeverity);
+
+	if (errorSeverity != IPDR_OK ||
+		captureResolvedAttributes(pTypeResolution->pAttributes_,
+								  pFNFData->pListAttributeDescriptor_, IPDR_FALSE) != IPDR_OK ||
+		(isComplex == IPDR_TRUE &&
+		 captureResolvedAttributes(pTypeResolution->pServiceAttributes_,
+								   pFNFData->pListServiceAttributeDescriptor_,
+								   IPDR_TRUE) != IPDR_OK) ||
+		putIPDRIntMap(pIPDRCommonParameters->pXMLTypeCache_, (int) fingerprint,
+					  pTypeResolution, &errorCode) != IPDR_OK)
+		freeXMLTypeResolution(pTypeResolution);
+
+	return (errorSeverity);
+}
@@ -27,8 +27,7 @@ D
 #include <string.h>
 #include <stdlib.h>
 #include "xml/XMLUnMarshaller.h"
-
-static char gVersion[10];
+#include "utils/IPDRThread.h"
 
 /*!
  *  NAME:
@@ -61,6 +60,7 @@ static void start(void *data, const char *name, const char **attr)
   unsigned int lenIPDRRecorderInfo = 0;
   char nameSpaceId[MAX_NAMESPACE_URI] = "";
   char tmpNameSpaceID[MAX_NAMESPACE_URI] = "";
+  char* pTokenContext = NULL;
 
 
   XMLUnMarshallerCommon* pXMLUnMarshallerCommon = NULL;
@@ -120,19 +120,19 @@ static void start(void *data, const char *name, const char **attr)
                       &pXMLUnMarshallerCommon->pGIPDRHeader_->startTime_, &errorCode);
 
 	if(!strcmp(attr[index], "version")) {
-		if(gVersion[0] != '\0') {
+		if(pXMLUnMarshallerCommon->version_[0] != '\0') {
 			if(strcmp(attr[index + 1], IPDR_VERSION_3_0) == 0) {
 				printf("The version in the xml file is %s\n", attr[index + 1]);
 			}
-			else if(strcmp(gVersion, attr[index + 1]) != 0) {
+			else if(strcmp(pXMLUnMarshallerCommon->version_, attr[index + 1]) != 0) {
 				printf("The version in the xml file is %s\n", attr[index + 1]);
 				exit(-1);
 			}
 		} else {
 			if(strcmp(attr[index + 1],IPDR_VERSION_3_1) == 0) {
-				strcpy(gVersion, IPDR_VERSION_3_1);
+				strcpy(pXMLUnMarshallerCommon->version_, IPDR_VERSION_3_1);
 			} else if(strcmp(attr[index + 1],IPDR_VERSION_3_5) == 0) {
-				strcpy(gVersion, IPDR_VERSION_3_5);
+				strcpy(pXMLUnMarshallerCommon->version_, IPDR_VERSION_3_5);
 			}
 		}
 		pXMLUnMarshallerCommon->pGIPDRHeader_->majorVersion_ = atoi(attr[index + 1]);
@@ -169,14 +169,14 @@ static void start(void *data, const char *name, const char **attr)
 	if(!strcmp(attr[index], "xsi:noNamespaceSchemaLocation")) {
 		sprintf(pXMLUnMarshallerCommon->schemaLocation_, "%s", attr[index + 1]);
 	
-	    pXMLUnMarshallerCommon->token_ = strtok(pXMLUnMarshallerCommon->schemaLocation_," ");
+	    pXMLUnMarshallerCommon->token_ = strtok_r(pXMLUnMarshallerCommon->schemaLocation_," ", &pTokenContext);
 
 	    for(count=1; pXMLUnMarshallerCommon->token_ != NULL; count++ )  {
       
            appendListServiceDefinitionURI(&pXMLUnMarshallerCommon->pGIPDRHeader_->pListServiceDefinitionURI_,
 			                            pXMLUnMarshallerCommon->token_); 
 										
-		  pXMLUnMarshallerCommon->token_ = strtok( NULL, " ");
+		  pXMLUnMarshallerCommon->token_ = strtok_r( NULL, " ", &pTokenContext );
 	  }
 	
 		strcpy(pXMLUnMarshallerCommon->schemaLocation_, ""); 
@@ -216,8 +216,7 @@ static void end(void *data, const char *name)
 	ListIPDRData* pCurrentListIPDRData = NULL;
 	ListAttributeDescriptor* pCurrent = NULL;
 	ListFNFData* pXMLCurrent = NULL;
-	static char lName[50];
-	static countValue = 0;
+	char lName[50];
 	int count = 0;
 	int retVal = 1;
 	int lComplexFlag = 0;
@@ -230,7 +229,8 @@ static void end(void *data, const char *name)
 		
 		if(pXMLUnMarshallerCommon->ComplexFlagValue2_ == 1) {
 			pXMLUnMarshallerCommon->ComplexFlagValue2_ = 0;
-			strncpy(lName, (char *)name, strlen(name));
+			strncpy(lName, (char *)name, sizeof(lName) - 1);
+			lName[sizeof(lName) - 1] = '\0';
 			lComplexFlag = 1;
 			appendNode(&pXMLUnMarshallerCommon->pAttrNameList_,(char *)name);
 		} else {
@@ -332,6 +332,54 @@ static void end(void *data, const char *name)
 
 
 
+/*!
+ *  NAME:
+ *      setAttributeValue() - Sets the value of the attribute being read.
+ *
+ *  DESCRIPTION:
+ *		   pPrefix followed by pValue is copied to attributeValue_,
+ *		   which grows when the value does not fit. pPrefix may be
+ *		   attributeValue_ itself to append to it.
+ *
+ *  ARGUMENTS:
+ *       -	pXMLUnMarshallerCommon {IN/OUT}
+ *       -  pPrefix {IN}
+ *		 -  pValue {IN}
+ *
+ *  RETURNS
+ *	     Returns IPDR_OK or IPDR_MEMORY_ALLOCATION_FAILED
+ *
+ */
+
+static int setAttributeValue(XMLUnMarshallerCommon* pXMLUnMarshallerCommon,
+							 const char* pPrefix,
+							 const char* pValue)
+{
+	int lenPrefix = strlen(pPrefix);
+	int lenValue = strlen(pValue);
+	int capacity = pXMLUnMarshallerCommon->attributeValueCapacity_;
+	char* pAttributeValue = NULL;
+
+	if (lenPrefix + lenValue + 1 > capacity) {
+		while (capacity < lenPrefix + lenValue + 1)
+			capacity = capacity * 2;
+		pAttributeValue = (char *) malloc(capacity);
+		if (pAttributeValue == NULL)
+			return (IPDR_MEMORY_ALLOCATION_FAILED);
+		memcpy(pAttributeValue, pPrefix, lenPrefix);
+		memcpy(pAttributeValue + lenPrefix, pValue, lenValue + 1);
+		free(pXMLUnMarshallerCommon->attributeValue_);
+		pXMLUnMarshallerCommon->attributeValue_ = pAttributeValue;
+		pXMLUnMarshallerCommon->attributeValueCapacity_ = capacity;
+		return (IPDR_OK);
+	}
+
+	memmove(pXMLUnMarshallerCommon->attributeValue_ + lenPrefix, pValue, lenValue + 1);
+	memmove(pXMLUnMarshallerCommon->attributeValue_, pPrefix, lenPrefix);
+	return (IPDR_OK);
+}
+
+
 /*!
  *  NAME:
  *      attributeValueHandler() - This function is called as any character
@@ -348,11 +396,11 @@ static void end(void *data, const char *name)
  *		 -  len {IN}
  *
  *  RETURNS
- *	     Returns void
+ *	     Returns IPDR_OK or IPDR_MEMORY_ALLOCATION_FAILED
  *
  */
 
-static void attributeValueHandler(void *data, const char *attributeValue, int len)
+static int attributeValueHandler(void *data, const char *attributeValue, int len)
 {
 	char *buffer = NULL;
 	int errorCode = 0;
@@ -365,7 +413,6 @@ static void attributeValueHandler(void *data, const char *attributeValue, int le
 	char* tmpXMLChar = NULL;
 	char* tmpXMLString = NULL;
 	char attributeValue1[MAX_IPDR_STRING];
-	char lTempAttributeName[MAX_IPDR_STRING];
 	void* dataValue[MAX_IPDR_STRING];
 	XMLUnMarshallerCommon* pXMLUnMarshallerCommon = NULL;
 	ListIPDRComplex* pCurrentListIPDRComplex = NULL;
@@ -434,17 +481,25 @@ if(len > 1) {
 	buffer[len] = 0;
 
 	if (pXMLUnMarshallerCommon->flagValue_ == IPDR_TRUE) {
-		sprintf(pXMLUnMarshallerCommon->attributeValue_, "%s", buffer);
-		if (getXMLChar(tmpXMLChar) != 0) {
-			tmpXMLString = (char *) calloc (2, sizeof(char));
-			tmpXMLString[0] = getXMLChar(tmpXMLChar);
-			tmpXMLString[1] = 0;
-			strcat(pXMLUnMarshallerCommon->attributeValue_, tmpXMLString);
+		tmpXMLString = (char *) calloc (2, sizeof(char));
+		tmpXMLString[0] = getXMLChar(tmpXMLChar);
+		if (setAttributeValue(pXMLUnMarshallerCommon, "", buffer) != IPDR_OK ||
+			setAttributeValue(pXMLUnMarshallerCommon, 
+							  pXMLUnMarshallerCommon->attributeValue_, tmpXMLString) != IPDR_OK) {
 			free(tmpXMLString);
+			free(buffer);
+			free(tmpXMLChar);
+			return (IPDR_MEMORY_ALLOCATION_FAILED);
 		}
+		free(tmpXMLString);
 	}
 	else {
-		strcat(pXMLUnMarshallerCommon->attributeValue_, buffer);
+		if (setAttributeValue(pXMLUnMarshallerCommon, 
+							  pXMLUnMarshallerCommon->attributeValue_, buffer) != IPDR_OK) {
+			free(buffer);
+			free(tmpXMLChar);
+			return (IPDR_MEMORY_ALLOCATION_FAILED);
+		}
 		
 		recCount = getLengthListAttributeDescriptor(
 			pXMLUnMarshallerCommon->pListAttributeDescriptor_);
@@ -474,8 +529,12 @@ if(len > 1) {
 			/*strcat(lTempAttributeName, " ");
 			strcat(lTempAttributeName,pXMLUnMarshallerCommon->attributeName_);*/
 
-			sprintf(lTempAttributeName, " %s", pXMLUnMarshallerCommon->attributeValue_);	
-			strcpy(pXMLUnMarshallerCommon->attributeValue_,lTempAttributeName);
+			if (setAttributeValue(pXMLUnMarshallerCommon, " ", 
+								  pXMLUnMarshallerCommon->attributeValue_) != IPDR_OK) {
+				free(buffer);
+				free(tmpXMLChar);
+				return (IPDR_MEMORY_ALLOCATION_FAILED);
+			}
 			lspaceFound = 0;	
 		}
 
@@ -530,28 +589,319 @@ if(len > 1) {
 	free(buffer);
 	free(tmpXMLChar);
 }
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      bufferText() - Collects the character data reported between
+ *                     two tags.
+ *
+ *  DESCRIPTION:
+ *		   Expat may report the text of an element in several pieces
+ *		   when it crosses a chunk boundary. The pieces are joined here
+ *		   and handed to attributeValueHandler() by flushText() when
+ *		   the next tag is seen.
+ *
+ *  ARGUMENTS:
+ *       -	data {IN}
+ *       -  text {IN}
+ *		 -  len {IN}
+ *
+ *  RETURNS
+ *	     Returns void
+ *
+ */
+
+static void bufferText(void *data, const char *text, int len)
+{
+	XMLStreamReader* pXMLStreamReader = (XMLStreamReader*) data;
+	char* pText = NULL;
+	int capacity = 0;
+
+	if (pXMLStreamReader->textLength_ + len + 1 > pXMLStreamReader->textCapacity_) {
+		capacity = pXMLStreamReader->textCapacity_ * 2;
+		while (capacity < pXMLStreamReader->textLength_ + len + 1)
+			capacity = capacity * 2;
+		pText = (char *) realloc(pXMLStreamReader->pText_, capacity);
+		if (pText == NULL) {
+			XML_StopParser(pXMLStreamReader->xmlParser_, XML_FALSE);
+			return;
+		}
+		pXMLStreamReader->pText_ = pText;
+		pXMLStreamReader->textCapacity_ = capacity;
+	}
+
+	memcpy(pXMLStreamReader->pText_ + pXMLStreamReader->textLength_, text, len);
+	pXMLStreamReader->textLength_ += len;
+}
+
+
+/*!
+ *  NAME:
+ *      flushText() - Hands the collected character data to
+ *                    attributeValueHandler().
+ *
+ *  DESCRIPTION:
+ *		   Every line break is passed as a piece of its own, the way
+ *		   expat reports it for text held in a single buffer. The
+ *		   parse is stopped if a value cannot be stored.
+ *
+ *  ARGUMENTS:
+ *       -	pXMLStreamReader {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns void
+ *
+ */
+
+static void flushText(XMLStreamReader* pXMLStreamReader)
+{
+	int count = 0;
+	int first = 0;
+	int status = IPDR_OK;
+	char* pText = pXMLStreamReader->pText_;
+
+	if (pXMLStreamReader->textLength_ == 0)
+		return;
+
+	pText[pXMLStreamReader->textLength_] = '\0';
+
+	for (count = 0; count < pXMLStreamReader->textLength_ && status == IPDR_OK; count++) {
+		if (pText[count] != '\n')
+			continue;
+		if (count > first)
+			status = attributeValueHandler(pXMLStreamReader->pXMLUnMarshallerCommon_,
+										   pText + first, count - first);
+		if (status == IPDR_OK)
+			status = attributeValueHandler(pXMLStreamReader->pXMLUnMarshallerCommon_,
+										   pText + count, 1);
+		first = count + 1;
+	}
+	if (status == IPDR_OK && pXMLStreamReader->textLength_ > first)
+		status = attributeValueHandler(pXMLStreamReader->pXMLUnMarshallerCommon_,
+									   pText + first, pXMLStreamReader->textLength_ - first);
+
+	pXMLStreamReader->textLength_ = 0;
+	if (status != IPDR_OK)
+		XML_StopParser(pXMLStreamReader->xmlParser_, XML_FALSE);
+}
+
+
+/*!
+ *  NAME:
+ *      streamStart() - Start handler of the pull parser.
+ *
+ *  DESCRIPTION:
+ *		   Calls start() and suspends the parse once the IPDRDoc
+ *		   start tag, which carries the header, has been read.
+ *
+ *  ARGUMENTS:
+ *       -	data {IN}
+ *       -  name {IN}
+ *       -  attr {IN}
+ *
+ *  RETURNS
+ *	     Returns void
+ *
+ */
+
+static void streamStart(void *data, const char *name, const char **attr)
+{
+	XMLStreamReader* pXMLStreamReader = (XMLStreamReader*) data;
+
+	flushText(pXMLStreamReader);
+	start(pXMLStreamReader->pXMLUnMarshallerCommon_, name, attr);
+
+	if (!strcmp(name, "IPDRDoc"))
+		XML_StopParser(pXMLStreamReader->xmlParser_, XML_TRUE);
+}
+
+
+/*!
+ *  NAME:
+ *      streamEnd() - End handler of the pull parser.
+ *
+ *  DESCRIPTION:
+ *		   Calls end() and suspends the parse after every IPDR
+ *		   element, leaving one record in pListFNFData_.
+ *
+ *  ARGUMENTS:
+ *       -	data {IN}
+ *       -  name {IN}
+ *
+ *  RETURNS
+ *	     Returns void
+ *
+ */
+
+static void streamEnd(void *data, const char *name)
+{
+	XMLStreamReader* pXMLStreamReader = (XMLStreamReader*) data;
+
+	flushText(pXMLStreamReader);
+	end(pXMLStreamReader->pXMLUnMarshallerCommon_, name);
+
+	if (!strcmp(name, "IPDR"))
+		XML_StopParser(pXMLStreamReader->xmlParser_, XML_TRUE);
+}
+
+
+/*!
+ *  NAME:
+ *      runXMLStreamReader() - Runs the parser to its next stop.
+ *
+ *  DESCRIPTION:
+ *		   Resumes a suspended parse, or feeds the next chunk of the
+ *		   stream, until the parser suspends itself or the whole
+ *		   document has been parsed.
+ *
+ *  ARGUMENTS:
+ *       -	pXMLStreamReader {IN/OUT}
+ *       -  fp {IN}
+ *		 -  pErrorCode {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+ *
+ */
+
+static int runXMLStreamReader(
+			   XMLStreamReader* pXMLStreamReader,
+			   FILE* fp,
+			   int* pErrorCode
+			  )
+{
+	int len = 0;
+	char* pChunk = pXMLStreamReader->pXMLUnMarshallerCommon_->Buff_;
+	enum XML_Status status;
+
+	while (!pXMLStreamReader->finished_) {
+		if (pXMLStreamReader->suspended_) {
+			pXMLStreamReader->suspended_ = IPDR_FALSE;
+			status = XML_ResumeParser(pXMLStreamReader->xmlParser_);
+		}
+		else {
+			len = fread(pChunk, 1, IPDR_XML_READ_CHUNK, fp);
+			if (ferror(fp)) {
+				*pErrorCode = IPDR_XML_INPUT_FILE_INVALID;
+				return (IPDR_ERROR);
+			}
+			pXMLStreamReader->lastChunk_ = feof(fp) ? IPDR_TRUE : IPDR_FALSE;
+			status = XML_Parse(pXMLStreamReader->xmlParser_, pChunk, len,
+							   pXMLStreamReader->lastChunk_);
+		}
+
+		if (status == XML_STATUS_ERROR) {
+			*pErrorCode = XML_GetErrorCode(pXMLStreamReader->xmlParser_) + EXPAT_ERROR_CODE;
+			return (IPDR_ERROR);
+		}
+		if (status == XML_STATUS_SUSPENDED) {
+			pXMLStreamReader->suspended_ = IPDR_TRUE;
+			return (IPDR_OK);
+		}
+		if (pXMLStreamReader->lastChunk_) {
+			flushText(pXMLStreamReader);
+			pXMLStreamReader->finished_ = IPDR_TRUE;
+		}
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      moveXMLStreamRecords() - Hands the parsed records over to
+ *                               IPDRCommonParameters.
+ *
+ *  DESCRIPTION:
+ *		   The records are linked to the tail of pListFNFData_ of
+ *		   IPDRCommonParameters without being copied.
+ *
+ *  ARGUMENTS:
+ *       -	IPDRCommonParameters (IN/OUT)
+ *       -  pXMLUnMarshallerCommon {IN/OUT}
+ *
+ *  RETURNS
+ *	     Returns void
+ *
+ */
+
+static void moveXMLStreamRecords(
+			   IPDRCommonParameters *pIPDRCommonParameters,
+			   XMLUnMarshallerCommon* pXMLUnMarshallerCommon
+			  )
+{
+	ListFNFData* pTail = NULL;
+
+	if (pXMLUnMarshallerCommon->pListFNFData_ == NULL)
+		return;
+
+	if (pIPDRCommonParameters->pListFNFData_ == NULL) {
+		pIPDRCommonParameters->pListFNFData_ = pXMLUnMarshallerCommon->pListFNFData_;
+	}
+	else {
+		pTail = pIPDRCommonParameters->pListFNFData_;
+		while (pTail->pNext_ != NULL)
+			pTail = pTail->pNext_;
+		pTail->pNext_ = pXMLUnMarshallerCommon->pListFNFData_;
+	}
+	pXMLUnMarshallerCommon->pListFNFData_ = NULL;
+}
+
+
+/*!
+ *  NAME:
+ *      endXMLStreamData() - Completes the read of an XML document.
+ *
+ *  DESCRIPTION:
+ *		   Copies the DocEnd values into IPDRCommonParameters and
+ *		   releases the parser.
+ *
+ *  ARGUMENTS:
+ *       -	IPDRCommonParameters (IN/OUT)
+ *
+ *  RETURNS
+ *	     Returns void
+ *
+ */
+
+static void endXMLStreamData(IPDRCommonParameters *pIPDRCommonParameters)
+{
+	XMLStreamReader* pXMLStreamReader = pIPDRCommonParameters->pXMLStreamReader_;
+
+	pIPDRCommonParameters->pDocEnd_->count_  =
+		pXMLStreamReader->pXMLUnMarshallerCommon_->pGDocEnd_->count_;
+	pIPDRCommonParameters->pDocEnd_->endTime_ =
+		pXMLStreamReader->pXMLUnMarshallerCommon_->pGDocEnd_->endTime_;
+
+	freeXMLStreamReader(pXMLStreamReader);
+	pIPDRCommonParameters->pXMLStreamReader_ = NULL;
 }
 
 
 /*!
  *  NAME:
  *      readXMLStreamData() - 	This function reads the IPDR XML Doc 
+ *							 	header
  *
  *  DESCRIPTION:
  *     	This function
+ *          -  Opens a pull parser over the stream and parses up to the
+ *			   end of the IPDRDoc start tag.
  *          -  Reads & Validates the Version. It should not be off
  *			-  Reads ipdrRecoderInfo
  *			-  Reads startTime
  *			-  Reads defaultNameSpaceURI
- *			-  Reads the Length for otherNameSpaces
  *			-  Reads otherNameSpaces
- *			-  Reads the Length for serviceDefinitionURI
  *			-  Reads serviceDefinitionURI
- *			-  Reads the length for docId
  *			-  Reads docId
  *			-  Populates the IPDRHeader structure with the above read values.
- *			-  Populates ListFNFData
- *			-  Populates Doc End Structure.
+ *
+ *		The records and the Doc End are read afterwards by
+ *		readXMLStreamRecord().
  *
  *	ARGUMENTS:
  *        -  IPDRCommonParameters (IN/OUT)
@@ -569,39 +919,14 @@ int readXMLStreamData(
 {
 
   FILE *fp;
-  char tmpNameSpaceID[MAX_NAMESPACE_URI] = "";
   int count = 0;
-  int tempLength = 0;
-  int errorSeverity = 0;
   unsigned int lenDocId = 0;
   unsigned int lenIPDRRecorderInfo = 0;
-  unsigned int xmlFileLength = 0;
   ListServiceDefinitionURI* pCurrentListServiceDefURI = NULL;
-  ListFNFData* pCurrentListFNFData = NULL;
-  ListFNFData* pIPDRCommonParametersCurrent = NULL;
   ListNameSpaceInfo* pCurrentNameSpaceInfo = NULL;
-  ListAttributeDescriptor* pCurrent = NULL;
-  XML_Parser xmlParser = XML_ParserCreate(NULL);
+  XMLStreamReader* pXMLStreamReader = NULL;
   XMLUnMarshallerCommon* pXMLUnMarshallerCommon = NULL;
-
-  void* userData = NULL;
-
-	/*Added this line to populate the gVersion from IPDRCommonParameters*/
-   strcpy(gVersion, pIPDRCommonParameters->schemaVersion);
-
-  pXMLUnMarshallerCommon = (XMLUnMarshallerCommon *) malloc (sizeof(XMLUnMarshallerCommon));
-
-  initXMLUnMarshallerCommon(pIPDRCommonParameters, pXMLUnMarshallerCommon);
-  xmlFileLength = getFileLength(pIPDRCommonParameters->pStreamName_);
-
-  if (! xmlParser) {
-	*pErrorCode = IPDR_XML_PARSER_MEMORY_ALLOC_FAILED;
-    return (IPDR_ERROR);
-  }
-
-  XML_SetElementHandler(xmlParser, start, end);
-
-  XML_SetCharacterDataHandler(xmlParser, attributeValueHandler);
+  char* pTokenContext = NULL;
 
   fp = pIPDRCommonParameters->pStreamHandle_;
 
@@ -610,38 +935,45 @@ int readXMLStreamData(
 	  return (IPDR_ERROR);
   }
 
- userData = (XMLUnMarshallerCommon *) pXMLUnMarshallerCommon;
+  freeXMLStreamReader(pIPDRCommonParameters->pXMLStreamReader_);
+  pIPDRCommonParameters->pXMLStreamReader_ = NULL;
 
- XML_SetUserData(xmlParser, userData);
+  pXMLStreamReader = (XMLStreamReader *) calloc (1, sizeof(XMLStreamReader));
+  if (pXMLStreamReader == NULL) {
+	*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+	return (IPDR_ERROR);
+  }
+  pIPDRCommonParameters->pXMLStreamReader_ = pXMLStreamReader;
 
+  pXMLUnMarshallerCommon = (XMLUnMarshallerCommon *) calloc (1, sizeof(XMLUnMarshallerCommon));
+  pXMLStreamReader->pXMLUnMarshallerCommon_ = pXMLUnMarshallerCommon;
+  pXMLStreamReader->textCapacity_ = MAX_IPDR_STRING;
+  pXMLStreamReader->pText_ = (char *) calloc (MAX_IPDR_STRING, sizeof(char));
+  pXMLStreamReader->xmlParser_ = XML_ParserCreate(NULL);
 
-  for (;;) {
-    int done;
-    int len;
+  if (pXMLUnMarshallerCommon == NULL || pXMLStreamReader->pText_ == NULL) {
+	*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+	return (IPDR_ERROR);
+  }
 
-	len = fread(pXMLUnMarshallerCommon->Buff_, 1, xmlFileLength, fp);
+  initXMLUnMarshallerCommon(pIPDRCommonParameters, pXMLUnMarshallerCommon);
 
-    if (ferror(fp)) {
-	 *pErrorCode = IPDR_XML_INPUT_FILE_INVALID;
-      return (IPDR_ERROR);
-    }
+  if (!pXMLStreamReader->xmlParser_ || pXMLUnMarshallerCommon->Buff_ == NULL) {
+	*pErrorCode = IPDR_XML_PARSER_MEMORY_ALLOC_FAILED;
+    return (IPDR_ERROR);
+  }
 
-    done = feof(fp);
+  XML_SetElementHandler(pXMLStreamReader->xmlParser_, streamStart, streamEnd);
 
-    if (!XML_Parse(xmlParser, pXMLUnMarshallerCommon->Buff_, len, done)) {
-	 /*
-	 *pErrorCode = IPDR_XML_PARSER_READ_ERROR;
-	 */
-	 *pErrorCode = XML_GetErrorCode(xmlParser) + EXPAT_ERROR_CODE;
-		
-      return (IPDR_ERROR);
-    }
+  XML_SetCharacterDataHandler(pXMLStreamReader->xmlParser_, bufferText);
+
+  XML_SetUserData(pXMLStreamReader->xmlParser_, pXMLStreamReader);
+
+  if (runXMLStreamReader(pXMLStreamReader, fp, pErrorCode) == IPDR_ERROR)
+	  return (IPDR_ERROR);
 
-    if (done)
-      break;
-  }
   if(strcmp(pXMLUnMarshallerCommon->schemaLocation_, "") != 0) {	
-	  pXMLUnMarshallerCommon->token_ = strtok(pXMLUnMarshallerCommon->schemaLocation_," ");
+	  pXMLUnMarshallerCommon->token_ = strtok_r(pXMLUnMarshallerCommon->schemaLocation_," ", &pTokenContext);
 
 	  for(count=1; pXMLUnMarshallerCommon->token_ != NULL; count++ )  {
       
@@ -652,7 +984,7 @@ int readXMLStreamData(
 			  appendListSchemaNameSpace(&pIPDRHeader->pListSchemaNameSpace_,
 										 pXMLUnMarshallerCommon->token_);
 		  }
-		  pXMLUnMarshallerCommon->token_ = strtok( NULL, " ");
+		  pXMLUnMarshallerCommon->token_ = strtok_r( NULL, " ", &pTokenContext );
 	  }
   }
  if (pXMLUnMarshallerCommon->pGIPDRHeader_->pOtherNameSpaceInfo_ != NULL) 	{
@@ -682,22 +1014,19 @@ int readXMLStreamData(
 	}
 
   strcpy(pIPDRHeader->ipdrRecorderInfo_, pXMLUnMarshallerCommon->pGIPDRHeader_->ipdrRecorderInfo_);
-  free(pXMLUnMarshallerCommon->pGIPDRHeader_->ipdrRecorderInfo_);
 
+  if(pXMLUnMarshallerCommon->pGIPDRHeader_->docID_ == NULL) {
+		*pErrorCode = IPDR_XML_NULL_DOCID;
+		return (IPDR_ERROR);
+  }
   lenDocId = strlen(pXMLUnMarshallerCommon->pGIPDRHeader_->docID_) + 1;
   pIPDRHeader->docID_ = (char *) calloc (lenDocId, sizeof(char));
   if(pIPDRHeader->docID_ == NULL) {
 		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
 		return(IPDR_ERROR);
   }
-  if(pXMLUnMarshallerCommon->pGIPDRHeader_->docID_ == NULL) {
-		*pErrorCode = IPDR_XML_NULL_DOCID;
-		return (IPDR_ERROR);
-  }
   strcpy(pIPDRHeader->docID_, pXMLUnMarshallerCommon->pGIPDRHeader_->docID_);
 
-  free(pXMLUnMarshallerCommon->pGIPDRHeader_->docID_);
-
   strcpy(pIPDRHeader->defaultNameSpaceURI_, pXMLUnMarshallerCommon->pGIPDRHeader_->defaultNameSpaceURI_);
 
   pCurrentListServiceDefURI = pXMLUnMarshallerCommon->pGIPDRHeader_->pListServiceDefinitionURI_;
@@ -710,61 +1039,165 @@ int readXMLStreamData(
   }
   pXMLUnMarshallerCommon->pGIPDRHeader_->pListServiceDefinitionURI_= pCurrentListServiceDefURI;
 
- /* Populating List FNFData*/
-  
-  pCurrentListFNFData= pXMLUnMarshallerCommon->pListFNFData_;
-  while(pXMLUnMarshallerCommon->pListFNFData_ != NULL) {
-	  	appendListFNFData(&pIPDRCommonParameters->pListFNFData_,
-		                 pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->typeName_,
-						 pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->pListAttributeDescriptor_,
-						 pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->pListIPDRData_
-					);
-
-		pCurrent = pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->pListServiceAttributeDescriptor_;
-		pIPDRCommonParametersCurrent = pIPDRCommonParameters->pListFNFData_;
-		while(pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->pListServiceAttributeDescriptor_ != NULL) {
-			while(pIPDRCommonParameters->pListFNFData_->pNext_ != NULL) {
-				pIPDRCommonParameters->pListFNFData_ = pIPDRCommonParameters->pListFNFData_->pNext_;
-			}
-
-			appendListAttributeDescriptor(&(pIPDRCommonParameters->pListFNFData_->pXMLFNFData_->pListServiceAttributeDescriptor_),
-										pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->attributeName_,
-										pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->attributeType_,
-										pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->description_,
-										pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->derivedType_, 
-										pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->complexType_, 
-										pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->pListAttrNameList_,
-										pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->pListAttrClassList_, 
-										pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->pListAttrMaxOccursList_, 
-										pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->pListServiceAttributeDescriptor_->pAttributeDescriptor_->noOfElements_); 
-	
-		pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->pListServiceAttributeDescriptor_ = pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->pListServiceAttributeDescriptor_->pNext_; 
-
-		}
-		pXMLUnMarshallerCommon->pListFNFData_->pXMLFNFData_->pListServiceAttributeDescriptor_ = pCurrent;
-		freeHeadListFNFData(&pXMLUnMarshallerCommon->pListFNFData_);
+  if (pXMLStreamReader->finished_) {
+	  moveXMLStreamRecords(pIPDRCommonParameters, pXMLUnMarshallerCommon);
+	  endXMLStreamData(pIPDRCommonParameters);
   }
-  pXMLUnMarshallerCommon->pListFNFData_ = pCurrentListFNFData;
-  pIPDRCommonParameters->pListFNFData_ = pIPDRCommonParametersCurrent;
-
-  	/* For Doc End */	
-  pIPDRCommonParameters->pDocEnd_->count_  = pXMLUnMarshallerCommon->pGDocEnd_->count_;
-  pIPDRCommonParameters->pDocEnd_->endTime_ = pXMLUnMarshallerCommon->pGDocEnd_->endTime_;
-
-  free(pXMLUnMarshallerCommon->pGIPDRHeader_->defaultNameSpaceURI_);
-  freeListServiceDefinitionURI(&(pXMLUnMarshallerCommon->pGIPDRHeader_->pListServiceDefinitionURI_));
-  freeListNameSpaceInfo(&pXMLUnMarshallerCommon->pGIPDRHeader_->pOtherNameSpaceInfo_);
-  free(pXMLUnMarshallerCommon->pGIPDRHeader_);
-  freeDocEnd(pXMLUnMarshallerCommon->pGDocEnd_);
-
-  
-  freeXMLUnMarshallerCommon(pXMLUnMarshallerCommon);
-  
+
   return (IPDR_OK);
 
 }  
 
 
+/*!
+ *  NAME:
+ *      readXMLStreamRecord() - Reads the next record of the XML Doc 
+ *
+ *  DESCRIPTION:
+ *     	This function
+ *          -  Resumes the parse opened by readXMLStreamData() until the
+ *			   next IPDR element has been read.
+ *			-  Links the record to pListFNFData_ of IPDRCommonParameters.
+ *			-  Populates the Doc End structure and releases the parser
+ *			   once the end of the document is reached.
+ *
+ *		Nothing is read while pListFNFData_ still holds a record.
+ *
+ *	ARGUMENTS:
+ *        -  IPDRCommonParameters (IN/OUT)
+ *		  -	 pErrorCode	(IN/OUT)
+ *
+ *  RETURNS
+ *	      Returns Zero or appropriate error code
+*/
+int readXMLStreamRecord(
+			   IPDRCommonParameters *pIPDRCommonParameters,
+			   int* pErrorCode
+			  )
+{
+	XMLStreamReader* pXMLStreamReader = NULL;
+
+	while (pIPDRCommonParameters->pListFNFData_ == NULL &&
+		   pIPDRCommonParameters->pXMLStreamReader_ != NULL) {
+		pXMLStreamReader = pIPDRCommonParameters->pXMLStreamReader_;
+
+		if (runXMLStreamReader(pXMLStreamReader,
+							   pIPDRCommonParameters->pStreamHandle_,
+							   pErrorCode) == IPDR_ERROR)
+			return (IPDR_ERROR);
+
+		moveXMLStreamRecords(pIPDRCommonParameters,
+							 pXMLStreamReader->pXMLUnMarshallerCommon_);
+
+		if (pXMLStreamReader->finished_)
+			endXMLStreamData(pIPDRCommonParameters);
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      closeXMLStreamData() - Reads the XML Doc up to its end 
+ *
+ *  DESCRIPTION:
+ *     	Parses the rest of the document so that the Doc End structure
+ *		can be populated. The records not read so far are discarded.
+ *
+ *	ARGUMENTS:
+ *        -  IPDRCommonParameters (IN/OUT)
+ *		  -	 pErrorCode	(IN/OUT)
+ *
+ *  RETURNS
+ *	      Returns Zero or appropriate error code
+*/
+int closeXMLStreamData(
+			   IPDRCommonParameters *pIPDRCommonParameters,
+			   int* pErrorCode
+			  )
+{
+	XMLStreamReader* pXMLStreamReader = NULL;
+
+	while (pIPDRCommonParameters->pXMLStreamReader_ != NULL) {
+		pXMLStreamReader = pIPDRCommonParameters->pXMLStreamReader_;
+
+		if (runXMLStreamReader(pXMLStreamReader,
+							   pIPDRCommonParameters->pStreamHandle_,
+							   pErrorCode) == IPDR_ERROR)
+			return (IPDR_ERROR);
+
+		if (pXMLStreamReader->pXMLUnMarshallerCommon_->pListFNFData_ != NULL)
+			freeListFNFData(&pXMLStreamReader->pXMLUnMarshallerCommon_->pListFNFData_);
+
+		if (pXMLStreamReader->finished_)
+			endXMLStreamData(pIPDRCommonParameters);
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*!
+ *  NAME:
+ *      freeXMLStreamReader() - memory deallocation of
+ *							XMLStreamReader structure.
+ *
+ *  DESCRIPTION:
+ *      1. This function releases the parser, the header & Doc End
+ *         read so far, the records not handed over yet and the
+ *         XMLUnMarshallerCommon structure.
+ *
+ *  ARGUMENTS:
+ *
+ *		 -  pXMLStreamReader (IN/OUT)
+ *
+ *  RETURNS
+ *	     Returns Zero or appropriate error code
+ */
+
+int freeXMLStreamReader(XMLStreamReader* pXMLStreamReader)
+{
+	XMLUnMarshallerCommon* pXMLUnMarshallerCommon = NULL;
+
+	if (pXMLStreamReader == NULL) {
+		return (IPDR_NULL_INPUT_PARAMETER);
+	}
+
+	if (pXMLStreamReader->xmlParser_ != NULL)
+		XML_ParserFree(pXMLStreamReader->xmlParser_);
+
+	pXMLUnMarshallerCommon = pXMLStreamReader->pXMLUnMarshallerCommon_;
+	if (pXMLUnMarshallerCommon != NULL && pXMLUnMarshallerCommon->pGIPDRHeader_ != NULL) {
+		free(pXMLUnMarshallerCommon->pGIPDRHeader_->ipdrRecorderInfo_);
+		free(pXMLUnMarshallerCommon->pGIPDRHeader_->docID_);
+		free(pXMLUnMarshallerCommon->pGIPDRHeader_->defaultNameSpaceURI_);
+		freeListServiceDefinitionURI(&(pXMLUnMarshallerCommon->pGIPDRHeader_->pListServiceDefinitionURI_));
+		freeListNameSpaceInfo(&pXMLUnMarshallerCommon->pGIPDRHeader_->pOtherNameSpaceInfo_);
+		free(pXMLUnMarshallerCommon->pGIPDRHeader_);
+		freeDocEnd(pXMLUnMarshallerCommon->pGDocEnd_);
+
+		if (pXMLUnMarshallerCommon->pListFNFData_ != NULL)
+			freeListFNFData(&pXMLUnMarshallerCommon->pListFNFData_);
+		freeListIPDRData(&(pXMLUnMarshallerCommon->pListIPDRData_));
+		freeListAttributeDescriptor(&(pXMLUnMarshallerCommon->pListAttributeDescriptor_));
+		freeListAttributeDescriptor(&(pXMLUnMarshallerCommon->pListServiceAttributeDescriptor_));
+		freeList(&(pXMLUnMarshallerCommon->pAttrNameList_));
+		freeList(&(pXMLUnMarshallerCommon->pAttrNameList2_));
+
+		freeXMLUnMarshallerCommon(pXMLUnMarshallerCommon);
+	}
+	else {
+		free(pXMLUnMarshallerCommon);
+	}
+
+	free(pXMLStreamReader->pText_);
+	free(pXMLStreamReader);
+
+	return (IPDR_OK);
+}
+
+
 /*!
  *  NAME:
  *      isNameSpaceInfo() - Checks wheather the given XML string
@@ -820,18 +1253,16 @@ int initXMLUnMarshallerCommon(
 							  XMLUnMarshallerCommon* pXMLUnMarshallerCommon
 							 )
 {
-	unsigned int xmlFileLength = 0;	
-
 if (pXMLUnMarshallerCommon == NULL) {
 		return (IPDR_NULL_INPUT_PARAMETER);
 	}
-	xmlFileLength = getFileLength(pIPDRCommonParameters->pStreamName_) + 1;
-	pXMLUnMarshallerCommon->Buff_ = (char*) calloc (xmlFileLength, sizeof(char));
+	pXMLUnMarshallerCommon->Buff_ = (char*) calloc (IPDR_XML_READ_CHUNK, sizeof(char));
 
 	pXMLUnMarshallerCommon->serviceType_ = (char*) calloc (MAX_IPDR_STRING, sizeof(char));
 	pXMLUnMarshallerCommon->schemaLocation_ = (char*) calloc (IPDR_XML_MAX_SCHEMA_LOCATION, sizeof(char));
 	pXMLUnMarshallerCommon->attributeName_ = (char*) calloc (MAX_ATTRIBUTE_NAME, sizeof(char));
 	pXMLUnMarshallerCommon->attributeValue_ =  (char*) calloc (MAX_IPDR_STRING, sizeof(char));
+	pXMLUnMarshallerCommon->attributeValueCapacity_ = MAX_IPDR_STRING;
 	pXMLUnMarshallerCommon->OldattributeName_ = (char*) calloc (MAX_ATTRIBUTE_NAME, sizeof(char));
 	pXMLUnMarshallerCommon->OldComplexattributeName_ = (char*) calloc (MAX_ATTRIBUTE_NAME, sizeof(char));
 	pXMLUnMarshallerCommon->Depth_ = 0;
@@ -850,6 +1281,7 @@ if (pXMLUnMarshallerCommon == NULL) {
 	pXMLUnMarshallerCommon->ComplexFlagValue_ = 0;
 	pXMLUnMarshallerCommon->ComplexFlagValue2_ = 0;
 	pXMLUnMarshallerCommon->EndFlagValue_ = 0;
+	strcpy(pXMLUnMarshallerCommon->version_, pIPDRCommonParameters->schemaVersion);
 
 	return (IPDR_OK);
 }
@@ -885,15 +1317,14 @@ int freeXMLUnMarshallerCommon(
     free(pXMLUnMarshallerCommon->serviceType_);
 		pXMLUnMarshallerCommon->serviceType_ = NULL;
 	
-	if (strcmp(pXMLUnMarshallerCommon->schemaLocation_, "" ) != 0) {
-		free(pXMLUnMarshallerCommon->schemaLocation_);
+	free(pXMLUnMarshallerCommon->schemaLocation_);
 		pXMLUnMarshallerCommon->schemaLocation_ = NULL;
-	}
 
 	free(pXMLUnMarshallerCommon->attributeName_);
 		pXMLUnMarshallerCommon->attributeName_ = NULL;
 	free(pXMLUnMarshallerCommon->attributeValue_);
 		pXMLUnMarshallerCommon->attributeValue_ = NULL;
+		pXMLUnMarshallerCommon->attributeValueCapacity_ = 0;
 	free(pXMLUnMarshallerCommon->OldattributeName_);
 		pXMLUnMarshallerCommon->OldattributeName_ = NULL;
 	free(pXMLUnMarshallerCommon->OldComplexattributeName_);
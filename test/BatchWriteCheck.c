@@ -0,0 +1,525 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : BatchWriteCheck            *
+ * Description          : Checks that records written*
+ *                        by writeIPDRBatch are those*
+ *                        of writeIPDR, and that a   *
+ *                        failed batch is neither    *
+ *                        written nor counted        *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils/IPDRCommon.h"
+#include "utils/IPDRMemory.h"
+#include "utils/errorCode.h"
+#include "common/IPDRDocReader.h"
+#include "common/IPDRDocWriter.h"
+#include "xdr/XDRInputBuffer.h"
+#include "xdr/XDROutputBuffer.h"
+#include "CheckUtil.h"
+
+#define BATCH_MAX_PATH				1024
+#define BATCH_MAX_RECORDS			64
+
+static const char* gDefaultDocuments[] = {
+	"testcase8/primitiveTypes.1.xdr",
+	"testcase1/testVOIP.1.xdr",
+	"data35/structure.xdr"
+};
+
+/* A document read, its records kept to be written again */
+typedef struct Document
+{
+	IPDRHeader* pIPDRHeader_;
+	char schemaVersion_[MAX_IPDR_STRING];
+	int noOfRecords_;
+	FNFData* pRecords_[BATCH_MAX_RECORDS];
+} Document;
+
+
+static void freeDocument(Document* pDocument)
+{
+	int count = 0;
+
+	for (count = 0; count < pDocument->noOfRecords_; count++)
+		freeFNFData(pDocument->pRecords_[count]);
+	pDocument->noOfRecords_ = 0;
+	freeIPDRHeader(pDocument->pIPDRHeader_);
+	pDocument->pIPDRHeader_ = NULL;
+}
+
+
+/*
+ * Reads the header and the records of a document into pDocument.
+ */
+static int readDocument(const char* fileName, Document* pDocument)
+{
+	int errorCode = 0;
+	int errorSeverity = IPDR_OK;
+	FILE* pInput = NULL;
+	IPDRCommonParameters* pReader = NULL;
+	FNFData* pFNFData = NULL;
+
+	pDocument->noOfRecords_ = 0;
+	pDocument->pIPDRHeader_ = newIPDRHeader();
+
+	pInput = fopen(fileName, "rb");
+	if (pInput == NULL || pDocument->pIPDRHeader_ == NULL) {
+		printf("%s: cannot open the document\n", fileName);
+		return (IPDR_ERROR);
+	}
+
+	pReader = newCheckParameters(XDR, NONREADABLE, "", pInput);
+	if (pReader == NULL ||
+		setXDRInputBuffer(pReader, XDR_INPUT_MMAP, &errorCode) == IPDR_ERROR ||
+		readHeader(pReader, pDocument->pIPDRHeader_, &errorCode) == IPDR_ERROR) {
+		printf("%s: cannot read the header, error %d\n", fileName, errorCode);
+		fclose(pInput);
+		return (IPDR_ERROR);
+	}
+	strcpy(pDocument->schemaVersion_, pReader->schemaVersion);
+
+	while (pDocument->noOfRecords_ < BATCH_MAX_RECORDS) {
+		pFNFData = newFNFData();
+		errorSeverity = readIPDR(pReader, &pFNFData, &errorCode);
+		if (errorSeverity == IPDR_ERROR || pFNFData == NULL) {
+			freeFNFData(pFNFData);
+			break;
+		}
+		/* The descriptor is resolved by the writer */
+		pFNFData->descriptorID_ = 0;
+		pDocument->pRecords_[pDocument->noOfRecords_++] = pFNFData;
+	}
+
+	pReader->pStreamHandle_ = NULL;
+	freeIPDRCommonParameters(pReader);
+	fclose(pInput);
+
+	if (pDocument->noOfRecords_ == 0) {
+		printf("%s: no records read, error %d\n", fileName, errorCode);
+		return (IPDR_ERROR);
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*
+ * Returns a writer of pDocument to pOutput, its header written.
+ */
+static IPDRCommonParameters* startCopy(const Document* pDocument,
+									   ListSchemaNameSpace** ppListSchemaNameSpace,
+									   FILE* pOutput, int* pErrorCode)
+{
+	IPDRHeader* pIPDRHeader = pDocument->pIPDRHeader_;
+	IPDRCommonParameters* pWriter = NULL;
+	ListNameSpaceInfo* pNameSpaceInfo = NULL;
+
+	pWriter = newCheckParameters(XDR, NONWRITABLE, pDocument->schemaVersion_, pOutput);
+	if (pWriter == NULL)
+		return (NULL);
+
+	for (pNameSpaceInfo = pIPDRHeader->pOtherNameSpaceInfo_; pNameSpaceInfo != NULL;
+		 pNameSpaceInfo = pNameSpaceInfo->pNext_)
+		appendListSchemaNameSpace(ppListSchemaNameSpace,
+								  pNameSpaceInfo->NameSpaceInfo_.nameSpaceURI_);
+	if (writeHeader(pWriter, pIPDRHeader->startTime_, pIPDRHeader->ipdrRecorderInfo_,
+					pIPDRHeader->defaultNameSpaceURI_, pIPDRHeader->pOtherNameSpaceInfo_,
+					pIPDRHeader->pListServiceDefinitionURI_, pIPDRHeader->docID_,
+					*ppListSchemaNameSpace, pErrorCode) == IPDR_ERROR) {
+		pWriter->pStreamHandle_ = NULL;
+		freeIPDRCommonParameters(pWriter);
+		return (NULL);
+	}
+
+	return (pWriter);
+}
+
+
+static void endCopy(IPDRCommonParameters* pWriter, ListSchemaNameSpace** ppListSchemaNameSpace)
+{
+	if (pWriter != NULL) {
+		pWriter->pStreamHandle_ = NULL;
+		freeIPDRCommonParameters(pWriter);
+	}
+	freeListSchemaNameSpace(ppListSchemaNameSpace);
+}
+
+
+static int hasStructures(const FNFData* pFNFData)
+{
+	const ListIPDRData* pValue = NULL;
+
+	for (pValue = pFNFData->pListIPDRData_; pValue != NULL; pValue = pValue->pNext_)
+		if ((unsigned int) pValue->IPDRDataType_ == IPDRDATA_STRUCTURE)
+			return (IPDR_TRUE);
+
+	return (IPDR_FALSE);
+}
+
+
+/*
+ * Sets the descriptor of every second record of a batch with
+ * resolveDescriptor(), as createFNFData() would; only types written
+ * before the batch are resolved, so that no descriptor is moved.
+ */
+static int preResolve(IPDRCommonParameters* pWriter, FNFData** ppRecords,
+					  int noOfWritten, int noOfRecords, int* pErrorCode)
+{
+	int count = 0;
+	int cnt = 0;
+	int descriptorCount = 0;
+	FNFType fnfType;
+
+	for (count = 0; count < noOfRecords; count += 2) {
+		for (cnt = 0; cnt < noOfWritten; cnt++)
+			if (strcmp((ppRecords - noOfWritten)[cnt]->typeName_, ppRecords[count]->typeName_) == 0)
+				break;
+		if (cnt == noOfWritten)
+			continue;
+
+		memset(&fnfType, 0, sizeof(fnfType));
+		fnfType.serviceType_ = ppRecords[count]->typeName_;
+		fnfType.pListAttributeDescriptor_ = ppRecords[count]->pListAttributeDescriptor_;
+		fnfType.pListServiceAttributeDescriptor_ = ppRecords[count]->pListServiceAttributeDescriptor_;
+
+		descriptorCount = pWriter->descriptorCount_;
+		if (resolveDescriptor(pWriter, &fnfType, pErrorCode) == IPDR_ERROR)
+			return (IPDR_ERROR);
+		if (pWriter->descriptorCount_ != descriptorCount || fnfType.descriptorID_ == 0) {
+			printf("record %d: type %s was not resolved to a written descriptor\n",
+				   noOfWritten + count + 1, fnfType.serviceType_);
+			return (IPDR_ERROR);
+		}
+		ppRecords[count]->descriptorID_ = fnfType.descriptorID_;
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*
+ * Writes the records of pDocument to pOutput, one by one with
+ * writeIPDR() or in two batches with writeIPDRBatch(). The records of
+ * the first batch have no descriptor; in the second, every second
+ * record of a type written already has its descriptor resolved.
+ */
+static int writeCopy(const char* fileName, Document* pDocument, int useBatch,
+					 FILE* pOutput, int* pNoOfStructures)
+{
+	int count = 0;
+	int half = 0;
+	int errorCode = 0;
+	int errorSeverity = IPDR_OK;
+	IPDRCommonParameters* pWriter = NULL;
+	ListSchemaNameSpace* pListSchemaNameSpace = NULL;
+
+	pWriter = startCopy(pDocument, &pListSchemaNameSpace, pOutput, &errorCode);
+	if (pWriter == NULL) {
+		printf("%s: writeHeader failed, error %d\n", fileName, errorCode);
+		freeListSchemaNameSpace(&pListSchemaNameSpace);
+		return (IPDR_ERROR);
+	}
+
+	for (count = 0; count < pDocument->noOfRecords_; count++)
+		pDocument->pRecords_[count]->descriptorID_ = 0;
+
+	if (useBatch == IPDR_FALSE) {
+		for (count = 0; count < pDocument->noOfRecords_ && errorSeverity != IPDR_ERROR; count++)
+			errorSeverity = writeIPDR(pWriter, pDocument->pRecords_[count], &errorCode);
+	} else {
+		half = (pDocument->noOfRecords_ + 1) / 2;
+		errorSeverity = writeIPDRBatch(pWriter, pDocument->pRecords_, half, &errorCode);
+		if (errorSeverity != IPDR_ERROR)
+			errorSeverity = preResolve(pWriter, pDocument->pRecords_ + half, half,
+									   pDocument->noOfRecords_ - half, &errorCode);
+		if (errorSeverity != IPDR_ERROR)
+			errorSeverity = writeIPDRBatch(pWriter, pDocument->pRecords_ + half,
+										   pDocument->noOfRecords_ - half, &errorCode);
+
+		for (count = 0; count < pDocument->noOfRecords_; count++)
+			if (hasStructures(pDocument->pRecords_[count]) == IPDR_TRUE)
+				(*pNoOfStructures)++;
+	}
+
+	if (errorSeverity != IPDR_ERROR &&
+		pWriter->IPDRCount_.ipdrRecordCount_ != pDocument->noOfRecords_ + 1) {
+		printf("%s: %d records counted, %d written\n", fileName,
+			   pWriter->IPDRCount_.ipdrRecordCount_ - 1, pDocument->noOfRecords_);
+		errorSeverity = IPDR_ERROR;
+	}
+
+	if (errorSeverity != IPDR_ERROR)
+		errorSeverity = writeDocEnd(pWriter, &errorCode);
+	if (errorSeverity == IPDR_ERROR)
+		printf("%s: copy %s failed, error %d\n", fileName,
+			   useBatch ? "with writeIPDRBatch" : "with writeIPDR", errorCode);
+
+	fflush(pOutput);
+	endCopy(pWriter, &pListSchemaNameSpace);
+	return (errorSeverity);
+}
+
+
+/*
+ * Copies a document with writeIPDR() and with writeIPDRBatch() and
+ * compares the copies.
+ */
+static int checkDocument(const char* fileName, Document* pDocument, int* pNoOfStructures)
+{
+	int failures = 0;
+	int useBatch = 0;
+	long length[2];
+	char* pBytes[2] = { NULL, NULL };
+	FILE* pCopy = NULL;
+
+	for (useBatch = IPDR_FALSE; useBatch <= IPDR_TRUE; useBatch++) {
+		pCopy = tmpfile();
+		if (pCopy == NULL) {
+			printf("%s: cannot open a copy\n", fileName);
+			return (1);
+		}
+		if (writeCopy(fileName, pDocument, useBatch, pCopy, pNoOfStructures) == IPDR_ERROR)
+			failures++;
+		else
+			pBytes[useBatch] = readCopy(pCopy, &length[useBatch]);
+		fclose(pCopy);
+	}
+
+	if (pBytes[IPDR_TRUE] == NULL || pBytes[IPDR_FALSE] == NULL) {
+		printf("%s: no copy to compare\n", fileName);
+		failures++;
+	} else if (length[IPDR_TRUE] != length[IPDR_FALSE] ||
+			   memcmp(pBytes[IPDR_TRUE], pBytes[IPDR_FALSE], length[IPDR_TRUE]) != 0) {
+		printf("%s: the copy written with writeIPDRBatch differs\n", fileName);
+		failures++;
+	}
+
+	free(pBytes[IPDR_FALSE]);
+	free(pBytes[IPDR_TRUE]);
+	return (failures);
+}
+
+
+/*
+ * Writes the header and the first record of pDocument to pOutput,
+ * the document left without an end.
+ */
+static int writeFirstRecord(const char* fileName, Document* pDocument, FILE* pOutput)
+{
+	int errorCode = 0;
+	int errorSeverity = IPDR_OK;
+	IPDRCommonParameters* pWriter = NULL;
+	ListSchemaNameSpace* pListSchemaNameSpace = NULL;
+
+	pWriter = startCopy(pDocument, &pListSchemaNameSpace, pOutput, &errorCode);
+	if (pWriter == NULL) {
+		printf("%s: writeHeader failed, error %d\n", fileName, errorCode);
+		freeListSchemaNameSpace(&pListSchemaNameSpace);
+		return (IPDR_ERROR);
+	}
+
+	pDocument->pRecords_[0]->descriptorID_ = 0;
+	errorSeverity = writeIPDR(pWriter, pDocument->pRecords_[0], &errorCode);
+	if (errorSeverity != IPDR_ERROR)
+		errorSeverity = flushXDROutputBuffer(pWriter->pOutputBuffer_, &errorCode);
+	if (errorSeverity == IPDR_ERROR)
+		printf("%s: writing the first record failed, error %d\n", fileName, errorCode);
+
+	endCopy(pWriter, &pListSchemaNameSpace);
+	return (errorSeverity);
+}
+
+
+/*
+ * Compares the whole of two documents left without an end.
+ */
+static int sameBytes(FILE* pExpected, FILE* pWritten)
+{
+	int same = IPDR_FALSE;
+	long length[2];
+	char* pBytes[2] = { NULL, NULL };
+
+	/* readCopy() leaves out the end time, which these do not have */
+	pBytes[0] = readCopy(pExpected, &length[0]);
+	pBytes[1] = readCopy(pWritten, &length[1]);
+	if (pBytes[0] != NULL && pBytes[1] != NULL && length[0] == length[1] &&
+		memcmp(pBytes[0], pBytes[1], length[0] + CHECK_DOC_END_TIME_SIZE) == 0)
+		same = IPDR_TRUE;
+
+	free(pBytes[0]);
+	free(pBytes[1]);
+	return (same);
+}
+
+
+/*
+ * Writes a batch whose third record cannot be encoded; the batch must
+ * fail, leave the document NONWRITABLE, count none of its records and
+ * leave the stream with the bytes of the records before it only.
+ */
+static int checkFailedBatch(const char* fileName, Document* pDocument, int* pNoOfChecked)
+{
+	int count = 0;
+	int errorCode = 0;
+	int batchStartCount = 0;
+	int failures = 0;
+	FILE* pCopy = NULL;
+	FILE* pExpected = NULL;
+	FNFData* pBadRecord = NULL;
+	IPDRCommonParameters* pWriter = NULL;
+	ListSchemaNameSpace* pListSchemaNameSpace = NULL;
+
+	/* The bad record is encoded through a codec plan */
+	for (count = 2; count < pDocument->noOfRecords_; count++)
+		if (hasStructures(pDocument->pRecords_[count]) == IPDR_FALSE)
+			break;
+	if (count >= pDocument->noOfRecords_)
+		return (0);
+	pBadRecord = pDocument->pRecords_[count];
+
+	pExpected = tmpfile();
+	if (pExpected == NULL) {
+		printf("%s: cannot open a copy\n", fileName);
+		return (1);
+	}
+	if (writeFirstRecord(fileName, pDocument, pExpected) == IPDR_ERROR) {
+		fclose(pExpected);
+		return (1);
+	}
+
+	strcpy(pBadRecord->typeName_, "BatchWriteCheckType");
+	if (setAttributeDescriptorString(NULL, &pBadRecord->pListAttributeDescriptor_->pAttributeDescriptor_->attributeType_,
+									 "noSuchType") != IPDR_OK) {
+		printf("%s: cannot change the type of record %d\n", fileName, count + 1);
+		fclose(pExpected);
+		return (1);
+	}
+
+	pCopy = tmpfile();
+	if (pCopy == NULL) {
+		printf("%s: cannot open a copy\n", fileName);
+		fclose(pExpected);
+		return (1);
+	}
+	pWriter = startCopy(pDocument, &pListSchemaNameSpace, pCopy, &errorCode);
+	if (pWriter == NULL) {
+		printf("%s: writeHeader failed, error %d\n", fileName, errorCode);
+		freeListSchemaNameSpace(&pListSchemaNameSpace);
+		fclose(pCopy);
+		fclose(pExpected);
+		return (1);
+	}
+
+	/* A record written before the batch stays counted */
+	pDocument->pRecords_[0]->descriptorID_ = 0;
+	if (writeIPDR(pWriter, pDocument->pRecords_[0], &errorCode) == IPDR_ERROR) {
+		printf("%s: writeIPDR failed, error %d\n", fileName, errorCode);
+		failures++;
+	}
+	batchStartCount = pWriter->IPDRCount_.ipdrRecordCount_;
+
+	if (failures == 0 &&
+		writeIPDRBatch(pWriter, pDocument->pRecords_ + 1, pDocument->noOfRecords_ - 1,
+					   &errorCode) != IPDR_ERROR) {
+		printf("%s: the batch with record %d of no such type was written\n", fileName, count + 1);
+		failures++;
+	} else if (failures == 0) {
+		if (pWriter->DocState_ != NONWRITABLE) {
+			printf("%s: the document is writable after the batch failed\n", fileName);
+			failures++;
+		}
+		if (pWriter->IPDRCount_.ipdrRecordCount_ != batchStartCount) {
+			printf("%s: the record count is %d after the batch failed, %d before it\n", fileName,
+				   pWriter->IPDRCount_.ipdrRecordCount_, batchStartCount);
+			failures++;
+		}
+		(*pNoOfChecked)++;
+	}
+
+	endCopy(pWriter, &pListSchemaNameSpace);
+	if (failures == 0 && sameBytes(pExpected, pCopy) != IPDR_TRUE) {
+		printf("%s: the bytes written with the failed batch are not those of the record before it\n",
+			   fileName);
+		failures++;
+	}
+	fclose(pCopy);
+	fclose(pExpected);
+	return (failures);
+}
+
+
+/*
+ * Checks one document; returns the number of mismatches.
+ */
+static int checkFile(const char* fileName, int* pNoOfStructures, int* pNoOfChecked)
+{
+	int failures = 0;
+	static Document document;
+
+	if (readDocument(fileName, &document) == IPDR_ERROR) {
+		failures++;
+	} else {
+		failures += checkDocument(fileName, &document, pNoOfStructures);
+		failures += checkFailedBatch(fileName, &document, pNoOfChecked);
+	}
+	freeDocument(&document);
+
+	return (failures);
+}
+
+
+int main(int argc, char *argv[])
+{
+	int failures = 0;
+	int count = 0;
+	int noOfStructures = 0;
+	int noOfChecked = 0;
+	char fileName[BATCH_MAX_PATH];
+	const char* pTestData = getenv("IPDR_TESTDATA");
+
+	if (argc > 1) {
+		for (count = 1; count < argc; count++)
+			failures += checkFile(argv[count], &noOfStructures, &noOfChecked);
+	} else {
+		for (count = 0; count < (int) (sizeof(gDefaultDocuments) / sizeof(gDefaultDocuments[0])); count++) {
+			snprintf(fileName, sizeof(fileName), "%s/%s",
+					 pTestData != NULL ? pTestData : "testdata", gDefaultDocuments[count]);
+			failures += checkFile(fileName, &noOfStructures, &noOfChecked);
+		}
+
+		if (noOfStructures == 0) {
+			printf("no record with structures was written in a batch\n");
+			failures++;
+		}
+		if (noOfChecked == 0) {
+			printf("no failed batch was checked\n");
+			failures++;
+		}
+	}
+
+	if (failures != 0) {
+		printf("FAILED: %d mismatches\n", failures);
+		return (1);
+	}
+	printf("OK: records written by writeIPDRBatch match writeIPDR\n");
+	return (0);
+}
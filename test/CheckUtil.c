@@ -0,0 +1,210 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : CheckUtil                  *
+ * Description          : Helpers shared by the      *
+ *                        regression tests run by    *
+ *                        make check                 *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils/IPDRCommon.h"
+#include "utils/IPDRMemory.h"
+#include "CheckUtil.h"
+
+
+/*
+ * Parameters of a document on pStream, the version of a document read
+ * is taken from its header if schemaVersion is empty. pStream is left
+ * open if the parameters cannot be allocated.
+ */
+IPDRCommonParameters* newCheckParameters(DocType docType,
+										 DocState docState,
+										 const char* schemaVersion,
+										 FILE* pStream)
+{
+	IPDRCommonParameters* pIPDRCommonParameters = NULL;
+
+	pIPDRCommonParameters = newIPDRCommonParameters();
+	if (pIPDRCommonParameters == NULL)
+		return (NULL);
+
+	pIPDRCommonParameters->DocType_ = docType;
+	pIPDRCommonParameters->DocState_ = docState;
+	pIPDRCommonParameters->descriptorCount_ = 1;
+	pIPDRCommonParameters->pDescriptorLookupMap_ = newIPDRIntMap(9, free);
+	pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_ = 1;
+	strcpy(pIPDRCommonParameters->schemaVersion, schemaVersion);
+	if (pIPDRCommonParameters->pDescriptorLookupMap_ == NULL) {
+		freeIPDRCommonParameters(pIPDRCommonParameters);
+		return (NULL);
+	}
+	pIPDRCommonParameters->pStreamHandle_ = pStream;
+
+	return (pIPDRCommonParameters);
+}
+
+
+/*
+ * Reads a copy back, the end time of the document left out.
+ */
+char* readCopy(FILE* pStream, long* pLength)
+{
+	char* pBytes = NULL;
+
+	fseek(pStream, 0, SEEK_END);
+	*pLength = ftell(pStream);
+	rewind(pStream);
+	if (*pLength < CHECK_DOC_END_TIME_SIZE)
+		return (NULL);
+
+	pBytes = (char *) malloc(*pLength);
+	if (pBytes == NULL || (long) fread(pBytes, 1, *pLength, pStream) != *pLength) {
+		free(pBytes);
+		return (NULL);
+	}
+	*pLength -= CHECK_DOC_END_TIME_SIZE;
+
+	return (pBytes);
+}
+
+
+/*
+ * Returns the value of the named attribute of a record, or of its
+ * first string attribute if attributeName is NULL. The XML reader
+ * types values by the schema only, so the name is used to find the
+ * attribute again.
+ */
+ListIPDRData* findStringValue(FNFData* pFNFData, const char* attributeName)
+{
+	ListIPDRData* pListIPDRData = NULL;
+	ListAttributeDescriptor* pListAttributeDescriptor = NULL;
+
+	pListAttributeDescriptor = pFNFData->pListAttributeDescriptor_;
+	for (pListIPDRData = pFNFData->pListIPDRData_;
+		 pListIPDRData != NULL && pListAttributeDescriptor != NULL;
+		 pListIPDRData = pListIPDRData->pNext_,
+		 pListAttributeDescriptor = pListAttributeDescriptor->pNext_) {
+		if (attributeName == NULL ?
+			pListIPDRData->IPDRDataType_ == IPDRDATA_STRING :
+			strcmp(pListAttributeDescriptor->pAttributeDescriptor_->attributeName_,
+				   attributeName) == 0)
+			return (pListIPDRData);
+	}
+
+	return (NULL);
+}
+
+
+/*
+ * Name of the attribute holding pValue.
+ */
+const char* findAttributeName(FNFData* pFNFData, ListIPDRData* pValue)
+{
+	ListIPDRData* pListIPDRData = NULL;
+	ListAttributeDescriptor* pListAttributeDescriptor = NULL;
+
+	pListAttributeDescriptor = pFNFData->pListAttributeDescriptor_;
+	for (pListIPDRData = pFNFData->pListIPDRData_;
+		 pListIPDRData != NULL && pListAttributeDescriptor != NULL;
+		 pListIPDRData = pListIPDRData->pNext_,
+		 pListAttributeDescriptor = pListAttributeDescriptor->pNext_) {
+		if (pListIPDRData == pValue)
+			return (pListAttributeDescriptor->pAttributeDescriptor_->attributeName_);
+	}
+
+	return (NULL);
+}
+
+
+/*
+ * Writes the attributes of a record to pRecord as text.
+ */
+int formatRecord(const FNFData* pFNFData, RecordText* pRecord)
+{
+	int count = 0;
+	size_t length = 0;
+	const ListAttributeDescriptor* pDescriptor = NULL;
+	const ListIPDRData* pValue = NULL;
+	const IPDRDataUnion* pUnion = NULL;
+	char value[CHECK_MAX_TEXT];
+
+	snprintf(pRecord->text_, sizeof(pRecord->text_), "%s:", pFNFData->typeName_);
+	pRecord->noOfAttributes_ = 0;
+
+	for (pDescriptor = pFNFData->pListAttributeDescriptor_, pValue = pFNFData->pListIPDRData_;
+		 pDescriptor != NULL && pValue != NULL;
+		 pDescriptor = pDescriptor->pNext_, pValue = pValue->pNext_) {
+		pUnion = &pValue->IPDRDataUnion_;
+		switch (pValue->IPDRDataType_)
+		{
+		case IPDRDATA_LONG:
+			snprintf(value, sizeof(value), "%d", pUnion->IPDRLong_);
+			break;
+		case IPDRDATA_ULONG:
+			snprintf(value, sizeof(value), "%u", pUnion->IPDRULong_);
+			break;
+		case IPDRDATA_LONGLONG:
+			snprintf(value, sizeof(value), "%lld", (long long) pUnion->IPDRLongLong_);
+			break;
+		case IPDRDATA_ULONGLONG:
+			snprintf(value, sizeof(value), "%llu", (unsigned long long) pUnion->IPDRULongLong_);
+			break;
+		case IPDRDATA_FLOAT:
+			snprintf(value, sizeof(value), "%.9g", pUnion->IPDRFloat_);
+			break;
+		case IPDRDATA_DOUBLE:
+			snprintf(value, sizeof(value), "%.17g", pUnion->IPDRDouble_);
+			break;
+		case IPDRDATA_SHORT:
+			snprintf(value, sizeof(value), "%d", pUnion->IPDRShort_);
+			break;
+		case IPDRDATA_USHORT:
+			snprintf(value, sizeof(value), "%u", pUnion->IPDRUShort_);
+			break;
+		case IPDRDATA_BYTE:
+		case IPDRDATA_UBYTE:
+			snprintf(value, sizeof(value), "%d", pUnion->IPDRByte_);
+			break;
+		case IPDRDATA_HEXADECARRAY:
+			value[0] = '\0';
+			for (count = 0; count < pValue->length_ && count * 2 + 3 < (int) sizeof(value); count++)
+				sprintf(value + count * 2, "%02x", pUnion->IPDRByteArray_[count]);
+			break;
+		case IPDRDATA_STRING:
+			snprintf(value, sizeof(value), "\"%s\"", (const char *) pUnion->IPDRUTF8Array_);
+			break;
+		case IPDRDATA_BOOLEAN:
+			snprintf(value, sizeof(value), "%s", (const char *) pUnion->IPDRBoolean_);
+			break;
+		default:
+			printf("%s: unexpected type %d\n", pDescriptor->pAttributeDescriptor_->attributeName_,
+				   pValue->IPDRDataType_);
+			return (IPDR_ERROR);
+		}
+
+		length = strlen(pRecord->text_);
+		snprintf(pRecord->text_ + length, sizeof(pRecord->text_) - length, " %s=%s",
+				 pDescriptor->pAttributeDescriptor_->attributeName_, value);
+		pRecord->noOfAttributes_++;
+	}
+
+	return (IPDR_OK);
+}
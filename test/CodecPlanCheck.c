@@ -0,0 +1,276 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : CodecPlanCheck             *
+ * Description          : Checks that records read   *
+ *                        and written through codec  *
+ *                        plans are those of the     *
+ *                        attribute by attribute     *
+ *                        decoder and encoder        *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils/IPDRCommon.h"
+#include "utils/IPDRMemory.h"
+#include "utils/errorCode.h"
+#include "common/IPDRDocReader.h"
+#include "common/IPDRDocWriter.h"
+#include "xdr/XDRInputBuffer.h"
+#include "CheckUtil.h"
+
+#define PLAN_MAX_PATH				1024
+#define PLAN_MAX_RECORDS			64
+
+static const char* gDefaultDocuments[] = {
+	"testcase8/primitiveTypes.1.xdr",
+	"testcase1/testVOIP.1.xdr"
+};
+
+/* Records of a document read */
+typedef struct DocumentText
+{
+	int noOfRecords_;
+	RecordText records_[PLAN_MAX_RECORDS];
+} DocumentText;
+
+
+/*
+ * Reads a document with readIPDR() into pDocument and, if pOutput is
+ * not NULL, writes its records there with writeIPDR(). Both sides use
+ * codec plans as useCodecPlans says.
+ */
+static int copyDocument(const char* fileName,
+						FILE* pInput,
+						int useCodecPlans,
+						DocumentText* pDocument,
+						FILE* pOutput,
+						int* pErrorCode)
+{
+	int errorSeverity = IPDR_OK;
+	IPDRHeader* pIPDRHeader = NULL;
+	IPDRCommonParameters* pReader = NULL;
+	IPDRCommonParameters* pWriter = NULL;
+	ListSchemaNameSpace* pListSchemaNameSpace = NULL;
+	ListNameSpaceInfo* pNameSpaceInfo = NULL;
+	FNFData* pFNFData = NULL;
+
+	pDocument->noOfRecords_ = 0;
+	*pErrorCode = IPDR_OK;
+
+	pIPDRHeader = newIPDRHeader();
+	pReader = newCheckParameters(XDR, NONREADABLE, "", pInput);
+	if (pReader != NULL)
+		pReader->useCodecPlans_ = useCodecPlans;
+	if (pIPDRHeader == NULL || pReader == NULL ||
+		setXDRInputBuffer(pReader, XDR_INPUT_MMAP, pErrorCode) == IPDR_ERROR ||
+		readHeader(pReader, pIPDRHeader, pErrorCode) == IPDR_ERROR) {
+		printf("%s: cannot read the header, error %d\n", fileName, *pErrorCode);
+		return (IPDR_ERROR);
+	}
+
+	if (pOutput != NULL) {
+		pWriter = newCheckParameters(XDR, NONWRITABLE, pReader->schemaVersion, pOutput);
+		if (pWriter == NULL)
+			return (IPDR_ERROR);
+		pWriter->useCodecPlans_ = useCodecPlans;
+		for (pNameSpaceInfo = pIPDRHeader->pOtherNameSpaceInfo_; pNameSpaceInfo != NULL;
+			 pNameSpaceInfo = pNameSpaceInfo->pNext_)
+			appendListSchemaNameSpace(&pListSchemaNameSpace,
+									  pNameSpaceInfo->NameSpaceInfo_.nameSpaceURI_);
+		if (writeHeader(pWriter, pIPDRHeader->startTime_, pIPDRHeader->ipdrRecorderInfo_,
+						pIPDRHeader->defaultNameSpaceURI_, pIPDRHeader->pOtherNameSpaceInfo_,
+						pIPDRHeader->pListServiceDefinitionURI_, pIPDRHeader->docID_,
+						pListSchemaNameSpace, pErrorCode) == IPDR_ERROR) {
+			printf("%s: writeHeader failed, error %d\n", fileName, *pErrorCode);
+			return (IPDR_ERROR);
+		}
+	}
+
+	while (pDocument->noOfRecords_ < PLAN_MAX_RECORDS) {
+		pFNFData = newFNFData();
+		errorSeverity = readIPDR(pReader, &pFNFData, pErrorCode);
+		if (errorSeverity == IPDR_ERROR || pFNFData == NULL)
+			break;
+
+		errorSeverity = formatRecord(pFNFData, &pDocument->records_[pDocument->noOfRecords_]);
+		if (errorSeverity == IPDR_OK && pWriter != NULL) {
+			/* The descriptor is resolved by the writer */
+			pFNFData->descriptorID_ = 0;
+			errorSeverity = writeIPDR(pWriter, pFNFData, pErrorCode);
+		}
+		freeFNFData(pFNFData);
+		if (errorSeverity == IPDR_ERROR)
+			break;
+		pDocument->noOfRecords_++;
+	}
+
+	if (errorSeverity != IPDR_ERROR && pWriter != NULL) {
+		errorSeverity = writeDocEnd(pWriter, pErrorCode);
+		fflush(pOutput);
+	}
+
+	if (pWriter != NULL) {
+		pWriter->pStreamHandle_ = NULL;
+		freeIPDRCommonParameters(pWriter);
+	}
+	pReader->pStreamHandle_ = NULL;
+	freeListSchemaNameSpace(&pListSchemaNameSpace);
+	freeIPDRHeader(pIPDRHeader);
+	freeIPDRCommonParameters(pReader);
+	return (errorSeverity);
+}
+
+
+/*
+ * Reads and copies a document with codec plans and without, and
+ * compares the records read and the copies written.
+ */
+static int checkDocument(const char* fileName)
+{
+	int failures = 0;
+	int useCodecPlans = 0;
+	int count = 0;
+	int errorCode = 0;
+	long length[2];
+	char* pBytes[2] = { NULL, NULL };
+	FILE* pInput = NULL;
+	FILE* pCopy = NULL;
+	static DocumentText documents[2];
+
+	for (useCodecPlans = IPDR_FALSE; useCodecPlans <= IPDR_TRUE; useCodecPlans++) {
+		pInput = fopen(fileName, "rb");
+		pCopy = tmpfile();
+		if (pInput == NULL || pCopy == NULL) {
+			printf("%s: cannot open the document\n", fileName);
+			return (1);
+		}
+		if (copyDocument(fileName, pInput, useCodecPlans, &documents[useCodecPlans],
+						 pCopy, &errorCode) == IPDR_ERROR) {
+			printf("%s: copy %s codec plans failed at record %d, error %d\n", fileName,
+				   useCodecPlans ? "with" : "without",
+				   documents[useCodecPlans].noOfRecords_ + 1, errorCode);
+			failures++;
+		} else {
+			pBytes[useCodecPlans] = readCopy(pCopy, &length[useCodecPlans]);
+		}
+		fclose(pCopy);
+		fclose(pInput);
+	}
+
+	if (documents[IPDR_TRUE].noOfRecords_ != documents[IPDR_FALSE].noOfRecords_) {
+		printf("%s: %d records read with codec plans, %d without\n", fileName,
+			   documents[IPDR_TRUE].noOfRecords_, documents[IPDR_FALSE].noOfRecords_);
+		failures++;
+	}
+	for (count = 0; count < documents[IPDR_TRUE].noOfRecords_ &&
+		 count < documents[IPDR_FALSE].noOfRecords_; count++) {
+		if (strcmp(documents[IPDR_TRUE].records_[count].text_,
+				   documents[IPDR_FALSE].records_[count].text_) != 0) {
+			printf("%s: record %d is\n    %s\nwithout codec plans\n    %s\n", fileName, count + 1,
+				   documents[IPDR_TRUE].records_[count].text_,
+				   documents[IPDR_FALSE].records_[count].text_);
+			failures++;
+			break;
+		}
+	}
+
+	if (pBytes[IPDR_TRUE] == NULL || pBytes[IPDR_FALSE] == NULL) {
+		printf("%s: no copy to compare\n", fileName);
+		failures++;
+	} else if (length[IPDR_TRUE] != length[IPDR_FALSE] ||
+			   memcmp(pBytes[IPDR_TRUE], pBytes[IPDR_FALSE], length[IPDR_TRUE]) != 0) {
+		printf("%s: the copy written with codec plans differs\n", fileName);
+		failures++;
+	}
+
+	free(pBytes[IPDR_FALSE]);
+	free(pBytes[IPDR_TRUE]);
+	return (failures);
+}
+
+
+/*
+ * Cuts a document inside a record; the record must fail rather than
+ * be read with values missing.
+ */
+static int checkTruncated(const char* fileName)
+{
+	int errorCode = 0;
+	long length = 0;
+	char* pBytes = NULL;
+	FILE* pInput = NULL;
+	FILE* pCut = NULL;
+	static DocumentText document;
+
+	pInput = fopen(fileName, "rb");
+	pCut = tmpfile();
+	if (pInput == NULL || pCut == NULL ||
+		(pBytes = readCopy(pInput, &length)) == NULL) {
+		printf("%s: cannot open the document\n", fileName);
+		return (1);
+	}
+	fclose(pInput);
+
+	/* The end time is left out already, cut off the last record too */
+	length -= 2 * CHECK_DOC_END_TIME_SIZE;
+	fwrite(pBytes, 1, length, pCut);
+	fflush(pCut);
+	rewind(pCut);
+	free(pBytes);
+
+	if (copyDocument(fileName, pCut, IPDR_TRUE, &document, NULL, &errorCode) != IPDR_ERROR ||
+		errorCode != IPDR_EOF_ENCOUNTERED) {
+		printf("%s: %d records of the cut document read, error %d\n", fileName,
+			   document.noOfRecords_, errorCode);
+		fclose(pCut);
+		return (1);
+	}
+
+	fclose(pCut);
+	return (0);
+}
+
+
+int main(int argc, char *argv[])
+{
+	int failures = 0;
+	int count = 0;
+	char fileName[PLAN_MAX_PATH];
+	const char* pTestData = getenv("IPDR_TESTDATA");
+
+	if (argc > 1) {
+		for (count = 1; count < argc; count++)
+			failures += checkDocument(argv[count]);
+	} else {
+		for (count = 0; count < (int) (sizeof(gDefaultDocuments) / sizeof(gDefaultDocuments[0])); count++) {
+			snprintf(fileName, sizeof(fileName), "%s/%s",
+					 pTestData != NULL ? pTestData : "testdata", gDefaultDocuments[count]);
+			failures += checkDocument(fileName);
+			failures += checkTruncated(fileName);
+		}
+	}
+
+	if (failures != 0) {
+		printf("FAILED: %d mismatches\n", failures);
+		return (1);
+	}
+	printf("OK: records read and written through codec plans match\n");
+	return (0);
+}
@@ -0,0 +1,272 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : FlatRecordCheck            *
+ * Description          : Checks that documents      *
+ *                        copied through flat records*
+ *                        are the bytes readIPDR and *
+ *                        writeIPDR give             *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils/IPDRCommon.h"
+#include "utils/IPDRMemory.h"
+#include "utils/IPDRFlatRecord.h"
+#include "utils/errorCode.h"
+#include "common/IPDRDocReader.h"
+#include "common/IPDRDocWriter.h"
+#include "xdr/XDRInputBuffer.h"
+#include "CheckUtil.h"
+
+#define FLAT_MAX_PATH				1024
+
+/* How records are copied */
+#define FLAT_COPY_FNFDATA			0   /* readIPDR, writeIPDR */
+#define FLAT_COPY_FLAT				1   /* readIPDRFlat, writeIPDRFlat */
+#define FLAT_COPY_CONVERTED			2   /* readIPDR, to a flat record and back, writeIPDR */
+
+static const char* gDefaultDocuments[] = {
+	"testcase8/primitiveTypes.1.xdr",
+	"testcase1/testVOIP.1.xdr"
+};
+
+static const char* gCopyNames[] = {
+	"readIPDR/writeIPDR",
+	"readIPDRFlat/writeIPDRFlat",
+	"copyFNFDataToFlatRecord/copyFlatRecordToFNFData"
+};
+
+
+/*
+ * Reads the next record the way copyMode says and writes it.
+ * *pRecordRead is IPDR_FALSE at the end of the document.
+ */
+static int copyRecord(IPDRCommonParameters* pReader,
+					  IPDRCommonParameters* pWriter,
+					  int copyMode,
+					  IPDRFlatRecord* pRecord,
+					  int* pRecordRead,
+					  int* pErrorCode)
+{
+	int errorCode = IPDR_OK;
+	FNFData* pFNFData = NULL;
+	FNFData* pCopy = NULL;
+
+	if (copyMode == FLAT_COPY_FLAT) {
+		if (readIPDRFlat(pReader, pRecord, pRecordRead, pErrorCode) == IPDR_ERROR)
+			return (IPDR_ERROR);
+		if (*pRecordRead == IPDR_FALSE)
+			return (IPDR_OK);
+		return (writeIPDRFlat(pWriter, pRecord, pErrorCode));
+	}
+
+	pFNFData = newFNFData();
+	if (readIPDR(pReader, &pFNFData, pErrorCode) == IPDR_ERROR)
+		return (IPDR_ERROR);
+	*pRecordRead = (pFNFData != NULL);
+	if (pFNFData == NULL)
+		return (IPDR_OK);
+
+	if (copyMode == FLAT_COPY_CONVERTED) {
+		pCopy = newFNFData();
+		if (pCopy == NULL)
+			errorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		if (errorCode == IPDR_OK)
+			errorCode = copyFNFDataToFlatRecord(pRecord, pFNFData);
+		if (errorCode == IPDR_OK)
+			errorCode = copyFlatRecordToFNFData(pCopy, pRecord);
+		freeFNFData(pFNFData);
+		pFNFData = pCopy;
+		if (errorCode != IPDR_OK) {
+			freeFNFData(pFNFData);
+			*pErrorCode = errorCode;
+			return (IPDR_ERROR);
+		}
+	}
+
+	/* The descriptor is resolved by the writer */
+	pFNFData->descriptorID_ = 0;
+	if (writeIPDR(pWriter, pFNFData, pErrorCode) == IPDR_ERROR) {
+		freeFNFData(pFNFData);
+		return (IPDR_ERROR);
+	}
+	freeFNFData(pFNFData);
+	return (IPDR_OK);
+}
+
+
+/*
+ * Copies a document to pOutput record by record.
+ */
+static int copyDocument(const char* fileName, int copyMode, FILE* pOutput)
+{
+	int errorCode = 0;
+	int recordRead = IPDR_TRUE;
+	int noOfRecords = 0;
+	FILE* pInput = NULL;
+	IPDRHeader* pIPDRHeader = NULL;
+	IPDRCommonParameters* pReader = NULL;
+	IPDRCommonParameters* pWriter = NULL;
+	IPDRFlatRecord* pRecord = NULL;
+	ListSchemaNameSpace* pListSchemaNameSpace = NULL;
+	ListNameSpaceInfo* pNameSpaceInfo = NULL;
+
+	pIPDRHeader = newIPDRHeader();
+	pRecord = newIPDRFlatRecord();
+	pInput = fopen(fileName, "rb");
+	if (pIPDRHeader == NULL || pRecord == NULL || pInput == NULL) {
+		printf("%s: cannot open the document\n", fileName);
+		return (-1);
+	}
+
+	pReader = newCheckParameters(XDR, NONREADABLE, "", pInput);
+	if (pReader == NULL ||
+		setXDRInputBuffer(pReader, XDR_INPUT_MMAP, &errorCode) == IPDR_ERROR ||
+		readHeader(pReader, pIPDRHeader, &errorCode) == IPDR_ERROR) {
+		printf("%s: cannot read the header, error %d\n", fileName, errorCode);
+		return (-1);
+	}
+	pWriter = newCheckParameters(XDR, NONWRITABLE, pReader->schemaVersion, pOutput);
+	if (pWriter == NULL)
+		return (-1);
+
+	for (pNameSpaceInfo = pIPDRHeader->pOtherNameSpaceInfo_; pNameSpaceInfo != NULL;
+		 pNameSpaceInfo = pNameSpaceInfo->pNext_)
+		appendListSchemaNameSpace(&pListSchemaNameSpace,
+								  pNameSpaceInfo->NameSpaceInfo_.nameSpaceURI_);
+	if (writeHeader(pWriter, pIPDRHeader->startTime_, pIPDRHeader->ipdrRecorderInfo_,
+					pIPDRHeader->defaultNameSpaceURI_, pIPDRHeader->pOtherNameSpaceInfo_,
+					pIPDRHeader->pListServiceDefinitionURI_, pIPDRHeader->docID_,
+					pListSchemaNameSpace, &errorCode) == IPDR_ERROR) {
+		printf("%s: writeHeader failed, error %d\n", fileName, errorCode);
+		return (-1);
+	}
+
+	for (;;) {
+		if (copyRecord(pReader, pWriter, copyMode, pRecord, &recordRead, &errorCode) == IPDR_ERROR) {
+			printf("%s: %s failed at record %d, error %d\n", fileName,
+				   gCopyNames[copyMode], noOfRecords + 1, errorCode);
+			return (-1);
+		}
+		if (recordRead == IPDR_FALSE)
+			break;
+		noOfRecords++;
+	}
+
+	if (writeDocEnd(pWriter, &errorCode) == IPDR_ERROR) {
+		printf("%s: writeDocEnd failed, error %d\n", fileName, errorCode);
+		return (-1);
+	}
+	fflush(pOutput);
+
+	pWriter->pStreamHandle_ = NULL;
+	freeListSchemaNameSpace(&pListSchemaNameSpace);
+	freeIPDRFlatRecord(pRecord);
+	freeIPDRHeader(pIPDRHeader);
+	freeIPDRCommonParameters(pReader);
+	freeIPDRCommonParameters(pWriter);
+	return (noOfRecords);
+}
+
+
+/*
+ * Copies a document each way and compares the copies with the one
+ * readIPDR() and writeIPDR() give.
+ */
+static int checkDocument(const char* fileName)
+{
+	int failures = 0;
+	int copyMode = 0;
+	int noOfRecords[3];
+	long length[3];
+	long offset = 0;
+	char* pBytes[3];
+	FILE* pCopy = NULL;
+
+	for (copyMode = FLAT_COPY_FNFDATA; copyMode <= FLAT_COPY_CONVERTED; copyMode++) {
+		pBytes[copyMode] = NULL;
+		pCopy = tmpfile();
+		if (pCopy == NULL)
+			return (1);
+		noOfRecords[copyMode] = copyDocument(fileName, copyMode, pCopy);
+		if (noOfRecords[copyMode] > 0)
+			pBytes[copyMode] = readCopy(pCopy, &length[copyMode]);
+		fclose(pCopy);
+		if (pBytes[copyMode] == NULL) {
+			printf("%s: no copy by %s\n", fileName, gCopyNames[copyMode]);
+			failures++;
+		}
+	}
+
+	for (copyMode = FLAT_COPY_FLAT; copyMode <= FLAT_COPY_CONVERTED; copyMode++) {
+		if (pBytes[FLAT_COPY_FNFDATA] == NULL || pBytes[copyMode] == NULL)
+			continue;
+		if (noOfRecords[copyMode] != noOfRecords[FLAT_COPY_FNFDATA] ||
+			length[copyMode] != length[FLAT_COPY_FNFDATA]) {
+			printf("%s: %s gave %d records in %ld bytes, %s %d in %ld\n", fileName,
+				   gCopyNames[copyMode], noOfRecords[copyMode], length[copyMode],
+				   gCopyNames[FLAT_COPY_FNFDATA], noOfRecords[FLAT_COPY_FNFDATA],
+				   length[FLAT_COPY_FNFDATA]);
+			failures++;
+			continue;
+		}
+		for (offset = 0; offset < length[copyMode]; offset++) {
+			if (pBytes[copyMode][offset] != pBytes[FLAT_COPY_FNFDATA][offset])
+				break;
+		}
+		if (offset < length[copyMode]) {
+			printf("%s: %s differs from %s at byte %ld\n", fileName,
+				   gCopyNames[copyMode], gCopyNames[FLAT_COPY_FNFDATA], offset);
+			failures++;
+		}
+	}
+
+	for (copyMode = FLAT_COPY_FNFDATA; copyMode <= FLAT_COPY_CONVERTED; copyMode++)
+		free(pBytes[copyMode]);
+
+	return (failures);
+}
+
+
+int main(int argc, char *argv[])
+{
+	int failures = 0;
+	int count = 0;
+	char fileName[FLAT_MAX_PATH];
+	const char* pTestData = getenv("IPDR_TESTDATA");
+
+	if (argc > 1) {
+		for (count = 1; count < argc; count++)
+			failures += checkDocument(argv[count]);
+	} else {
+		for (count = 0; count < (int) (sizeof(gDefaultDocuments) / sizeof(gDefaultDocuments[0])); count++) {
+			snprintf(fileName, sizeof(fileName), "%s/%s",
+					 pTestData != NULL ? pTestData : "testdata", gDefaultDocuments[count]);
+			failures += checkDocument(fileName);
+		}
+	}
+
+	if (failures != 0) {
+		printf("FAILED: %d mismatches\n", failures);
+		return (1);
+	}
+	printf("OK: flat record copies match readIPDR/writeIPDR\n");
+	return (0);
+}
@@ -0,0 +1,185 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : IPDRMapBench               *
+ * Description          : Compares the typed maps    *
+ *                        with the chained HashTable *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "utils/IPDRCommon.h"
+#include "utils/hashtable.h"
+#include "utils/IPDRMap.h"
+
+#define BENCH_DEFAULT_KEYS		2000
+#define BENCH_DEFAULT_ROUNDS	200
+#define BENCH_KEY_LENGTH		64
+
+
+static double nsPerLookup(clock_t start, clock_t end, long lookups)
+{
+	return((double) (end - start) * 1e9 / CLOCKS_PER_SEC / lookups);
+}
+
+int main(int argc, char *argv[])
+{
+	int keys = BENCH_DEFAULT_KEYS;
+	int rounds = BENCH_DEFAULT_ROUNDS;
+	int count = 0;
+	int round = 0;
+	int value = 0;
+	int mismatch = 0;
+	int errorCode = 0;
+	long lookups = 0;
+	char* pKeys = NULL;
+	char* pValue = NULL;
+	char idKey[MAX_IPDR_STRING];
+	volatile long sink = 0;
+	HashTable* pHashTable = NULL;
+	HashTable* pIDHashTable = NULL;
+	IPDRStringMap* pStringMap = NULL;
+	IPDRIntMap* pIntMap = NULL;
+	clock_t start;
+	clock_t end;
+	double legacyTime;
+	double mapTime;
+
+	if (argc > 1)
+		keys = atoi(argv[1]);
+	if (argc > 2)
+		rounds = atoi(argv[2]);
+	if (keys <= 0)
+		keys = BENCH_DEFAULT_KEYS;
+	if (rounds <= 0)
+		rounds = BENCH_DEFAULT_ROUNDS;
+	lookups = (long) keys * rounds;
+
+	/* Attribute names as built by validateAgainstSchema() */
+	pKeys = (char *) calloc(keys, BENCH_KEY_LENGTH);
+	pHashTable = HashTableCreate(HASH_BUCKETS);
+	pIDHashTable = HashTableCreate(HASH_BUCKETS);
+	pStringMap = newIPDRStringMap(0);
+	pIntMap = newIPDRIntMap(0, free);
+	if (pKeys == NULL || pHashTable == NULL || pIDHashTable == NULL ||
+		pStringMap == NULL || pIntMap == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		return(1);
+	}
+	for (count = 0; count < keys; count++)
+		sprintf(pKeys + count * BENCH_KEY_LENGTH,
+				"IP-Type%d$http://www.ipdr.org/namespaces/ipdr$attr%d",
+				count % 7, count);
+
+	/* string -> int */
+	start = clock();
+	for (count = 0; count < keys; count++)
+		HashTablePut(pHashTable, pKeys + count * BENCH_KEY_LENGTH,
+					 (void *) (long) count);
+	for (round = 0; round < rounds; round++) {
+		for (count = 0; count < keys; count++)
+			sink += atoi((char *) HashTableGet(pHashTable,
+											   pKeys + count * BENCH_KEY_LENGTH));
+	}
+	end = clock();
+	legacyTime = nsPerLookup(start, end, lookups);
+
+	start = clock();
+	for (count = 0; count < keys; count++)
+		putIPDRStringMap(pStringMap, pKeys + count * BENCH_KEY_LENGTH,
+						 count, &errorCode);
+	for (round = 0; round < rounds; round++) {
+		for (count = 0; count < keys; count++) {
+			getIPDRStringMap(pStringMap, pKeys + count * BENCH_KEY_LENGTH, &value);
+			sink += value;
+		}
+	}
+	end = clock();
+	mapTime = nsPerLookup(start, end, lookups);
+
+	for (count = 0; count < keys; count++) {
+		if (getIPDRStringMap(pStringMap, pKeys + count * BENCH_KEY_LENGTH,
+							 &value) != IPDR_TRUE || value != count ||
+			atoi((char *) HashTableGet(pHashTable,
+									   pKeys + count * BENCH_KEY_LENGTH)) != count) {
+			mismatch++;
+			break;
+		}
+	}
+	if (getIPDRStringMap(pStringMap, "IP-Type0$absent", NULL) != IPDR_FALSE)
+		mismatch++;
+	printf("string->int  HashTable %8.2f ns/lookup  IPDRStringMap %8.2f ns/lookup\n",
+		   legacyTime, mapTime);
+
+	/* int -> serialized descriptor, as kept per descriptor ID */
+	start = clock();
+	for (count = 0; count < keys; count++) {
+		sprintf(idKey, "%d", count);
+		HashTablePutstr(pIDHashTable, idKey, pKeys + count * BENCH_KEY_LENGTH);
+	}
+	for (round = 0; round < rounds; round++) {
+		for (count = 0; count < keys; count++) {
+			sprintf(idKey, "%d", count);
+			sink += (long) HashTableGet(pIDHashTable, idKey);
+		}
+	}
+	end = clock();
+	legacyTime = nsPerLookup(start, end, lookups);
+
+	start = clock();
+	for (count = 0; count < keys; count++) {
+		pValue = (char *) malloc(strlen(pKeys + count * BENCH_KEY_LENGTH) + 1);
+		strcpy(pValue, pKeys + count * BENCH_KEY_LENGTH);
+		putIPDRIntMap(pIntMap, count, pValue, &errorCode);
+	}
+	for (round = 0; round < rounds; round++) {
+		for (count = 0; count < keys; count++)
+			sink += (long) getIPDRIntMap(pIntMap, count);
+	}
+	end = clock();
+	mapTime = nsPerLookup(start, end, lookups);
+
+	for (count = 0; count < keys; count++) {
+		sprintf(idKey, "%d", count);
+		pValue = (char *) getIPDRIntMap(pIntMap, count);
+		if (pValue == NULL ||
+			strcmp(pValue, (char *) HashTableGet(pIDHashTable, idKey)) != 0) {
+			mismatch++;
+			break;
+		}
+	}
+	if (getIPDRIntMap(pIntMap, keys) != NULL)
+		mismatch++;
+	printf("int->pointer HashTable %8.2f ns/lookup  IPDRIntMap    %8.2f ns/lookup\n",
+		   legacyTime, mapTime);
+
+	HashTableDestroy(pHashTable);
+	HashTableDestroy(pIDHashTable);
+	freeIPDRStringMap(pStringMap);
+	freeIPDRIntMap(pIntMap);
+	free(pKeys);
+
+	if (mismatch != 0) {
+		printf("FAILED: map contents differ from the HashTable\n");
+		return(1);
+	}
+	printf("OK: %d keys, %ld lookups per map\n", keys, lookups);
+	return(0);
+}
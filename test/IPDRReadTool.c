@@ -145,6 +145,15 @@ int main(
      printf("sorry no version change\n");
 */
 
+	/* The whole document is decoded, read it through a mapping */
+	if (pIPDRCommonParameters->DocType_ == XDR) {
+		errorSeverity = setXDRInputBuffer(pIPDRCommonParameters, XDR_INPUT_MMAP, pErrorCode);
+		if (errorSeverity == IPDR_ERROR) {
+			exceptionHandler(pIPDRCommonParameters, pErrorCode, "setXDRInputBuffer"); 
+			return (IPDR_ERROR);
+		}
+	}
+
 	/* Read the header and get the default name space and Service 
 	Definition URI list*/
     errorSeverity = readHeader(pIPDRCommonParameters, pIPDRHeader, pErrorCode);
@@ -1926,6 +1935,32 @@ int validateInputParams(
 			}
 		}
 
+		/*Catches the commandline parameter -schemacache. Also reads
+		the schema cache directory from the next commandline parameter*/
+		if ((strcmp(tempString,	"-SCHEMACACHE")) == 0) {
+			if(!(countArguments==(unsigned int)(argCount-1))) {
+				if (setSchemaCacheDirectory(argValues[countArguments+1],
+					pErrorCode) == IPDR_ERROR) {
+					return(IPDR_ERROR);
+				}
+				countValidArgs += 2;
+				countArguments++;
+			}
+		}
+
+		/*Catches the commandline parameter -projection. Only the comma
+		separated attributes that follow are read into the records*/
+		if ((strcmp(tempString,	"-PROJECTION")) == 0) {
+			if(!(countArguments==(unsigned int)(argCount-1))) {
+				if (setProjection(argValues[countArguments+1],
+					pIPDRCommonParameters, pErrorCode) == IPDR_ERROR) {
+					return(IPDR_ERROR);
+				}
+				countValidArgs += 2;
+				countArguments++;
+			}
+		}
+
 		/*Catches the commandline parameter -ipdrversion*/
 		if ((strcmp(tempString,	"-IPDRVERSION")) == 0) {
 			*versionFlag = 1;
@@ -1991,6 +2026,69 @@ int validateInputParams(
 }
 
 
+/*!
+ *  NAME:
+ *      setProjection() - Sets the attributes read into the records
+ *
+ *  DESCRIPTION:
+ *      Splits the comma separated attribute names of the -projection
+ *      parameter and passes them to setIPDRProjection().
+ *  
+ *  ARGUMENTS:
+ *		
+ *			attributeNames			(IN)
+ *			pIPDRCommonParameters   (IN/OUT)
+ *			pErrorCode				(IN/OUT)
+ *
+ *  RETURNS 	
+ *	     Returns Zero if the operation is successful or appropriate
+ * 		 error code in case of failure.
+ */
+
+int setProjection(
+				  char* attributeNames,
+				  IPDRCommonParameters* pIPDRCommonParameters,
+				  int* pErrorCode
+				  )
+{
+	int errorSeverity = IPDR_OK;
+	char* names = NULL;
+	char* token = NULL;
+	char* attributeName = NULL;
+	char* pContext = NULL;
+	List* pListAttributeName = NULL;
+
+	names = (char *) calloc(strlen(attributeNames) + 1, sizeof(char));
+	if (names == NULL) {
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return(IPDR_ERROR);
+	}
+	strcpy(names, attributeNames);
+
+	token = strtok_r(names, ",", &pContext);
+	while (token != NULL) {
+		attributeName = (char *) calloc(strlen(token) + 1, sizeof(char));
+		if (attributeName == NULL) {
+			freeList(&pListAttributeName);
+			free(names);
+			*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+			return(IPDR_ERROR);
+		}
+		strcpy(attributeName, token);
+		appendNode(&pListAttributeName, attributeName);
+		token = strtok_r(NULL, ",", &pContext);
+	}
+
+	errorSeverity = setIPDRProjection(pIPDRCommonParameters, 
+									  pListAttributeName, pErrorCode);
+
+	freeList(&pListAttributeName);
+	free(names);
+
+	return(errorSeverity);
+}
+
+
 /*!
  *  NAME:
  *      populateIPDRCommonParameters() - This function populates
@@ -2019,8 +2117,8 @@ int populateIPDRCommonParameters(
 	pIPDRCommonParameters->DocState_ = NONREADABLE;
 	pIPDRCommonParameters->DocType_ = 0;
 	pIPDRCommonParameters->descriptorCount_ = 1;
-	pIPDRCommonParameters->pDescriptorLookupHashTable_ = 
-		                      HashTableCreate(numOfBuckets);
+	pIPDRCommonParameters->pDescriptorLookupMap_ = 
+		                      newIPDRIntMap(numOfBuckets, free);
 	pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_ = 1;
 	pIPDRCommonParameters->pDescriptorLookupList_ = NULL;
 	pIPDRCommonParameters->pListErrorStructure_ = NULL;                    
@@ -2045,7 +2143,7 @@ int populateIPDRCommonParameters(
 
 int printUsage()
 {
-	printf("\nCorrect Input String is: Infile.xdr -doctype XDR <-schemavalidation> <-ipdrversion 3.5/3.1> -outFiledir <-output directory>");
+	printf("\nCorrect Input String is: Infile.xdr -doctype XDR <-schemavalidation> <-schemacache CacheDirectory> <-ipdrversion 3.5/3.1> <-projection name1,name2> -outFiledir <-output directory>");
 	return (IPDR_OK);
 }
 
@@ -0,0 +1,1062 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : IPDRThreadStress           *
+ * Description          : Reads and writes documents *
+ *                        on several threads at once *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "utils/IPDRCommon.h"
+#include "utils/IPDRMemory.h"
+#include "utils/IPDRThread.h"
+#include "utils/UUIDUtil.h"
+#include "utils/errorCode.h"
+#include "common/IPDRBatchConverter.h"
+#include "common/IPDRDocReader.h"
+#include "common/IPDRDocWriter.h"
+#include "common/schemaRegistry.h"
+#include "xdr/XDRInputBuffer.h"
+
+#define STRESS_DEFAULT_THREADS		8
+#define STRESS_DEFAULT_ROUNDS		4
+#define STRESS_UUIDS_PER_ROUND		250
+#define STRESS_UUID_LENGTH			40
+#define STRESS_END_TIME				"endTime=\""
+#define STRESS_CREATION_TIME		"creationTime=\""
+#define STRESS_RECORD_TIME			"<IPDRCreationTime>"
+#define STRESS_NO_OF_BATCH_SIZES	3
+#define STRESS_MAX_PATH				1024
+#define STRESS_INVALID_BATCH_SIZE	7
+
+/*
+ * Without documents given, the multi-record VoIP document of the test
+ * data is converted, with the schemas it names, in a work directory:
+ * the UUID generator keeps its state in the current directory.
+ */
+#define STRESS_DEFAULT_DIRECTORY	"testcase1"
+#define STRESS_DEFAULT_DOCUMENT		"testVOIP.1.xdr"
+#define STRESS_DEFAULT_VERSION		IPDR_VERSION_3_1
+#define STRESS_WORK_DIRECTORY		"IPDRThreadStress.dir"
+
+
+/* An input document and its conversions done on one thread */
+typedef struct StressDocument {
+	char* pFileName_;
+	byte* pReference_[2];    /* XDR and XML output */
+	long referenceLength_[2];
+	int noOfRecords_;
+} StressDocument;
+
+typedef struct StressJob {
+	StressDocument* pDocuments_;
+	int noOfDocuments_;
+	int rounds_;
+	int first_;              /* Document the job starts with */
+	int failures_;
+	char* pUUIDs_;           /* UUIDs generated by the job */
+	int noOfUUIDs_;
+} StressJob;
+
+static DocType gOutputTypes[2] = { XDR, XML };
+static char gIPDRVersion[MAX_SCHEMA_VERSION] = IPDR_VERSION_3_5;
+static int gSchemaValidation = 0;
+static int gBatchSizes[STRESS_NO_OF_BATCH_SIZES] = { 1, 7, 4096 };
+
+/* Copied into the work directory, the document first */
+static const char* gDefaultFiles[] = {
+	STRESS_DEFAULT_DOCUMENT,
+	"VoIP3.0-A.0.xsd",
+	"IPDRDoc3.0.xsd"
+};
+
+/* Written to the work directory by the UUID generator */
+static const char* gUUIDFiles[] = {
+	"state",
+	"nodeid"
+};
+
+
+static IPDRCommonParameters* newStressParameters(DocType docType,
+												 DocState docState,
+												 char* streamName,
+												 FILE* pStream)
+{
+	IPDRCommonParameters* pIPDRCommonParameters = NULL;
+
+	pIPDRCommonParameters = newIPDRCommonParameters();
+	if (pIPDRCommonParameters == NULL) {
+		fclose(pStream);
+		return (NULL);
+	}
+
+	pIPDRCommonParameters->DocType_ = docType;
+	pIPDRCommonParameters->DocState_ = docState;
+	pIPDRCommonParameters->pStreamHandle_ = pStream;
+	pIPDRCommonParameters->descriptorCount_ = 1;
+	pIPDRCommonParameters->pDescriptorLookupMap_ = newIPDRIntMap(9, free);
+	pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_ = 1;
+	strcpy(pIPDRCommonParameters->schemaVersion, gIPDRVersion);
+	pIPDRCommonParameters->pStreamName_ = (char *) calloc(strlen(streamName) + 1, sizeof(char));
+	if (pIPDRCommonParameters->pDescriptorLookupMap_ == NULL ||
+		pIPDRCommonParameters->pStreamName_ == NULL) {
+		freeIPDRCommonParameters(pIPDRCommonParameters);
+		return (NULL);
+	}
+	strcpy(pIPDRCommonParameters->pStreamName_, streamName);
+
+	return (pIPDRCommonParameters);
+}
+
+
+/*
+ * Opens a document for reading and reads its header, with the schema
+ * of its service definitions when schema validation is on.
+ */
+static IPDRCommonParameters* openStressReader(DocType docType,
+											  char* streamName,
+											  FILE* pStream,
+											  IPDRHeader* pIPDRHeader,
+											  int* pErrorCode)
+{
+	IPDRCommonParameters* pReader = NULL;
+
+	if (pStream == NULL) {
+		*pErrorCode = IPDR_INVALID_FILE;
+		return (NULL);
+	}
+
+	pReader = newStressParameters(docType, NONREADABLE, streamName, pStream);
+	if (pReader == NULL) {
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return (NULL);
+	}
+
+	if ((docType == XDR &&
+		 setXDRInputBuffer(pReader, XDR_INPUT_MMAP, pErrorCode) == IPDR_ERROR) ||
+		readHeader(pReader, pIPDRHeader, pErrorCode) == IPDR_ERROR ||
+		(gSchemaValidation &&
+		 acquireSchemaData(pReader, pIPDRHeader->pOtherNameSpaceInfo_,
+						   pIPDRHeader->pListServiceDefinitionURI_,
+						   pIPDRHeader->defaultNameSpaceURI_, pErrorCode) == IPDR_ERROR)) {
+		freeIPDRCommonParameters(pReader);
+		return (NULL);
+	}
+
+	return (pReader);
+}
+
+
+/*
+ * Blanks the value that follows each occurrence of pMarker, up to the
+ * next occurrence of terminator.
+ */
+static void maskValues(char* pDocument, const char* pMarker, char terminator)
+{
+	char* pValue = pDocument;
+
+	while ((pValue = strstr(pValue, pMarker)) != NULL) {
+		for (pValue += strlen(pMarker); *pValue != '\0' && *pValue != terminator; pValue++)
+			*pValue = '0';
+	}
+}
+
+
+/*
+ * Blanks the times taken when the document was written, so
+ * conversions done at different times compare equal. XDR documents
+ * hold only the end time, in the last 8 bytes; XML documents also
+ * stamp the header and each record.
+ */
+static void maskWriteTimes(DocType docType, byte* pDocument, long length)
+{
+	if (docType == XDR) {
+		if (length >= 8)
+			memset(pDocument + length - 8, 0, 8);
+		return;
+	}
+
+	maskValues((char *) pDocument, STRESS_END_TIME, '"');
+	maskValues((char *) pDocument, STRESS_CREATION_TIME, '"');
+	maskValues((char *) pDocument, STRESS_RECORD_TIME, '<');
+}
+
+
+/*
+ * Reads an XDR document and writes its records to a temporary
+ * document of outputType. Returns the written document. With a
+ * batchSize, the records are read with readIPDRBatch() on noOfThreads,
+ * otherwise one at a time, into pArena when given.
+ */
+static int convertDocument(char* fileName,
+						   DocType outputType,
+						   int batchSize,
+						   int noOfThreads,
+						   IPDRArena* pArena,
+						   byte** ppOutput,
+						   long* pLength,
+						   int* pErrorCode)
+{
+	int errorSeverity = IPDR_ERROR;
+	int count = 0;
+	int noOfRecords = 0;
+	long length = 0;
+	FILE* pOutputStream = NULL;
+	byte* pOutput = NULL;
+	IPDRCommonParameters* pReader = NULL;
+	IPDRCommonParameters* pWriter = NULL;
+	IPDRHeader* pIPDRHeader = NULL;
+	FNFData* pFNFData = NULL;
+	FNFData** ppBatch = NULL;
+	DocEnd* pDocEnd = NULL;
+	ListNameSpaceInfo* pNameSpaceInfo = NULL;
+	ListSchemaNameSpace* pListSchemaNameSpace = NULL;
+
+	*ppOutput = NULL;
+	*pLength = 0;
+	*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+
+	pIPDRHeader = newIPDRHeader();
+	pDocEnd = newDocEnd();
+	if (batchSize > 0)
+		ppBatch = (FNFData **) calloc(batchSize, sizeof(FNFData *));
+	if (pIPDRHeader == NULL || pDocEnd == NULL || (batchSize > 0 && ppBatch == NULL))
+		goto cleanup;
+
+	pReader = openStressReader(XDR, fileName, fopen(fileName, "rb"), pIPDRHeader, pErrorCode);
+	if (pReader == NULL)
+		goto cleanup;
+
+	pOutputStream = tmpfile();
+	if (pOutputStream == NULL) {
+		*pErrorCode = IPDR_INVALID_FILE;
+		goto cleanup;
+	}
+	pWriter = newStressParameters(outputType, NONWRITABLE, fileName, pOutputStream);
+	if (pWriter == NULL)
+		goto cleanup;
+
+	if (gSchemaValidation &&
+		acquireSchemaData(pWriter, pIPDRHeader->pOtherNameSpaceInfo_,
+						  pIPDRHeader->pListServiceDefinitionURI_,
+						  pIPDRHeader->defaultNameSpaceURI_, pErrorCode) == IPDR_ERROR)
+		goto cleanup;
+
+	for (pNameSpaceInfo = pIPDRHeader->pOtherNameSpaceInfo_; pNameSpaceInfo != NULL;
+		 pNameSpaceInfo = pNameSpaceInfo->pNext_)
+		appendListSchemaNameSpace(&pListSchemaNameSpace,
+								  pNameSpaceInfo->NameSpaceInfo_.nameSpaceURI_);
+
+	if (writeHeader(pWriter, pIPDRHeader->startTime_, pIPDRHeader->ipdrRecorderInfo_,
+					pIPDRHeader->defaultNameSpaceURI_, pIPDRHeader->pOtherNameSpaceInfo_,
+					pIPDRHeader->pListServiceDefinitionURI_, pIPDRHeader->docID_,
+					pListSchemaNameSpace, pErrorCode) == IPDR_ERROR)
+		goto cleanup;
+
+	while (batchSize == 0) {
+		if (pArena != NULL)
+			resetIPDRArena(pArena);
+		pFNFData = newFNFDataInArena(pArena);
+		if (readIPDR(pReader, &pFNFData, pErrorCode) == IPDR_ERROR)
+			goto cleanup;
+		if (pFNFData == NULL)
+			break;
+		if (writeIPDR(pWriter, pFNFData, pErrorCode) == IPDR_ERROR)
+			goto cleanup;
+		freeFNFData(pFNFData);
+		pFNFData = NULL;
+	}
+
+	noOfRecords = batchSize;
+	while (noOfRecords == batchSize && batchSize > 0) {
+		if (readIPDRBatch(pReader, ppBatch, batchSize, noOfThreads,
+						  &noOfRecords, pErrorCode) == IPDR_ERROR)
+			goto cleanup;
+		for (count = 0; count < noOfRecords; count++) {
+			if (writeIPDR(pWriter, ppBatch[count], pErrorCode) == IPDR_ERROR)
+				goto cleanup;
+			freeFNFData(ppBatch[count]);
+			ppBatch[count] = NULL;
+		}
+	}
+
+	if (readDocEnd(pReader, pDocEnd, pErrorCode) == IPDR_ERROR ||
+		writeDocEnd(pWriter, pErrorCode) == IPDR_ERROR)
+		goto cleanup;
+
+	fflush(pOutputStream);
+	fseek(pOutputStream, 0, SEEK_END);
+	length = ftell(pOutputStream);
+	rewind(pOutputStream);
+	pOutput = (byte *) calloc(length + 1, sizeof(byte));
+	if (pOutput == NULL || (long) fread(pOutput, 1, length, pOutputStream) != length) {
+		free(pOutput);
+		*pErrorCode = IPDR_INVALID_FILE;
+		goto cleanup;
+	}
+	*ppOutput = pOutput;
+	*pLength = length;
+	errorSeverity = IPDR_OK;
+
+cleanup:
+	freeFNFData(pFNFData);
+	for (count = 0; count < batchSize && ppBatch != NULL; count++)
+		freeFNFData(ppBatch[count]);
+	free(ppBatch);
+	freeListSchemaNameSpace(&pListSchemaNameSpace);
+	if (pIPDRHeader != NULL)
+		freeIPDRHeader(pIPDRHeader);
+	if (pDocEnd != NULL)
+		freeDocEnd(pDocEnd);
+	if (pReader != NULL)
+		freeIPDRCommonParameters(pReader);
+	if (pWriter != NULL)
+		freeIPDRCommonParameters(pWriter);
+
+	return (errorSeverity);
+}
+
+
+/*
+ * Reads a converted document back and counts its records.
+ */
+static int countRecords(DocType docType,
+						byte* pDocument,
+						long length,
+						int* pNoOfRecords,
+						int* pErrorCode)
+{
+	int errorSeverity = IPDR_ERROR;
+	FILE* pStream = NULL;
+	IPDRCommonParameters* pReader = NULL;
+	IPDRHeader* pIPDRHeader = NULL;
+	FNFData* pFNFData = NULL;
+
+	*pNoOfRecords = 0;
+
+	pStream = tmpfile();
+	if (pStream == NULL || (long) fwrite(pDocument, 1, length, pStream) != length) {
+		if (pStream != NULL)
+			fclose(pStream);
+		*pErrorCode = IPDR_INVALID_FILE;
+		return (IPDR_ERROR);
+	}
+	fflush(pStream);
+	rewind(pStream);
+
+	pIPDRHeader = newIPDRHeader();
+	if (pIPDRHeader == NULL) {
+		fclose(pStream);
+		*pErrorCode = IPDR_MEMORY_ALLOCATION_FAILED;
+		return (IPDR_ERROR);
+	}
+
+	pReader = openStressReader(docType, "tmpfile", pStream, pIPDRHeader, pErrorCode);
+	if (pReader != NULL) {
+		while (1) {
+			pFNFData = newFNFData();
+			if (readIPDR(pReader, &pFNFData, pErrorCode) == IPDR_ERROR)
+				break;
+			if (pFNFData == NULL) {
+				errorSeverity = IPDR_OK;
+				break;
+			}
+			freeFNFData(pFNFData);
+			pFNFData = NULL;
+			(*pNoOfRecords)++;
+		}
+		freeFNFData(pFNFData);
+		freeIPDRCommonParameters(pReader);
+	}
+	freeIPDRHeader(pIPDRHeader);
+
+	return (errorSeverity);
+}
+
+
+/*
+ * Converts a document to XDR and XML and checks the outputs against
+ * the reference, or sets the reference if there is none yet.
+ */
+static int checkDocument(StressDocument* pDocument)
+{
+	int failures = 0;
+	int type = 0;
+	int errorCode = 0;
+	int noOfRecords = 0;
+	long length = 0;
+	byte* pOutput = NULL;
+
+	for (type = 0; type < 2; type++) {
+		if (convertDocument(pDocument->pFileName_, gOutputTypes[type], 0, 1, NULL,
+							&pOutput, &length, &errorCode) != IPDR_OK ||
+			countRecords(gOutputTypes[type], pOutput, length,
+						 &noOfRecords, &errorCode) != IPDR_OK) {
+			printf("%s: conversion to %s failed with error %d\n", pDocument->pFileName_,
+				   gOutputTypes[type] == XDR ? "XDR" : "XML", errorCode);
+			free(pOutput);
+			failures++;
+			continue;
+		}
+
+		maskWriteTimes(gOutputTypes[type], pOutput, length);
+
+		if (pDocument->pReference_[type] == NULL) {
+			pDocument->pReference_[type] = pOutput;
+			pDocument->referenceLength_[type] = length;
+			if (type == 0)
+				pDocument->noOfRecords_ = noOfRecords;
+			pOutput = NULL;
+		}
+		else if (length != pDocument->referenceLength_[type] ||
+				 memcmp(pOutput, pDocument->pReference_[type], length) != 0) {
+			printf("%s: %s output differs from the single threaded conversion\n",
+				   pDocument->pFileName_, gOutputTypes[type] == XDR ? "XDR" : "XML");
+			failures++;
+		}
+
+		if (noOfRecords != pDocument->noOfRecords_) {
+			printf("%s: %d records read back from the %s output, expected %d\n",
+				   pDocument->pFileName_, noOfRecords,
+				   gOutputTypes[type] == XDR ? "XDR" : "XML", pDocument->noOfRecords_);
+			failures++;
+		}
+		free(pOutput);
+		pOutput = NULL;
+	}
+
+	return (failures);
+}
+
+
+static void runStressJob(void* pArgument)
+{
+	int round = 0;
+	int count = 0;
+	int errorCode = 0;
+	StressJob* pJob = (StressJob *) pArgument;
+
+	for (round = 0; round < pJob->rounds_; round++) {
+		for (count = 0; count < pJob->noOfDocuments_; count++)
+			pJob->failures_ += checkDocument(&pJob->pDocuments_[
+				(pJob->first_ + count) % pJob->noOfDocuments_]);
+
+		for (count = 0; count < STRESS_UUIDS_PER_ROUND; count++) {
+			getUUID(pJob->pUUIDs_ + pJob->noOfUUIDs_ * STRESS_UUID_LENGTH, &errorCode);
+			pJob->noOfUUIDs_++;
+		}
+	}
+}
+
+
+/*
+ * Re-encodes every document to XDR with its records read by
+ * readIPDRBatch() in batches of several sizes, and checks the output
+ * against the reference.
+ */
+static int checkBatchRead(StressDocument* pDocuments,
+						  int noOfDocuments,
+						  int noOfThreads)
+{
+	int failures = 0;
+	int index = 0;
+	int size = 0;
+	int errorCode = 0;
+	long length = 0;
+	byte* pOutput = NULL;
+
+	for (index = 0; index < noOfDocuments; index++) {
+		for (size = 0; size < STRESS_NO_OF_BATCH_SIZES; size++) {
+			if (convertDocument(pDocuments[index].pFileName_, XDR, gBatchSizes[size],
+								noOfThreads, NULL, &pOutput, &length, &errorCode) != IPDR_OK) {
+				printf("%s: batch read of %d records failed with error %d\n",
+					   pDocuments[index].pFileName_, gBatchSizes[size], errorCode);
+				failures++;
+				continue;
+			}
+
+			maskWriteTimes(XDR, pOutput, length);
+			if (length != pDocuments[index].referenceLength_[0] ||
+				memcmp(pOutput, pDocuments[index].pReference_[0], length) != 0) {
+				printf("%s: batch read of %d records differs from readIPDR\n",
+					   pDocuments[index].pFileName_, gBatchSizes[size]);
+				failures++;
+			}
+			free(pOutput);
+			pOutput = NULL;
+		}
+	}
+
+	return (failures);
+}
+
+
+/*
+ * Re-encodes every document to XDR and XML with its records read
+ * into an arena reset for each record, and checks the outputs against
+ * the references.
+ */
+static int checkArenaRead(StressDocument* pDocuments,
+						  int noOfDocuments)
+{
+	int failures = 0;
+	int index = 0;
+	int type = 0;
+	int errorCode = 0;
+	long length = 0;
+	byte* pOutput = NULL;
+	IPDRArena* pArena = NULL;
+
+	pArena = newIPDRArena(0);
+	if (pArena == NULL)
+		return (1);
+
+	for (index = 0; index < noOfDocuments; index++) {
+		for (type = 0; type < 2; type++) {
+			if (convertDocument(pDocuments[index].pFileName_, gOutputTypes[type], 0, 1,
+								pArena, &pOutput, &length, &errorCode) != IPDR_OK) {
+				printf("%s: arena read failed with error %d\n",
+					   pDocuments[index].pFileName_, errorCode);
+				failures++;
+				continue;
+			}
+
+			maskWriteTimes(gOutputTypes[type], pOutput, length);
+			if (length != pDocuments[index].referenceLength_[type] ||
+				memcmp(pOutput, pDocuments[index].pReference_[type], length) != 0) {
+				printf("%s: %s output of an arena read differs from readIPDR\n",
+					   pDocuments[index].pFileName_, gOutputTypes[type] == XDR ? "XDR" : "XML");
+				failures++;
+			}
+			free(pOutput);
+			pOutput = NULL;
+		}
+	}
+
+	freeIPDRArena(pArena);
+
+	return (failures);
+}
+
+
+/*
+ * Reads a whole file and closes it. Returns its contents, NUL
+ * terminated, or NULL if it can not be read.
+ */
+static byte* readStressFile(FILE* pStream, long* pLength)
+{
+	byte* pContents = NULL;
+
+	fseek(pStream, 0, SEEK_END);
+	*pLength = ftell(pStream);
+	rewind(pStream);
+	pContents = (byte *) calloc(*pLength + 1, sizeof(byte));
+	if (pContents != NULL && (long) fread(pContents, 1, *pLength, pStream) != *pLength) {
+		free(pContents);
+		pContents = NULL;
+	}
+	fclose(pStream);
+
+	return (pContents);
+}
+
+
+/*
+ * Reads a document whose element after its first record has an
+ * invalid discriminator, one record at a time and then in batches.
+ * Both reads must fail, leaving the document unreadable with the
+ * error recorded.
+ */
+static int checkInvalidDiscriminator(StressDocument* pDocument,
+									 int noOfThreads)
+{
+	int failures = 0;
+	int batched = 0;
+	int errorCode = 0;
+	int noOfRecords = 0;
+	long length = 0;
+	size_t offset = 0;
+	byte* pContents = NULL;
+	FILE* pStream = NULL;
+	FNFData* pFNFData = NULL;
+	FNFData* ppBatch[STRESS_INVALID_BATCH_SIZE];
+	IPDRHeader* pIPDRHeader = NULL;
+	IPDRCommonParameters* pReader = NULL;
+
+	pStream = fopen(pDocument->pFileName_, "rb");
+	pContents = pStream != NULL ? readStressFile(pStream, &length) : NULL;
+	pIPDRHeader = newIPDRHeader();
+	pFNFData = newFNFData();
+	pReader = openStressReader(XDR, pDocument->pFileName_, fopen(pDocument->pFileName_, "rb"),
+							   pIPDRHeader, &errorCode);
+	if (pContents == NULL || pIPDRHeader == NULL || pFNFData == NULL || pReader == NULL ||
+		readIPDR(pReader, &pFNFData, &errorCode) == IPDR_ERROR || pFNFData == NULL) {
+		printf("%s: cannot read the first record, error %d\n", pDocument->pFileName_, errorCode);
+		failures++;
+	}
+	else {
+		offset = pReader->pInputBuffer_->offset_;
+	}
+	freeFNFData(pFNFData);
+	if (pReader != NULL)
+		freeIPDRCommonParameters(pReader);
+	if (pIPDRHeader != NULL)
+		freeIPDRHeader(pIPDRHeader);
+
+	for (batched = 0; batched < 2 && failures == 0; batched++) {
+		memset(pContents + offset, 0x7f, 4);
+		pStream = tmpfile();
+		if (pStream == NULL || (long) fwrite(pContents, 1, length, pStream) != length) {
+			failures++;
+			break;
+		}
+		fflush(pStream);
+		rewind(pStream);
+
+		pIPDRHeader = newIPDRHeader();
+		pReader = openStressReader(XDR, "tmpfile", pStream, pIPDRHeader, &errorCode);
+		if (pReader == NULL) {
+			freeIPDRHeader(pIPDRHeader);
+			failures++;
+			break;
+		}
+
+		errorCode = IPDR_OK;
+		do {
+			if (batched) {
+				if (readIPDRBatch(pReader, ppBatch, STRESS_INVALID_BATCH_SIZE, noOfThreads,
+								  &noOfRecords, &errorCode) == IPDR_ERROR)
+					break;
+				while (noOfRecords > 0)
+					freeFNFData(ppBatch[--noOfRecords]);
+			}
+			else {
+				pFNFData = newFNFData();
+				if (readIPDR(pReader, &pFNFData, &errorCode) == IPDR_ERROR)
+					break;
+				noOfRecords = (pFNFData != NULL);
+				freeFNFData(pFNFData);
+				pFNFData = NULL;
+			}
+		} while (noOfRecords > 0);
+		freeFNFData(pFNFData);
+		pFNFData = NULL;
+
+		if (errorCode != IPDR_INVALID_DESCRIMINATOR ||
+			pReader->DocState_ != NONREADABLE ||
+			pReader->pExceptionStructure_->errorCode_ != IPDR_INVALID_DESCRIMINATOR) {
+			printf("%s: %s of an invalid discriminator gave error %d, exception %d\n",
+				   pDocument->pFileName_, batched ? "readIPDRBatch" : "readIPDR", errorCode,
+				   pReader->pExceptionStructure_->errorCode_);
+			failures++;
+		}
+		freeIPDRCommonParameters(pReader);
+		freeIPDRHeader(pIPDRHeader);
+	}
+	free(pContents);
+
+	return (failures);
+}
+
+
+/*
+ * Copies the default files from pTestData into the work directory and
+ * changes to it.
+ */
+static int enterWorkDirectory(const char* pTestData)
+{
+	int count = 0;
+	long length = 0;
+	char fileName[STRESS_MAX_PATH];
+	byte* pContents = NULL;
+	FILE* pStream = NULL;
+
+	mkdir(STRESS_WORK_DIRECTORY, 0755);
+
+	for (count = 0; count < (int) (sizeof(gDefaultFiles) / sizeof(gDefaultFiles[0])); count++) {
+		snprintf(fileName, sizeof(fileName), "%s/%s/%s", pTestData,
+				 STRESS_DEFAULT_DIRECTORY, gDefaultFiles[count]);
+		pStream = fopen(fileName, "rb");
+		pContents = pStream != NULL ? readStressFile(pStream, &length) : NULL;
+		if (pContents == NULL) {
+			printf("cannot read %s\n", fileName);
+			return (IPDR_ERROR);
+		}
+
+		snprintf(fileName, sizeof(fileName), "%s/%s", STRESS_WORK_DIRECTORY,
+				 gDefaultFiles[count]);
+		pStream = fopen(fileName, "wb");
+		if (pStream == NULL || (long) fwrite(pContents, 1, length, pStream) != length) {
+			printf("cannot write %s\n", fileName);
+			if (pStream != NULL)
+				fclose(pStream);
+			free(pContents);
+			return (IPDR_ERROR);
+		}
+		fclose(pStream);
+		free(pContents);
+	}
+
+	if (chdir(STRESS_WORK_DIRECTORY) != 0) {
+		printf("cannot change to %s\n", STRESS_WORK_DIRECTORY);
+		return (IPDR_ERROR);
+	}
+
+	return (IPDR_OK);
+}
+
+
+/*
+ * Removes the work directory and what was written to it.
+ */
+static void leaveWorkDirectory(void)
+{
+	int count = 0;
+
+	for (count = 0; count < (int) (sizeof(gDefaultFiles) / sizeof(gDefaultFiles[0])); count++)
+		remove(gDefaultFiles[count]);
+	for (count = 0; count < (int) (sizeof(gUUIDFiles) / sizeof(gUUIDFiles[0])); count++)
+		remove(gUUIDFiles[count]);
+
+	if (chdir("..") == 0)
+		rmdir(STRESS_WORK_DIRECTORY);
+}
+
+
+/*
+ * Converts every document to XDR and XML rounds times with
+ * convertIPDRDocuments() and checks the output files against the
+ * references.
+ */
+static int checkBatchConversion(StressDocument* pDocuments,
+								int noOfDocuments,
+								int noOfThreads,
+								int rounds)
+{
+	int failures = 0;
+	int noOfJobs = noOfDocuments * 2 * rounds;
+	int count = 0;
+	int type = 0;
+	int errorCode = 0;
+	long length = 0;
+	byte* pOutput = NULL;
+	FILE* pStream = NULL;
+	StressDocument* pDocument = NULL;
+	IPDRConversionJob* pJobs = NULL;
+	IPDRConversionStatistics statistics;
+
+	pJobs = (IPDRConversionJob *) calloc(noOfJobs, sizeof(IPDRConversionJob));
+	if (pJobs == NULL)
+		return (1);
+
+	for (count = 0; count < noOfJobs; count++) {
+		pDocument = &pDocuments[count % noOfDocuments];
+		pJobs[count].pInputFileName_ = pDocument->pFileName_;
+		pJobs[count].inputType_ = XDR;
+		pJobs[count].outputType_ = gOutputTypes[(count / noOfDocuments) % 2];
+		pJobs[count].pOutputFileName_ = (char *) calloc(strlen(pDocument->pFileName_) + 20, sizeof(char));
+		if (pJobs[count].pOutputFileName_ == NULL)
+			return (1);
+		sprintf(pJobs[count].pOutputFileName_, "%s.%d.batch", pDocument->pFileName_, count);
+	}
+
+	if (convertIPDRDocuments(pJobs, noOfJobs, noOfThreads, gIPDRVersion,
+							 gSchemaValidation, &statistics, &errorCode) != IPDR_OK) {
+		printf("Batch conversion failed with error %d\n", errorCode);
+		failures++;
+	}
+
+	for (count = 0; count < noOfJobs; count++) {
+		pDocument = &pDocuments[count % noOfDocuments];
+		type = (count / noOfDocuments) % 2;
+		pStream = fopen(pJobs[count].pOutputFileName_, "rb");
+		if (pJobs[count].errorCode_ != 0 || pStream == NULL) {
+			printf("%s: batch conversion failed with error %d\n",
+				   pJobs[count].pOutputFileName_, pJobs[count].errorCode_);
+			if (pStream != NULL)
+				fclose(pStream);
+			failures++;
+			continue;
+		}
+
+		pOutput = readStressFile(pStream, &length);
+		if (pOutput != NULL)
+			maskWriteTimes(gOutputTypes[type], pOutput, length);
+		remove(pJobs[count].pOutputFileName_);
+
+		if (pOutput == NULL || length != pDocument->referenceLength_[type] ||
+			memcmp(pOutput, pDocument->pReference_[type], length) != 0 ||
+			pJobs[count].noOfRecords_ != pDocument->noOfRecords_) {
+			printf("%s: batch output differs from the single threaded conversion\n",
+				   pJobs[count].pOutputFileName_);
+			failures++;
+		}
+		free(pOutput);
+	}
+
+	if (failures == 0)
+		printf("Batch: %d documents, %ld records on %d threads in %.3f s, "
+			   "%.0f records/s, %.0f bytes/s\n",
+			   statistics.noOfDocuments_, statistics.noOfRecords_,
+			   statistics.noOfThreads_, statistics.elapsedSeconds_,
+			   statistics.recordsPerSecond_, statistics.bytesPerSecond_);
+
+	for (count = 0; count < noOfJobs; count++)
+		free(pJobs[count].pOutputFileName_);
+	free(pJobs);
+
+	return (failures);
+}
+
+
+/*
+ * Converts every document to XML, typed by its schema, and then
+ * converts that XML rounds times to XML again with
+ * convertIPDRDocuments(). The records written must be those read.
+ * Headers are not compared, the XML reader does not keep the form
+ * of the schema location.
+ */
+static int checkXMLInput(StressDocument* pDocuments,
+						 int noOfDocuments,
+						 int noOfThreads,
+						 int rounds)
+{
+	int failures = 0;
+	int index = 0;
+	int count = 0;
+	int errorCode = 0;
+	long length = 0;
+	long referenceLength = 0;
+	byte* pOutput = NULL;
+	byte* pReference = NULL;
+	char* pOutputRecords = NULL;
+	char* pReferenceRecords = NULL;
+	FILE* pStream = NULL;
+	IPDRConversionJob* pJobs = NULL;
+	IPDRConversionStatistics statistics;
+
+	pJobs = (IPDRConversionJob *) calloc(rounds + 1, sizeof(IPDRConversionJob));
+	if (pJobs == NULL)
+		return (1);
+
+	for (index = 0; index < noOfDocuments; index++) {
+		for (count = 0; count <= rounds; count++) {
+			pJobs[count].pOutputFileName_ =
+				(char *) calloc(strlen(pDocuments[index].pFileName_) + 20, sizeof(char));
+			if (pJobs[count].pOutputFileName_ == NULL)
+				return (1);
+			sprintf(pJobs[count].pOutputFileName_, "%s.%d.xml", pDocuments[index].pFileName_, count);
+			pJobs[count].pInputFileName_ = pJobs[0].pOutputFileName_;
+			pJobs[count].inputType_ = XML;
+			pJobs[count].outputType_ = XML;
+		}
+		pJobs[0].pInputFileName_ = pDocuments[index].pFileName_;
+		pJobs[0].inputType_ = XDR;
+
+		pStream = NULL;
+		if (convertIPDRDocument(&pJobs[0], gIPDRVersion, 1) != IPDR_OK ||
+			(pStream = fopen(pJobs[0].pOutputFileName_, "rb")) == NULL ||
+			(pReference = readStressFile(pStream, &referenceLength)) == NULL) {
+			printf("%s: conversion to XML failed with error %d\n",
+				   pDocuments[index].pFileName_, pJobs[0].errorCode_);
+			failures++;
+		}
+		else if (convertIPDRDocuments(pJobs + 1, rounds, noOfThreads, gIPDRVersion, 1,
+									  &statistics, &errorCode) != IPDR_OK) {
+			printf("%s: conversion of XML failed with error %d\n",
+				   pDocuments[index].pFileName_, errorCode);
+			failures++;
+		}
+
+		if (pReference != NULL) {
+			maskWriteTimes(XML, pReference, referenceLength);
+			pReferenceRecords = strstr((char *) pReference, "<IPDR ");
+		}
+		for (count = 1; count <= rounds && failures == 0; count++) {
+			pStream = fopen(pJobs[count].pOutputFileName_, "rb");
+			pOutput = pStream != NULL ? readStressFile(pStream, &length) : NULL;
+			if (pOutput != NULL)
+				maskWriteTimes(XML, pOutput, length);
+			pOutputRecords = pOutput != NULL ? strstr((char *) pOutput, "<IPDR ") : NULL;
+			if (pOutputRecords == NULL || pReferenceRecords == NULL ||
+				strcmp(pOutputRecords, pReferenceRecords) != 0 ||
+				pJobs[count].noOfRecords_ != pDocuments[index].noOfRecords_) {
+				printf("%s: records converted from XML differ from those read\n",
+					   pJobs[count].pOutputFileName_);
+				failures++;
+			}
+			free(pOutput);
+		}
+
+		free(pReference);
+		pReference = NULL;
+		pReferenceRecords = NULL;
+		for (count = 0; count <= rounds; count++) {
+			remove(pJobs[count].pOutputFileName_);
+			free(pJobs[count].pOutputFileName_);
+			pJobs[count].pOutputFileName_ = NULL;
+		}
+	}
+	free(pJobs);
+
+	return (failures);
+}
+
+
+static int compareUUIDs(const void* pFirst, const void* pSecond)
+{
+	return (strcmp((const char *) pFirst, (const char *) pSecond));
+}
+
+
+/*
+ * Converts each XDR document given to XDR and XML, once on one thread
+ * and then again on every thread at once, and compares the outputs.
+ * The threads also generate UUIDs, which must all differ. Last, the
+ * same conversions are run through the batch converter, which also
+ * converts the documents from XML. Without documents given, the
+ * default one of IPDR_TESTDATA is converted in a work directory.
+ */
+int main(int argc, char *argv[])
+{
+	int noOfThreads = STRESS_DEFAULT_THREADS;
+	int rounds = STRESS_DEFAULT_ROUNDS;
+	int noOfDocuments = 0;
+	int noOfUUIDs = 0;
+	int failures = 0;
+	int count = 0;
+	int index = 0;
+	int useDefault = IPDR_FALSE;
+	int versionGiven = IPDR_FALSE;
+	char* pUUIDs = NULL;
+	const char* pTestData = getenv("IPDR_TESTDATA");
+	StressDocument* pDocuments = NULL;
+	StressJob* pJobs = NULL;
+	IPDRThread* pThreads = NULL;
+
+	pDocuments = (StressDocument *) calloc(argc + 1, sizeof(StressDocument));
+	if (pDocuments == NULL)
+		return (1);
+
+	for (count = 1; count < argc; count++) {
+		if (strcmp(argv[count], "-threads") == 0 && count + 1 < argc) {
+			noOfThreads = atoi(argv[++count]);
+		} else if (strcmp(argv[count], "-rounds") == 0 && count + 1 < argc) {
+			rounds = atoi(argv[++count]);
+		} else if (strcmp(argv[count], "-ipdrversion") == 0 && count + 1 < argc) {
+			strncpy(gIPDRVersion, argv[++count], MAX_SCHEMA_VERSION - 1);
+			versionGiven = IPDR_TRUE;
+		} else if (strcmp(argv[count], "-schemavalidation") == 0) {
+			gSchemaValidation = 1;
+		} else if (argv[count][0] != '-') {
+			pDocuments[noOfDocuments++].pFileName_ = argv[count];
+		} else {
+			noOfDocuments = -1;
+			break;
+		}
+	}
+
+	if (noOfDocuments == 0) {
+		useDefault = IPDR_TRUE;
+		if (enterWorkDirectory(pTestData != NULL ? pTestData : "testdata") != IPDR_OK) {
+			free(pDocuments);
+			return (1);
+		}
+		pDocuments[noOfDocuments++].pFileName_ = (char *) STRESS_DEFAULT_DOCUMENT;
+		if (versionGiven == IPDR_FALSE)
+			strcpy(gIPDRVersion, STRESS_DEFAULT_VERSION);
+	}
+
+	if (noOfDocuments < 0 || noOfThreads < 1 || rounds < 1) {
+		printf("Usage: IPDRThreadStress [-threads N] [-rounds N] "
+			   "[-ipdrversion 3.5/3.1] [-schemavalidation] [Infile.xdr ...]\n");
+		free(pDocuments);
+		return (1);
+	}
+
+	for (index = 0; index < noOfDocuments; index++) {
+		if (checkDocument(&pDocuments[index]) != 0) {
+			if (useDefault == IPDR_TRUE)
+				leaveWorkDirectory();
+			return (1);
+		}
+	}
+
+	noOfUUIDs = noOfThreads * rounds * STRESS_UUIDS_PER_ROUND;
+	pUUIDs = (char *) calloc(noOfUUIDs, STRESS_UUID_LENGTH);
+	pJobs = (StressJob *) calloc(noOfThreads, sizeof(StressJob));
+	pThreads = (IPDRThread *) calloc(noOfThreads, sizeof(IPDRThread));
+	if (pUUIDs == NULL || pJobs == NULL || pThreads == NULL)
+		return (1);
+
+	for (count = 0; count < noOfThreads; count++) {
+		pJobs[count].pDocuments_ = pDocuments;
+		pJobs[count].noOfDocuments_ = noOfDocuments;
+		pJobs[count].rounds_ = rounds;
+		pJobs[count].first_ = count % noOfDocuments;
+		pJobs[count].pUUIDs_ = pUUIDs + count * rounds * STRESS_UUIDS_PER_ROUND * STRESS_UUID_LENGTH;
+		if (startIPDRThread(&pThreads[count], runStressJob, &pJobs[count]) != IPDR_OK)
+			return (1);
+	}
+
+	for (count = 0; count < noOfThreads; count++) {
+		joinIPDRThread(&pThreads[count]);
+		failures += pJobs[count].failures_;
+	}
+
+	qsort(pUUIDs, noOfUUIDs, STRESS_UUID_LENGTH, compareUUIDs);
+	for (count = 1; count < noOfUUIDs; count++) {
+		if (strcmp(pUUIDs + (count - 1) * STRESS_UUID_LENGTH,
+				   pUUIDs + count * STRESS_UUID_LENGTH) == 0) {
+			printf("UUID %s generated twice\n", pUUIDs + count * STRESS_UUID_LENGTH);
+			failures++;
+		}
+	}
+
+	failures += checkBatchConversion(pDocuments, noOfDocuments, noOfThreads, rounds);
+	failures += checkBatchRead(pDocuments, noOfDocuments, noOfThreads);
+	failures += checkArenaRead(pDocuments, noOfDocuments);
+	failures += checkXMLInput(pDocuments, noOfDocuments, noOfThreads, rounds);
+	for (index = 0; index < noOfDocuments; index++)
+		failures += checkInvalidDiscriminator(&pDocuments[index], noOfThreads);
+
+	for (index = 0; index < noOfDocuments; index++) {
+		free(pDocuments[index].pReference_[0]);
+		free(pDocuments[index].pReference_[1]);
+	}
+	free(pDocuments);
+	free(pJobs);
+	free(pThreads);
+	free(pUUIDs);
+	clearSchemaRegistry();
+	if (useDefault == IPDR_TRUE)
+		leaveWorkDirectory();
+
+	if (failures != 0) {
+		printf("FAILED: %d mismatches\n", failures);
+		return (1);
+	}
+
+	printf("OK: %d documents converted %d times on %d threads, %d UUIDs unique\n",
+		   noOfDocuments, rounds * noOfThreads, noOfThreads, noOfUUIDs);
+	return (0);
+}
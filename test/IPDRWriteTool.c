@@ -353,8 +353,8 @@ int populateIPDRCommonParameters(
 	pIPDRCommonParameters->DocState_ = NONWRITABLE;
 	pIPDRCommonParameters->DocType_ = 0;
 	pIPDRCommonParameters->descriptorCount_ = 1;
-	pIPDRCommonParameters->pDescriptorLookupHashTable_ = 
-		                      HashTableCreate(numOfBuckets);
+	pIPDRCommonParameters->pDescriptorLookupMap_ = 
+		                      newIPDRIntMap(numOfBuckets, free);
 	pIPDRCommonParameters->IPDRCount_.ipdrRecordCount_ = 1;
 	pIPDRCommonParameters->pDescriptorLookupList_ = NULL;
 	pIPDRCommonParameters->pListErrorStructure_ = NULL;                    
@@ -699,6 +699,19 @@ int validateInputParams(
 			}
 		}
 
+		/*Catches the commandline parameter -schemacache. Also reads
+		the schema cache directory from the next commandline parameter*/
+		if ((strcmp(tempString,	"-SCHEMACACHE")) == 0) {
+			if(!(countArguments==(unsigned int)(argCount-1))) {
+				if (setSchemaCacheDirectory(argValues[countArguments+1],
+					pErrorCode) == IPDR_ERROR) {
+					return(IPDR_ERROR);
+				}
+				countValidArgs += 2;
+				countArguments++;
+			}
+		}
+
 		/*Catches the commandline parameter -ipdrversion*/
 		if ((strcmp(tempString,	"-IPDRVERSION")) == 0) {
 			*versionFlag = 1;
@@ -2548,7 +2561,7 @@ if(pCurrentListAttrDesc->pAttributeDescriptor_->complexType_[0] != '\0') {
 
 int printUsage()
 {
-	printf("\nCorrect Input String is: -doctype XDR/XML -outfile OutputFileName <-schemavalidation> <-ipdrversion 3.5/3.1> <-recordcount> <No Of Records> <-roundrobin> TestDataFile1 <TestDataFile2> <TestDataFile3>");
+	printf("\nCorrect Input String is: -doctype XDR/XML -outfile OutputFileName <-schemavalidation> <-schemacache CacheDirectory> <-ipdrversion 3.5/3.1> <-recordcount> <No Of Records> <-roundrobin> TestDataFile1 <TestDataFile2> <TestDataFile3>");
 	return (IPDR_OK);
 }
 
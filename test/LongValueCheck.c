@@ -0,0 +1,287 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : LongValueCheck             *
+ * Description          : Checks that values longer  *
+ *                        than MAX_IPDR_STRING and   *
+ *                        descriptor types longer    *
+ *                        than MAX_ATTRIBUTE_TYPE    *
+ *                        are kept whole             *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils/IPDRCommon.h"
+#include "utils/IPDRMemory.h"
+#include "utils/errorCode.h"
+#include "common/IPDRDocReader.h"
+#include "common/IPDRDocWriter.h"
+#include "xdr/XDRInputBuffer.h"
+#include "CheckUtil.h"
+
+#define LONG_DEFAULT_DOCUMENT		"testcase8/primitiveTypes.1.xdr"
+#define LONG_MAX_PATH				1024
+#define LONG_NO_OF_VALUES			3
+
+/* Lengths of the values written, all above MAX_IPDR_STRING */
+static const int gLengths[LONG_NO_OF_VALUES] = {
+	MAX_IPDR_STRING + 1,
+	3 * MAX_IPDR_STRING,
+	10 * MAX_IPDR_STRING + 7
+};
+
+
+/*
+ * A value of the given length. Spaces and characters the XML writer
+ * escapes are mixed in, so the XML reader gets the text in several
+ * pieces.
+ */
+static char* newLongValue(int length, int seed)
+{
+	int count = 0;
+	char* pValue = NULL;
+	static const char characters[] = "abcdefghijklmnopqrstuvwxyz0123456789 &<>";
+
+	pValue = (char *) calloc(length + 1, sizeof(char));
+	if (pValue == NULL)
+		return (NULL);
+
+	for (count = 0; count < length; count++)
+		pValue[count] = characters[(count * 7 + seed) % (sizeof(characters) - 1)];
+	/* The XML reader drops leading white space */
+	pValue[0] = 'x';
+	pValue[length - 1] = 'y';
+
+	return (pValue);
+}
+
+
+/*
+ * Writes the first record of the document once per long value to a
+ * document of docType and reads the values back.
+ */
+static int checkRoundTrip(const char* fileName, DocType docType, char** ppValues)
+{
+	int failures = 0;
+	int count = 0;
+	int errorCode = 0;
+	char attributeName[MAX_ATTRIBUTE_NAME] = "";
+	const char* pRead = NULL;
+	FILE* pInputStream = NULL;
+	FILE* pOutputStream = NULL;
+	IPDRCommonParameters* pReader = NULL;
+	IPDRCommonParameters* pWriter = NULL;
+	IPDRHeader* pIPDRHeader = NULL;
+	IPDRHeader* pCopyHeader = NULL;
+	FNFData* pFNFData = NULL;
+	FNFData* pReadFNFData = NULL;
+	ListIPDRData* pStringValue = NULL;
+	ListSchemaNameSpace* pListSchemaNameSpace = NULL;
+	ListNameSpaceInfo* pNameSpaceInfo = NULL;
+	const char* docName = (docType == XML) ? "XML" : "XDR";
+
+	pIPDRHeader = newIPDRHeader();
+	pCopyHeader = newIPDRHeader();
+	pFNFData = newFNFData();
+	pInputStream = fopen(fileName, "rb");
+	pOutputStream = tmpfile();
+	if (pIPDRHeader == NULL || pCopyHeader == NULL || pFNFData == NULL ||
+		pInputStream == NULL || pOutputStream == NULL) {
+		printf("%s: cannot open the document\n", fileName);
+		return (1);
+	}
+
+	pReader = newCheckParameters(XDR, NONREADABLE, IPDR_VERSION_3_5, pInputStream);
+	if (pReader == NULL ||
+		setXDRInputBuffer(pReader, XDR_INPUT_MMAP, &errorCode) == IPDR_ERROR ||
+		readHeader(pReader, pIPDRHeader, &errorCode) == IPDR_ERROR ||
+		readIPDR(pReader, &pFNFData, &errorCode) == IPDR_ERROR ||
+		pFNFData == NULL) {
+		printf("%s: cannot read the first record, error %d\n", fileName, errorCode);
+		return (1);
+	}
+
+	pStringValue = findStringValue(pFNFData, NULL);
+	if (pStringValue == NULL) {
+		printf("%s: the first record has no string attribute\n", fileName);
+		return (1);
+	}
+	strncpy(attributeName, findAttributeName(pFNFData, pStringValue), sizeof(attributeName) - 1);
+
+	pWriter = newCheckParameters(docType, NONWRITABLE, IPDR_VERSION_3_5, pOutputStream);
+	if (pWriter == NULL)
+		return (1);
+	for (pNameSpaceInfo = pIPDRHeader->pOtherNameSpaceInfo_; pNameSpaceInfo != NULL;
+		 pNameSpaceInfo = pNameSpaceInfo->pNext_)
+		appendListSchemaNameSpace(&pListSchemaNameSpace,
+								  pNameSpaceInfo->NameSpaceInfo_.nameSpaceURI_);
+	if (writeHeader(pWriter, pIPDRHeader->startTime_, pIPDRHeader->ipdrRecorderInfo_,
+					pIPDRHeader->defaultNameSpaceURI_, pIPDRHeader->pOtherNameSpaceInfo_,
+					pIPDRHeader->pListServiceDefinitionURI_, pIPDRHeader->docID_,
+					pListSchemaNameSpace, &errorCode) == IPDR_ERROR) {
+		printf("%s: writeHeader failed, error %d\n", docName, errorCode);
+		return (1);
+	}
+
+	for (count = 0; count < LONG_NO_OF_VALUES; count++) {
+		pFNFData->descriptorID_ = 0;
+		if (setListIPDRDataValue(pStringValue, (void *) ppValues[count], -1,
+								 IPDRDATA_STRING) != IPDR_OK ||
+			writeIPDR(pWriter, pFNFData, &errorCode) == IPDR_ERROR) {
+			printf("%s: writeIPDR failed, error %d\n", docName, errorCode);
+			return (1);
+		}
+	}
+	if (writeDocEnd(pWriter, &errorCode) == IPDR_ERROR) {
+		printf("%s: writeDocEnd failed, error %d\n", docName, errorCode);
+		return (1);
+	}
+	fflush(pOutputStream);
+	rewind(pOutputStream);
+
+	/* The reader takes the stream over */
+	pWriter->pStreamHandle_ = NULL;
+	freeIPDRCommonParameters(pWriter);
+	pWriter = newCheckParameters(docType, NONREADABLE, IPDR_VERSION_3_5, pOutputStream);
+	if (pWriter == NULL ||
+		(docType == XDR &&
+		 setXDRInputBuffer(pWriter, XDR_INPUT_MMAP, &errorCode) == IPDR_ERROR) ||
+		readHeader(pWriter, pCopyHeader, &errorCode) == IPDR_ERROR) {
+		printf("%s: cannot read the header back, error %d\n", docName, errorCode);
+		return (1);
+	}
+
+	for (count = 0; count < LONG_NO_OF_VALUES; count++) {
+		pReadFNFData = newFNFData();
+		if (readIPDR(pWriter, &pReadFNFData, &errorCode) == IPDR_ERROR ||
+			pReadFNFData == NULL) {
+			printf("%s: record %d cannot be read back, error %d\n",
+				   docName, count + 1, errorCode);
+			return (1);
+		}
+		pStringValue = findStringValue(pReadFNFData, attributeName);
+		pRead = (pStringValue == NULL) ? "" :
+			(const char *) pStringValue->IPDRDataUnion_.IPDRUTF8Array_;
+		if (strcmp(pRead, ppValues[count]) != 0) {
+			printf("%s: record %d: %d characters written, %d read back\n",
+				   docName, count + 1, (int) strlen(ppValues[count]), (int) strlen(pRead));
+			failures++;
+		}
+		freeFNFData(pReadFNFData);
+	}
+
+	freeListSchemaNameSpace(&pListSchemaNameSpace);
+	freeFNFData(pFNFData);
+	freeIPDRHeader(pIPDRHeader);
+	freeIPDRHeader(pCopyHeader);
+	freeIPDRCommonParameters(pReader);
+	freeIPDRCommonParameters(pWriter);
+
+	return (failures);
+}
+
+
+/*
+ * Sets a descriptor type longer than MAX_ATTRIBUTE_TYPE, then a
+ * shorter one, on a descriptor on the heap and on one in an arena.
+ */
+static int checkDescriptorStrings(void)
+{
+	int failures = 0;
+	int pass = 0;
+	char longType[3 * MAX_ATTRIBUTE_TYPE];
+	IPDRArena* pArena = NULL;
+	ListAttributeDescriptor* pHeapList = NULL;
+	ListAttributeDescriptor* pArenaList = NULL;
+	ListAttributeDescriptor* pList = NULL;
+
+	memset(longType, 'T', sizeof(longType) - 1);
+	longType[sizeof(longType) - 1] = '\0';
+
+	pArena = newIPDRArena(0);
+	if (pArena == NULL ||
+		appendListAttributeDescriptor(&pHeapList, "name", "INTEGER", "OPTIONAL",
+									  "INTEGER", NULL, NULL, NULL, NULL, 0) != IPDR_OK ||
+		appendListAttributeDescriptorInArena(pArena, &pArenaList,
+											 pHeapList->pAttributeDescriptor_) != IPDR_OK) {
+		printf("cannot append the descriptors\n");
+		return (1);
+	}
+
+	for (pass = 0; pass < 2; pass++) {
+		pList = (pass == 0) ? pHeapList : pArenaList;
+		if (setAttributeDescriptorString(pass == 0 ? NULL : pArena,
+				&(pList->pAttributeDescriptor_->derivedType_), longType) != IPDR_OK ||
+			strcmp(pList->pAttributeDescriptor_->derivedType_, longType) != 0 ||
+			strcmp(pList->pAttributeDescriptor_->attributeType_, "INTEGER") != 0) {
+			printf("%s: long derived type not kept\n", pass == 0 ? "heap" : "arena");
+			failures++;
+		}
+		if (setAttributeDescriptorString(pass == 0 ? NULL : pArena,
+				&(pList->pAttributeDescriptor_->derivedType_), "IPV4ADDR") != IPDR_OK ||
+			strcmp(pList->pAttributeDescriptor_->derivedType_, "IPV4ADDR") != 0) {
+			printf("%s: short derived type not kept\n", pass == 0 ? "heap" : "arena");
+			failures++;
+		}
+	}
+
+	freeListAttributeDescriptor(&pHeapList);
+	freeIPDRArena(pArena);
+
+	return (failures);
+}
+
+
+int main(int argc, char *argv[])
+{
+	int failures = 0;
+	int count = 0;
+	char fileName[LONG_MAX_PATH];
+	char* pValues[LONG_NO_OF_VALUES];
+	const char* pTestData = getenv("IPDR_TESTDATA");
+
+	if (argc > 1)
+		snprintf(fileName, sizeof(fileName), "%s", argv[1]);
+	else
+		snprintf(fileName, sizeof(fileName), "%s/%s",
+				 pTestData != NULL ? pTestData : "testdata", LONG_DEFAULT_DOCUMENT);
+
+	for (count = 0; count < LONG_NO_OF_VALUES; count++) {
+		pValues[count] = newLongValue(gLengths[count], count);
+		if (pValues[count] == NULL) {
+			printf("cannot allocate the values\n");
+			return (1);
+		}
+	}
+
+	failures += checkDescriptorStrings();
+	failures += checkRoundTrip(fileName, XDR, pValues);
+	failures += checkRoundTrip(fileName, XML, pValues);
+
+	for (count = 0; count < LONG_NO_OF_VALUES; count++)
+		free(pValues[count]);
+
+	if (failures != 0) {
+		printf("FAILED: %d mismatches\n", failures);
+		return (1);
+	}
+	printf("OK: %d values of up to %d characters read back unchanged\n",
+		   LONG_NO_OF_VALUES, gLengths[LONG_NO_OF_VALUES - 1]);
+	return (0);
+}
@@ -0,0 +1,282 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : ReadIntoCheck              *
+ * Description          : Checks that readIPDRInto   *
+ *                        reads the records readIPDR *
+ *                        does, reusing the layout   *
+ *                        only while it is current   *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils/IPDRCommon.h"
+#include "utils/IPDRMemory.h"
+#include "utils/IPDRArena.h"
+#include "utils/dynamicArray.h"
+#include "utils/errorCode.h"
+#include "common/IPDRDocReader.h"
+#include "xdr/XDRInputBuffer.h"
+#include "CheckUtil.h"
+
+#define INTO_RECORDS_DOCUMENT		"testcase1/testVOIP.1.xdr"
+#define INTO_OTHER_DOCUMENT			"testcase8/primitiveTypes.1.xdr"
+#define INTO_MAX_PATH				1024
+#define INTO_MAX_RECORDS			64
+
+/* Records read between these are projected on two attributes */
+#define INTO_PROJECT_FROM			10
+#define INTO_PROJECT_TO				20
+
+#define INTO_READ_IPDR				0
+#define INTO_READ_INTO				1
+
+/* Records of a document read */
+typedef struct DocumentText
+{
+	int noOfRecords_;
+	int noOfReuses_;     /* Records whose descriptors were those of the record before */
+	RecordText records_[INTO_MAX_RECORDS];
+} DocumentText;
+
+
+/*
+ * Projects the document on two attributes of its first record, or
+ * reads every attribute again if pFirst is NULL.
+ */
+static int projectDocument(IPDRCommonParameters* pIPDRCommonParameters,
+						   const RecordText* pFirst)
+{
+	int errorCode = 0;
+	int errorSeverity = 0;
+	int count = 0;
+	char names[CHECK_MAX_TEXT];
+	char* pName = NULL;
+	char* pContext = NULL;
+	List* pListAttributeName = NULL;
+
+	if (pFirst == NULL)
+		return (setIPDRProjection(pIPDRCommonParameters, NULL, &errorCode));
+
+	/* The first and third attributes, " name=value" in the text */
+	snprintf(names, sizeof(names), "%s", strchr(pFirst->text_, ':') + 1);
+	for (pName = strtok_r(names, " ", &pContext); pName != NULL && count < 3;
+		 pName = strtok_r(NULL, " ", &pContext), count++) {
+		if (count == 1 || strchr(pName, '=') == NULL)
+			continue;
+		*strchr(pName, '=') = '\0';
+		appendNode(&pListAttributeName, pName);
+	}
+
+	errorSeverity = setIPDRProjection(pIPDRCommonParameters, pListAttributeName, &errorCode);
+	freeList(&pListAttributeName);
+	return (errorSeverity);
+}
+
+
+/*
+ * Reads a document with readIPDR(), or with readIPDRInto() into
+ * pFNFData. With project set, the records from INTO_PROJECT_FROM to
+ * INTO_PROJECT_TO are read projected.
+ */
+static int readDocument(const char* fileName,
+						int readMode,
+						FNFData* pFNFData,
+						int project,
+						DocumentText* pDocument)
+{
+	int errorCode = 0;
+	int recordRead = IPDR_TRUE;
+	int count = 0;
+	FILE* pStream = NULL;
+	IPDRHeader* pIPDRHeader = NULL;
+	IPDRCommonParameters* pIPDRCommonParameters = NULL;
+	FNFData* pReadFNFData = NULL;
+	const ListAttributeDescriptor* pLastLayout = NULL;
+
+	pDocument->noOfRecords_ = 0;
+	pDocument->noOfReuses_ = 0;
+
+	pIPDRHeader = newIPDRHeader();
+	pStream = fopen(fileName, "rb");
+	if (pIPDRHeader == NULL || pStream == NULL ||
+		(pIPDRCommonParameters = newCheckParameters(XDR, NONREADABLE, "", pStream)) == NULL) {
+		printf("%s: cannot open the document\n", fileName);
+		return (IPDR_ERROR);
+	}
+	if (setXDRInputBuffer(pIPDRCommonParameters, XDR_INPUT_MMAP, &errorCode) == IPDR_ERROR ||
+		readHeader(pIPDRCommonParameters, pIPDRHeader, &errorCode) == IPDR_ERROR) {
+		printf("%s: cannot read the header, error %d\n", fileName, errorCode);
+		return (IPDR_ERROR);
+	}
+
+	for (count = 0; count < INTO_MAX_RECORDS; count++) {
+		if (project == IPDR_TRUE && count == INTO_PROJECT_FROM &&
+			projectDocument(pIPDRCommonParameters, &pDocument->records_[0]) == IPDR_ERROR)
+			return (IPDR_ERROR);
+		if (project == IPDR_TRUE && count == INTO_PROJECT_TO &&
+			projectDocument(pIPDRCommonParameters, NULL) == IPDR_ERROR)
+			return (IPDR_ERROR);
+
+		if (readMode == INTO_READ_INTO) {
+			if (readIPDRInto(pIPDRCommonParameters, pFNFData, &recordRead, &errorCode) == IPDR_ERROR) {
+				printf("%s: readIPDRInto failed at record %d, error %d\n", fileName, count + 1, errorCode);
+				return (IPDR_ERROR);
+			}
+			if (recordRead == IPDR_FALSE)
+				break;
+			if (count > 0 && pFNFData->pListAttributeDescriptor_ == pLastLayout)
+				pDocument->noOfReuses_++;
+			pLastLayout = pFNFData->pListAttributeDescriptor_;
+			pReadFNFData = pFNFData;
+		} else {
+			pReadFNFData = newFNFData();
+			if (readIPDR(pIPDRCommonParameters, &pReadFNFData, &errorCode) == IPDR_ERROR) {
+				printf("%s: readIPDR failed at record %d, error %d\n", fileName, count + 1, errorCode);
+				return (IPDR_ERROR);
+			}
+			if (pReadFNFData == NULL)
+				break;
+		}
+
+		if (formatRecord(pReadFNFData, &pDocument->records_[count]) == IPDR_ERROR)
+			return (IPDR_ERROR);
+		pDocument->noOfRecords_++;
+		if (readMode != INTO_READ_INTO)
+			freeFNFData(pReadFNFData);
+	}
+
+	freeIPDRHeader(pIPDRHeader);
+	freeIPDRCommonParameters(pIPDRCommonParameters);
+	return (IPDR_OK);
+}
+
+
+/*
+ * Compares the records readIPDRInto() read with those of readIPDR().
+ */
+static int compareDocuments(const char* checkName,
+							const DocumentText* pExpected,
+							const DocumentText* pRead)
+{
+	int count = 0;
+
+	if (pRead->noOfRecords_ != pExpected->noOfRecords_) {
+		printf("%s: %d records read, readIPDR read %d\n", checkName,
+			   pRead->noOfRecords_, pExpected->noOfRecords_);
+		return (1);
+	}
+
+	for (count = 0; count < pRead->noOfRecords_; count++) {
+		if (strcmp(pRead->records_[count].text_, pExpected->records_[count].text_) != 0) {
+			printf("%s: record %d is\n    %s\nreadIPDR read\n    %s\n", checkName, count + 1,
+				   pRead->records_[count].text_, pExpected->records_[count].text_);
+			return (1);
+		}
+	}
+
+	return (0);
+}
+
+
+int main(int argc, char *argv[])
+{
+	int failures = 0;
+	int count = 0;
+	char recordsDocument[INTO_MAX_PATH];
+	char otherDocument[INTO_MAX_PATH];
+	const char* pTestData = getenv("IPDR_TESTDATA");
+	FNFData* pFNFData = NULL;
+	FNFData* pArenaFNFData = NULL;
+	IPDRArena* pArena = NULL;
+	static DocumentText expected;
+	static DocumentText read;
+
+	if (pTestData == NULL)
+		pTestData = "testdata";
+	if (argc > 2) {
+		snprintf(recordsDocument, sizeof(recordsDocument), "%s", argv[1]);
+		snprintf(otherDocument, sizeof(otherDocument), "%s", argv[2]);
+	} else {
+		snprintf(recordsDocument, sizeof(recordsDocument), "%s/%s", pTestData, INTO_RECORDS_DOCUMENT);
+		snprintf(otherDocument, sizeof(otherDocument), "%s/%s", pTestData, INTO_OTHER_DOCUMENT);
+	}
+
+	pFNFData = newFNFData();
+	pArena = newIPDRArena(0);
+	if (pFNFData == NULL || pArena == NULL)
+		return (1);
+
+	/* Records of one descriptor are read into the same layout */
+	if (readDocument(recordsDocument, INTO_READ_IPDR, NULL, IPDR_FALSE, &expected) == IPDR_ERROR ||
+		readDocument(recordsDocument, INTO_READ_INTO, pFNFData, IPDR_FALSE, &read) == IPDR_ERROR)
+		return (1);
+	failures += compareDocuments("reuse", &expected, &read);
+	if (read.noOfReuses_ != read.noOfRecords_ - 1) {
+		printf("reuse: the layout was kept for %d of %d records\n",
+			   read.noOfReuses_, read.noOfRecords_ - 1);
+		failures++;
+	}
+
+	/* The layout of a record of the document before is not taken */
+	if (readDocument(otherDocument, INTO_READ_IPDR, NULL, IPDR_FALSE, &expected) == IPDR_ERROR ||
+		readDocument(otherDocument, INTO_READ_INTO, pFNFData, IPDR_FALSE, &read) == IPDR_ERROR)
+		return (1);
+	failures += compareDocuments("next document", &expected, &read);
+
+	/* Setting the projection renews the layout */
+	freeFNFData(pFNFData);
+	pFNFData = newFNFData();
+	if (pFNFData == NULL ||
+		readDocument(recordsDocument, INTO_READ_IPDR, NULL, IPDR_TRUE, &expected) == IPDR_ERROR ||
+		readDocument(recordsDocument, INTO_READ_INTO, pFNFData, IPDR_TRUE, &read) == IPDR_ERROR)
+		return (1);
+	failures += compareDocuments("projection", &expected, &read);
+	for (count = INTO_PROJECT_FROM; count < INTO_PROJECT_TO && count < read.noOfRecords_; count++) {
+		if (read.records_[count].noOfAttributes_ != 2) {
+			printf("projection: record %d has %d attributes\n", count + 1,
+				   read.records_[count].noOfAttributes_);
+			failures++;
+			break;
+		}
+	}
+	if (read.noOfRecords_ <= INTO_PROJECT_TO || read.noOfReuses_ != read.noOfRecords_ - 3) {
+		printf("projection: the layout was kept for %d of %d records\n",
+			   read.noOfReuses_, read.noOfRecords_ - 3);
+		failures++;
+	}
+
+	/* Records in an arena are read by readIPDR() */
+	pArenaFNFData = newFNFDataInArena(pArena);
+	if (pArenaFNFData == NULL ||
+		readDocument(recordsDocument, INTO_READ_IPDR, NULL, IPDR_FALSE, &expected) == IPDR_ERROR ||
+		readDocument(recordsDocument, INTO_READ_INTO, pArenaFNFData, IPDR_FALSE, &read) == IPDR_ERROR)
+		return (1);
+	failures += compareDocuments("readIPDR fallback", &expected, &read);
+
+	freeFNFData(pFNFData);
+	freeIPDRArena(pArena);
+
+	if (failures != 0) {
+		printf("FAILED: %d mismatches\n", failures);
+		return (1);
+	}
+	printf("OK: %d records read into a caller's FNFData\n", expected.noOfRecords_);
+	return (0);
+}
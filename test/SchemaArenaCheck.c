@@ -0,0 +1,342 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : SchemaArenaCheck           *
+ * Description          : Checks that records read   *
+ *                        into an arena are validated*
+ *                        against the schema as the  *
+ *                        records read by readIPDR   *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "utils/IPDRCommon.h"
+#include "utils/IPDRMemory.h"
+#include "utils/IPDRArena.h"
+#include "utils/errorCode.h"
+#include "common/IPDRDocReader.h"
+#include "common/IPDRDocWriter.h"
+#include "common/schema.h"
+#include "xdr/XDRInputBuffer.h"
+#include "CheckUtil.h"
+
+#define ARENA_DEFAULT_DIRECTORY		"testcase1"
+#define ARENA_DEFAULT_DOCUMENT		"testVOIP.1.xdr"
+#define ARENA_MAX_PATH				1024
+#define ARENA_MAX_RECORDS			64
+
+/* Types and descriptions of the attributes of a record once validated */
+typedef struct ArenaCheckRecord
+{
+	char typeName_[MAX_IPDR_STRING];
+	char types_[MAX_IPDR_STRING * 2];
+} ArenaCheckRecord;
+
+
+/*
+ * Opens a document for reading, with the schemas its header refers
+ * to if validate is set. They are looked up relative to the working
+ * directory.
+ */
+static IPDRCommonParameters* openReader(FILE* pStream,
+										IPDRHeader* pIPDRHeader,
+										int validate)
+{
+	int errorCode = 0;
+	IPDRCommonParameters* pIPDRCommonParameters = NULL;
+
+	pIPDRCommonParameters = newCheckParameters(XDR, NONREADABLE, "", pStream);
+	if (pIPDRCommonParameters == NULL)
+		return (NULL);
+
+	if (setXDRInputBuffer(pIPDRCommonParameters, XDR_INPUT_MMAP, &errorCode) == IPDR_ERROR ||
+		readHeader(pIPDRCommonParameters, pIPDRHeader, &errorCode) == IPDR_ERROR ||
+		(validate == IPDR_TRUE &&
+		 setSchemaData(pIPDRCommonParameters, pIPDRHeader->pOtherNameSpaceInfo_,
+					   pIPDRHeader->pListServiceDefinitionURI_,
+					   pIPDRHeader->defaultNameSpaceURI_, &errorCode) == IPDR_ERROR)) {
+		printf("the document cannot be opened, error %d\n", errorCode);
+		freeIPDRCommonParameters(pIPDRCommonParameters);
+		return (NULL);
+	}
+
+	return (pIPDRCommonParameters);
+}
+
+
+/*
+ * Copies the document to pOutput with the derived types of its
+ * descriptors set to their primitive types, so reading the copy with
+ * schema validation writes the longer schema types over them.
+ */
+static int writePrimitiveCopy(const char* fileName, FILE* pOutput)
+{
+	int errorCode = 0;
+	int noOfRecords = 0;
+	FILE* pInput = NULL;
+	IPDRHeader* pIPDRHeader = NULL;
+	IPDRCommonParameters* pReader = NULL;
+	IPDRCommonParameters* pWriter = NULL;
+	ListSchemaNameSpace* pListSchemaNameSpace = NULL;
+	ListNameSpaceInfo* pNameSpaceInfo = NULL;
+	ListAttributeDescriptor* pCurrent = NULL;
+	FNFData* pFNFData = NULL;
+
+	pIPDRHeader = newIPDRHeader();
+	pInput = fopen(fileName, "rb");
+	if (pIPDRHeader == NULL || pInput == NULL) {
+		printf("%s: cannot open the document\n", fileName);
+		return (-1);
+	}
+	pReader = openReader(pInput, pIPDRHeader, IPDR_FALSE);
+	if (pReader == NULL)
+		return (-1);
+	pWriter = newCheckParameters(XDR, NONWRITABLE, pReader->schemaVersion, pOutput);
+	if (pWriter == NULL)
+		return (-1);
+
+	for (pNameSpaceInfo = pIPDRHeader->pOtherNameSpaceInfo_; pNameSpaceInfo != NULL;
+		 pNameSpaceInfo = pNameSpaceInfo->pNext_)
+		appendListSchemaNameSpace(&pListSchemaNameSpace,
+								  pNameSpaceInfo->NameSpaceInfo_.nameSpaceURI_);
+	if (writeHeader(pWriter, pIPDRHeader->startTime_, pIPDRHeader->ipdrRecorderInfo_,
+					pIPDRHeader->defaultNameSpaceURI_, pIPDRHeader->pOtherNameSpaceInfo_,
+					pIPDRHeader->pListServiceDefinitionURI_, pIPDRHeader->docID_,
+					pListSchemaNameSpace, &errorCode) == IPDR_ERROR) {
+		printf("writeHeader failed, error %d\n", errorCode);
+		return (-1);
+	}
+
+	for (;;) {
+		pFNFData = newFNFData();
+		if (readIPDR(pReader, &pFNFData, &errorCode) == IPDR_ERROR) {
+			printf("%s: readIPDR failed, error %d\n", fileName, errorCode);
+			return (-1);
+		}
+		if (pFNFData == NULL)
+			break;
+
+		for (pCurrent = pFNFData->pListAttributeDescriptor_; pCurrent != NULL;
+			 pCurrent = pCurrent->pNext_)
+			strcpy(pCurrent->pAttributeDescriptor_->derivedType_,
+				   pCurrent->pAttributeDescriptor_->attributeType_);
+		pFNFData->descriptorID_ = 0;
+
+		if (writeIPDR(pWriter, pFNFData, &errorCode) == IPDR_ERROR) {
+			printf("writeIPDR failed, error %d\n", errorCode);
+			return (-1);
+		}
+		noOfRecords++;
+		freeFNFData(pFNFData);
+	}
+
+	if (writeDocEnd(pWriter, &errorCode) == IPDR_ERROR) {
+		printf("writeDocEnd failed, error %d\n", errorCode);
+		return (-1);
+	}
+	fflush(pOutput);
+	rewind(pOutput);
+
+	/* The copy is read from the same stream */
+	pWriter->pStreamHandle_ = NULL;
+	freeListSchemaNameSpace(&pListSchemaNameSpace);
+	freeIPDRHeader(pIPDRHeader);
+	freeIPDRCommonParameters(pReader);
+	freeIPDRCommonParameters(pWriter);
+	return (noOfRecords);
+}
+
+
+/*
+ * Lists the types and descriptions of the attributes of a record.
+ */
+static void getRecordTypes(const FNFData* pFNFData, ArenaCheckRecord* pRecord)
+{
+	const ListAttributeDescriptor* pCurrent = NULL;
+	size_t length = 0;
+
+	snprintf(pRecord->typeName_, sizeof(pRecord->typeName_), "%s", pFNFData->typeName_);
+	pRecord->types_[0] = '\0';
+	for (pCurrent = pFNFData->pListAttributeDescriptor_; pCurrent != NULL;
+		 pCurrent = pCurrent->pNext_) {
+		length = strlen(pRecord->types_);
+		snprintf(pRecord->types_ + length, sizeof(pRecord->types_) - length, "%s/%s(%s) ",
+				 pCurrent->pAttributeDescriptor_->attributeType_,
+				 pCurrent->pAttributeDescriptor_->derivedType_,
+				 pCurrent->pAttributeDescriptor_->description_ != NULL ?
+				 pCurrent->pAttributeDescriptor_->description_ : "");
+	}
+}
+
+
+/*
+ * Reads the copy with readIPDR() and schema validation.
+ */
+static int readWithReadIPDR(FILE* pStream, ArenaCheckRecord* pRecords)
+{
+	int errorCode = 0;
+	int noOfRecords = 0;
+	IPDRHeader* pIPDRHeader = NULL;
+	IPDRCommonParameters* pIPDRCommonParameters = NULL;
+	FNFData* pFNFData = NULL;
+
+	pIPDRHeader = newIPDRHeader();
+	if (pIPDRHeader == NULL)
+		return (-1);
+	pIPDRCommonParameters = openReader(pStream, pIPDRHeader, IPDR_TRUE);
+	if (pIPDRCommonParameters == NULL)
+		return (-1);
+
+	for (;;) {
+		pFNFData = newFNFData();
+		if (readIPDR(pIPDRCommonParameters, &pFNFData, &errorCode) == IPDR_ERROR) {
+			printf("readIPDR failed, error %d\n", errorCode);
+			noOfRecords = -1;
+			break;
+		}
+		if (pFNFData == NULL)
+			break;
+		if (noOfRecords < ARENA_MAX_RECORDS)
+			getRecordTypes(pFNFData, &pRecords[noOfRecords]);
+		noOfRecords++;
+		freeFNFData(pFNFData);
+	}
+
+	/* The stream is read again */
+	pIPDRCommonParameters->pStreamHandle_ = NULL;
+	rewind(pStream);
+	freeIPDRHeader(pIPDRHeader);
+	freeIPDRCommonParameters(pIPDRCommonParameters);
+	return (noOfRecords);
+}
+
+
+/*
+ * Reads the copy again into a record of an arena, reset after each
+ * record, and compares the types with those readIPDR() gave.
+ */
+static int checkArenaRead(FILE* pStream,
+						  const ArenaCheckRecord* pRecords,
+						  int noOfRecords)
+{
+	int failures = 0;
+	int errorCode = 0;
+	int recordRead = IPDR_FALSE;
+	int count = 0;
+	ArenaCheckRecord record;
+	IPDRHeader* pIPDRHeader = NULL;
+	IPDRCommonParameters* pIPDRCommonParameters = NULL;
+	IPDRArena* pArena = NULL;
+	FNFData* pFNFData = NULL;
+
+	pIPDRHeader = newIPDRHeader();
+	pArena = newIPDRArena(0);
+	if (pIPDRHeader == NULL || pArena == NULL)
+		return (1);
+	pIPDRCommonParameters = openReader(pStream, pIPDRHeader, IPDR_TRUE);
+	if (pIPDRCommonParameters == NULL)
+		return (1);
+
+	for (count = 0; ; count++) {
+		resetIPDRArena(pArena);
+		pFNFData = newFNFDataInArena(pArena);
+		if (pFNFData == NULL ||
+			readIPDRInto(pIPDRCommonParameters, pFNFData, &recordRead, &errorCode) == IPDR_ERROR) {
+			printf("readIPDRInto failed at record %d, error %d\n", count + 1, errorCode);
+			failures++;
+			break;
+		}
+		if (recordRead == IPDR_FALSE)
+			break;
+		if (count >= noOfRecords || count >= ARENA_MAX_RECORDS)
+			continue;
+
+		getRecordTypes(pFNFData, &record);
+		if (strcmp(record.typeName_, pRecords[count].typeName_) != 0 ||
+			strcmp(record.types_, pRecords[count].types_) != 0) {
+			printf("record %d: %s %s\n    readIPDR gave %s %s\n", count + 1,
+				   record.typeName_, record.types_,
+				   pRecords[count].typeName_, pRecords[count].types_);
+			failures++;
+		}
+	}
+	if (failures == 0 && count != noOfRecords) {
+		printf("%d records read into the arena, %d by readIPDR\n", count, noOfRecords);
+		failures++;
+	}
+
+	freeIPDRArena(pArena);
+	freeIPDRHeader(pIPDRHeader);
+	freeIPDRCommonParameters(pIPDRCommonParameters);
+	return (failures);
+}
+
+
+int main(int argc, char *argv[])
+{
+	int failures = 0;
+	int noOfRecords = 0;
+	char directory[ARENA_MAX_PATH];
+	const char* pFileName = ARENA_DEFAULT_DOCUMENT;
+	const char* pTestData = getenv("IPDR_TESTDATA");
+	char* pSlash = NULL;
+	FILE* pCopy = NULL;
+	static ArenaCheckRecord records[ARENA_MAX_RECORDS];
+
+	/* The schemas are next to the document */
+	if (argc > 1) {
+		snprintf(directory, sizeof(directory), "%s", argv[1]);
+		pSlash = strrchr(directory, '/');
+		if (pSlash == NULL) {
+			strcpy(directory, ".");
+			pFileName = argv[1];
+		} else {
+			*pSlash = '\0';
+			pFileName = argv[1] + (pSlash - directory) + 1;
+		}
+	} else {
+		snprintf(directory, sizeof(directory), "%s/%s",
+				 pTestData != NULL ? pTestData : "testdata", ARENA_DEFAULT_DIRECTORY);
+	}
+	if (chdir(directory) != 0) {
+		printf("cannot change to %s\n", directory);
+		return (1);
+	}
+
+	pCopy = tmpfile();
+	if (pCopy == NULL || writePrimitiveCopy(pFileName, pCopy) <= 0) {
+		printf("FAILED: %s cannot be copied\n", pFileName);
+		return (1);
+	}
+
+	noOfRecords = readWithReadIPDR(pCopy, records);
+	if (noOfRecords <= 0) {
+		printf("FAILED: %s has no record to compare\n", pFileName);
+		return (1);
+	}
+
+	failures = checkArenaRead(pCopy, records, noOfRecords);
+	if (failures != 0) {
+		printf("FAILED: %d mismatches\n", failures);
+		return (1);
+	}
+	printf("OK: %d validated records read into an arena\n", noOfRecords);
+	return (0);
+}
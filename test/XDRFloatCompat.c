@@ -0,0 +1,209 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : XDRFloatCompat             *
+ * Description          : Checks the IEEE-754 float  *
+ *                        and double codec against   *
+ *                        the legacy binary string   *
+ *                        encoder                    *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "xdr/XDRMarshaller.h"
+#include "xdr/XDRUnMarshaller.h"
+#include "xdr/XDRPrimitives.h"
+
+#define COMPAT_DEFAULT_VALUES	100000
+
+
+/* Legacy write_double() conversion */
+static void legacyStoreDouble(byte* pBuffer, double value)
+{
+	char hexa[DOUBLE_HEXA_BITS];
+	char tempByte[3] = "ff";
+	int count;
+
+	getWriteDoubleHexFromDouble(hexa, value);
+	for (count = 0; count < DOUBLE_HEXA_BITS; count = count + 2) {
+		tempByte[0] = hexa[count];
+		tempByte[1] = hexa[count + 1];
+		pBuffer[count / 2] = (byte) convWriteIntHexToInt(tempByte);
+	}
+}
+
+/* Legacy write_float() conversion */
+static void legacyStoreFloat(byte* pBuffer, float value)
+{
+	char hexa[FLOAT_HEXA_BITS];
+	char tempByte[3] = "ff";
+	int count;
+
+	getFloatWriteHexFromDouble(hexa, value);
+	for (count = 0; count < FLOAT_HEXA_BITS; count = count + 2) {
+		tempByte[0] = hexa[count];
+		tempByte[1] = hexa[count + 1];
+		pBuffer[count / 2] = (byte) hexToInt(tempByte);
+	}
+}
+
+/* Legacy read_double() conversion */
+static double legacyLoadDouble(const byte* pBuffer)
+{
+	char hexa[3];
+	char binary[5];
+	char complete[DOUBLE_HEXA_BITS * 4];
+	int count;
+	int next;
+	double value;
+
+	for (count = 0; count < DOUBLE_HEXA_BYTES; count++) {
+		sprintf(hexa, "%02x", pBuffer[count]);
+		for (next = 0; next < 2; next++) {
+			convReadDoubleHexToBinary(hexa[next], binary);
+			memcpy(complete + 8 * count + 4 * next, binary, 4);
+		}
+	}
+	value = pow(2, getReadDoubleExponent(complete)) *
+			getReadDoubleMantissa(complete + DOUBLE_EXPONENT_BITS);
+	return((complete[0] == '1') ? -value : value);
+}
+
+static u_hyper randomBits(void)
+{
+	return(((u_hyper) (rand() & 0xffff) << 48) ^
+		   ((u_hyper) (rand() & 0xffff) << 32) ^
+		   ((u_hyper) (rand() & 0xffff) << 16) ^
+		    (u_hyper) (rand() & 0xffff));
+}
+
+/* Special values the legacy encoder could not represent */
+static int checkSpecialValues(void)
+{
+	u_hyper doubleBits[] = {
+		0x0000000000000000ULL, 0x8000000000000000ULL,
+		0x0000000000000001ULL, 0x000fffffffffffffULL,
+		0x7ff0000000000000ULL, 0xfff0000000000000ULL,
+		0x7ff8000000000000ULL, 0x7ff4000000000123ULL
+	};
+	unsigned int floatBits[] = {
+		0x00000000, 0x80000000, 0x00000001, 0x007fffff,
+		0x7f800000, 0xff800000, 0x7fc00000, 0x7fa00123
+	};
+	byte buffer[XDR_DOUBLE_BYTES];
+	double doubleValue;
+	double doubleResult;
+	float floatValue;
+	float floatResult;
+	int failures = 0;
+	int count;
+
+	for (count = 0; count < (int) (sizeof(doubleBits) / sizeof(doubleBits[0])); count++) {
+		memcpy(&doubleValue, &doubleBits[count], sizeof(double));
+		xdrStoreDouble(buffer, doubleValue);
+		doubleResult = xdrLoadDouble(buffer);
+		if (xdrLoadUHyper(buffer) != doubleBits[count] ||
+			memcmp(&doubleResult, &doubleValue, sizeof(double)) != 0) {
+			printf("double special value %016llx does not round trip\n",
+				   doubleBits[count]);
+			failures++;
+		}
+	}
+
+	for (count = 0; count < (int) (sizeof(floatBits) / sizeof(floatBits[0])); count++) {
+		memcpy(&floatValue, &floatBits[count], sizeof(float));
+		xdrStoreFloat(buffer, floatValue);
+		floatResult = xdrLoadFloat(buffer);
+		if (xdrLoadUInt(buffer) != floatBits[count] ||
+			memcmp(&floatResult, &floatValue, sizeof(float)) != 0) {
+			printf("float special value %08x does not round trip\n",
+				   floatBits[count]);
+			failures++;
+		}
+	}
+	return(failures);
+}
+
+int main(int argc, char *argv[])
+{
+	int values = COMPAT_DEFAULT_VALUES;
+	int count = 0;
+	int failures = 0;
+	int exponent;
+	u_hyper bits;
+	unsigned int floatBits;
+	double doubleValue;
+	float floatValue;
+	byte legacy[XDR_DOUBLE_BYTES];
+	byte kernel[XDR_DOUBLE_BYTES];
+
+	if (argc > 1)
+		values = atoi(argv[1]);
+	if (values <= 0)
+		values = COMPAT_DEFAULT_VALUES;
+
+	srand(20022);
+	for (count = 0; count < values; count++) {
+		/*
+		 * Random normal doubles; the legacy encoder only handles
+		 * normal numbers, so zero and all-ones exponents are skipped.
+		 */
+		bits = randomBits();
+		exponent = (int) ((bits >> 52) & 0x7ff);
+		if (exponent == 0 || exponent == 0x7ff)
+			bits ^= 0x3ff0000000000000ULL;
+		memcpy(&doubleValue, &bits, sizeof(double));
+
+		legacyStoreDouble(legacy, doubleValue);
+		xdrStoreDouble(kernel, doubleValue);
+		if (memcmp(legacy, kernel, XDR_DOUBLE_BYTES) != 0 ||
+			xdrLoadDouble(kernel) != doubleValue ||
+			legacyLoadDouble(kernel) != doubleValue) {
+			printf("double %016llx: codec differs from the legacy encoding\n", bits);
+			failures++;
+		}
+
+		floatBits = (unsigned int) randomBits();
+		exponent = (int) ((floatBits >> 23) & 0xff);
+		if (exponent == 0 || exponent == 0xff)
+			floatBits ^= 0x3f800000;
+		memcpy(&floatValue, &floatBits, sizeof(float));
+
+		legacyStoreFloat(legacy, floatValue);
+		xdrStoreFloat(kernel, floatValue);
+		if (memcmp(legacy, kernel, XDR_FLOAT_BYTES) != 0 ||
+			xdrLoadFloat(kernel) != floatValue) {
+			printf("float %08x: codec differs from the legacy encoding\n", floatBits);
+			failures++;
+		}
+
+		if (failures > 10)
+			break;
+	}
+
+	failures += checkSpecialValues();
+
+	if (failures != 0) {
+		printf("FAILED: %d mismatches\n", failures);
+		return(1);
+	}
+	printf("OK: %d doubles and %d floats match the legacy encoding\n",
+		   values, values);
+	return(0);
+}
@@ -0,0 +1,226 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : XDRPrimitiveBench          *
+ * Description          : Compares the XDR primitive *
+ *                        kernels with the legacy    *
+ *                        hex string conversion      *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "xdr/XDRMarshaller.h"
+#include "xdr/XDRUnMarshaller.h"
+#include "xdr/XDRPrimitives.h"
+
+#define BENCH_DEFAULT_FIELDS	1000000
+
+
+/* Legacy write_long() conversion, kept here as the reference encoder */
+static void legacyStoreInt(byte* pBuffer, int value)
+{
+	char tempByte[3] = "ff";
+	char bytes[INT_BITS + 1];
+	int count;
+
+	sprintf(bytes, "%08x", value);
+	for (count = 0; count < INT_BITS; count = count + 2) {
+		tempByte[0] = bytes[count];
+		tempByte[1] = bytes[count + 1];
+		pBuffer[count / 2] = (byte) convWriteIntHexToInt(tempByte);
+	}
+}
+
+/* Legacy read_long() conversion */
+static int legacyLoadInt(const byte* pBuffer)
+{
+	char tempByte[3] = "ff";
+	int value = 0;
+	int count;
+
+	for (count = 0; count < INT_BYTES; count++) {
+		sprintf(tempByte, "%02x", pBuffer[count]);
+		value = value + convReadIntHexToInt(count, tempByte);
+	}
+	return(value);
+}
+
+/* Legacy write_longlong() conversion, valid for non negative values */
+static void legacyStoreHyper(byte* pBuffer, hyper value)
+{
+	char tempByte[3] = "ff";
+	unsigned char bytes[HYPER_BITS + 1];
+	char tempBytes[HYPER_BITS + 1];
+	int count;
+
+	convWriteHyperToHex(value, bytes);
+	sprintf(tempBytes, "%16s", bytes);
+	for (count = 0; count < HYPER_MAXCOUNT_16; count = count + 2) {
+		tempByte[0] = tempBytes[count];
+		tempByte[1] = tempBytes[count + 1];
+		pBuffer[count / 2] = (byte) convWriteHyperHexToInt(tempByte);
+	}
+}
+
+static double nsPerField(clock_t start, clock_t end, int fields)
+{
+	return((double) (end - start) * 1e9 / CLOCKS_PER_SEC / fields);
+}
+
+int main(int argc, char *argv[])
+{
+	int fields = BENCH_DEFAULT_FIELDS;
+	int count = 0;
+	int mismatch = 0;
+	int* pValues = NULL;
+	hyper* pHypers = NULL;
+	byte* pLegacy = NULL;
+	byte* pKernel = NULL;
+	volatile unsigned int sink = 0;
+	char hexa[DOUBLE_HEXA_BITS];
+	clock_t start;
+	clock_t end;
+	double legacyTime;
+	double kernelTime;
+
+	if (argc > 1)
+		fields = atoi(argv[1]);
+	if (fields <= 0)
+		fields = BENCH_DEFAULT_FIELDS;
+
+	pValues = (int *) calloc(fields, sizeof(int));
+	pHypers = (hyper *) calloc(fields, sizeof(hyper));
+	pLegacy = (byte *) calloc(fields, XDR_HYPER_BYTES);
+	pKernel = (byte *) calloc(fields, XDR_HYPER_BYTES);
+	if (pValues == NULL || pHypers == NULL ||
+		pLegacy == NULL || pKernel == NULL) {
+		fprintf(stderr, "Out of memory\n");
+		return(1);
+	}
+
+	srand(20021);
+	for (count = 0; count < fields; count++) {
+		pValues[count] = (int) (((unsigned int) rand() << 16) ^ rand());
+		pHypers[count] = (((hyper) rand() << 32) ^
+						  ((hyper) rand() << 16) ^ rand()) & 0x7fffffffffffffffLL;
+	}
+
+	/* 32 bit encode */
+	start = clock();
+	for (count = 0; count < fields; count++)
+		legacyStoreInt(pLegacy + count * XDR_INT_BYTES, pValues[count]);
+	end = clock();
+	legacyTime = nsPerField(start, end, fields);
+
+	start = clock();
+	for (count = 0; count < fields; count++)
+		xdrStoreUInt(pKernel + count * XDR_INT_BYTES, (unsigned int) pValues[count]);
+	end = clock();
+	kernelTime = nsPerField(start, end, fields);
+
+	if (memcmp(pLegacy, pKernel, fields * XDR_INT_BYTES) != 0)
+		mismatch++;
+	printf("write_long   legacy %8.2f ns/field  kernel %8.2f ns/field\n",
+		   legacyTime, kernelTime);
+
+	/* 32 bit decode */
+	start = clock();
+	for (count = 0; count < fields; count++)
+		sink += (unsigned int) legacyLoadInt(pKernel + count * XDR_INT_BYTES);
+	end = clock();
+	legacyTime = nsPerField(start, end, fields);
+
+	start = clock();
+	for (count = 0; count < fields; count++)
+		sink += xdrLoadUInt(pKernel + count * XDR_INT_BYTES);
+	end = clock();
+	kernelTime = nsPerField(start, end, fields);
+
+	for (count = 0; count < fields; count++) {
+		if ((int) xdrLoadUInt(pKernel + count * XDR_INT_BYTES) != pValues[count] ||
+			legacyLoadInt(pKernel + count * XDR_INT_BYTES) != pValues[count]) {
+			mismatch++;
+			break;
+		}
+	}
+	printf("read_long    legacy %8.2f ns/field  kernel %8.2f ns/field\n",
+		   legacyTime, kernelTime);
+
+	/* 64 bit encode */
+	start = clock();
+	for (count = 0; count < fields; count++)
+		legacyStoreHyper(pLegacy + count * XDR_HYPER_BYTES, pHypers[count]);
+	end = clock();
+	legacyTime = nsPerField(start, end, fields);
+
+	start = clock();
+	for (count = 0; count < fields; count++)
+		xdrStoreUHyper(pKernel + count * XDR_HYPER_BYTES, (u_hyper) pHypers[count]);
+	end = clock();
+	kernelTime = nsPerField(start, end, fields);
+
+	if (memcmp(pLegacy, pKernel, fields * XDR_HYPER_BYTES) != 0)
+		mismatch++;
+	for (count = 0; count < fields; count++) {
+		if ((hyper) xdrLoadUHyper(pKernel + count * XDR_HYPER_BYTES) != pHypers[count]) {
+			mismatch++;
+			break;
+		}
+	}
+	printf("write_hyper  legacy %8.2f ns/field  kernel %8.2f ns/field\n",
+		   legacyTime, kernelTime);
+
+	/* double encode, IEEE-754 bit-cast against the binary string path */
+	start = clock();
+	for (count = 0; count < fields; count++)
+		getWriteDoubleHexFromDouble(hexa, (double) pValues[count] / 1024);
+	end = clock();
+	legacyTime = nsPerField(start, end, fields);
+
+	start = clock();
+	for (count = 0; count < fields; count++)
+		xdrStoreDouble(pKernel + count * XDR_DOUBLE_BYTES,
+					   (double) pValues[count] / 1024);
+	end = clock();
+	kernelTime = nsPerField(start, end, fields);
+	printf("write_double legacy %8.2f ns/field  kernel %8.2f ns/field\n",
+		   legacyTime, kernelTime);
+
+	/* double decode */
+	start = clock();
+	for (count = 0; count < fields; count++)
+		sink += (unsigned int) xdrLoadDouble(pKernel + count * XDR_DOUBLE_BYTES);
+	end = clock();
+	kernelTime = nsPerField(start, end, fields);
+	printf("read_double                          kernel %8.2f ns/field\n",
+		   kernelTime);
+
+	free(pValues);
+	free(pHypers);
+	free(pLegacy);
+	free(pKernel);
+
+	if (mismatch != 0) {
+		printf("FAILED: kernel output differs from the legacy encoding\n");
+		return(1);
+	}
+	printf("OK: %d fields bit-exact with the legacy encoding\n", fields);
+	return(0);
+}
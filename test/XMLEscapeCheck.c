@@ -0,0 +1,256 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : XMLEscapeCheck             *
+ * Description          : Checks that strings with   *
+ *                        XML special characters are *
+ *                        escaped when written and   *
+ *                        read back unchanged        *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "utils/IPDRCommon.h"
+#include "utils/IPDRMemory.h"
+#include "utils/errorCode.h"
+#include "common/IPDRDocReader.h"
+#include "common/IPDRDocWriter.h"
+#include "xdr/XDRInputBuffer.h"
+#include "CheckUtil.h"
+#include "xml/XMLMarshaller.h"
+
+#define ESCAPE_DEFAULT_DOCUMENT		"testcase8/primitiveTypes.1.xdr"
+#define ESCAPE_MAX_PATH				1024
+
+/* Values written into the string attribute of the record */
+static const char* gValues[] = {
+	"<IPDR>",
+	"a & b",
+	"&amp; is not unescaped twice",
+	"\"quoted\" and 'single'",
+	"</myString><myString>",
+	"]]>",
+	"plain"
+};
+
+static const char* gEscapedValues[] = {
+	"&lt;IPDR&gt;",
+	"a &amp; b",
+	"&amp;amp; is not unescaped twice",
+	"&quot;quoted&quot; and &apos;single&apos;",
+	"&lt;/myString&gt;&lt;myString&gt;",
+	"]]&gt;",
+	"plain"
+};
+
+#define ESCAPE_NO_OF_VALUES		((int) (sizeof(gValues) / sizeof(gValues[0])))
+
+
+/*
+ * Checks escapeXMLString() against the expected entity references.
+ */
+static int checkEscapeXMLString(void)
+{
+	int failures = 0;
+	int count = 0;
+	int length = 0;
+	char escaped[256];
+
+	for (count = 0; count < ESCAPE_NO_OF_VALUES; count++) {
+		length = escapeXMLString(gValues[count], escaped);
+		if (strcmp(escaped, gEscapedValues[count]) != 0 ||
+			length != (int) strlen(gEscapedValues[count])) {
+			printf("escapeXMLString(\"%s\") = \"%s\", expected \"%s\"\n",
+				   gValues[count], escaped, gEscapedValues[count]);
+			failures++;
+		}
+	}
+
+	return (failures);
+}
+
+
+/*
+ * Writes the record once per value to an XML document, alternately
+ * with and without the descriptor ID of the reader, so both template
+ * lookups are used, and reads the document back.
+ */
+static int checkXMLRoundTrip(const char* fileName)
+{
+	int failures = 0;
+	int count = 0;
+	int errorCode = 0;
+	int descriptorID = 0;
+	long length = 0;
+	char attributeName[MAX_ATTRIBUTE_NAME] = "";
+	char* pDocument = NULL;
+	FILE* pInputStream = NULL;
+	FILE* pOutputStream = NULL;
+	IPDRCommonParameters* pReader = NULL;
+	IPDRCommonParameters* pWriter = NULL;
+	IPDRHeader* pIPDRHeader = NULL;
+	IPDRHeader* pXMLHeader = NULL;
+	DocEnd* pDocEnd = NULL;
+	FNFData* pFNFData = NULL;
+	FNFData* pReadFNFData = NULL;
+	ListIPDRData* pStringValue = NULL;
+	ListSchemaNameSpace* pListSchemaNameSpace = NULL;
+	ListNameSpaceInfo* pNameSpaceInfo = NULL;
+
+	pIPDRHeader = newIPDRHeader();
+	pXMLHeader = newIPDRHeader();
+	pDocEnd = newDocEnd();
+	pFNFData = newFNFData();
+	pInputStream = fopen(fileName, "rb");
+	pOutputStream = tmpfile();
+	if (pIPDRHeader == NULL || pXMLHeader == NULL || pDocEnd == NULL ||
+		pFNFData == NULL || pInputStream == NULL || pOutputStream == NULL) {
+		printf("%s: cannot open the document\n", fileName);
+		return (1);
+	}
+
+	pReader = newCheckParameters(XDR, NONREADABLE, IPDR_VERSION_3_5, pInputStream);
+	if (pReader == NULL ||
+		setXDRInputBuffer(pReader, XDR_INPUT_MMAP, &errorCode) == IPDR_ERROR ||
+		readHeader(pReader, pIPDRHeader, &errorCode) == IPDR_ERROR ||
+		readIPDR(pReader, &pFNFData, &errorCode) == IPDR_ERROR ||
+		pFNFData == NULL) {
+		printf("%s: cannot read the first record, error %d\n", fileName, errorCode);
+		return (1);
+	}
+
+	pStringValue = findStringValue(pFNFData, NULL);
+	if (pStringValue == NULL) {
+		printf("%s: the first record has no string attribute\n", fileName);
+		return (1);
+	}
+	descriptorID = pFNFData->descriptorID_;
+	strncpy(attributeName, findAttributeName(pFNFData, pStringValue), sizeof(attributeName) - 1);
+
+	pWriter = newCheckParameters(XML, NONWRITABLE, IPDR_VERSION_3_5, pOutputStream);
+	if (pWriter == NULL)
+		return (1);
+	for (pNameSpaceInfo = pIPDRHeader->pOtherNameSpaceInfo_; pNameSpaceInfo != NULL;
+		 pNameSpaceInfo = pNameSpaceInfo->pNext_)
+		appendListSchemaNameSpace(&pListSchemaNameSpace,
+								  pNameSpaceInfo->NameSpaceInfo_.nameSpaceURI_);
+	if (writeHeader(pWriter, pIPDRHeader->startTime_, pIPDRHeader->ipdrRecorderInfo_,
+					pIPDRHeader->defaultNameSpaceURI_, pIPDRHeader->pOtherNameSpaceInfo_,
+					pIPDRHeader->pListServiceDefinitionURI_, pIPDRHeader->docID_,
+					pListSchemaNameSpace, &errorCode) == IPDR_ERROR) {
+		printf("writeHeader failed, error %d\n", errorCode);
+		return (1);
+	}
+
+	for (count = 0; count < ESCAPE_NO_OF_VALUES; count++) {
+		pFNFData->descriptorID_ = (count % 2 == 0) ? descriptorID : 0;
+		if (setListIPDRDataValue(pStringValue, (void *) gValues[count], -1,
+								 IPDRDATA_STRING) != IPDR_OK ||
+			writeIPDR(pWriter, pFNFData, &errorCode) == IPDR_ERROR) {
+			printf("writeIPDR failed, error %d\n", errorCode);
+			return (1);
+		}
+	}
+	if (writeDocEnd(pWriter, &errorCode) == IPDR_ERROR) {
+		printf("writeDocEnd failed, error %d\n", errorCode);
+		return (1);
+	}
+	fflush(pOutputStream);
+
+	/* The special characters must only appear as entity references */
+	fseek(pOutputStream, 0, SEEK_END);
+	length = ftell(pOutputStream);
+	rewind(pOutputStream);
+	pDocument = (char *) calloc(length + 1, sizeof(char));
+	if (pDocument == NULL ||
+		(long) fread(pDocument, 1, length, pOutputStream) != length) {
+		printf("cannot read the XML document back\n");
+		return (1);
+	}
+	for (count = 0; count < ESCAPE_NO_OF_VALUES; count++) {
+		if (strstr(pDocument, gEscapedValues[count]) == NULL) {
+			printf("\"%s\" is not written as \"%s\"\n",
+				   gValues[count], gEscapedValues[count]);
+			failures++;
+		}
+	}
+	free(pDocument);
+	rewind(pOutputStream);
+
+	/* The XML reader takes the stream over */
+	pWriter->pStreamHandle_ = NULL;
+	freeIPDRCommonParameters(pWriter);
+	pWriter = newCheckParameters(XML, NONREADABLE, IPDR_VERSION_3_5, pOutputStream);
+	if (pWriter == NULL ||
+		readHeader(pWriter, pXMLHeader, &errorCode) == IPDR_ERROR) {
+		printf("cannot read the XML header, error %d\n", errorCode);
+		return (1);
+	}
+
+	for (count = 0; count < ESCAPE_NO_OF_VALUES; count++) {
+		pReadFNFData = newFNFData();
+		if (readIPDR(pWriter, &pReadFNFData, &errorCode) == IPDR_ERROR ||
+			pReadFNFData == NULL) {
+			printf("record %d cannot be read back, error %d\n", count + 1, errorCode);
+			return (1);
+		}
+		pStringValue = findStringValue(pReadFNFData, attributeName);
+		if (pStringValue == NULL ||
+			strcmp((char *) pStringValue->IPDRDataUnion_.IPDRUTF8Array_, gValues[count]) != 0) {
+			printf("record %d: \"%s\" read back as \"%s\"\n", count + 1, gValues[count],
+				   pStringValue == NULL ? "" : (char *) pStringValue->IPDRDataUnion_.IPDRUTF8Array_);
+			failures++;
+		}
+		freeFNFData(pReadFNFData);
+	}
+
+	freeListSchemaNameSpace(&pListSchemaNameSpace);
+	freeFNFData(pFNFData);
+	freeIPDRHeader(pIPDRHeader);
+	freeIPDRHeader(pXMLHeader);
+	freeDocEnd(pDocEnd);
+	freeIPDRCommonParameters(pReader);
+	freeIPDRCommonParameters(pWriter);
+
+	return (failures);
+}
+
+
+int main(int argc, char *argv[])
+{
+	int failures = 0;
+	char fileName[ESCAPE_MAX_PATH];
+	const char* pTestData = getenv("IPDR_TESTDATA");
+
+	if (argc > 1)
+		snprintf(fileName, sizeof(fileName), "%s", argv[1]);
+	else
+		snprintf(fileName, sizeof(fileName), "%s/%s",
+				 pTestData != NULL ? pTestData : "testdata", ESCAPE_DEFAULT_DOCUMENT);
+
+	failures += checkEscapeXMLString();
+	failures += checkXMLRoundTrip(fileName);
+
+	if (failures != 0) {
+		printf("FAILED: %d mismatches\n", failures);
+		return (1);
+	}
+	printf("OK: %d strings escaped and read back unchanged\n", ESCAPE_NO_OF_VALUES);
+	return (0);
+}
@@ -0,0 +1,55 @@
+/* Copyright (C) 2002, The IPDR Organization, all rights reserved.
+* The use and distribution of this software is governed by the terms of
+* the license agreement which can be found in the file LICENSE.TXT at
+* the top of this source tree.
+*
+* This software is distributed on an "AS IS" basis, WITHOUT WARRANTY OF
+* ANY KIND, either express or implied.
+*/
+
+
+/*****************************************************
+ * File                 : CheckUtil.h                *
+ * Description          : Helpers shared by the      *
+ *                        regression tests run by    *
+ *                        make check                 *
+ * Author               : Infosys Tech Ltd           *
+ * Modification History :                            *
+ *---------------------------------------------------*
+ * Date       Name        Change/Description         *
+ *---------------------------------------------------*
+ *                                                   *
+ *****************************************************/
+
+#ifndef _CHECKUTIL_H
+#define _CHECKUTIL_H
+
+#include <stdio.h>
+
+#include "utils/IPDRCommon.h"
+
+/* The end time of a document is written when it is closed */
+#define CHECK_DOC_END_TIME_SIZE		8
+
+#define CHECK_MAX_TEXT				4096
+
+/* A record read, as text */
+typedef struct RecordText
+{
+	int noOfAttributes_;
+	char text_[CHECK_MAX_TEXT];
+} RecordText;
+
+IPDRCommonParameters* newCheckParameters(DocType docType,
+										 DocState docState,
+										 const char* schemaVersion,
+										 FILE* pStream);
+
+char* readCopy(FILE* pStream, long* pLength);
+
+ListIPDRData* findStringValue(FNFData* pFNFData, const char* attributeName);
+const char* findAttributeName(FNFData* pFNFData, ListIPDRData* pValue);
+
+int formatRecord(const FNFData* pFNFData, RecordText* pRecord);
+
+#endif
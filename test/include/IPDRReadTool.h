@@ -40,6 +40,7 @@
 #include "curl/types.h"
 #include "curl/easy.h"
 #include "common/getFile.h"
+#include "common/schemaCache.h"
 
 
 #define MAX_STR_LENGTH		40000
@@ -112,6 +113,12 @@ int validateInputParams(
 					   );
 */
 
+int setProjection(
+				  char* attributeNames,
+				  IPDRCommonParameters* pIPDRCommonParameters,
+				  int* pErrorCode
+				  );
+
 int populateIPDRCommonParameters(
 								IPDRCommonParameters* pIPDRCommonParameters,
 								int* pErrorCode
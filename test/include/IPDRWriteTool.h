@@ -39,6 +39,7 @@
 #include "curl/types.h"
 #include "curl/easy.h"
 #include "common/getFile.h"
+#include "common/schemaCache.h"
 
 #define MAX_REC_STRING		40000
 #define MAX_STR_LENGTH		10000